@@ -0,0 +1,129 @@
+/**************************************************************************//**
+ * @file     acmp_route_test.c
+ * @brief    Host test of the ACMP trigger routing
+ *
+ * Checks that the comparator outputs are routed to the EPWM brake, to a
+ * timer capture input for edge counting and to EADC through the timer,
+ * touching only the requested channels and fields.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2024 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+#include "host_regs.h"
+
+#if defined(TIMER_INTERCAPSEL_ACMP1)
+#define TEST_CAPSEL_ACMP1       TIMER_INTERCAPSEL_ACMP1
+#define TEST_CAPSEL_MSK         TIMER_EXTCTL_INTERCAPSEL_Msk
+#else
+#define TEST_CAPSEL_ACMP1       TIMER_INTER_CAPTURE_SOURCE_ACMP1
+#define TEST_CAPSEL_MSK         TIMER_EXTCTL_ICAPSEL_Msk
+#endif
+
+/* Brake action high on both channels of a pair */
+#define TEST_BRK_ACTION         ((3UL << EPWM_BRKCTL0_1_BRKAEVEN_Pos) | (3UL << EPWM_BRKCTL0_1_BRKAODD_Pos))
+
+static uint32_t W1cWrite(uint32_t u32Addr, uint32_t u32Old, uint32_t u32New)
+{
+    (void)u32Addr;
+    return u32Old & ~u32New;
+}
+
+static void TestEPWMBrake(void)
+{
+    uint32_t i;
+
+    for(i = 0UL; i < 3UL; i++)
+        EPWM0->BRKCTL[i] = TEST_BRK_ACTION;
+
+    /* Channels 0 and 2: pairs 0 and 1 get the source, the brake action is kept */
+    ACMP_EnableEPWMBrake(EPWM0, 0x05UL, 1UL, ACMP_BRAKE_LEVEL);
+    HOST_CHECK(EPWM0->BRKCTL[0] == (TEST_BRK_ACTION | EPWM_FB_LEVEL_ACMP1));
+    HOST_CHECK(EPWM0->BRKCTL[1] == (TEST_BRK_ACTION | EPWM_FB_LEVEL_ACMP1));
+    HOST_CHECK(EPWM0->BRKCTL[2] == TEST_BRK_ACTION);
+
+    ACMP_EnableEPWMBrake(EPWM0, 0x10UL, 0UL, ACMP_BRAKE_EDGE);
+    HOST_CHECK(EPWM0->BRKCTL[2] == (TEST_BRK_ACTION | EPWM_FB_EDGE_ACMP0));
+    HOST_CHECK(EPWM0->BRKCTL[0] == (TEST_BRK_ACTION | EPWM_FB_LEVEL_ACMP1));
+
+    /* Removing one comparator leaves the other sources and the brake action */
+    ACMP_EnableEPWMBrake(EPWM0, 0x01UL, 0UL, ACMP_BRAKE_EDGE);
+    ACMP_DisableEPWMBrake(EPWM0, 0x01UL, 1UL);
+    HOST_CHECK(EPWM0->BRKCTL[0] == (TEST_BRK_ACTION | EPWM_FB_EDGE_ACMP0));
+    HOST_CHECK(EPWM0->BRKCTL[1] == (TEST_BRK_ACTION | EPWM_FB_LEVEL_ACMP1));
+    ACMP_DisableEPWMBrake(EPWM0, 0x3FUL, 0UL);
+    HOST_CHECK(EPWM0->BRKCTL[0] == TEST_BRK_ACTION);
+    HOST_CHECK(EPWM0->BRKCTL[2] == TEST_BRK_ACTION);
+}
+
+static void TestEdgeCount(void)
+{
+    S_ACMP_EDGE_CNT_T sCnt;
+    uint32_t i;
+
+    HostReg_SetHook(&TIMER1->EINTSTS, NULL, W1cWrite);
+    HostReg_Trap(1UL);
+
+    ACMP_EdgeCountOpen(&sCnt, TIMER1, 1UL, TIMER_CAPTURE_EVENT_RISING, 3UL);
+    HOST_CHECK((TIMER1->CTL & (TIMER_CTL_CAPSRC_Msk | TIMER_CTL_CNTEN_Msk)) == (TIMER_CTL_CAPSRC_Msk | TIMER_CTL_CNTEN_Msk));
+    HOST_CHECK((TIMER1->EXTCTL & TEST_CAPSEL_MSK) == TEST_CAPSEL_ACMP1);
+    HOST_CHECK((TIMER1->EXTCTL & TIMER_EXTCTL_CAPEDGE_Msk) == TIMER_CAPTURE_EVENT_RISING);
+    HOST_CHECK(((TIMER1->EXTCTL & TIMER_EXTCTL_CAPDIVSCL_Msk) >> TIMER_EXTCTL_CAPDIVSCL_Pos) == 3UL);
+    HOST_CHECK((TIMER1->EXTCTL & (TIMER_EXTCTL_CAPEN_Msk | TIMER_EXTCTL_CAPIEN_Msk)) == (TIMER_EXTCTL_CAPEN_Msk | TIMER_EXTCTL_CAPIEN_Msk));
+
+    /* Five capture interrupts of 8 edges each, one spurious call without a flag */
+    for(i = 0UL; i < 5UL; i++)
+    {
+        HostReg_Set(&TIMER1->CAP, 100UL * i);
+        HostReg_Set(&TIMER1->EINTSTS, TIMER_EINTSTS_CAPIF_Msk);
+        ACMP_EdgeCountIRQHandler(&sCnt);
+        HOST_CHECK((HostReg_Get(&TIMER1->EINTSTS) & TIMER_EINTSTS_CAPIF_Msk) == 0UL);
+    }
+    ACMP_EdgeCountIRQHandler(&sCnt);
+    HOST_CHECK(ACMP_EdgeCountGet(&sCnt) == 40UL);
+    HOST_CHECK(sCnt.u32LastCap == 400UL);
+
+    ACMP_EdgeCountClose(&sCnt);
+    HOST_CHECK((TIMER1->EXTCTL & (TIMER_EXTCTL_CAPEN_Msk | TIMER_EXTCTL_CAPIEN_Msk)) == 0UL);
+    HostReg_Trap(0UL);
+}
+
+static void TestEADCTrigger(void)
+{
+    /* A running timer keeps its mode and compare value */
+    TIMER2->CTL = TIMER_PERIODIC_MODE | TIMER_CTL_CNTEN_Msk | 11UL;
+    TIMER2->CMP = 1234UL;
+    HOST_CHECK(ACMP_EnableEADCTrigger(TIMER2, 0UL, TIMER_CAPTURE_EVENT_FALLING) == EADC_TIMER2_TRIGGER);
+    HOST_CHECK((TIMER2->CTL & TIMER_CTL_OPMODE_Msk) == TIMER_PERIODIC_MODE);
+    HOST_CHECK(TIMER2->CMP == 1234UL);
+    HOST_CHECK((TIMER2->EXTCTL & TIMER_EXTCTL_CAPEDGE_Msk) == TIMER_CAPTURE_EVENT_FALLING);
+    HOST_CHECK((TIMER2->EXTCTL & TEST_CAPSEL_MSK) == 0UL);
+    HOST_CHECK((TIMER2->TRGCTL & (TIMER_TRGCTL_TRGSSEL_Msk | TIMER_TRGCTL_TRGEADC_Msk)) ==
+               (TIMER_TRGSRC_CAPTURE_EVENT | TIMER_TRG_TO_EADC));
+
+    ACMP_DisableEADCTrigger(TIMER2);
+    HOST_CHECK((TIMER2->TRGCTL & (TIMER_TRGCTL_TRGSSEL_Msk | TIMER_TRGCTL_TRGEADC_Msk)) == 0UL);
+}
+
+static void TestWindowState(void)
+{
+    ACMP01->STATUS = ACMP_STATUS_ACMPWO_Msk;
+    HOST_CHECK(ACMP_GetWindowState(ACMP01) == ACMP_WINDOW_INSIDE);
+    ACMP01->STATUS = ACMP_STATUS_ACMPO0_Msk;
+    HOST_CHECK(ACMP_GetWindowState(ACMP01) == ACMP_WINDOW_ABOVE);
+    ACMP01->STATUS = 0UL;
+    HOST_CHECK(ACMP_GetWindowState(ACMP01) == ACMP_WINDOW_BELOW);
+}
+
+int main(void)
+{
+    HostReg_Reset();
+
+    TestEPWMBrake();
+    TestEdgeCount();
+    TestEADCTrigger();
+    TestWindowState();
+
+    return HostTest_Result("acmp_route");
+}
@@ -0,0 +1,142 @@
+/**************************************************************************//**
+ * @file     aes_ctx_bench.c
+ * @brief    Host benchmark of AES contexts against AES_SetKey/AES_SetInitVect
+ *
+ * Counts the CRPT register writes per 1 KB record of a session that keeps
+ * one 256-bit key, once with AES_SetKey + AES_SetInitVect and once with
+ * AES_CtxLoad, and checks when AES_CtxLoad writes the key and the IV.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2024 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "NuMicro.h"
+#include "host_regs.h"
+
+#if defined(CRPT_AES0_KEYx_KEY_Msk)
+#define TEST_AES_KEY            CRPT->AES0_KEY
+#define TEST_AES_IV             CRPT->AES0_IV
+#else
+#define TEST_AES_KEY            CRPT->AES_KEY
+#define TEST_AES_IV             CRPT->AES_IV
+#endif
+
+#define BENCH_RECORDS           1000UL
+#define BENCH_RECORD_SIZE       1024UL
+#define BENCH_KEY_WORDS         (4UL + AES_KEY_SIZE_256 * 2UL)
+
+static uint32_t s_au32Key[8] = {0x603deb10, 0x15ca71be, 0x2b73aef0, 0x857d7781, 0x1f352c07, 0x3b6108d7, 0x2d9810a3, 0x0914dff4};
+static uint32_t s_au32Key2[8] = {0x2b7e1516, 0x28aed2a6, 0xabf71588, 0x09cf4f3c, 0x00010203, 0x04050607, 0x08090a0b, 0x0c0d0e0f};
+static uint32_t s_au32IV[4] = {0x00010203, 0x04050607, 0x08090a0b, 0x0c0d0e0f};
+static uint8_t  s_au8In[BENCH_RECORD_SIZE], s_au8Out[BENCH_RECORD_SIZE];
+
+static void RecordSetKey(void)
+{
+    AES_SetKey(CRPT, 0UL, s_au32Key, AES_KEY_SIZE_256);
+    AES_SetInitVect(CRPT, 0UL, s_au32IV);
+    AES_SetDMATransfer(CRPT, 0UL, (uint32_t)(uintptr_t)s_au8In, (uint32_t)(uintptr_t)s_au8Out, BENCH_RECORD_SIZE);
+    AES_Start(CRPT, 0UL, CRYPTO_DMA_ONE_SHOT);
+}
+
+static void RecordCtx(S_AES_CTX_T *psCtx)
+{
+    AES_CtxLoad(CRPT, 0UL, psCtx, s_au32IV);
+    AES_SetDMATransfer(CRPT, 0UL, (uint32_t)(uintptr_t)s_au8In, (uint32_t)(uintptr_t)s_au8Out, BENCH_RECORD_SIZE);
+    AES_Start(CRPT, 0UL, CRYPTO_DMA_ONE_SHOT);
+}
+
+/* The engine advances the IV registers while it chains blocks */
+static void EngineRun(void)
+{
+    uint32_t i;
+
+    for(i = 0UL; i < 4UL; i++)
+        HostReg_Set(&TEST_AES_IV[i], ~s_au32IV[i]);
+}
+
+static uint32_t CountWrites(volatile uint32_t *pu32Reg, uint32_t u32Num, void (*pfnRecord)(S_AES_CTX_T *psCtx), S_AES_CTX_T *psCtx)
+{
+    HostReg_SetCountWindow(pu32Reg, u32Num * 4UL);
+    HostReg_ResetCount();
+    pfnRecord(psCtx);
+    return HostReg_GetWriteCount();
+}
+
+static void LoadCtx(S_AES_CTX_T *psCtx)
+{
+    AES_CtxLoad(CRPT, 0UL, psCtx, s_au32IV);
+}
+
+int main(void)
+{
+    S_AES_CTX_T sCtx, sCtx2;
+    uint64_t u64Start, u64KeyNs, u64CtxNs;
+    uint32_t i, u32KeyWr, u32CtxWr;
+
+    HostReg_Reset();
+    HostReg_Trap(1UL);
+    AES_InvalidateKeyCache(CRPT);
+    AES_Open(CRPT, 0UL, 1UL, AES_MODE_CBC, AES_KEY_SIZE_256, AES_IN_OUT_SWAP);
+    AES_CtxSetKey(&sCtx, s_au32Key, AES_KEY_SIZE_256);
+    AES_CtxSetKey(&sCtx2, s_au32Key2, AES_KEY_SIZE_256);
+
+    /* The first load writes the key, later loads of the same context only the IV */
+    HOST_CHECK(CountWrites(TEST_AES_KEY, 8UL, LoadCtx, &sCtx) == BENCH_KEY_WORDS);
+    HOST_CHECK(memcmp((const void *)TEST_AES_KEY, s_au32Key, sizeof(s_au32Key)) == 0);
+    HOST_CHECK(CountWrites(TEST_AES_KEY, 8UL, LoadCtx, &sCtx) == 0UL);
+
+    /* The IV is written again after every record, even when it is the same */
+    for(i = 0UL; i < 3UL; i++)
+    {
+        EngineRun();
+        HOST_CHECK(CountWrites(TEST_AES_IV, 4UL, RecordCtx, &sCtx) == 4UL);
+        HOST_CHECK(memcmp((const void *)TEST_AES_IV, s_au32IV, sizeof(s_au32IV)) == 0);
+    }
+
+    /* Another context, AES_SetKey or a changed key loads the key again */
+    HOST_CHECK(CountWrites(TEST_AES_KEY, 8UL, LoadCtx, &sCtx2) == BENCH_KEY_WORDS);
+    HOST_CHECK(CountWrites(TEST_AES_KEY, 8UL, LoadCtx, &sCtx) == BENCH_KEY_WORDS);
+    AES_SetKey(CRPT, 0UL, s_au32Key2, AES_KEY_SIZE_256);
+    HOST_CHECK(CountWrites(TEST_AES_KEY, 8UL, LoadCtx, &sCtx) == BENCH_KEY_WORDS);
+    HOST_CHECK(memcmp((const void *)TEST_AES_KEY, s_au32Key, sizeof(s_au32Key)) == 0);
+    AES_CtxSetKey(&sCtx, s_au32Key2, AES_KEY_SIZE_256);
+    HOST_CHECK(CountWrites(TEST_AES_KEY, 8UL, LoadCtx, &sCtx) == BENCH_KEY_WORDS);
+    AES_CtxInvalidate(&sCtx);
+    HOST_CHECK(CountWrites(TEST_AES_KEY, 8UL, LoadCtx, &sCtx) == BENCH_KEY_WORDS);
+    AES_InvalidateKeyCache(CRPT);
+    HOST_CHECK(CountWrites(TEST_AES_KEY, 8UL, LoadCtx, &sCtx) == BENCH_KEY_WORDS);
+    HOST_CHECK(memcmp((const void *)TEST_AES_KEY, s_au32Key2, sizeof(s_au32Key2)) == 0);
+    AES_CtxSetKey(&sCtx, s_au32Key, AES_KEY_SIZE_256);
+
+    /* CRPT register writes per 1 KB record */
+    HostReg_SetCountWindow(CRPT, sizeof(CRPT_T));
+    HostReg_ResetCount();
+    for(i = 0UL; i < BENCH_RECORDS; i++)
+        RecordSetKey();
+    u32KeyWr = HostReg_GetWriteCount();
+    RecordCtx(&sCtx);
+    HostReg_ResetCount();
+    for(i = 0UL; i < BENCH_RECORDS; i++)
+        RecordCtx(&sCtx);
+    u32CtxWr = HostReg_GetWriteCount();
+    HOST_CHECK(u32KeyWr - u32CtxWr == BENCH_RECORDS * BENCH_KEY_WORDS);
+
+    /* Host time per record, registers as plain memory */
+    HostReg_Trap(0UL);
+    u64Start = HostBench_Ns();
+    for(i = 0UL; i < BENCH_RECORDS * 100UL; i++)
+        RecordSetKey();
+    u64KeyNs = HostBench_Ns() - u64Start;
+    u64Start = HostBench_Ns();
+    for(i = 0UL; i < BENCH_RECORDS * 100UL; i++)
+        RecordCtx(&sCtx);
+    u64CtxNs = HostBench_Ns() - u64Start;
+
+    printf("AES_SetKey + AES_SetInitVect: %4.1f register writes, %6.1f ns per 1 KB record\n",
+           (double)u32KeyWr / BENCH_RECORDS, (double)u64KeyNs / (BENCH_RECORDS * 100UL));
+    printf("AES_CtxLoad:                  %4.1f register writes, %6.1f ns per 1 KB record\n",
+           (double)u32CtxWr / BENCH_RECORDS, (double)u64CtxNs / (BENCH_RECORDS * 100UL));
+
+    return HostTest_Result("aes_ctx_bench");
+}
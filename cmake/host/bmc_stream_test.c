@@ -0,0 +1,347 @@
+/**************************************************************************//**
+ * @file     bmc_stream_test.c
+ * @brief    Host test of the BMC PDMA streaming on a FIFO model
+ *
+ * Three channel groups stream through the PDMA descriptors of bmc.c. Each
+ * time step PDMA refills 2 word FIFOs from the current descriptors, then
+ * every running group sends one word out of its FIFO, or flags a transmit
+ * under run when it is empty. A finished descriptor raises the transfer
+ * done flag and PDMA moves to the linked one on the next step. The PDMA
+ * and BMC interrupts call BMC_StreamIRQHandler for every stream.
+ *
+ * The producer writes consecutive words into the halves it gets. The words
+ * sent by a group must be those words in order, except for whole halves
+ * played again because they were not refilled in time, which u32Late must
+ * count. Checked are the start of all groups on the same step by one CTL
+ * write, late refills, and under runs while PDMA is held off.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2024 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "NuMicro.h"
+#include "host_regs.h"
+
+#define TEST_STREAMS        3UL
+#define TEST_HALF_LEN       8UL
+#define TEST_FIFO_DEPTH     2UL
+#define TEST_DUMMY          0xFFFFFFFFUL
+
+/* Group and PDMA channel of each stream */
+static const uint32_t s_au32Group[TEST_STREAMS] = { BMC_GROUP_0, BMC_GROUP_2, BMC_GROUP_7 };
+static const uint32_t s_au32Ch[TEST_STREAMS] = { 1UL, 4UL, 9UL };
+
+static S_BMC_STREAM_T s_asStream[TEST_STREAMS];
+static S_BMC_STREAM_T *s_apsStream[TEST_STREAMS] = { &s_asStream[0], &s_asStream[1], &s_asStream[2] };
+static uint32_t s_au32Buf[TEST_STREAMS][2UL * TEST_HALF_LEN];
+
+/* Register mirrors */
+static uint32_t s_u32Ctl, s_u32CtlWrites, s_u32IntSts, s_u32TdSts;
+
+/* PDMA and FIFO model of each stream */
+static DSCT_T *s_apsDesc[TEST_STREAMS];
+static uint32_t s_au32DescIdx[TEST_STREAMS];
+static uint32_t s_au32Fifo[TEST_STREAMS][TEST_FIFO_DEPTH], s_au32FifoLen[TEST_STREAMS];
+static uint32_t s_u32DmaHold;
+
+/* Producer, and checker of the sent words */
+static uint32_t s_au32NextWr[TEST_STREAMS];
+static uint32_t s_au32NextSeq[TEST_STREAMS], s_au32Sent[TEST_STREAMS], s_au32First[TEST_STREAMS];
+static uint32_t s_au32Last[TEST_STREAMS][2UL * TEST_HALF_LEN], s_au32Replay[TEST_STREAMS], s_au32Replays[TEST_STREAMS];
+static uint32_t s_au32Dummies[TEST_STREAMS], s_u32Step, s_u32Bad;
+
+static uint32_t CtlWrite(uint32_t u32Addr, uint32_t u32Old, uint32_t u32New)
+{
+    (void)u32Addr;
+    (void)u32Old;
+    s_u32Ctl = u32New;
+    s_u32CtlWrites++;
+    return u32New;
+}
+
+static uint32_t IntStsRead(uint32_t u32Addr, uint32_t u32Val)
+{
+    (void)u32Addr;
+    (void)u32Val;
+    return s_u32IntSts;
+}
+
+static uint32_t IntStsWrite(uint32_t u32Addr, uint32_t u32Old, uint32_t u32New)
+{
+    (void)u32Addr;
+    (void)u32Old;
+    s_u32IntSts &= ~u32New;
+    return s_u32IntSts;
+}
+
+static uint32_t TdStsRead(uint32_t u32Addr, uint32_t u32Val)
+{
+    (void)u32Addr;
+    (void)u32Val;
+    return s_u32TdSts;
+}
+
+static uint32_t TdStsWrite(uint32_t u32Addr, uint32_t u32Old, uint32_t u32New)
+{
+    (void)u32Addr;
+    (void)u32Old;
+    s_u32TdSts &= ~u32New;
+    return s_u32TdSts;
+}
+
+static uint32_t Word(uint32_t u32Stream, uint32_t u32Seq)
+{
+    return (u32Stream << 24) | u32Seq;
+}
+
+/* Fills every half the driver hands out */
+static void Produce(uint32_t u32Stream)
+{
+    uint32_t *pu32Half, i;
+
+    while((pu32Half = BMC_StreamGetBuf(s_apsStream[u32Stream])) != NULL)
+    {
+        for(i = 0UL; i < TEST_HALF_LEN; i++)
+            pu32Half[i] = Word(u32Stream, s_au32NextWr[u32Stream]++);
+        BMC_StreamCommit(s_apsStream[u32Stream]);
+    }
+}
+
+/*
+ * A sent word is either the next produced one, or the word sent at the same place of the buffer
+ * one round before. Halves must be one or the other as a whole.
+ */
+static void Check(uint32_t u32Stream, uint32_t u32Word)
+{
+    uint32_t u32Pos = s_au32Sent[u32Stream] % (2UL * TEST_HALF_LEN);
+
+    if(u32Word == TEST_DUMMY)
+    {
+        s_au32Dummies[u32Stream]++;
+        return;
+    }
+    if(s_au32Sent[u32Stream]++ == 0UL)
+        s_au32First[u32Stream] = s_u32Step;
+
+    if((u32Pos % TEST_HALF_LEN) == 0UL)
+    {
+        s_au32Replay[u32Stream] = (u32Word != Word(u32Stream, s_au32NextSeq[u32Stream])) ? 1UL : 0UL;
+        s_au32Replays[u32Stream] += s_au32Replay[u32Stream];
+    }
+
+    if(s_au32Replay[u32Stream])
+    {
+        if(u32Word != s_au32Last[u32Stream][u32Pos])
+            s_u32Bad++;
+    }
+    else if(u32Word == Word(u32Stream, s_au32NextSeq[u32Stream]))
+    {
+        s_au32NextSeq[u32Stream]++;
+    }
+    else
+    {
+        s_u32Bad++;
+    }
+    s_au32Last[u32Stream][u32Pos] = u32Word;
+}
+
+/* PDMA moves words into the FIFO until it is full or the descriptor is done */
+static void Dma(uint32_t u32Stream)
+{
+    DSCT_T *psDesc = s_apsDesc[u32Stream];
+    uint32_t u32Ch = s_au32Ch[u32Stream];
+
+    while(s_au32FifoLen[u32Stream] < TEST_FIFO_DEPTH)
+    {
+        s_au32Fifo[u32Stream][s_au32FifoLen[u32Stream]++] = ((uint32_t *)(uintptr_t)psDesc->SA)[s_au32DescIdx[u32Stream]++];
+
+        if(s_au32DescIdx[u32Stream] > ((psDesc->CTL & PDMA_DSCT_CTL_TXCNT_Msk) >> PDMA_DSCT_CTL_TXCNT_Pos))
+        {
+            s_u32TdSts |= 1UL << u32Ch;
+            s_au32DescIdx[u32Stream] = 0UL;
+            s_apsDesc[u32Stream] = (DSCT_T *)(uintptr_t)(((uint32_t)(uintptr_t)psDesc & 0xFFFF0000UL) + psDesc->NEXT);
+            break;
+        }
+    }
+}
+
+/* One word time of the BMC */
+static void Step(void)
+{
+    uint32_t k, u32Word;
+
+    for(k = 0UL; k < TEST_STREAMS; k++)
+    {
+        if((s_u32Ctl & BMC_CTL_DMAEN_Msk) && (s_u32DmaHold == 0UL) && (s_apsDesc[k] != NULL))
+            Dma(k);
+    }
+    if(s_u32DmaHold)
+        s_u32DmaHold--;
+
+    for(k = 0UL; k < TEST_STREAMS; k++)
+    {
+        if(!(s_u32Ctl & BMC_CTL_BMCEN_Msk) || !(s_u32Ctl & (BMC_CTL_G0CHEN_Msk << (s_au32Group[k] >> 2))))
+            continue;
+
+        if(s_au32FifoLen[k] == 0UL)
+        {
+            s_u32IntSts |= BMC_INTSTS_TXUNDIF_Msk | (BMC_INTSTS_G0TXUND_Msk << (s_au32Group[k] >> 2));
+            u32Word = TEST_DUMMY;
+        }
+        else
+        {
+            u32Word = s_au32Fifo[k][0];
+            s_au32Fifo[k][0] = s_au32Fifo[k][1];
+            s_au32FifoLen[k]--;
+        }
+        Check(k, u32Word);
+    }
+
+    /* PDMA and BMC interrupts */
+    if(s_u32TdSts || (s_u32IntSts & (0xFFUL << BMC_INTSTS_G0TXUND_Pos)))
+    {
+        for(k = 0UL; k < TEST_STREAMS; k++)
+            BMC_StreamIRQHandler(PDMA0, s_apsStream[k]);
+    }
+    s_u32Step++;
+}
+
+static void Open(void)
+{
+    uint32_t k;
+
+    memset(s_au32NextWr, 0, sizeof(s_au32NextWr));
+    memset(s_au32NextSeq, 0, sizeof(s_au32NextSeq));
+    memset(s_au32Sent, 0, sizeof(s_au32Sent));
+    memset(s_au32Replays, 0, sizeof(s_au32Replays));
+    memset(s_au32Dummies, 0, sizeof(s_au32Dummies));
+    memset(s_au32FifoLen, 0, sizeof(s_au32FifoLen));
+    s_u32Bad = 0UL;
+
+    for(k = 0UL; k < TEST_STREAMS; k++)
+    {
+        HOST_CHECK(BMC_StreamOpen(PDMA0, s_apsStream[k], s_au32Group[k], s_au32Ch[k], s_au32Buf[k], TEST_HALF_LEN) == 0);
+        Produce(k);
+        HOST_CHECK(s_asStream[k].u32Filled == 3UL);
+        HOST_CHECK(BMC_StreamGetBuf(s_apsStream[k]) == NULL);
+
+        /* The channel starts on the descriptor given to PDMA_SetTransferMode */
+        s_apsDesc[k] = (DSCT_T *)(uintptr_t)(HostReg_Get(&PDMA0->SCATBA) + HostReg_Get(&PDMA0->DSCT[s_au32Ch[k]].NEXT));
+        HOST_CHECK(s_apsDesc[k] == &s_asStream[k].asDesc[0]);
+        s_au32DescIdx[k] = 0UL;
+    }
+}
+
+static void Stop(void)
+{
+    BMC_StreamStop(PDMA0, s_apsStream, TEST_STREAMS);
+    HOST_CHECK((s_u32Ctl & (BMC_CTL_BMCEN_Msk | BMC_CTL_DMAEN_Msk | (0xFFUL << BMC_CTL_G0CHEN_Pos))) == 0UL);
+    HOST_CHECK(HostReg_Get(&PDMA0->CHRST) == ((1UL << 1) | (1UL << 4) | (1UL << 9)));
+    HOST_CHECK(s_u32TdSts == 0UL);
+}
+
+/* Refilled on every step: all groups start together and send every word once, in order */
+static void TestContinuous(void)
+{
+    uint32_t i, k;
+
+    Open();
+    s_u32CtlWrites = 0UL;
+    BMC_StreamStart(s_apsStream, TEST_STREAMS);
+    HOST_CHECK(s_u32CtlWrites == 1UL);
+
+    for(i = 0UL; i < 1000UL; i++)
+    {
+        Step();
+        for(k = 0UL; k < TEST_STREAMS; k++)
+            Produce(k);
+    }
+
+    for(k = 0UL; k < TEST_STREAMS; k++)
+    {
+        HOST_CHECK(s_au32First[k] == s_au32First[0]);
+        HOST_CHECK(s_au32Sent[k] == 1000UL);
+        HOST_CHECK(s_au32NextSeq[k] == 1000UL);
+        HOST_CHECK((s_asStream[k].u32Late == 0UL) && (s_au32Replays[k] == 0UL));
+        HOST_CHECK((s_asStream[k].u32Underrun == 0UL) && (s_au32Dummies[k] == 0UL));
+    }
+    HOST_CHECK(s_u32Bad == 0UL);
+    Stop();
+}
+
+/* Refills of stream 1 stall now and then: whole halves are played again and counted, no word is torn */
+static void TestLate(void)
+{
+    uint32_t i, k, u32Stall = 0UL;
+
+    Open();
+    BMC_StreamStart(s_apsStream, TEST_STREAMS);
+
+    for(i = 0UL; i < 3000UL; i++)
+    {
+        Step();
+        if((i % 400UL) == 100UL)
+            u32Stall = 5UL + ((i / 400UL) * 7UL);
+        for(k = 0UL; k < TEST_STREAMS; k++)
+        {
+            if((k != 1UL) || (u32Stall == 0UL))
+                Produce(k);
+        }
+        if(u32Stall)
+            u32Stall--;
+    }
+
+    printf("late: %lu halves replayed, %lu words sent\n", (unsigned long)s_au32Replays[1], (unsigned long)s_au32NextSeq[1]);
+    HOST_CHECK(s_u32Bad == 0UL);
+    HOST_CHECK(s_au32Replays[1] != 0UL);
+    HOST_CHECK(s_asStream[1].u32Late == s_au32Replays[1]);
+    HOST_CHECK(s_au32NextSeq[1] + (s_au32Replays[1] * TEST_HALF_LEN) == s_au32Sent[1]);
+    HOST_CHECK((s_asStream[0].u32Late == 0UL) && (s_asStream[2].u32Late == 0UL));
+    for(k = 0UL; k < TEST_STREAMS; k++)
+        HOST_CHECK((s_au32Sent[k] == 3000UL) && (s_asStream[k].u32Underrun == 0UL));
+    Stop();
+}
+
+/* PDMA held off: the FIFOs run dry, every under run is counted, and no word is lost */
+static void TestUnderrun(void)
+{
+    uint32_t i, k;
+
+    Open();
+    BMC_StreamStart(s_apsStream, TEST_STREAMS);
+
+    for(i = 0UL; i < 500UL; i++)
+    {
+        if(i == 200UL)
+            s_u32DmaHold = 10UL;
+        Step();
+        for(k = 0UL; k < TEST_STREAMS; k++)
+            Produce(k);
+    }
+
+    for(k = 0UL; k < TEST_STREAMS; k++)
+    {
+        /* The FIFO is one word ahead when PDMA stops */
+        HOST_CHECK(s_au32Dummies[k] == (10UL - (TEST_FIFO_DEPTH - 1UL)));
+        HOST_CHECK(s_asStream[k].u32Underrun == s_au32Dummies[k]);
+        HOST_CHECK((s_au32NextSeq[k] == s_au32Sent[k]) && (s_asStream[k].u32Late == 0UL));
+    }
+    HOST_CHECK(s_u32Bad == 0UL);
+    Stop();
+}
+
+int main(void)
+{
+    HostReg_Reset();
+    HostReg_SetHook(&BMC->CTL, NULL, CtlWrite);
+    HostReg_SetHook(&BMC->INTSTS, IntStsRead, IntStsWrite);
+    HostReg_SetHook(&PDMA0->TDSTS, TdStsRead, TdStsWrite);
+    HostReg_Trap(1UL);
+
+    TestContinuous();
+    TestLate();
+    TestUnderrun();
+
+    return HostTest_Result("bmc_stream");
+}
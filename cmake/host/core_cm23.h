@@ -0,0 +1,16 @@
+/**************************************************************************//**
+ * @file     core_cm23.h
+ * @brief    Host stand-in for the CMSIS Cortex-M23 core header, see host_core.h
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2024 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __CORE_CM23_H__
+#define __CORE_CM23_H__
+
+#define __CORTEX_M      23U
+#define __FPU_USED      0U
+
+#include "host_core.h"
+
+#endif /* __CORE_CM23_H__ */
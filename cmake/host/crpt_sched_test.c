@@ -0,0 +1,260 @@
+/**************************************************************************//**
+ * @file     crpt_sched_test.c
+ * @brief    Host test of the crypto job scheduler
+ *
+ * Checks the start order of queued jobs (priority, FIFO among equals and the
+ * overtake bound), that an engine never waits for the jobs of another one,
+ * the time-out of CRPT_JobWait, and that ECC operations and scheduled jobs
+ * exclude each other. Engines finish when the test raises their INTSTS flag
+ * and calls CRPT_JobIRQHandler, the ECC engine finishes from the model
+ * interrupt right after it was started.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2024 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "NuMicro.h"
+#include "host_regs.h"
+
+#define TEST_JOB_NUM            16UL
+#define TEST_LOG_MAX            64UL
+
+static S_CRPT_JOB_T s_asJob[TEST_JOB_NUM];
+static uint32_t s_au32Log[TEST_LOG_MAX];   /* Job index of each start */
+static uint32_t s_u32LogLen;
+
+static uint32_t W1cWrite(uint32_t u32Addr, uint32_t u32Old, uint32_t u32New)
+{
+    (void)u32Addr;
+    return u32Old & ~u32New;
+}
+
+static void JobStart(CRPT_T *crpt, S_CRPT_JOB_T *psJob)
+{
+    (void)crpt;
+    if(s_u32LogLen < TEST_LOG_MAX)
+        s_au32Log[s_u32LogLen++] = (uint32_t)(psJob - s_asJob);
+}
+
+static S_CRPT_JOB_T *JobInit(uint32_t u32Idx, uint32_t u32Engine, uint32_t u32Priority)
+{
+    S_CRPT_JOB_T *psJob = &s_asJob[u32Idx];
+
+    memset(psJob, 0, sizeof(*psJob));
+    psJob->u32Engine = u32Engine;
+    psJob->u32Priority = u32Priority;
+    psJob->pfnStart = JobStart;
+    return psJob;
+}
+
+/* Engine raises its done flag */
+static void EngineDone(uint32_t u32Flag)
+{
+    HostReg_Set(&CRPT->INTSTS, HostReg_Get(&CRPT->INTSTS) | u32Flag);
+    CRPT_JobIRQHandler(CRPT);
+}
+
+static void Restart(void)
+{
+    HostReg_Reset();
+    HostReg_SetHook(&CRPT->INTSTS, NULL, W1cWrite);
+    HostReg_Trap(1UL);
+    CRPT_JobInit(CRPT);
+    memset(s_asJob, 0, sizeof(s_asJob));
+    s_u32LogLen = 0UL;
+}
+
+static void TestPriority(void)
+{
+    static const uint32_t au32Order[] = {0UL, 2UL, 4UL, 3UL, 1UL};
+    uint32_t i;
+
+    Restart();
+
+    /* Job 0 starts at once, the others queue by priority, 2 and 4 in submit order */
+    HOST_CHECK(CRPT_JobSubmit(CRPT, JobInit(0UL, CRPT_JOB_AES, 0UL)) == CRPT_JOB_OK);
+    HOST_CHECK(s_asJob[0].i32Status == CRPT_JOB_RUNNING);
+    HOST_CHECK(CRPT_JobSubmit(CRPT, JobInit(1UL, CRPT_JOB_AES, 1UL)) == CRPT_JOB_OK);
+    HOST_CHECK(CRPT_JobSubmit(CRPT, JobInit(2UL, CRPT_JOB_AES, 3UL)) == CRPT_JOB_OK);
+    HOST_CHECK(CRPT_JobSubmit(CRPT, JobInit(3UL, CRPT_JOB_AES, 2UL)) == CRPT_JOB_OK);
+    HOST_CHECK(CRPT_JobSubmit(CRPT, JobInit(4UL, CRPT_JOB_AES, 3UL)) == CRPT_JOB_OK);
+    HOST_CHECK(s_asJob[1].i32Status == CRPT_JOB_QUEUED);
+    HOST_CHECK(CRPT_JobSubmit(CRPT, &s_asJob[1]) == CRPT_JOB_ERR_BUSY);
+    HOST_CHECK(CRPT->INTEN & CRPT_INTEN_AESIEN_Msk);
+
+    for(i = 0UL; i < 5UL; i++)
+    {
+        HOST_CHECK(s_u32LogLen == i + 1UL);
+        EngineDone(CRPT_INTSTS_AESIF_Msk);
+    }
+
+    HOST_CHECK(memcmp(s_au32Log, au32Order, sizeof(au32Order)) == 0);
+    for(i = 0UL; i < 5UL; i++)
+        HOST_CHECK(s_asJob[i].i32Status == CRPT_JOB_OK);
+
+    /* The last job leaves the engine interrupt disabled */
+    HOST_CHECK((CRPT->INTEN & CRPT_INTEN_AESIEN_Msk) == 0UL);
+}
+
+static void TestOvertake(void)
+{
+    uint32_t i, u32Pos = 0UL;
+
+    Restart();
+
+    /* A low priority job waits behind a running one while high priority jobs keep arriving */
+    CRPT_JobSubmit(CRPT, JobInit(0UL, CRPT_JOB_AES, 0UL));
+    CRPT_JobSubmit(CRPT, JobInit(1UL, CRPT_JOB_AES, 0UL));
+    for(i = 2UL; i < 2UL + 2UL * CRPT_JOB_OVERTAKE_MAX; i++)
+        HOST_CHECK(CRPT_JobSubmit(CRPT, JobInit(i, CRPT_JOB_AES, 5UL)) == CRPT_JOB_OK);
+
+    while(s_u32LogLen < 2UL + 2UL * CRPT_JOB_OVERTAKE_MAX)
+        EngineDone(CRPT_INTSTS_AESIF_Msk);
+
+    /* Job 1 starts after the running job and CRPT_JOB_OVERTAKE_MAX later ones */
+    for(i = 0UL; i < s_u32LogLen; i++)
+    {
+        if(s_au32Log[i] == 1UL)
+            u32Pos = i;
+    }
+    HOST_CHECK(u32Pos == 1UL + CRPT_JOB_OVERTAKE_MAX);
+
+    /* Later high priority jobs keep their order */
+    for(i = 1UL; i < s_u32LogLen; i++)
+    {
+        if((i > 1UL) && (i != u32Pos) && (i != u32Pos + 1UL))
+            HOST_CHECK(s_au32Log[i] == s_au32Log[i - 1UL] + 1UL);
+    }
+    HOST_CHECK(s_au32Log[u32Pos + 1UL] == 2UL + CRPT_JOB_OVERTAKE_MAX);
+}
+
+static void TestEngines(void)
+{
+#if (CRPT_JOB_ENGINE_NUM > 1)
+    uint32_t i;
+
+    Restart();
+
+    /* A queue on the SHA engine does not delay an AES job */
+    for(i = 0UL; i < 4UL; i++)
+        CRPT_JobSubmit(CRPT, JobInit(i, CRPT_JOB_SHA, 7UL));
+    HOST_CHECK(CRPT_JobSubmit(CRPT, JobInit(4UL, CRPT_JOB_AES, 0UL)) == CRPT_JOB_OK);
+    HOST_CHECK(s_asJob[4].i32Status == CRPT_JOB_RUNNING);
+    HOST_CHECK(s_u32LogLen == 2UL);
+
+    /* Each flag only finishes the job of its own engine */
+    EngineDone(CRPT_INTSTS_AESIF_Msk);
+    HOST_CHECK(s_asJob[4].i32Status == CRPT_JOB_OK);
+    HOST_CHECK(s_asJob[0].i32Status == CRPT_JOB_RUNNING);
+    HOST_CHECK((CRPT->INTEN & CRPT_INTEN_AESIEN_Msk) == 0UL);
+    HOST_CHECK(CRPT->INTEN & CRPT_INTEN_HMACIEN_Msk);
+
+    EngineDone(CRPT_INTSTS_HMACEIF_Msk);
+    HOST_CHECK(s_asJob[0].i32Status == CRPT_JOB_ERR_ENGINE);
+    HOST_CHECK(s_asJob[1].i32Status == CRPT_JOB_RUNNING);
+#endif
+}
+
+static void TestWait(void)
+{
+    uint32_t u32Clock = SystemCoreClock;
+
+    Restart();
+    SystemCoreClock = 1000UL;
+
+    /* A job still queued when the wait times out is removed */
+    CRPT_JobSubmit(CRPT, JobInit(0UL, CRPT_JOB_AES, 0UL));
+    CRPT_JobSubmit(CRPT, JobInit(1UL, CRPT_JOB_AES, 0UL));
+    HOST_CHECK(CRPT_JobWait(CRPT, &s_asJob[1]) == CRPT_JOB_ERR_TIMEOUT);
+    HOST_CHECK(s_asJob[1].i32Status == CRPT_JOB_ERR_CANCEL);
+    HOST_CHECK(CRPT_JobCancel(CRPT, &s_asJob[0]) == CRPT_JOB_ERR_BUSY);
+
+    EngineDone(CRPT_INTSTS_AESIF_Msk);
+    HOST_CHECK(CRPT_JobWait(CRPT, &s_asJob[0]) == CRPT_JOB_OK);
+    HOST_CHECK(s_u32LogLen == 1UL);
+
+    SystemCoreClock = u32Clock;
+}
+
+#if defined(CRPT_ECC_STS_BUSY_Msk)
+
+#define TEST_P192_GX    "188da80eb03090f67cbf20eb43a18800f4ff0afd82ff1012"
+#define TEST_P192_GY    "07192b95ffc8da78631011ed6b24cdd573f977a11e794811"
+#define TEST_P192_K     "1a8d598fc15bf0fd89030b5cb1111aeb92ae8baf5ea475fb"
+
+static uint32_t s_u32EccStarts;
+static int32_t  s_i32EccSubmit;     /* CRPT_JobSubmit while the ECC engine runs */
+
+static uint32_t EccCtlWrite(uint32_t u32Addr, uint32_t u32Old, uint32_t u32New)
+{
+    (void)u32Addr;
+    (void)u32Old;
+
+    if(u32New & CRPT_ECC_CTL_START_Msk)
+    {
+        s_u32EccStarts++;
+        HostReg_RaiseIrq();
+    }
+    return u32New & ~CRPT_ECC_CTL_START_Msk;
+}
+
+/* ECC engine runs and finishes */
+static void EccIrq(void)
+{
+    HostReg_Set(&CRPT->ECC_STS, CRPT_ECC_STS_BUSY_Msk);
+    s_i32EccSubmit = CRPT_JobSubmit(CRPT, JobInit(8UL, CRPT_JOB_AES, 0UL));
+    HostReg_Set(&CRPT->ECC_STS, 0UL);
+    HostReg_Set(&CRPT->INTSTS, HostReg_Get(&CRPT->INTSTS) | CRPT_INTSTS_ECCIF_Msk);
+    CRPT_JobIRQHandler(CRPT);
+}
+
+static void TestEcc(void)
+{
+    char acX[80], acY[80];
+    uint32_t u32Clock = SystemCoreClock;
+
+    Restart();
+    HostReg_SetHook(&CRPT->ECC_CTL, NULL, EccCtlWrite);
+    HostReg_SetIrq(EccIrq);
+
+    /* Idle scheduler: the ECC engine runs and no job is accepted meanwhile */
+    s_i32EccSubmit = CRPT_JOB_OK;
+    HOST_CHECK(ECC_Mutiply(CRPT, CURVE_P_192, TEST_P192_GX, TEST_P192_GY, TEST_P192_K, acX, acY) == 0);
+    HOST_CHECK(s_u32EccStarts == 1UL);
+    HOST_CHECK(s_i32EccSubmit == CRPT_JOB_ERR_BUSY);
+    HOST_CHECK(s_u32LogLen == 0UL);
+    HOST_CHECK((HostReg_Get(&CRPT->INTSTS) & CRPT_INTSTS_ECCIF_Msk) == 0UL);
+
+    /* Jobs are accepted again once it is done */
+    HOST_CHECK(CRPT_JobSubmit(CRPT, JobInit(0UL, CRPT_JOB_AES, 0UL)) == CRPT_JOB_OK);
+
+    /* A running job keeps the ECC engine from starting until the wait times out */
+    SystemCoreClock = 1000UL;
+    HOST_CHECK(ECC_Mutiply(CRPT, CURVE_P_192, TEST_P192_GX, TEST_P192_GY, TEST_P192_K, acX, acY) == -1);
+    HOST_CHECK(s_u32EccStarts == 1UL);
+    SystemCoreClock = u32Clock;
+
+    EngineDone(CRPT_INTSTS_AESIF_Msk);
+    HOST_CHECK(s_asJob[0].i32Status == CRPT_JOB_OK);
+    HOST_CHECK(ECC_Mutiply(CRPT, CURVE_P_192, TEST_P192_GX, TEST_P192_GY, TEST_P192_K, acX, acY) == 0);
+    HOST_CHECK(s_u32EccStarts == 2UL);
+}
+
+#endif
+
+int main(void)
+{
+    HostReg_Reset();
+
+    TestPriority();
+    TestOvertake();
+    TestEngines();
+    TestWait();
+#if defined(CRPT_ECC_STS_BUSY_Msk)
+    TestEcc();
+#endif
+
+    HostReg_Reset();
+    return HostTest_Result("crpt_sched");
+}
@@ -0,0 +1,156 @@
+/**************************************************************************//**
+ * @file     ecap_batch_bench.c
+ * @brief    Host benchmark of the ECAP capture rings and batch measurement
+ *
+ * Replays PWM edges through ECAP_CaptureIRQHandler, including counter
+ * overflows and pulses that end before the interrupt samples the input,
+ * checks the period and duty from ECAP_CaptureMeasure and reports the host
+ * time per edge of both halves.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2024 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+#include "host_regs.h"
+
+#define TEST_CLK            12000000UL      /* ECAP counter clock */
+#define TEST_PERIOD         12000UL         /* 1 kHz */
+#define TEST_HIGH           3000UL          /* 25 % */
+#define TEST_BATCH          16UL            /* Edges per ECAP_CaptureMeasure call */
+#define BENCH_EDGES         1000000UL
+
+static S_ECAP_CAPTURE_T s_sCap;
+static uint32_t s_u32Epoch;
+
+/* One capture on IC0 at counter time u32Ts, with the input at u32Live when the interrupt runs */
+static void Edge(uint32_t u32Ts, uint32_t u32Live)
+{
+    uint32_t u32Sts = ECAP_STATUS_CAPTF0_Msk | (u32Live ? ECAP_STATUS_CAP0_Msk : 0UL);
+
+    if((u32Ts >> 24) != s_u32Epoch)
+    {
+        s_u32Epoch = u32Ts >> 24;
+        u32Sts |= ECAP_STATUS_CAPOVF_Msk;
+    }
+    ECAP0->HLD0 = u32Ts & ECAP_CNT_CNT_Msk;
+    ECAP0->STATUS = u32Sts;
+    ECAP_CaptureIRQHandler(&s_sCap);
+}
+
+static void Start(uint32_t u32EdgeSel)
+{
+    HostReg_Reset();
+    ECAP0->CTL1 = u32EdgeSel;
+    s_u32Epoch = 0UL;
+    ECAP_CaptureInit(&s_sCap, ECAP0, 0x1UL);
+}
+
+/* Rising edges only; every pulse is already over when the interrupt samples the input */
+static void TestShortPulse(void)
+{
+    S_ECAP_MEAS_T sMeas;
+    uint32_t i;
+
+    Start(ECAP_RISING_EDGE);
+    for(i = 0UL; i <= 10UL; i++)
+        Edge(100UL + i * TEST_PERIOD, 0UL);
+
+    HOST_CHECK(ECAP_CaptureMeasure(&s_sCap, ECAP_IC0, TEST_CLK, &sMeas) == 11UL);
+    HOST_CHECK(sMeas.u32Periods == 10UL);
+    HOST_CHECK(sMeas.u32Period == TEST_PERIOD);
+    HOST_CHECK(sMeas.u32FreqMilliHz == 1000000UL);
+    HOST_CHECK(sMeas.u32Duty == ECAP_DUTY_UNKNOWN);
+}
+
+/* Falling edges only */
+static void TestFalling(void)
+{
+    S_ECAP_MEAS_T sMeas;
+    uint32_t i;
+
+    Start(ECAP_FALLING_EDGE);
+    for(i = 0UL; i <= 4UL; i++)
+        Edge(TEST_HIGH + i * TEST_PERIOD, 1UL);
+
+    ECAP_CaptureMeasure(&s_sCap, ECAP_IC0, TEST_CLK, &sMeas);
+    HOST_CHECK(sMeas.u32Periods == 4UL);
+    HOST_CHECK(sMeas.u32Period == TEST_PERIOD);
+    HOST_CHECK(sMeas.u32Duty == ECAP_DUTY_UNKNOWN);
+}
+
+/* Both edges across counter overflows, one falling edge missed */
+static void TestBoth(void)
+{
+    S_ECAP_MEAS_T sMeas;
+    uint32_t i, u32Ts = 0x00FF0000UL, u32Edges = 0UL, u32Periods = 0UL;
+
+    Start(ECAP_RISING_FALLING_EDGE);
+    for(i = 0UL; i < 40UL; i++)
+    {
+        Edge(u32Ts, 1UL);
+        if(i != 20UL)
+            Edge(u32Ts + TEST_HIGH, 0UL);
+        u32Ts += TEST_PERIOD;
+
+        if((i % 8UL) == 7UL)
+        {
+            u32Edges += ECAP_CaptureMeasure(&s_sCap, ECAP_IC0, TEST_CLK, &sMeas);
+            u32Periods += sMeas.u32Periods;
+            HOST_CHECK(sMeas.u32Period == TEST_PERIOD);
+            HOST_CHECK(sMeas.u32Duty == 250UL);
+        }
+    }
+    Edge(u32Ts, 1UL);
+    u32Edges += ECAP_CaptureMeasure(&s_sCap, ECAP_IC0, TEST_CLK, &sMeas);
+    u32Periods += sMeas.u32Periods;
+
+    HOST_CHECK(s_sCap.asRing[0].u32Lost == 0UL);
+    HOST_CHECK(u32Edges == 80UL);
+    /* The period with the missed edge is discarded */
+    HOST_CHECK(u32Periods == 39UL);
+}
+
+int main(void)
+{
+    S_ECAP_MEAS_T sMeas;
+    uint64_t u64Start, u64IrqNs = 0ULL, u64MeasNs = 0ULL, u64Span = 0ULL, u64High = 0ULL;
+    uint32_t i, j, u32Ts = 0UL, u32Periods = 0UL;
+
+    TestShortPulse();
+    TestFalling();
+    TestBoth();
+
+    /* Batches of TEST_BATCH edges: interrupt per edge, one measurement per batch */
+    Start(ECAP_RISING_FALLING_EDGE);
+    for(i = 0UL; i < BENCH_EDGES; i += TEST_BATCH)
+    {
+        u64Start = HostBench_Ns();
+        for(j = 0UL; j < TEST_BATCH; j += 2UL)
+        {
+            Edge(u32Ts, 1UL);
+            Edge(u32Ts + TEST_HIGH, 0UL);
+            u32Ts += TEST_PERIOD;
+        }
+        u64IrqNs += HostBench_Ns() - u64Start;
+
+        u64Start = HostBench_Ns();
+        ECAP_CaptureMeasure(&s_sCap, ECAP_IC0, TEST_CLK, &sMeas);
+        u64MeasNs += HostBench_Ns() - u64Start;
+
+        u32Periods += sMeas.u32Periods;
+        u64Span += (uint64_t)sMeas.u32Period * sMeas.u32Periods;
+        u64High += ((uint64_t)sMeas.u32Duty * sMeas.u32Period * sMeas.u32Periods) / 1000ULL;
+    }
+
+    HOST_CHECK(s_sCap.asRing[0].u32Lost == 0UL);
+    HOST_CHECK(u32Periods == (BENCH_EDGES / 2UL) - 1UL);
+    HOST_CHECK(u64Span == (uint64_t)u32Periods * TEST_PERIOD);
+    HOST_CHECK(u64High == (uint64_t)u32Periods * TEST_HIGH);
+
+    printf("ECAP_CaptureIRQHandler: %6.1f ns/edge\n", (double)u64IrqNs / BENCH_EDGES);
+    printf("ECAP_CaptureMeasure:    %6.1f ns/edge, %lu edges per call\n",
+           (double)u64MeasNs / BENCH_EDGES, (unsigned long)TEST_BATCH);
+
+    return HostTest_Result("ecap_batch_bench");
+}
@@ -0,0 +1,126 @@
+/**************************************************************************//**
+ * @file     eqei_enc_bench.c
+ * @brief    Host benchmark of the EQEI encoder estimator update
+ *
+ * EQEI_EncoderUpdate runs in a timer interrupt, so its cost per call is
+ * bounded: it reads the EQEI counter once, and the ECAP status once plus
+ * the hold register and the flag clear when an edge was captured. The
+ * register accesses per update are checked for an update without an edge
+ * and one with an edge, in both methods, and the host time per update is
+ * printed.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2024 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+#include "host_regs.h"
+
+#define BENCH_LOOPS             1000000UL
+#define BENCH_ECAP_CLK          1000000UL
+#define BENCH_UPDATE_HZ         1000UL
+
+static S_EQEI_ENC_T s_sEnc;
+static uint32_t s_u32Cnt, s_u32Cap;
+
+static uint32_t W1cWrite(uint32_t u32Addr, uint32_t u32Old, uint32_t u32New)
+{
+    (void)u32Addr;
+    return u32Old & ~u32New;
+}
+
+/* The encoder moves u32Step counts, with or without a captured edge */
+static void Step(uint32_t u32Step, uint32_t u32Edge)
+{
+    s_u32Cnt += u32Step;
+    s_u32Cap += BENCH_ECAP_CLK / BENCH_UPDATE_HZ;
+    HostReg_Set(&EQEI0->CNT, s_u32Cnt);
+    if(u32Edge)
+    {
+        HostReg_Set(&ECAP0->HLD0, s_u32Cap & EQEI_ENC_ECAP_CNT_MSK);
+        HostReg_Set(&ECAP0->STATUS, ECAP_STATUS_CAPTF0_Msk);
+    }
+}
+
+/* Register accesses of one update in the EQEI and the ECAP window */
+static void Bench(uint32_t u32Step, uint32_t u32Edge, uint32_t *pu32Eqei, uint32_t *pu32Ecap)
+{
+    S_EQEI_ENC_T sSaved;
+    uint32_t u32Sts;
+
+    Step(u32Step, u32Edge);
+    sSaved = s_sEnc;
+    u32Sts = HostReg_Get(&ECAP0->STATUS);
+
+    HostReg_SetCountWindow(EQEI0, sizeof(EQEI_T));
+    HostReg_ResetCount();
+    EQEI_EncoderUpdate(&s_sEnc);
+    *pu32Eqei = HostReg_GetReadCount() + HostReg_GetWriteCount();
+
+    /* Same update again, counted on the ECAP window */
+    s_sEnc = sSaved;
+    HostReg_Set(&ECAP0->STATUS, u32Sts);
+    HostReg_SetCountWindow(ECAP0, sizeof(ECAP_T));
+    HostReg_ResetCount();
+    EQEI_EncoderUpdate(&s_sEnc);
+    *pu32Ecap = HostReg_GetReadCount() + HostReg_GetWriteCount();
+}
+
+int main(void)
+{
+    uint32_t u32Eqei, u32Ecap, i;
+    uint64_t u64Start, u64TNs, u64MNs;
+
+    HostReg_Reset();
+    HostReg_SetHook(&ECAP0->STATUS, NULL, W1cWrite);
+    HostReg_Trap(1UL);
+    EQEI_Open(EQEI0, EQEI_CTL_X4_FREE_COUNTING_MODE, 0UL);
+    EQEI_Start(EQEI0);
+    EQEI_EncoderInit(&s_sEnc, EQEI0, ECAP0, ECAP_IC0, BENCH_ECAP_CLK, BENCH_UPDATE_HZ, 2UL);
+    Step(2UL, 1UL);
+    EQEI_EncoderUpdate(&s_sEnc);
+
+    /* T-method: no edge, then an edge */
+    Bench(0UL, 0UL, &u32Eqei, &u32Ecap);
+    HOST_CHECK((u32Eqei == 1UL) && (u32Ecap == 1UL));
+    Bench(2UL, 1UL, &u32Eqei, &u32Ecap);
+    HOST_CHECK((u32Eqei == 1UL) && (u32Ecap == 3UL));
+    HOST_CHECK(s_sEnc.u32Method == EQEI_ENC_METHOD_T);
+
+    /* M-method */
+    Bench(40UL, 1UL, &u32Eqei, &u32Ecap);
+    HOST_CHECK((u32Eqei == 1UL) && (u32Ecap == 3UL));
+    HOST_CHECK(s_sEnc.u32Method == EQEI_ENC_METHOD_M);
+    Bench(40UL, 0UL, &u32Eqei, &u32Ecap);
+    HOST_CHECK((u32Eqei == 1UL) && (u32Ecap == 1UL));
+
+    /* Host time per update, registers as plain memory */
+    HostReg_Trap(0UL);
+    EQEI_EncoderInit(&s_sEnc, EQEI0, ECAP0, ECAP_IC0, BENCH_ECAP_CLK, BENCH_UPDATE_HZ, 2UL);
+    u64Start = HostBench_Ns();
+    for(i = 0UL; i < BENCH_LOOPS; i++)
+    {
+        EQEI0->CNT += 2UL;
+        ECAP0->HLD0 = (ECAP0->HLD0 + 5000UL) & EQEI_ENC_ECAP_CNT_MSK;
+        ECAP0->STATUS = (i & 1UL) ? ECAP_STATUS_CAPTF0_Msk : 0UL;
+        EQEI_EncoderUpdate(&s_sEnc);
+    }
+    u64TNs = HostBench_Ns() - u64Start;
+    HOST_CHECK(s_sEnc.u32Method == EQEI_ENC_METHOD_T);
+
+    u64Start = HostBench_Ns();
+    for(i = 0UL; i < BENCH_LOOPS; i++)
+    {
+        EQEI0->CNT += 40UL;
+        ECAP0->HLD0 = (ECAP0->HLD0 + 50UL) & EQEI_ENC_ECAP_CNT_MSK;
+        ECAP0->STATUS = ECAP_STATUS_CAPTF0_Msk;
+        EQEI_EncoderUpdate(&s_sEnc);
+    }
+    u64MNs = HostBench_Ns() - u64Start;
+    HOST_CHECK(s_sEnc.u32Method == EQEI_ENC_METHOD_M);
+
+    printf("EQEI_EncoderUpdate T-method: 1 EQEI + 1..3 ECAP accesses, %5.1f ns/update\n", (double)u64TNs / BENCH_LOOPS);
+    printf("EQEI_EncoderUpdate M-method: 1 EQEI + 1..3 ECAP accesses, %5.1f ns/update\n", (double)u64MNs / BENCH_LOOPS);
+
+    return HostTest_Result("eqei_enc_bench");
+}
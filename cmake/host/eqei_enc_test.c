@@ -0,0 +1,269 @@
+/**************************************************************************//**
+ * @file     eqei_enc_test.c
+ * @brief    Host test of the EQEI encoder estimator on replayed waveforms
+ *
+ * A quadrature encoder is replayed in 1 us steps: EQEI0 counts in X4 mode
+ * and ECAP0 time stamps both edges of phase A with a 1 MHz counter, so two
+ * counts lie between captured edges. The registers are set once per update
+ * period, with the count and the last edge, which is all the estimator
+ * sees. EQEI_EncoderUpdate runs at 1 kHz and its position, velocity,
+ * acceleration and method are checked against the waveform at constant
+ * speed, on a ramp through the M/T switch, at stand still and across the
+ * counter wrap of compare-counting mode.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2024 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+#include "host_regs.h"
+
+#define TEST_ECAP_CLK           1000000UL
+#define TEST_UPDATE_HZ          1000UL
+#define TEST_US_PER_UPDATE      (TEST_ECAP_CLK / TEST_UPDATE_HZ)
+#define TEST_CNT_PER_CAP        2UL
+#define TEST_Q8                 256.0
+
+static S_EQEI_ENC_T s_sEnc;
+static uint64_t s_u64Us;            /* ECAP counter, not wrapped */
+static double   s_dPos;             /* Encoder position in counts */
+static int64_t  s_i64Cnt;           /* Whole counts, what EQEI counted */
+static int64_t  s_i64Start;         /* s_i64Cnt at EQEI_EncoderInit */
+static uint32_t s_u32Range;         /* CNTMAX + 1, 0 for 2^32 */
+static uint32_t s_u32Methods[3];    /* Updates per method of the last replay */
+static double   s_dAccSum;          /* Sum of the acceleration estimates of the last replay */
+
+static uint32_t W1cWrite(uint32_t u32Addr, uint32_t u32Old, uint32_t u32New)
+{
+    (void)u32Addr;
+    return u32Old & ~u32New;
+}
+
+static int64_t Floor(double d)
+{
+    int64_t i64 = (int64_t)d;
+
+    return ((double)i64 > d) ? (i64 - 1) : i64;
+}
+
+static double Abs(double d)
+{
+    return (d < 0.0) ? -d : d;
+}
+
+/* Phase A changes at every even count */
+static int64_t EdgeA(int64_t i64Cnt)
+{
+    return (i64Cnt >= 0) ? (i64Cnt / 2) : ((i64Cnt - 1) / 2);
+}
+
+/* Moves the encoder to dPos. Returns 1 if phase A had an edge, which ECAP time stamps. */
+static uint32_t Move(double dPos)
+{
+    int64_t i64Cnt = Floor(dPos), i64Old = s_i64Cnt;
+
+    s_dPos = dPos;
+    s_i64Cnt = i64Cnt;
+    return (EdgeA(i64Cnt) != EdgeA(i64Old)) ? 1UL : 0UL;
+}
+
+/* The registers as the estimator sees them at the update: EQEI count and the last latched edge */
+static void Latch(uint32_t u32Edge, uint32_t u32EdgeUs)
+{
+    uint32_t u32Cnt = (uint32_t)s_i64Cnt;
+
+    if(s_u32Range != 0UL)
+        u32Cnt = (uint32_t)(((s_i64Cnt % (int64_t)s_u32Range) + s_u32Range) % s_u32Range);
+    HostReg_Set(&EQEI0->CNT, u32Cnt);
+
+    if(u32Edge)
+    {
+        HostReg_Set(&ECAP0->HLD0, u32EdgeUs & EQEI_ENC_ECAP_CNT_MSK);
+        HostReg_Set(&ECAP0->STATUS, HostReg_Get(&ECAP0->STATUS) | ECAP_STATUS_CAPTF0_Msk);
+    }
+}
+
+static void Restart(uint32_t u32CntMax)
+{
+    HostReg_Reset();
+    HostReg_SetHook(&ECAP0->STATUS, NULL, W1cWrite);
+    HostReg_Trap(1UL);
+
+    s_u64Us = 0x123456ULL;
+    s_dPos = 0.5;
+    s_i64Cnt = 0;
+    s_u32Range = (u32CntMax == 0UL) ? 0UL : (u32CntMax + 1UL);
+    EQEI_Open(EQEI0, (u32CntMax == 0UL) ? EQEI_CTL_X4_FREE_COUNTING_MODE : EQEI_CTL_X4_COMPARE_COUNTING_MODE, u32CntMax);
+    EQEI_Start(EQEI0);
+    EQEI_EncoderInit(&s_sEnc, EQEI0, ECAP0, ECAP_IC0, TEST_ECAP_CLK, TEST_UPDATE_HZ, TEST_CNT_PER_CAP);
+    s_i64Start = s_i64Cnt;
+}
+
+/*
+ * Replays u32Ms milliseconds at velocity dVel + dAcc * t (counts/s) and returns the largest velocity error
+ * in counts/s after u32SettleMs. The allowed error is one count per update in M-method; in T-method the
+ * measured interval ends at the last edge, so it lags by up to one edge interval and one update period.
+ */
+static double Replay(double dVel, double dAcc, uint32_t u32Ms, uint32_t u32SettleMs, double *pdExcess)
+{
+    double dMaxErr = 0.0, dErr, dTol, dV, dT;
+    uint32_t u32Update, u32Us, u32Edge, u32EdgeUs;
+
+    s_u32Methods[0] = s_u32Methods[1] = s_u32Methods[2] = 0UL;
+    s_dAccSum = 0.0;
+    *pdExcess = 0.0;
+
+    for(u32Update = 0UL; u32Update < u32Ms; u32Update++)
+    {
+        u32Edge = u32EdgeUs = 0UL;
+        for(u32Us = 1UL; u32Us <= TEST_US_PER_UPDATE; u32Us++)
+        {
+            dT = (u32Update * TEST_US_PER_UPDATE + u32Us) / (double)TEST_ECAP_CLK;
+            s_u64Us++;
+            if(Move(s_dPos + (dVel + dAcc * dT) / TEST_ECAP_CLK))
+            {
+                u32Edge = 1UL;
+                u32EdgeUs = (uint32_t)s_u64Us;
+            }
+        }
+        Latch(u32Edge, u32EdgeUs);
+        EQEI_EncoderUpdate(&s_sEnc);
+
+        HOST_CHECK(s_sEnc.i32Pos == (int32_t)(s_i64Cnt - s_i64Start));
+        s_u32Methods[s_sEnc.u32Method]++;
+        s_dAccSum += s_sEnc.i32Acc / TEST_Q8;
+        if(u32Update < u32SettleMs)
+            continue;
+
+        dV = dVel + dAcc * ((u32Update + 1UL) / (double)TEST_UPDATE_HZ);
+        dErr = Abs(s_sEnc.i32Vel / TEST_Q8 - dV);
+        if(s_sEnc.u32Method == EQEI_ENC_METHOD_M)
+            dTol = TEST_UPDATE_HZ + Abs(dAcc) / TEST_UPDATE_HZ;
+        else
+            dTol = 0.01 * Abs(dV) + Abs(dAcc) * (TEST_CNT_PER_CAP / Abs(dV) + 2.0 / TEST_UPDATE_HZ);
+        if(dErr > dMaxErr)
+            dMaxErr = dErr;
+        if(dErr - dTol > *pdExcess)
+            *pdExcess = dErr - dTol;
+    }
+
+    return dMaxErr;
+}
+
+/* Constant speeds on both sides of the M/T switch, both directions */
+static void TestConstant(void)
+{
+    double dExcess, dErr;
+
+    /* 0.2 counts per update: T-method, limited by the 1 us time stamp */
+    Restart(0UL);
+    dErr = Replay(200.0, 0.0, 500UL, 50UL, &dExcess);
+    HOST_CHECK(dExcess == 0.0);
+    HOST_CHECK(dErr < 1.0);
+    HOST_CHECK(s_sEnc.u32Method == EQEI_ENC_METHOD_T);
+
+    dErr = Replay(-350.0, 0.0, 500UL, 50UL, &dExcess);
+    HOST_CHECK(dExcess == 0.0);
+    HOST_CHECK(dErr < 2.0);
+    HOST_CHECK(s_sEnc.i32Vel < 0);
+
+    /* 12.5 counts per update: still T-method, below EQEI_ENC_M_ENTER_CNT */
+    dErr = Replay(12500.0, 0.0, 200UL, 20UL, &dExcess);
+    HOST_CHECK(dExcess == 0.0);
+    HOST_CHECK(s_sEnc.u32Method == EQEI_ENC_METHOD_T);
+
+    /* 33.3 counts per update: M-method, one count of quantization */
+    dErr = Replay(33333.3, 0.0, 200UL, 20UL, &dExcess);
+    HOST_CHECK(dExcess == 0.0);
+    HOST_CHECK(s_u32Methods[EQEI_ENC_METHOD_M] >= 199UL);
+
+    dErr = Replay(-33333.3, 0.0, 200UL, 20UL, &dExcess);
+    HOST_CHECK(dExcess == 0.0);
+    HOST_CHECK(s_sEnc.u32Method == EQEI_ENC_METHOD_M);
+    (void)dErr;
+}
+
+/* Acceleration through the M/T switch, with hysteresis on the way down */
+static void TestRamp(void)
+{
+    double dExcess;
+
+    Restart(0UL);
+    (void)Replay(500.0, 0.0, 100UL, 0UL, &dExcess);
+
+    /* 500 -> 40500 counts/s in 2 s */
+    (void)Replay(500.0, 20000.0, 2000UL, 10UL, &dExcess);
+    HOST_CHECK(dExcess == 0.0);
+    HOST_CHECK(s_sEnc.u32Method == EQEI_ENC_METHOD_M);
+    /* T-method up to the first update of 16 counts, which comes between 15000 counts/s (0.725 s) and
+       16000 counts/s (0.775 s) depending on the count phase */
+    HOST_CHECK((s_u32Methods[EQEI_ENC_METHOD_T] >= 725UL) && (s_u32Methods[EQEI_ENC_METHOD_T] <= 775UL));
+    HOST_CHECK(Abs(s_dAccSum / 2000.0 - 20000.0) < 2000.0);
+
+    /* Back down to 500 counts/s: M-method holds until the first update below 8 counts, between 8000
+       counts/s (1.625 s) and 7000 counts/s (1.675 s) */
+    (void)Replay(40500.0, -20000.0, 2000UL, 10UL, &dExcess);
+    HOST_CHECK(dExcess == 0.0);
+    HOST_CHECK((s_u32Methods[EQEI_ENC_METHOD_M] >= 1625UL) && (s_u32Methods[EQEI_ENC_METHOD_M] <= 1675UL));
+    HOST_CHECK(Abs(s_dAccSum / 2000.0 + 20000.0) < 2000.0);
+}
+
+/* After the last edge the estimate decays and is 0 once the ECAP range has passed */
+static void TestStop(void)
+{
+    double dExcess, dIdle;
+    uint32_t u32Update, u32Us;
+
+    Restart(0UL);
+    (void)Replay(200.0, 0.0, 200UL, 0UL, &dExcess);
+    HOST_CHECK(s_sEnc.i32Vel > 0);
+
+    dIdle = 0.0;
+    for(u32Update = 0UL; u32Update < 18000UL; u32Update++)
+    {
+        for(u32Us = 0UL; u32Us < TEST_US_PER_UPDATE; u32Us++)
+            s_u64Us++;
+        dIdle += 1.0 / TEST_UPDATE_HZ;
+        EQEI_EncoderUpdate(&s_sEnc);
+
+        /* Never above one edge interval per idle time */
+        HOST_CHECK(s_sEnc.i32Vel / TEST_Q8 <= TEST_CNT_PER_CAP / dIdle + 1.0);
+        HOST_CHECK(s_sEnc.i32Vel >= 0);
+        if(s_sEnc.u32Method == EQEI_ENC_METHOD_STOP)
+            break;
+    }
+    HOST_CHECK(s_sEnc.u32Method == EQEI_ENC_METHOD_STOP);
+    HOST_CHECK(s_sEnc.i32Vel == 0);
+    /* The 24-bit ECAP counter covers 16.7 s at 1 MHz, the last edge was up to 10 ms before */
+    HOST_CHECK((dIdle > 16.7) && (dIdle < 16.8));
+
+    /* Moving again: the first edge only sets the time base, the second gives a speed */
+    (void)Replay(500.0, 0.0, 50UL, 10UL, &dExcess);
+    HOST_CHECK(dExcess == 0.0);
+    HOST_CHECK(s_sEnc.u32Method == EQEI_ENC_METHOD_T);
+}
+
+/* Position unwraps across CNTMAX in both directions */
+static void TestWrap(void)
+{
+    double dExcess;
+
+    Restart(999UL);
+    (void)Replay(30000.0, 0.0, 1000UL, 10UL, &dExcess);
+    HOST_CHECK(dExcess == 0.0);
+    HOST_CHECK(s_sEnc.i32Pos > 29000);
+    (void)Replay(-30000.0, 0.0, 1500UL, 10UL, &dExcess);
+    HOST_CHECK(dExcess == 0.0);
+    HOST_CHECK(s_sEnc.i32Pos < -14000);
+    HOST_CHECK(HostReg_Get(&EQEI0->CNT) <= 999UL);
+}
+
+int main(void)
+{
+    TestConstant();
+    TestRamp();
+    TestStop();
+    TestWrap();
+
+    return HostTest_Result("eqei_enc");
+}
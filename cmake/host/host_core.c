@@ -0,0 +1,18 @@
+/**************************************************************************//**
+ * @file     host_core.c
+ * @brief    Core peripherals of the host stand-in for the CMSIS core headers
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2024 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#include "host_core.h"
+
+static SysTick_Type s_sSysTick;
+static SCB_Type s_sScb;
+static CoreDebug_Type s_sCoreDebug;
+static DWT_Type s_sDwt;
+
+SysTick_Type *SysTick = &s_sSysTick;
+SCB_Type *SCB = &s_sScb;
+CoreDebug_Type *CoreDebug = &s_sCoreDebug;
+DWT_Type *DWT = &s_sDwt;
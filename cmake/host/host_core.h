@@ -0,0 +1,110 @@
+/**************************************************************************//**
+ * @file     host_core.h
+ * @brief    Host stand-in for the CMSIS core headers
+ *
+ * Lets the StdDriver sources build and the host tests run on a PC. Core
+ * intrinsics are no-ops and the core peripherals are plain structures
+ * defined in host_core.c. Device peripherals keep their fixed addresses,
+ * which host tests back with memory through host_regs.h.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2024 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __HOST_CORE_H__
+#define __HOST_CORE_H__
+
+#include <stdint.h>
+
+#define __I                     volatile const
+#define __O                     volatile
+#define __IO                    volatile
+#define __IM                    volatile const
+#define __OM                    volatile
+#define __IOM                   volatile
+
+#define __ASM                   __asm__
+#define __INLINE                inline
+#define __STATIC_INLINE         static inline
+#define __WEAK                  __attribute__((weak))
+#define __USED                  __attribute__((used))
+#define __PACKED                __attribute__((packed))
+#define __NO_RETURN             __attribute__((noreturn))
+#define __ALIGNED(x)            __attribute__((aligned(x)))
+
+#define __NOP()                 do {} while(0)
+#define __WFI()                 do {} while(0)
+#define __WFE()                 do {} while(0)
+#define __DSB()                 __sync_synchronize()
+#define __ISB()                 __sync_synchronize()
+#define __DMB()                 __sync_synchronize()
+#define __disable_irq()         do {} while(0)
+#define __enable_irq()          do {} while(0)
+#define __get_PRIMASK()         0UL
+#define __set_PRIMASK(x)        ((void)(x))
+#define __get_IPSR()            0UL
+#define __CLZ(x)                ((uint32_t)__builtin_clz(x))
+#define __REV(x)                __builtin_bswap32(x)
+
+typedef struct
+{
+    __IO uint32_t CTRL;
+    __IO uint32_t LOAD;
+    __IO uint32_t VAL;
+    __I  uint32_t CALIB;
+} SysTick_Type;
+
+typedef struct
+{
+    __I  uint32_t CPUID;
+    __IO uint32_t ICSR;
+    __IO uint32_t VTOR;
+    __IO uint32_t AIRCR;
+    __IO uint32_t SCR;
+    __IO uint32_t CCR;
+    __IO uint8_t  SHP[12];
+    __IO uint32_t SHCSR;
+    __IO uint32_t CFSR;
+    __IO uint32_t HFSR;
+    __IO uint32_t DFSR;
+    __IO uint32_t MMFAR;
+    __IO uint32_t BFAR;
+    __IO uint32_t AFSR;
+    __IO uint32_t CPACR;
+} SCB_Type;
+
+typedef struct
+{
+    __IO uint32_t DEMCR;
+} CoreDebug_Type;
+
+typedef struct
+{
+    __IO uint32_t CTRL;
+    __IO uint32_t CYCCNT;
+} DWT_Type;
+
+extern SysTick_Type *SysTick;
+extern SCB_Type *SCB;
+extern CoreDebug_Type *CoreDebug;
+extern DWT_Type *DWT;
+
+#define SysTick_CTRL_ENABLE_Msk         (1UL << 0)
+#define SysTick_CTRL_TICKINT_Msk        (1UL << 1)
+#define SysTick_CTRL_CLKSOURCE_Pos      2U
+#define SysTick_CTRL_CLKSOURCE_Msk      (1UL << SysTick_CTRL_CLKSOURCE_Pos)
+#define SysTick_CTRL_COUNTFLAG_Msk      (1UL << 16)
+#define SysTick_LOAD_RELOAD_Msk         0xFFFFFFUL
+#define SCB_SCR_SLEEPDEEP_Msk           (1UL << 2)
+#define SCB_AIRCR_VECTKEY_Pos           16U
+#define SCB_AIRCR_SYSRESETREQ_Msk       (1UL << 2)
+#define CoreDebug_DEMCR_TRCENA_Msk      (1UL << 24)
+#define DWT_CTRL_CYCCNTENA_Msk          (1UL << 0)
+
+__STATIC_INLINE void NVIC_EnableIRQ(int32_t IRQn) { (void)IRQn; }
+__STATIC_INLINE void NVIC_DisableIRQ(int32_t IRQn) { (void)IRQn; }
+__STATIC_INLINE void NVIC_ClearPendingIRQ(int32_t IRQn) { (void)IRQn; }
+__STATIC_INLINE void NVIC_SetPriority(int32_t IRQn, uint32_t priority) { (void)IRQn; (void)priority; }
+__STATIC_INLINE void NVIC_SystemReset(void) {}
+__STATIC_INLINE uint32_t SysTick_Config(uint32_t ticks) { (void)ticks; return 0UL; }
+
+#endif /* __HOST_CORE_H__ */
@@ -0,0 +1,382 @@
+/**************************************************************************//**
+ * @file     host_regs.c
+ * @brief    Register stub backing of the host build, see host_regs.h
+ *
+ * Trapping protects the windows. A faulting access unprotects its page,
+ * runs the read hook, and single-steps the instruction with the trap flag;
+ * the trap then runs the write hook and protects the page again. Each access
+ * instruction counts once; a read-modify-write instruction counts as a write
+ * and only runs the write hook. This needs an x86-64 Linux host.
+ *
+ * The interrupt of a model is SIGUSR1. It is blocked while the trap handlers
+ * run, so one raised by a write hook is taken right after the instruction
+ * that wrote the register, and one raised inside the interrupt is taken
+ * when the interrupt returns.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2024 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#define _GNU_SOURCE
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include "host_regs.h"
+
+#define HOST_PAGE_SIZE      0x1000UL
+#define HOST_PENDING_MAX    4UL
+#define HOST_EFLAGS_TF      0x100UL
+#define HOST_PF_ERR_WRITE   0x2UL
+
+typedef struct
+{
+    uint32_t u32Base;
+    uint32_t u32Size;
+} HOST_REG_WIN_T;
+
+typedef struct
+{
+    uint32_t u32Addr;
+    HOST_REG_READ_FUNC pfnRead;
+    HOST_REG_WRITE_FUNC pfnWrite;
+} HOST_REG_HOOK_T;
+
+typedef struct
+{
+    uint32_t u32Page;
+    uint32_t u32Reg;
+    uint32_t u32Old;
+    uint32_t u32Write;
+} HOST_REG_PENDING_T;
+
+/* Peripheral windows of the M460, M480 and M2L31 device headers */
+static const HOST_REG_WIN_T s_asHostRegWin[] =
+{
+    { 0x40000000UL, 0x00200000UL },
+    { 0x50000000UL, 0x00200000UL },
+};
+
+static HOST_REG_HOOK_T s_asHostRegHook[HOST_REG_HOOK_MAX];
+static uint32_t s_u32HostRegHookCnt;
+static HOST_REG_PENDING_T s_asHostRegPending[HOST_PENDING_MAX];
+static uint32_t s_u32HostRegPendingCnt;
+static uint32_t s_u32HostRegInit, s_u32HostRegTrap;
+static uint32_t s_u32HostRegCntBase, s_u32HostRegCntEnd = 0xFFFFFFFFUL;
+static volatile uint32_t s_u32HostRegReads, s_u32HostRegWrites;
+static HOST_REG_IRQ_FUNC s_pfnHostRegIrq;
+
+uint32_t g_u32HostTestFail;
+
+static int32_t HostReg_InWindow(uintptr_t uAddr)
+{
+    uint32_t i;
+
+    for(i = 0UL; i < sizeof(s_asHostRegWin) / sizeof(s_asHostRegWin[0]); i++)
+    {
+        if((uAddr >= s_asHostRegWin[i].u32Base) && (uAddr < (uintptr_t)s_asHostRegWin[i].u32Base + s_asHostRegWin[i].u32Size))
+            return 1;
+    }
+    return 0;
+}
+
+static HOST_REG_HOOK_T *HostReg_FindHook(uint32_t u32Addr)
+{
+    uint32_t i;
+
+    for(i = 0UL; i < s_u32HostRegHookCnt; i++)
+    {
+        if(s_asHostRegHook[i].u32Addr == u32Addr)
+            return &s_asHostRegHook[i];
+    }
+    return NULL;
+}
+
+static void HostReg_Protect(int i32Prot)
+{
+    uint32_t i;
+
+    for(i = 0UL; i < sizeof(s_asHostRegWin) / sizeof(s_asHostRegWin[0]); i++)
+        mprotect((void *)(uintptr_t)s_asHostRegWin[i].u32Base, s_asHostRegWin[i].u32Size, i32Prot);
+}
+
+static void HostReg_SegvHandler(int i32Sig, siginfo_t *psInfo, void *pvCtx)
+{
+    ucontext_t *psUc = (ucontext_t *)pvCtx;
+    uintptr_t uAddr = (uintptr_t)psInfo->si_addr;
+    HOST_REG_PENDING_T *psPend;
+    HOST_REG_HOOK_T *psHook;
+
+    (void)i32Sig;
+
+    if(!s_u32HostRegTrap || !HostReg_InWindow(uAddr) || (s_u32HostRegPendingCnt >= HOST_PENDING_MAX))
+    {
+        /* A real fault: let it kill the process */
+        signal(SIGSEGV, SIG_DFL);
+        return;
+    }
+
+    psPend = &s_asHostRegPending[s_u32HostRegPendingCnt++];
+    psPend->u32Page = (uint32_t)(uAddr & ~(HOST_PAGE_SIZE - 1UL));
+    psPend->u32Reg = (uint32_t)(uAddr & ~3UL);
+    psPend->u32Write = (psUc->uc_mcontext.gregs[REG_ERR] & HOST_PF_ERR_WRITE) ? 1UL : 0UL;
+    mprotect((void *)(uintptr_t)psPend->u32Page, HOST_PAGE_SIZE, PROT_READ | PROT_WRITE);
+
+    psPend->u32Old = *(volatile uint32_t *)(uintptr_t)psPend->u32Reg;
+    psHook = HostReg_FindHook(psPend->u32Reg);
+    if(!psPend->u32Write && (psHook != NULL) && (psHook->pfnRead != NULL))
+    {
+        psPend->u32Old = psHook->pfnRead(psPend->u32Reg, psPend->u32Old);
+        *(volatile uint32_t *)(uintptr_t)psPend->u32Reg = psPend->u32Old;
+    }
+
+    if((psPend->u32Reg >= s_u32HostRegCntBase) && (psPend->u32Reg <= s_u32HostRegCntEnd))
+    {
+        if(psPend->u32Write)
+            s_u32HostRegWrites++;
+        else
+            s_u32HostRegReads++;
+    }
+
+    psUc->uc_mcontext.gregs[REG_EFL] |= HOST_EFLAGS_TF;
+}
+
+static void HostReg_TrapHandler(int i32Sig, siginfo_t *psInfo, void *pvCtx)
+{
+    ucontext_t *psUc = (ucontext_t *)pvCtx;
+    HOST_REG_PENDING_T *psPend;
+    HOST_REG_HOOK_T *psHook;
+    uint32_t i, u32New;
+
+    (void)i32Sig;
+    (void)psInfo;
+
+    for(i = 0UL; i < s_u32HostRegPendingCnt; i++)
+    {
+        psPend = &s_asHostRegPending[i];
+        psHook = HostReg_FindHook(psPend->u32Reg);
+        if(psPend->u32Write && (psHook != NULL) && (psHook->pfnWrite != NULL))
+        {
+            u32New = *(volatile uint32_t *)(uintptr_t)psPend->u32Reg;
+            *(volatile uint32_t *)(uintptr_t)psPend->u32Reg = psHook->pfnWrite(psPend->u32Reg, psPend->u32Old, u32New);
+        }
+        mprotect((void *)(uintptr_t)psPend->u32Page, HOST_PAGE_SIZE, PROT_NONE);
+    }
+    s_u32HostRegPendingCnt = 0UL;
+
+    psUc->uc_mcontext.gregs[REG_EFL] &= ~HOST_EFLAGS_TF;
+}
+
+static void HostReg_IrqHandler(int i32Sig)
+{
+    (void)i32Sig;
+
+    if(s_pfnHostRegIrq != NULL)
+        s_pfnHostRegIrq();
+}
+
+/**
+  * @brief      Map the peripheral windows
+  * @details    Called by the other functions, so tests only need it to touch registers first.
+  */
+void HostReg_Init(void)
+{
+    struct sigaction sAct;
+    uint32_t i;
+    void *pvMap;
+
+    if(s_u32HostRegInit)
+        return;
+
+    for(i = 0UL; i < sizeof(s_asHostRegWin) / sizeof(s_asHostRegWin[0]); i++)
+    {
+        pvMap = mmap((void *)(uintptr_t)s_asHostRegWin[i].u32Base, s_asHostRegWin[i].u32Size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+        if(pvMap != (void *)(uintptr_t)s_asHostRegWin[i].u32Base)
+        {
+            fprintf(stderr, "cannot map registers at 0x%08lx\n", (unsigned long)s_asHostRegWin[i].u32Base);
+            exit(2);
+        }
+    }
+
+    memset(&sAct, 0, sizeof(sAct));
+    sAct.sa_flags = SA_SIGINFO | SA_NODEFER;
+    sigemptyset(&sAct.sa_mask);
+    sigaddset(&sAct.sa_mask, SIGUSR1);
+    sAct.sa_sigaction = HostReg_SegvHandler;
+    sigaction(SIGSEGV, &sAct, NULL);
+    sAct.sa_sigaction = HostReg_TrapHandler;
+    sigaction(SIGTRAP, &sAct, NULL);
+
+    /* Not SA_NODEFER: an interrupt raised by the interrupt waits for it to return */
+    sAct.sa_flags = SA_RESTART;
+    sigemptyset(&sAct.sa_mask);
+    sAct.sa_handler = HostReg_IrqHandler;
+    sigaction(SIGUSR1, &sAct, NULL);
+
+    s_u32HostRegInit = 1UL;
+}
+
+/* Map the windows before main() so that drivers may be called at once */
+__attribute__((constructor)) static void HostReg_AutoInit(void)
+{
+    HostReg_Init();
+}
+
+/**
+  * @brief      Clear every register, hook and counter and stop trapping
+  */
+void HostReg_Reset(void)
+{
+    uint32_t i;
+
+    HostReg_Init();
+    HostReg_Trap(0UL);
+    for(i = 0UL; i < sizeof(s_asHostRegWin) / sizeof(s_asHostRegWin[0]); i++)
+        memset((void *)(uintptr_t)s_asHostRegWin[i].u32Base, 0, s_asHostRegWin[i].u32Size);
+    HostReg_ClearHooks();
+    HostReg_SetIrq(NULL);
+    HostReg_SetCountWindow(NULL, 0UL);
+    HostReg_ResetCount();
+}
+
+/**
+  * @brief      Start or stop trapping register accesses
+  * @param[in]  u32On   1 to count accesses and run hooks, 0 for plain memory
+  */
+void HostReg_Trap(uint32_t u32On)
+{
+    HostReg_Init();
+    s_u32HostRegTrap = u32On;
+    HostReg_Protect(u32On ? PROT_NONE : (PROT_READ | PROT_WRITE));
+}
+
+/**
+  * @brief      Set the hooks of one 32-bit register
+  * @param[in]  pvReg       Register address
+  * @param[in]  pfnRead     Read hook, NULL if not used
+  * @param[in]  pfnWrite    Write hook, NULL if not used
+  * @retval     0           Success
+  * @retval     -1          Too many hooks
+  */
+int32_t HostReg_SetHook(volatile void *pvReg, HOST_REG_READ_FUNC pfnRead, HOST_REG_WRITE_FUNC pfnWrite)
+{
+    uint32_t u32Addr = (uint32_t)(uintptr_t)pvReg & ~3UL;
+    HOST_REG_HOOK_T *psHook = HostReg_FindHook(u32Addr);
+
+    if(psHook == NULL)
+    {
+        if(s_u32HostRegHookCnt >= HOST_REG_HOOK_MAX)
+            return -1;
+        psHook = &s_asHostRegHook[s_u32HostRegHookCnt++];
+        psHook->u32Addr = u32Addr;
+    }
+    psHook->pfnRead = pfnRead;
+    psHook->pfnWrite = pfnWrite;
+
+    return 0;
+}
+
+/**
+  * @brief      Set the interrupt service of a peripheral model
+  * @param[in]  pfnIrq      Called for \ref HostReg_RaiseIrq, NULL to remove it
+  */
+void HostReg_SetIrq(HOST_REG_IRQ_FUNC pfnIrq)
+{
+    HostReg_Init();
+    s_pfnHostRegIrq = pfnIrq;
+}
+
+/**
+  * @brief      Raise the interrupt of the model
+  * @details    Call from a write hook. The interrupt runs after the instruction that wrote the
+  *             register, like an exception taken between two instructions on the CPU.
+  */
+void HostReg_RaiseIrq(void)
+{
+    raise(SIGUSR1);
+}
+
+/**
+  * @brief      Remove all hooks
+  */
+void HostReg_ClearHooks(void)
+{
+    s_u32HostRegHookCnt = 0UL;
+}
+
+/**
+  * @brief      Write a register without counting it or running its hooks
+  */
+void HostReg_Set(volatile void *pvReg, uint32_t u32Val)
+{
+    uint32_t u32Trap = s_u32HostRegTrap;
+
+    HostReg_Trap(0UL);
+    *(volatile uint32_t *)pvReg = u32Val;
+    HostReg_Trap(u32Trap);
+}
+
+/**
+  * @brief      Read a register without counting it or running its hooks
+  */
+uint32_t HostReg_Get(volatile void *pvReg)
+{
+    uint32_t u32Trap = s_u32HostRegTrap, u32Val;
+
+    HostReg_Trap(0UL);
+    u32Val = *(volatile uint32_t *)pvReg;
+    HostReg_Trap(u32Trap);
+
+    return u32Val;
+}
+
+/**
+  * @brief      Only count accesses to u32Size bytes from pvBase, 0 to count all
+  */
+void HostReg_SetCountWindow(volatile void *pvBase, uint32_t u32Size)
+{
+    s_u32HostRegCntBase = (u32Size != 0UL) ? (uint32_t)(uintptr_t)pvBase : 0UL;
+    s_u32HostRegCntEnd = (u32Size != 0UL) ? (uint32_t)(uintptr_t)pvBase + u32Size - 1UL : 0xFFFFFFFFUL;
+}
+
+void HostReg_ResetCount(void)
+{
+    s_u32HostRegReads = 0UL;
+    s_u32HostRegWrites = 0UL;
+}
+
+uint32_t HostReg_GetReadCount(void)
+{
+    return s_u32HostRegReads;
+}
+
+uint32_t HostReg_GetWriteCount(void)
+{
+    return s_u32HostRegWrites;
+}
+
+void HostTest_Fail(const char *pcFile, int i32Line, const char *pcCond)
+{
+    printf("%s:%d: check failed: %s\n", pcFile, i32Line, pcCond);
+    g_u32HostTestFail++;
+}
+
+/**
+  * @brief      Print the result of a host test and return its exit code
+  */
+int HostTest_Result(const char *pcName)
+{
+    printf("%s: %s, %lu failed checks\n", pcName, (g_u32HostTestFail == 0UL) ? "PASS" : "FAIL", (unsigned long)g_u32HostTestFail);
+    return (g_u32HostTestFail == 0UL) ? 0 : 1;
+}
+
+uint64_t HostBench_Ns(void)
+{
+    struct timespec sTs;
+
+    clock_gettime(CLOCK_MONOTONIC, &sTs);
+    return ((uint64_t)sTs.tv_sec * 1000000000ULL) + (uint64_t)sTs.tv_nsec;
+}
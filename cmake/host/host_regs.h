@@ -0,0 +1,73 @@
+/**************************************************************************//**
+ * @file     host_regs.h
+ * @brief    Register stub backing of the host build
+ *
+ * The peripheral windows of the device headers (0x40000000 and 0x50000000)
+ * are backed by ordinary memory, so driver code runs on a PC unchanged and
+ * the host tests see every register as a plain word. With trapping enabled
+ * each register access is caught, counted and passed to the read and write
+ * hooks of that register, which model flags such as write-one-to-clear
+ * status bits or a FIFO behind a data register.
+ *
+ * Host tests are linked as non-PIE executables so that static buffers have
+ * 32-bit addresses, as the PDMA and crypto drivers expect.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2024 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __HOST_REGS_H__
+#define __HOST_REGS_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define HOST_REG_HOOK_MAX       64      /*!< Registers that can have hooks at the same time */
+
+/**
+  * @details    Read hook. Returns the value the CPU reads, u32Val is the stored value.
+  *             The returned value is also stored.
+  */
+typedef uint32_t (*HOST_REG_READ_FUNC)(uint32_t u32Addr, uint32_t u32Val);
+
+/**
+  * @details    Write hook. Returns the value to store after the CPU wrote u32New over u32Old.
+  */
+typedef uint32_t (*HOST_REG_WRITE_FUNC)(uint32_t u32Addr, uint32_t u32Old, uint32_t u32New);
+
+/**
+  * @details    Interrupt of a peripheral model, see \ref HostReg_RaiseIrq.
+  */
+typedef void (*HOST_REG_IRQ_FUNC)(void);
+
+void     HostReg_Init(void);
+void     HostReg_Reset(void);
+void     HostReg_Trap(uint32_t u32On);
+int32_t  HostReg_SetHook(volatile void *pvReg, HOST_REG_READ_FUNC pfnRead, HOST_REG_WRITE_FUNC pfnWrite);
+void     HostReg_ClearHooks(void);
+void     HostReg_SetIrq(HOST_REG_IRQ_FUNC pfnIrq);
+void     HostReg_RaiseIrq(void);
+void     HostReg_Set(volatile void *pvReg, uint32_t u32Val);
+uint32_t HostReg_Get(volatile void *pvReg);
+void     HostReg_SetCountWindow(volatile void *pvBase, uint32_t u32Size);
+void     HostReg_ResetCount(void);
+uint32_t HostReg_GetReadCount(void);
+uint32_t HostReg_GetWriteCount(void);
+
+/* Check helper of the host tests: report the failed condition and count it */
+extern uint32_t g_u32HostTestFail;
+#define HOST_CHECK(cond)    do { if(!(cond)) HostTest_Fail(__FILE__, __LINE__, #cond); } while(0)
+void     HostTest_Fail(const char *pcFile, int i32Line, const char *pcCond);
+int      HostTest_Result(const char *pcName);
+
+/* Timing helper of the host benchmarks */
+uint64_t HostBench_Ns(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HOST_REGS_H__ */
@@ -0,0 +1,64 @@
+/**************************************************************************//**
+ * @file     host_regs_test.c
+ * @brief    Host test of the register stub backing
+ *
+ * Runs GPIO driver code against the stub registers with trapping on and
+ * checks the stored values, the access counts and a write-one-to-clear hook.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2024 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+#include "host_regs.h"
+
+static uint32_t s_u32Reads;
+
+/* INTSRC is write-one-to-clear */
+static uint32_t IntSrcWrite(uint32_t u32Addr, uint32_t u32Old, uint32_t u32New)
+{
+    (void)u32Addr;
+    return u32Old & ~u32New;
+}
+
+static uint32_t ModeRead(uint32_t u32Addr, uint32_t u32Val)
+{
+    (void)u32Addr;
+    s_u32Reads++;
+    return u32Val;
+}
+
+int main(void)
+{
+    HostReg_Reset();
+
+    /* Plain memory without trapping */
+    PA->DOUT = 0x1234UL;
+    HOST_CHECK(PA->DOUT == 0x1234UL);
+    HOST_CHECK(HostReg_GetWriteCount() == 0UL);
+
+    HostReg_SetHook(&PA->INTSRC, NULL, IntSrcWrite);
+    HostReg_SetHook(&PA->MODE, ModeRead, NULL);
+    HostReg_Set(&PA->INTSRC, 0x00F0UL);
+    HostReg_Trap(1UL);
+
+    GPIO_SetMode(PA, 0x0005UL, GPIO_MODE_OUTPUT);
+    HOST_CHECK(HostReg_Get(&PA->MODE) == ((GPIO_MODE_OUTPUT << 0) | (GPIO_MODE_OUTPUT << 4)));
+    HOST_CHECK(s_u32Reads == 2UL);
+    HOST_CHECK(HostReg_GetWriteCount() == 2UL);
+
+    GPIO_CLR_INT_FLAG(PA, 0x0030UL);
+    HOST_CHECK(HostReg_Get(&PA->INTSRC) == 0x00C0UL);
+
+    /* Only accesses inside the count window are counted */
+    HostReg_ResetCount();
+    HostReg_SetCountWindow(PB, sizeof(GPIO_T));
+    GPIO_SetMode(PA, 0x0001UL, GPIO_MODE_INPUT);
+    HOST_CHECK(HostReg_GetWriteCount() == 0UL);
+    GPIO_SetMode(PB, 0x0001UL, GPIO_MODE_INPUT);
+    HOST_CHECK(HostReg_GetWriteCount() == 1UL);
+
+    HostReg_Trap(0UL);
+
+    return HostTest_Result("host_regs");
+}
@@ -0,0 +1,382 @@
+/**************************************************************************//**
+ * @file     i2c_model.c
+ * @brief    I2C bus model of the host tests
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2024 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#include <string.h>
+#include "host_regs.h"
+#include "i2c_model.h"
+
+#define HOST_I2C_PENDING    (I2C_CTL0_SI_Msk | I2C_CTL0_STA_Msk | I2C_CTL0_STO_Msk)
+
+#define HOST_I2C_IDLE       0U      /* No transfer, or the bus belongs to another host */
+#define HOST_I2C_ADDR       1U      /* START sent, next byte is the address */
+#define HOST_I2C_TX         2U      /* Host transmitter */
+#define HOST_I2C_RX         3U      /* Host receiver */
+#define HOST_I2C_HELD       4U      /* Address not acknowledged, waiting for STOP or START */
+
+HOST_I2C_DEV_T g_sHostI2cDev;
+
+static I2C_T *s_pI2c;
+static HOST_I2C_IRQ_FUNC s_pfnIrq;
+static uint32_t s_u32State;
+static uint32_t s_u32Owned;         /* Bus owned since the last START, PEC accumulates */
+static uint32_t s_u32RspIdx;
+static uint8_t s_u8Crc;
+static PDMA_T *s_pPdma;             /* Target role: PDMA of the driver, NULL if not used */
+static uint32_t s_u32TxCh, s_u32RxCh;
+static uint32_t s_u32DmaIdx;        /* Bytes moved by the running PDMA transfer */
+static uint32_t s_u32Addressed;     /* Target role: the driver takes part in the running transfer */
+
+/* SMBus PEC, CRC-8 with polynomial x^8 + x^2 + x + 1 */
+static uint8_t HostI2c_CrcByte(uint8_t u8Crc, uint8_t u8Data)
+{
+    uint32_t i;
+
+    u8Crc ^= u8Data;
+    for(i = 0UL; i < 8UL; i++)
+        u8Crc = (uint8_t)((u8Crc & 0x80U) ? ((u8Crc << 1) ^ 0x07U) : (u8Crc << 1));
+    return u8Crc;
+}
+
+uint8_t HostI2c_Crc8(const uint8_t *pu8Data, uint32_t u32Len)
+{
+    uint8_t u8Crc = 0U;
+    uint32_t i;
+
+    for(i = 0UL; i < u32Len; i++)
+        u8Crc = HostI2c_CrcByte(u8Crc, pu8Data[i]);
+    return u8Crc;
+}
+
+static void HostI2c_Byte(uint8_t u8Data)
+{
+    HOST_I2C_DEV_T *psDev = &g_sHostI2cDev;
+
+    if(psDev->u32LogLen < HOST_I2C_LOG_MAX)
+        psDev->au8Log[psDev->u32LogLen++] = u8Data;
+    s_u8Crc = HostI2c_CrcByte(s_u8Crc, u8Data);
+    HostReg_Set(&s_pI2c->PKTCRC, s_u8Crc);
+}
+
+/* Byte the device drives in the read phase */
+static uint8_t HostI2c_DevByte(void)
+{
+    HOST_I2C_DEV_T *psDev = &g_sHostI2cDev;
+    uint32_t u32Idx = s_u32RspIdx++;
+
+    if(u32Idx < psDev->u32RspLen)
+        return psDev->au8Rsp[u32Idx];
+    if(u32Idx == psDev->u32RspLen)
+        return (uint8_t)(s_u8Crc ^ (psDev->u8BadPec ? 0x5AU : 0U));
+    return 0xFFU;
+}
+
+static void HostI2c_Raise(uint32_t u32Status)
+{
+    HOST_I2C_DEV_T *psDev = &g_sHostI2cDev;
+
+    if(++psDev->u32Steps == psDev->u32FaultAt)
+    {
+        if(psDev->u32Fault == HOST_I2C_FAULT_TIMEOUT)
+        {
+            s_pI2c->TOCTL |= I2C_TOCTL_TOIF_Msk;
+        }
+        else
+        {
+            /* The bus goes to the other host on arbitration loss, else waits for STOP */
+            u32Status = psDev->u32Fault;
+            s_u32State = (u32Status == 0x38UL) ? HOST_I2C_IDLE : HOST_I2C_HELD;
+            if(u32Status == 0x38UL)
+                s_u32Owned = 0UL;
+        }
+    }
+
+    HostReg_Set(&s_pI2c->STATUS0, u32Status);
+    if(s_pI2c->CTL0 & I2C_CTL0_INTEN_Msk)
+    {
+        psDev->u32Irqs++;
+        s_pfnIrq(s_pI2c);
+    }
+
+    /* TOIF is write-one-to-clear */
+    if(psDev->u32Steps == psDev->u32FaultAt)
+        s_pI2c->TOCTL &= ~I2C_TOCTL_TOIF_Msk;
+}
+
+static void HostI2c_Step(uint32_t u32Ctl)
+{
+    HOST_I2C_DEV_T *psDev = &g_sHostI2cDev;
+    uint8_t u8Data;
+
+    s_pI2c->CTL0 = u32Ctl & ~HOST_I2C_PENDING;
+
+    if(u32Ctl & I2C_CTL0_STO_Msk)
+    {
+        if(s_u32Owned)
+            psDev->u32Stops++;
+        s_u32Owned = 0UL;
+        s_u32State = HOST_I2C_IDLE;
+    }
+
+    if(u32Ctl & I2C_CTL0_STA_Msk)
+    {
+        if(!s_u32Owned)
+        {
+            /* PEC restarts at a START after STOP, PECCLR is not used */
+            psDev->au16Start[psDev->u32Packets++] = (uint16_t)psDev->u32LogLen;
+            s_u8Crc = 0U;
+            HostReg_Set(&s_pI2c->PKTCRC, 0UL);
+        }
+        s_u32RspIdx = 0UL;
+        s_u32State = HOST_I2C_ADDR;
+        HostI2c_Raise(s_u32Owned ? 0x10UL : 0x08UL);
+        s_u32Owned = 1UL;
+        return;
+    }
+
+    switch(s_u32State)
+    {
+    case HOST_I2C_ADDR:
+        u8Data = (uint8_t)s_pI2c->DAT;
+        HostI2c_Byte(u8Data);
+        if((u8Data >> 1) != psDev->u8Addr)
+        {
+            s_u32State = HOST_I2C_HELD;
+            HostI2c_Raise((u8Data & 1U) ? 0x48UL : 0x20UL);
+        }
+        else
+        {
+            s_u32State = (u8Data & 1U) ? HOST_I2C_RX : HOST_I2C_TX;
+            HostI2c_Raise((u8Data & 1U) ? 0x40UL : 0x18UL);
+        }
+        break;
+    case HOST_I2C_TX:
+        HostI2c_Byte((uint8_t)s_pI2c->DAT);
+        HostI2c_Raise(0x28UL);
+        break;
+    case HOST_I2C_RX:
+        u8Data = HostI2c_DevByte();
+        s_pI2c->DAT = u8Data;
+        HostI2c_Byte(u8Data);
+        HostI2c_Raise((u32Ctl & I2C_CTL0_AA_Msk) ? 0x50UL : 0x58UL);
+        break;
+    default:
+        break;
+    }
+}
+
+static void HostI2c_Irq(void)
+{
+    HostI2c_Step(s_pI2c->CTL0);
+}
+
+/* SI, STA or STO written: the controller starts the next bus step */
+static uint32_t HostI2c_CtlWrite(uint32_t u32Addr, uint32_t u32Old, uint32_t u32New)
+{
+    (void)u32Addr;
+    (void)u32Old;
+
+    if((u32New & HOST_I2C_PENDING) && !g_sHostI2cDev.u32Hold)
+        HostReg_RaiseIrq();
+    return u32New;
+}
+
+/* Target role: PDMA channel u32Ch is enabled by the I2C (u32En) and has bytes left */
+static int32_t HostI2c_DmaOn(uint32_t u32En, uint32_t u32Ch)
+{
+    return (s_pPdma != NULL) && (s_pI2c->CTL1 & u32En) && (s_pPdma->DSCT[u32Ch].CTL & PDMA_DSCT_CTL_OPMODE_Msk);
+}
+
+/* Target role: move one byte by PDMA, the channel goes idle after its last byte */
+static uint8_t *HostI2c_DmaByte(uint32_t u32Ch, uint32_t u32Addr)
+{
+    uint32_t u32Ctl = s_pPdma->DSCT[u32Ch].CTL;
+    uint8_t *pu8Mem = (uint8_t *)(uintptr_t)(u32Addr + s_u32DmaIdx++);
+
+    if(u32Ctl & PDMA_DSCT_CTL_TXCNT_Msk)
+        s_pPdma->DSCT[u32Ch].CTL = u32Ctl - (1UL << PDMA_DSCT_CTL_TXCNT_Pos);
+    else
+        s_pPdma->DSCT[u32Ch].CTL = u32Ctl & ~PDMA_DSCT_CTL_OPMODE_Msk;
+    return pu8Mem;
+}
+
+/* Target role: an own address register of the driver holds u8Addr and AA is set */
+static int32_t HostI2c_Addressed(uint8_t u8Addr)
+{
+    volatile uint32_t *apu32Addr[4];
+    uint32_t i;
+
+    apu32Addr[0] = &s_pI2c->ADDR0;
+    apu32Addr[1] = &s_pI2c->ADDR1;
+    apu32Addr[2] = &s_pI2c->ADDR2;
+    apu32Addr[3] = &s_pI2c->ADDR3;
+    if(!(s_pI2c->CTL0 & I2C_CTL0_AA_Msk))
+        return 0;
+    for(i = 0UL; i < 4UL; i++)
+    {
+        if(((*apu32Addr[i] >> 1) & 0x7FUL) == u8Addr)
+            return 1;
+    }
+    return 0;
+}
+
+/* Target role: START or repeated START, then the address byte */
+static int32_t HostI2c_BusStart(uint8_t u8Sla)
+{
+    HOST_I2C_DEV_T *psDev = &g_sHostI2cDev;
+
+    if(s_u32Addressed)
+        HostI2c_Raise(0xA0UL);              /* Repeated START ends the running transfer */
+    if(!s_u32Owned)
+        psDev->au16Start[psDev->u32Packets++] = (uint16_t)psDev->u32LogLen;
+    s_u32Owned = 1UL;
+    HostI2c_Byte(u8Sla);
+    s_u32Addressed = (uint32_t)HostI2c_Addressed((uint8_t)(u8Sla >> 1));
+    if(!s_u32Addressed)
+        return 0;
+
+    s_pI2c->DAT = u8Sla;
+    s_u32DmaIdx = 0UL;
+    HostI2c_Raise((u8Sla & 1U) ? 0xA8UL : 0x60UL);
+    return 1;
+}
+
+/**
+  * @details    Target role: the bus host writes pu8Data to u8Addr after a START, or a repeated START
+  *             if the bus is still owned. Returns the bytes the target acknowledged, -1 if the
+  *             address was not acknowledged. The bus is kept until \ref HostI2c_BusStop, so a
+  *             following write or read starts with a repeated START.
+  */
+int32_t HostI2c_BusWrite(uint8_t u8Addr, const uint8_t *pu8Data, uint32_t u32Len)
+{
+    uint32_t i;
+
+    if(!HostI2c_BusStart((uint8_t)(u8Addr << 1)))
+        return -1;
+
+    for(i = 0UL; i < u32Len; i++)
+    {
+        HostI2c_Byte(pu8Data[i]);
+        if(!(s_pI2c->CTL0 & I2C_CTL0_AA_Msk))
+        {
+            /* Received and not acknowledged, the host gives up */
+            s_pI2c->DAT = pu8Data[i];
+            HostI2c_Raise(0x88UL);
+            s_u32Addressed = 0UL;
+            break;
+        }
+        if(HostI2c_DmaOn(I2C_CTL1_RXPDMAEN_Msk, s_u32RxCh))
+        {
+            *HostI2c_DmaByte(s_u32RxCh, s_pPdma->DSCT[s_u32RxCh].DA) = pu8Data[i];
+            continue;
+        }
+        s_pI2c->DAT = pu8Data[i];
+        HostI2c_Raise(0x80UL);
+    }
+    return (int32_t)i;
+}
+
+/**
+  * @details    Target role: the bus host reads u32Len bytes from u8Addr, acknowledging all but the
+  *             last. Returns the bytes read, -1 if the address was not acknowledged.
+  */
+int32_t HostI2c_BusRead(uint8_t u8Addr, uint8_t *pu8Data, uint32_t u32Len)
+{
+    uint32_t i;
+
+    if(!HostI2c_BusStart((uint8_t)((u8Addr << 1) | 1U)))
+        return -1;
+
+    for(i = 0UL; i < u32Len; i++)
+    {
+        if(HostI2c_DmaOn(I2C_CTL1_TXPDMAEN_Msk, s_u32TxCh))
+        {
+            pu8Data[i] = *HostI2c_DmaByte(s_u32TxCh, s_pPdma->DSCT[s_u32TxCh].SA);
+        }
+        else
+        {
+            if(i != 0UL)
+                HostI2c_Raise(0xB8UL);      /* Previous byte acknowledged */
+            pu8Data[i] = (uint8_t)s_pI2c->DAT;
+        }
+        HostI2c_Byte(pu8Data[i]);
+    }
+    HostI2c_Raise(0xC0UL);                  /* Last byte not acknowledged */
+    s_u32Addressed = 0UL;
+    return (int32_t)i;
+}
+
+/**
+  * @details    Target role: STOP, ends the transfers of \ref HostI2c_BusWrite and \ref HostI2c_BusRead.
+  */
+void HostI2c_BusStop(void)
+{
+    if(s_u32Owned)
+        g_sHostI2cDev.u32Stops++;
+    if(s_u32Addressed)
+        HostI2c_Raise(0xA0UL);
+    s_u32Owned = 0UL;
+    s_u32Addressed = 0UL;
+}
+
+/**
+  * @details    Target role: start the model on port i2c, with the interrupt service of the driver.
+  *             pdma, u32TxCh and u32RxCh are the PDMA setting of the driver, pdma is NULL if not used.
+  */
+void HostI2c_StartTarget(I2C_T *i2c, HOST_I2C_IRQ_FUNC pfnIrq, PDMA_T *pdma, uint32_t u32TxCh, uint32_t u32RxCh)
+{
+    s_pI2c = i2c;
+    s_pfnIrq = pfnIrq;
+    s_pPdma = pdma;
+    s_u32TxCh = u32TxCh;
+    s_u32RxCh = u32RxCh;
+    HostReg_Reset();
+    HostI2c_Reset();
+}
+
+/**
+  * @details    Clear the device script, the log and the I2C registers.
+  */
+void HostI2c_Reset(void)
+{
+    memset(&g_sHostI2cDev, 0, sizeof(g_sHostI2cDev));
+    s_u32State = HOST_I2C_IDLE;
+    s_u32Owned = 0UL;
+    s_u32Addressed = 0UL;
+    s_u32RspIdx = 0UL;
+    s_u8Crc = 0U;
+    if(s_pI2c != NULL)
+    {
+        s_pI2c->CTL0 = 0UL;
+        s_pI2c->TOCTL = 0UL;
+        HostReg_Set(&s_pI2c->STATUS0, 0xF8UL);
+        HostReg_Set(&s_pI2c->PKTCRC, 0UL);
+    }
+}
+
+/**
+  * @details    Host role: start the model on port i2c with the scripted device. pfnIrq is the
+  *             interrupt service of the driver. Register trapping is turned on.
+  */
+void HostI2c_Start(I2C_T *i2c, HOST_I2C_IRQ_FUNC pfnIrq)
+{
+    s_pI2c = i2c;
+    s_pfnIrq = pfnIrq;
+    s_pPdma = NULL;
+    HostReg_Reset();
+    HostI2c_Reset();
+    HostReg_SetHook(&i2c->CTL0, NULL, HostI2c_CtlWrite);
+    HostReg_SetIrq(HostI2c_Irq);
+    HostReg_Trap(1UL);
+}
+
+/**
+  * @details    Stop the model and register trapping.
+  */
+void HostI2c_Stop(void)
+{
+    HostReg_Reset();
+}
@@ -0,0 +1,75 @@
+/**************************************************************************//**
+ * @file     i2c_model.h
+ * @brief    I2C bus model of the host tests
+ *
+ * Host role: a write hook on CTL0 stands in for the I2C controller. Each
+ * time the driver writes SI, STA or STO the model raises its interrupt,
+ * which moves the bus one step against a scripted device, updates STATUS0,
+ * DAT and the PKTCRC packet CRC and calls the interrupt handler of the
+ * driver. Thread code of the driver is preempted by its interrupt as on the
+ * CPU, and the blocking driver calls run unchanged.
+ *
+ * Target role: the test is the bus host. HostI2c_BusWrite, HostI2c_BusRead
+ * and HostI2c_BusStop clock bytes to and from the driver, acknowledged as
+ * its AA bit says, and call its interrupt handler for each target status.
+ * Bytes of a running PDMA transfer are moved without an interrupt.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2024 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __I2C_MODEL_H__
+#define __I2C_MODEL_H__
+
+#include <stdint.h>
+#include "NuMicro.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define HOST_I2C_RSP_MAX        64U     /*!< Bytes a device sends per transaction */
+#define HOST_I2C_LOG_MAX        512U    /*!< Bus bytes kept in the log */
+
+#define HOST_I2C_FAULT_TIMEOUT  0x100U  /*!< Fault that raises TOIF instead of a status */
+
+typedef void (*HOST_I2C_IRQ_FUNC)(I2C_T *i2c);
+
+/**
+  * @details    Scripted device on the bus. It acknowledges its address and every byte
+  *             written, and answers reads with au8Rsp followed by the PEC of the packet.
+  */
+typedef struct
+{
+    uint8_t  u8Addr;                        /*!< 7-bit address */
+    uint8_t  u8BadPec;                      /*!< 1 to send a wrong PEC */
+    uint8_t  au8Rsp[HOST_I2C_RSP_MAX];      /*!< Bytes sent in the read phase, restarted at each START */
+    uint32_t u32RspLen;
+    uint32_t u32FaultAt;                    /*!< Bus step that fails, 1 for the first START, 0 for none */
+    uint32_t u32Fault;                      /*!< Status of the failed step, or HOST_I2C_FAULT_TIMEOUT */
+    uint32_t u32Hold;                       /*!< 1 to stall the bus */
+    uint32_t u32Steps;                      /*!< Bus steps so far */
+    uint32_t u32Stops;                      /*!< STOPs sent */
+    uint32_t u32Irqs;                       /*!< Interrupts taken by the driver */
+    uint8_t  au8Log[HOST_I2C_LOG_MAX];      /*!< Bytes on the bus, address bytes included */
+    uint16_t au16Start[HOST_I2C_LOG_MAX];   /*!< Log index of each START that follows a STOP */
+    uint32_t u32LogLen;
+    uint32_t u32Packets;
+} HOST_I2C_DEV_T;
+
+extern HOST_I2C_DEV_T g_sHostI2cDev;
+
+void    HostI2c_Start(I2C_T *i2c, HOST_I2C_IRQ_FUNC pfnIrq);
+void    HostI2c_StartTarget(I2C_T *i2c, HOST_I2C_IRQ_FUNC pfnIrq, PDMA_T *pdma, uint32_t u32TxCh, uint32_t u32RxCh);
+int32_t HostI2c_BusWrite(uint8_t u8Addr, const uint8_t *pu8Data, uint32_t u32Len);
+int32_t HostI2c_BusRead(uint8_t u8Addr, uint8_t *pu8Data, uint32_t u32Len);
+void    HostI2c_BusStop(void);
+void    HostI2c_Stop(void);
+void    HostI2c_Reset(void);
+uint8_t HostI2c_Crc8(const uint8_t *pu8Data, uint32_t u32Len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __I2C_MODEL_H__ */
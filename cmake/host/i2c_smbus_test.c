@@ -0,0 +1,247 @@
+/**************************************************************************//**
+ * @file     i2c_smbus_test.c
+ * @brief    Host test of the SMBus transaction engine
+ *
+ * Runs the SMBus protocols, PEC and the ARP commands against the I2C bus
+ * model, and checks that a transaction list ended by arbitration loss, a
+ * bus error or a time-out reports that error for every transaction that
+ * did not run.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2024 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "NuMicro.h"
+#include "host_regs.h"
+#include "i2c_model.h"
+
+#define TEST_ADDR               0x30U
+
+/* Bus steps of a READ_WORD without PEC: START, SLA+W, command, repeated START, SLA+R, 2 data */
+#define TEST_READ_WORD_STEPS    7UL
+
+static uint32_t s_u32DoneCnt;
+static int32_t s_i32DoneStatus;
+
+static void Done(I2C_T *i2c, void *pvUser, int32_t i32Status)
+{
+    (void)i2c;
+    (void)pvUser;
+    s_u32DoneCnt++;
+    s_i32DoneStatus = i32Status;
+}
+
+static void Script(uint8_t u8Addr, const uint8_t *pu8Rsp, uint32_t u32Len)
+{
+    HostI2c_Reset();
+    g_sHostI2cDev.u8Addr = u8Addr;
+    if(pu8Rsp != NULL)
+        memcpy(g_sHostI2cDev.au8Rsp, pu8Rsp, u32Len);
+    g_sHostI2cDev.u32RspLen = u32Len;
+}
+
+/* The bus log matches au8Exp followed by the PEC of it */
+static int LogIsWithPec(const uint8_t *pu8Exp, uint32_t u32Len)
+{
+    return (g_sHostI2cDev.u32LogLen == u32Len + 1UL) &&
+           (memcmp(g_sHostI2cDev.au8Log, pu8Exp, u32Len) == 0) &&
+           (g_sHostI2cDev.au8Log[u32Len] == HostI2c_Crc8(pu8Exp, u32Len));
+}
+
+static void TestWrite(void)
+{
+    static uint8_t au8Tx[2] = { 0x34U, 0x12U };
+    static uint8_t au8Blk[3] = { 0xA1U, 0xA2U, 0xA3U };
+    static const uint8_t au8Word[] = { TEST_ADDR << 1, 0x10U, 0x34U, 0x12U };
+    static const uint8_t au8Block[] = { TEST_ADDR << 1, 0x20U, 3U, 0xA1U, 0xA2U, 0xA3U };
+    S_I2C_SMBUS_MSG_T sMsg = { TEST_ADDR, I2C_SMBUS_PROTO_WRITE_WORD, 0x10U, 1U, 2U, 0U, au8Tx, NULL, 0L };
+
+    Script(TEST_ADDR, NULL, 0UL);
+    HOST_CHECK(I2C_SMBusXfer(I2C0, &sMsg, 1UL, NULL, NULL) == I2C_SMBUS_OK);
+    HOST_CHECK(I2C_SMBusWait(I2C0) == I2C_SMBUS_OK);
+    HOST_CHECK(sMsg.i32Status == I2C_SMBUS_OK);
+    HOST_CHECK(LogIsWithPec(au8Word, sizeof(au8Word)));
+    HOST_CHECK(g_sHostI2cDev.u32Stops == 1UL);
+
+    Script(TEST_ADDR, NULL, 0UL);
+    HOST_CHECK(I2C_SMBusBlockWrite(I2C0, TEST_ADDR, 0x20U, au8Blk, 3U, 1U) == I2C_SMBUS_OK);
+    HOST_CHECK(LogIsWithPec(au8Block, sizeof(au8Block)));
+
+    /* Nobody at the address */
+    Script(TEST_ADDR + 1U, NULL, 0UL);
+    HOST_CHECK(I2C_SMBusBlockWrite(I2C0, TEST_ADDR, 0x20U, au8Blk, 3U, 1U) == I2C_SMBUS_ERR_NACK);
+}
+
+static void TestRead(void)
+{
+    static const uint8_t au8Word[] = { 0xCDU, 0xABU };
+    static const uint8_t au8Block[] = { 3U, 0xB1U, 0xB2U, 0xB3U };
+    static const uint8_t au8Oversize[] = { 9U, 0U };
+    static uint8_t au8Rx[8];
+    S_I2C_SMBUS_MSG_T sMsg = { TEST_ADDR, I2C_SMBUS_PROTO_READ_WORD, 0x11U, 1U, 0U, 2U, NULL, au8Rx, 0L };
+    uint8_t u8Len;
+    uint16_t u16Rsp;
+
+    Script(TEST_ADDR, au8Word, sizeof(au8Word));
+    HOST_CHECK(I2C_SMBusXfer(I2C0, &sMsg, 1UL, NULL, NULL) == I2C_SMBUS_OK);
+    HOST_CHECK(I2C_SMBusWait(I2C0) == I2C_SMBUS_OK);
+    HOST_CHECK((au8Rx[0] == 0xCDU) && (au8Rx[1] == 0xABU));
+    HOST_CHECK(g_sHostI2cDev.u32Packets == 1UL);
+
+    /* The PEC covers the command, both address bytes and the data */
+    Script(TEST_ADDR, au8Word, sizeof(au8Word));
+    g_sHostI2cDev.u8BadPec = 1U;
+    HOST_CHECK(I2C_SMBusXfer(I2C0, &sMsg, 1UL, NULL, NULL) == I2C_SMBUS_OK);
+    HOST_CHECK(I2C_SMBusWait(I2C0) == I2C_SMBUS_ERR_PEC);
+    HOST_CHECK(sMsg.i32Status == I2C_SMBUS_ERR_PEC);
+
+    Script(TEST_ADDR, au8Block, sizeof(au8Block));
+    u8Len = sizeof(au8Rx);
+    HOST_CHECK(I2C_SMBusBlockRead(I2C0, TEST_ADDR, 0x21U, au8Rx, &u8Len, 1U) == I2C_SMBUS_OK);
+    HOST_CHECK((u8Len == 3U) && (au8Rx[0] == 0xB1U) && (au8Rx[2] == 0xB3U));
+
+    Script(TEST_ADDR, au8Oversize, sizeof(au8Oversize));
+    u8Len = 4U;
+    HOST_CHECK(I2C_SMBusBlockRead(I2C0, TEST_ADDR, 0x21U, au8Rx, &u8Len, 0U) == I2C_SMBUS_ERR_SIZE);
+
+    Script(TEST_ADDR, au8Word, sizeof(au8Word));
+    HOST_CHECK(I2C_SMBusProcessCall(I2C0, TEST_ADDR, 0x12U, 0x5678U, &u16Rsp, 1U) == I2C_SMBUS_OK);
+    HOST_CHECK(u16Rsp == 0xABCDU);
+    HOST_CHECK((g_sHostI2cDev.au8Log[2] == 0x78U) && (g_sHostI2cDev.au8Log[3] == 0x56U));
+
+    Script(TEST_ADDR, au8Block, sizeof(au8Block));
+    u8Len = sizeof(au8Rx);
+    HOST_CHECK(I2C_SMBusBlockProcessCall(I2C0, TEST_ADDR, 0x13U, (uint8_t *)au8Word, 2U, au8Rx, &u8Len, 1U) == I2C_SMBUS_OK);
+    HOST_CHECK((u8Len == 3U) && (au8Rx[1] == 0xB2U));
+}
+
+static void TestArp(void)
+{
+    static const uint8_t au8Prepare[] = { I2C_SMBUS_ARP_ADDR << 1, 0x01U };
+    static const uint8_t au8Reset[] = { I2C_SMBUS_ARP_ADDR << 1, 0x02U };
+    uint8_t au8Rsp[18], au8Udid[17], au8Assign[20];
+    uint32_t i;
+
+    Script(I2C_SMBUS_ARP_ADDR, NULL, 0UL);
+    HOST_CHECK(I2C_SMBusArpPrepare(I2C0) == I2C_SMBUS_OK);
+    HOST_CHECK(LogIsWithPec(au8Prepare, sizeof(au8Prepare)));
+
+    Script(I2C_SMBUS_ARP_ADDR, NULL, 0UL);
+    HOST_CHECK(I2C_SMBusArpReset(I2C0) == I2C_SMBUS_OK);
+    HOST_CHECK(LogIsWithPec(au8Reset, sizeof(au8Reset)));
+
+    au8Rsp[0] = 17U;
+    for(i = 0UL; i < 16UL; i++)
+        au8Rsp[1UL + i] = (uint8_t)(0x80U + i);
+    au8Rsp[17] = 0xFFU;
+    Script(I2C_SMBUS_ARP_ADDR, au8Rsp, sizeof(au8Rsp));
+    HOST_CHECK(I2C_SMBusArpGetUdid(I2C0, au8Udid) == I2C_SMBUS_OK);
+    HOST_CHECK(memcmp(au8Udid, &au8Rsp[1], 17UL) == 0);
+
+    /* A device that answers a short UDID */
+    au8Rsp[0] = 16U;
+    Script(I2C_SMBUS_ARP_ADDR, au8Rsp, 17UL);
+    HOST_CHECK(I2C_SMBusArpGetUdid(I2C0, au8Udid) == I2C_SMBUS_ERR_SIZE);
+
+    /* No device left to enumerate */
+    Script(TEST_ADDR, NULL, 0UL);
+    HOST_CHECK(I2C_SMBusArpGetUdid(I2C0, au8Udid) == I2C_SMBUS_ERR_NACK);
+
+    au8Assign[0] = I2C_SMBUS_ARP_ADDR << 1;
+    au8Assign[1] = 0x04U;
+    au8Assign[2] = 17U;
+    memcpy(&au8Assign[3], &au8Rsp[1], 16UL);
+    au8Assign[19] = (0x42U << 1) | 1U;
+    Script(I2C_SMBUS_ARP_ADDR, NULL, 0UL);
+    HOST_CHECK(I2C_SMBusArpAssign(I2C0, &au8Rsp[1], 0x42U) == I2C_SMBUS_OK);
+    HOST_CHECK(LogIsWithPec(au8Assign, sizeof(au8Assign)));
+}
+
+static void InitList(S_I2C_SMBUS_MSG_T asMsg[3], uint8_t au8Rx[3][2])
+{
+    uint32_t i;
+
+    for(i = 0UL; i < 3UL; i++)
+    {
+        memset(&asMsg[i], 0, sizeof(asMsg[i]));
+        asMsg[i].u8Addr = TEST_ADDR;
+        asMsg[i].u8Proto = I2C_SMBUS_PROTO_READ_WORD;
+        asMsg[i].u8Cmd = (uint8_t)(0x30U + i);
+        asMsg[i].u8RxLen = 2U;
+        asMsg[i].pu8Rx = au8Rx[i];
+    }
+}
+
+static void TestList(void)
+{
+    static const uint8_t au8Word[] = { 0x11U, 0x22U };
+    static const uint32_t au32Fault[] = { 0x38UL, 0x00UL, HOST_I2C_FAULT_TIMEOUT };
+    static const int32_t ai32Err[] = { I2C_SMBUS_ERR_ARB, I2C_SMBUS_ERR_BUS, I2C_SMBUS_ERR_TIMEOUT };
+    static uint8_t au8Rx[3][2];
+    S_I2C_SMBUS_MSG_T asMsg[3];
+    uint32_t i, u32Clk = SystemCoreClock;
+
+    /* A NACK does not stop the list */
+    InitList(asMsg, au8Rx);
+    asMsg[1].u8Addr = TEST_ADDR + 1U;
+    Script(TEST_ADDR, au8Word, sizeof(au8Word));
+    s_u32DoneCnt = 0UL;
+    HOST_CHECK(I2C_SMBusXfer(I2C0, asMsg, 3UL, Done, NULL) == I2C_SMBUS_OK);
+    HOST_CHECK(I2C_SMBusWait(I2C0) == I2C_SMBUS_ERR_NACK);
+    HOST_CHECK(asMsg[0].i32Status == I2C_SMBUS_OK);
+    HOST_CHECK(asMsg[1].i32Status == I2C_SMBUS_ERR_NACK);
+    HOST_CHECK(asMsg[2].i32Status == I2C_SMBUS_OK);
+    HOST_CHECK((s_u32DoneCnt == 1UL) && (s_i32DoneStatus == I2C_SMBUS_ERR_NACK));
+    HOST_CHECK(g_sHostI2cDev.u32Stops == 3UL);
+
+    /* Faults at the SLA+W of the second transaction end the list */
+    for(i = 0UL; i < 3UL; i++)
+    {
+        InitList(asMsg, au8Rx);
+        Script(TEST_ADDR, au8Word, sizeof(au8Word));
+        g_sHostI2cDev.u32FaultAt = TEST_READ_WORD_STEPS + 2UL;
+        g_sHostI2cDev.u32Fault = au32Fault[i];
+        s_u32DoneCnt = 0UL;
+        HOST_CHECK(I2C_SMBusXfer(I2C0, asMsg, 3UL, Done, NULL) == I2C_SMBUS_OK);
+        HOST_CHECK(I2C_SMBusWait(I2C0) == ai32Err[i]);
+        HOST_CHECK(asMsg[0].i32Status == I2C_SMBUS_OK);
+        HOST_CHECK(asMsg[1].i32Status == ai32Err[i]);
+        HOST_CHECK(asMsg[2].i32Status == ai32Err[i]);
+        HOST_CHECK((s_u32DoneCnt == 1UL) && (s_i32DoneStatus == ai32Err[i]));
+            HOST_CHECK(g_sHostI2cDev.u32Packets == 2UL);
+        /* No STOP after losing arbitration, the bus belongs to the other host */
+        HOST_CHECK(g_sHostI2cDev.u32Stops == ((au32Fault[i] == 0x38UL) ? 1UL : 2UL));
+    }
+
+    /* A stalled bus times out in I2C_SMBusWait */
+    InitList(asMsg, au8Rx);
+    Script(TEST_ADDR, au8Word, sizeof(au8Word));
+    g_sHostI2cDev.u32Hold = 1UL;
+    SystemCoreClock = 100000UL;
+    HOST_CHECK(I2C_SMBusXfer(I2C0, asMsg, 3UL, NULL, NULL) == I2C_SMBUS_OK);
+    HOST_CHECK(I2C_SMBusWait(I2C0) == I2C_SMBUS_ERR_TIMEOUT);
+    for(i = 0UL; i < 3UL; i++)
+        HOST_CHECK(asMsg[i].i32Status == I2C_SMBUS_ERR_TIMEOUT);
+    g_sHostI2cDev.u32Hold = 0UL;
+    SystemCoreClock = u32Clk;
+
+    /* The port is free again */
+    InitList(asMsg, au8Rx);
+    Script(TEST_ADDR, au8Word, sizeof(au8Word));
+    HOST_CHECK(I2C_SMBusXfer(I2C0, asMsg, 3UL, NULL, NULL) == I2C_SMBUS_OK);
+    HOST_CHECK(I2C_SMBusWait(I2C0) == I2C_SMBUS_OK);
+}
+
+int main(void)
+{
+    HostI2c_Start(I2C0, I2C_SMBusIRQHandler);
+
+    TestWrite();
+    TestRead();
+    TestArp();
+    TestList();
+
+    HostI2c_Stop();
+    return HostTest_Result("i2c_smbus");
+}
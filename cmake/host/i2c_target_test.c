@@ -0,0 +1,235 @@
+/**************************************************************************//**
+ * @file     i2c_target_test.c
+ * @brief    Host test of the I2C target engine
+ *
+ * Drives host write and read sequences through the I2C bus model: register
+ * pointer set, auto-increment, reads past the end of a map, NACK at the
+ * write limit and 2-byte pointers. Built with I2C_TARGET_PDMA=1 it also
+ * checks the hand-off between PDMA and the interrupt, in both directions.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2024 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "NuMicro.h"
+#include "host_regs.h"
+#include "i2c_model.h"
+
+#if defined(PDMA0)
+#define TEST_PDMA               PDMA0
+#else
+#define TEST_PDMA               PDMA
+#endif
+
+#define TEST_ADDR0              0x50U
+#define TEST_ADDR1              0x51U
+#define TEST_SIZE0              16U
+#define TEST_LIMIT0             12U     /* Registers 12 to 15 of map 0 are read-only */
+#define TEST_SIZE1              300U
+
+static uint8_t s_au8Regs0[TEST_SIZE0];
+static uint8_t s_au8Regs1[TEST_SIZE1];
+static uint32_t s_u32WrCalls, s_u32ReadCalls;
+static uint16_t s_u16WrReg, s_u16WrLen;
+
+static void RegsWritten(S_I2C_TARGET_MAP_T *psMap, uint16_t u16Reg, uint16_t u16Len)
+{
+    (void)psMap;
+    s_u32WrCalls++;
+    s_u16WrReg = u16Reg;
+    s_u16WrLen = u16Len;
+}
+
+static void RegsRead(S_I2C_TARGET_MAP_T *psMap)
+{
+    (void)psMap;
+    s_u32ReadCalls++;
+}
+
+static S_I2C_TARGET_MAP_T s_asMap[2] =
+{
+    { TEST_ADDR0, 1U, TEST_SIZE0, TEST_LIMIT0, 0U, s_au8Regs0, RegsRead, RegsWritten },
+    { TEST_ADDR1, 2U, TEST_SIZE1, TEST_SIZE1, 0U, s_au8Regs1, NULL, RegsWritten },
+};
+
+static void Open(void)
+{
+    uint32_t i;
+
+    for(i = 0UL; i < TEST_SIZE0; i++)
+        s_au8Regs0[i] = (uint8_t)(0xA0U + i);
+    for(i = 0UL; i < TEST_SIZE1; i++)
+        s_au8Regs1[i] = (uint8_t)i;
+    s_u32WrCalls = 0UL;
+    s_u32ReadCalls = 0UL;
+#if I2C_TARGET_PDMA
+    HostI2c_StartTarget(I2C0, I2C_TargetIRQHandler, TEST_PDMA, 0UL, 1UL);
+#else
+    HostI2c_StartTarget(I2C0, I2C_TargetIRQHandler, NULL, 0UL, 0UL);
+#endif
+    HOST_CHECK(I2C_TargetOpen(I2C0, s_asMap, 2UL) == I2C_TARGET_OK);
+#if I2C_TARGET_PDMA
+    HOST_CHECK(I2C_TargetSetPdma(I2C0, TEST_PDMA, 0UL, 1UL, 4UL) == I2C_TARGET_OK);
+#endif
+}
+
+static void TestPointer(void)
+{
+    static const uint8_t au8Wr[] = { 0x02U, 0x11U, 0x22U, 0x33U };
+    static const uint8_t au8Ptr[] = { 0x04U };
+    uint8_t au8Rd[4];
+
+    Open();
+
+    /* Pointer, then data with auto-increment */
+    HOST_CHECK(HostI2c_BusWrite(TEST_ADDR0, au8Wr, sizeof(au8Wr)) == 4);
+    HostI2c_BusStop();
+    HOST_CHECK((s_au8Regs0[2] == 0x11U) && (s_au8Regs0[3] == 0x22U) && (s_au8Regs0[4] == 0x33U));
+    HOST_CHECK((s_au8Regs0[1] == 0xA1U) && (s_au8Regs0[5] == 0xA5U));
+    HOST_CHECK((s_u32WrCalls == 1UL) && (s_u16WrReg == 2U) && (s_u16WrLen == 3U));
+    HOST_CHECK(s_asMap[0].u16Ptr == 5U);
+
+    /* Pointer alone, repeated START and read */
+    HOST_CHECK(HostI2c_BusWrite(TEST_ADDR0, au8Ptr, sizeof(au8Ptr)) == 1);
+    HOST_CHECK(HostI2c_BusRead(TEST_ADDR0, au8Rd, 3UL) == 3);
+    HostI2c_BusStop();
+    HOST_CHECK((au8Rd[0] == 0x33U) && (au8Rd[1] == 0xA5U) && (au8Rd[2] == 0xA6U));
+    HOST_CHECK((s_u32WrCalls == 1UL) && (s_u32ReadCalls == 1UL));
+
+    /* The pointer is kept between transfers */
+    HOST_CHECK(HostI2c_BusRead(TEST_ADDR0, au8Rd, 2UL) == 2);
+    HostI2c_BusStop();
+    HOST_CHECK((au8Rd[0] == 0xA7U) && (au8Rd[1] == 0xA8U));
+
+    /* Past the end of the map */
+    HOST_CHECK(HostI2c_BusWrite(TEST_ADDR0, (const uint8_t[]){ 14U }, 1UL) == 1);
+    HOST_CHECK(HostI2c_BusRead(TEST_ADDR0, au8Rd, 4UL) == 4);
+    HostI2c_BusStop();
+    HOST_CHECK((au8Rd[0] == 0xAEU) && (au8Rd[1] == 0xAFU) && (au8Rd[2] == I2C_TARGET_IDLE_BYTE) && (au8Rd[3] == I2C_TARGET_IDLE_BYTE));
+    HOST_CHECK(s_asMap[0].u16Ptr == TEST_SIZE0);
+
+    /* Nobody at the address */
+    HOST_CHECK(HostI2c_BusWrite(0x52U, au8Ptr, sizeof(au8Ptr)) == -1);
+    HostI2c_BusStop();
+}
+
+static void TestWrLimit(void)
+{
+    static const uint8_t au8Wr[] = { 10U, 0x01U, 0x02U, 0x03U, 0x04U };
+    static const uint8_t au8Ro[] = { 12U, 0x05U };
+
+    Open();
+
+    /* Registers 10 and 11 are written, the byte for register 12 is not acknowledged */
+    HOST_CHECK(HostI2c_BusWrite(TEST_ADDR0, au8Wr, sizeof(au8Wr)) == 3);
+    HostI2c_BusStop();
+    HOST_CHECK((s_au8Regs0[10] == 0x01U) && (s_au8Regs0[11] == 0x02U) && (s_au8Regs0[12] == 0xACU));
+    HOST_CHECK((s_u32WrCalls == 1UL) && (s_u16WrReg == 10U) && (s_u16WrLen == 2U));
+
+    /* Pointer at a read-only register */
+    HOST_CHECK(HostI2c_BusWrite(TEST_ADDR0, au8Ro, sizeof(au8Ro)) == 1);
+    HostI2c_BusStop();
+    HOST_CHECK((s_au8Regs0[12] == 0xACU) && (s_u32WrCalls == 1UL));
+
+    /* The target answers again after the NACK */
+    HOST_CHECK(HostI2c_BusWrite(TEST_ADDR0, (const uint8_t[]){ 0U, 0x5AU }, 2UL) == 2);
+    HostI2c_BusStop();
+    HOST_CHECK(s_au8Regs0[0] == 0x5AU);
+}
+
+static void TestPtr16(void)
+{
+    static const uint8_t au8Wr[] = { 0x01U, 0x02U, 0xEEU, 0xEFU };
+    uint8_t au8Rd[3];
+
+    Open();
+
+    HOST_CHECK(HostI2c_BusWrite(TEST_ADDR1, au8Wr, sizeof(au8Wr)) == 4);
+    HostI2c_BusStop();
+    HOST_CHECK((s_au8Regs1[0x102] == 0xEEU) && (s_au8Regs1[0x103] == 0xEFU));
+    HOST_CHECK((s_u32WrCalls == 1UL) && (s_u16WrReg == 0x102U) && (s_u16WrLen == 2U));
+
+    HOST_CHECK(HostI2c_BusWrite(TEST_ADDR1, au8Wr, 2UL) == 2);
+    HOST_CHECK(HostI2c_BusRead(TEST_ADDR1, au8Rd, 3UL) == 3);
+    HostI2c_BusStop();
+    HOST_CHECK((au8Rd[0] == 0xEEU) && (au8Rd[1] == 0xEFU) && (au8Rd[2] == 0x04U));
+
+    /* Map 0 kept its own pointer */
+    HOST_CHECK(s_asMap[0].u16Ptr == 0U);
+}
+
+#if I2C_TARGET_PDMA
+static void TestPdma(void)
+{
+    uint8_t au8Wr[66], au8Rd[32];
+    uint32_t i, u32Irqs;
+
+    Open();
+
+    /* 64 registers after a 2-byte pointer: interrupts for the address, the pointer and STOP only */
+    au8Wr[0] = 0U;
+    au8Wr[1] = 0U;
+    for(i = 0UL; i < 64UL; i++)
+        au8Wr[2UL + i] = (uint8_t)(0x80U + i);
+    u32Irqs = g_sHostI2cDev.u32Irqs;
+    HOST_CHECK(HostI2c_BusWrite(TEST_ADDR1, au8Wr, sizeof(au8Wr)) == (int32_t)sizeof(au8Wr));
+    HostI2c_BusStop();
+    HOST_CHECK(g_sHostI2cDev.u32Irqs - u32Irqs == 4UL);
+    HOST_CHECK(memcmp(s_au8Regs1, &au8Wr[2], 64UL) == 0);
+    HOST_CHECK(s_au8Regs1[64] == 64U);
+    HOST_CHECK((s_u32WrCalls == 1UL) && (s_u16WrReg == 0U) && (s_u16WrLen == 64U));
+    HOST_CHECK(s_asMap[1].u16Ptr == 64U);
+    HOST_CHECK(!(I2C0->CTL1 & (I2C_CTL1_RXPDMAEN_Msk | I2C_CTL1_TXPDMAEN_Msk)));
+
+    /* PDMA stops one register short of the limit, the interrupt takes the last one and NACKs the next */
+    au8Wr[0] = 0U;
+    HOST_CHECK(HostI2c_BusWrite(TEST_ADDR0, au8Wr, 15UL) == 13);
+    HostI2c_BusStop();
+    HOST_CHECK(memcmp(s_au8Regs0, &au8Wr[1], TEST_LIMIT0) == 0);
+    HOST_CHECK(s_au8Regs0[TEST_LIMIT0] == 0xACU);
+    HOST_CHECK((s_u32WrCalls == 2UL) && (s_u16WrReg == 0U) && (s_u16WrLen == TEST_LIMIT0));
+
+    /* Read by PDMA from the kept pointer, after a repeated START */
+    HOST_CHECK(HostI2c_BusWrite(TEST_ADDR1, (const uint8_t[]){ 0U, 0x50U }, 2UL) == 2);
+    u32Irqs = g_sHostI2cDev.u32Irqs;
+    HOST_CHECK(HostI2c_BusRead(TEST_ADDR1, au8Rd, 32UL) == 32);
+    HostI2c_BusStop();
+    HOST_CHECK(g_sHostI2cDev.u32Irqs - u32Irqs == 3UL);   /* Repeated START, SLA+R, last byte */
+    HOST_CHECK((au8Rd[0] == 0x50U) && (au8Rd[31] == 0x6FU));
+    HOST_CHECK(s_asMap[1].u16Ptr == 0x70U);
+
+    /* PDMA runs out at the end of the map, the interrupt sends the idle bytes */
+    HOST_CHECK(HostI2c_BusWrite(TEST_ADDR0, (const uint8_t[]){ 10U }, 1UL) == 1);
+    HOST_CHECK(HostI2c_BusRead(TEST_ADDR0, au8Rd, 8UL) == 8);
+    HostI2c_BusStop();
+    HOST_CHECK(memcmp(au8Rd, &s_au8Regs0[10], 6UL) == 0);
+    HOST_CHECK((au8Rd[6] == I2C_TARGET_IDLE_BYTE) && (au8Rd[7] == I2C_TARGET_IDLE_BYTE));
+    HOST_CHECK(s_asMap[0].u16Ptr == TEST_SIZE0);
+
+    /* A short run stays on the interrupt */
+    HOST_CHECK(HostI2c_BusWrite(TEST_ADDR0, (const uint8_t[]){ 13U }, 1UL) == 1);
+    u32Irqs = g_sHostI2cDev.u32Irqs;
+    HOST_CHECK(HostI2c_BusRead(TEST_ADDR0, au8Rd, 3UL) == 3);
+    HostI2c_BusStop();
+    HOST_CHECK(g_sHostI2cDev.u32Irqs - u32Irqs == 5UL);
+    HOST_CHECK((au8Rd[0] == 0xADU) && (au8Rd[2] == 0xAFU));
+}
+#endif
+
+int main(void)
+{
+    TestPointer();
+    TestWrLimit();
+    TestPtr16();
+#if I2C_TARGET_PDMA
+    TestPdma();
+#endif
+
+    HostReg_Reset();
+#if I2C_TARGET_PDMA
+    return HostTest_Result("i2c_target_pdma");
+#else
+    return HostTest_Result("i2c_target");
+#endif
+}
@@ -0,0 +1,280 @@
+/**************************************************************************//**
+ * @file     kpi_scan_test.c
+ * @brief    Host test of the KPI event queue on injected scan matrices
+ *
+ * The test keeps the state of a 6 x 8 key matrix. Each injected matrix
+ * sets KST, the press and release flags of the changed keys and the status
+ * flags, then runs KPI_IRQHandler. KPF and KRF are write-one-to-clear.
+ * Checked are:
+ * - the key queue of KPI_Open with several keys changing in one scan,
+ * - the event queue on a random walk of the matrix, against the changes
+ *   of the matrix, releases first, with the tick of the interrupt,
+ * - overflow counting with a small event queue, and KPI_WaitEvent,
+ * - the automatic slow scan while no key is held.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2024 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+#include "host_regs.h"
+
+#define TEST_STEPS          500UL
+#define TEST_QUEUE_LEN      (KPI_MAX_KEYS + 1UL)
+
+/* Interrupt vector of kpi.c */
+void KPI_IRQHandler(void);
+
+static uint32_t s_au32Matrix[2];
+static uint32_t s_u32Tick, s_u32TickStep;
+static uint32_t s_u32Seed = 0x1D872B41UL;
+static KPI_KEY_T s_asKey[8];
+static KPI_EVENT_T s_asEvent[TEST_QUEUE_LEN];
+
+static uint32_t Rand(void)
+{
+    s_u32Seed = s_u32Seed * 1664525UL + 1013904223UL;
+    return s_u32Seed >> 8;
+}
+
+static uint32_t W1cWrite(uint32_t u32Addr, uint32_t u32Old, uint32_t u32New)
+{
+    (void)u32Addr;
+    return u32Old & ~u32New;
+}
+
+static uint32_t GetTick(void)
+{
+    s_u32Tick += s_u32TickStep;
+    return s_u32Tick;
+}
+
+/* Bit of key (row, column) in KST/KPF/KRF word row / 4 */
+static uint32_t KeyBit(uint32_t u32Row, uint32_t u32Col)
+{
+    return 1UL << (((u32Row % 4UL) * 8UL) + u32Col);
+}
+
+/* One scan finding the matrix in the given state */
+static void Inject(const uint32_t au32New[2])
+{
+    uint32_t au32Press[2], au32Release[2], u32Sts = 0UL, i;
+
+    for(i = 0UL; i < 2UL; i++)
+    {
+        au32Press[i] = au32New[i] & ~s_au32Matrix[i];
+        au32Release[i] = s_au32Matrix[i] & ~au32New[i];
+        if(au32Press[i])
+            u32Sts |= KPI_STATUS_KPIF_Msk | KPI_STATUS_KIF_Msk;
+        if(au32Release[i])
+            u32Sts |= KPI_STATUS_KRIF_Msk | KPI_STATUS_KIF_Msk;
+        HostReg_Set((volatile uint32_t *)&KPI->KST[i], au32New[i]);
+        HostReg_Set(&KPI->KPF[i], au32Press[i]);
+        HostReg_Set(&KPI->KRF[i], au32Release[i]);
+        s_au32Matrix[i] = au32New[i];
+    }
+    HostReg_Set(&KPI->STATUS, u32Sts);
+
+    KPI_IRQHandler();
+
+    for(i = 0UL; i < 2UL; i++)
+        HOST_CHECK((HostReg_Get(&KPI->KPF[i]) == 0UL) && (HostReg_Get(&KPI->KRF[i]) == 0UL));
+}
+
+static void Open(void)
+{
+    s_au32Matrix[0] = 0UL;
+    s_au32Matrix[1] = 0UL;
+    HOST_CHECK(KPI_Open(6UL, 8UL, s_asKey, sizeof(s_asKey) / sizeof(s_asKey[0])) == 0);
+}
+
+static uint32_t SameKey(KPI_KEY_T key, uint32_t u32Row, uint32_t u32Col, uint32_t u32St)
+{
+    return ((key.x == u32Row) && (key.y == u32Col) && (key.st == u32St)) ? 1UL : 0UL;
+}
+
+/* Three keys pressed in one scan, two of them released in the next */
+static void TestKeyQueue(void)
+{
+    uint32_t au32Mat[2];
+    KPI_KEY_T key;
+
+    Open();
+    au32Mat[0] = KeyBit(0UL, 3UL) | KeyBit(2UL, 7UL);
+    au32Mat[1] = KeyBit(5UL, 1UL);
+    Inject(au32Mat);
+    HOST_CHECK(KPI_kbhit() == 1);
+    HOST_CHECK(SameKey(KPI_GetKey(), 0UL, 3UL, KPI_PRESS));
+    HOST_CHECK(SameKey(KPI_GetKey(), 2UL, 7UL, KPI_PRESS));
+    HOST_CHECK(SameKey(KPI_GetKey(), 5UL, 1UL, KPI_PRESS));
+    HOST_CHECK(KPI_kbhit() == 0);
+
+    au32Mat[0] = KeyBit(2UL, 7UL);
+    au32Mat[1] = 0UL;
+    Inject(au32Mat);
+    HOST_CHECK(SameKey(KPI_GetKey(), 0UL, 3UL, KPI_RELEASE));
+    HOST_CHECK(SameKey(KPI_GetKey(), 5UL, 1UL, KPI_RELEASE));
+    key = KPI_GetKey();
+    HOST_CHECK((key.x == 0xFFU) && (key.y == 0xFFU));
+
+    KPI_Close();
+}
+
+/* Pops the events of the keys in au32Flag, in row and column order */
+static uint32_t CheckEvents(const uint32_t au32Flag[2], uint32_t u32St)
+{
+    KPI_EVENT_T event;
+    uint32_t u32Row, u32Col, u32Ok = 1UL;
+
+    for(u32Row = 0UL; u32Row < KPI_MAX_ROW; u32Row++)
+    {
+        for(u32Col = 0UL; u32Col < KPI_MAX_COL; u32Col++)
+        {
+            if((au32Flag[u32Row / 4UL] & KeyBit(u32Row, u32Col)) == 0UL)
+                continue;
+            if((KPI_GetEvent(&event) != 0) || !SameKey(event.key, u32Row, u32Col, u32St) || (event.u32Time != s_u32Tick))
+                u32Ok = 0UL;
+        }
+    }
+    return u32Ok;
+}
+
+/* Random walk of the matrix: one to three keys change per scan */
+static void TestEventQueue(void)
+{
+    uint32_t au32Mat[2], au32Press[2], au32Release[2], u32Step, u32Row, i;
+    KPI_EVENT_T event;
+
+    Open();
+    HOST_CHECK(KPI_SetEventQueue(s_asEvent, TEST_QUEUE_LEN, GetTick) == 0);
+    s_u32Tick = 0UL;
+    s_u32TickStep = 0UL;
+
+    for(u32Step = 0UL; u32Step < TEST_STEPS; u32Step++)
+    {
+        au32Mat[0] = s_au32Matrix[0];
+        au32Mat[1] = s_au32Matrix[1];
+        for(i = Rand() % 3UL; i < 3UL; i++)
+        {
+            u32Row = Rand() % KPI_MAX_ROW;
+            au32Mat[u32Row / 4UL] ^= KeyBit(u32Row, Rand() % KPI_MAX_COL);
+        }
+        for(i = 0UL; i < 2UL; i++)
+        {
+            au32Press[i] = au32Mat[i] & ~s_au32Matrix[i];
+            au32Release[i] = s_au32Matrix[i] & ~au32Mat[i];
+        }
+
+        s_u32Tick += 10UL;
+        Inject(au32Mat);
+
+        /* Releases before presses, stamped with the tick of the interrupt */
+        HOST_CHECK(CheckEvents(au32Release, KPI_RELEASE));
+        HOST_CHECK(CheckEvents(au32Press, KPI_PRESS));
+        HOST_CHECK(KPI_GetEvent(&event) != 0);
+    }
+
+    HOST_CHECK(KPI_GetOverflowCount() == 0UL);
+    KPI_Close();
+}
+
+/* Six keys in one scan into a queue of four entries, three usable */
+static void TestOverflow(void)
+{
+    uint32_t au32Mat[2], au32Flag[2];
+    KPI_EVENT_T event;
+
+    Open();
+    HOST_CHECK(KPI_SetEventQueue(s_asEvent, 4UL, GetTick) == 0);
+    s_u32Tick = 100UL;
+    s_u32TickStep = 0UL;
+
+    au32Mat[0] = KeyBit(1UL, 0UL) | KeyBit(1UL, 1UL) | KeyBit(1UL, 2UL) | KeyBit(3UL, 6UL);
+    au32Mat[1] = KeyBit(4UL, 4UL) | KeyBit(5UL, 5UL);
+    Inject(au32Mat);
+    HOST_CHECK(KPI_GetOverflowCount() == 3UL);
+
+    /* The oldest events are kept, the newest dropped */
+    au32Flag[0] = KeyBit(1UL, 0UL) | KeyBit(1UL, 1UL) | KeyBit(1UL, 2UL);
+    au32Flag[1] = 0UL;
+    HOST_CHECK(CheckEvents(au32Flag, KPI_PRESS));
+    HOST_CHECK(KPI_GetEvent(&event) != 0);
+
+    /* Room again after draining */
+    au32Mat[1] = KeyBit(4UL, 4UL);
+    s_u32Tick = 200UL;
+    Inject(au32Mat);
+    au32Flag[0] = 0UL;
+    au32Flag[1] = KeyBit(5UL, 5UL);
+    HOST_CHECK(CheckEvents(au32Flag, KPI_RELEASE));
+    HOST_CHECK(KPI_GetOverflowCount() == 3UL);
+
+    /* KPI_WaitEvent times out on the tick, and returns a queued event at once */
+    s_u32TickStep = 1UL;
+    HOST_CHECK(KPI_WaitEvent(&event, 50UL) == -1);
+    HOST_CHECK(s_u32Tick >= 250UL);
+    s_u32TickStep = 0UL;
+    au32Mat[0] = 0UL;
+    Inject(au32Mat);
+    HOST_CHECK((KPI_WaitEvent(&event, 50UL) == 0) && SameKey(event.key, 1UL, 0UL, KPI_RELEASE));
+
+    HOST_CHECK(KPI_SetEventQueue(NULL, 0UL, NULL) == 0);
+    KPI_Close();
+}
+
+/* Slow scan once no key is held, fast scan again on the next press */
+static void TestAutoSlowScan(void)
+{
+    uint32_t au32Mat[2], u32Ctl, u32Dly;
+
+    CLK->CLKSEL3 = (CLK->CLKSEL3 & ~CLK_CLKSEL3_KPISEL_Msk) | CLK_CLKSEL3_KPISEL_HXT;
+    Open();
+    KPI_SetSampleTime(1UL);
+    KPI_EnableAutoSlowScan(1UL);
+    u32Ctl = KPI->CTL;
+    u32Dly = KPI->DLYCTL;
+
+    au32Mat[0] = KeyBit(0UL, 0UL);
+    au32Mat[1] = KeyBit(4UL, 0UL);
+    Inject(au32Mat);
+    HOST_CHECK((KPI->CTL == u32Ctl) && (KPI->DLYCTL == u32Dly));
+
+    /* One key still held */
+    au32Mat[0] = 0UL;
+    Inject(au32Mat);
+    HOST_CHECK(KPI->CTL == u32Ctl);
+
+    au32Mat[1] = 0UL;
+    Inject(au32Mat);
+    HOST_CHECK((KPI->CTL & KPI_CTL_DBCLKSEL_Msk) == (5UL << KPI_CTL_DBCLKSEL_Pos));
+    HOST_CHECK((KPI->DLYCTL & 0xFFUL) == 127UL);
+    HOST_CHECK((KPI->DLYCTL & ~0xFFUL) == (u32Dly & ~0xFFUL));
+
+    au32Mat[1] = KeyBit(5UL, 7UL);
+    Inject(au32Mat);
+    HOST_CHECK((KPI->CTL == u32Ctl) && (KPI->DLYCTL == u32Dly));
+    HOST_CHECK(SameKey(KPI_GetKey(), 0UL, 0UL, KPI_PRESS));
+
+    KPI_EnableAutoSlowScan(0UL);
+    KPI_Close();
+}
+
+int main(void)
+{
+    uint32_t i;
+
+    HostReg_Reset();
+    for(i = 0UL; i < 2UL; i++)
+    {
+        HostReg_SetHook(&KPI->KPF[i], NULL, W1cWrite);
+        HostReg_SetHook(&KPI->KRF[i], NULL, W1cWrite);
+    }
+    HostReg_Trap(1UL);
+
+    TestKeyQueue();
+    TestEventQueue();
+    TestOverflow();
+    TestAutoSlowScan();
+
+    return HostTest_Result("kpi_scan");
+}
@@ -0,0 +1,460 @@
+/**************************************************************************//**
+ * @file     nu_drv_test.c
+ * @brief    Host test of the nu_drv.h backends and the nu_async.h queues
+ *
+ * Checks that NU_OP calls and the operation tables program the same
+ * registers, the CAN backend of the series against its message object or
+ * Tx buffer layout, the DMA channel queue against a PDMA model (and LPPDMA
+ * on M2L31), and the CAN transmit queue against a scripted CAN controller.
+ * The PDMA model copies the programmed transfer and raises TDSTS or ABTSTS
+ * when the test finishes a channel.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2024 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "NuMicro.h"
+#include "nu_async.h"
+#include "host_regs.h"
+
+#if defined(PDMA0)
+#define TEST_PDMA               PDMA0
+#else
+#define TEST_PDMA               PDMA
+#endif
+
+#define TEST_CH                 2UL
+#define TEST_REQ_NUM            4UL
+#define TEST_XFER_WORDS         16UL
+
+/* Registers of the PDMA model, the same layout on PDMA and LPPDMA */
+typedef struct
+{
+    const S_NU_DMA_OPS_T *psOps;
+    void *pvPort;
+    volatile uint32_t *pu32Dsct;        /* CTL of channel 0, 4 words per channel */
+    volatile uint32_t *pu32Chctl;
+    volatile uint32_t *pu32Swreq;
+    volatile uint32_t *pu32Abtsts;
+    volatile uint32_t *pu32Tdsts;
+} TEST_DMA_T;
+
+static const S_NU_DMA_OPS_T s_sPdmaOps = NU_PDMA_OPS;
+static S_NU_DMA_CHAN_T s_sChan;
+static S_NU_DMA_REQ_T s_asReq[TEST_REQ_NUM];
+static uint32_t s_au32Src[TEST_REQ_NUM][TEST_XFER_WORDS], s_au32Dst[TEST_REQ_NUM][TEST_XFER_WORDS];
+static uint32_t s_au32Done[TEST_REQ_NUM * 2UL];     /* Request index of each callback */
+static int32_t  s_ai32Status[TEST_REQ_NUM * 2UL];
+static uint32_t s_u32DoneNum, s_u32Swreqs, s_u32Resubmit;
+
+static uint32_t W1cWrite(uint32_t u32Addr, uint32_t u32Old, uint32_t u32New)
+{
+    (void)u32Addr;
+    return u32Old & ~u32New;
+}
+
+static uint32_t SwreqWrite(uint32_t u32Addr, uint32_t u32Old, uint32_t u32New)
+{
+    (void)u32Addr;
+    (void)u32Old;
+    if(u32New & (1UL << TEST_CH))
+        s_u32Swreqs++;
+    return 0UL;
+}
+
+/* The channel finishes the programmed transfer, or aborts and is disabled */
+static void DmaFinish(const TEST_DMA_T *psDma, uint32_t u32Abort)
+{
+    volatile uint32_t *pu32Dsct = &psDma->pu32Dsct[TEST_CH * 4UL];
+    uint32_t u32Ctl = HostReg_Get(&pu32Dsct[0]);
+    uint32_t u32Bytes = (((u32Ctl & PDMA_DSCT_CTL_TXCNT_Msk) >> PDMA_DSCT_CTL_TXCNT_Pos) + 1UL) <<
+                        ((u32Ctl & PDMA_DSCT_CTL_TXWIDTH_Msk) >> PDMA_DSCT_CTL_TXWIDTH_Pos);
+
+    if(u32Abort)
+    {
+        HostReg_Set(psDma->pu32Chctl, HostReg_Get(psDma->pu32Chctl) & ~(1UL << TEST_CH));
+        HostReg_Set(psDma->pu32Abtsts, HostReg_Get(psDma->pu32Abtsts) | (1UL << TEST_CH));
+    }
+    else
+    {
+        memcpy((void *)(uintptr_t)HostReg_Get(&pu32Dsct[2]), (const void *)(uintptr_t)HostReg_Get(&pu32Dsct[1]), u32Bytes);
+        HostReg_Set(psDma->pu32Tdsts, HostReg_Get(psDma->pu32Tdsts) | (1UL << TEST_CH));
+    }
+    NU_DmaChanIRQHandler(&s_sChan);
+}
+
+static void ReqDone(void *pvUser, int32_t i32Status)
+{
+    uint32_t u32Idx = (uint32_t)(uintptr_t)pvUser;
+
+    s_au32Done[s_u32DoneNum] = u32Idx;
+    s_ai32Status[s_u32DoneNum] = i32Status;
+    s_u32DoneNum++;
+
+    /* Chain a request from the callback, as a driver refilling its buffer would */
+    if(s_u32Resubmit && (u32Idx == 0UL))
+    {
+        s_u32Resubmit = 0UL;
+        HOST_CHECK(NU_DmaChanSubmit(&s_sChan, &s_asReq[0]) == NU_ASYNC_OK);
+    }
+}
+
+static S_NU_DMA_REQ_T *ReqInit(uint32_t u32Idx, uint32_t u32Peripheral)
+{
+    S_NU_DMA_REQ_T *psReq = &s_asReq[u32Idx];
+    uint32_t i;
+
+    for(i = 0UL; i < TEST_XFER_WORDS; i++)
+    {
+        s_au32Src[u32Idx][i] = (u32Idx << 16) | i;
+        s_au32Dst[u32Idx][i] = 0UL;
+    }
+
+    memset(psReq, 0, sizeof(*psReq));
+    psReq->sXfer.u32Peripheral = u32Peripheral;
+    psReq->sXfer.u32Width = PDMA_WIDTH_32;
+    psReq->sXfer.u32Count = TEST_XFER_WORDS;
+    psReq->sXfer.u32SrcAddr = (uint32_t)(uintptr_t)s_au32Src[u32Idx];
+    psReq->sXfer.u32SrcCtrl = PDMA_SAR_INC;
+    psReq->sXfer.u32DstAddr = (uint32_t)(uintptr_t)s_au32Dst[u32Idx];
+    psReq->sXfer.u32DstCtrl = PDMA_DAR_INC;
+    psReq->pfnDone = ReqDone;
+    psReq->pvUser = (void *)(uintptr_t)u32Idx;
+    return psReq;
+}
+
+static void DmaRestart(const TEST_DMA_T *psDma)
+{
+    HostReg_Reset();
+    HostReg_SetHook(psDma->pu32Abtsts, NULL, W1cWrite);
+    HostReg_SetHook(psDma->pu32Tdsts, NULL, W1cWrite);
+    HostReg_SetHook(psDma->pu32Swreq, NULL, SwreqWrite);
+    HostReg_Trap(1UL);
+    psDma->psOps->pfnOpen(psDma->pvPort, 1UL << TEST_CH);
+    NU_DmaChanInit(&s_sChan, psDma->psOps, psDma->pvPort, TEST_CH);
+    s_u32DoneNum = 0UL;
+    s_u32Swreqs = 0UL;
+    s_u32Resubmit = 0UL;
+}
+
+/* NU_OP calls compile to the same driver calls as the operation table */
+static void TestDispatch(void)
+{
+    static uint8_t au8Op[sizeof(PDMA_T)], au8Table[sizeof(PDMA_T)];
+    S_NU_DMA_REQ_T *psReq = ReqInit(0UL, PDMA_MEM);
+    uint32_t u32OpWr, u32TableWr;
+
+    HostReg_Reset();
+    HostReg_Trap(1UL);
+    HostReg_SetCountWindow(TEST_PDMA, sizeof(PDMA_T));
+    NU_OP(NU_DMA_BACKEND, Open)(TEST_PDMA, 1UL << TEST_CH);
+    NU_OP(NU_DMA_BACKEND, SetTransfer)(TEST_PDMA, TEST_CH, &psReq->sXfer);
+    NU_OP(NU_DMA_BACKEND, EnableInt)(TEST_PDMA, TEST_CH, PDMA_INT_TRANS_DONE);
+    NU_OP(NU_DMA_BACKEND, Trigger)(TEST_PDMA, TEST_CH);
+    u32OpWr = HostReg_GetWriteCount();
+    HostReg_Trap(0UL);
+    memcpy(au8Op, (const void *)TEST_PDMA, sizeof(au8Op));
+
+    HostReg_Reset();
+    HostReg_Trap(1UL);
+    HostReg_SetCountWindow(TEST_PDMA, sizeof(PDMA_T));
+    s_sPdmaOps.pfnOpen(TEST_PDMA, 1UL << TEST_CH);
+    s_sPdmaOps.pfnSetTransfer(TEST_PDMA, TEST_CH, &psReq->sXfer);
+    s_sPdmaOps.pfnEnableInt(TEST_PDMA, TEST_CH, PDMA_INT_TRANS_DONE);
+    s_sPdmaOps.pfnTrigger(TEST_PDMA, TEST_CH);
+    u32TableWr = HostReg_GetWriteCount();
+    HostReg_Trap(0UL);
+    memcpy(au8Table, (const void *)TEST_PDMA, sizeof(au8Table));
+
+    HOST_CHECK(u32OpWr == u32TableWr);
+    HOST_CHECK(memcmp(au8Op, au8Table, sizeof(au8Op)) == 0);
+    HOST_CHECK(TEST_PDMA->DSCT[TEST_CH].SA == psReq->sXfer.u32SrcAddr);
+    HOST_CHECK(TEST_PDMA->DSCT[TEST_CH].DA == psReq->sXfer.u32DstAddr);
+    HOST_CHECK(TEST_PDMA->INTEN == (1UL << TEST_CH));
+    HOST_CHECK(TEST_PDMA->SWREQ == (1UL << TEST_CH));
+}
+
+static void TestDmaQueue(const TEST_DMA_T *psDma)
+{
+    uint32_t i;
+
+    DmaRestart(psDma);
+
+    /* The first request starts at once, the others wait */
+    HOST_CHECK(NU_DmaChanSubmit(&s_sChan, NULL) == NU_ASYNC_ERR_PARAM);
+    for(i = 0UL; i < 3UL; i++)
+        HOST_CHECK(NU_DmaChanSubmit(&s_sChan, ReqInit(i, PDMA_MEM)) == NU_ASYNC_OK);
+    HOST_CHECK(s_asReq[0].i32Status == NU_ASYNC_RUNNING);
+    HOST_CHECK(s_asReq[1].i32Status == NU_ASYNC_QUEUED);
+    HOST_CHECK(s_asReq[2].i32Status == NU_ASYNC_QUEUED);
+    HOST_CHECK(NU_DmaChanSubmit(&s_sChan, &s_asReq[1]) == NU_ASYNC_ERR_BUSY);
+    HOST_CHECK(s_u32Swreqs == 1UL);
+    HOST_CHECK(HostReg_Get(&psDma->pu32Dsct[TEST_CH * 4UL + 1UL]) == s_asReq[0].sXfer.u32SrcAddr);
+
+    /* Flags of other channels and spurious calls leave the queue alone */
+    HostReg_Set(psDma->pu32Tdsts, 1UL << (TEST_CH + 1UL));
+    NU_DmaChanIRQHandler(&s_sChan);
+    HOST_CHECK(s_u32DoneNum == 0UL);
+    HOST_CHECK(HostReg_Get(psDma->pu32Tdsts) == (1UL << (TEST_CH + 1UL)));
+    HostReg_Set(psDma->pu32Tdsts, 0UL);
+
+    /* Done: the data arrived, the flag is cleared and the next request runs */
+    DmaFinish(psDma, 0UL);
+    HOST_CHECK(s_u32DoneNum == 1UL);
+    HOST_CHECK((s_au32Done[0] == 0UL) && (s_ai32Status[0] == NU_ASYNC_OK));
+    HOST_CHECK(s_asReq[0].i32Status == NU_ASYNC_OK);
+    HOST_CHECK(memcmp(s_au32Dst[0], s_au32Src[0], sizeof(s_au32Src[0])) == 0);
+    HOST_CHECK((HostReg_Get(psDma->pu32Tdsts) & (1UL << TEST_CH)) == 0UL);
+    HOST_CHECK(s_asReq[1].i32Status == NU_ASYNC_RUNNING);
+    HOST_CHECK(s_u32Swreqs == 2UL);
+    HOST_CHECK(HostReg_Get(&psDma->pu32Dsct[TEST_CH * 4UL + 2UL]) == s_asReq[1].sXfer.u32DstAddr);
+
+    /* Abort: reported, the channel is enabled again for the next request */
+    DmaFinish(psDma, 1UL);
+    HOST_CHECK((s_au32Done[1] == 1UL) && (s_ai32Status[1] == NU_ASYNC_ERR_ABORT));
+    HOST_CHECK(s_sChan.u32Aborts == 1UL);
+    HOST_CHECK((HostReg_Get(psDma->pu32Abtsts) & (1UL << TEST_CH)) == 0UL);
+    HOST_CHECK(HostReg_Get(psDma->pu32Chctl) & (1UL << TEST_CH));
+    HOST_CHECK(s_asReq[2].i32Status == NU_ASYNC_RUNNING);
+
+    DmaFinish(psDma, 0UL);
+    HOST_CHECK((s_au32Done[2] == 2UL) && (s_ai32Status[2] == NU_ASYNC_OK));
+    HOST_CHECK(memcmp(s_au32Dst[2], s_au32Src[2], sizeof(s_au32Src[2])) == 0);
+    HOST_CHECK((s_sChan.psHead == NULL) && (s_sChan.psTail == NULL));
+    HOST_CHECK(s_sChan.u32Done == 2UL);
+    HOST_CHECK(s_u32Swreqs == 3UL);
+
+    /* A request submitted from the callback starts after the queued one */
+    s_u32Resubmit = 1UL;
+    HOST_CHECK(NU_DmaChanSubmit(&s_sChan, ReqInit(0UL, PDMA_MEM)) == NU_ASYNC_OK);
+    HOST_CHECK(NU_DmaChanSubmit(&s_sChan, ReqInit(1UL, PDMA_MEM)) == NU_ASYNC_OK);
+    DmaFinish(psDma, 0UL);
+    HOST_CHECK(s_asReq[1].i32Status == NU_ASYNC_RUNNING);
+    HOST_CHECK(s_asReq[0].i32Status == NU_ASYNC_QUEUED);
+    DmaFinish(psDma, 0UL);
+    DmaFinish(psDma, 0UL);
+    HOST_CHECK(s_u32DoneNum == 6UL);
+    HOST_CHECK((s_au32Done[3] == 0UL) && (s_au32Done[4] == 1UL) && (s_au32Done[5] == 0UL));
+    HOST_CHECK(s_sChan.psHead == NULL);
+
+    /* Peripheral requests start on the request of their peripheral, not by software */
+    HOST_CHECK(NU_DmaChanSubmit(&s_sChan, ReqInit(3UL, PDMA_UART0_TX)) == NU_ASYNC_OK);
+    HOST_CHECK(s_u32Swreqs == 6UL);
+    DmaFinish(psDma, 0UL);
+    HOST_CHECK((s_au32Done[6] == 3UL) && (s_ai32Status[6] == NU_ASYNC_OK));
+}
+
+/* CAN backend */
+static S_NU_CAN_FRAME_T s_sFrame = {0x123UL, 0U, 0U, 8U, {0x11U, 0x22U, 0x33U, 0x44U, 0x55U, 0x66U, 0x77U, 0x88U}};
+
+#if defined(CAN_IF_CREQ_BUSY_Msk)
+static const S_NU_CAN_OPS_T s_sCanOps = NU_CAN_OPS;
+
+/* Message object u32Buf is written through interface register set 0 */
+static void CheckCanIf(const S_NU_CAN_FRAME_T *psFrame, uint32_t u32Buf)
+{
+    uint32_t u32Arb2 = CAN_IF_ARB2_MSGVAL_Msk | ((psFrame->u8Rtr != 0U) ? 0UL : CAN_IF_ARB2_DIR_Msk);
+
+    if(psFrame->u8Xtd)
+    {
+        HOST_CHECK(CAN0->IF[0].ARB1 == (psFrame->u32Id & 0xFFFFUL));
+        HOST_CHECK(CAN0->IF[0].ARB2 == (u32Arb2 | CAN_IF_ARB2_XTD_Msk | (psFrame->u32Id >> 16)));
+    }
+    else
+    {
+        HOST_CHECK(CAN0->IF[0].ARB2 == (u32Arb2 | (psFrame->u32Id << 2)));
+    }
+    HOST_CHECK((CAN0->IF[0].MCON & CAN_IF_MCON_DLC_Msk) == psFrame->u8Dlc);
+    HOST_CHECK(CAN0->IF[0].MCON & CAN_IF_MCON_TXIE_Msk);
+    HOST_CHECK(CAN0->IF[0].DAT_A1 == ((uint32_t)psFrame->au8Data[1] << 8 | psFrame->au8Data[0]));
+    HOST_CHECK(CAN0->IF[0].DAT_B2 == ((uint32_t)psFrame->au8Data[7] << 8 | psFrame->au8Data[6]));
+    HOST_CHECK(CAN0->IF[0].CMASK == (CAN_IF_CMASK_WRRD_Msk | CAN_IF_CMASK_TXRQSTNEWDAT_Msk));
+    HOST_CHECK(CAN0->IF[0].CREQ == 1UL + u32Buf);
+}
+
+static void TestCanBackend(void)
+{
+    S_NU_CAN_FRAME_T sFrame = s_sFrame;
+
+    HostReg_Reset();
+    HostReg_Trap(1UL);
+    HOST_CHECK(NU_OP(NU_CAN_BACKEND, Send)(CAN0, 5UL, &sFrame) == 0);
+    CheckCanIf(&sFrame, 5UL);
+
+    sFrame.u32Id = 0x1234567UL;
+    sFrame.u8Xtd = 1U;
+    HOST_CHECK(s_sCanOps.pfnSend(CAN0, 6UL, &sFrame) == 0);
+    CheckCanIf(&sFrame, 6UL);
+
+    sFrame.u8Rtr = 1U;
+    sFrame.u8Dlc = 0U;
+    HOST_CHECK(s_sCanOps.pfnSend(CAN0, 7UL, &sFrame) == 0);
+    CheckCanIf(&sFrame, 7UL);
+}
+#else
+#define TEST_CANFD_TXBC         0x100UL
+#define TEST_CANFD_T0_XTD       (1UL << 30)     /* Tx buffer element T0 bits, private to canfd.c */
+#define TEST_CANFD_T0_RTR       (1UL << 29)
+
+static const S_NU_CAN_OPS_T s_sCanOps = NU_CANFD_OPS;
+static uint32_t s_u32TxbarBuf;
+
+/* The controller takes the frame and marks the buffer pending */
+static void CanfdIrq(void)
+{
+    HostReg_Set(&CANFD0->TXBRP, HostReg_Get(&CANFD0->TXBRP) | s_u32TxbarBuf);
+}
+
+static uint32_t TxbarWrite(uint32_t u32Addr, uint32_t u32Old, uint32_t u32New)
+{
+    (void)u32Addr;
+    (void)u32Old;
+    s_u32TxbarBuf = u32New;
+    HostReg_RaiseIrq();
+    return u32New;
+}
+
+static void CheckCanfdBuf(const S_NU_CAN_FRAME_T *psFrame, uint32_t u32Buf)
+{
+    const CANFD_BUF_T *psBuf = (const CANFD_BUF_T *)(CANFD_SRAM_BASE_ADDR(CANFD0) + TEST_CANFD_TXBC + u32Buf * sizeof(CANFD_BUF_T));
+    uint32_t u32Id;
+
+    if(psFrame->u8Xtd)
+        u32Id = TEST_CANFD_T0_XTD | psFrame->u32Id;
+    else
+        u32Id = psFrame->u32Id << 18;
+    if(psFrame->u8Rtr)
+        u32Id |= TEST_CANFD_T0_RTR;
+
+    HOST_CHECK(psBuf->u32Id == u32Id);
+    HOST_CHECK(psBuf->u32Config == ((uint32_t)psFrame->u8Dlc << 16));
+    HOST_CHECK(memcmp(psBuf->au8Data, psFrame->au8Data, psFrame->u8Dlc) == 0);
+    HOST_CHECK(HostReg_Get(&CANFD0->TXBRP) & (1UL << u32Buf));
+}
+
+static void TestCanBackend(void)
+{
+    S_NU_CAN_FRAME_T sFrame = s_sFrame;
+
+    HostReg_Reset();
+    HostReg_Set(&CANFD0->TXBC, TEST_CANFD_TXBC);
+    HostReg_Set(&CANFD0->PSR, (uint32_t)eCANFD_IDLE << CANFD_PSR_ACT_Pos);
+    HostReg_SetHook(&CANFD0->TXBAR, NULL, TxbarWrite);
+    HostReg_SetIrq(CanfdIrq);
+    HostReg_Trap(1UL);
+
+    HOST_CHECK(NU_OP(NU_CAN_BACKEND, Send)(CANFD0, 0UL, &sFrame) == 0);
+    CheckCanfdBuf(&sFrame, 0UL);
+
+    sFrame.u32Id = 0x1234567UL;
+    sFrame.u8Xtd = 1U;
+    HOST_CHECK(s_sCanOps.pfnSend(CANFD0, 1UL, &sFrame) == 0);
+    CheckCanfdBuf(&sFrame, 1UL);
+
+    sFrame.u8Rtr = 1U;
+    sFrame.u8Dlc = 0U;
+    HOST_CHECK(s_sCanOps.pfnSend(CANFD0, 2UL, &sFrame) == 0);
+    CheckCanfdBuf(&sFrame, 2UL);
+
+    /* A pending buffer is busy */
+    HOST_CHECK(s_sCanOps.pfnSend(CANFD0, 1UL, &s_sFrame) == -1);
+    HOST_CHECK(s_u32TxbarBuf == (1UL << 2));
+}
+#endif
+
+/* CAN transmit queue against a scripted controller */
+static S_NU_CAN_FRAME_T s_asSent[NU_CAN_TXQ_LEN * 2UL];
+static uint32_t s_u32SentNum, s_u32CanBusy;
+
+static int32_t FakeSend(void *pvPort, uint32_t u32Buf, const S_NU_CAN_FRAME_T *psFrame)
+{
+    (void)pvPort;
+    HOST_CHECK(u32Buf == 3UL);
+    if(s_u32CanBusy)
+        return -1;
+    s_asSent[s_u32SentNum++] = *psFrame;
+    return 0;
+}
+
+static void TestCanTxq(void)
+{
+    static S_NU_CAN_OPS_T sOps;
+    S_NU_CAN_TXQ_T sTxq;
+    S_NU_CAN_FRAME_T sFrame = s_sFrame;
+    uint32_t i;
+
+    sOps = s_sCanOps;
+    sOps.pfnSend = FakeSend;
+    NU_CanTxqInit(&sTxq, &sOps, NULL, 3UL);
+    s_u32SentNum = 0UL;
+    s_u32CanBusy = 0UL;
+
+    /* The first frame goes to the buffer, the next ones wait until it was sent */
+    for(i = 0UL; i <= NU_CAN_TXQ_LEN; i++)
+    {
+        sFrame.u32Id = i;
+        HOST_CHECK(NU_CanTxqSend(&sTxq, &sFrame) == NU_ASYNC_OK);
+    }
+    HOST_CHECK((s_u32SentNum == 1UL) && (sTxq.u32InFlight == 1UL));
+
+    /* Full queue: the frame is dropped and counted */
+    sFrame.u32Id = 0x7FFUL;
+    HOST_CHECK(NU_CanTxqSend(&sTxq, &sFrame) == NU_ASYNC_ERR_FULL);
+    HOST_CHECK(sTxq.u32Drops == 1UL);
+
+    /* Each transmit complete sends the next frame, in order */
+    for(i = 1UL; i <= NU_CAN_TXQ_LEN; i++)
+    {
+        NU_CanTxqIRQHandler(&sTxq);
+        HOST_CHECK(s_u32SentNum == i + 1UL);
+        HOST_CHECK(sTxq.u32Sent == i);
+    }
+    for(i = 0UL; i <= NU_CAN_TXQ_LEN; i++)
+        HOST_CHECK(s_asSent[i].u32Id == i);
+    NU_CanTxqIRQHandler(&sTxq);
+    HOST_CHECK((sTxq.u32InFlight == 0UL) && (sTxq.u32Sent == NU_CAN_TXQ_LEN + 1UL));
+    NU_CanTxqIRQHandler(&sTxq);
+    HOST_CHECK(sTxq.u32Sent == NU_CAN_TXQ_LEN + 1UL);
+
+    /* A buffer used by other code keeps the frames queued until it completes */
+    s_u32CanBusy = 1UL;
+    sFrame.u32Id = 0x100UL;
+    HOST_CHECK(NU_CanTxqSend(&sTxq, &sFrame) == NU_ASYNC_OK);
+    sFrame.u32Id = 0x101UL;
+    HOST_CHECK(NU_CanTxqSend(&sTxq, &sFrame) == NU_ASYNC_OK);
+    HOST_CHECK((sTxq.u32InFlight == 0UL) && (s_u32SentNum == NU_CAN_TXQ_LEN + 1UL));
+    NU_CanTxqIRQHandler(&sTxq);
+    HOST_CHECK(sTxq.u32Sent == NU_CAN_TXQ_LEN + 1UL);
+    s_u32CanBusy = 0UL;
+    NU_CanTxqIRQHandler(&sTxq);
+    HOST_CHECK((sTxq.u32InFlight == 1UL) && (s_asSent[s_u32SentNum - 1UL].u32Id == 0x100UL));
+    NU_CanTxqIRQHandler(&sTxq);
+    HOST_CHECK(s_asSent[s_u32SentNum - 1UL].u32Id == 0x101UL);
+    NU_CanTxqIRQHandler(&sTxq);
+    HOST_CHECK((sTxq.u32Sent == NU_CAN_TXQ_LEN + 3UL) && (sTxq.u32Drops == 1UL));
+}
+
+int main(void)
+{
+    TEST_DMA_T sPdma = {&s_sPdmaOps, TEST_PDMA, &TEST_PDMA->DSCT[0].CTL, &TEST_PDMA->CHCTL,
+                        &TEST_PDMA->SWREQ, &TEST_PDMA->ABTSTS, &TEST_PDMA->TDSTS
+                       };
+#if defined(LPPDMA0)
+    static const S_NU_DMA_OPS_T sLppdmaOps = NU_LPPDMA_OPS;
+    TEST_DMA_T sLppdma = {&sLppdmaOps, LPPDMA0, &LPPDMA0->LPDSCT[0].CTL, &LPPDMA0->CHCTL,
+                          &LPPDMA0->SWREQ, &LPPDMA0->ABTSTS, &LPPDMA0->TDSTS
+                         };
+#endif
+
+    HostReg_Reset();
+    TestDispatch();
+    TestDmaQueue(&sPdma);
+#if defined(LPPDMA0)
+    TestDmaQueue(&sLppdma);
+#endif
+    TestCanBackend();
+    TestCanTxq();
+
+    return HostTest_Result("nu_drv");
+}
@@ -0,0 +1,139 @@
+/**************************************************************************//**
+ * @file     nvt_fast_test.c
+ * @brief    Host test and benchmark of the NVT_FAST placement annotations
+ *
+ * canfd.c is built again with NVT_FAST_CODE_SECTION / NVT_FAST_DATA_SECTION
+ * set to sections the linker gives start and stop symbols, once without and
+ * once with NVT_FAST_CANFD:
+ * - Without the group the annotations must compile away: neither section
+ *   exists in the executable.
+ * - With the group the CAN FD read path is in the code section, the DLC
+ *   table is the only object of the data section, and functions outside
+ *   the group stay where they were.
+ * Both builds read Rx FIFO messages of every DLC and time the read path.
+ * The host has no flash wait states, so the two times only show what the
+ * noinline placement costs; the gain from SRAM exists on target only.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2024 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "NuMicro.h"
+#include "host_regs.h"
+
+#define TEST_FIFO_START     0x100UL
+#define TEST_GET_INDEX      3UL
+#define BENCH_READS         200000UL
+
+/* R1 word of an Rx element, private to canfd.c */
+#define TEST_ELEM_DLC_Pos   16
+#define TEST_ELEM_FDF_Msk   (1UL << 21)
+
+/* Set by the linker for sections with these names, weak so they are NULL when the section is absent */
+extern const uint8_t __start_nvt_fast_text[] __attribute__((weak));
+extern const uint8_t __stop_nvt_fast_text[] __attribute__((weak));
+extern const uint8_t __start_nvt_fast_rodata[] __attribute__((weak));
+extern const uint8_t __stop_nvt_fast_rodata[] __attribute__((weak));
+
+static const uint8_t s_au8DlcBytes[16] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 20, 24, 32, 48, 64 };
+
+static uint32_t InFastText(const void *pvFunc)
+{
+    const uint8_t *pu8Addr = (const uint8_t *)pvFunc;
+
+    return ((pu8Addr >= __start_nvt_fast_text) && (pu8Addr < __stop_nvt_fast_text)) ? 1UL : 0UL;
+}
+
+static void TestPlacement(void)
+{
+#if defined(NVT_FAST_CANFD)
+    HOST_CHECK(InFastText((const void *)(uintptr_t)CANFD_ReadRxBufMsg));
+    HOST_CHECK(InFastText((const void *)(uintptr_t)CANFD_ReadRxFifoMsg));
+    HOST_CHECK(InFastText((const void *)(uintptr_t)CANFD_CopyDBufToMsgBuf));
+    HOST_CHECK(InFastText((const void *)(uintptr_t)CANFD_CopyRxFifoToMsgBuf));
+    HOST_CHECK(!InFastText((const void *)(uintptr_t)CANFD_TxBufCancelReq));
+    HOST_CHECK((__stop_nvt_fast_rodata - __start_nvt_fast_rodata) == (long)sizeof(s_au8DlcBytes));
+    HOST_CHECK(memcmp(__start_nvt_fast_rodata, s_au8DlcBytes, sizeof(s_au8DlcBytes)) == 0);
+#else
+    HOST_CHECK((__start_nvt_fast_text == NULL) && (__stop_nvt_fast_text == NULL));
+    HOST_CHECK((__start_nvt_fast_rodata == NULL) && (__stop_nvt_fast_rodata == NULL));
+#endif
+}
+
+/* Rx FIFO 0 holds one message at TEST_GET_INDEX; trapping is off, registers are plain memory */
+static CANFD_BUF_T *SetupFifo(void)
+{
+    CANFD_BUF_T *psElem;
+    uint32_t i;
+
+    CANFD0->RXF0C = TEST_FIFO_START;
+    *(volatile uint32_t *)&CANFD0->RXF0S = (TEST_GET_INDEX << 8) | 1UL;
+    psElem = (CANFD_BUF_T *)(uintptr_t)(CANFD_SRAM_BASE_ADDR(CANFD0) + TEST_FIFO_START + (TEST_GET_INDEX * sizeof(CANFD_BUF_T)));
+    psElem->u32Id = 0x123UL << 18;
+    for(i = 0UL; i < CANFD_MAX_MESSAGE_BYTES; i++)
+        psElem->au8Data[i] = (uint8_t)(0xA0U + i);
+    return psElem;
+}
+
+/* Every DLC decodes through the (placed) table */
+static void TestRead(void)
+{
+    CANFD_BUF_T *psElem = SetupFifo();
+    CANFD_FD_MSG_T sMsg;
+    uint32_t u32Dlc, i, u32Ok;
+
+    for(u32Dlc = 0UL; u32Dlc < 16UL; u32Dlc++)
+    {
+        psElem->u32Config = (u32Dlc << TEST_ELEM_DLC_Pos) | TEST_ELEM_FDF_Msk;
+        memset(&sMsg, 0, sizeof(sMsg));
+        CANFD0->RXF0A = 0UL;
+
+        HOST_CHECK(CANFD_ReadRxFifoMsg(CANFD0, 0U, &sMsg) == 1UL);
+        HOST_CHECK(CANFD0->RXF0A == TEST_GET_INDEX);
+        HOST_CHECK((sMsg.u32Id == 0x123UL) && (sMsg.eIdType == eCANFD_SID) && sMsg.bFDFormat);
+        HOST_CHECK(sMsg.u32DLC == s_au8DlcBytes[u32Dlc]);
+        for(i = 0UL, u32Ok = 1UL; i < CANFD_MAX_MESSAGE_BYTES; i++)
+        {
+            if(sMsg.au8Data[i] != ((i < sMsg.u32DLC) ? (uint8_t)(0xA0U + i) : 0U))
+                u32Ok = 0UL;
+        }
+        HOST_CHECK(u32Ok);
+    }
+}
+
+static void BenchRead(void)
+{
+    CANFD_BUF_T *psElem = SetupFifo();
+    CANFD_FD_MSG_T sMsg;
+    uint64_t u64Start, u64Ns;
+    uint32_t i, u32Read = 0UL;
+
+    psElem->u32Config = 15UL << TEST_ELEM_DLC_Pos;
+    u64Start = HostBench_Ns();
+    for(i = 0UL; i < BENCH_READS; i++)
+        u32Read += CANFD_ReadRxFifoMsg(CANFD0, 0U, &sMsg);
+    u64Ns = HostBench_Ns() - u64Start;
+
+    HOST_CHECK(u32Read == BENCH_READS);
+#if defined(NVT_FAST_CANFD)
+    printf("NVT_FAST_CANFD: %.1f ns per 64 byte Rx FIFO read\n", (double)u64Ns / BENCH_READS);
+#else
+    printf("no NVT_FAST group: %.1f ns per 64 byte Rx FIFO read\n", (double)u64Ns / BENCH_READS);
+#endif
+}
+
+int main(void)
+{
+    HostReg_Reset();
+
+    TestPlacement();
+    TestRead();
+    BenchRead();
+
+#if defined(NVT_FAST_CANFD)
+    return HostTest_Result("nvt_fast_canfd");
+#else
+    return HostTest_Result("nvt_fast");
+#endif
+}
@@ -0,0 +1,234 @@
+/**************************************************************************//**
+ * @file     retarget_log_test.c
+ * @brief    Host test of the DEFERRED_PRINTF output of retarget.c
+ *
+ * retarget.c is built with DEFERRED_PRINTF and a 256 byte ring. The debug
+ * port is a UART model: DAT writes go into a 16 byte TX FIFO, FIFOSTS
+ * reports its level, and the wire takes one character out of it per time
+ * step. Whenever the TX empty interrupt is enabled and the FIFO is empty,
+ * DebugLog_IRQHandler runs.
+ *
+ * Thread bursts through _write overflow the ring while short messages
+ * from an interrupt are written through SendChar_ToUART between the time
+ * steps. The wire must carry every accepted character in write order, LF
+ * as CR LF, and the drop count must match the characters that did not
+ * fit. DebugLog_EnterPanic must then flush the ring by polling and leave
+ * later output synchronous.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2024 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "NuMicro.h"
+#include "host_regs.h"
+
+#define TEST_FIFO_DEPTH     16UL
+#define TEST_WIRE_MAX       65536UL
+
+/* Output functions of retarget.c */
+int _write(int fd, char *ptr, int len);
+void SendChar_ToUART(int ch);
+int IsDebugFifoEmpty(void);
+
+static uint8_t s_au8Fifo[TEST_FIFO_DEPTH];
+static uint32_t s_u32FifoIn, s_u32FifoOut, s_u32Overruns, s_u32Polling, s_u32Inten;
+static char s_acWire[TEST_WIRE_MAX], s_acExpect[TEST_WIRE_MAX];
+static uint32_t s_u32WireLen, s_u32ExpectLen, s_u32Accepted, s_u32DatWrites, s_u32Drops;
+static uint32_t s_u32Seed = 0x7A3F12C5UL;
+
+static uint32_t Rand(void)
+{
+    s_u32Seed = s_u32Seed * 1664525UL + 1013904223UL;
+    return s_u32Seed >> 8;
+}
+
+/* The wire sends the oldest character of the FIFO */
+static void Shift(void)
+{
+    if(s_u32FifoIn != s_u32FifoOut)
+    {
+        if(s_u32WireLen < TEST_WIRE_MAX)
+            s_acWire[s_u32WireLen++] = (char)s_au8Fifo[s_u32FifoOut % TEST_FIFO_DEPTH];
+        s_u32FifoOut++;
+    }
+}
+
+static uint32_t DatWrite(uint32_t u32Addr, uint32_t u32Old, uint32_t u32New)
+{
+    (void)u32Addr;
+    (void)u32Old;
+    if((s_u32FifoIn - s_u32FifoOut) >= TEST_FIFO_DEPTH)
+        s_u32Overruns++;
+    else
+        s_au8Fifo[s_u32FifoIn++ % TEST_FIFO_DEPTH] = (uint8_t)u32New;
+    s_u32DatWrites++;
+    return u32New;
+}
+
+/* A CPU polling a full FIFO waits for the wire */
+static uint32_t FifoStsRead(uint32_t u32Addr, uint32_t u32Val)
+{
+    uint32_t u32Sts = UART_FIFOSTS_RXEMPTY_Msk;
+
+    (void)u32Addr;
+    (void)u32Val;
+    if(s_u32Polling && ((s_u32FifoIn - s_u32FifoOut) >= TEST_FIFO_DEPTH))
+        Shift();
+    if((s_u32FifoIn - s_u32FifoOut) >= TEST_FIFO_DEPTH)
+        u32Sts |= UART_FIFOSTS_TXFULL_Msk;
+    if(s_u32FifoIn == s_u32FifoOut)
+        u32Sts |= UART_FIFOSTS_TXEMPTY_Msk | UART_FIFOSTS_TXEMPTYF_Msk;
+    return u32Sts;
+}
+
+static uint32_t IntenWrite(uint32_t u32Addr, uint32_t u32Old, uint32_t u32New)
+{
+    (void)u32Addr;
+    (void)u32Old;
+    s_u32Inten = u32New;
+    return u32New;
+}
+
+/* What the ring accepts of a write: LF takes two entries, a character that does not fit is dropped */
+static void Expect(const char *pcStr, uint32_t u32Len)
+{
+    uint32_t i, u32Need;
+
+    for(i = 0UL; i < u32Len; i++)
+    {
+        u32Need = (pcStr[i] == '\n') ? 2UL : 1UL;
+        if(((s_u32Accepted - s_u32DatWrites) + u32Need) > DEFERRED_PRINTF_BUF_SIZE)
+        {
+            s_u32Drops++;
+            continue;
+        }
+        if(pcStr[i] == '\n')
+            s_acExpect[s_u32ExpectLen++] = '\r';
+        s_acExpect[s_u32ExpectLen++] = pcStr[i];
+        s_u32Accepted += u32Need;
+    }
+}
+
+/* A burst of thread messages through _write, without time passing */
+static void ThreadBurst(uint32_t u32Msgs)
+{
+    char acMsg[64];
+    uint32_t i, u32Len;
+
+    for(i = 0UL; i < u32Msgs; i++)
+    {
+        u32Len = (uint32_t)snprintf(acMsg, sizeof(acMsg), "thread %lu:%.*s\n", (unsigned long)(Rand() % 10000UL),
+                                    (int)(Rand() % 40UL), "........................................");
+        Expect(acMsg, u32Len);
+        HOST_CHECK(_write(1, acMsg, (int)u32Len) == (int)u32Len);
+    }
+}
+
+/* A short message from an interrupt, one character at a time */
+static void IsrMessage(void)
+{
+    char acMsg[16];
+    uint32_t i, u32Len;
+
+    u32Len = (uint32_t)snprintf(acMsg, sizeof(acMsg), "isr%lu\n", (unsigned long)(Rand() % 100UL));
+    for(i = 0UL; i < u32Len; i++)
+    {
+        Expect(&acMsg[i], 1UL);
+        SendChar_ToUART(acMsg[i]);
+    }
+}
+
+/* Time steps of one character each, with the TX empty interrupt */
+static void Run(uint32_t u32Steps, uint32_t u32IsrEvery)
+{
+    uint32_t i;
+
+    for(i = 0UL; i < u32Steps; i++)
+    {
+        Shift();
+        if((s_u32Inten & UART_INTEN_THREIEN_Msk) && (s_u32FifoIn == s_u32FifoOut))
+            DebugLog_IRQHandler();
+        if((u32IsrEvery != 0UL) && ((i % u32IsrEvery) == 0UL))
+            IsrMessage();
+    }
+}
+
+static uint32_t WireMatches(void)
+{
+    if((s_u32WireLen == s_u32ExpectLen) && (memcmp(s_acWire, s_acExpect, s_u32WireLen) == 0))
+        return 1UL;
+
+    printf("wire %lu characters, expected %lu\n", (unsigned long)s_u32WireLen, (unsigned long)s_u32ExpectLen);
+    return 0UL;
+}
+
+/* Bursts larger than the ring, with interrupt messages while it drains */
+static void TestBursts(void)
+{
+    uint32_t u32Round;
+
+    for(u32Round = 0UL; u32Round < 50UL; u32Round++)
+    {
+        ThreadBurst(1UL + (Rand() % 12UL));
+        Run(Rand() % 400UL, 13UL + (Rand() % 50UL));
+    }
+
+    /* Drain: the interrupt is disabled once the ring is empty */
+    Run(DEFERRED_PRINTF_BUF_SIZE + TEST_FIFO_DEPTH + 1UL, 0UL);
+    HOST_CHECK((s_u32Inten & UART_INTEN_THREIEN_Msk) == 0UL);
+    HOST_CHECK(IsDebugFifoEmpty() == 1);
+
+    printf("bursts: %lu characters sent, %lu dropped\n", (unsigned long)s_u32WireLen, (unsigned long)s_u32Drops);
+    HOST_CHECK(s_u32Drops != 0UL);
+    HOST_CHECK(DebugLog_GetDropCount() == s_u32Drops);
+    HOST_CHECK(s_u32Overruns == 0UL);
+    HOST_CHECK(WireMatches());
+}
+
+/* Panic with a full ring: flushed by polling, then synchronous */
+static void TestPanic(void)
+{
+    static const char acAfter[] = "HardFault\n";
+    uint32_t u32Drops = DebugLog_GetDropCount();
+
+    ThreadBurst(12UL);
+    Run(20UL, 0UL);
+    HOST_CHECK(IsDebugFifoEmpty() == 0);
+
+    s_u32Polling = 1UL;
+    DebugLog_EnterPanic();
+    HOST_CHECK((s_u32Inten & UART_INTEN_THREIEN_Msk) == 0UL);
+    HOST_CHECK(DebugLog_GetDropCount() == s_u32Drops);
+    u32Drops = s_u32Drops;
+
+    /* Nothing is dropped any more, however much is written */
+    memcpy(&s_acExpect[s_u32ExpectLen], "HardFault\r\n", 11UL);
+    s_u32ExpectLen += 11UL;
+    HOST_CHECK(_write(1, (char *)acAfter, (int)(sizeof(acAfter) - 1UL)) == (int)(sizeof(acAfter) - 1UL));
+    SendChar_ToUART('!');
+    SendChar_ToUART('\n');
+    memcpy(&s_acExpect[s_u32ExpectLen], "!\r\n", 3UL);
+    s_u32ExpectLen += 3UL;
+    HOST_CHECK((s_u32Inten & UART_INTEN_THREIEN_Msk) == 0UL);
+    HOST_CHECK(DebugLog_GetDropCount() == u32Drops);
+
+    while(s_u32FifoIn != s_u32FifoOut)
+        Shift();
+    HOST_CHECK(s_u32Overruns == 0UL);
+    HOST_CHECK(WireMatches());
+}
+
+int main(void)
+{
+    HostReg_Reset();
+    HostReg_SetHook(&DEBUG_PORT->DAT, NULL, DatWrite);
+    HostReg_SetHook(&DEBUG_PORT->FIFOSTS, FifoStsRead, NULL);
+    HostReg_SetHook(&DEBUG_PORT->INTEN, NULL, IntenWrite);
+    HostReg_Trap(1UL);
+
+    TestBursts();
+    TestPanic();
+
+    return HostTest_Result("retarget_log");
+}
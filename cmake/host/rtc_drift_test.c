@@ -0,0 +1,165 @@
+/**************************************************************************//**
+ * @file     rtc_drift_test.c
+ * @brief    Host test of the RTC 32 kHz drift compensation
+ *
+ * Feeds synthetic LXT drift profiles to RTC_DriftIRQHandler as timer
+ * captures and checks the frequency RTC_DriftProcess programs into
+ * RTC_FREQADJ against the true LXT frequency:
+ * - HXT reference: a temperature ramp from +20 to -40 ppm.
+ * - 1PPS reference: a constant offset with a spurious and a lost pulse,
+ *   which the range check must reject.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2024 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+#include "host_regs.h"
+
+#define TEST_HXT_HZ         12000000UL
+#define TEST_LXT_HZ         32768.0
+
+static S_RTC_DRIFT_T s_sDrift;
+static uint32_t s_u32Writes, s_u32LastAdj;
+static double s_dMaxErrPpm;
+
+static double Abs(double dVal)
+{
+    return (dVal < 0.0) ? -dVal : dVal;
+}
+
+/* Drift of the LXT over time: hold, ramp from dFrom to dTo ppm, hold */
+static double Profile(double dT, double dHold, double dRamp, double dFrom, double dTo)
+{
+    if(dT < dHold)
+        return dFrom;
+    if(dT < (dHold + dRamp))
+        return dFrom + (dTo - dFrom) * (dT - dHold) / dRamp;
+    return dTo;
+}
+
+/* Frequency programmed into RTC_FREQADJ */
+static double FreqAdj(void)
+{
+    uint32_t u32Adj = RTC->FREQADJ;
+
+    return (double)RTC_FCR_REFERENCE + (double)((u32Adj & RTC_FREQADJ_INTEGER_Msk) >> RTC_FREQADJ_INTEGER_Pos) +
+           (double)(u32Adj & RTC_FREQADJ_FRACTION_Msk) / 64.0;
+}
+
+/* One timer capture, then the thread context; the error is checked from dCheckT on */
+static void Capture(uint32_t u32Cap, double dT, double dPpm, double dCheckT)
+{
+    double dErr;
+
+    /* Trapping is off, registers are plain memory */
+    *(volatile uint32_t *)&TIMER0->CAP = u32Cap & TIMER_CAP_CAPDAT_Msk;
+    TIMER0->EINTSTS = TIMER_EINTSTS_CAPIF_Msk;
+    RTC_DriftIRQHandler(&s_sDrift);
+    HOST_CHECK(RTC_DriftProcess(&s_sDrift) == RTC_OK);
+
+    if(RTC->FREQADJ != s_u32LastAdj)
+    {
+        s_u32LastAdj = RTC->FREQADJ;
+        s_u32Writes++;
+    }
+
+    if(dT >= dCheckT)
+    {
+        dErr = Abs(FreqAdj() - TEST_LXT_HZ * (1.0 + dPpm / 1e6)) * 1e6 / TEST_LXT_HZ;
+        if(dErr > s_dMaxErrPpm)
+            s_dMaxErrPpm = dErr;
+    }
+}
+
+static void Reset(void)
+{
+    RTC->FREQADJ = 0UL;
+    s_u32LastAdj = 0UL;
+    s_u32Writes = 0UL;
+    s_dMaxErrPpm = 0.0;
+}
+
+/*
+ * Timer on HXT capturing every 256 LXT cycles, 4 s windows. The LXT holds +20 ppm for 60 s, then
+ * drifts to -40 ppm at 0.05 ppm/s, as over a temperature sweep, and holds there. The filter lags by
+ * about 2^RTC_DRIFT_FILTER_SHIFT windows, 0.8 ppm on the ramp, FREQADJ is only reprogrammed after a
+ * change of RTC_DRIFT_STEP_X10000, 0.48 ppm, and is rounded to 1/64 Hz, so the programmed frequency
+ * stays within 1.7 ppm once the first window is in.
+ */
+static void TestHxtRamp(void)
+{
+    double dT = 0.0, dPpm;
+    uint32_t i;
+
+    Reset();
+    RTC_DriftInit(&s_sDrift, TIMER0, RTC_DRIFT_REF_HXT, TEST_HXT_HZ, 4UL);
+    HOST_CHECK(s_sDrift.u32Window == 512UL);
+    HOST_CHECK((TIMER0->EXTCTL & TIMER_EXTCTL_CAPEN_Msk) && (TIMER0->CTL & TIMER_CTL_CNTEN_Msk));
+
+    for(i = 0UL; dT < 1440.0; i++)
+    {
+        dPpm = Profile(dT, 60.0, 1200.0, 20.0, -40.0);
+        dT += (double)RTC_DRIFT_LXT_DIV / (TEST_LXT_HZ * (1.0 + dPpm / 1e6));
+        Capture((uint32_t)(uint64_t)(dT * TEST_HXT_HZ), dT, dPpm, 5.0);
+    }
+
+    printf("HXT ramp: max error %.2f ppm, %u FREQADJ writes\n", s_dMaxErrPpm, s_u32Writes);
+    HOST_CHECK(s_dMaxErrPpm < 1.7);
+    HOST_CHECK(s_sDrift.u32Rejects == 0UL);
+    /* Not reprogrammed on every window: each write moves by at least one step, 60 ppm are at most
+       126 steps, and the ramp adds 0.2 ppm per window to it */
+    HOST_CHECK((s_u32Writes > 80UL) && (s_u32Writes <= 126UL));
+    HOST_CHECK(Abs(FreqAdj() - TEST_LXT_HZ * (1.0 - 40.0 / 1e6)) * 1e6 / TEST_LXT_HZ < 0.5);
+
+    RTC_DriftClose(&s_sDrift);
+    HOST_CHECK((TIMER0->CTL == 0UL) && (TIMER0->EXTCTL == 0UL));
+}
+
+/*
+ * Timer on LXT capturing a 1PPS signal, 16 s windows. The LXT runs at -25 ppm. One window counts a
+ * spurious pulse half way through a second, a later one misses a pulse; both are far beyond the
+ * range check and must not move the calibration. A window is resolved to 1/16 count, 1.9 ppm, which
+ * the filter averages down.
+ */
+static void TestPpsGlitch(void)
+{
+    double dPpm = -25.0, dHz = TEST_LXT_HZ * (1.0 + dPpm / 1e6);
+    uint32_t u32Sec, u32Adj = 0UL;
+
+    Reset();
+    RTC_DriftInit(&s_sDrift, TIMER0, RTC_DRIFT_REF_1PPS, 0UL, 16UL);
+    HOST_CHECK(s_sDrift.u32Window == 16UL);
+    HOST_CHECK((TIMER0->CTL & TIMER_CTL_CAPSRC_Msk) == 0UL);
+
+    for(u32Sec = 0UL; u32Sec < 1200UL; u32Sec++)
+    {
+        if(u32Sec == 600UL)
+        {
+            u32Adj = RTC->FREQADJ;
+            Capture((uint32_t)(uint64_t)(((double)u32Sec + 0.5) * dHz), (double)u32Sec + 0.5, dPpm, 80.0);
+            HOST_CHECK(s_sDrift.u32Rejects == 0UL);
+        }
+        if(u32Sec == 900UL)
+            continue;
+        Capture((uint32_t)(uint64_t)((double)u32Sec * dHz), (double)u32Sec, dPpm, 80.0);
+    }
+
+    printf("1PPS glitch: max error %.2f ppm, %u rejected windows\n", s_dMaxErrPpm, s_sDrift.u32Rejects);
+    /* The spurious pulse shortens one or two windows by half a second, the lost one lengthens one */
+    HOST_CHECK((s_sDrift.u32Rejects >= 2UL) && (s_sDrift.u32Rejects <= 3UL));
+    HOST_CHECK(s_dMaxErrPpm < 2.0);
+    HOST_CHECK(u32Adj != 0UL);
+
+    RTC_DriftClose(&s_sDrift);
+}
+
+int main(void)
+{
+    HostReg_Reset();
+
+    TestHxtRamp();
+    TestPpsGlitch();
+
+    return HostTest_Result("rtc_drift");
+}
@@ -0,0 +1,60 @@
+/**************************************************************************//**
+ * @file     rtc_epoch_test.c
+ * @brief    Host test of the RTC epoch conversion
+ *
+ * Converts every day from 2000 to 2099, at a time of day that moves through
+ * the day, to date and time and back, and checks a few known dates.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2024 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+
+typedef struct
+{
+    uint32_t u32Epoch;
+    uint32_t u32Year, u32Month, u32Day, u32DayOfWeek, u32Hour, u32Minute, u32Second;
+} S_EPOCH_CASE_T;
+
+static const S_EPOCH_CASE_T s_asCase[] =
+{
+    { 946684800UL,  2000UL,  1UL,  1UL, RTC_SATURDAY,  0UL,  0UL,  0UL },
+    { 951782400UL,  2000UL,  2UL, 29UL, RTC_TUESDAY,   0UL,  0UL,  0UL },
+    { 1709210096UL, 2024UL,  2UL, 29UL, RTC_THURSDAY, 12UL, 34UL, 56UL },
+    { 4102444799UL, 2099UL, 12UL, 31UL, RTC_THURSDAY, 23UL, 59UL, 59UL },
+};
+
+int main(void)
+{
+    S_RTC_TIME_DATA_T sTime;
+    uint32_t u32Epoch, i, u32Err = 0UL;
+
+    for(i = 0UL; i < sizeof(s_asCase) / sizeof(s_asCase[0]); i++)
+    {
+        RTC_EpochToDateAndTime(s_asCase[i].u32Epoch, &sTime);
+        if((sTime.u32Year != s_asCase[i].u32Year) || (sTime.u32Month != s_asCase[i].u32Month) ||
+                (sTime.u32Day != s_asCase[i].u32Day) || (sTime.u32DayOfWeek != s_asCase[i].u32DayOfWeek) ||
+                (sTime.u32Hour != s_asCase[i].u32Hour) || (sTime.u32Minute != s_asCase[i].u32Minute) ||
+                (sTime.u32Second != s_asCase[i].u32Second))
+        {
+            printf("%lu: got %lu-%lu-%lu (%lu) %lu:%lu:%lu\n", (unsigned long)s_asCase[i].u32Epoch,
+                   (unsigned long)sTime.u32Year, (unsigned long)sTime.u32Month, (unsigned long)sTime.u32Day,
+                   (unsigned long)sTime.u32DayOfWeek, (unsigned long)sTime.u32Hour,
+                   (unsigned long)sTime.u32Minute, (unsigned long)sTime.u32Second);
+            u32Err++;
+        }
+    }
+
+    for(u32Epoch = RTC_EPOCH_YEAR2000; u32Epoch < 4102444800UL; u32Epoch += 86400UL + 61UL)
+    {
+        RTC_EpochToDateAndTime(u32Epoch, &sTime);
+        if(RTC_DateAndTimeToEpoch(&sTime) != u32Epoch)
+        {
+            printf("%lu: round trip gives %lu\n", (unsigned long)u32Epoch, (unsigned long)RTC_DateAndTimeToEpoch(&sTime));
+            u32Err++;
+        }
+    }
+
+    return (u32Err == 0UL) ? 0 : 1;
+}
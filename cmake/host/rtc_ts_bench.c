@@ -0,0 +1,117 @@
+/**************************************************************************//**
+ * @file     rtc_ts_bench.c
+ * @brief    Host benchmark of the RTC timestamp against RTC_GetDateAndTime
+ *
+ * Checks that the cached timestamp follows the calendar and the tick
+ * interrupt, then compares the register accesses and the host time per
+ * call of RTC_GetTimestamp with RTC_GetDateAndTime + RTC_DateAndTimeToEpoch.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2024 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+#include "host_regs.h"
+
+#define BENCH_LOOPS     1000000UL
+
+/* RTC_INTSTS is write-one-to-clear */
+static uint32_t IntStsWrite(uint32_t u32Addr, uint32_t u32Old, uint32_t u32New)
+{
+    (void)u32Addr;
+    return u32Old & ~u32New;
+}
+
+#if defined(RTC_RWEN_RWENF_Msk)
+/* Writing the key to RTC_RWEN opens register access at once */
+static uint32_t RwenWrite(uint32_t u32Addr, uint32_t u32Old, uint32_t u32New)
+{
+    (void)u32Addr;
+    (void)u32Old;
+    return (u32New == RTC_WRITE_KEY) ? RTC_RWEN_RWENF_Msk : 0UL;
+}
+#endif
+
+static void Tick(void)
+{
+    HostReg_Set(&RTC->INTSTS, RTC_INTSTS_TICKIF_Msk);
+    RTC_TimestampTickHandler();
+    HOST_CHECK((HostReg_Get(&RTC->INTSTS) & RTC_INTSTS_TICKIF_Msk) == 0UL);
+}
+
+int main(void)
+{
+    S_RTC_TIME_DATA_T sTime;
+    volatile uint64_t u64Ts = 0ULL;
+    volatile uint32_t u32Epoch = 0UL;
+    uint64_t u64Start, u64DtNs, u64TsNs;
+    uint32_t i, u32DtAcc, u32TsAcc;
+
+    HostReg_Reset();
+    HostReg_SetHook(&RTC->INTSTS, NULL, IntStsWrite);
+#if defined(RTC_RWEN_RWENF_Msk)
+    HostReg_SetHook(&RTC->RWEN, NULL, RwenWrite);
+#endif
+    HostReg_Trap(1UL);
+
+    /* 2024-02-29 12:34:56, 24-hour */
+    RTC->CLKFMT = RTC_CLOCK_24;
+    RTC->CAL = 0x00240229UL;
+    RTC->TIME = 0x00123456UL;
+    RTC_TimestampInit(RTC_TICK_1_128_SEC);
+
+    RTC_GetDateAndTime(&sTime);
+    HOST_CHECK(RTC_TS_SEC(RTC_GetTimestamp()) == 1709210096UL);
+    HOST_CHECK(RTC_TS_SEC(RTC_GetTimestamp()) == RTC_DateAndTimeToEpoch(&sTime));
+    HOST_CHECK(RTC_TS_FRAC(RTC_GetTimestamp()) == 0UL);
+
+    /* Three ticks of 1/128 second, then the next second */
+    Tick();
+    Tick();
+    Tick();
+    HOST_CHECK(RTC_TS_FRAC(RTC_GetTimestamp()) == (3UL << 25));
+    HostReg_Set(&RTC->TIME, 0x00123457UL);
+    Tick();
+    HOST_CHECK(RTC_TS_SEC(RTC_GetTimestamp()) == 1709210097UL);
+    HOST_CHECK(RTC_TS_FRAC(RTC_GetTimestamp()) == 0UL);
+
+    /* A missed second boundary decodes the calendar again */
+    HostReg_Set(&RTC->TIME, 0x00123500UL);
+    Tick();
+    HOST_CHECK(RTC_TS_SEC(RTC_GetTimestamp()) == 1709210100UL);
+
+    /* Register accesses per call */
+    HostReg_SetCountWindow(RTC, sizeof(RTC_T));
+    HostReg_ResetCount();
+    RTC_GetDateAndTime(&sTime);
+    u32Epoch = RTC_DateAndTimeToEpoch(&sTime);
+    u32DtAcc = HostReg_GetReadCount() + HostReg_GetWriteCount();
+    HostReg_ResetCount();
+    u64Ts = RTC_GetTimestamp();
+    u32TsAcc = HostReg_GetReadCount() + HostReg_GetWriteCount();
+    HOST_CHECK(RTC_TS_SEC(u64Ts) == u32Epoch);
+    HOST_CHECK(u32TsAcc == 0UL);
+    HOST_CHECK(u32DtAcc >= 14UL);
+
+    /* Host time per call, registers as plain memory */
+    HostReg_Trap(0UL);
+    u64Start = HostBench_Ns();
+    for(i = 0UL; i < BENCH_LOOPS; i++)
+    {
+        RTC_GetDateAndTime(&sTime);
+        u32Epoch = RTC_DateAndTimeToEpoch(&sTime);
+    }
+    u64DtNs = HostBench_Ns() - u64Start;
+    u64Start = HostBench_Ns();
+    for(i = 0UL; i < BENCH_LOOPS; i++)
+        u64Ts = RTC_GetTimestamp();
+    u64TsNs = HostBench_Ns() - u64Start;
+
+    printf("RTC_GetDateAndTime + epoch: %2lu register accesses, %6.1f ns/call\n",
+           (unsigned long)u32DtAcc, (double)u64DtNs / BENCH_LOOPS);
+    printf("RTC_GetTimestamp:           %2lu register accesses, %6.1f ns/call\n",
+           (unsigned long)u32TsAcc, (double)u64TsNs / BENCH_LOOPS);
+    HOST_CHECK(u64TsNs < u64DtNs);
+
+    return HostTest_Result("rtc_ts_bench");
+}
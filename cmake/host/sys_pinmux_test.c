@@ -0,0 +1,189 @@
+/**************************************************************************//**
+ * @file     sys_pinmux_test.c
+ * @brief    Host test of the batch pin-mux apply
+ *
+ * SYS_ApplyPinmux and SYS_ApplyMfpTable merge pins per GPx_MFPn register.
+ * Both are compared with applying the same NVT_PINMUX values one pin at a
+ * time, as the pinctrl driver does, on random pin lists with repeated pins
+ * and on a fixed table. The register accesses of the fixed case are
+ * counted: one write per register, and a read only when not all four pins
+ * of the register are set.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2024 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+#include "host_regs.h"
+
+#define TEST_ROUNDS         2000UL
+#define TEST_LIST_MAX       48UL
+#define TEST_PORT_NUM       (SYS_MFP_REG_NUM / 4UL)
+
+/* Same encoding as NVT_PINMUX of the pinctrl headers, port 0 = GPA */
+#define TEST_PINMUX(port, pin, mfp)     (((uint32_t)(port) << 28) | ((uint32_t)(pin) << 24) | (uint32_t)(mfp))
+
+static uint32_t s_u32Seed = 0x2545F491UL;
+
+static uint32_t Rand(void)
+{
+    s_u32Seed = s_u32Seed * 1664525UL + 1013904223UL;
+    return s_u32Seed >> 8;
+}
+
+/* One pin at a time, read-modify-write of its MFP field */
+static void PerPinApply(const uint32_t au32Pinmux[], uint32_t u32Count)
+{
+    volatile uint32_t *pu32Mfp = &SYS->GPA_MFP0;
+    uint32_t i, u32Reg, u32Shift;
+
+    for(i = 0UL; i < u32Count; i++)
+    {
+        u32Reg = (SYS_PINMUX_PORT(au32Pinmux[i]) * 4UL) + (SYS_PINMUX_PIN(au32Pinmux[i]) / 4UL);
+        if(u32Reg >= SYS_MFP_REG_NUM)
+            continue;
+
+        u32Shift = (SYS_PINMUX_PIN(au32Pinmux[i]) % 4UL) * 8UL;
+        pu32Mfp[u32Reg] = (pu32Mfp[u32Reg] & ~(SYS_MFP_FIELD_Msk << u32Shift)) | (SYS_PINMUX_MFP(au32Pinmux[i]) << u32Shift);
+    }
+}
+
+static void SetMfp(const uint32_t au32Val[])
+{
+    volatile uint32_t *pu32Mfp = &SYS->GPA_MFP0;
+    uint32_t i;
+
+    for(i = 0UL; i < SYS_MFP_REG_NUM; i++)
+        pu32Mfp[i] = au32Val[i];
+}
+
+static uint32_t SameMfp(const uint32_t au32Val[])
+{
+    volatile uint32_t *pu32Mfp = &SYS->GPA_MFP0;
+    uint32_t i;
+
+    for(i = 0UL; i < SYS_MFP_REG_NUM; i++)
+    {
+        if(pu32Mfp[i] != au32Val[i])
+        {
+            printf("GPx_MFP%lu: 0x%08lx, per pin 0x%08lx\n", (unsigned long)i, (unsigned long)pu32Mfp[i], (unsigned long)au32Val[i]);
+            return 0UL;
+        }
+    }
+    return 1UL;
+}
+
+/* Random lists over all ports, some pins repeated, some entries on a port beyond the MFP registers */
+static void TestRandom(void)
+{
+    uint32_t au32Init[SYS_MFP_REG_NUM], au32Expect[SYS_MFP_REG_NUM], au32Pinmux[TEST_LIST_MAX];
+    uint32_t au32Used[SYS_MFP_REG_NUM];
+    uint32_t u32Round, u32Count, u32Regs, i;
+    volatile uint32_t *pu32Mfp = &SYS->GPA_MFP0;
+
+    for(u32Round = 0UL; u32Round < TEST_ROUNDS; u32Round++)
+    {
+        for(i = 0UL; i < SYS_MFP_REG_NUM; i++)
+        {
+            au32Init[i] = Rand() & 0x1F1F1F1FUL;
+            au32Used[i] = 0UL;
+        }
+
+        u32Count = 1UL + (Rand() % TEST_LIST_MAX);
+        for(i = 0UL; i < u32Count; i++)
+        {
+            if((i != 0UL) && ((Rand() % 4UL) == 0UL))
+                au32Pinmux[i] = (au32Pinmux[Rand() % i] & ~SYS_MFP_FIELD_Msk) | (Rand() & SYS_MFP_FIELD_Msk);
+            else
+                au32Pinmux[i] = TEST_PINMUX(Rand() % (TEST_PORT_NUM + 1UL), Rand() % 16UL, Rand() & SYS_MFP_FIELD_Msk);
+        }
+
+        SetMfp(au32Init);
+        PerPinApply(au32Pinmux, u32Count);
+        for(i = 0UL; i < SYS_MFP_REG_NUM; i++)
+            au32Expect[i] = pu32Mfp[i];
+
+        for(i = 0UL, u32Regs = 0UL; i < u32Count; i++)
+        {
+            if((SYS_PINMUX_PORT(au32Pinmux[i]) < TEST_PORT_NUM) &&
+                    (au32Used[(SYS_PINMUX_PORT(au32Pinmux[i]) * 4UL) + (SYS_PINMUX_PIN(au32Pinmux[i]) / 4UL)]++ == 0UL))
+                u32Regs++;
+        }
+
+        SetMfp(au32Init);
+        HOST_CHECK(SYS_ApplyPinmux(au32Pinmux, u32Count) == u32Regs);
+        HOST_CHECK(SameMfp(au32Expect));
+    }
+}
+
+/* UART0 on PB12..PB15 fills GPB_MFP3, SPI0 on PA0..PA2 is part of GPA_MFP0, PA1 is listed twice */
+static const uint32_t s_au32Pins[] =
+{
+    TEST_PINMUX(1, 12, 6), TEST_PINMUX(1, 13, 6), TEST_PINMUX(1, 14, 6), TEST_PINMUX(1, 15, 6),
+    TEST_PINMUX(0, 0, 4), TEST_PINMUX(0, 1, 0), TEST_PINMUX(0, 2, 4), TEST_PINMUX(0, 1, 4),
+};
+
+static const S_SYS_MFP_CFG_T s_asTable[] =
+{
+    { 0UL, 0x001F1F1FUL, 0x00040404UL },
+    { 7UL, 0x1F1F1F1FUL, 0x06060606UL },
+};
+
+/* A register and a port beyond the MFP registers */
+static const S_SYS_MFP_CFG_T s_sBadCfg = { SYS_MFP_REG_NUM, 0x1F1F1F1FUL, 0UL };
+static const uint32_t s_u32BadPin = TEST_PINMUX(TEST_PORT_NUM, 0, 1);
+
+static void TestTable(void)
+{
+    uint32_t au32Init[SYS_MFP_REG_NUM], au32Expect[SYS_MFP_REG_NUM];
+    uint32_t u32Cnt = sizeof(s_au32Pins) / sizeof(s_au32Pins[0]), u32Ret, i;
+    volatile uint32_t *pu32Mfp = &SYS->GPA_MFP0;
+
+    for(i = 0UL; i < SYS_MFP_REG_NUM; i++)
+        au32Init[i] = Rand() & 0x1F1F1F1FUL;
+
+    SetMfp(au32Init);
+    HostReg_SetCountWindow(pu32Mfp, SYS_MFP_REG_NUM * 4UL);
+    HostReg_Trap(1UL);
+    HostReg_ResetCount();
+    PerPinApply(s_au32Pins, u32Cnt);
+    HOST_CHECK((HostReg_GetReadCount() == u32Cnt) && (HostReg_GetWriteCount() == u32Cnt));
+    HostReg_Trap(0UL);
+    for(i = 0UL; i < SYS_MFP_REG_NUM; i++)
+        au32Expect[i] = pu32Mfp[i];
+    HOST_CHECK(au32Expect[0] == ((au32Init[0] & 0x1F000000UL) | 0x00040404UL));
+    HOST_CHECK(au32Expect[7] == 0x06060606UL);
+
+    /* Two writes, and a read of GPA_MFP0 only */
+    SetMfp(au32Init);
+    HostReg_Trap(1UL);
+    HostReg_ResetCount();
+    u32Ret = SYS_ApplyPinmux(s_au32Pins, u32Cnt);
+    HOST_CHECK((HostReg_GetReadCount() == 1UL) && (HostReg_GetWriteCount() == 2UL));
+    HostReg_Trap(0UL);
+    HOST_CHECK(u32Ret == 2UL);
+    HOST_CHECK(SameMfp(au32Expect));
+
+    SetMfp(au32Init);
+    HostReg_Trap(1UL);
+    HostReg_ResetCount();
+    SYS_ApplyMfpTable(s_asTable, sizeof(s_asTable) / sizeof(s_asTable[0]));
+    HOST_CHECK((HostReg_GetReadCount() == 1UL) && (HostReg_GetWriteCount() == 2UL));
+    HostReg_Trap(0UL);
+    HOST_CHECK(SameMfp(au32Expect));
+
+    /* Entries beyond the MFP registers are skipped */
+    SYS_ApplyMfpTable(&s_sBadCfg, 1UL);
+    HOST_CHECK(SYS_ApplyPinmux(&s_u32BadPin, 1UL) == 0UL);
+    HOST_CHECK(SameMfp(au32Expect));
+}
+
+int main(void)
+{
+    HostReg_Reset();
+
+    TestRandom();
+    TestTable();
+
+    return HostTest_Result("sys_pinmux");
+}
@@ -0,0 +1,359 @@
+/**************************************************************************//**
+ * @file     utcpd_pd_test.c
+ * @brief    Host test of the UTCPD PD message layer and sink policy engine
+ *
+ * A scripted source talks to the sink through the UTCPD registers: it puts
+ * messages into the RX registers and raises RXSOPIS, and it answers every
+ * TXCTL write with GoodCRC unless the test holds the transmitter busy. A
+ * millisecond counter drives the policy timers, so response latencies and
+ * timeouts are checked against the PD specification windows.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2024 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "NuMicro.h"
+#include "host_regs.h"
+
+#define TEST_PORT               0
+
+#define TEST_PDO_5V3A           ((100UL << 10) | 300UL)
+#define TEST_PDO_9V3A           ((180UL << 10) | 300UL)
+#define TEST_APDO_PPS11V3A      ((3UL << 30) | (110UL << 17) | (33UL << 8) | 60UL)
+
+#define TEST_TX_LOG             32UL
+
+typedef struct
+{
+    uint32_t u32Ms;
+    uint32_t u32Ctl;
+    uint32_t u32Header;
+    uint32_t u32Data0;
+} S_TEST_TX_T;
+
+static uint32_t s_u32Ms;
+static uint32_t s_u32Hold;          /* No GoodCRC until TxDone() */
+static uint32_t s_u32SrcId;
+static S_TEST_TX_T s_asTx[TEST_TX_LOG];
+static uint32_t s_u32TxNum;
+
+static uint32_t Tick(void)
+{
+    return s_u32Ms;
+}
+
+static uint32_t W1cWrite(uint32_t u32Addr, uint32_t u32Old, uint32_t u32New)
+{
+    (void)u32Addr;
+    return u32Old & ~u32New;
+}
+
+static uint32_t TxctlWrite(uint32_t u32Addr, uint32_t u32Old, uint32_t u32New)
+{
+    (void)u32Addr;
+    (void)u32Old;
+    HostReg_RaiseIrq();
+    return u32New;
+}
+
+static void TxDone(uint32_t u32Sts)
+{
+    HostReg_Set(&UTCPD->IS, HostReg_Get(&UTCPD->IS) | u32Sts);
+    UTCPD_PdIRQHandler(TEST_PORT);
+}
+
+/* The PHY sends the message and, unless held, the source answers with GoodCRC */
+static void UtcpdIrq(void)
+{
+    S_TEST_TX_T *psTx;
+
+    if(s_u32TxNum < TEST_TX_LOG)
+    {
+        psTx = &s_asTx[s_u32TxNum];
+        psTx->u32Ms = s_u32Ms;
+        psTx->u32Ctl = HostReg_Get(&UTCPD->TXCTL);
+        psTx->u32Header = HostReg_Get(&UTCPD->TXHEAD);
+        psTx->u32Data0 = HostReg_Get(&UTCPD->TXDA0);
+    }
+    s_u32TxNum++;
+
+    if(s_u32Hold == 0UL)
+        TxDone(UTCPD_IS_TXOKIS_Msk);
+}
+
+/* Source message with the next MessageID, roles Source/DFP, PD 3.0 */
+static void SrcSend(uint32_t u32Type, const uint32_t au32Data[], uint32_t u32Cnt)
+{
+    uint32_t i;
+
+    HostReg_Set(&UTCPD->RXBCNT, 3UL + u32Cnt * 4UL);
+    HostReg_Set(&UTCPD->RXFTYPE, UTCPD_PD_SOP);
+    HostReg_Set(&UTCPD->RXHEAD, u32Type | (1UL << 5) | (UTCPD_PD_REV30 << 6) | (1UL << 8) | (s_u32SrcId << 9) |
+                (u32Cnt << 12));
+    for(i = 0UL; i < u32Cnt; i++)
+        HostReg_Set(&(&UTCPD->RXDA0)[i], au32Data[i]);
+    s_u32SrcId = (s_u32SrcId + 1UL) & 0x7UL;
+    TxDone(UTCPD_IS_RXSOPIS_Msk);
+}
+
+static void SrcCaps(void)
+{
+    static const uint32_t au32Caps[] = {TEST_PDO_5V3A, TEST_PDO_9V3A, TEST_APDO_PPS11V3A};
+
+    SrcSend(UTCPD_PD_DATA_SRC_CAP, au32Caps, 3UL);
+}
+
+static const S_TEST_TX_T *LastTx(void)
+{
+    return &s_asTx[s_u32TxNum - 1UL];
+}
+
+/* Runs the policy engine every millisecond until a message is sent or u32Ms passed */
+static uint32_t RunUntilTx(uint32_t u32Ms)
+{
+    uint32_t u32Num = s_u32TxNum, u32End = s_u32Ms + u32Ms;
+
+    while((s_u32TxNum == u32Num) && (s_u32Ms < u32End))
+    {
+        s_u32Ms++;
+        (void)UTCPD_PdSnkProcess(TEST_PORT);
+    }
+    return s_u32TxNum - u32Num;
+}
+
+static void Restart(uint32_t u32Mv, uint32_t u32Ma)
+{
+    HostReg_Reset();
+    HostReg_SetHook(&UTCPD->IS, NULL, W1cWrite);
+    HostReg_SetHook(&UTCPD->TXCTL, NULL, TxctlWrite);
+    HostReg_SetIrq(UtcpdIrq);
+    HostReg_Trap(1UL);
+
+    s_u32Ms = 1000UL;
+    s_u32Hold = 0UL;
+    s_u32SrcId = 0UL;
+    s_u32TxNum = 0UL;
+    UTCPD_PdSnkSetTarget(TEST_PORT, u32Mv, u32Ma);
+    HOST_CHECK(UTCPD_PdOpen(TEST_PORT, 0UL, 0UL, Tick) == 0);
+}
+
+/* Source_Capabilities to PS_RDY, the sink answering within tReceiverResponse */
+static void Contract(uint32_t u32Pos)
+{
+    uint32_t u32Rx = s_u32Ms;
+
+    SrcCaps();
+    HOST_CHECK(RunUntilTx(UTCPD_PD_T_RECEIVER_RESPONSE) == 1UL);
+    HOST_CHECK(UTCPD_PD_HDR_TYPE(LastTx()->u32Header) == UTCPD_PD_DATA_REQUEST);
+    HOST_CHECK(UTCPD_PD_HDR_CNT(LastTx()->u32Header) == 1UL);
+    HOST_CHECK((LastTx()->u32Data0 >> 28) == u32Pos);
+    HOST_CHECK(LastTx()->u32Ms - u32Rx <= UTCPD_PD_T_RECEIVER_RESPONSE);
+    HOST_CHECK(UTCPD_PdSnkProcess(TEST_PORT) == UTCPD_SNK_WAIT_ACCEPT);
+
+    s_u32Ms += 3UL;
+    SrcSend(UTCPD_PD_CTRL_ACCEPT, NULL, 0UL);
+    HOST_CHECK(UTCPD_PdSnkProcess(TEST_PORT) == UTCPD_SNK_WAIT_PS_RDY);
+    s_u32Ms += 200UL;
+    SrcSend(UTCPD_PD_CTRL_PS_RDY, NULL, 0UL);
+    HOST_CHECK(UTCPD_PdSnkProcess(TEST_PORT) == UTCPD_SNK_READY);
+}
+
+static void TestContract(void)
+{
+    uint32_t u32Mv, u32Ma, u32Rx, u32TxDrops, u32RxDrops;
+
+    Restart(9000UL, 2000UL);
+    HOST_CHECK(UTCPD_PdSnkGetContract(TEST_PORT, &u32Mv, &u32Ma) == 1);
+    Contract(2UL);
+    HOST_CHECK(UTCPD_PdSnkGetContract(TEST_PORT, &u32Mv, &u32Ma) == 0);
+    HOST_CHECK((u32Mv == 9000UL) && (u32Ma == 2000UL));
+    HOST_CHECK((LastTx()->u32Data0 & 0x3FFUL) == 200UL);
+
+    /* Get_Sink_Cap is answered with vSafe5V at the target current */
+    u32Rx = s_u32Ms;
+    SrcSend(UTCPD_PD_CTRL_GET_SNK_CAP, NULL, 0UL);
+    HOST_CHECK(RunUntilTx(UTCPD_PD_T_RECEIVER_RESPONSE) == 1UL);
+    HOST_CHECK(UTCPD_PD_HDR_TYPE(LastTx()->u32Header) == UTCPD_PD_DATA_SNK_CAP);
+    HOST_CHECK(LastTx()->u32Data0 == ((100UL << 10) | 200UL));
+    HOST_CHECK(LastTx()->u32Ms - u32Rx <= UTCPD_PD_T_RECEIVER_RESPONSE);
+
+    /* Unsupported messages get Not_Supported on PD 3.0 */
+    SrcSend(UTCPD_PD_CTRL_GET_SRC_CAP, NULL, 0UL);
+    HOST_CHECK(RunUntilTx(UTCPD_PD_T_RECEIVER_RESPONSE) == 1UL);
+    HOST_CHECK(UTCPD_PD_HDR_TYPE(LastTx()->u32Header) == UTCPD_PD_CTRL_NOT_SUPPORTED);
+
+    /* Sink MessageIDs count up, one per message */
+    HOST_CHECK(UTCPD_PD_HDR_ID(LastTx()->u32Header) == 2UL);
+    HOST_CHECK(UTCPD_PdGetMaxRespTime(TEST_PORT) <= UTCPD_PD_T_RECEIVER_RESPONSE);
+    HOST_CHECK(UTCPD_PdGetDropCount(TEST_PORT, &u32RxDrops, &u32TxDrops) == 0);
+    HOST_CHECK((u32RxDrops == 0UL) && (u32TxDrops == 0UL));
+}
+
+/* tTypeCSinkWaitCap, tSenderResponse, tPSTransition and nHardResetCount */
+static void TestTimers(void)
+{
+    uint32_t u32Start, u32HardResets, i;
+
+    /* No Source_Capabilities: Hard Reset within tTypeCSinkWaitCap */
+    Restart(5000UL, 900UL);
+    u32Start = s_u32Ms;
+    HOST_CHECK(RunUntilTx(1000UL) == 1UL);
+    HOST_CHECK(LastTx()->u32Ctl == UTCPD_PD_TX_HARD_RESET);
+    HOST_CHECK((LastTx()->u32Ms - u32Start >= 310UL) && (LastTx()->u32Ms - u32Start <= 620UL));
+
+    /* The source never answers: nHardResetCount resets, then the error state */
+    u32HardResets = 1UL;
+    for(i = 0UL; (i < 10000UL) && (UTCPD_PdSnkProcess(TEST_PORT) != UTCPD_SNK_ERROR); i++)
+        u32HardResets += RunUntilTx(1UL);
+    HOST_CHECK(UTCPD_PdSnkProcess(TEST_PORT) == UTCPD_SNK_ERROR);
+    HOST_CHECK(u32HardResets == UTCPD_PD_N_HARD_RESET);
+
+    /* No Accept: Hard Reset tSenderResponse after GoodCRC of the Request */
+    Restart(5000UL, 900UL);
+    SrcCaps();
+    HOST_CHECK(RunUntilTx(UTCPD_PD_T_RECEIVER_RESPONSE) == 1UL);
+    u32Start = LastTx()->u32Ms;
+    HOST_CHECK(RunUntilTx(100UL) == 1UL);
+    HOST_CHECK(LastTx()->u32Ctl == UTCPD_PD_TX_HARD_RESET);
+    HOST_CHECK((LastTx()->u32Ms - u32Start >= 24UL) && (LastTx()->u32Ms - u32Start <= 30UL));
+
+    /* No PS_RDY: Hard Reset within tPSTransition */
+    Restart(5000UL, 900UL);
+    SrcCaps();
+    HOST_CHECK(RunUntilTx(UTCPD_PD_T_RECEIVER_RESPONSE) == 1UL);
+    SrcSend(UTCPD_PD_CTRL_ACCEPT, NULL, 0UL);
+    HOST_CHECK(UTCPD_PdSnkProcess(TEST_PORT) == UTCPD_SNK_WAIT_PS_RDY);
+    u32Start = s_u32Ms;
+    HOST_CHECK(RunUntilTx(1000UL) == 1UL);
+    HOST_CHECK(LastTx()->u32Ctl == UTCPD_PD_TX_HARD_RESET);
+    HOST_CHECK((LastTx()->u32Ms - u32Start >= 450UL) && (LastTx()->u32Ms - u32Start <= 550UL));
+
+    /* PPS contract: re-requested before tPPSTimeout */
+    Restart(4200UL, 2000UL);
+    Contract(3UL);
+    HOST_CHECK(((LastTx()->u32Data0 >> 9) & 0xFFFUL) == 4200UL / 20UL);
+    u32Start = s_u32Ms;
+    HOST_CHECK(RunUntilTx(10000UL) == 1UL);
+    HOST_CHECK(UTCPD_PD_HDR_TYPE(LastTx()->u32Header) == UTCPD_PD_DATA_REQUEST);
+    HOST_CHECK(LastTx()->u32Ms - u32Start < 10000UL);
+}
+
+/* Replies and Requests that find the transmitter busy */
+static void TestBusyTx(void)
+{
+    uint32_t u32Rx, u32RxDrops, u32TxDrops;
+
+    /* Source_Capabilities while a message is waiting for GoodCRC: the Request goes out once it is done */
+    Restart(9000UL, 2000UL);
+    s_u32Hold = 1UL;
+    HOST_CHECK(UTCPD_PdSendMsg(TEST_PORT, UTCPD_PD_SOP_PRIME, 15UL, NULL, 0UL) == 0);
+    u32Rx = s_u32Ms;
+    SrcCaps();
+    HOST_CHECK(RunUntilTx(5UL) == 0UL);
+    HOST_CHECK(UTCPD_PdSnkProcess(TEST_PORT) == UTCPD_SNK_WAIT_CAP);
+    s_u32Hold = 0UL;
+    TxDone(UTCPD_IS_TXOKIS_Msk);
+    HOST_CHECK(RunUntilTx(1UL) == 1UL);
+    HOST_CHECK(UTCPD_PD_HDR_TYPE(LastTx()->u32Header) == UTCPD_PD_DATA_REQUEST);
+    HOST_CHECK(LastTx()->u32Ms - u32Rx <= UTCPD_PD_T_RECEIVER_RESPONSE);
+    HOST_CHECK(UTCPD_PdSnkProcess(TEST_PORT) == UTCPD_SNK_WAIT_ACCEPT);
+    HOST_CHECK(UTCPD_PdGetMaxRespTime(TEST_PORT) == LastTx()->u32Ms - u32Rx);
+
+    /* A reply is kept until the transmitter is free */
+    Restart(9000UL, 2000UL);
+    Contract(2UL);
+    s_u32Hold = 1UL;
+    HOST_CHECK(UTCPD_PdSendMsg(TEST_PORT, UTCPD_PD_SOP_PRIME, 15UL, NULL, 0UL) == 0);
+    SrcSend(UTCPD_PD_CTRL_GET_SNK_CAP, NULL, 0UL);
+    HOST_CHECK(RunUntilTx(5UL) == 0UL);
+    s_u32Hold = 0UL;
+    TxDone(UTCPD_IS_TXOKIS_Msk);
+    HOST_CHECK(RunUntilTx(1UL) == 1UL);
+    HOST_CHECK(UTCPD_PD_HDR_TYPE(LastTx()->u32Header) == UTCPD_PD_DATA_SNK_CAP);
+    HOST_CHECK(UTCPD_PdGetDropCount(TEST_PORT, &u32RxDrops, &u32TxDrops) == 0);
+    HOST_CHECK(u32TxDrops == 0UL);
+
+    /* Given up after tSenderResponse, the source no longer waits for it */
+    s_u32Hold = 1UL;
+    HOST_CHECK(UTCPD_PdSendMsg(TEST_PORT, UTCPD_PD_SOP_PRIME, 15UL, NULL, 0UL) == 0);
+    SrcSend(UTCPD_PD_CTRL_GET_SNK_CAP, NULL, 0UL);
+    HOST_CHECK(RunUntilTx(UTCPD_PD_T_SENDER_RESPONSE + 1UL) == 0UL);
+    HOST_CHECK(UTCPD_PdGetDropCount(TEST_PORT, &u32RxDrops, &u32TxDrops) == 0);
+    HOST_CHECK(u32TxDrops == 1UL);
+    s_u32Hold = 0UL;
+    TxDone(UTCPD_IS_TXOKIS_Msk);
+    HOST_CHECK(RunUntilTx(10UL) == 0UL);
+
+    /* A newer reply replaces the pending one */
+    s_u32Hold = 1UL;
+    HOST_CHECK(UTCPD_PdSendMsg(TEST_PORT, UTCPD_PD_SOP_PRIME, 15UL, NULL, 0UL) == 0);
+    SrcSend(UTCPD_PD_CTRL_GET_SNK_CAP, NULL, 0UL);
+    HOST_CHECK(RunUntilTx(1UL) == 0UL);
+    SrcSend(UTCPD_PD_CTRL_GET_SRC_CAP, NULL, 0UL);
+    HOST_CHECK(RunUntilTx(1UL) == 0UL);
+    s_u32Hold = 0UL;
+    TxDone(UTCPD_IS_TXOKIS_Msk);
+    HOST_CHECK(RunUntilTx(1UL) == 1UL);
+    HOST_CHECK(UTCPD_PD_HDR_TYPE(LastTx()->u32Header) == UTCPD_PD_CTRL_NOT_SUPPORTED);
+    HOST_CHECK(RunUntilTx(10UL) == 0UL);
+    HOST_CHECK(UTCPD_PdGetDropCount(TEST_PORT, &u32RxDrops, &u32TxDrops) == 0);
+    HOST_CHECK((u32RxDrops == 0UL) && (u32TxDrops == 2UL));
+    HOST_CHECK(UTCPD_PdSnkProcess(TEST_PORT) == UTCPD_SNK_READY);
+}
+
+/* Received messages lost to a full queue or a receive buffer overrun */
+static void TestRxDrops(void)
+{
+    S_UTCPD_PD_MSG_T sMsg;
+    uint32_t u32RxDrops, u32TxDrops, i;
+
+    Restart(5000UL, 900UL);
+    for(i = 0UL; i < UTCPD_PD_RXQ_SIZE + 1UL; i++)
+        SrcSend(UTCPD_PD_CTRL_PING, NULL, 0UL);
+    HOST_CHECK(UTCPD_PdGetDropCount(TEST_PORT, &u32RxDrops, &u32TxDrops) == 0);
+    HOST_CHECK(u32RxDrops == 1UL);
+    for(i = 0UL; i < UTCPD_PD_RXQ_SIZE; i++)
+        HOST_CHECK(UTCPD_PdGetMsg(TEST_PORT, &sMsg) == 0);
+    HOST_CHECK(UTCPD_PdGetMsg(TEST_PORT, &sMsg) == 1);
+
+    /* The dropped MessageID is not taken, its retransmission is queued; a second copy is a duplicate */
+    s_u32SrcId = UTCPD_PD_RXQ_SIZE;
+    SrcSend(UTCPD_PD_CTRL_PING, NULL, 0UL);
+    HOST_CHECK(UTCPD_PdGetMsg(TEST_PORT, &sMsg) == 0);
+    HOST_CHECK(UTCPD_PD_HDR_ID(sMsg.u16Header) == UTCPD_PD_RXQ_SIZE);
+    s_u32SrcId = UTCPD_PD_RXQ_SIZE;
+    SrcSend(UTCPD_PD_CTRL_PING, NULL, 0UL);
+    HOST_CHECK(UTCPD_PdGetMsg(TEST_PORT, &sMsg) == 1);
+
+    TxDone(UTCPD_IS_RXOFIS_Msk);
+    HOST_CHECK(UTCPD_PdGetDropCount(TEST_PORT, &u32RxDrops, &u32TxDrops) == 0);
+    HOST_CHECK((u32RxDrops == 2UL) && (u32TxDrops == 0UL));
+    HOST_CHECK((HostReg_Get(&UTCPD->IS) & UTCPD_IS_RXOFIS_Msk) == 0UL);
+}
+
+/* TCPCI register access of the driver lands on the UTCPD registers */
+static void TestTcpcRegs(void)
+{
+    HostReg_Reset();
+    HostReg_Trap(1UL);
+
+    HOST_CHECK(UTCPD_SetVBUSAlarm(TEST_PORT, 0x1234UL, 0x0567UL) == 0);
+    HOST_CHECK(HostReg_Get(&UTCPD->VBAMH) == 0x1234UL);
+    HOST_CHECK(HostReg_Get(&UTCPD->VBAML) == 0x0567UL);
+
+    HostReg_Set(&UTCPD->MUXSEL, UTCPD_MUXSEL_ADCSELVC_Msk);
+    UTCPD_vconn_configure_oc_detection_soruce(TEST_PORT, 5UL);
+    HOST_CHECK(HostReg_Get(&UTCPD->MUXSEL) == (UTCPD_MUXSEL_ADCSELVC_Msk | (5UL << UTCPD_MUXSEL_VCOCS_Pos)));
+}
+
+int main(void)
+{
+    TestTcpcRegs();
+    TestContract();
+    TestTimers();
+    TestBusyTx();
+    TestRxDrops();
+
+    return HostTest_Result("utcpd_pd");
+}
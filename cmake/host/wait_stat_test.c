@@ -0,0 +1,206 @@
+/**************************************************************************//**
+ * @file     wait_stat_test.c
+ * @brief    Host test of the wait-loop instrumentation on a flash ISP model
+ *
+ * The flash driver and system_<series>.c are built again with NVT_WAIT_STAT
+ * and an 8 bin histogram. ISPGO of the ISP trigger register stays set for a
+ * given number of polls, and every poll advances the cycle source of
+ * NVT_WAIT_CYCLES(): DWT->CYCCNT, or SysTick counting down and reloading
+ * on m2l31x. The statistics of the ISP read site must match the cycles of
+ * the polls exactly:
+ * - random busy times and poll costs, across counter wrap or SysTick
+ *   reloads, with waits beyond the last histogram bin,
+ * - a read that times out, which is recorded as well (not on m48x, whose
+ *   FMC_Read() waits without a time-out),
+ * - other sites untouched, WaitStat_Get() arguments and WaitStat_Reset().
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2024 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "NuMicro.h"
+#include "host_regs.h"
+
+#define TEST_WAITS          300UL
+#define TEST_STUCK          0xFFFFFFFFUL
+#define TEST_SYSTICK_LOAD   4999UL
+
+#if defined(RMC)
+#define TEST_ISP            RMC
+#define TEST_ISPGO_Msk      RMC_ISPTRG_ISPGO_Msk
+#define TEST_SITE           WAIT_SITE_RMC_READ
+#define TEST_SITE_OTHER     WAIT_SITE_RMC_ERASE
+#define TEST_READ(addr)     RMC_Read(addr)
+#define TEST_ERR            g_RMC_i32ErrCode
+#define TEST_TIMEOUT
+#else
+#define TEST_ISP            FMC
+#define TEST_ISPGO_Msk      FMC_ISPTRG_ISPGO_Msk
+#define TEST_SITE           WAIT_SITE_FMC_READ
+#define TEST_SITE_OTHER     WAIT_SITE_FMC_ERASE
+#define TEST_READ(addr)     FMC_Read(addr)
+/* The m48x FMC_Read() has no time-out */
+#if defined(FMC_TIMEOUT_READ)
+#define TEST_ERR            g_FMC_i32ErrCode
+#define TEST_TIMEOUT
+#endif
+#endif
+
+static uint32_t s_u32BusyPolls, s_u32PollCycles, s_u32Busy, s_u32Reads;
+static S_WAIT_STAT_T s_sExpect;
+static uint32_t s_u32Seed = 0x4F1BBCDCUL;
+
+static uint32_t Rand(void)
+{
+    s_u32Seed = s_u32Seed * 1664525UL + 1013904223UL;
+    return s_u32Seed >> 8;
+}
+
+/* Time passing on the cycle source of NVT_WAIT_CYCLES() */
+static void Advance(uint32_t u32Cycles)
+{
+#if defined(NVT_WAIT_SYSTICK)
+    if(SysTick->VAL >= u32Cycles)
+        SysTick->VAL -= u32Cycles;
+    else
+        SysTick->VAL = SysTick->VAL + SysTick->LOAD + 1UL - u32Cycles;
+#else
+    DWT->CYCCNT += u32Cycles;
+#endif
+}
+
+static uint32_t IspTrgWrite(uint32_t u32Addr, uint32_t u32Old, uint32_t u32New)
+{
+    (void)u32Addr;
+    (void)u32Old;
+    s_u32Busy = s_u32BusyPolls;
+    s_u32Reads = 0UL;
+    return u32New;
+}
+
+/* Every poll takes s_u32PollCycles, ISPGO clears after s_u32BusyPolls polls */
+static uint32_t IspTrgRead(uint32_t u32Addr, uint32_t u32Val)
+{
+    (void)u32Addr;
+    (void)u32Val;
+    s_u32Reads++;
+    Advance(s_u32PollCycles);
+    if(s_u32Busy == TEST_STUCK)
+        return TEST_ISPGO_Msk;
+    if(s_u32Busy == 0UL)
+        return 0UL;
+    s_u32Busy--;
+    return TEST_ISPGO_Msk;
+}
+
+/* Same binning as WaitStat_Record(), without __CLZ */
+static void Expect(uint32_t u32Cycles)
+{
+    uint32_t u32Bin = 0UL;
+
+    while((u32Cycles >> (u32Bin + 1UL)) != 0UL)
+        u32Bin++;
+    if(u32Bin >= NVT_WAIT_HIST_BINS)
+        u32Bin = NVT_WAIT_HIST_BINS - 1UL;
+
+    s_sExpect.u32Count++;
+    s_sExpect.u64Total += u32Cycles;
+    if(u32Cycles > s_sExpect.u32Max)
+        s_sExpect.u32Max = u32Cycles;
+    s_sExpect.au32Hist[u32Bin]++;
+}
+
+static uint32_t SameStat(uint32_t u32Site, const S_WAIT_STAT_T *psExpect)
+{
+    S_WAIT_STAT_T sStat;
+
+    if(WaitStat_Get(u32Site, &sStat) != 0)
+        return 0UL;
+    if(memcmp(&sStat, psExpect, sizeof(sStat)) == 0)
+        return 1UL;
+
+    printf("site %lu: %lu waits, max %lu, total %llu; expected %lu, %lu, %llu\n", (unsigned long)u32Site,
+           (unsigned long)sStat.u32Count, (unsigned long)sStat.u32Max, (unsigned long long)sStat.u64Total,
+           (unsigned long)psExpect->u32Count, (unsigned long)psExpect->u32Max, (unsigned long long)psExpect->u64Total);
+    return 0UL;
+}
+
+/* Random busy times and poll costs; the cycle source starts anywhere, so waits cross wrap and reloads */
+static void TestWaits(void)
+{
+    uint32_t i;
+
+    for(i = 0UL; i < TEST_WAITS; i++)
+    {
+        s_u32BusyPolls = Rand() % 300UL;
+        s_u32PollCycles = 1UL + (Rand() % 7UL);
+#if defined(NVT_WAIT_SYSTICK)
+        SysTick->VAL = Rand() % (TEST_SYSTICK_LOAD + 1UL);
+#else
+        DWT->CYCCNT = ((i % 4UL) == 0UL) ? (0xFFFFFFFFUL - (Rand() % 1000UL)) : (Rand() << 8);
+#endif
+        TEST_READ(0x1000UL);
+#if defined(TEST_TIMEOUT)
+        HOST_CHECK(TEST_ERR == 0);
+#endif
+        HOST_CHECK(s_u32Reads == s_u32BusyPolls + 1UL);
+        Expect(s_u32Reads * s_u32PollCycles);
+    }
+
+    HOST_CHECK(SameStat(TEST_SITE, &s_sExpect));
+    /* Waits of 128 cycles and more all land in the last of the 8 bins */
+    HOST_CHECK(s_sExpect.au32Hist[NVT_WAIT_HIST_BINS - 1UL] != 0UL);
+}
+
+/* A read that never finishes is recorded when it gives up */
+static void TestTimeout(void)
+{
+#if defined(TEST_TIMEOUT)
+    uint32_t u32Clock = SystemCoreClock;
+
+    SystemCoreClock = 4000UL;
+    s_u32BusyPolls = TEST_STUCK;
+    s_u32PollCycles = 3UL;
+    HOST_CHECK(TEST_READ(0x1000UL) == 0xFFFFFFFFUL);
+    HOST_CHECK(TEST_ERR == -1);
+    HOST_CHECK((s_u32Reads > 90UL) && (s_u32Reads < 510UL));
+    Expect(s_u32Reads * s_u32PollCycles);
+    HOST_CHECK(SameStat(TEST_SITE, &s_sExpect));
+    SystemCoreClock = u32Clock;
+#endif
+}
+
+static void TestGet(void)
+{
+    S_WAIT_STAT_T sStat, sZero;
+
+    memset(&sZero, 0, sizeof(sZero));
+    HOST_CHECK(SameStat(TEST_SITE_OTHER, &sZero));
+    HOST_CHECK(WaitStat_Get(WAIT_SITE_CNT, &sStat) == -1);
+    HOST_CHECK(WaitStat_Get(TEST_SITE, NULL) == -1);
+
+    /* Out of range sites are ignored */
+    WaitStat_Record(WAIT_SITE_CNT, 10UL);
+    HOST_CHECK(SameStat(TEST_SITE, &s_sExpect));
+
+    WaitStat_Reset();
+    HOST_CHECK(SameStat(TEST_SITE, &sZero));
+}
+
+int main(void)
+{
+    HostReg_Reset();
+#if defined(NVT_WAIT_SYSTICK)
+    SysTick->LOAD = TEST_SYSTICK_LOAD;
+#endif
+    WaitStat_Reset();
+    HostReg_SetHook(&TEST_ISP->ISPTRG, IspTrgRead, IspTrgWrite);
+    HostReg_Trap(1UL);
+
+    TestWaits();
+    TestTimeout();
+    TestGet();
+
+    return HostTest_Result("wait_stat");
+}
@@ -0,0 +1,402 @@
+/**************************************************************************//**
+ * @file     wdt_longop_test.c
+ * @brief    Host test of WDT_RunLongOp and the flash erase step function
+ *
+ * Time is a microsecond counter that the step functions advance by the cost
+ * of every unit, and every WWDT counter poll by 1 us. The WWDT model counts
+ * CNT down from 0x3F once per tick since the last reload; a reload while CNT
+ * is above CMPDAT is an early reload, and CNT reaching 0 is an expiry. The
+ * WDT model records the longest time between two counter resets.
+ * Checked are:
+ * - fixed chunks without a time base, the progress callback and the WDT
+ *   reset before every chunk and at the end,
+ * - chunk growth without WWDT: at most doubling, limited by u32MaxChunk,
+ * - chunk adaptation with WWDT feeding while the unit cost changes: no
+ *   early reload, no expiry, both the skipped feed and the window wait
+ *   taken, and the budget limited to half the WWDT period,
+ * - step errors, WDT_LONGOP_DONE, no step function, and a WWDT window that
+ *   never opens,
+ * - FMC_EraseStep / RMC_EraseStep on an ISP model, page by page, and the
+ *   chunk of a failed page not counted as done.
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2024 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#include <stdio.h>
+#include "NuMicro.h"
+#include "host_regs.h"
+
+#define TEST_WWDT_TICK_US   100UL
+#define TEST_WWDT_CMP       0x10UL
+#define TEST_WWDT_MAX       (WWDT_CNT_CNTDAT_Msk >> WWDT_CNT_CNTDAT_Pos)
+#define TEST_PHASE_UNITS    4000UL
+#define TEST_FLASH_BASE     0x20000UL
+#define TEST_FLASH_PAGES    3UL
+
+/* One trigger per erased page on FMC, one program trigger per word on RMC */
+#if defined(RMC)
+#define TEST_ISP            RMC
+#define TEST_ISP_CMD        RMC_ISPCMD_PROGRAM
+#define TEST_ISP_UNIT       4UL
+#define TEST_PAGE_SIZE      RMC_FLASH_PAGE_SIZE
+#define TEST_FF_REG         ISPSTS
+#define TEST_ISPFF_Msk      RMC_ISPSTS_ISPFF_Msk
+#define TEST_ERASE_STEP     RMC_EraseStep
+#else
+#define TEST_ISP            FMC
+#define TEST_ISP_CMD        FMC_ISPCMD_PAGE_ERASE
+#define TEST_ISP_UNIT       FMC_FLASH_PAGE_SIZE
+#define TEST_PAGE_SIZE      FMC_FLASH_PAGE_SIZE
+#define TEST_FF_REG         ISPCTL
+#define TEST_ISPFF_Msk      FMC_ISPCTL_ISPFF_Msk
+#define TEST_ERASE_STEP     FMC_EraseStep
+#endif
+
+/* Time and watchdog models */
+static uint32_t s_u32Now, s_u32WwdtOn, s_u32WwdtStuck, s_u32Reload, s_u32CntReads;
+static uint32_t s_u32Reloads, s_u32EarlyReloads, s_u32Expired;
+static uint32_t s_u32WdtReset, s_u32WdtResets, s_u32WdtMaxGap;
+
+/* Step function and progress state */
+static uint32_t s_u32Ctx, s_u32Next, s_u32Calls, s_u32PrevCount, s_u32MaxCount, s_u32BadStep;
+static uint32_t s_u32MaxChunkUs, s_u32FailAt, s_u32DoneAt, s_u32Progress, s_u32BadProgress;
+static int32_t s_i32StepErr;
+static const uint32_t *s_pu32Cost;
+static uint32_t s_u32Phases;
+
+/* Flash ISP model */
+static uint32_t s_u32IspCmd, s_u32IspAddr, s_u32IspUnits, s_u32BadAddr, s_u32FailAddr, s_u32IspFail;
+
+static uint32_t WwdtCount(void)
+{
+    uint32_t u32Ticks = (s_u32Now - s_u32Reload) / TEST_WWDT_TICK_US;
+
+    return (u32Ticks >= TEST_WWDT_MAX) ? 0UL : (TEST_WWDT_MAX - u32Ticks);
+}
+
+static void Advance(uint32_t u32Us)
+{
+    s_u32Now += u32Us;
+    if(s_u32WwdtOn && !s_u32WwdtStuck && (WwdtCount() == 0UL))
+        s_u32Expired++;
+}
+
+static uint32_t GetUs(void)
+{
+    return s_u32Now;
+}
+
+static uint32_t WwdtCntRead(uint32_t u32Addr, uint32_t u32Val)
+{
+    (void)u32Addr;
+    (void)u32Val;
+    s_u32CntReads++;
+    if(s_u32WwdtStuck)
+        return TEST_WWDT_MAX;
+    Advance(1UL);
+    return WwdtCount();
+}
+
+static uint32_t WwdtRldWrite(uint32_t u32Addr, uint32_t u32Old, uint32_t u32New)
+{
+    (void)u32Addr;
+    (void)u32Old;
+    if(u32New == WWDT_RELOAD_WORD)
+    {
+        if(WwdtCount() > TEST_WWDT_CMP)
+            s_u32EarlyReloads++;
+        s_u32Reloads++;
+        s_u32Reload = s_u32Now;
+    }
+    return 0UL;
+}
+
+static uint32_t WdtRstWrite(uint32_t u32Addr, uint32_t u32Old, uint32_t u32New)
+{
+    (void)u32Addr;
+    (void)u32Old;
+    if(u32New == WDT_RESET_COUNTER_KEYWORD)
+    {
+        if((s_u32Now - s_u32WdtReset) > s_u32WdtMaxGap)
+            s_u32WdtMaxGap = s_u32Now - s_u32WdtReset;
+        s_u32WdtReset = s_u32Now;
+        s_u32WdtResets++;
+    }
+    return 0UL;
+}
+
+/* Units must come in order, a chunk at most doubles the previous one */
+static int32_t Step(void *pvCtx, uint32_t u32Offset, uint32_t u32Count)
+{
+    uint32_t u32Start = s_u32Now, i;
+
+    if((pvCtx != &s_u32Ctx) || (u32Offset != s_u32Next) || (u32Count == 0UL))
+        s_u32BadStep++;
+    if((s_u32Calls != 0UL) && (u32Count > s_u32PrevCount * 2UL))
+        s_u32BadStep++;
+    if(u32Count > s_u32MaxCount)
+        s_u32MaxCount = u32Count;
+    s_u32PrevCount = u32Count;
+    s_u32Calls++;
+
+    if((s_u32FailAt != 0UL) && (u32Offset + u32Count > s_u32FailAt))
+        return s_i32StepErr;
+
+    for(i = 0UL; i < u32Count; i++)
+        Advance(s_pu32Cost[((u32Offset + i) / TEST_PHASE_UNITS) % s_u32Phases]);
+    if((s_u32Now - u32Start) > s_u32MaxChunkUs)
+        s_u32MaxChunkUs = s_u32Now - u32Start;
+    s_u32Next = u32Offset + u32Count;
+
+    if((s_u32DoneAt != 0UL) && (s_u32Next >= s_u32DoneAt))
+        return WDT_LONGOP_DONE;
+    return 0;
+}
+
+static void Progress(void *pvCtx, uint32_t u32Done, uint32_t u32Total)
+{
+    (void)u32Total;
+    if((pvCtx != &s_u32Ctx) || (u32Done != s_u32Next))
+        s_u32BadProgress++;
+    s_u32Progress++;
+}
+
+static void Start(S_WDT_LONGOP_T *psOp, const uint32_t *pu32Cost, uint32_t u32Phases)
+{
+    S_WDT_LONGOP_T sOp = { 0 };
+
+    *psOp = sOp;
+    psOp->pfnStep = Step;
+    psOp->pfnProgress = Progress;
+    psOp->pvCtx = &s_u32Ctx;
+    s_pu32Cost = pu32Cost;
+    s_u32Phases = u32Phases;
+    s_u32Next = s_u32Calls = s_u32PrevCount = s_u32MaxCount = s_u32MaxChunkUs = 0UL;
+    s_u32FailAt = s_u32DoneAt = s_u32Progress = 0UL;
+    s_u32BadStep = s_u32BadProgress = 0UL;
+    s_u32WdtResets = s_u32WdtMaxGap = 0UL;
+    s_u32WdtReset = s_u32Now;
+    s_u32Reloads = s_u32EarlyReloads = s_u32Expired = s_u32CntReads = 0UL;
+    s_u32Reload = s_u32Now;
+}
+
+/* No time base: u32Chunk units at a time, the WDT reset before every chunk and at the end */
+static void TestFixed(void)
+{
+    static const uint32_t au32Cost[] = { 20UL };
+    S_WDT_LONGOP_T sOp;
+
+    Start(&sOp, au32Cost, 1UL);
+    sOp.u32Total = 100UL;
+    sOp.u32Chunk = 7UL;
+    sOp.u32Feed = WDT_LONGOP_FEED_WDT;
+
+    HOST_CHECK(WDT_RunLongOp(&sOp) == WDT_OK);
+    HOST_CHECK((sOp.u32Done == 100UL) && (s_u32Next == 100UL));
+    HOST_CHECK((s_u32Calls == 15UL) && (s_u32PrevCount == 2UL) && (s_u32MaxCount == 7UL));
+    HOST_CHECK((sOp.u32Chunk == 7UL) && (sOp.u32UnitUs == 0UL));
+    HOST_CHECK((s_u32Progress == 15UL) && (s_u32BadProgress == 0UL) && (s_u32BadStep == 0UL));
+    HOST_CHECK(s_u32WdtResets == 16UL);
+    HOST_CHECK(s_u32WdtMaxGap == 7UL * 20UL);
+    HOST_CHECK((s_u32Reloads == 0UL) && (s_u32CntReads == 0UL));
+}
+
+/* 1 us units and a large budget: 1, 2, 4 .. 64, then u32MaxChunk */
+static void TestGrowth(void)
+{
+    static const uint32_t au32Cost[] = { 1UL };
+    S_WDT_LONGOP_T sOp;
+
+    Start(&sOp, au32Cost, 1UL);
+    sOp.pfnGetUs = GetUs;
+    sOp.u32Total = 1127UL;
+    sOp.u32MaxChunk = 100UL;
+    sOp.u32BudgetUs = 10000UL;
+    sOp.u32Feed = WDT_LONGOP_FEED_WDT;
+
+    HOST_CHECK(WDT_RunLongOp(&sOp) == WDT_OK);
+    HOST_CHECK(sOp.u32Done == 1127UL);
+    HOST_CHECK((s_u32Calls == 17UL) && (s_u32MaxCount == 100UL) && (s_u32BadStep == 0UL));
+    HOST_CHECK((sOp.u32Chunk == 100UL) && (sOp.u32UnitUs == 1UL));
+}
+
+/* WWDT feeding while the unit cost drops and rises again */
+static void TestWwdt(void)
+{
+    static const uint32_t au32Cost[] = { 8UL, 3UL, 5UL };
+    uint32_t u32Budget = (TEST_WWDT_MAX * TEST_WWDT_TICK_US) / 2UL;
+    S_WDT_LONGOP_T sOp;
+
+    Start(&sOp, au32Cost, 3UL);
+    s_u32WwdtOn = 1UL;
+    sOp.pfnGetUs = GetUs;
+    sOp.u32Total = 3UL * TEST_PHASE_UNITS;
+    sOp.u32Chunk = 16UL;
+    sOp.u32UnitUs = 8UL;
+    sOp.u32BudgetUs = 5000UL;
+    sOp.u32Feed = WDT_LONGOP_FEED_WDT | WDT_LONGOP_FEED_WWDT;
+    sOp.u32WwdtTickUs = TEST_WWDT_TICK_US;
+
+    HOST_CHECK(WDT_RunLongOp(&sOp) == WDT_OK);
+    HOST_CHECK((sOp.u32Done == sOp.u32Total) && (s_u32BadStep == 0UL) && (s_u32BadProgress == 0UL));
+    HOST_CHECK((s_u32EarlyReloads == 0UL) && (s_u32Expired == 0UL));
+    printf("wwdt: %lu chunks, %lu reloads, %lu counter reads, longest chunk %lu us\n", (unsigned long)s_u32Calls,
+           (unsigned long)s_u32Reloads, (unsigned long)s_u32CntReads, (unsigned long)s_u32MaxChunkUs);
+
+    /* The first feed is skipped, and later ones wait for the window */
+    HOST_CHECK(s_u32Reloads < s_u32Calls + 1UL);
+    HOST_CHECK(s_u32CntReads > s_u32Calls + 1UL);
+
+    /* Chunks fill the halved budget, and the estimate follows the last phase */
+    HOST_CHECK(sOp.u32UnitUs == 5UL);
+    HOST_CHECK(sOp.u32Chunk == u32Budget / 5UL);
+    HOST_CHECK((s_u32MaxChunkUs > u32Budget - 8UL) && (s_u32MaxChunkUs < (u32Budget * 5UL) / 3UL + 5UL));
+    HOST_CHECK(s_u32WdtMaxGap < 2UL * TEST_WWDT_MAX * TEST_WWDT_TICK_US);
+    s_u32WwdtOn = 0UL;
+}
+
+static void TestErrors(void)
+{
+    static const uint32_t au32Cost[] = { 10UL };
+    uint32_t u32Clock = SystemCoreClock;
+    S_WDT_LONGOP_T sOp;
+
+    /* A step error ends the operation, its chunk is not done */
+    Start(&sOp, au32Cost, 1UL);
+    sOp.u32Total = 100UL;
+    sOp.u32Chunk = 10UL;
+    s_u32FailAt = 35UL;
+    s_i32StepErr = -5;
+    HOST_CHECK(WDT_RunLongOp(&sOp) == -5);
+    HOST_CHECK((sOp.u32Done == 30UL) && (s_u32Calls == 4UL) && (s_u32Progress == 3UL));
+
+    /* Open-ended operation finished by the step function */
+    Start(&sOp, au32Cost, 1UL);
+    sOp.u32Chunk = 10UL;
+    s_u32DoneAt = 45UL;
+    HOST_CHECK(WDT_RunLongOp(&sOp) == WDT_OK);
+    HOST_CHECK((sOp.u32Done == 50UL) && (s_u32Calls == 5UL) && (s_u32Progress == 5UL));
+
+    Start(&sOp, au32Cost, 1UL);
+    sOp.pfnStep = NULL;
+    HOST_CHECK(WDT_RunLongOp(&sOp) == WDT_FAIL);
+
+    /* The window never opens: no reload, no step */
+    Start(&sOp, au32Cost, 1UL);
+    s_u32WwdtOn = 1UL;
+    s_u32WwdtStuck = 1UL;
+    SystemCoreClock = 1000UL;
+    sOp.u32Total = 10UL;
+    sOp.u32Feed = WDT_LONGOP_FEED_WWDT;
+    sOp.u32WwdtTickUs = TEST_WWDT_TICK_US;
+    HOST_CHECK(WDT_RunLongOp(&sOp) == WDT_ERR_TIMEOUT);
+    HOST_CHECK((s_u32Calls == 0UL) && (s_u32Reloads == 0UL) && (s_u32CntReads >= 1000UL));
+    SystemCoreClock = u32Clock;
+    s_u32WwdtStuck = 0UL;
+    s_u32WwdtOn = 0UL;
+}
+
+static uint32_t IspCmdWrite(uint32_t u32Addr, uint32_t u32Old, uint32_t u32New)
+{
+    (void)u32Addr;
+    (void)u32Old;
+    s_u32IspCmd = u32New;
+    return u32New;
+}
+
+static uint32_t IspAddrWrite(uint32_t u32Addr, uint32_t u32Old, uint32_t u32New)
+{
+    (void)u32Addr;
+    (void)u32Old;
+    s_u32IspAddr = u32New;
+    return u32New;
+}
+
+/* Erase (FMC) or program (RMC) triggers must cover the pages in order */
+static uint32_t IspTrgWrite(uint32_t u32Addr, uint32_t u32Old, uint32_t u32New)
+{
+    (void)u32Addr;
+    (void)u32Old;
+    s_u32IspFail = 0UL;
+    if(s_u32IspCmd == TEST_ISP_CMD)
+    {
+        if(s_u32IspAddr != TEST_FLASH_BASE + s_u32IspUnits * TEST_ISP_UNIT)
+            s_u32BadAddr++;
+        if(s_u32IspAddr == s_u32FailAddr)
+            s_u32IspFail = 1UL;
+        s_u32IspUnits++;
+    }
+    return u32New;
+}
+
+/* ISP operations finish at once */
+static uint32_t IspTrgRead(uint32_t u32Addr, uint32_t u32Val)
+{
+    (void)u32Addr;
+    (void)u32Val;
+    return 0UL;
+}
+
+static uint32_t IspFfRead(uint32_t u32Addr, uint32_t u32Val)
+{
+    (void)u32Addr;
+    return s_u32IspFail ? (u32Val | TEST_ISPFF_Msk) : (u32Val & ~TEST_ISPFF_Msk);
+}
+
+static uint32_t IspFfWrite(uint32_t u32Addr, uint32_t u32Old, uint32_t u32New)
+{
+    (void)u32Addr;
+    (void)u32Old;
+    if(u32New & TEST_ISPFF_Msk)
+        s_u32IspFail = 0UL;
+    return u32New & ~TEST_ISPFF_Msk;
+}
+
+static void TestFlash(void)
+{
+    uint32_t u32Base = TEST_FLASH_BASE;
+    S_WDT_LONGOP_T sOp = { 0 };
+
+    HostReg_SetHook(&TEST_ISP->ISPCMD, NULL, IspCmdWrite);
+    HostReg_SetHook(&TEST_ISP->ISPADDR, NULL, IspAddrWrite);
+    HostReg_SetHook(&TEST_ISP->ISPTRG, IspTrgRead, IspTrgWrite);
+    HostReg_SetHook(&TEST_ISP->TEST_FF_REG, IspFfRead, IspFfWrite);
+
+    sOp.pfnStep = TEST_ERASE_STEP;
+    sOp.pvCtx = &u32Base;
+    sOp.u32Total = TEST_FLASH_PAGES;
+    sOp.u32Chunk = 1UL;
+    sOp.u32Feed = WDT_LONGOP_FEED_WDT;
+    s_u32WdtResets = 0UL;
+    s_u32FailAddr = 0xFFFFFFFFUL;
+    HOST_CHECK(WDT_RunLongOp(&sOp) == WDT_OK);
+    HOST_CHECK(sOp.u32Done == TEST_FLASH_PAGES);
+    HOST_CHECK(s_u32IspUnits == (TEST_FLASH_PAGES * TEST_PAGE_SIZE) / TEST_ISP_UNIT);
+    HOST_CHECK((s_u32BadAddr == 0UL) && (s_u32WdtResets == TEST_FLASH_PAGES + 1UL));
+
+    /* The second page fails: the first one is done. RMC_Erase() still writes the rest of the page. */
+    s_u32IspUnits = 0UL;
+    s_u32FailAddr = TEST_FLASH_BASE + TEST_PAGE_SIZE;
+    HOST_CHECK(WDT_RunLongOp(&sOp) == -1);
+    HOST_CHECK(sOp.u32Done == 1UL);
+    HOST_CHECK(s_u32IspUnits == (2UL * TEST_PAGE_SIZE) / TEST_ISP_UNIT);
+    HOST_CHECK(s_u32BadAddr == 0UL);
+}
+
+int main(void)
+{
+    HostReg_Reset();
+    HostReg_Set(&WWDT->CTL, TEST_WWDT_CMP << WWDT_CTL_CMPDAT_Pos);
+    HostReg_SetHook((volatile uint32_t *)&WWDT->CNT, WwdtCntRead, NULL);
+    HostReg_SetHook(&WWDT->RLDCNT, NULL, WwdtRldWrite);
+    HostReg_SetHook(&WDT->RSTCNT, NULL, WdtRstWrite);
+    HostReg_Trap(1UL);
+
+    TestFixed();
+    TestGrowth();
+    TestWwdt();
+    TestErrors();
+    TestFlash();
+
+    return HostTest_Result("wdt_longop");
+}
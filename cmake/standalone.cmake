@@ -0,0 +1,192 @@
+# SPDX-License-Identifier: Apache-2.0
+#
+# Copyright (c) 2024 Nuvoton Technology Corporation.
+#
+# Standalone build of one series' StdDriver as a static library, used when
+# this tree is configured directly instead of as a Zephyr module:
+#
+#   cmake -S . -B build -DNUMAKER_SERIES=m46x -DNUMAKER_DRIVERS="UART;I2C;RTC" \
+#         [-DCMSIS_CORE_INCLUDE=<dir with core_cm4.h / core_cm23.h>]
+#
+# The series CMakeLists.txt files are reused as they are: the zephyr_*
+# functions below collect their sources into the numaker_stddriver target,
+# and CONFIG_HAS_NUMAKER_<X> / CONFIG_HAS_NUMICRO_<X> is set for every <X> in
+# NUMAKER_DRIVERS ("all" selects every driver). CMSIS_CORE_INCLUDE points at
+# the CMSIS core headers for a cross build. It defaults to the host stubs in
+# cmake/host, with which the library builds on a PC, the peripheral
+# registers are backed by memory and the host tests in cmake/host are added
+# for ctest.
+#
+# NUMAKER_PROFILE=slim drops code and tables most products do not need (see
+# the profile below); NUMAKER_DEFINES adds further driver switches and
+# NUMAKER_LTO enables link-time optimisation. The numaker_size target prints
+# the per-object size of the library for the selected profile.
+
+set(NUMAKER_SERIES m46x CACHE STRING "Series to build: m46x, m48x or m2l31x")
+set_property(CACHE NUMAKER_SERIES PROPERTY STRINGS m46x m48x m2l31x)
+set(NUMAKER_DRIVERS all CACHE STRING "Drivers to build, e.g. UART;I2C;RTC, or all")
+set(CMSIS_CORE_INCLUDE ${CMAKE_CURRENT_LIST_DIR}/host CACHE PATH "Directory of the CMSIS core headers or host stubs")
+set(NUMAKER_PROFILE full CACHE STRING "Driver feature profile: full or slim")
+set_property(CACHE NUMAKER_PROFILE PROPERTY STRINGS full slim)
+set(NUMAKER_DEFINES "" CACHE STRING "Extra driver switches, e.g. SDH_DISABLE_MMC;RSA_MAX_KLEN=2048")
+option(NUMAKER_LTO "Build StdDriver with link-time optimisation" OFF)
+
+if(NOT NUMAKER_SERIES MATCHES "^(m46x|m48x|m2l31x)$")
+  message(FATAL_ERROR "Unknown NUMAKER_SERIES ${NUMAKER_SERIES}")
+endif()
+if(NOT IS_DIRECTORY "${CMSIS_CORE_INCLUDE}")
+  message(FATAL_ERROR "Set CMSIS_CORE_INCLUDE to the CMSIS core headers or host stubs")
+endif()
+get_filename_component(numaker_core_dir ${CMSIS_CORE_INCLUDE} REALPATH)
+get_filename_component(numaker_host_dir ${CMAKE_CURRENT_LIST_DIR}/host REALPATH)
+if(numaker_core_dir STREQUAL numaker_host_dir)
+  set(numaker_host TRUE)
+else()
+  set(numaker_host FALSE)
+endif()
+
+string(TOUPPER ${NUMAKER_SERIES} series_uc)
+set(CONFIG_SOC_SERIES_${series_uc} y)
+
+add_library(numaker_stddriver STATIC)
+target_include_directories(numaker_stddriver PUBLIC ${CMSIS_CORE_INCLUDE})
+if(numaker_host)
+  target_sources(numaker_stddriver PRIVATE ${numaker_host_dir}/host_core.c)
+endif()
+target_compile_definitions(numaker_stddriver PUBLIC ${NUMAKER_DEFINES})
+
+# Slim profile: NIST P curves only, RSA up to 2048 bits, Winbond/MXIC SPI
+# flash only and no MMC/eMMC on SDH.
+if(NUMAKER_PROFILE STREQUAL "slim")
+  target_compile_definitions(numaker_stddriver PUBLIC
+    ECC_CURVE_GROUPS=ECC_CURVE_GROUP_P
+    RSA_MAX_KLEN=2048
+    SPIM_FLASH_VENDORS=\(SPIM_VENDOR_WINBOND|SPIM_VENDOR_MXIC\)
+    SDH_DISABLE_MMC
+  )
+elseif(NOT NUMAKER_PROFILE STREQUAL "full")
+  message(FATAL_ERROR "Unknown NUMAKER_PROFILE ${NUMAKER_PROFILE}")
+endif()
+
+if(CMAKE_C_COMPILER_ID STREQUAL "GNU" OR CMAKE_C_COMPILER_ID MATCHES "Clang")
+  target_compile_options(numaker_stddriver PRIVATE -ffunction-sections -fdata-sections)
+endif()
+set_property(TARGET numaker_stddriver PROPERTY INTERPROCEDURAL_OPTIMIZATION ${NUMAKER_LTO})
+
+find_program(NUMAKER_SIZE_TOOL NAMES ${CMAKE_C_COMPILER_TARGET}-size arm-none-eabi-size size)
+if(NUMAKER_SIZE_TOOL)
+  add_custom_target(numaker_size
+    COMMAND ${NUMAKER_SIZE_TOOL} -t $<TARGET_FILE:numaker_stddriver>
+    DEPENDS numaker_stddriver
+    COMMENT "StdDriver size, ${NUMAKER_SERIES} ${NUMAKER_PROFILE} profile"
+  )
+endif()
+
+function(numaker_enabled feature result)
+  set(${result} FALSE PARENT_SCOPE)
+  if(${feature})
+    set(${result} TRUE PARENT_SCOPE)
+  elseif(feature MATCHES "^CONFIG_HAS_NUM(AKER|ICRO)_(.+)$")
+    if("all" IN_LIST NUMAKER_DRIVERS OR CMAKE_MATCH_2 IN_LIST NUMAKER_DRIVERS OR CMAKE_MATCH_2 STREQUAL "HAL")
+      set(${result} TRUE PARENT_SCOPE)
+    endif()
+  endif()
+endfunction()
+
+function(zephyr_include_directories)
+  foreach(dir ${ARGN})
+    get_filename_component(dir ${dir} ABSOLUTE)
+    if(IS_DIRECTORY ${dir})
+      target_include_directories(numaker_stddriver PUBLIC ${dir})
+    endif()
+  endforeach()
+endfunction()
+
+function(zephyr_library_sources)
+  foreach(src ${ARGN})
+    get_filename_component(src ${src} ABSOLUTE)
+    target_sources(numaker_stddriver PRIVATE ${src})
+  endforeach()
+endfunction()
+
+function(zephyr_library_sources_ifdef feature)
+  numaker_enabled(${feature} enabled)
+  if(enabled)
+    zephyr_library_sources(${ARGN})
+  endif()
+endfunction()
+
+function(zephyr_sources_ifdef feature)
+  numaker_enabled(${feature} enabled)
+  if(enabled)
+    zephyr_library_sources(${ARGN})
+  endif()
+endfunction()
+
+add_subdirectory(${NUMAKER_SERIES})
+
+# Every other source of the series is selected by its upper-case file name
+# (CRYPTO, SDH, KPI, ...), so "all" builds the whole StdDriver. Sources that
+# do not build yet are listed in numaker_broken_<series>: m48x files that
+# still rely on the TRUE/FALSE/BITn legacy constants M480.h no longer
+# defines, and on the host the m48x/m2l31x retarget.c, whose GCC HardFault
+# handler is Arm assembly.
+set(numaker_broken_m46x)
+set(numaker_broken_m48x ccap.c emac.c sdh.c wwdt.c)
+set(numaker_broken_m2l31x)
+if(numaker_host)
+  list(APPEND numaker_broken_m48x retarget.c)
+  list(APPEND numaker_broken_m2l31x retarget.c)
+endif()
+get_target_property(numaker_srcs numaker_stddriver SOURCES)
+set(numaker_built)
+foreach(src ${numaker_srcs})
+  get_filename_component(name ${src} NAME)
+  list(APPEND numaker_built ${name})
+endforeach()
+file(GLOB numaker_all_srcs ${PROJECT_SOURCE_DIR}/${NUMAKER_SERIES}/StdDriver/src/*.c)
+foreach(src ${numaker_all_srcs})
+  get_filename_component(name ${src} NAME)
+  get_filename_component(drv ${src} NAME_WE)
+  string(TOUPPER ${drv} drv)
+  if(name IN_LIST numaker_built OR name IN_LIST numaker_broken_${NUMAKER_SERIES})
+    continue()
+  endif()
+  if("all" IN_LIST NUMAKER_DRIVERS OR drv IN_LIST NUMAKER_DRIVERS)
+    target_sources(numaker_stddriver PRIVATE ${src})
+    list(APPEND numaker_built ${name})
+  endif()
+endforeach()
+
+# numaker_host_test(<name> SOURCES <files> [REQUIRES <driver sources>]
+#                   [DEFINES <defs>] [BENCH])
+#
+# Adds a host test linked with the library and the register stubs. It is
+# skipped unless every REQUIRES source (e.g. i2c.c) is in the library.
+# Executables are not position independent so that static buffers have
+# 32-bit addresses for the drivers that program them into DMA registers.
+function(numaker_host_test name)
+  cmake_parse_arguments(arg "BENCH" "" "SOURCES;REQUIRES;DEFINES" ${ARGN})
+  foreach(src ${arg_REQUIRES})
+    if(NOT src IN_LIST numaker_built)
+      return()
+    endif()
+  endforeach()
+  add_executable(numaker_${name} ${arg_SOURCES})
+  target_compile_definitions(numaker_${name} PRIVATE ${arg_DEFINES})
+  target_compile_options(numaker_${name} PRIVATE -fno-pie)
+  target_link_options(numaker_${name} PRIVATE -no-pie)
+  target_link_libraries(numaker_${name} PRIVATE numaker_host numaker_stddriver)
+  add_test(NAME ${name} COMMAND numaker_${name})
+  if(arg_BENCH)
+    set_tests_properties(${name} PROPERTIES LABELS bench)
+  endif()
+endfunction()
+
+if(numaker_host AND NOT CMAKE_CROSSCOMPILING)
+  enable_testing()
+  add_library(numaker_host STATIC ${numaker_host_dir}/host_regs.c)
+  target_include_directories(numaker_host PUBLIC ${numaker_host_dir})
+  target_compile_options(numaker_host PRIVATE -fno-pie)
+  add_subdirectory(${numaker_host_dir} host)
+endif()
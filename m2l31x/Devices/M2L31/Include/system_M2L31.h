@@ -84,6 +84,124 @@ extern void Uart0DefaultMPF(void);
  */
 extern int IsDebugFifoEmpty(void);
 
+#if defined(DEFERRED_PRINTF)
+/**
+ * Deferred printf of retarget.c. DebugLog_IRQHandler must be called from the DEBUG_PORT interrupt handler.
+ */
+extern int DebugLog_Write(const char *ptr, int len);
+extern void DebugLog_IRQHandler(void);
+extern void DebugLog_Flush(void);
+extern void DebugLog_EnterPanic(void);
+extern uint32_t DebugLog_GetDropCount(void);
+#endif
+
+#if defined(BINARY_TRACE)
+/**
+ * Binary trace of retarget.c. TRACE_PRINTF() sends the format string address and up to
+ * TRACE_MAX_ARGS 32-bit arguments; the host decoder looks the format string up in the ELF file.
+ */
+#define TRACE_MAX_ARGS      8
+typedef uint32_t (*TRACE_TICK_FUNC)(void);
+extern void Trace_SetTickFunc(TRACE_TICK_FUNC pfnGetTick);
+extern void Trace_Log(const char *pcFmt, uint32_t u32ArgCnt, ...);
+extern uint32_t Trace_GetDropCount(void);
+/* 9 to 16 arguments expand to the undeclared TRACE_TOO_MANY_ARGS and fail to compile */
+#define TRACE_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, N, ...)   N
+#define TRACE_NARGS(...)    TRACE_NARGS_(0, ##__VA_ARGS__, TRACE_TOO_MANY_ARGS, TRACE_TOO_MANY_ARGS, \
+                                         TRACE_TOO_MANY_ARGS, TRACE_TOO_MANY_ARGS, TRACE_TOO_MANY_ARGS, \
+                                         TRACE_TOO_MANY_ARGS, TRACE_TOO_MANY_ARGS, TRACE_TOO_MANY_ARGS, \
+                                         8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define TRACE_PRINTF(fmt, ...)  Trace_Log((fmt), TRACE_NARGS(__VA_ARGS__), ##__VA_ARGS__)
+#else
+#define TRACE_PRINTF(fmt, ...)  printf((fmt), ##__VA_ARGS__)
+#endif
+
+/**
+ * Placement of hot driver paths in SRAM. Define NVT_FAST_<GROUP> to place the functions and
+ * lookup tables of that group in NVT_FAST_CODE_SECTION / NVT_FAST_DATA_SECTION:
+ *   NVT_FAST_CANFD    CAN FD message read path
+ *   NVT_FAST_UART     DEFERRED_PRINTF UART interrupt handler
+ * The default sections are copied to SRAM by Zephyr at boot; calls from flash reach them through
+ * linker veneers. Without NVT_FAST_<GROUP> the annotations are empty.
+ */
+#ifndef NVT_FAST_CODE_SECTION
+#define NVT_FAST_CODE_SECTION   ".ramfunc"
+#endif
+#ifndef NVT_FAST_DATA_SECTION
+#define NVT_FAST_DATA_SECTION   ".ramfunc.rodata"
+#endif
+
+#if defined(__ICCARM__)
+#define NVT_FAST_FUNC           __ramfunc
+#define NVT_FAST_DATA
+#else
+#define NVT_FAST_FUNC           __attribute__((noinline, section(NVT_FAST_CODE_SECTION)))
+#define NVT_FAST_DATA           __attribute__((section(NVT_FAST_DATA_SECTION)))
+#endif
+
+#if defined(NVT_FAST_CANFD)
+#define NVT_FAST_CANFD_FUNC    NVT_FAST_FUNC
+#define NVT_FAST_CANFD_DATA    NVT_FAST_DATA
+#else
+#define NVT_FAST_CANFD_FUNC
+#define NVT_FAST_CANFD_DATA
+#endif
+
+#if defined(NVT_FAST_UART)
+#define NVT_FAST_UART_FUNC     NVT_FAST_FUNC
+#define NVT_FAST_UART_DATA     NVT_FAST_DATA
+#else
+#define NVT_FAST_UART_FUNC
+#define NVT_FAST_UART_DATA
+#endif
+
+/**
+ * Wait-loop instrumentation. Define NVT_WAIT_STAT to bracket the blocking wait loops of the drivers
+ * with NVT_WAIT_BEGIN(site) / NVT_WAIT_END(site). Per site the number of waits, the longest and the
+ * total wait in cycles and a log2 histogram (bin n counts waits of 2^n to 2^(n+1)-1 cycles, the
+ * last bin all longer waits) are kept; read them with WaitStat_Get(). A site holds one start time,
+ * so it must not be waited on from two contexts at once. Without NVT_WAIT_STAT the macros are empty.
+ */
+#if defined(NVT_WAIT_STAT)
+#ifndef NVT_WAIT_HIST_BINS
+#define NVT_WAIT_HIST_BINS      24
+#endif
+#ifndef NVT_WAIT_CYCLES
+/* Cortex-M23 has no cycle counter: count SysTick clocks, one reload per wait is corrected */
+#define NVT_WAIT_CYCLES()       (SysTick->LOAD - SysTick->VAL)
+#define NVT_WAIT_SYSTICK
+#endif
+
+typedef enum
+{
+    WAIT_SITE_RMC_READ = 0,     /*!< RMC ISP read and ID read */
+    WAIT_SITE_RMC_PROGRAM,      /*!< RMC ISP program and configuration write */
+    WAIT_SITE_RMC_ERASE,        /*!< RMC ISP page and bank erase */
+    WAIT_SITE_RMC_CHKSUM,       /*!< RMC checksum and check-all-one */
+    WAIT_SITE_I2C,              /*!< I2C SI and STOP */
+    WAIT_SITE_LPI2C,            /*!< LPI2C SI and STOP */
+    WAIT_SITE_CNT
+} E_WAIT_SITE;
+
+typedef struct
+{
+    uint32_t u32Count;                      /*!< Number of waits */
+    uint32_t u32Max;                        /*!< Longest wait in cycles */
+    uint64_t u64Total;                      /*!< Sum of all waits in cycles */
+    uint32_t au32Hist[NVT_WAIT_HIST_BINS];  /*!< Log2 histogram of the wait cycles */
+} S_WAIT_STAT_T;
+
+extern uint32_t g_au32WaitStart[WAIT_SITE_CNT];
+extern void WaitStat_Reset(void);
+extern void WaitStat_Record(uint32_t u32Site, uint32_t u32Cycles);
+extern int32_t WaitStat_Get(uint32_t u32Site, S_WAIT_STAT_T *psStat);
+#define NVT_WAIT_BEGIN(site)    (g_au32WaitStart[(site)] = NVT_WAIT_CYCLES())
+#define NVT_WAIT_END(site)      WaitStat_Record((site), NVT_WAIT_CYCLES() - g_au32WaitStart[(site)])
+#else
+#define NVT_WAIT_BEGIN(site)
+#define NVT_WAIT_END(site)
+#endif
+
 
 #ifdef __cplusplus
 }
@@ -126,3 +126,98 @@ void Uart0DefaultMPF(void)
     SYS->GPB_MFP3 = (SYS->GPB_MFP3 & ~SYS_GPB_MFP3_PB13MFP_Msk) | SYS_GPB_MFP3_PB13MFP_UART0_TXD;
 }
 #endif
+
+#if defined(NVT_WAIT_STAT)
+/*----------------------------------------------------------------------------
+  Wait-loop statistics
+ *----------------------------------------------------------------------------*/
+uint32_t g_au32WaitStart[WAIT_SITE_CNT];
+static S_WAIT_STAT_T s_asWaitStat[WAIT_SITE_CNT];
+
+/**
+ * @brief    Reset wait statistics
+ * @param    None
+ * @return   None
+ * @details  Clears the statistics of all sites. NVT_WAIT_CYCLES() defaults to SysTick, which must be running.
+ */
+void WaitStat_Reset(void)
+{
+    uint32_t u32Primask = __get_PRIMASK();
+    uint32_t i;
+
+    __disable_irq();
+    for (i = 0UL; i < sizeof(s_asWaitStat); i++)
+    {
+        ((uint8_t *)s_asWaitStat)[i] = 0U;
+    }
+    __set_PRIMASK(u32Primask);
+}
+
+/**
+ * @brief    Record a wait
+ * @param[in]  u32Site    Wait site, ::E_WAIT_SITE.
+ * @param[in]  u32Cycles  Cycles spent in the wait loop.
+ * @return   None
+ * @details  Called by NVT_WAIT_END(). Safe to call from interrupt handlers.
+ */
+void WaitStat_Record(uint32_t u32Site, uint32_t u32Cycles)
+{
+    S_WAIT_STAT_T *psStat;
+    uint32_t u32Bin, u32Primask;
+
+    if (u32Site >= (uint32_t)WAIT_SITE_CNT)
+    {
+        return;
+    }
+
+#if defined(NVT_WAIT_SYSTICK)
+    /* SysTick reloaded during the wait */
+    if (u32Cycles & 0x80000000UL)
+    {
+        u32Cycles += (SysTick->LOAD & SysTick_LOAD_RELOAD_Msk) + 1UL;
+    }
+#endif
+
+    u32Bin = (u32Cycles > 1UL) ? (31UL - __CLZ(u32Cycles)) : 0UL;
+    if (u32Bin >= NVT_WAIT_HIST_BINS)
+    {
+        u32Bin = NVT_WAIT_HIST_BINS - 1UL;
+    }
+
+    psStat = &s_asWaitStat[u32Site];
+    u32Primask = __get_PRIMASK();
+    __disable_irq();
+    psStat->u32Count++;
+    psStat->u64Total += u32Cycles;
+    if (u32Cycles > psStat->u32Max)
+    {
+        psStat->u32Max = u32Cycles;
+    }
+    psStat->au32Hist[u32Bin]++;
+    __set_PRIMASK(u32Primask);
+}
+
+/**
+ * @brief    Get wait statistics
+ * @param[in]  u32Site    Wait site, ::E_WAIT_SITE.
+ * @param[out] psStat     Copy of the statistics of the site.
+ * @retval   0   Success
+ * @retval   -1  Invalid site or NULL pointer
+ */
+int32_t WaitStat_Get(uint32_t u32Site, S_WAIT_STAT_T *psStat)
+{
+    uint32_t u32Primask;
+
+    if ((u32Site >= (uint32_t)WAIT_SITE_CNT) || (psStat == NULL))
+    {
+        return -1;
+    }
+
+    u32Primask = __get_PRIMASK();
+    __disable_irq();
+    *psStat = s_asWaitStat[u32Site];
+    __set_PRIMASK(u32Primask);
+
+    return 0;
+}
+#endif
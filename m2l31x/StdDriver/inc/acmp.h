@@ -75,8 +75,42 @@ extern "C"
 /*--------------------------------------------------------------------------------------------------*/
 #define ACMP_TIMEOUT_ERR            (-1)    /*!< ACMP operation abort due to timeout error \hideinitializer */
 
+/*---------------------------------------------------------------------------------------------------------*/
+/* ACMP window compare state constant definitions                                                          */
+/*---------------------------------------------------------------------------------------------------------*/
+#define ACMP_WINDOW_BELOW             (0UL)   /*!< Input voltage is below the window lower bound \hideinitializer */
+#define ACMP_WINDOW_INSIDE            (1UL)   /*!< Input voltage is inside the window \hideinitializer */
+#define ACMP_WINDOW_ABOVE             (2UL)   /*!< Input voltage is above the window upper bound \hideinitializer */
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* ACMP EPWM brake routing constant definitions                                                            */
+/*---------------------------------------------------------------------------------------------------------*/
+#define ACMP_BRAKE_EDGE               (0UL)   /*!< Comparator output is an edge-detect brake source of EPWM \hideinitializer */
+#define ACMP_BRAKE_LEVEL              (1UL)   /*!< Comparator output is a level-detect brake source of EPWM \hideinitializer */
+
 /*@}*/ /* end of group ACMP_EXPORTED_CONSTANTS */
 
+
+/** @addtogroup ACMP_EXPORTED_STRUCTS ACMP Exported Structs
+  @{
+*/
+
+/**
+  * @brief  Comparator edge counter built on a timer capture input.
+  * @details The timer captures the comparator output through its internal capture path. With a capture
+  *          source divider of 2^u32DivShift, the timer raises one interrupt per 2^u32DivShift edges, so
+  *          a zero-cross detector does not have to take an interrupt for every crossing.
+  */
+typedef struct
+{
+    TIMER_T *timer;                 /*!< Timer that captures the comparator output */
+    uint32_t u32DivShift;           /*!< Capture source divider, log2 */
+    volatile uint32_t u32Events;    /*!< Capture events since open */
+    volatile uint32_t u32LastCap;   /*!< Timer counter latched by the latest capture event */
+} S_ACMP_EDGE_CNT_T;
+
+/*@}*/ /* end of group ACMP_EXPORTED_STRUCTS */
+
 extern int32_t g_ACMP_i32ErrCode;
 
 /** @addtogroup ACMP_EXPORTED_FUNCTIONS ACMP Exported Functions
@@ -504,6 +538,17 @@ extern int32_t g_ACMP_i32ErrCode;
 /* Function prototype declaration */
 void ACMP_Open(ACMP_T *acmp, uint32_t u32ChNum, uint32_t u32NegSrc, uint32_t u32HysSel);
 void ACMP_Close(ACMP_T *acmp, uint32_t u32ChNum);
+void ACMP_WindowOpen(ACMP_T *acmp, uint32_t u32PosSel, uint32_t u32LowLevel, uint32_t u32HighLevel, uint32_t u32HysSel);
+void ACMP_WindowClose(ACMP_T *acmp);
+uint32_t ACMP_GetWindowState(ACMP_T *acmp);
+void ACMP_EdgeCountOpen(S_ACMP_EDGE_CNT_T *psCnt, TIMER_T *timer, uint32_t u32ChNum, uint32_t u32Edge, uint32_t u32DivShift);
+void ACMP_EdgeCountClose(S_ACMP_EDGE_CNT_T *psCnt);
+void ACMP_EdgeCountIRQHandler(S_ACMP_EDGE_CNT_T *psCnt);
+uint32_t ACMP_EdgeCountGet(S_ACMP_EDGE_CNT_T *psCnt);
+uint32_t ACMP_EnableEADCTrigger(TIMER_T *timer, uint32_t u32ChNum, uint32_t u32Edge);
+void ACMP_DisableEADCTrigger(TIMER_T *timer);
+void ACMP_EnableEPWMBrake(EPWM_T *epwm, uint32_t u32ChannelMask, uint32_t u32ChNum, uint32_t u32Mode);
+void ACMP_DisableEPWMBrake(EPWM_T *epwm, uint32_t u32ChannelMask, uint32_t u32ChNum);
 
 /*@}*/ /* end of group ACMP_EXPORTED_FUNCTIONS */
 
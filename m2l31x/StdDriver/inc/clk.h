@@ -579,8 +579,44 @@ extern "C"
 
 #define CLK_TIMEOUT_ERR             (-1)    /*!< Clock timeout error value \hideinitializer */
 
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Wake-up Source Manager constant definitions.                                                           */
+/*---------------------------------------------------------------------------------------------------------*/
+#define CLK_WKSRC_LPTMR0            (0x01UL)    /*!< Wake-up source is LPTMR0 \hideinitializer */
+#define CLK_WKSRC_LPTMR1            (0x02UL)    /*!< Wake-up source is LPTMR1 \hideinitializer */
+#define CLK_WKSRC_LPUART0           (0x04UL)    /*!< Wake-up source is LPUART0 \hideinitializer */
+#define CLK_WKSRC_WKIO              (0x08UL)    /*!< Wake-up source is Standby Power-down wake-up I/O (GPA~GPD WK0/WK1, LPIO pins) \hideinitializer */
+#define CLK_WKSRC_WKTMR             (0x10UL)    /*!< Wake-up source is PMU wake-up timer \hideinitializer */
+#define CLK_WKSRC_RTC               (0x20UL)    /*!< Wake-up source is RTC alarm, tick or tamper \hideinitializer */
+#define CLK_WKSRC_ACMP              (0x40UL)    /*!< Wake-up source is ACMP0~2 \hideinitializer */
+#define CLK_WKSRC_OTHER             (0x80UL)    /*!< Wake-up source is not one of the managed sources \hideinitializer */
+#define CLK_WKSRC_CNT               (8UL)       /*!< Number of wake-up sources tracked by the wake-up source manager \hideinitializer */
+
 /*@}*/ /* end of group CLK_EXPORTED_CONSTANTS */
 
+/** @addtogroup CLK_EXPORTED_STRUCTS CLK Exported Structs
+  @{
+*/
+
+/**
+  * @details    Wake-up source manager tick function. It must return a free-running counter that keeps
+  *             counting in the selected Power-down mode, e.g. a LXT/LIRC clocked TTMR or LPTMR counter.
+  */
+typedef uint32_t (*CLK_WKSRC_TICK_FUNC)(void);
+
+/**
+  * @details    Wake-up source statistics
+  */
+typedef struct
+{
+    uint32_t u32WakeCnt;        /*!< Number of wake-ups caused by this source */
+    uint32_t u32LastTicks;      /*!< Ticks spent in Power-down before the latest wake-up by this source */
+    uint32_t u32MaxTicks;       /*!< Longest Power-down period ended by this source */
+    uint64_t u64TotalTicks;     /*!< Accumulated ticks spent in Power-down before wake-ups by this source */
+} S_CLK_WKSRC_STAT_T;
+
+/*@}*/ /* end of group CLK_EXPORTED_STRUCTS */
+
 extern int32_t g_CLK_i32ErrCode;
 
 /** @addtogroup CLK_EXPORTED_FUNCTIONS CLK Exported Functions
@@ -779,6 +815,13 @@ void     CLK_DisableMIRC(void);
 uint32_t CLK_EnableMIRC(uint32_t u32MircFreq);
 uint32_t CLK_GetHCLK1Freq(void);
 uint32_t CLK_GetPCLK2Freq(void);
+void     CLK_WKSrcInit(CLK_WKSRC_TICK_FUNC pfnGetTick);
+void     CLK_WKSrcEnable(uint32_t u32SrcMask);
+void     CLK_WKSrcDisable(uint32_t u32SrcMask);
+uint32_t CLK_WKSrcPowerDown(void);
+uint32_t CLK_WKSrcGetReason(void);
+int32_t  CLK_WKSrcGetStat(uint32_t u32Src, S_CLK_WKSRC_STAT_T *psStat);
+void     CLK_WKSrcClearStat(void);
 
 /*@}*/ /* end of group CLK_EXPORTED_FUNCTIONS */
 
@@ -65,8 +65,60 @@ extern "C"
 #define CRYPTO_DMA_CONTINUE     (0x6UL)   /*!< Do continuous encrypt/decrypt in DMA cascade \hideinitializer */
 #define CRYPTO_DMA_LAST         (0x7UL)   /*!< Do last encrypt/decrypt in DMA cascade          \hideinitializer */
 
+#define CRPT_JOB_AES            (0UL)     /*!< Job runs on the AES engine              \hideinitializer */
+#define CRPT_JOB_ENGINE_NUM     (1UL)     /*!< Engines of the job scheduler            \hideinitializer */
+#ifndef CRPT_JOB_OVERTAKE_MAX
+#define CRPT_JOB_OVERTAKE_MAX   (4UL)     /*!< Higher priority jobs that may start before a waiting job \hideinitializer */
+#endif
+#define CRPT_JOB_TIMEOUT        SystemCoreClock   /*!< Polls of \ref CRPT_JobWait before it gives up \hideinitializer */
+
+#define CRPT_JOB_OK             ( 0L)     /*!< Job finished                            \hideinitializer */
+#define CRPT_JOB_QUEUED         ( 1L)     /*!< Job waits for its engine                \hideinitializer */
+#define CRPT_JOB_RUNNING        ( 2L)     /*!< Job runs on its engine                  \hideinitializer */
+#define CRPT_JOB_ERR_ENGINE     (-1L)     /*!< Engine reported an error                \hideinitializer */
+#define CRPT_JOB_ERR_PARAM      (-2L)     /*!< Invalid job                             \hideinitializer */
+#define CRPT_JOB_ERR_BUSY       (-3L)     /*!< Job is queued or running                \hideinitializer */
+#define CRPT_JOB_ERR_TIMEOUT    (-4L)     /*!< Job did not finish in time              \hideinitializer */
+#define CRPT_JOB_ERR_CANCEL     (-5L)     /*!< Job was removed from its queue          \hideinitializer */
+
 /**@}*/ /* end of group CRYPTO_EXPORTED_CONSTANTS */
 
+/** @addtogroup CRYPTO_EXPORTED_STRUCTS CRYPTO Exported Structs
+  @{
+*/
+
+/**
+  * @details    AES key context of a session, see AES_CtxLoad
+  */
+typedef struct
+{
+    uint32_t au32Key[8];                /*!< Key words, as for AES_SetKey */
+    uint32_t u32KeySize;                /*!< AES_KEY_SIZE_128, AES_KEY_SIZE_192 or AES_KEY_SIZE_256 */
+    uint32_t u32KeyGen;                 /*!< Driver private, changes whenever the key changes */
+} S_AES_CTX_T;
+
+typedef struct S_CRPT_JOB S_CRPT_JOB_T;     /*!< Job of the crypto job scheduler */
+
+typedef void (*CRPT_JOB_START_FUNC)(CRPT_T *crpt, S_CRPT_JOB_T *psJob);                  /*!< Programs and starts the engine of the job */
+typedef void (*CRPT_JOB_DONE_FUNC)(CRPT_T *crpt, S_CRPT_JOB_T *psJob, int32_t i32Status); /*!< Called from the interrupt when the job finished */
+
+/**
+  * @details    Job of the crypto job scheduler, owned by the caller until it finished
+  */
+struct S_CRPT_JOB
+{
+    uint32_t u32Engine;                 /*!< CRPT_JOB_AES */
+    uint32_t u32Priority;               /*!< Higher runs first, FIFO among equal priorities */
+    CRPT_JOB_START_FUNC pfnStart;       /*!< e.g. AES_Open, AES_SetKey, AES_SetDMATransfer and AES_Start */
+    CRPT_JOB_DONE_FUNC  pfnDone;        /*!< NULL if not used */
+    void *pvUser;                       /*!< Caller data, not used by the scheduler */
+    volatile int32_t i32Status;         /*!< CRPT_JOB_QUEUED, CRPT_JOB_RUNNING, CRPT_JOB_OK or an error */
+    uint32_t u32Overtaken;              /*!< Scheduler private */
+    S_CRPT_JOB_T *psNext;               /*!< Scheduler private */
+};
+
+/**@}*/ /* end of group CRYPTO_EXPORTED_STRUCTS */
+
 
 /** @addtogroup CRYPTO_EXPORTED_MACROS CRYPTO Exported Macros
   @{
@@ -177,6 +229,15 @@ void AES_Start(CRPT_T *crpt, uint32_t u32Channel, uint32_t u32DMAMode);
 void AES_SetKey(CRPT_T *crpt, uint32_t u32Channel, uint32_t au32Keys[], uint32_t u32KeySize);
 void AES_SetInitVect(CRPT_T *crpt, uint32_t u32Channel, uint32_t au32IV[]);
 void AES_SetDMATransfer(CRPT_T *crpt, uint32_t u32Channel, uint32_t u32SrcAddr, uint32_t u32DstAddr, uint32_t u32TransCnt);
+void AES_CtxSetKey(S_AES_CTX_T *psCtx, uint32_t au32Keys[], uint32_t u32KeySize);
+void AES_CtxLoad(CRPT_T *crpt, uint32_t u32Channel, S_AES_CTX_T *psCtx, uint32_t au32IV[]);
+void AES_CtxInvalidate(S_AES_CTX_T *psCtx);
+void AES_InvalidateKeyCache(CRPT_T *crpt);
+void CRPT_JobInit(CRPT_T *crpt);
+int32_t CRPT_JobSubmit(CRPT_T *crpt, S_CRPT_JOB_T *psJob);
+int32_t CRPT_JobCancel(CRPT_T *crpt, S_CRPT_JOB_T *psJob);
+int32_t CRPT_JobWait(CRPT_T *crpt, S_CRPT_JOB_T *psJob);
+void CRPT_JobIRQHandler(CRPT_T *crpt);
 
 /**@}*/ /* end of group CRYPTO_EXPORTED_FUNCTIONS */
 
@@ -69,8 +69,56 @@ extern "C"
 #define ECAP_CAPTURE_TIMER_CLK_SRC_CAP1        (2UL<<ECAP_CTL1_CNTSRCSEL_Pos)    /*!< ECAP capture timer/clock source from CAP1    \hideinitializer */
 #define ECAP_CAPTURE_TIMER_CLK_SRC_CAP2        (3UL<<ECAP_CTL1_CNTSRCSEL_Pos)    /*!< ECAP capture timer/clock source from CAP2    \hideinitializer */
 
+#define ECAP_RING_SIZE                         (32UL)         /*!< Timestamps kept per channel, power of 2 up to 32 \hideinitializer */
+#define ECAP_DUTY_UNKNOWN                      (0xFFFFFFFFUL) /*!< Duty not measured, only one edge is captured      \hideinitializer */
+
 /*@}*/ /* end of group ECAP_EXPORTED_CONSTANTS */
 
+/** @addtogroup ECAP_EXPORTED_STRUCTS ECAP Exported Structs
+  @{
+*/
+
+/**
+  * @details    Timestamp ring of one capture channel.
+  */
+typedef struct
+{
+    uint32_t au32Ts[ECAP_RING_SIZE];    /*!< Timestamps extended to 32 bits by the overflow count */
+    volatile uint32_t u32Level;         /*!< Bit n is the input level after the edge in au32Ts[n] */
+    volatile uint32_t u32Head;          /*!< Write index, free running */
+    volatile uint32_t u32Tail;          /*!< Read index, free running */
+    volatile uint32_t u32Lost;          /*!< Edges dropped because the ring was full */
+    uint32_t u32PrevTs;                 /*!< Last processed edge */
+    uint32_t u32PrevRise;               /*!< Last processed rising edge */
+    uint32_t u32PendHigh;               /*!< High time of the period still open */
+    uint32_t u32Flags;                  /*!< Batch state */
+} S_ECAP_RING_T;
+
+/**
+  * @details    Capture service state of one ECAP module.
+  */
+typedef struct
+{
+    ECAP_T *ecap;                       /*!< ECAP module */
+    volatile uint32_t u32Ovf;           /*!< Counter overflow count */
+    S_ECAP_RING_T asRing[3];            /*!< Rings of ECAP_IC0 ~ ECAP_IC2 */
+} S_ECAP_CAPTURE_T;
+
+/**
+  * @details    Result of ECAP_CaptureMeasure().
+  */
+typedef struct
+{
+    uint32_t u32Edges;                  /*!< Edges consumed from the ring */
+    uint32_t u32Periods;                /*!< Complete periods measured */
+    uint32_t u32Period;                 /*!< Average period in ECAP ticks, 0 if none */
+    uint32_t u32FreqMilliHz;            /*!< Average frequency in mHz, 0 if none */
+    uint32_t u32Duty;                   /*!< High time in 0.1 %, or \ref ECAP_DUTY_UNKNOWN */
+} S_ECAP_MEAS_T;
+
+/*@}*/ /* end of group ECAP_EXPORTED_STRUCTS */
+
+
 /** @addtogroup ECAP_EXPORTED_FUNCTIONS ECAP Exported Functions
   @{
 */
@@ -448,6 +496,9 @@ void ECAP_Open(ECAP_T* ecap, uint32_t u32FuncMask);
 void ECAP_Close(ECAP_T* ecap);
 void ECAP_EnableINT(ECAP_T* ecap, uint32_t u32Mask);
 void ECAP_DisableINT(ECAP_T* ecap, uint32_t u32Mask);
+void ECAP_CaptureInit(S_ECAP_CAPTURE_T *psCap, ECAP_T *ecap, uint32_t u32ChMask);
+void ECAP_CaptureIRQHandler(S_ECAP_CAPTURE_T *psCap);
+uint32_t ECAP_CaptureMeasure(S_ECAP_CAPTURE_T *psCap, uint32_t u32Ch, uint32_t u32Clk, S_ECAP_MEAS_T *psMeas);
 /*@}*/ /* end of group ECAP_EXPORTED_FUNCTIONS */
 
 /*@}*/ /* end of group ECAP_Driver */
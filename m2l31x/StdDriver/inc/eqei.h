@@ -62,8 +62,50 @@ extern "C"
 #define EQEI_CTL2_DIRCTION_TIED_HIGH        (0x2<<EQEI_CTL2_DIRSRC_Pos)  /*!<Direction signal is tied 1 only for direction up count mode   \hideinitializer */
 #define EQEI_CTL2_DIRCTION_TIED_LOW         (0x3<<EQEI_CTL2_DIRSRC_Pos)  /*!<Direction signal is tied 0 only for direction down count mode \hideinitializer */
 
+/*---------------------------------------------------------------------------------------------------------*/
+/* EQEI encoder estimator constants definitions                                                            */
+/*---------------------------------------------------------------------------------------------------------*/
+#define EQEI_ENC_METHOD_STOP     (0UL)   /*!< No edge within the ECAP counter range, velocity is 0          \hideinitializer */
+#define EQEI_ENC_METHOD_M        (1UL)   /*!< Velocity from counts per update period (M-method)          \hideinitializer */
+#define EQEI_ENC_METHOD_T        (2UL)   /*!< Velocity from ECAP period between encoder edges (T-method) \hideinitializer */
+
+#define EQEI_ENC_M_ENTER_CNT     (16L)   /*!< Switch to M-method at this many counts per update          \hideinitializer */
+#define EQEI_ENC_M_EXIT_CNT      (8L)    /*!< Switch back to T-method below this many counts per update  \hideinitializer */
+#define EQEI_ENC_ECAP_CNT_MSK    (0xFFFFFFUL) /*!< ECAP counter width                                     \hideinitializer */
+
 /*@}*/ /* end of group EQEI_EXPORTED_CONSTANTS */
 
+/** @addtogroup EQEI_EXPORTED_STRUCTS EQEI Exported Structs
+  @{
+*/
+
+/**
+  * @details    Encoder estimator state. Velocity and acceleration are signed Q24.8 fixed point values in
+  *             counts per second and counts per second squared.
+  */
+typedef struct
+{
+    EQEI_T   *eqei;             /*!< EQEI module counting the encoder */
+    ECAP_T   *ecap;             /*!< ECAP module time stamping encoder edges */
+    uint32_t u32EcapCh;         /*!< ECAP channel capturing the encoder phase */
+    uint32_t u32EcapClk;        /*!< ECAP counter clock in Hz */
+    uint32_t u32UpdateHz;       /*!< Rate of EQEI_EncoderUpdate() calls */
+    uint32_t u32CntPerCap;      /*!< EQEI counts between two captured edges */
+    uint32_t u32Range;          /*!< EQEI counter range, CNTMAX + 1, 0 for 2^32 */
+    uint32_t u32LastCnt;        /*!< EQEI counter at the last update */
+    uint32_t u32LastCap;        /*!< Last captured ECAP value */
+    uint32_t u32HaveCap;        /*!< u32LastCap is valid */
+    uint32_t u32IdleTicks;      /*!< ECAP ticks elapsed since the last captured edge */
+    int32_t  i32HalfCntSinceCap; /*!< Position from the last captured edge in half counts */
+    int32_t  i32Pos;            /*!< Unwrapped position in counts */
+    int32_t  i32Vel;            /*!< Velocity, Q24.8 counts/s */
+    int32_t  i32Acc;            /*!< Acceleration, Q24.8 counts/s^2 */
+    uint32_t u32Method;         /*!< \ref EQEI_ENC_METHOD_STOP, \ref EQEI_ENC_METHOD_M or \ref EQEI_ENC_METHOD_T */
+} S_EQEI_ENC_T;
+
+/*@}*/ /* end of group EQEI_EXPORTED_STRUCTS */
+
+
 
 /** @addtogroup EQEI_EXPORTED_FUNCTIONS EQEI Exported Functions
   @{
@@ -417,6 +459,8 @@ void EQEI_EnableInt(EQEI_T* eqei, uint32_t u32IntSel);
 void EQEI_Open(EQEI_T* eqei, uint32_t u32Mode, uint32_t u32Value);
 void EQEI_Start(EQEI_T* eqei);
 void EQEI_Stop(EQEI_T* eqei);
+void EQEI_EncoderInit(S_EQEI_ENC_T *psEnc, EQEI_T *eqei, ECAP_T *ecap, uint32_t u32EcapCh, uint32_t u32EcapClk, uint32_t u32UpdateHz, uint32_t u32CntPerCap);
+void EQEI_EncoderUpdate(S_EQEI_ENC_T *psEnc);
 
 
 /*@}*/ /* end of group EQEI_EXPORTED_FUNCTIONS */
@@ -387,11 +387,13 @@ __STATIC_INLINE void LPI2C_STOP(LPI2C_T *lpi2c)
     uint32_t u32TimeOutCount = SystemCoreClock;
 
     (lpi2c)->CTL0 |= (LPI2C_CTL0_SI_Msk | LPI2C_CTL0_STO_Msk);
+    NVT_WAIT_BEGIN(WAIT_SITE_LPI2C);
     while(lpi2c->CTL0 & LPI2C_CTL0_STO_Msk)
     {
         u32TimeOutCount--;
         if(u32TimeOutCount == 0) break;
     }
+    NVT_WAIT_END(WAIT_SITE_LPI2C);
 }
 
 void LPI2C_ClearTimeoutFlag(LPI2C_T *lpi2c);
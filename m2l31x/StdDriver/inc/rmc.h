@@ -362,15 +362,18 @@ __STATIC_INLINE uint32_t RMC_ReadCID(void)
 #if ISBEN
     __ISB();
 #endif                                           /* To make sure ISP/CPU be Synchronized */
+    NVT_WAIT_BEGIN(WAIT_SITE_RMC_READ);
     while (tout-- > 0)
     {
         if (!(RMC->ISPTRG & RMC_ISPTRG_ISPGO_Msk))  /* Waiting for ISP Done */
         {
             if (RMC->ISPDAT != 0x530000DA)
                 g_RMC_i32ErrCode = -1;
+            NVT_WAIT_END(WAIT_SITE_RMC_READ);
             return RMC->ISPDAT;
         }
     }
+    NVT_WAIT_END(WAIT_SITE_RMC_READ);
     g_RMC_i32ErrCode = -1;
     return 0xFFFFFFFF;
 }
@@ -393,11 +396,16 @@ __STATIC_INLINE uint32_t RMC_ReadPID(void)
 #if ISBEN
     __ISB();
 #endif                                          /* To make sure ISP/CPU be Synchronized */
+    NVT_WAIT_BEGIN(WAIT_SITE_RMC_READ);
     while (tout-- > 0)
     {
         if (!(RMC->ISPTRG & RMC_ISPTRG_ISPGO_Msk))  /* Waiting for ISP Done */
+        {
+            NVT_WAIT_END(WAIT_SITE_RMC_READ);
             return RMC->ISPDAT;
+        }
     }
+    NVT_WAIT_END(WAIT_SITE_RMC_READ);
     g_RMC_i32ErrCode = -1;
     return 0xFFFFFFFF;
 }
@@ -421,11 +429,16 @@ __STATIC_INLINE uint32_t RMC_ReadUID(uint8_t u8Index)
 #if ISBEN
     __ISB();
 #endif
+    NVT_WAIT_BEGIN(WAIT_SITE_RMC_READ);
     while (tout-- > 0)
     {
         if (!(RMC->ISPTRG & RMC_ISPTRG_ISPGO_Msk))  /* Waiting for ISP Done */
+        {
+            NVT_WAIT_END(WAIT_SITE_RMC_READ);
             return RMC->ISPDAT;
+        }
     }
+    NVT_WAIT_END(WAIT_SITE_RMC_READ);
     g_RMC_i32ErrCode = -1;
     return 0xFFFFFFFF;
 }
@@ -448,11 +461,16 @@ __STATIC_INLINE uint32_t RMC_ReadUCID(uint32_t u32Index)
 #if ISBEN
     __ISB();
 #endif                                            /* To make sure ISP/CPU be Synchronized */
+    NVT_WAIT_BEGIN(WAIT_SITE_RMC_READ);
     while (tout-- > 0)
     {
         if (!(RMC->ISPTRG & RMC_ISPTRG_ISPGO_Msk))  /* Waiting for ISP Done */
+        {
+            NVT_WAIT_END(WAIT_SITE_RMC_READ);
             return RMC->ISPDAT;
+        }
     }
+    NVT_WAIT_END(WAIT_SITE_RMC_READ);
     g_RMC_i32ErrCode = -1;
     return 0xFFFFFFFF;
 }
@@ -477,11 +495,16 @@ __STATIC_INLINE int32_t RMC_SetVectorPageAddr(uint32_t u32PageAddr)
 #if ISBEN
     __ISB();
 #endif                                /* To make sure ISP/CPU be Synchronized */
+    NVT_WAIT_BEGIN(WAIT_SITE_RMC_PROGRAM);
     while (tout-- > 0)
     {
         if (!RMC->ISPTRG)             /* Waiting for ISP Done */
+        {
+            NVT_WAIT_END(WAIT_SITE_RMC_PROGRAM);
             return 0;
+        }
     }
+    NVT_WAIT_END(WAIT_SITE_RMC_PROGRAM);
     g_RMC_i32ErrCode = -1;
     return -1;
 }
@@ -494,6 +517,7 @@ __STATIC_INLINE int32_t RMC_SetVectorPageAddr(uint32_t u32PageAddr)
 extern void     RMC_Close(void);
 extern int32_t  RMC_ConfigXOM(uint32_t xom_num, uint32_t xom_base, uint8_t xom_page);
 extern int32_t  RMC_Erase(uint32_t u32PageAddr);
+extern int32_t  RMC_EraseStep(void *pvCtx, uint32_t u32Offset, uint32_t u32Count);
 extern int32_t  RMC_EraseXOM(uint32_t xom_num);
 extern int32_t  RMC_GetXOMState(uint32_t xom_num);
 extern int32_t  RMC_GetBootSource(void);
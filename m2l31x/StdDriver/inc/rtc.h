@@ -67,6 +67,7 @@ extern "C"
 /*---------------------------------------------------------------------------------------------------------*/
 #define RTC_WAIT_COUNT          0xFFFFFFFFUL      /*!< Initial Time-out Value \hideinitializer */
 #define RTC_YEAR2000            2000UL            /*!< RTC Reference for compute year data \hideinitializer */
+#define RTC_EPOCH_YEAR2000      946684800UL       /*!< Seconds from 1970-01-01 to 2000-01-01 00:00:00 \hideinitializer */
 #define RTC_FCR_REFERENCE       32761UL           /*!< RTC Reference for frequency compensation \hideinitializer */
 
 /*---------------------------------------------------------------------------------------------------------*/
@@ -118,6 +119,16 @@ extern "C"
 #define RTC_ERR_FAIL        (-1L)               /*!< RTC operation failed */
 #define RTC_ERR_TIMEOUT     (-2L)               /*!< RTC operation abort due to timeout error */
 
+/*---------------------------------------------------------------------------------------------------------*/
+/* RTC 32 kHz Drift Compensation Constant Definitions                                                      */
+/*---------------------------------------------------------------------------------------------------------*/
+#define RTC_DRIFT_REF_HXT       0UL               /*!< Measure LXT with a timer clocked by HXT \hideinitializer */
+#define RTC_DRIFT_REF_1PPS      1UL               /*!< Measure LXT against a 1PPS signal on TMx_EXT pin \hideinitializer */
+#define RTC_DRIFT_LXT_DIV       256UL             /*!< LXT cycles per capture with \ref RTC_DRIFT_REF_HXT \hideinitializer */
+#define RTC_DRIFT_FILTER_SHIFT  2UL               /*!< Low-pass filter weight of a new estimate is 1/2^n \hideinitializer */
+#define RTC_DRIFT_STEP_X10000   156L              /*!< Minimum change to reprogram FREQADJ, 1/64 Hz X10000 \hideinitializer */
+#define RTC_DRIFT_MAX_X10000    163840L           /*!< Estimates beyond +-500 ppm are rejected, X10000 \hideinitializer */
+
 /*@}*/ /* end of group RTC_EXPORTED_CONSTANTS */
 
 
@@ -140,6 +151,25 @@ typedef struct
     uint32_t u32AmPm;           /*!< Only Time Scale select 12-hr used */
 } S_RTC_TIME_DATA_T;
 
+/**
+  * @brief  RTC 32 kHz drift compensation state
+  */
+typedef struct
+{
+    TIMER_T *timer;                     /*!< Timer used for the measurement */
+    uint32_t u32RefSel;                 /*!< \ref RTC_DRIFT_REF_HXT or \ref RTC_DRIFT_REF_1PPS */
+    uint32_t u32RefHz;                  /*!< Timer clock frequency with \ref RTC_DRIFT_REF_HXT */
+    uint32_t u32Window;                 /*!< Captures per measurement window */
+    volatile uint32_t u32Caps;          /*!< Captures in the current window */
+    volatile uint32_t u32LastCap;       /*!< Previous capture value */
+    volatile uint64_t u64Ticks;         /*!< Timer ticks in the current window */
+    volatile int32_t i32FreqX10000;     /*!< Filtered LXT frequency X10000, 0 before the first window */
+    int32_t i32AppliedX10000;           /*!< Frequency last passed to \ref RTC_32KCalibration */
+    volatile uint32_t u32Primed;        /*!< First capture seen */
+    volatile uint32_t u32Ready;         /*!< New filtered estimate available */
+    volatile uint32_t u32Rejects;       /*!< Windows rejected by the range check */
+} S_RTC_DRIFT_T;
+
 /*@}*/ /* end of group RTC_EXPORTED_STRUCTS */
 
 
@@ -225,6 +255,26 @@ typedef struct
   */
 #define RTC_GET_TICK_INT_FLAG()         ((RTC->INTSTS & RTC_INTSTS_TICKIF_Msk)? 1:0)
 
+/**
+  * @brief      Get Seconds of RTC Timestamp
+  *
+  * @param[in]  u64Ts   Timestamp returned by \ref RTC_GetTimestamp
+  *
+  * @return     Seconds since 1970-01-01 00:00:00
+  * \hideinitializer
+  */
+#define RTC_TS_SEC(u64Ts)               ((uint32_t)((u64Ts) >> 32))
+
+/**
+  * @brief      Get Sub-second of RTC Timestamp
+  *
+  * @param[in]  u64Ts   Timestamp returned by \ref RTC_GetTimestamp
+  *
+  * @return     Sub-second part in units of 2^-32 second
+  * \hideinitializer
+  */
+#define RTC_TS_FRAC(u64Ts)              ((uint32_t)(u64Ts))
+
 /**
   * @brief      Set I/O Control By GPIO
   *
@@ -345,7 +395,17 @@ typedef struct
 int32_t RTC_Open(S_RTC_TIME_DATA_T *sPt);
 void RTC_Close(void);
 int32_t RTC_32KCalibration(int32_t i32FrequencyX10000);
+void RTC_DriftInit(S_RTC_DRIFT_T *psDrift, TIMER_T *timer, uint32_t u32RefSel, uint32_t u32RefHz, uint32_t u32WindowSec);
+void RTC_DriftIRQHandler(S_RTC_DRIFT_T *psDrift);
+int32_t RTC_DriftProcess(S_RTC_DRIFT_T *psDrift);
+void RTC_DriftClose(S_RTC_DRIFT_T *psDrift);
 void RTC_GetDateAndTime(S_RTC_TIME_DATA_T *sPt);
+void RTC_TimestampInit(uint32_t u32TickSelection);
+void RTC_TimestampSync(void);
+void RTC_TimestampTickHandler(void);
+uint64_t RTC_GetTimestamp(void);
+uint32_t RTC_DateAndTimeToEpoch(S_RTC_TIME_DATA_T *sPt);
+void RTC_EpochToDateAndTime(uint32_t u32Epoch, S_RTC_TIME_DATA_T *sPt);
 void RTC_GetAlarmDateAndTime(S_RTC_TIME_DATA_T *sPt);
 void RTC_SetDateAndTime(S_RTC_TIME_DATA_T *sPt);
 void RTC_SetAlarmDateAndTime(S_RTC_TIME_DATA_T *sPt);
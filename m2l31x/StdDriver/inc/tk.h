@@ -131,9 +131,38 @@ extern "C"
 
 #define TK_SCANALL_NUM                      (31)                                              /*!< Touch key scan all number */
 
+#define TK_ENGINE_CH_NUM                    (26UL)        /*!< Number of touch key channels handled by the TK engine */
+#define TK_ENGINE_OK                        ( 0L)         /*!< TK engine operation OK */
+#define TK_ENGINE_ERR_TIMEOUT               (-1L)         /*!< TK engine scan time-out */
+#define TK_ENGINE_ERR_PARAM                 (-2L)         /*!< TK engine invalid parameter */
+
 /*@}*/ /* end of group TK_EXPORTED_CONSTANTS */
 
 
+/** @addtogroup TK_EXPORTED_STRUCTS TK Exported Structs
+  @{
+*/
+
+/**
+  * @details    TK engine configuration. Raw counts are the 8-bit sensing result data, a touch
+  *             raises the raw count above the tracked baseline.
+  */
+typedef struct
+{
+    uint32_t u32ChanMask;       /*!< Touch key channels handled by the engine. Bit 0 is touch key 0 */
+    uint8_t  u8RefCapBank;      /*!< Reference capacitor bank data used for every channel during calibration */
+    uint8_t  u8CalTarget;       /*!< Raw count each channel is calibrated to */
+    uint8_t  u8ScanAllTarget;   /*!< Raw count the scan all data is calibrated to */
+    uint8_t  u8ScanAllTh;       /*!< Scan all threshold to wake up system from low power scan all mode */
+    uint8_t  u8TouchTh;         /*!< Signal above baseline to report a touch */
+    uint8_t  u8ReleaseTh;       /*!< Signal above baseline to report a release. Must be lower than u8TouchTh */
+    uint8_t  u8DebounceCnt;     /*!< Consecutive scans needed to change touch state */
+    uint8_t  u8BaselineShift;   /*!< Baseline IIR filter weight is 1/2^u8BaselineShift, 0~7 */
+} S_TK_ENGINE_CFG_T;
+
+/*@}*/ /* end of group TK_EXPORTED_STRUCTS */
+
+
 /** @addtogroup TK_EXPORTED_FUNCTIONS TK Exported Functions
   @{
 */
@@ -424,6 +453,17 @@ void TK_ClearTKIF(void);
 
 void TK_ConfigPowerDown(uint8_t u8Sensitivity);
 
+int32_t TK_EngineInit(const S_TK_ENGINE_CFG_T *psCfg);
+int32_t TK_EngineCalibrate(void);
+uint32_t TK_EngineUpdate(uint32_t u32TKNum, uint32_t u32RawData);
+int32_t TK_EngineScan(void);
+uint32_t TK_EngineProcess(void);
+uint32_t TK_EngineGetTouchMask(void);
+uint32_t TK_EngineGetBaseline(uint32_t u32TKNum);
+uint32_t TK_EngineGetCompCapBankData(uint32_t u32TKNum);
+void TK_EngineEnterScanAll(void);
+void TK_EngineExitScanAll(void);
+
 /*@}*/ /* end of group TK_EXPORTED_FUNCTIONS */
 
 /*@}*/ /* end of group TK_Driver */
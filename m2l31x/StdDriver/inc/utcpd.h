@@ -275,8 +275,110 @@ extern "C"
 
 #define UTCPD_PWRASTS_BLEEDDLVL_HIGH (0x0ul << 3)                                      /*!< UTCPD_T::PWRASTS: Bleed Discharge Level*/
 #define UTCPD_PWRASTS_BLEEDDLVL_LOW  (0x1ul << 3)                                      /*!< UTCPD_T::PWRASTS: Bleed Discharge Level*/
+/*---------------------------------------------------------------------------------------------------------*/
+/*  PD message layer constant definitions.                                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+#define UTCPD_PD_PORT_NUM            (1UL)                                             /*!< Number of ports handled by the PD message layer */
+#define UTCPD_PD_MAX_DO              (7UL)                                             /*!< Maximum data objects in one PD message          */
+#define UTCPD_PD_RXQ_SIZE            (4UL)                                             /*!< Received message queue depth, power of 2        */
+#define UTCPD_PD_MAX_PDO             (7UL)                                             /*!< Maximum PDOs kept from Source_Capabilities      */
+#define UTCPD_PD_TX_RETRY            (3UL)                                             /*!< Hardware retries when GoodCRC is not received   */
+
+#define UTCPD_PD_SOP                 (0UL)                                             /*!< SOP frame                                       */
+#define UTCPD_PD_SOP_PRIME           (1UL)                                             /*!< SOP' frame                                      */
+#define UTCPD_PD_SOP_PRIME_PRIME     (2UL)                                             /*!< SOP'' frame                                     */
+#define UTCPD_PD_TX_HARD_RESET       (5UL)                                             /*!< TXSTYPE value of Hard Reset                     */
+
+#define UTCPD_PD_REV20               (1UL)                                             /*!< PD specification revision 2.0                   */
+#define UTCPD_PD_REV30               (2UL)                                             /*!< PD specification revision 3.0                   */
+
+#define UTCPD_PD_CTRL_GOODCRC        (1UL)                                             /*!< GoodCRC control message                         */
+#define UTCPD_PD_CTRL_GOTOMIN        (2UL)                                             /*!< GotoMin control message                         */
+#define UTCPD_PD_CTRL_ACCEPT         (3UL)                                             /*!< Accept control message                          */
+#define UTCPD_PD_CTRL_REJECT         (4UL)                                             /*!< Reject control message                          */
+#define UTCPD_PD_CTRL_PING           (5UL)                                             /*!< Ping control message                            */
+#define UTCPD_PD_CTRL_PS_RDY         (6UL)                                             /*!< PS_RDY control message                          */
+#define UTCPD_PD_CTRL_GET_SRC_CAP    (7UL)                                             /*!< Get_Source_Cap control message                  */
+#define UTCPD_PD_CTRL_GET_SNK_CAP    (8UL)                                             /*!< Get_Sink_Cap control message                    */
+#define UTCPD_PD_CTRL_WAIT           (12UL)                                            /*!< Wait control message                            */
+#define UTCPD_PD_CTRL_SOFT_RESET     (13UL)                                            /*!< Soft_Reset control message                      */
+#define UTCPD_PD_CTRL_NOT_SUPPORTED  (16UL)                                            /*!< Not_Supported control message (PD 3.0)          */
+
+#define UTCPD_PD_DATA_SRC_CAP        (1UL)                                             /*!< Source_Capabilities data message                */
+#define UTCPD_PD_DATA_REQUEST        (2UL)                                             /*!< Request data message                            */
+#define UTCPD_PD_DATA_SNK_CAP        (4UL)                                             /*!< Sink_Capabilities data message                  */
+
+#define UTCPD_PD_HDR_TYPE(h)         ((uint32_t)(h) & 0x1FUL)                          /*!< Message type of a PD header                     */
+#define UTCPD_PD_HDR_REV(h)          (((uint32_t)(h) >> 6) & 0x3UL)                    /*!< Specification revision of a PD header           */
+#define UTCPD_PD_HDR_ID(h)           (((uint32_t)(h) >> 9) & 0x7UL)                    /*!< MessageID of a PD header                        */
+#define UTCPD_PD_HDR_CNT(h)          (((uint32_t)(h) >> 12) & 0x7UL)                   /*!< Number of data objects of a PD header           */
+#define UTCPD_PD_HDR_EXT(h)          (((uint32_t)(h) >> 15) & 0x1UL)                   /*!< Extended bit of a PD header                     */
+
+#define UTCPD_PD_TX_IDLE             (0UL)                                             /*!< No transmission requested                       */
+#define UTCPD_PD_TX_BUSY             (1UL)                                             /*!< Waiting for GoodCRC                             */
+#define UTCPD_PD_TX_OK               (2UL)                                             /*!< GoodCRC received                                */
+#define UTCPD_PD_TX_FAIL             (3UL)                                             /*!< No GoodCRC after all retries                    */
+#define UTCPD_PD_TX_DISCARD          (4UL)                                             /*!< Discarded by an incoming message                */
+
+#define UTCPD_PDO_FIXED              (0UL)                                             /*!< Fixed supply PDO                                */
+#define UTCPD_PDO_BATTERY            (1UL)                                             /*!< Battery supply PDO                              */
+#define UTCPD_PDO_VARIABLE           (2UL)                                             /*!< Variable supply PDO                             */
+#define UTCPD_PDO_PPS                (3UL)                                             /*!< Programmable power supply APDO                  */
+
+#define UTCPD_PD_T_SENDER_RESPONSE   (27UL)                                            /*!< tSenderResponse, 24 ~ 30 ms                     */
+#define UTCPD_PD_T_SINK_WAIT_CAP     (465UL)                                           /*!< tTypeCSinkWaitCap, 310 ~ 620 ms                 */
+#define UTCPD_PD_T_PS_TRANSITION     (500UL)                                           /*!< tPSTransition, 450 ~ 550 ms                     */
+#define UTCPD_PD_T_SINK_REQUEST      (100UL)                                           /*!< tSinkRequest after Wait, 100 ms minimum         */
+#define UTCPD_PD_T_PPS_REQUEST       (8000UL)                                          /*!< PPS re-request period, below tPPSTimeout 10 s   */
+#define UTCPD_PD_T_RECEIVER_RESPONSE (15UL)                                            /*!< tReceiverResponse, 15 ms maximum                */
+#define UTCPD_PD_T_HR_RECOVER        (1275UL)                                          /*!< tSrcRecover + tSrcTurnOn maximum after reset    */
+#define UTCPD_PD_N_HARD_RESET        (2UL)                                             /*!< nHardResetCount                                 */
+
+#define UTCPD_SNK_DISABLED           (0UL)                                             /*!< Sink policy engine not started                  */
+#define UTCPD_SNK_WAIT_CAP           (1UL)                                             /*!< Waiting for Source_Capabilities                 */
+#define UTCPD_SNK_WAIT_ACCEPT        (2UL)                                             /*!< Request sent, waiting for Accept                */
+#define UTCPD_SNK_WAIT_PS_RDY        (3UL)                                             /*!< Accepted, waiting for PS_RDY                    */
+#define UTCPD_SNK_READY              (4UL)                                             /*!< Explicit contract established                   */
+#define UTCPD_SNK_ERROR              (5UL)                                             /*!< Hard reset count exhausted, need error recovery */
 /*@}*/ /* end of group I2C_EXPORTED_CONSTANTS */
 
+/** @addtogroup UTCPD_EXPORTED_STRUCTS UTCPD Exported Structs
+  @{
+*/
+
+/**
+  * @details    A received or transmitted PD message.
+  */
+typedef struct
+{
+    uint16_t u16Header;                      /*!< PD message header                         */
+    uint8_t  u8Sop;                          /*!< Frame type, \ref UTCPD_PD_SOP etc.        */
+    uint8_t  u8Cnt;                          /*!< Number of data objects                    */
+    uint32_t u32Tick;                        /*!< Millisecond tick the message was received */
+    uint32_t au32Data[UTCPD_PD_MAX_DO];      /*!< Data objects                              */
+} S_UTCPD_PD_MSG_T;
+
+/**
+  * @details    One decoded power data object of Source_Capabilities.
+  */
+typedef struct
+{
+    uint8_t  u8Type;                         /*!< \ref UTCPD_PDO_FIXED etc.                 */
+    uint8_t  u8Pos;                          /*!< Object position, 1 based                  */
+    uint16_t u16MinMv;                       /*!< Minimum voltage in mV                     */
+    uint16_t u16MaxMv;                       /*!< Maximum voltage in mV                     */
+    uint16_t u16MaxMa;                       /*!< Maximum current in mA, 0 for battery PDO  */
+    uint32_t u32MaxMw;                       /*!< Maximum power in mW, battery PDO only     */
+} S_UTCPD_PDO_T;
+
+/**
+  * @details    Millisecond tick source of the PD policy engine.
+  */
+typedef uint32_t (*UTCPD_PD_TICK_FUNC)(void);
+
+/*@}*/ /* end of group UTCPD_EXPORTED_STRUCTS */
+
+
 /*---------------------------------------------------------------------------------------------------------*/
 /* Define utcpd functions prototype                                                                        */
 /*---------------------------------------------------------------------------------------------------------*/
@@ -346,6 +448,18 @@ void UTCPD_frs_tx_polarity_active_low(int port);
 void UTCPD_frs_tx_polarity_active_high(int port);
 void UTCPD_frs_mux_selection(int port, uint32_t cc1frssel, uint32_t cc2frssel);
 uint32_t UTCPD_Open(int port);
+int32_t UTCPD_PdOpen(int port, uint32_t u32PwrRole, uint32_t u32DataRole, UTCPD_PD_TICK_FUNC pfnTick);
+void UTCPD_PdIRQHandler(int port);
+int32_t UTCPD_PdSendMsg(int port, uint32_t u32Sop, uint32_t u32Type, const uint32_t au32Data[], uint32_t u32Cnt);
+int32_t UTCPD_PdSendHardReset(int port);
+uint32_t UTCPD_PdGetTxStatus(int port);
+int32_t UTCPD_PdGetMsg(int port, S_UTCPD_PD_MSG_T *psMsg);
+uint32_t UTCPD_PdParseSrcCap(const uint32_t au32Pdo[], uint32_t u32Cnt, S_UTCPD_PDO_T asPdo[]);
+void UTCPD_PdSnkSetTarget(int port, uint32_t u32Mv, uint32_t u32Ma);
+uint32_t UTCPD_PdSnkProcess(int port);
+int32_t UTCPD_PdSnkGetContract(int port, uint32_t *pu32Mv, uint32_t *pu32Ma);
+uint32_t UTCPD_PdGetMaxRespTime(int port);
+int32_t UTCPD_PdGetDropCount(int port, uint32_t *pu32RxDrops, uint32_t *pu32TxDrops);
 
 
 /*@}*/ /* end of group UTCPD_EXPORTED_FUNCTIONS */
@@ -0,0 +1,183 @@
+/**************************************************************************//**
+ * @file     utcpdlib.h
+ * @version  V1.00
+ * @brief    M2L31 series TCPC register access for the UTCPD driver
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ * @copyright (C) 2024 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __UTCPDLIB_H__
+#define __UTCPDLIB_H__
+
+#include "NuMicro.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup UTCPD_Driver UTCPD Driver
+  @{
+*/
+
+/*
+ * The UTCPD driver was written against the TCPCI register interface of an external port controller.
+ * On M2L31 the port controller is on chip: each TCPCI register is a 32-bit register of UTCPD_T and
+ * the accessors below read and write it directly. The i2c address argument is kept for the TCPCI
+ * call signature and not used. All accessors return 0 (EC_SUCCESS of the TCPCI library).
+ */
+
+/** @addtogroup UTCPD_EXPORTED_CONSTANTS UTCPD Exported Constants
+  @{
+*/
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  TCPCI register offsets in UTCPD_T                                                                      */
+/*---------------------------------------------------------------------------------------------------------*/
+#define TCPC_REG_ALERT                          (0x14UL)    /*!< UTCPD_T::IS          \hideinitializer */
+#define TCPC_REG_ALERT_MASK                     (0x18UL)    /*!< UTCPD_T::IE          \hideinitializer */
+#define TCPC_REG_POWER_STATUS_MASK              (0x1CUL)    /*!< UTCPD_T::PWRSTSIE    \hideinitializer */
+#define TCPC_REG_FAULT_STATUS_MASK              (0x20UL)    /*!< UTCPD_T::FUTSTSIE    \hideinitializer */
+#define TCPC_REG_TCPC_CTRL                      (0x24UL)    /*!< UTCPD_T::CTL         \hideinitializer */
+#define TCPC_REG_PINPL                          (0x28UL)    /*!< UTCPD_T::PINPL       \hideinitializer */
+#define TCPC_REG_ROLE_CTRL                      (0x2CUL)    /*!< UTCPD_T::ROLCTL      \hideinitializer */
+#define TCPC_REG_FAULT_CTRL                     (0x30UL)    /*!< UTCPD_T::FUTCTL      \hideinitializer */
+#define TCPC_REG_POWER_CTRL                     (0x34UL)    /*!< UTCPD_T::PWRCTL      \hideinitializer */
+#define TCPC_REG_CC_STATUS                      (0x38UL)    /*!< UTCPD_T::CCSTS       \hideinitializer */
+#define TCPC_REG_POWER_STATUS                   (0x3CUL)    /*!< UTCPD_T::PWRSTS      \hideinitializer */
+#define TCPC_REG_FAULT_STATUS                   (0x40UL)    /*!< UTCPD_T::FUTSTS      \hideinitializer */
+#define TCPC_REG_COMMAND                        (0x44UL)    /*!< UTCPD_T::CMD         \hideinitializer */
+#define TCPC_REG_MSG_HDR_INFO                   (0x50UL)    /*!< UTCPD_T::MSHEAD      \hideinitializer */
+#define TCPC_REG_RX_DETECT                      (0x54UL)    /*!< UTCPD_T::DTRXEVNT    \hideinitializer */
+#define TCPC_REG_VBUS_SINK_DISCONNECT_THRESH    (0xC4UL)    /*!< UTCPD_T::SKVBDCTH    \hideinitializer */
+#define TCPC_REG_VBUS_STOP_DISCHARGE_THRESH     (0xC8UL)    /*!< UTCPD_T::SPDGTH      \hideinitializer */
+#define TCPC_REG_VBUS_VOLTAGE_ALARM_HI_CFG      (0xCCUL)    /*!< UTCPD_T::VBAMH, followed by VBAML \hideinitializer */
+#define UTCPD_MUXSEL                            (0xDCUL)    /*!< UTCPD_T::MUXSEL      \hideinitializer */
+#define UTCPD_PHYCTL                            (0x11CUL)   /*!< UTCPD_T::PHYCTL      \hideinitializer */
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  TCPCI register bits                                                                                    */
+/*---------------------------------------------------------------------------------------------------------*/
+#define TCPC_REG_TCPC_CTRL_PLUG_ORIENTATION             UTCPD_CTL_ORIENT_Msk        /*!< Plug orientation        \hideinitializer */
+
+#define TCPC_REG_PINPL_SRCEN                            UTCPD_PINPL_VBSRENPL_Msk    /*!< VBUS source enable      \hideinitializer */
+#define TCPC_REG_PINPL_SNKEN                            UTCPD_PINPL_VBSKENPL_Msk    /*!< VBUS sink enable        \hideinitializer */
+#define TCPC_REG_PINPL_VBDCHG                           UTCPD_PINPL_VBDGENPL_Msk    /*!< VBUS discharge enable   \hideinitializer */
+#define TCPC_REG_PINPL_FRSTX                            UTCPD_PINPL_TXFRSPL_Msk     /*!< Fast role swap transmit \hideinitializer */
+#define TCPC_REG_PINPL_VCEN                             UTCPD_PINPL_VCENPL_Msk      /*!< VCONN enable            \hideinitializer */
+
+#define TCPC_REG_FAULT_CTRL_VCONN_OCP_FAULT_DIS         UTCPD_FUTCTL_VCOCDTDS_Msk   /*!< VCONN OC detection off  \hideinitializer */
+#define TCPC_REG_FAULT_CTRL_VBUS_OVP_FAULT_DIS          UTCPD_FUTCTL_VBOVDTDS_Msk   /*!< VBUS OV detection off   \hideinitializer */
+#define TCPC_REG_FAULT_CTRL_VBUS_OCP_FAULT_DIS          UTCPD_FUTCTL_VBOCDTDS_Msk   /*!< VBUS OC detection off   \hideinitializer */
+#define TCPC_REG_FAULT_CTRL_VBUS_FORCE_OFF_DIS          UTCPD_FUTCTL_FOFFVBDS_Msk   /*!< Force off VBUS disabled \hideinitializer */
+
+#define TCPC_REG_POWER_CTRL_ENABLE_VCONN                UTCPD_PWRCTL_VCEN_Msk       /*!< VCONN enable            \hideinitializer */
+#define TCPC_REG_POWER_CTRL_AUTO_DISCHARGE_DISCONNECT   UTCPD_PWRCTL_ADGDC_Msk      /*!< Auto discharge          \hideinitializer */
+#define TCPC_REG_POWER_CTRL_VBUS_VOL_MONITOR_DIS        UTCPD_PWRCTL_VBMONI_Msk     /*!< VBUS monitor disabled   \hideinitializer */
+
+#define TCPC_REG_CC_STATUS_CC1_STATE_MASK               UTCPD_CCSTS_CC1STATE_Msk    /*!< CC1 state               \hideinitializer */
+#define TCPC_REG_CC_STATUS_CC2_STATE_MASK               UTCPD_CCSTS_CC2STATE_Msk    /*!< CC2 state               \hideinitializer */
+#define TCPC_REG_CC_STATUS_CONNECT_RESULT_MASK          UTCPD_CCSTS_CONRLT_Msk      /*!< Connect result          \hideinitializer */
+#define TCPC_REG_CC_STATUS_LOOK4CONNECTION_MASK         UTCPD_CCSTS_LK4CONN_Msk     /*!< Looking for connection  \hideinitializer */
+
+#define TCPC_REG_POWER_STATUS_SINKING_VBUS              UTCPD_PWRSTS_SKVB_Msk       /*!< Sinking VBUS            \hideinitializer */
+#define TCPC_REG_POWER_STATUS_SOURCING_VBUS             UTCPD_PWRSTS_SRVB_Msk       /*!< Sourcing VBUS           \hideinitializer */
+#define TCPC_REG_POWER_STATUS_SOURCING_HIGH_VBUS        UTCPD_PWRSTS_SRHV_Msk       /*!< Sourcing high voltage   \hideinitializer */
+
+#define VBOCS                                           UTCPD_MUXSEL_VBOCS_Msk      /*!< VBUS OC source select   \hideinitializer */
+#define VCOCS                                           UTCPD_MUXSEL_VCOCS_Msk      /*!< VCONN OC source select  \hideinitializer */
+#define CC1VCENS                                        UTCPD_MUXSEL_CC1VCENS_Msk   /*!< CC1 VCONN enable select \hideinitializer */
+#define CC2VCENS                                        UTCPD_MUXSEL_CC2VCENS_Msk   /*!< CC2 VCONN enable select \hideinitializer */
+#define CC1FRSS                                         UTCPD_MUXSEL_CC1FRSS_Msk    /*!< CC1 FRS select          \hideinitializer */
+#define CC2FRSS                                         UTCPD_MUXSEL_CC2FRSS_Msk    /*!< CC2 FRS select          \hideinitializer */
+
+/*@}*/ /* end of group UTCPD_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup UTCPD_EXPORTED_STRUCTS UTCPD Exported Structs
+  @{
+*/
+
+/**
+  * @details    Action of tcpc_update16()
+  */
+enum mask_update
+{
+    MASK_CLR = 0,                       /*!< Clear the bits */
+    MASK_SET = 1                        /*!< Set the bits */
+};
+
+/*@}*/ /* end of group UTCPD_EXPORTED_STRUCTS */
+
+
+/** @addtogroup UTCPD_EXPORTED_FUNCTIONS UTCPD Exported Functions
+  @{
+*/
+
+/* UTCPD register at a TCPCI offset. There is one port. */
+#define UTCPD_TCPC_REG(port, reg)   (*(volatile uint32_t *)((uint8_t *)UTCPD + (uint32_t)(reg)))
+
+__STATIC_INLINE int tcpc_addr_read32(int port, const void *i2c_addr, int reg, int *val)
+{
+    (void)port;
+    (void)i2c_addr;
+    *val = (int)UTCPD_TCPC_REG(port, reg);
+    return 0;
+}
+
+__STATIC_INLINE int tcpc_addr_write32(int port, const void *i2c_addr, int reg, unsigned int val)
+{
+    (void)port;
+    (void)i2c_addr;
+    UTCPD_TCPC_REG(port, reg) = (uint32_t)val;
+    return 0;
+}
+
+/* TCPCI 16-bit registers are 32-bit wide on UTCPD, MUXSEL keeps fields above bit 15. The 16-bit
+   accessors therefore transfer the whole register. */
+__STATIC_INLINE int tcpc_addr_read16(int port, const void *i2c_addr, int reg, int *val)
+{
+    return tcpc_addr_read32(port, i2c_addr, reg, val);
+}
+
+__STATIC_INLINE int tcpc_addr_write16(int port, const void *i2c_addr, int reg, int val)
+{
+    return tcpc_addr_write32(port, i2c_addr, reg, (unsigned int)val);
+}
+
+__STATIC_INLINE int tcpc_update16(int port, int reg, uint32_t mask, enum mask_update action)
+{
+    (void)port;
+    if (action == MASK_SET)
+        UTCPD_TCPC_REG(port, reg) |= mask;
+    else
+        UTCPD_TCPC_REG(port, reg) &= ~mask;
+    return 0;
+}
+
+/* Writes consecutive 16-bit TCPCI registers, each into its own 32-bit UTCPD register */
+__STATIC_INLINE int tcpc_write_block(int port, int reg, const uint8_t *out, int len)
+{
+    int i;
+
+    (void)port;
+    for (i = 0; (i + 1) < len; i += 2)
+        UTCPD_TCPC_REG(port, reg + i * 2) = (uint32_t)out[i] | ((uint32_t)out[i + 1] << 8);
+    return 0;
+}
+
+/*@}*/ /* end of group UTCPD_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group UTCPD_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __UTCPDLIB_H__ */
@@ -327,6 +327,14 @@ static uint8_t CANFD_EncodeDLC(uint8_t u8NumberOfBytes)
 }
 
 
+/** @cond HIDDEN_SYMBOLS */
+/* Number of data bytes of each DLC code */
+static NVT_FAST_CANFD_DATA const uint8_t s_au8CanfdDlcBytes[16] =
+{
+    0u, 1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u, 12u, 16u, 20u, 24u, 32u, 48u, 64u
+};
+/** @endcond HIDDEN_SYMBOLS */
+
 /**
  * @brief       Decode the Data Length Code.
  *
@@ -338,14 +346,7 @@ static uint8_t CANFD_EncodeDLC(uint8_t u8NumberOfBytes)
  */
 static uint8_t CANFD_DecodeDLC(uint8_t u8Dlc)
 {
-    if (u8Dlc <= 8) return u8Dlc;
-    else if (u8Dlc == 9) return 12;
-    else if (u8Dlc == 10) return 16;
-    else if (u8Dlc == 11) return 20;
-    else if (u8Dlc == 12) return 24;
-    else if (u8Dlc == 13) return 32;
-    else if (u8Dlc == 14) return 48;
-    else return 64;
+    return s_au8CanfdDlcBytes[u8Dlc & 0xFu];
 }
 
 
@@ -1266,7 +1267,7 @@ void CANFD_SetXIDFltr(CANFD_T *psCanfd, uint32_t u32FltrIdx, uint32_t u32FilterL
  *              The function fills a receive CAN message frame structure with just received data
  *              and activates the Message Buffer again.The function returns immediately.
 */
-uint32_t CANFD_ReadRxBufMsg(CANFD_T *psCanfd, uint8_t u8MbIdx, CANFD_FD_MSG_T *psMsgBuf)
+NVT_FAST_CANFD_FUNC uint32_t CANFD_ReadRxBufMsg(CANFD_T *psCanfd, uint8_t u8MbIdx, CANFD_FD_MSG_T *psMsgBuf)
 {
     CANFD_BUF_T *psRxBuffer;
     uint32_t u32Success = 0;
@@ -1315,7 +1316,7 @@ uint32_t CANFD_ReadRxBufMsg(CANFD_T *psCanfd, uint8_t u8MbIdx, CANFD_FD_MSG_T *p
  *
  * @details     This function reads a CAN message from the CANFD build-in Rx FIFO.
  */
-uint32_t CANFD_ReadRxFifoMsg(CANFD_T *psCanfd, uint8_t u8FifoIdx, CANFD_FD_MSG_T *psMsgBuf)
+NVT_FAST_CANFD_FUNC uint32_t CANFD_ReadRxFifoMsg(CANFD_T *psCanfd, uint8_t u8FifoIdx, CANFD_FD_MSG_T *psMsgBuf)
 {
     CANFD_BUF_T *pRxBuffer;
     uint8_t GetIndex;
@@ -1381,7 +1382,7 @@ uint32_t CANFD_ReadRxFifoMsg(CANFD_T *psCanfd, uint8_t u8FifoIdx, CANFD_FD_MSG_T
  *
  * @details     Copies a message from a dedicated Rx buffer into a message buffer.
  */
-void CANFD_CopyDBufToMsgBuf(CANFD_BUF_T *psRxBuf, CANFD_FD_MSG_T *psMsgBuf)
+NVT_FAST_CANFD_FUNC void CANFD_CopyDBufToMsgBuf(CANFD_BUF_T *psRxBuf, CANFD_FD_MSG_T *psMsgBuf)
 {
     uint32_t u32Idx;
 
@@ -1461,7 +1462,7 @@ uint32_t CANFD_GetRxFifoWaterLvl(CANFD_T *psCanfd, uint32_t u32RxFifoNum)
  *
  * @details      Copies messages from FIFO into a message buffert.
  */
-void CANFD_CopyRxFifoToMsgBuf(CANFD_BUF_T *psRxBuf, CANFD_FD_MSG_T *psMsgBuf)
+NVT_FAST_CANFD_FUNC void CANFD_CopyRxFifoToMsgBuf(CANFD_BUF_T *psRxBuf, CANFD_FD_MSG_T *psMsgBuf)
 {
     /*Copies a message from a dedicated Rx FIFO into a message buffer*/
     CANFD_CopyDBufToMsgBuf(psRxBuf, psMsgBuf);
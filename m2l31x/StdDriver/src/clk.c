@@ -1633,6 +1633,271 @@ uint32_t CLK_EnableMIRC(uint32_t u32MircFreq)
     return CLK_GetMIRCFreq();
 }
 
+static CLK_WKSRC_TICK_FUNC s_pfnWKSrcGetTick = NULL;
+static uint32_t s_u32WKSrcEnabled = 0UL;
+static uint32_t s_u32WKSrcReason = 0UL;
+static S_CLK_WKSRC_STAT_T s_asWKSrcStat[CLK_WKSRC_CNT];
+
+/**
+  * @brief      Collect and clear the wake-up flags of all managed wake-up sources
+  * @param      None
+  * @return     Wake-up source bit mask. See \ref CLK_WKSRC_LPTMR0 ~ \ref CLK_WKSRC_OTHER.
+  * @details    PMU wake-up flags are cleared by CLRWK, LPTMR and LPUART wake-up flags are
+  *             write-one-to-clear in their own modules.
+  */
+static uint32_t CLK_WKSrcCollect(void)
+{
+    uint32_t u32PmuSts, u32LpuartSts, u32PdMode, u32Src = 0UL;
+
+    u32PmuSts = CLK->PMUSTS;
+    u32PdMode = CLK->PMUCTL & CLK_PMUCTL_PDMSEL_Msk;
+
+    if (u32PmuSts & (CLK_PMUSTS_GPAWK0_Msk | CLK_PMUSTS_GPBWK0_Msk | CLK_PMUSTS_GPCWK0_Msk | CLK_PMUSTS_GPDWK0_Msk |
+                     CLK_PMUSTS_GPAWK1_Msk | CLK_PMUSTS_GPBWK1_Msk | CLK_PMUSTS_GPCWK1_Msk | CLK_PMUSTS_GPDWK1_Msk))
+        u32Src |= CLK_WKSRC_WKIO;
+
+    if (u32PmuSts & CLK_PMUSTS_TMRWK_Msk)
+        u32Src |= CLK_WKSRC_WKTMR;
+
+    if (u32PmuSts & CLK_PMUSTS_RTCWK_Msk)
+        u32Src |= CLK_WKSRC_RTC;
+
+    /* ACMP wake-up flags are only valid in Standby Power-down mode */
+    if ((u32PdMode >= CLK_PMUCTL_PDMSEL_SPD0) && (u32PdMode <= CLK_PMUCTL_PDMSEL_SPD2) &&
+            (u32PmuSts & (CLK_PMUSTS_ACMPWK0_Msk | CLK_PMUSTS_ACMPWK1_Msk | CLK_PMUSTS_ACMPWK2_Msk)))
+        u32Src |= CLK_WKSRC_ACMP;
+
+    if (u32PmuSts & ~CLK_PMUSTS_CLRWK_Msk)
+        CLK->PMUSTS |= CLK_PMUSTS_CLRWK_Msk;
+
+    if (LPTMR_GetWakeupFlag(LPTMR0))
+    {
+        u32Src |= CLK_WKSRC_LPTMR0;
+        LPTMR_ClearWakeupFlag(LPTMR0);
+    }
+
+    if (LPTMR_GetWakeupFlag(LPTMR1))
+    {
+        u32Src |= CLK_WKSRC_LPTMR1;
+        LPTMR_ClearWakeupFlag(LPTMR1);
+    }
+
+    u32LpuartSts = LPUART0->WKSTS;
+
+    if (u32LpuartSts)
+    {
+        u32Src |= CLK_WKSRC_LPUART0;
+        LPUART0->WKSTS = u32LpuartSts;
+        LPUART0->INTSTS = LPUART_INTSTS_WKIF_Msk;
+    }
+
+    return u32Src;
+}
+
+/**
+  * @brief      Initialize wake-up source manager
+  * @param[in]  pfnGetTick  Free-running tick function used to measure time spent in Power-down mode.
+  *                         It could be NULL if sleep time measurement is not required.
+  * @return     None
+  * @details    This function clears the wake-up statistics and pending wake-up flags of all managed sources.
+  * @note       The counter behind pfnGetTick must keep running in the selected Power-down mode.
+  */
+void CLK_WKSrcInit(CLK_WKSRC_TICK_FUNC pfnGetTick)
+{
+    s_pfnWKSrcGetTick = pfnGetTick;
+    s_u32WKSrcEnabled = 0UL;
+    s_u32WKSrcReason = 0UL;
+
+    (void)CLK_WKSrcCollect();
+    CLK_WKSrcClearStat();
+}
+
+/**
+  * @brief      Enable wake-up sources
+  * @param[in]  u32SrcMask  Wake-up source bit mask. It could be combination of
+  *                         - \ref CLK_WKSRC_LPTMR0
+  *                         - \ref CLK_WKSRC_LPTMR1
+  *                         - \ref CLK_WKSRC_LPUART0
+  *                         - \ref CLK_WKSRC_WKIO
+  *                         - \ref CLK_WKSRC_WKTMR
+  *                         - \ref CLK_WKSRC_RTC
+  *                         - \ref CLK_WKSRC_ACMP
+  * @return     None
+  * @details    This function enables the wake-up function of the selected sources. \n
+  *             LPTMR time-out and LPUART incoming data wake-up are enabled.
+  *             Wake-up I/O pins must be configured by \ref CLK_EnableSPDWKPin and the
+  *             wake-up timer interval by \ref CLK_SET_WKTMR_INTERVAL before calling this function.
+  *             The register write-protection function should be disabled before using this function.
+  */
+void CLK_WKSrcEnable(uint32_t u32SrcMask)
+{
+    if (u32SrcMask & CLK_WKSRC_LPTMR0)
+        LPTMR_EnableWakeup(LPTMR0);
+
+    if (u32SrcMask & CLK_WKSRC_LPTMR1)
+        LPTMR_EnableWakeup(LPTMR1);
+
+    if (u32SrcMask & CLK_WKSRC_LPUART0)
+    {
+        LPUART0->WKCTL |= LPUART_WKCTL_WKDATEN_Msk;
+        LPUART0->INTEN |= LPUART_INTEN_WKIEN_Msk;
+    }
+
+    if (u32SrcMask & CLK_WKSRC_WKTMR)
+        CLK_ENABLE_WKTMR();
+
+    if (u32SrcMask & CLK_WKSRC_RTC)
+        CLK_ENABLE_RTCWK();
+
+    if (u32SrcMask & CLK_WKSRC_ACMP)
+        CLK_ENABLE_SPDACMP();
+
+    s_u32WKSrcEnabled |= (u32SrcMask & ~CLK_WKSRC_OTHER);
+}
+
+/**
+  * @brief      Disable wake-up sources
+  * @param[in]  u32SrcMask  Wake-up source bit mask. See \ref CLK_WKSrcEnable.
+  * @return     None
+  * @details    This function disables the wake-up function of the selected sources.
+  *             Wake-up I/O pins stay configured, they are only no longer reported as enabled.
+  *             The register write-protection function should be disabled before using this function.
+  */
+void CLK_WKSrcDisable(uint32_t u32SrcMask)
+{
+    if (u32SrcMask & CLK_WKSRC_LPTMR0)
+        LPTMR_DisableWakeup(LPTMR0);
+
+    if (u32SrcMask & CLK_WKSRC_LPTMR1)
+        LPTMR_DisableWakeup(LPTMR1);
+
+    if (u32SrcMask & CLK_WKSRC_LPUART0)
+    {
+        LPUART0->INTEN &= ~LPUART_INTEN_WKIEN_Msk;
+        LPUART0->WKCTL &= ~LPUART_WKCTL_WKDATEN_Msk;
+    }
+
+    if (u32SrcMask & CLK_WKSRC_WKTMR)
+        CLK_DISABLE_WKTMR();
+
+    if (u32SrcMask & CLK_WKSRC_RTC)
+        CLK_DISABLE_RTCWK();
+
+    if (u32SrcMask & CLK_WKSRC_ACMP)
+        CLK_DISABLE_SPDACMP();
+
+    s_u32WKSrcEnabled &= ~u32SrcMask;
+}
+
+/**
+  * @brief      Enter Power-down mode and record the wake-up reason
+  * @param      None
+  * @return     Wake-up source bit mask. See \ref CLK_WKSRC_LPTMR0 ~ \ref CLK_WKSRC_OTHER.
+  * @details    This function clears stale wake-up flags, enters Power-down mode by \ref CLK_PowerDown,
+  *             then collects the flags of all managed sources and charges the sleep time to every
+  *             source that fired. If no managed source fired, the wake-up is reported as \ref CLK_WKSRC_OTHER. \n
+  *             Interrupts are masked from before Power-down until the flags are latched, so an interrupt
+  *             handler that clears a wake-up flag cannot hide the wake-up source. Pending interrupts are
+  *             served when this function restores the interrupt mask. \n
+  *             The Power-down mode should be selected by \ref CLK_SetPowerDownMode and
+  *             the register write-protection function should be disabled before using this function.
+  */
+uint32_t CLK_WKSrcPowerDown(void)
+{
+    uint32_t u32Start = 0UL, u32Ticks = 0UL, u32Src, u32Primask, i;
+
+    /* WFI still wakes up on a pending interrupt while PRIMASK is set */
+    u32Primask = __get_PRIMASK();
+    __disable_irq();
+
+    (void)CLK_WKSrcCollect();
+
+    if (s_pfnWKSrcGetTick != NULL)
+        u32Start = s_pfnWKSrcGetTick();
+
+    CLK_PowerDown();
+
+    if (s_pfnWKSrcGetTick != NULL)
+        u32Ticks = s_pfnWKSrcGetTick() - u32Start;
+
+    u32Src = CLK_WKSrcCollect();
+
+    __set_PRIMASK(u32Primask);
+
+    if (u32Src == 0UL)
+        u32Src = CLK_WKSRC_OTHER;
+
+    for (i = 0UL; i < CLK_WKSRC_CNT; i++)
+    {
+        if (u32Src & (1UL << i))
+        {
+            s_asWKSrcStat[i].u32WakeCnt++;
+            s_asWKSrcStat[i].u32LastTicks = u32Ticks;
+            s_asWKSrcStat[i].u64TotalTicks += u32Ticks;
+
+            if (u32Ticks > s_asWKSrcStat[i].u32MaxTicks)
+                s_asWKSrcStat[i].u32MaxTicks = u32Ticks;
+        }
+    }
+
+    s_u32WKSrcReason = u32Src;
+
+    return u32Src;
+}
+
+/**
+  * @brief      Get the wake-up reason of the latest Power-down
+  * @param      None
+  * @return     Wake-up source bit mask recorded by the latest \ref CLK_WKSrcPowerDown call.
+  */
+uint32_t CLK_WKSrcGetReason(void)
+{
+    return s_u32WKSrcReason;
+}
+
+/**
+  * @brief      Get wake-up statistics of a wake-up source
+  * @param[in]  u32Src  Single wake-up source. It could be \ref CLK_WKSRC_LPTMR0 ~ \ref CLK_WKSRC_OTHER.
+  * @param[out] psStat  Statistics of the selected source.
+  * @retval     0       Success
+  * @retval     -1      u32Src is not a single managed wake-up source or psStat is NULL
+  */
+int32_t CLK_WKSrcGetStat(uint32_t u32Src, S_CLK_WKSRC_STAT_T *psStat)
+{
+    uint32_t i;
+
+    if ((psStat == NULL) || (u32Src == 0UL) || (u32Src & (u32Src - 1UL)))
+        return -1;
+
+    for (i = 0UL; i < CLK_WKSRC_CNT; i++)
+    {
+        if (u32Src == (1UL << i))
+        {
+            *psStat = s_asWKSrcStat[i];
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+/**
+  * @brief      Clear wake-up statistics of all wake-up sources
+  * @param      None
+  * @return     None
+  */
+void CLK_WKSrcClearStat(void)
+{
+    uint32_t i;
+
+    for (i = 0UL; i < CLK_WKSRC_CNT; i++)
+    {
+        s_asWKSrcStat[i].u32WakeCnt = 0UL;
+        s_asWKSrcStat[i].u32LastTicks = 0UL;
+        s_asWKSrcStat[i].u32MaxTicks = 0UL;
+        s_asWKSrcStat[i].u64TotalTicks = 0ULL;
+    }
+}
 
 /*@}*/ /* end of group CLK_EXPORTED_FUNCTIONS */
 
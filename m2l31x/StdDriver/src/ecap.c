@@ -108,6 +108,202 @@ void ECAP_DisableINT(ECAP_T* ecap, uint32_t u32Mask)
     }
 }
 
+/** @cond HIDDEN_SYMBOLS */
+#define ECAP_RING_PREV      (0x1UL)     /* u32PrevTs is valid */
+#define ECAP_RING_RISE      (0x2UL)     /* u32PrevRise is valid */
+#define ECAP_RING_HIGH      (0x4UL)     /* Last processed edge was rising */
+#define ECAP_RING_BOTH      (0x8UL)     /* Both edges are captured */
+/** @endcond HIDDEN_SYMBOLS */
+
+/**
+  * @brief Initialize capture service
+  * @param[in] psCap     Capture service state
+  * @param[in] ecap      Specify ECAP port, already opened with a free running counter
+  * @param[in] u32ChMask Bit n enables channel ECAP_ICn
+  * @return None
+  * @details Every captured edge is stored with its input level into the channel ring by
+  *          ECAP_CaptureIRQHandler(), which must be called from the ECAP IRQ handler.
+  *          ECAP has no PDMA request, so the handler is kept short and the arithmetic is left to
+  *          ECAP_CaptureMeasure(). Counter reload and compare clear must stay disabled.
+  */
+void ECAP_CaptureInit(S_ECAP_CAPTURE_T *psCap, ECAP_T *ecap, uint32_t u32ChMask)
+{
+    uint32_t i;
+
+    psCap->ecap = ecap;
+    psCap->u32Ovf = 0UL;
+    for(i = 0UL; i < 3UL; i++)
+    {
+        psCap->asRing[i].u32Head = 0UL;
+        psCap->asRing[i].u32Tail = 0UL;
+        psCap->asRing[i].u32Lost = 0UL;
+        psCap->asRing[i].u32Flags = 0UL;
+    }
+
+    ecap->STATUS = ECAP_STATUS_CAPTF0_Msk | ECAP_STATUS_CAPTF1_Msk | ECAP_STATUS_CAPTF2_Msk | ECAP_STATUS_CAPOVF_Msk;
+    ECAP_EnableINT(ecap, ((u32ChMask & 0x7UL) << ECAP_CTL0_CAPIEN0_Pos) | ECAP_CTL0_OVIEN_Msk);
+}
+
+/**
+  * @brief Capture service interrupt handler
+  * @param[in] psCap     Capture service state
+  * @return None
+  * @details Extends each hold value to 32 bits with the overflow count. A capture taken in the first
+  *          half of the counter range while an overflow is still pending belongs after that overflow.
+  *          The level after the edge follows from the edge selection of the channel; the input is only
+  *          sampled when both edges are captured, so a short pulse cannot mislabel a single-edge capture.
+  */
+void ECAP_CaptureIRQHandler(S_ECAP_CAPTURE_T *psCap)
+{
+    ECAP_T *ecap = psCap->ecap;
+    S_ECAP_RING_T *psRing;
+    uint32_t u32Sts, u32Ovf, u32Hold, u32Head, u32Idx, u32Edge, u32High, i;
+
+    u32Sts = ecap->STATUS;
+    u32Edge = ecap->CTL1;
+    u32Ovf = psCap->u32Ovf << 24;
+
+    if(u32Sts & ECAP_STATUS_CAPOVF_Msk)
+    {
+        ecap->STATUS = ECAP_STATUS_CAPOVF_Msk;
+        psCap->u32Ovf++;
+    }
+
+    for(i = 0UL; i < 3UL; i++)
+    {
+        if((u32Sts & (ECAP_STATUS_CAPTF0_Msk << i)) == 0UL)
+        {
+            continue;
+        }
+
+        u32Hold = ECAP_GET_CNT_HOLD_VALUE(ecap, i) & ECAP_CNT_CNT_Msk;
+        ecap->STATUS = ECAP_STATUS_CAPTF0_Msk << i;
+
+        if((u32Sts & ECAP_STATUS_CAPOVF_Msk) && (u32Hold < 0x800000UL))
+        {
+            u32Hold += 0x1000000UL;
+        }
+
+        psRing = &psCap->asRing[i];
+        u32Head = psRing->u32Head;
+        if((u32Head - psRing->u32Tail) >= ECAP_RING_SIZE)
+        {
+            psRing->u32Lost++;
+            continue;
+        }
+
+        switch((u32Edge >> (i << 1)) & ECAP_CTL1_EDGESEL0_Msk)
+        {
+            case ECAP_RISING_EDGE:
+                u32High = 1UL;
+                break;
+            case ECAP_FALLING_EDGE:
+                u32High = 0UL;
+                break;
+            default:
+                u32High = u32Sts & (ECAP_STATUS_CAP0_Msk << i);
+                break;
+        }
+
+        u32Idx = u32Head & (ECAP_RING_SIZE - 1UL);
+        psRing->au32Ts[u32Idx] = u32Ovf + u32Hold;
+        if(u32High)
+            psRing->u32Level |= (1UL << u32Idx);
+        else
+            psRing->u32Level &= ~(1UL << u32Idx);
+        psRing->u32Head = u32Head + 1UL;
+    }
+}
+
+/**
+  * @brief Measure frequency and duty from captured edges
+  * @param[in]  psCap    Capture service state
+  * @param[in]  u32Ch    ECAP_IC0, ECAP_IC1 or ECAP_IC2
+  * @param[in]  u32Clk   ECAP counter clock in Hz
+  * @param[out] psMeas   Result over the edges consumed by this call
+  * @return Number of edges consumed
+  * @details Periods are measured rising edge to rising edge, or falling edge to falling edge when only
+  *          falling edges are captured. With rising and falling edge capture the duty is the high time
+  *          over the same periods; two edges with the same level mean an edge was missed, and the open
+  *          period is discarded. The last edge is kept so consecutive calls measure a continuous signal.
+  */
+uint32_t ECAP_CaptureMeasure(S_ECAP_CAPTURE_T *psCap, uint32_t u32Ch, uint32_t u32Clk, S_ECAP_MEAS_T *psMeas)
+{
+    S_ECAP_RING_T *psRing = &psCap->asRing[u32Ch];
+    uint32_t u32Tail = psRing->u32Tail, u32Head = psRing->u32Head;
+    uint32_t u32Flags = psRing->u32Flags, u32Level = psRing->u32Level;
+    uint32_t u32Ts, u32Idx, u32Rise, u32Edges = 0UL, u32Periods = 0UL;
+    uint64_t u64Span = 0ULL, u64High = 0ULL;
+
+    /* Levels are only meaningful with both edges; otherwise every edge starts a period */
+    if(((psCap->ecap->CTL1 >> (u32Ch << 1)) & ECAP_CTL1_EDGESEL0_Msk) == ECAP_RISING_FALLING_EDGE)
+        u32Flags |= ECAP_RING_BOTH;
+    else
+        u32Flags &= ~ECAP_RING_BOTH;
+
+    while(u32Tail != u32Head)
+    {
+        u32Idx = u32Tail & (ECAP_RING_SIZE - 1UL);
+        u32Ts = psRing->au32Ts[u32Idx];
+        u32Rise = (u32Flags & ECAP_RING_BOTH) ? ((u32Level >> u32Idx) & 1UL) : 1UL;
+        u32Tail++;
+        u32Edges++;
+
+        if((u32Flags & (ECAP_RING_BOTH | ECAP_RING_PREV)) == (ECAP_RING_BOTH | ECAP_RING_PREV) &&
+                (u32Rise == ((u32Flags & ECAP_RING_HIGH) ? 1UL : 0UL)))
+        {
+            /* Missed edge, restart at this one */
+            u32Flags &= ~ECAP_RING_RISE;
+            psRing->u32PendHigh = 0UL;
+        }
+
+        if(u32Rise)
+        {
+            if(u32Flags & ECAP_RING_RISE)
+            {
+                u64Span += (uint32_t)(u32Ts - psRing->u32PrevRise);
+                u64High += psRing->u32PendHigh;
+                u32Periods++;
+            }
+            psRing->u32PrevRise = u32Ts;
+            psRing->u32PendHigh = 0UL;
+            u32Flags |= ECAP_RING_RISE | ECAP_RING_HIGH;
+        }
+        else
+        {
+            if(u32Flags & ECAP_RING_RISE)
+            {
+                psRing->u32PendHigh = u32Ts - psRing->u32PrevRise;
+            }
+            u32Flags &= ~ECAP_RING_HIGH;
+        }
+
+        psRing->u32PrevTs = u32Ts;
+        u32Flags |= ECAP_RING_PREV;
+    }
+
+    psRing->u32Tail = u32Tail;
+    psRing->u32Flags = u32Flags;
+
+    psMeas->u32Edges = u32Edges;
+    psMeas->u32Periods = u32Periods;
+    if((u32Periods != 0UL) && (u64Span != 0ULL))
+    {
+        psMeas->u32Period = (uint32_t)(u64Span / u32Periods);
+        psMeas->u32FreqMilliHz = (uint32_t)(((uint64_t)u32Clk * 1000ULL * u32Periods) / u64Span);
+        psMeas->u32Duty = (u32Flags & ECAP_RING_BOTH) ? (uint32_t)((u64High * 1000ULL) / u64Span) : ECAP_DUTY_UNKNOWN;
+    }
+    else
+    {
+        psMeas->u32Period = 0UL;
+        psMeas->u32FreqMilliHz = 0UL;
+        psMeas->u32Duty = ECAP_DUTY_UNKNOWN;
+    }
+
+    return u32Edges;
+}
+
+
 /*@}*/ /* end of group ECAP_EXPORTED_FUNCTIONS */
 
 /*@}*/ /* end of group ECAP_Driver */
@@ -140,6 +140,164 @@ void EQEI_Stop(EQEI_T* eqei)
 }
 
 
+/** @cond HIDDEN_SYMBOLS */
+static int32_t EQEI_EncoderSat(int64_t i64Val)
+{
+    if(i64Val > INT32_MAX)
+        return INT32_MAX;
+    if(i64Val < INT32_MIN)
+        return INT32_MIN;
+    return (int32_t)i64Val;
+}
+/** @endcond HIDDEN_SYMBOLS */
+
+/**
+  * @brief      Initialize encoder estimator
+  * @param[in]  psEnc        Estimator state
+  * @param[in]  eqei         The pointer of the EQEI module, already opened and started
+  * @param[in]  ecap         The pointer of the ECAP module, already opened with its counter running
+  * @param[in]  u32EcapCh    ECAP channel capturing an encoder phase. ECAP_IC0, ECAP_IC1 or ECAP_IC2
+  * @param[in]  u32EcapClk   ECAP counter clock in Hz
+  * @param[in]  u32UpdateHz  Rate at which EQEI_EncoderUpdate() is called
+  * @param[in]  u32CntPerCap EQEI counts between two captured edges, e.g. 2 for X4 mode capturing both edges of phase A
+  * @return     None
+  * @details    The ECAP channel should take its input from the EQEI phase signal
+  *             (\ref ECAP_CAP_INPUT_SRC_FROM_CH) so counts and time stamps refer to the same edges.
+  *             The ECAP counter must run free over its full 24-bit range.
+  */
+void EQEI_EncoderInit(S_EQEI_ENC_T *psEnc, EQEI_T *eqei, ECAP_T *ecap, uint32_t u32EcapCh, uint32_t u32EcapClk, uint32_t u32UpdateHz, uint32_t u32CntPerCap)
+{
+    psEnc->eqei = eqei;
+    psEnc->ecap = ecap;
+    psEnc->u32EcapCh = u32EcapCh;
+    psEnc->u32EcapClk = u32EcapClk;
+    psEnc->u32UpdateHz = u32UpdateHz;
+    psEnc->u32CntPerCap = (u32CntPerCap == 0UL) ? 1UL : u32CntPerCap;
+    /* 0 when the counter uses the full 32-bit range */
+    psEnc->u32Range = (eqei->CNTMAX == 0UL) ? 0UL : (eqei->CNTMAX + 1UL);
+    psEnc->u32LastCnt = EQEI_GET_CNT_VALUE(eqei);
+    psEnc->u32LastCap = 0UL;
+    psEnc->u32HaveCap = 0UL;
+    psEnc->u32IdleTicks = 0UL;
+    psEnc->i32HalfCntSinceCap = 1;
+    psEnc->i32Pos = 0;
+    psEnc->i32Vel = 0;
+    psEnc->i32Acc = 0;
+    psEnc->u32Method = EQEI_ENC_METHOD_STOP;
+
+    ECAP_CLR_CAPTURE_FLAG(ecap, ECAP_STATUS_CAPTF0_Msk << u32EcapCh);
+}
+
+/**
+  * @brief      Update encoder estimator
+  * @param[in]  psEnc        Estimator state
+  * @return     None
+  * @details    Call at a fixed rate, typically from a timer interrupt. Position is unwrapped from the EQEI
+  *             counter. At high speed velocity is the count difference over the update period (M-method).
+  *             At low speed it is the whole number of captured edge intervals divided by the ECAP time
+  *             between the last two captures (T-method). The intervals are counted from the position of
+  *             the captured edges, which is tracked through every capture, so several edges per update
+  *             period and a change of direction are counted exactly. When no edge arrives, the estimate decays to the highest speed
+  *             still consistent with the elapsed time, and is 0 once the ECAP counter range is exceeded.
+  *             The two methods switch with hysteresis, \ref EQEI_ENC_M_ENTER_CNT and
+  *             \ref EQEI_ENC_M_EXIT_CNT.
+  */
+void EQEI_EncoderUpdate(S_EQEI_ENC_T *psEnc)
+{
+    uint32_t u32Cnt, u32Cap, u32Period, u32Abs;
+    int32_t i32Delta, i32Edges, i32Half, i32Vel;
+    int64_t i64Bound;
+
+    /* Position */
+    u32Cnt = EQEI_GET_CNT_VALUE(psEnc->eqei);
+    i32Delta = (int32_t)(u32Cnt - psEnc->u32LastCnt);
+    if(psEnc->u32Range != 0UL)
+    {
+        /* Counter wraps at CNTMAX; take the shorter way round */
+        if(i32Delta > (int32_t)(psEnc->u32Range / 2UL))
+            i32Delta -= (int32_t)psEnc->u32Range;
+        else if(i32Delta < -(int32_t)(psEnc->u32Range / 2UL))
+            i32Delta += (int32_t)psEnc->u32Range;
+    }
+    psEnc->u32LastCnt = u32Cnt;
+    psEnc->i32Pos += i32Delta;
+    psEnc->i32HalfCntSinceCap += 2 * i32Delta;
+
+    u32Abs = (uint32_t)((i32Delta < 0) ? -i32Delta : i32Delta);
+    i32Vel = psEnc->i32Vel;
+
+    /* Method selection with hysteresis */
+    if(u32Abs >= (uint32_t)EQEI_ENC_M_ENTER_CNT)
+        psEnc->u32Method = EQEI_ENC_METHOD_M;
+    else if((psEnc->u32Method == EQEI_ENC_METHOD_M) && (u32Abs < (uint32_t)EQEI_ENC_M_EXIT_CNT))
+        psEnc->u32Method = EQEI_ENC_METHOD_T;
+
+    if(ECAP_GET_CAPTURE_FLAG(psEnc->ecap, ECAP_STATUS_CAPTF0_Msk << psEnc->u32EcapCh))
+    {
+        u32Cap = ECAP_GET_CNT_HOLD_VALUE(psEnc->ecap, psEnc->u32EcapCh) & EQEI_ENC_ECAP_CNT_MSK;
+        ECAP_CLR_CAPTURE_FLAG(psEnc->ecap, ECAP_STATUS_CAPTF0_Msk << psEnc->u32EcapCh);
+
+        /* The position from the last captured edge, in half counts as an edge lies between two counts, is
+           the whole intervals to the new edge plus less than one interval after it */
+        i32Half = (int32_t)(psEnc->u32CntPerCap * 2UL);
+        if(psEnc->i32HalfCntSinceCap > 0)
+            i32Edges = (psEnc->i32HalfCntSinceCap - 1) / i32Half;
+        else
+            i32Edges = -((-psEnc->i32HalfCntSinceCap - 1) / i32Half);
+
+        if(psEnc->u32Method != EQEI_ENC_METHOD_M)
+        {
+            if(psEnc->u32HaveCap)
+            {
+                u32Period = (u32Cap - psEnc->u32LastCap) & EQEI_ENC_ECAP_CNT_MSK;
+                if((u32Period != 0UL) && (i32Edges != 0))
+                {
+                    i32Vel = EQEI_EncoderSat(((int64_t)i32Edges * psEnc->u32CntPerCap * psEnc->u32EcapClk * 256) / u32Period);
+                }
+            }
+            psEnc->u32Method = EQEI_ENC_METHOD_T;
+        }
+
+        /* Keep the position after the new edge. When the edge was the only count of this period, the
+           position is half a count past it; this also sets the reference after a stand still. */
+        if((u32Abs == 1UL) || (psEnc->u32HaveCap == 0UL))
+            psEnc->i32HalfCntSinceCap = (i32Delta < 0) ? -1 : 1;
+        else
+            psEnc->i32HalfCntSinceCap -= i32Edges * i32Half;
+
+        psEnc->u32LastCap = u32Cap;
+        psEnc->u32HaveCap = 1UL;
+        psEnc->u32IdleTicks = 0UL;
+    }
+    else if(psEnc->u32HaveCap)
+    {
+        psEnc->u32IdleTicks += psEnc->u32EcapClk / psEnc->u32UpdateHz;
+        if(psEnc->u32IdleTicks > EQEI_ENC_ECAP_CNT_MSK)
+        {
+            /* Stand still: the next capture cannot be measured against the last one */
+            psEnc->u32HaveCap = 0UL;
+            psEnc->u32Method = EQEI_ENC_METHOD_STOP;
+            i32Vel = 0;
+        }
+        else if(psEnc->u32Method != EQEI_ENC_METHOD_M)
+        {
+            /* No edge yet, so the speed is below one interval per idle time */
+            i64Bound = ((int64_t)psEnc->u32CntPerCap * psEnc->u32EcapClk * 256) / psEnc->u32IdleTicks;
+            if(i32Vel > i64Bound)
+                i32Vel = (int32_t)i64Bound;
+            else if(i32Vel < -i64Bound)
+                i32Vel = (int32_t)(-i64Bound);
+        }
+    }
+
+    if(psEnc->u32Method == EQEI_ENC_METHOD_M)
+        i32Vel = EQEI_EncoderSat((int64_t)i32Delta * psEnc->u32UpdateHz * 256);
+
+    psEnc->i32Acc = EQEI_EncoderSat(((int64_t)i32Vel - psEnc->i32Vel) * psEnc->u32UpdateHz);
+    psEnc->i32Vel = i32Vel;
+}
+
+
 /*@}*/ /* end of group EQEI_EXPORTED_FUNCTIONS */
 
 /*@}*/ /* end of group EQEI_Driver */
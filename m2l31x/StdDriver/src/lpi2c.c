@@ -502,6 +502,7 @@ uint8_t LPI2C_WriteByte(LPI2C_T *lpi2c, uint8_t u8SlaveAddr, uint8_t data)
     while(u8Xfering && (u8Err == 0u))
     {
         u32TimeOutCount = SystemCoreClock;
+        NVT_WAIT_BEGIN(WAIT_SITE_LPI2C);
         LPI2C_WAIT_READY(lpi2c)
         {
             u32TimeOutCount--;
@@ -511,6 +512,7 @@ uint8_t LPI2C_WriteByte(LPI2C_T *lpi2c, uint8_t u8SlaveAddr, uint8_t data)
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_LPI2C);
 
         switch(LPI2C_GET_STATUS(lpi2c))
         {
@@ -568,6 +570,7 @@ uint32_t LPI2C_WriteMultiBytes(LPI2C_T *lpi2c, uint8_t u8SlaveAddr, uint8_t data
     while(u8Xfering && (u8Err == 0u))
     {
         u32TimeOutCount = SystemCoreClock;
+        NVT_WAIT_BEGIN(WAIT_SITE_LPI2C);
         LPI2C_WAIT_READY(lpi2c)
         {
             u32TimeOutCount--;
@@ -577,6 +580,7 @@ uint32_t LPI2C_WriteMultiBytes(LPI2C_T *lpi2c, uint8_t u8SlaveAddr, uint8_t data
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_LPI2C);
 
         switch(LPI2C_GET_STATUS(lpi2c))
         {
@@ -640,6 +644,7 @@ uint8_t LPI2C_WriteByteOneReg(LPI2C_T *lpi2c, uint8_t u8SlaveAddr, uint8_t u8Dat
     while(u8Xfering && (u8Err == 0u))
     {
         u32TimeOutCount = SystemCoreClock;
+        NVT_WAIT_BEGIN(WAIT_SITE_LPI2C);
         LPI2C_WAIT_READY(lpi2c)
         {
             u32TimeOutCount--;
@@ -649,6 +654,7 @@ uint8_t LPI2C_WriteByteOneReg(LPI2C_T *lpi2c, uint8_t u8SlaveAddr, uint8_t u8Dat
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_LPI2C);
 
         switch(LPI2C_GET_STATUS(lpi2c))
         {
@@ -716,6 +722,7 @@ uint32_t LPI2C_WriteMultiBytesOneReg(LPI2C_T *lpi2c, uint8_t u8SlaveAddr, uint8_
     while(u8Xfering && (u8Err == 0u))
     {
         u32TimeOutCount = SystemCoreClock;
+        NVT_WAIT_BEGIN(WAIT_SITE_LPI2C);
         LPI2C_WAIT_READY(lpi2c)
         {
             u32TimeOutCount--;
@@ -725,6 +732,7 @@ uint32_t LPI2C_WriteMultiBytesOneReg(LPI2C_T *lpi2c, uint8_t u8SlaveAddr, uint8_
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_LPI2C);
 
         switch(LPI2C_GET_STATUS(lpi2c))
         {
@@ -791,6 +799,7 @@ uint8_t LPI2C_WriteByteTwoRegs(LPI2C_T *lpi2c, uint8_t u8SlaveAddr, uint16_t u16
     while(u8Xfering && (u8Err == 0u))
     {
         u32TimeOutCount = SystemCoreClock;
+        NVT_WAIT_BEGIN(WAIT_SITE_LPI2C);
         LPI2C_WAIT_READY(lpi2c)
         {
             u32TimeOutCount--;
@@ -800,6 +809,7 @@ uint8_t LPI2C_WriteByteTwoRegs(LPI2C_T *lpi2c, uint8_t u8SlaveAddr, uint16_t u16
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_LPI2C);
 
         switch(LPI2C_GET_STATUS(lpi2c))
         {
@@ -872,6 +882,7 @@ uint32_t LPI2C_WriteMultiBytesTwoRegs(LPI2C_T *lpi2c, uint8_t u8SlaveAddr, uint1
     while(u8Xfering && (u8Err == 0u))
     {
         u32TimeOutCount = SystemCoreClock;
+        NVT_WAIT_BEGIN(WAIT_SITE_LPI2C);
         LPI2C_WAIT_READY(lpi2c)
         {
             u32TimeOutCount--;
@@ -881,6 +892,7 @@ uint32_t LPI2C_WriteMultiBytesTwoRegs(LPI2C_T *lpi2c, uint8_t u8SlaveAddr, uint1
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_LPI2C);
 
         switch(LPI2C_GET_STATUS(lpi2c))
         {
@@ -946,6 +958,7 @@ uint8_t LPI2C_ReadByte(LPI2C_T *lpi2c, uint8_t u8SlaveAddr)
     while(u8Xfering && (u8Err == 0u))
     {
         u32TimeOutCount = SystemCoreClock;
+        NVT_WAIT_BEGIN(WAIT_SITE_LPI2C);
         LPI2C_WAIT_READY(lpi2c)
         {
             u32TimeOutCount--;
@@ -955,6 +968,7 @@ uint8_t LPI2C_ReadByte(LPI2C_T *lpi2c, uint8_t u8SlaveAddr)
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_LPI2C);
 
         switch(LPI2C_GET_STATUS(lpi2c))
         {
@@ -1017,6 +1031,7 @@ uint32_t LPI2C_ReadMultiBytes(LPI2C_T *lpi2c, uint8_t u8SlaveAddr, uint8_t rdata
     while(u8Xfering && (u8Err == 0u))
     {
         u32TimeOutCount = SystemCoreClock;
+        NVT_WAIT_BEGIN(WAIT_SITE_LPI2C);
         LPI2C_WAIT_READY(lpi2c)
         {
             u32TimeOutCount--;
@@ -1026,6 +1041,7 @@ uint32_t LPI2C_ReadMultiBytes(LPI2C_T *lpi2c, uint8_t u8SlaveAddr, uint8_t rdata
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_LPI2C);
 
         switch(LPI2C_GET_STATUS(lpi2c))
         {
@@ -1093,6 +1109,7 @@ uint8_t LPI2C_ReadByteOneReg(LPI2C_T *lpi2c, uint8_t u8SlaveAddr, uint8_t u8Data
     while(u8Xfering && (u8Err == 0u))
     {
         u32TimeOutCount = SystemCoreClock;
+        NVT_WAIT_BEGIN(WAIT_SITE_LPI2C);
         LPI2C_WAIT_READY(lpi2c)
         {
             u32TimeOutCount--;
@@ -1102,6 +1119,7 @@ uint8_t LPI2C_ReadByteOneReg(LPI2C_T *lpi2c, uint8_t u8SlaveAddr, uint8_t u8Data
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_LPI2C);
 
         switch(LPI2C_GET_STATUS(lpi2c))
         {
@@ -1179,6 +1197,7 @@ uint32_t LPI2C_ReadMultiBytesOneReg(LPI2C_T *lpi2c, uint8_t u8SlaveAddr, uint8_t
     while(u8Xfering && (u8Err == 0u))
     {
         u32TimeOutCount = SystemCoreClock;
+        NVT_WAIT_BEGIN(WAIT_SITE_LPI2C);
         LPI2C_WAIT_READY(lpi2c)
         {
             u32TimeOutCount--;
@@ -1188,6 +1207,7 @@ uint32_t LPI2C_ReadMultiBytesOneReg(LPI2C_T *lpi2c, uint8_t u8SlaveAddr, uint8_t
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_LPI2C);
 
         switch(LPI2C_GET_STATUS(lpi2c))
         {
@@ -1269,6 +1289,7 @@ uint8_t LPI2C_ReadByteTwoRegs(LPI2C_T *lpi2c, uint8_t u8SlaveAddr, uint16_t u16D
     while(u8Xfering && (u8Err == 0u))
     {
         u32TimeOutCount = SystemCoreClock;
+        NVT_WAIT_BEGIN(WAIT_SITE_LPI2C);
         LPI2C_WAIT_READY(lpi2c)
         {
             u32TimeOutCount--;
@@ -1278,6 +1299,7 @@ uint8_t LPI2C_ReadByteTwoRegs(LPI2C_T *lpi2c, uint8_t u8SlaveAddr, uint16_t u16D
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_LPI2C);
 
         switch(LPI2C_GET_STATUS(lpi2c))
         {
@@ -1363,6 +1385,7 @@ uint32_t LPI2C_ReadMultiBytesTwoRegs(LPI2C_T *lpi2c, uint8_t u8SlaveAddr, uint16
     while(u8Xfering && (u8Err == 0u))
     {
         u32TimeOutCount = SystemCoreClock;
+        NVT_WAIT_BEGIN(WAIT_SITE_LPI2C);
         LPI2C_WAIT_READY(lpi2c)
         {
             u32TimeOutCount--;
@@ -1372,6 +1395,7 @@ uint32_t LPI2C_ReadMultiBytesTwoRegs(LPI2C_T *lpi2c, uint8_t u8SlaveAddr, uint16
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_LPI2C);
 
         switch(LPI2C_GET_STATUS(lpi2c))
         {
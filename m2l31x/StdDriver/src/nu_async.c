@@ -0,0 +1,241 @@
+/**************************************************************************//**
+ * @file     nu_async.c
+ * @version  V1.00
+ * @brief    Interrupt driven DMA and CAN queues on the series independent driver interface
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2024 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#include "nu_async.h"
+
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup NU_ASYNC_Driver NU_ASYNC Driver
+  @{
+*/
+
+/** @addtogroup NU_ASYNC_EXPORTED_FUNCTIONS NU_ASYNC Exported Functions
+  @{
+*/
+
+static void NU_DmaChanStart(S_NU_DMA_CHAN_T *psChan, S_NU_DMA_REQ_T *psReq);
+static uint32_t NU_CanTxqPost(S_NU_CAN_TXQ_T *psTxq);
+
+/* Programs and starts a request. PDMA_Trigger only requests memory to memory transfers, the others
+   start on the request of their peripheral. */
+static void NU_DmaChanStart(S_NU_DMA_CHAN_T *psChan, S_NU_DMA_REQ_T *psReq)
+{
+    psReq->i32Status = NU_ASYNC_RUNNING;
+    psChan->psOps->pfnSetTransfer(psChan->pvPort, psChan->u32Ch, &psReq->sXfer);
+    psChan->psOps->pfnEnableInt(psChan->pvPort, psChan->u32Ch, PDMA_INT_TRANS_DONE);
+    psChan->psOps->pfnTrigger(psChan->pvPort, psChan->u32Ch);
+}
+
+/**
+  * @brief      Initialize a DMA channel queue
+  * @param[out] psChan      The channel queue
+  * @param[in]  psOps       DMA operations of the controller, e.g. NU_PDMA_OPS
+  * @param[in]  pvPort      PDMA (or LPPDMA) base address
+  * @param[in]  u32Ch       Channel, opened with psOps->pfnOpen
+  * @return     None
+  */
+void NU_DmaChanInit(S_NU_DMA_CHAN_T *psChan, const S_NU_DMA_OPS_T *psOps, void *pvPort, uint32_t u32Ch)
+{
+    psChan->psOps = psOps;
+    psChan->pvPort = pvPort;
+    psChan->u32Ch = u32Ch;
+    psChan->psHead = NULL;
+    psChan->psTail = NULL;
+    psChan->u32Done = 0UL;
+    psChan->u32Aborts = 0UL;
+}
+
+/**
+  * @brief      Submit a request to a DMA channel queue
+  * @param[in]  psChan      The channel queue
+  * @param[in]  psReq       The request. sXfer, pfnDone and pvUser are set by the caller.
+  * @retval     NU_ASYNC_OK         The request is started or queued
+  * @retval     NU_ASYNC_ERR_PARAM  psReq is NULL
+  * @retval     NU_ASYNC_ERR_BUSY   psReq is already queued or running
+  * @details    The request starts at once when the channel is idle, otherwise when the requests
+  *             before it finished. pfnDone is called from NU_DmaChanIRQHandler() with NU_ASYNC_OK or
+  *             NU_ASYNC_ERR_ABORT. The request must stay valid until then.
+  */
+int32_t NU_DmaChanSubmit(S_NU_DMA_CHAN_T *psChan, S_NU_DMA_REQ_T *psReq)
+{
+    uint32_t u32Primask;
+
+    if (psReq == NULL)
+        return NU_ASYNC_ERR_PARAM;
+
+    u32Primask = __get_PRIMASK();
+    __disable_irq();
+
+    if ((psReq->i32Status == NU_ASYNC_QUEUED) || (psReq->i32Status == NU_ASYNC_RUNNING))
+    {
+        __set_PRIMASK(u32Primask);
+        return NU_ASYNC_ERR_BUSY;
+    }
+
+    psReq->psNext = NULL;
+    psReq->i32Status = NU_ASYNC_QUEUED;
+    if (psChan->psTail == NULL)
+    {
+        psChan->psHead = psReq;
+        psChan->psTail = psReq;
+        NU_DmaChanStart(psChan, psReq);
+    }
+    else
+    {
+        psChan->psTail->psNext = psReq;
+        psChan->psTail = psReq;
+    }
+
+    __set_PRIMASK(u32Primask);
+
+    return NU_ASYNC_OK;
+}
+
+/**
+  * @brief      DMA channel queue interrupt handler
+  * @param[in]  psChan      The channel queue
+  * @return     None
+  * @details    Called from the interrupt handler of the controller for each channel queue on it.
+  *             When the channel finished or aborted, it clears the flags of the channel, starts the
+  *             next request and calls pfnDone of the finished one. An aborted channel is opened
+  *             again before the next request starts.
+  */
+void NU_DmaChanIRQHandler(S_NU_DMA_CHAN_T *psChan)
+{
+    S_NU_DMA_REQ_T *psReq;
+    uint32_t u32Mask = (1UL << psChan->u32Ch);
+    uint32_t u32Abort;
+    int32_t i32Status;
+
+    u32Abort = psChan->psOps->pfnGetAbort(psChan->pvPort) & u32Mask;
+    if ((u32Abort == 0UL) && ((psChan->psOps->pfnGetDone(psChan->pvPort) & u32Mask) == 0UL))
+        return;
+
+    psChan->psOps->pfnClearFlags(psChan->pvPort, u32Mask);
+
+    psReq = psChan->psHead;
+    if (psReq == NULL)
+        return;
+
+    if (u32Abort)
+    {
+        i32Status = NU_ASYNC_ERR_ABORT;
+        psChan->u32Aborts++;
+        psChan->psOps->pfnOpen(psChan->pvPort, u32Mask);
+    }
+    else
+    {
+        i32Status = NU_ASYNC_OK;
+        psChan->u32Done++;
+    }
+
+    /* Start the next request before the callback, which may take a while or submit again */
+    psChan->psHead = psReq->psNext;
+    if (psChan->psHead == NULL)
+        psChan->psTail = NULL;
+    else
+        NU_DmaChanStart(psChan, psChan->psHead);
+
+    psReq->psNext = NULL;
+    psReq->i32Status = i32Status;
+    if (psReq->pfnDone != NULL)
+        psReq->pfnDone(psReq->pvUser, i32Status);
+}
+
+/* Sends the oldest queued frame, returns 1 if the buffer took it */
+static uint32_t NU_CanTxqPost(S_NU_CAN_TXQ_T *psTxq)
+{
+    if (psTxq->psOps->pfnSend(psTxq->pvPort, psTxq->u32Buf, &psTxq->asFrame[psTxq->u32Head & (NU_CAN_TXQ_LEN - 1UL)]) != 0)
+        return 0UL;
+
+    psTxq->u32Head++;
+    psTxq->u32InFlight = 1UL;
+    return 1UL;
+}
+
+/**
+  * @brief      Initialize a CAN transmit queue
+  * @param[out] psTxq       The transmit queue
+  * @param[in]  psOps       CAN operations of the controller, e.g. NU_CANFD_OPS
+  * @param[in]  pvPort      CAN or CANFD base address, opened with psOps->pfnOpen
+  * @param[in]  u32Buf      Message object or Tx buffer used to send
+  * @return     None
+  */
+void NU_CanTxqInit(S_NU_CAN_TXQ_T *psTxq, const S_NU_CAN_OPS_T *psOps, void *pvPort, uint32_t u32Buf)
+{
+    psTxq->psOps = psOps;
+    psTxq->pvPort = pvPort;
+    psTxq->u32Buf = u32Buf;
+    psTxq->u32Head = 0UL;
+    psTxq->u32Tail = 0UL;
+    psTxq->u32InFlight = 0UL;
+    psTxq->u32Sent = 0UL;
+    psTxq->u32Drops = 0UL;
+}
+
+/**
+  * @brief      Send a frame through a CAN transmit queue
+  * @param[in]  psTxq       The transmit queue
+  * @param[in]  psFrame     The frame, copied into the queue
+  * @retval     NU_ASYNC_OK         The frame is in the buffer or queued
+  * @retval     NU_ASYNC_ERR_FULL   The queue is full, the frame was dropped and counted in u32Drops
+  * @details    Frames go to the buffer in the order they were sent. A frame that finds the buffer in
+  *             use waits in the queue for NU_CanTxqIRQHandler().
+  */
+int32_t NU_CanTxqSend(S_NU_CAN_TXQ_T *psTxq, const S_NU_CAN_FRAME_T *psFrame)
+{
+    uint32_t u32Primask;
+
+    u32Primask = __get_PRIMASK();
+    __disable_irq();
+
+    if ((psTxq->u32Tail - psTxq->u32Head) >= NU_CAN_TXQ_LEN)
+    {
+        psTxq->u32Drops++;
+        __set_PRIMASK(u32Primask);
+        return NU_ASYNC_ERR_FULL;
+    }
+
+    psTxq->asFrame[psTxq->u32Tail & (NU_CAN_TXQ_LEN - 1UL)] = *psFrame;
+    psTxq->u32Tail++;
+    if (psTxq->u32InFlight == 0UL)
+        (void)NU_CanTxqPost(psTxq);
+
+    __set_PRIMASK(u32Primask);
+
+    return NU_ASYNC_OK;
+}
+
+/**
+  * @brief      CAN transmit queue interrupt handler
+  * @param[in]  psTxq       The transmit queue
+  * @return     None
+  * @details    Called from the interrupt handler of the controller when the buffer of the queue
+  *             finished a transmission. It counts the frame of the queue as sent and puts the next
+  *             queued frame into the buffer.
+  */
+void NU_CanTxqIRQHandler(S_NU_CAN_TXQ_T *psTxq)
+{
+    if (psTxq->u32InFlight)
+    {
+        psTxq->u32InFlight = 0UL;
+        psTxq->u32Sent++;
+    }
+
+    if (psTxq->u32Tail != psTxq->u32Head)
+        (void)NU_CanTxqPost(psTxq);
+}
+
+/*@}*/ /* end of group NU_ASYNC_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NU_ASYNC_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
@@ -223,7 +223,9 @@ uint32_t RMC_Read(uint32_t u32Addr)
     RMC->ISPADDR = u32Addr;
     RMC->ISPTRG = RMC_ISPTRG_ISPGO_Msk;
     tout = RMC_TIMEOUT_READ;
+    NVT_WAIT_BEGIN(WAIT_SITE_RMC_READ);
     while ((--tout > 0) && (RMC->ISPTRG & RMC_ISPTRG_ISPGO_Msk)) {}
+    NVT_WAIT_END(WAIT_SITE_RMC_READ);
     if (tout == 0)
     {
         g_RMC_i32ErrCode = -1;
@@ -306,7 +308,9 @@ int32_t RMC_Write(uint32_t u32Addr, uint32_t u32Data)
     RMC->ISPTRG = RMC_ISPTRG_ISPGO_Msk;
 
     tout = RMC_TIMEOUT_WRITE;
+    NVT_WAIT_BEGIN(WAIT_SITE_RMC_PROGRAM);
     while ((--tout > 0) && (RMC->ISPTRG & RMC_ISPTRG_ISPGO_Msk)) {}
+    NVT_WAIT_END(WAIT_SITE_RMC_PROGRAM);
     if (tout == 0)
     {
         g_RMC_i32ErrCode = -1;
@@ -325,7 +329,9 @@ int32_t RMC_Write(uint32_t u32Addr, uint32_t u32Data)
     RMC->ISPTRG = RMC_ISPTRG_ISPGO_Msk;
 
     tout = RMC_TIMEOUT_WRITE;
+    NVT_WAIT_BEGIN(WAIT_SITE_RMC_PROGRAM);
     while ((--tout > 0) && (RMC->ISPTRG & RMC_ISPTRG_ISPGO_Msk)) {}
+    NVT_WAIT_END(WAIT_SITE_RMC_PROGRAM);
     if (tout == 0)
     {
         g_RMC_i32ErrCode = -1;
@@ -345,7 +351,9 @@ int32_t RMC_Write(uint32_t u32Addr, uint32_t u32Data)
     RMC->ISPTRG = RMC_ISPTRG_ISPGO_Msk;
 
     tout = RMC_TIMEOUT_WRITE;
+    NVT_WAIT_BEGIN(WAIT_SITE_RMC_PROGRAM);
     while ((--tout > 0) && (RMC->ISPTRG & RMC_ISPTRG_ISPGO_Msk)) {}
+    NVT_WAIT_END(WAIT_SITE_RMC_PROGRAM);
     if (tout == 0)
     {
         g_RMC_i32ErrCode = -1;
@@ -400,7 +408,9 @@ int32_t RMC_MassErase(void)
     RMC->ISPTRG = RMC_ISPTRG_ISPGO_Msk;
 
     tout = 0xFFFFFFFF;
+    NVT_WAIT_BEGIN(WAIT_SITE_RMC_ERASE);
     while ((--tout > 0) && (RMC->ISPTRG & RMC_ISPTRG_ISPGO_Msk)) {}
+    NVT_WAIT_END(WAIT_SITE_RMC_ERASE);
     if (tout == 0)
     {
         g_RMC_i32ErrCode = -1;
@@ -416,6 +426,31 @@ int32_t RMC_MassErase(void)
 
     return ret;
 }
+
+/**
+  * @brief      Erase flash pages, step function of \ref WDT_RunLongOp
+  * @param[in]  pvCtx      Pointer to a uint32_t holding the address of page 0 of the operation
+  * @param[in]  u32Offset  Index of the first page to erase
+  * @param[in]  u32Count   Number of pages to erase
+  * @return     Erase success or not.
+  * @retval     0   Success
+  * @retval     -1  Erase failed
+  * @details    Erases a region page by page so that the watchdogs can be fed between chunks,
+  *             u32Total is the region size / \ref RMC_FLASH_PAGE_SIZE.
+  */
+int32_t RMC_EraseStep(void *pvCtx, uint32_t u32Offset, uint32_t u32Count)
+{
+    uint32_t u32Addr = *(uint32_t *)pvCtx + u32Offset * RMC_FLASH_PAGE_SIZE;
+
+    while(u32Count-- > 0UL)
+    {
+        if(RMC_Erase(u32Addr) != 0)
+            return -1;
+        u32Addr += RMC_FLASH_PAGE_SIZE;
+    }
+    return 0;
+}
+
 /**
   * @brief Execute RMC_ISPCMD_READ command to read User Configuration.
   * @param[out]  u32Config A two-word array.
@@ -511,7 +546,9 @@ uint32_t  RMC_GetChkSum(uint32_t u32addr, uint32_t u32count)
         RMC->ISPTRG  = RMC_ISPTRG_ISPGO_Msk;
 
         tout = RMC_TIMEOUT_CHKSUM;
+        NVT_WAIT_BEGIN(WAIT_SITE_RMC_CHKSUM);
         while ((--tout > 0) && (RMC->ISPSTS & RMC_ISPSTS_ISPBUSY_Msk)) {}
+        NVT_WAIT_END(WAIT_SITE_RMC_CHKSUM);
         if (tout == 0)
         {
             g_RMC_i32ErrCode = -1;
@@ -529,7 +566,9 @@ uint32_t  RMC_GetChkSum(uint32_t u32addr, uint32_t u32count)
         RMC->ISPTRG = RMC_ISPTRG_ISPGO_Msk;
 
         tout = RMC_TIMEOUT_CHKSUM;
+        NVT_WAIT_BEGIN(WAIT_SITE_RMC_CHKSUM);
         while ((--tout > 0) && (RMC->ISPSTS & RMC_ISPSTS_ISPBUSY_Msk)) {}
+        NVT_WAIT_END(WAIT_SITE_RMC_CHKSUM);
         if (tout == 0)
         {
             g_RMC_i32ErrCode = -1;
@@ -574,6 +613,7 @@ uint32_t  RMC_CheckAllOne(uint32_t u32addr, uint32_t u32count)
     RMC->ISPTRG   = RMC_ISPTRG_ISPGO_Msk;
 
     i32TimeOutCnt0 = RMC_TIMEOUT_CHKALLONE;
+    NVT_WAIT_BEGIN(WAIT_SITE_RMC_CHKSUM);
     while(RMC->ISPSTS & RMC_ISPSTS_ISPBUSY_Msk)
     {
         if( i32TimeOutCnt0-- <= 0)
@@ -582,6 +622,7 @@ uint32_t  RMC_CheckAllOne(uint32_t u32addr, uint32_t u32count)
             break;
         }
     }
+    NVT_WAIT_END(WAIT_SITE_RMC_CHKSUM);
 
     if(g_RMC_i32ErrCode == 0)
     {
@@ -593,6 +634,7 @@ uint32_t  RMC_CheckAllOne(uint32_t u32addr, uint32_t u32count)
             RMC->ISPTRG = RMC_ISPTRG_ISPGO_Msk;
 
             i32TimeOutCnt0 = RMC_TIMEOUT_CHKALLONE;
+            NVT_WAIT_BEGIN(WAIT_SITE_RMC_CHKSUM);
             while(RMC->ISPSTS & RMC_ISPSTS_ISPBUSY_Msk)
             {
                 if( i32TimeOutCnt0-- <= 0)
@@ -601,6 +643,7 @@ uint32_t  RMC_CheckAllOne(uint32_t u32addr, uint32_t u32count)
                     break;
                 }
             }
+            NVT_WAIT_END(WAIT_SITE_RMC_CHKSUM);
 
             if( i32TimeOutCnt1-- <= 0)
             {
@@ -648,7 +691,9 @@ int32_t RMC_RemapBank(uint32_t u32BankAddr)
     RMC->ISPTRG = RMC_ISPTRG_ISPGO_Msk;
 
     tout = RMC_TIMEOUT_WRITE;
+    NVT_WAIT_BEGIN(WAIT_SITE_RMC_PROGRAM);
     while ((--tout > 0) && (RMC->ISPTRG & RMC_ISPTRG_ISPGO_Msk)) {}
+    NVT_WAIT_END(WAIT_SITE_RMC_PROGRAM);
     if (tout == 0)
     {
         g_RMC_i32ErrCode = -1;
@@ -502,6 +502,340 @@ uint32_t TK_CheckTKIF(uint8_t u8TKNum)
     return u32Ret;
 }
 
+static S_TK_ENGINE_CFG_T s_sTkCfg;
+static uint32_t s_au32TkBaseline[TK_ENGINE_CH_NUM];    /* Baseline in 24.8 fixed point */
+static uint8_t s_au8TkCcb[TK_ENGINE_CH_NUM];
+static uint8_t s_au8TkDebounce[TK_ENGINE_CH_NUM];
+static uint8_t s_u8TkCcbAll = 0;
+static volatile uint32_t s_u32TkTouchMask = 0;
+
+/**
+  * @brief      Start one scan of the enabled channels and wait until it completes
+  * @param[in]  None
+  * @retval     TK_ENGINE_OK            Scan completed
+  * @retval     TK_ENGINE_ERR_TIMEOUT   Scan did not complete in 1 second
+  */
+int32_t TK_EngineScan(void)
+{
+    uint32_t u32TimeOutCnt = SystemCoreClock;
+
+    TK_CLR_INT_FLAG(TK_INT_SCAN_COMPLETE);
+    TK_START_SCAN();
+
+    while((TK->STA & TK_STA_SCIF_Msk) == 0)
+    {
+        if(--u32TimeOutCnt == 0)
+            return TK_ENGINE_ERR_TIMEOUT;
+    }
+
+    TK_CLR_INT_FLAG(TK_INT_SCAN_COMPLETE);
+
+    return TK_ENGINE_OK;
+}
+
+/**
+  * @brief      Read the raw count of one channel or of scan all after one scan
+  * @param[in]  u32TKNum: Touch key number, or TK_SCANALL_NUM for scan all data.
+  * @param[out] pu32Data: Raw count.
+  * @return     TK_ENGINE_OK or TK_ENGINE_ERR_TIMEOUT
+  */
+static int32_t TK_EngineMeasure(uint32_t u32TKNum, uint32_t *pu32Data)
+{
+    int32_t i32Ret = TK_EngineScan();
+
+    if(u32TKNum == TK_SCANALL_NUM)
+        *pu32Data = TK_GET_SCANALL_SENSE_DATA();
+    else
+        *pu32Data = TK_GET_SENSE_DATA(u32TKNum);
+
+    return i32Ret;
+}
+
+/**
+  * @brief      Write complement capacitor bank data of one channel or of scan all
+  * @param[in]  u32TKNum: Touch key number, or TK_SCANALL_NUM for scan all.
+  * @param[in]  u32CapData: Complement capacitor bank data. The valid value is 0~0xFF.
+  * @return     None
+  */
+static void TK_EngineSetCcb(uint32_t u32TKNum, uint32_t u32CapData)
+{
+    if(u32TKNum == TK_SCANALL_NUM)
+        TK->CCBD4 = (TK->CCBD4 & ~TK_CCBD4_CCBD_ALL_Msk) | (u32CapData << TK_CCBD4_CCBD_ALL_Pos);
+    else
+        TK_SetCompCapBankData(u32TKNum, u32CapData);
+}
+
+/**
+  * @brief      Search the complement capacitor bank data giving the raw count closest to the target
+  * @param[in]  u32TKNum: Touch key number, or TK_SCANALL_NUM for scan all.
+  * @param[in]  u32Target: Target raw count.
+  * @param[out] pu8Ccb: Selected complement capacitor bank data.
+  * @param[out] pu32Data: Raw count measured with the selected data.
+  * @return     TK_ENGINE_OK or TK_ENGINE_ERR_TIMEOUT
+  * @details    The direction of the raw count against the bank data is probed at both ends first,
+  *             then a binary search takes 8 more scans.
+  */
+static int32_t TK_EngineSearchCcb(uint32_t u32TKNum, uint32_t u32Target, uint8_t *pu8Ccb, uint32_t *pu32Data)
+{
+    uint32_t u32Lo, u32Hi, u32Data, u32Ccb = 0, u32Bit, u32Rising;
+
+    TK_EngineSetCcb(u32TKNum, 0x00);
+    if(TK_EngineMeasure(u32TKNum, &u32Lo) != TK_ENGINE_OK)
+        return TK_ENGINE_ERR_TIMEOUT;
+
+    TK_EngineSetCcb(u32TKNum, 0xFF);
+    if(TK_EngineMeasure(u32TKNum, &u32Hi) != TK_ENGINE_OK)
+        return TK_ENGINE_ERR_TIMEOUT;
+
+    u32Rising = (u32Hi >= u32Lo) ? 1 : 0;
+
+    for(u32Bit = 0x80; u32Bit != 0; u32Bit >>= 1)
+    {
+        TK_EngineSetCcb(u32TKNum, u32Ccb | u32Bit);
+        if(TK_EngineMeasure(u32TKNum, &u32Data) != TK_ENGINE_OK)
+            return TK_ENGINE_ERR_TIMEOUT;
+
+        /* Keep the bit while the raw count has not passed the target */
+        if(u32Rising ? (u32Data <= u32Target) : (u32Data >= u32Target))
+            u32Ccb |= u32Bit;
+    }
+
+    TK_EngineSetCcb(u32TKNum, u32Ccb);
+    if(TK_EngineMeasure(u32TKNum, &u32Data) != TK_ENGINE_OK)
+        return TK_ENGINE_ERR_TIMEOUT;
+
+    *pu8Ccb = (uint8_t)u32Ccb;
+    *pu32Data = u32Data;
+
+    return TK_ENGINE_OK;
+}
+
+/**
+  * @brief      Initialize touch key engine
+  * @param[in]  psCfg: Engine configuration.
+  * @retval     TK_ENGINE_OK            Success
+  * @retval     TK_ENGINE_ERR_PARAM     Invalid configuration
+  * @details    This function keeps the configuration and clears baselines and touch states.
+  *             Touch key must be opened and configured by TK_Open() and TK_ConfigSensitivity() first.
+  */
+int32_t TK_EngineInit(const S_TK_ENGINE_CFG_T *psCfg)
+{
+    uint32_t i;
+
+    if((psCfg == NULL) || (psCfg->u32ChanMask >> TK_ENGINE_CH_NUM) ||
+       (psCfg->u8ReleaseTh >= psCfg->u8TouchTh) || (psCfg->u8BaselineShift > 7))
+        return TK_ENGINE_ERR_PARAM;
+
+    s_sTkCfg = *psCfg;
+    if(s_sTkCfg.u8DebounceCnt == 0)
+        s_sTkCfg.u8DebounceCnt = 1;
+
+    for(i = 0; i < TK_ENGINE_CH_NUM; i++)
+    {
+        s_au32TkBaseline[i] = 0;
+        s_au8TkDebounce[i] = 0;
+    }
+    s_u32TkTouchMask = 0;
+
+    return TK_ENGINE_OK;
+}
+
+/**
+  * @brief      Calibrate the capacitor banks of all engine channels
+  * @param[in]  None
+  * @retval     TK_ENGINE_OK            Success
+  * @retval     TK_ENGINE_ERR_TIMEOUT   A calibration scan did not complete
+  * @details    Each channel is scanned alone in single scan mode and its complement capacitor bank is
+  *             searched to bring the raw count to u8CalTarget, which becomes the initial baseline.
+  *             The scan all capacitor bank is searched the same way against u8ScanAllTarget.
+  *             Keys must not be touched while calibrating. The enabled channels, scan mode and scan
+  *             trigger of the caller are restored on return.
+  */
+int32_t TK_EngineCalibrate(void)
+{
+    uint32_t i, u32Data, u32ChanSave, u32TrgSave, u32ScanAllSave;
+    int32_t i32Ret = TK_ENGINE_OK;
+
+    u32ChanSave = (TK->SCANC & 0x1FFFF) | (TK->SCANC1 << 17);
+    u32TrgSave = TK->SCANC & TK_SCANC_TRG_EN_Msk;
+    u32ScanAllSave = TK->REFC & TK_REFC_SCAN_ALL_Msk;
+
+    TK_SetScanMode(TK_SCAN_MODE_SINGLE);
+
+    for(i = 0; i < TK_ENGINE_CH_NUM; i++)
+    {
+        if((s_sTkCfg.u32ChanMask & (1UL << i)) == 0)
+            continue;
+
+        TK_EnableChannel(1UL << i);
+        TK_SetRefCapBankData(i, s_sTkCfg.u8RefCapBank);
+
+        i32Ret = TK_EngineSearchCcb(i, s_sTkCfg.u8CalTarget, &s_au8TkCcb[i], &u32Data);
+        if(i32Ret != TK_ENGINE_OK)
+            break;
+
+        s_au32TkBaseline[i] = u32Data << 8;
+        s_au8TkDebounce[i] = 0;
+    }
+
+    if(i32Ret == TK_ENGINE_OK)
+    {
+        TK_EnableChannel(s_sTkCfg.u32ChanMask);
+        TK_SetScanMode(TK_SCAN_MODE_ALL_KEY);
+        TK->REFCBD4 = (TK->REFCBD4 & ~TK_REFCBD4_CBD_ALL_Msk) | ((uint32_t)s_sTkCfg.u8RefCapBank << TK_REFCBD4_CBD_ALL_Pos);
+
+        i32Ret = TK_EngineSearchCcb(TK_SCANALL_NUM, s_sTkCfg.u8ScanAllTarget, &s_u8TkCcbAll, &u32Data);
+    }
+
+    /* TK_SetScanMode() clears the trigger enable, so put the saved bits back directly */
+    TK->SCANC = (TK->SCANC & ~TK_SCANC_TRG_EN_Msk) | u32TrgSave;
+    TK->REFC = (TK->REFC & ~TK_REFC_SCAN_ALL_Msk) | u32ScanAllSave;
+    TK_EnableChannel(u32ChanSave);
+    s_u32TkTouchMask = 0;
+
+    return i32Ret;
+}
+
+/**
+  * @brief      Feed one raw count to the engine
+  * @param[in]  u32TKNum: Touch key number. The valid value is 0~25.
+  * @param[in]  u32RawData: Raw count of the channel.
+  * @return     Touch state mask of all engine channels after the update.
+  * @details    A channel turns touched after u8DebounceCnt consecutive counts at least u8TouchTh above
+  *             the baseline and released after u8DebounceCnt consecutive counts at most u8ReleaseTh above it.
+  *             The baseline follows the raw count with a 1/2^u8BaselineShift IIR filter only while the
+  *             channel is neither touched nor about to be touched, so slow drift is absorbed but touches are not.
+  */
+uint32_t TK_EngineUpdate(uint32_t u32TKNum, uint32_t u32RawData)
+{
+    int32_t i32Signal, i32Base;
+    uint32_t u32Bit;
+
+    if(u32TKNum >= TK_ENGINE_CH_NUM)
+        return s_u32TkTouchMask;
+
+    u32Bit = 1UL << u32TKNum;
+    i32Base = (int32_t)s_au32TkBaseline[u32TKNum];
+    i32Signal = (int32_t)u32RawData - (i32Base >> 8);
+
+    if(s_u32TkTouchMask & u32Bit)
+    {
+        if(i32Signal <= (int32_t)s_sTkCfg.u8ReleaseTh)
+        {
+            if(++s_au8TkDebounce[u32TKNum] >= s_sTkCfg.u8DebounceCnt)
+            {
+                s_u32TkTouchMask &= ~u32Bit;
+                s_au8TkDebounce[u32TKNum] = 0;
+            }
+        }
+        else
+        {
+            s_au8TkDebounce[u32TKNum] = 0;
+        }
+    }
+    else if(i32Signal >= (int32_t)s_sTkCfg.u8TouchTh)
+    {
+        if(++s_au8TkDebounce[u32TKNum] >= s_sTkCfg.u8DebounceCnt)
+        {
+            s_u32TkTouchMask |= u32Bit;
+            s_au8TkDebounce[u32TKNum] = 0;
+        }
+    }
+    else
+    {
+        s_au8TkDebounce[u32TKNum] = 0;
+        i32Base += (((int32_t)u32RawData << 8) - i32Base) >> s_sTkCfg.u8BaselineShift;
+        s_au32TkBaseline[u32TKNum] = (uint32_t)i32Base;
+    }
+
+    return s_u32TkTouchMask;
+}
+
+/**
+  * @brief      Feed the sensing result data of all engine channels to the engine
+  * @param[in]  None
+  * @return     Touch state mask of all engine channels.
+  * @details    Call this function after a scan completes, e.g. from TK_IRQHandler on scan complete interrupt.
+  */
+uint32_t TK_EngineProcess(void)
+{
+    uint32_t i;
+
+    for(i = 0; i < TK_ENGINE_CH_NUM; i++)
+    {
+        if(s_sTkCfg.u32ChanMask & (1UL << i))
+            (void)TK_EngineUpdate(i, TK_GET_SENSE_DATA(i));
+    }
+
+    return s_u32TkTouchMask;
+}
+
+/**
+  * @brief      Get touch state mask
+  * @param[in]  None
+  * @return     Touch state mask. Bit 0 is touch key 0.
+  */
+uint32_t TK_EngineGetTouchMask(void)
+{
+    return s_u32TkTouchMask;
+}
+
+/**
+  * @brief      Get the tracked baseline of one channel
+  * @param[in]  u32TKNum: Touch key number. The valid value is 0~25.
+  * @return     Baseline raw count.
+  */
+uint32_t TK_EngineGetBaseline(uint32_t u32TKNum)
+{
+    return (u32TKNum < TK_ENGINE_CH_NUM) ? (s_au32TkBaseline[u32TKNum] >> 8) : 0;
+}
+
+/**
+  * @brief      Get the calibrated complement capacitor bank data of one channel
+  * @param[in]  u32TKNum: Touch key number. The valid value is 0~25, or TK_SCANALL_NUM for scan all.
+  * @return     Complement capacitor bank data.
+  */
+uint32_t TK_EngineGetCompCapBankData(uint32_t u32TKNum)
+{
+    if(u32TKNum == TK_SCANALL_NUM)
+        return s_u8TkCcbAll;
+
+    return (u32TKNum < TK_ENGINE_CH_NUM) ? s_au8TkCcb[u32TKNum] : 0;
+}
+
+/**
+  * @brief      Switch the engine channels to low power scan all mode
+  * @param[in]  None
+  * @return     None
+  * @details    All engine channels are measured together as one key with the calibrated scan all capacitor
+  *             bank, so each periodic scan is one short conversion. Any touch above u8ScanAllTh raises the
+  *             threshold interrupt to wake up the system, which should then call TK_EngineExitScanAll().
+  */
+void TK_EngineEnterScanAll(void)
+{
+    TK_EnableChannel(s_sTkCfg.u32ChanMask);
+    TK_EnableScanAll(s_sTkCfg.u8RefCapBank, s_u8TkCcbAll, s_sTkCfg.u8ScanAllTh);
+}
+
+/**
+  * @brief      Return from low power scan all mode to per channel scan
+  * @param[in]  None
+  * @return     None
+  * @details    The calibrated complement capacitor banks are restored for every engine channel.
+  */
+void TK_EngineExitScanAll(void)
+{
+    uint32_t i;
+
+    TK_DisableScanAll();
+
+    for(i = 0; i < TK_ENGINE_CH_NUM; i++)
+    {
+        if(s_sTkCfg.u32ChanMask & (1UL << i))
+            TK_SetCompCapBankData(i, s_au8TkCcb[i]);
+    }
+}
+
 /*@}*/ /* end of group TK_EXPORTED_FUNCTIONS */
 
 /*@}*/ /* end of group TK_Driver */
@@ -1138,6 +1138,860 @@ uint32_t UTCPD_Open(int port)
 	return 0; 
 }
 
+/** @cond HIDDEN_SYMBOLS */
+
+#define UTCPD_PD_IS_MASK    (UTCPD_IS_RXSOPIS_Msk | UTCPD_IS_RXHRSTIS_Msk | UTCPD_IS_TXFALIS_Msk | \
+                             UTCPD_IS_TXDCUDIS_Msk | UTCPD_IS_TXOKIS_Msk | UTCPD_IS_RXOFIS_Msk)
+#define UTCPD_PD_RX_NONE    (0xFFUL)
+
+typedef struct
+{
+    UTCPD_PD_TICK_FUNC pfnTick;
+    S_UTCPD_PD_MSG_T asRxQ[UTCPD_PD_RXQ_SIZE];
+    volatile uint32_t u32RxHead;
+    volatile uint32_t u32RxTail;
+    volatile uint32_t u32TxStatus;
+    volatile uint32_t u32TxTick;
+    volatile uint32_t u32HardReset;
+    uint8_t  au8TxId[3];
+    uint8_t  au8RxId[3];
+    uint8_t  u8TxSop;
+    uint8_t  u8PwrRole;
+    uint8_t  u8DataRole;
+    uint8_t  u8Rev;
+    /* Sink policy engine */
+    uint32_t u32State;
+    uint32_t u32Timer;
+    uint32_t u32Timeout;
+    uint32_t u32HardResetCnt;
+    uint32_t u32TargetMv;
+    uint32_t u32TargetMa;
+    uint32_t u32Retarget;
+    uint32_t u32WaitRetry;
+    uint32_t u32PdoCnt;
+    S_UTCPD_PDO_T asPdo[UTCPD_PD_MAX_PDO];
+    uint32_t u32ReqMv;
+    uint32_t u32ReqMa;
+    uint32_t u32ReqPps;
+    uint32_t u32Contract;
+    uint32_t u32ContractMv;
+    uint32_t u32ContractMa;
+    uint32_t u32ContractPps;
+    uint32_t u32MaxRespMs;
+    /* Reply or Request refused by a busy transmitter, sent by the next UTCPD_PdSnkProcess */
+    uint32_t u32ReplyPending;
+    uint32_t u32ReplyType;
+    uint32_t u32ReplyData;
+    uint32_t u32ReplyCnt;
+    uint32_t u32ReplyTick;
+    uint32_t u32ReqPending;
+    uint32_t u32ReqTick;
+    volatile uint32_t u32RxDrops;
+    uint32_t u32TxDrops;
+} S_UTCPD_PD_PORT_T;
+
+static S_UTCPD_PD_PORT_T s_asPdPort[UTCPD_PD_PORT_NUM];
+
+static UTCPD_T *UTCPD_PdBase(int port)
+{
+    (void)port;
+    return UTCPD;
+}
+
+static void UTCPD_PdResetId(S_UTCPD_PD_PORT_T *psPort, uint32_t u32Sop)
+{
+    psPort->au8TxId[u32Sop] = 0U;
+    psPort->au8RxId[u32Sop] = (uint8_t)UTCPD_PD_RX_NONE;
+}
+
+static void UTCPD_PdReadMsg(UTCPD_T *utcpd, S_UTCPD_PD_PORT_T *psPort)
+{
+    S_UTCPD_PD_MSG_T *psMsg;
+    uint32_t u32Bytes, u32Sop, u32Header, u32Cnt, u32Id, i;
+
+    u32Bytes = utcpd->RXBCNT & 0xFFUL;
+    if(u32Bytes < 3UL)
+        return;
+
+    u32Sop = utcpd->RXFTYPE & 0x7UL;
+    if(u32Sop > UTCPD_PD_SOP_PRIME_PRIME)
+        return;
+
+    u32Header = utcpd->RXHEAD & 0xFFFFUL;
+    u32Cnt = (u32Bytes - 3UL) / 4UL;
+    if(u32Cnt > UTCPD_PD_MAX_DO)
+        u32Cnt = UTCPD_PD_MAX_DO;
+    u32Id = UTCPD_PD_HDR_ID(u32Header);
+
+    /* Checked before the MessageID is taken, so a retransmission of the message can still be queued */
+    if((psPort->u32RxHead - psPort->u32RxTail) >= UTCPD_PD_RXQ_SIZE)
+    {
+        psPort->u32RxDrops++;
+        return;
+    }
+
+    if((u32Cnt == 0UL) && (UTCPD_PD_HDR_TYPE(u32Header) == UTCPD_PD_CTRL_SOFT_RESET))
+    {
+        /* Soft_Reset always carries MessageID 0 and restarts both counters */
+        UTCPD_PdResetId(psPort, u32Sop);
+    }
+    else if(psPort->au8RxId[u32Sop] == u32Id)
+    {
+        /* Retransmission of a message whose GoodCRC was lost; already delivered */
+        return;
+    }
+    psPort->au8RxId[u32Sop] = (uint8_t)u32Id;
+
+    psMsg = &psPort->asRxQ[psPort->u32RxHead & (UTCPD_PD_RXQ_SIZE - 1UL)];
+    psMsg->u16Header = (uint16_t)u32Header;
+    psMsg->u8Sop = (uint8_t)u32Sop;
+    psMsg->u8Cnt = (uint8_t)u32Cnt;
+    psMsg->u32Tick = psPort->pfnTick();
+    for(i = 0UL; i < u32Cnt; i++)
+        psMsg->au32Data[i] = (&utcpd->RXDA0)[i];
+    psPort->u32RxHead++;
+}
+
+static int32_t UTCPD_PdSnkSend(int port, S_UTCPD_PD_PORT_T *psPort, uint32_t u32Type,
+                               const uint32_t au32Data[], uint32_t u32Cnt, uint32_t u32RxTick)
+{
+    uint32_t u32Elapsed;
+
+    if(UTCPD_PdSendMsg(port, UTCPD_PD_SOP, u32Type, au32Data, u32Cnt) != 0)
+        return 1;
+
+    u32Elapsed = psPort->pfnTick() - u32RxTick;
+    if(u32Elapsed > psPort->u32MaxRespMs)
+        psPort->u32MaxRespMs = u32Elapsed;
+
+    return 0;
+}
+
+static void UTCPD_PdSnkReply(int port, S_UTCPD_PD_PORT_T *psPort, uint32_t u32Type,
+                             const uint32_t au32Data[], uint32_t u32Cnt, uint32_t u32RxTick)
+{
+    if(UTCPD_PdSnkSend(port, psPort, u32Type, au32Data, u32Cnt, u32RxTick) == 0)
+        return;
+
+    /* Transmitter busy, keep the reply for UTCPD_PdSnkProcess. A newer reply replaces an older one. */
+    if(psPort->u32ReplyPending)
+        psPort->u32TxDrops++;
+    psPort->u32ReplyPending = 1UL;
+    psPort->u32ReplyType = u32Type;
+    psPort->u32ReplyData = (u32Cnt != 0UL) ? au32Data[0] : 0UL;
+    psPort->u32ReplyCnt = u32Cnt;
+    psPort->u32ReplyTick = u32RxTick;
+}
+
+/* Pending reply and Request are dropped when the state they answered is left */
+static void UTCPD_PdSnkDropPending(S_UTCPD_PD_PORT_T *psPort)
+{
+    if(psPort->u32ReplyPending)
+    {
+        psPort->u32ReplyPending = 0UL;
+        psPort->u32TxDrops++;
+    }
+    psPort->u32ReqPending = 0UL;
+}
+
+static void UTCPD_PdSnkEnter(S_UTCPD_PD_PORT_T *psPort, uint32_t u32State, uint32_t u32Now, uint32_t u32Timeout)
+{
+    psPort->u32State = u32State;
+    psPort->u32Timer = u32Now;
+    psPort->u32Timeout = u32Timeout;
+}
+
+static void UTCPD_PdSnkHardReset(int port, S_UTCPD_PD_PORT_T *psPort, uint32_t u32Now)
+{
+    psPort->u32Contract = 0UL;
+    psPort->u32PdoCnt = 0UL;
+    UTCPD_PdSnkDropPending(psPort);
+
+    if(psPort->u32HardResetCnt >= UTCPD_PD_N_HARD_RESET)
+    {
+        UTCPD_PdSnkEnter(psPort, UTCPD_SNK_ERROR, u32Now, 0UL);
+        return;
+    }
+
+    psPort->u32HardResetCnt++;
+    UTCPD_PdSendHardReset(port);
+    UTCPD_PdSnkEnter(psPort, UTCPD_SNK_WAIT_CAP, u32Now, UTCPD_PD_T_HR_RECOVER + UTCPD_PD_T_SINK_WAIT_CAP);
+}
+
+static uint32_t UTCPD_PdSnkBuildRdo(S_UTCPD_PD_PORT_T *psPort)
+{
+    const S_UTCPD_PDO_T *psPdo;
+    uint32_t u32Mv = psPort->u32TargetMv, u32Ma = psPort->u32TargetMa;
+    uint32_t i;
+
+    /* Exact fixed supply first, PPS next, vSafe5V with Capability Mismatch last */
+    for(i = 0UL; i < psPort->u32PdoCnt; i++)
+    {
+        psPdo = &psPort->asPdo[i];
+        if((psPdo->u8Type == UTCPD_PDO_FIXED) && (psPdo->u16MaxMv == u32Mv) && (psPdo->u16MaxMa >= u32Ma))
+        {
+            psPort->u32ReqMv = u32Mv;
+            psPort->u32ReqMa = u32Ma;
+            psPort->u32ReqPps = 0UL;
+            return ((uint32_t)psPdo->u8Pos << 28) | (1UL << 24) | ((u32Ma / 10UL) << 10) | (u32Ma / 10UL);
+        }
+    }
+
+    for(i = 0UL; i < psPort->u32PdoCnt; i++)
+    {
+        psPdo = &psPort->asPdo[i];
+        if((psPdo->u8Type == UTCPD_PDO_PPS) && (psPdo->u16MinMv <= u32Mv) && (psPdo->u16MaxMv >= u32Mv) &&
+                (psPdo->u16MaxMa >= u32Ma))
+        {
+            psPort->u32ReqMv = u32Mv;
+            psPort->u32ReqMa = u32Ma;
+            psPort->u32ReqPps = 1UL;
+            /* Output voltage in 20 mV units, operating current in 50 mA units */
+            return ((uint32_t)psPdo->u8Pos << 28) | (1UL << 24) | ((u32Mv / 20UL) << 9) | (u32Ma / 50UL);
+        }
+    }
+
+    psPdo = &psPort->asPdo[0];
+    if(u32Ma > psPdo->u16MaxMa)
+        u32Ma = psPdo->u16MaxMa;
+    psPort->u32ReqMv = psPdo->u16MaxMv;
+    psPort->u32ReqMa = u32Ma;
+    psPort->u32ReqPps = 0UL;
+
+    return (1UL << 28) | (1UL << 26) | (1UL << 24) | ((u32Ma / 10UL) << 10) | (psPdo->u16MaxMa / 10UL);
+}
+
+static void UTCPD_PdSnkRequest(int port, S_UTCPD_PD_PORT_T *psPort, uint32_t u32Now, uint32_t u32RxTick)
+{
+    uint32_t u32Rdo;
+
+    if(psPort->u32PdoCnt == 0UL)
+        return;
+
+    u32Rdo = UTCPD_PdSnkBuildRdo(psPort);
+    if(UTCPD_PdSnkSend(port, psPort, UTCPD_PD_DATA_REQUEST, &u32Rdo, 1UL, u32RxTick) != 0)
+    {
+        /* Transmitter busy, UTCPD_PdSnkProcess sends it when the transmitter is free */
+        psPort->u32ReqPending = 1UL;
+        psPort->u32ReqTick = u32RxTick;
+        return;
+    }
+
+    psPort->u32ReqPending = 0UL;
+    psPort->u32Retarget = 0UL;
+    psPort->u32WaitRetry = 0UL;
+    UTCPD_PdSnkEnter(psPort, UTCPD_SNK_WAIT_ACCEPT, u32Now, UTCPD_PD_T_SENDER_RESPONSE);
+}
+
+static void UTCPD_PdSnkNotSupported(int port, S_UTCPD_PD_PORT_T *psPort, uint32_t u32RxTick)
+{
+    UTCPD_PdSnkReply(port, psPort, (psPort->u8Rev >= UTCPD_PD_REV30) ? UTCPD_PD_CTRL_NOT_SUPPORTED : UTCPD_PD_CTRL_REJECT,
+                     NULL, 0UL, u32RxTick);
+}
+
+static void UTCPD_PdSnkHandleMsg(int port, S_UTCPD_PD_PORT_T *psPort, const S_UTCPD_PD_MSG_T *psMsg, uint32_t u32Now)
+{
+    uint32_t u32Type = UTCPD_PD_HDR_TYPE(psMsg->u16Header);
+    uint32_t u32Pdo;
+
+    if(psMsg->u8Sop != UTCPD_PD_SOP)
+        return;
+
+    if(psMsg->u8Cnt != 0UL)
+    {
+        if(UTCPD_PD_HDR_EXT(psMsg->u16Header))
+        {
+            UTCPD_PdSnkNotSupported(port, psPort, psMsg->u32Tick);
+        }
+        else if(u32Type == UTCPD_PD_DATA_SRC_CAP)
+        {
+            /* Operate at the lower of both revisions */
+            if(UTCPD_PD_HDR_REV(psMsg->u16Header) < psPort->u8Rev)
+            {
+                psPort->u8Rev = (uint8_t)UTCPD_PD_HDR_REV(psMsg->u16Header);
+                UTCPD_PdBase(port)->MSHEAD = (UTCPD_PdBase(port)->MSHEAD & ~UTCPD_MSHEAD_PDREV_Msk) |
+                                             ((uint32_t)psPort->u8Rev << UTCPD_MSHEAD_PDREV_Pos);
+            }
+            psPort->u32PdoCnt = UTCPD_PdParseSrcCap(psMsg->au32Data, psMsg->u8Cnt, psPort->asPdo);
+            UTCPD_PdSnkRequest(port, psPort, u32Now, psMsg->u32Tick);
+        }
+        else
+        {
+            UTCPD_PdSnkNotSupported(port, psPort, psMsg->u32Tick);
+        }
+        return;
+    }
+
+    switch(u32Type)
+    {
+        case UTCPD_PD_CTRL_ACCEPT:
+            if(psPort->u32State == UTCPD_SNK_WAIT_ACCEPT)
+                UTCPD_PdSnkEnter(psPort, UTCPD_SNK_WAIT_PS_RDY, u32Now, UTCPD_PD_T_PS_TRANSITION);
+            break;
+
+        case UTCPD_PD_CTRL_REJECT:
+        case UTCPD_PD_CTRL_WAIT:
+            if(psPort->u32State == UTCPD_SNK_WAIT_ACCEPT)
+            {
+                if(psPort->u32Contract)
+                    UTCPD_PdSnkEnter(psPort, UTCPD_SNK_READY, u32Now, 0UL);
+                else
+                    UTCPD_PdSnkEnter(psPort, UTCPD_SNK_WAIT_CAP, u32Now, UTCPD_PD_T_SINK_WAIT_CAP);
+
+                psPort->u32WaitRetry = (u32Type == UTCPD_PD_CTRL_WAIT) ? 1UL : 0UL;
+            }
+            break;
+
+        case UTCPD_PD_CTRL_PS_RDY:
+            if(psPort->u32State == UTCPD_SNK_WAIT_PS_RDY)
+            {
+                psPort->u32Contract = 1UL;
+                psPort->u32ContractMv = psPort->u32ReqMv;
+                psPort->u32ContractMa = psPort->u32ReqMa;
+                psPort->u32ContractPps = psPort->u32ReqPps;
+                psPort->u32HardResetCnt = 0UL;
+                UTCPD_PdSnkEnter(psPort, UTCPD_SNK_READY, u32Now, 0UL);
+            }
+            break;
+
+        case UTCPD_PD_CTRL_SOFT_RESET:
+            UTCPD_PdSnkDropPending(psPort);
+            UTCPD_PdSnkReply(port, psPort, UTCPD_PD_CTRL_ACCEPT, NULL, 0UL, psMsg->u32Tick);
+            psPort->u32Contract = 0UL;
+            psPort->u32PdoCnt = 0UL;
+            UTCPD_PdSnkEnter(psPort, UTCPD_SNK_WAIT_CAP, u32Now, UTCPD_PD_T_SINK_WAIT_CAP);
+            break;
+
+        case UTCPD_PD_CTRL_GET_SNK_CAP:
+            /* vSafe5V fixed supply at the target current */
+            u32Pdo = ((5000UL / 50UL) << 10) | (psPort->u32TargetMa / 10UL);
+            UTCPD_PdSnkReply(port, psPort, UTCPD_PD_DATA_SNK_CAP, &u32Pdo, 1UL, psMsg->u32Tick);
+            break;
+
+        case UTCPD_PD_CTRL_GOODCRC:
+        case UTCPD_PD_CTRL_PING:
+            break;
+
+        default:
+            UTCPD_PdSnkNotSupported(port, psPort, psMsg->u32Tick);
+            break;
+    }
+}
+
+/** @endcond HIDDEN_SYMBOLS */
+
+/**
+  * @brief      Open PD message layer
+  *
+  * @param[in]  port         Specify UTCPD port
+  * @param[in]  u32PwrRole   Power role, 0: Sink, 1: Source
+  * @param[in]  u32DataRole  Data role, 0: UFP, 1: DFP
+  * @param[in]  pfnTick      Function returning a free running millisecond tick
+  *
+  * @return     0: Successful,  1: Fail
+  *
+  * @details    Programs the message header used for automatic GoodCRC, enables SOP and Hard Reset
+  *             reception and unmasks the RX/TX alerts. GoodCRC replies and retransmission are done by
+  *             UTCPD hardware with \ref UTCPD_PD_TX_RETRY retries; MessageID counters, duplicate
+  *             detection and the policy timers are kept by software.
+  *             For a sink port, the sink policy engine starts waiting for Source_Capabilities.
+  *             The UTCPD IRQ handler must call \ref UTCPD_PdIRQHandler.
+  */
+int32_t UTCPD_PdOpen(int port, uint32_t u32PwrRole, uint32_t u32DataRole, UTCPD_PD_TICK_FUNC pfnTick)
+{
+    UTCPD_T *utcpd;
+    S_UTCPD_PD_PORT_T *psPort;
+    uint32_t i;
+
+    if((port < 0) || ((uint32_t)port >= UTCPD_PD_PORT_NUM) || (pfnTick == NULL))
+        return 1;
+
+    utcpd = UTCPD_PdBase(port);
+    psPort = &s_asPdPort[port];
+
+    utcpd->IE &= ~UTCPD_PD_IS_MASK;
+
+    psPort->pfnTick = pfnTick;
+    psPort->u32RxHead = psPort->u32RxTail = 0UL;
+    psPort->u32TxStatus = UTCPD_PD_TX_IDLE;
+    psPort->u32HardReset = 0UL;
+    for(i = UTCPD_PD_SOP; i <= UTCPD_PD_SOP_PRIME_PRIME; i++)
+        UTCPD_PdResetId(psPort, i);
+    psPort->u8PwrRole = (uint8_t)(u32PwrRole & 1UL);
+    psPort->u8DataRole = (uint8_t)(u32DataRole & 1UL);
+    psPort->u8Rev = (uint8_t)UTCPD_PD_REV30;
+
+    psPort->u32HardResetCnt = 0UL;
+    psPort->u32Retarget = psPort->u32WaitRetry = 0UL;
+    psPort->u32PdoCnt = 0UL;
+    psPort->u32Contract = 0UL;
+    psPort->u32MaxRespMs = 0UL;
+    psPort->u32ReplyPending = psPort->u32ReqPending = 0UL;
+    psPort->u32RxDrops = psPort->u32TxDrops = 0UL;
+    if(psPort->u32TargetMv == 0UL)
+    {
+        psPort->u32TargetMv = 5000UL;
+        psPort->u32TargetMa = 900UL;
+    }
+
+    if(psPort->u8PwrRole == 0U)
+        UTCPD_PdSnkEnter(psPort, UTCPD_SNK_WAIT_CAP, pfnTick(), UTCPD_PD_T_SINK_WAIT_CAP);
+    else
+        UTCPD_PdSnkEnter(psPort, UTCPD_SNK_DISABLED, pfnTick(), 0UL);
+
+    utcpd->MSHEAD = ((uint32_t)psPort->u8PwrRole << UTCPD_MSHEAD_PWRROL_Pos) |
+                    ((uint32_t)psPort->u8Rev << UTCPD_MSHEAD_PDREV_Pos) |
+                    ((uint32_t)psPort->u8DataRole << UTCPD_MSHEAD_DAROL_Pos);
+    utcpd->IS = UTCPD_PD_IS_MASK;
+    utcpd->IE |= UTCPD_PD_IS_MASK;
+    utcpd->DTRXEVNT = UTCPD_DTRXEVNT_SOPEN_Msk | UTCPD_DTRXEVNT_HRSTEN_Msk;
+
+    return 0;
+}
+
+/**
+  * @brief      PD message layer alert handler
+  *
+  * @param[in]  port         Specify UTCPD port
+  *
+  * @return     None
+  *
+  * @details    Call from the UTCPD IRQ handler. Queues received messages, drops retransmissions with a
+  *             repeated MessageID, and completes the pending transmission. Only the RX/TX message alerts
+  *             are cleared; CC, power and fault alerts are left to the caller.
+  */
+void UTCPD_PdIRQHandler(int port)
+{
+    UTCPD_T *utcpd;
+    S_UTCPD_PD_PORT_T *psPort;
+    uint32_t u32Sts, i;
+
+    if((port < 0) || ((uint32_t)port >= UTCPD_PD_PORT_NUM) || (s_asPdPort[port].pfnTick == NULL))
+        return;
+
+    utcpd = UTCPD_PdBase(port);
+    psPort = &s_asPdPort[port];
+    u32Sts = utcpd->IS & UTCPD_PD_IS_MASK;
+
+    if(u32Sts & UTCPD_IS_RXHRSTIS_Msk)
+    {
+        for(i = UTCPD_PD_SOP; i <= UTCPD_PD_SOP_PRIME_PRIME; i++)
+            UTCPD_PdResetId(psPort, i);
+        psPort->u32RxTail = psPort->u32RxHead;
+        psPort->u32HardReset = 1UL;
+    }
+
+    if(u32Sts & UTCPD_IS_RXSOPIS_Msk)
+        UTCPD_PdReadMsg(utcpd, psPort);
+
+    /* UTCPD receive buffer overrun, a message was lost before it could be read */
+    if(u32Sts & UTCPD_IS_RXOFIS_Msk)
+        psPort->u32RxDrops++;
+
+    if(u32Sts & (UTCPD_IS_TXOKIS_Msk | UTCPD_IS_TXFALIS_Msk))
+    {
+        if(psPort->u8TxSop == UTCPD_PD_TX_HARD_RESET)
+        {
+            for(i = UTCPD_PD_SOP; i <= UTCPD_PD_SOP_PRIME_PRIME; i++)
+                UTCPD_PdResetId(psPort, i);
+            psPort->u32HardReset = 1UL;
+        }
+        else
+        {
+            /* The counter also advances when all retries failed */
+            psPort->au8TxId[psPort->u8TxSop] = (uint8_t)((psPort->au8TxId[psPort->u8TxSop] + 1U) & 0x7U);
+        }
+        psPort->u32TxTick = psPort->pfnTick();
+        psPort->u32TxStatus = (u32Sts & UTCPD_IS_TXOKIS_Msk) ? UTCPD_PD_TX_OK : UTCPD_PD_TX_FAIL;
+    }
+    else if(u32Sts & UTCPD_IS_TXDCUDIS_Msk)
+    {
+        psPort->u32TxStatus = UTCPD_PD_TX_DISCARD;
+    }
+
+    utcpd->IS = u32Sts;
+}
+
+/**
+  * @brief      Send a PD message
+  *
+  * @param[in]  port         Specify UTCPD port
+  * @param[in]  u32Sop       Frame type, \ref UTCPD_PD_SOP, \ref UTCPD_PD_SOP_PRIME or \ref UTCPD_PD_SOP_PRIME_PRIME
+  * @param[in]  u32Type      Control or data message type
+  * @param[in]  au32Data     Data objects, NULL for a control message
+  * @param[in]  u32Cnt       Number of data objects, 0 ~ \ref UTCPD_PD_MAX_DO
+  *
+  * @return     0: Successful,  1: Fail or a transmission is still pending
+  *
+  * @details    The header is built from the current roles, revision and MessageID counter. The result is
+  *             reported by \ref UTCPD_PdGetTxStatus once GoodCRC is received or all retries failed.
+  */
+int32_t UTCPD_PdSendMsg(int port, uint32_t u32Sop, uint32_t u32Type, const uint32_t au32Data[], uint32_t u32Cnt)
+{
+    UTCPD_T *utcpd;
+    S_UTCPD_PD_PORT_T *psPort;
+    uint32_t u32Header, i;
+
+    if((port < 0) || ((uint32_t)port >= UTCPD_PD_PORT_NUM) || (u32Sop > UTCPD_PD_SOP_PRIME_PRIME) ||
+            (u32Cnt > UTCPD_PD_MAX_DO) || ((u32Cnt != 0UL) && (au32Data == NULL)))
+        return 1;
+
+    utcpd = UTCPD_PdBase(port);
+    psPort = &s_asPdPort[port];
+
+    if(psPort->u32TxStatus == UTCPD_PD_TX_BUSY)
+        return 1;
+
+    u32Header = (u32Type & 0x1FUL) | ((uint32_t)psPort->u8Rev << 6) | ((uint32_t)psPort->au8TxId[u32Sop] << 9) |
+                (u32Cnt << 12);
+    if(u32Sop == UTCPD_PD_SOP)
+        u32Header |= ((uint32_t)psPort->u8DataRole << 5) | ((uint32_t)psPort->u8PwrRole << 8);
+
+    for(i = 0UL; i < u32Cnt; i++)
+        (&utcpd->TXDA0)[i] = au32Data[i];
+    utcpd->TXHEAD = u32Header;
+    utcpd->TXBCNT = 2UL + u32Cnt * 4UL;
+
+    psPort->u8TxSop = (uint8_t)u32Sop;
+    psPort->u32TxStatus = UTCPD_PD_TX_BUSY;
+    utcpd->TXCTL = (UTCPD_PD_TX_RETRY << UTCPD_TXCTL_RETRYCNT_Pos) | u32Sop;
+
+    return 0;
+}
+
+/**
+  * @brief      Send Hard Reset
+  *
+  * @param[in]  port         Specify UTCPD port
+  *
+  * @return     0: Successful,  1: Fail
+  *
+  * @details    A pending transmission is overridden. UTCPD clears DTRXEVNT when Hard Reset is requested;
+  *             reception is enabled again by \ref UTCPD_PdSnkProcess.
+  */
+int32_t UTCPD_PdSendHardReset(int port)
+{
+    UTCPD_T *utcpd;
+
+    if((port < 0) || ((uint32_t)port >= UTCPD_PD_PORT_NUM))
+        return 1;
+
+    utcpd = UTCPD_PdBase(port);
+    s_asPdPort[port].u8TxSop = (uint8_t)UTCPD_PD_TX_HARD_RESET;
+    s_asPdPort[port].u32TxStatus = UTCPD_PD_TX_BUSY;
+    utcpd->TXCTL = UTCPD_PD_TX_HARD_RESET;
+
+    return 0;
+}
+
+/**
+  * @brief      Get status of the last transmission
+  *
+  * @param[in]  port         Specify UTCPD port
+  *
+  * @return     \ref UTCPD_PD_TX_IDLE, \ref UTCPD_PD_TX_BUSY, \ref UTCPD_PD_TX_OK, \ref UTCPD_PD_TX_FAIL
+  *             or \ref UTCPD_PD_TX_DISCARD
+  */
+uint32_t UTCPD_PdGetTxStatus(int port)
+{
+    if((port < 0) || ((uint32_t)port >= UTCPD_PD_PORT_NUM))
+        return UTCPD_PD_TX_IDLE;
+
+    return s_asPdPort[port].u32TxStatus;
+}
+
+/**
+  * @brief      Get a received PD message
+  *
+  * @param[in]  port         Specify UTCPD port
+  * @param[out] psMsg        Received message
+  *
+  * @return     0: Successful,  1: No message
+  *
+  * @details    Do not mix with \ref UTCPD_PdSnkProcess, which consumes the same queue.
+  */
+int32_t UTCPD_PdGetMsg(int port, S_UTCPD_PD_MSG_T *psMsg)
+{
+    S_UTCPD_PD_PORT_T *psPort;
+
+    if((port < 0) || ((uint32_t)port >= UTCPD_PD_PORT_NUM) || (psMsg == NULL))
+        return 1;
+
+    psPort = &s_asPdPort[port];
+    if(psPort->u32RxTail == psPort->u32RxHead)
+        return 1;
+
+    *psMsg = psPort->asRxQ[psPort->u32RxTail & (UTCPD_PD_RXQ_SIZE - 1UL)];
+    psPort->u32RxTail++;
+
+    return 0;
+}
+
+/**
+  * @brief      Decode Source_Capabilities
+  *
+  * @param[in]  au32Pdo      Power data objects
+  * @param[in]  u32Cnt       Number of power data objects
+  * @param[out] asPdo        Decoded objects, at least \ref UTCPD_PD_MAX_PDO entries
+  *
+  * @return     Number of decoded objects
+  *
+  * @details    Fixed, battery, variable and PPS APDOs are decoded; other APDO types are skipped.
+  *             u8Pos keeps the original object position used by the Request.
+  */
+uint32_t UTCPD_PdParseSrcCap(const uint32_t au32Pdo[], uint32_t u32Cnt, S_UTCPD_PDO_T asPdo[])
+{
+    uint32_t u32Pdo, u32Num = 0UL, i;
+    S_UTCPD_PDO_T *psPdo;
+
+    if(u32Cnt > UTCPD_PD_MAX_PDO)
+        u32Cnt = UTCPD_PD_MAX_PDO;
+
+    for(i = 0UL; i < u32Cnt; i++)
+    {
+        u32Pdo = au32Pdo[i];
+        psPdo = &asPdo[u32Num];
+        psPdo->u8Type = (uint8_t)(u32Pdo >> 30);
+        psPdo->u8Pos = (uint8_t)(i + 1UL);
+        psPdo->u32MaxMw = 0UL;
+
+        switch(u32Pdo >> 30)
+        {
+            case UTCPD_PDO_FIXED:
+                psPdo->u16MinMv = psPdo->u16MaxMv = (uint16_t)(((u32Pdo >> 10) & 0x3FFUL) * 50UL);
+                psPdo->u16MaxMa = (uint16_t)((u32Pdo & 0x3FFUL) * 10UL);
+                break;
+
+            case UTCPD_PDO_BATTERY:
+                psPdo->u16MaxMv = (uint16_t)(((u32Pdo >> 20) & 0x3FFUL) * 50UL);
+                psPdo->u16MinMv = (uint16_t)(((u32Pdo >> 10) & 0x3FFUL) * 50UL);
+                psPdo->u16MaxMa = 0U;
+                psPdo->u32MaxMw = (u32Pdo & 0x3FFUL) * 250UL;
+                break;
+
+            case UTCPD_PDO_VARIABLE:
+                psPdo->u16MaxMv = (uint16_t)(((u32Pdo >> 20) & 0x3FFUL) * 50UL);
+                psPdo->u16MinMv = (uint16_t)(((u32Pdo >> 10) & 0x3FFUL) * 50UL);
+                psPdo->u16MaxMa = (uint16_t)((u32Pdo & 0x3FFUL) * 10UL);
+                break;
+
+            default:
+                /* APDO, only SPR PPS is supported */
+                if(((u32Pdo >> 28) & 0x3UL) != 0UL)
+                    continue;
+                psPdo->u16MaxMv = (uint16_t)(((u32Pdo >> 17) & 0xFFUL) * 100UL);
+                psPdo->u16MinMv = (uint16_t)(((u32Pdo >> 8) & 0xFFUL) * 100UL);
+                psPdo->u16MaxMa = (uint16_t)((u32Pdo & 0x7FUL) * 50UL);
+                break;
+        }
+        u32Num++;
+    }
+
+    return u32Num;
+}
+
+/**
+  * @brief      Set sink target voltage and current
+  *
+  * @param[in]  port         Specify UTCPD port
+  * @param[in]  u32Mv        Target voltage in mV
+  * @param[in]  u32Ma        Operating current in mA
+  *
+  * @return     None
+  *
+  * @details    An exact fixed supply is preferred, then a PPS APDO covering the voltage. Otherwise vSafe5V
+  *             is requested with Capability Mismatch set. With a contract in place, a new Request is sent
+  *             by the next \ref UTCPD_PdSnkProcess call.
+  */
+void UTCPD_PdSnkSetTarget(int port, uint32_t u32Mv, uint32_t u32Ma)
+{
+    S_UTCPD_PD_PORT_T *psPort;
+
+    if((port < 0) || ((uint32_t)port >= UTCPD_PD_PORT_NUM))
+        return;
+
+    psPort = &s_asPdPort[port];
+    psPort->u32TargetMv = u32Mv;
+    psPort->u32TargetMa = u32Ma;
+    psPort->u32Retarget = 1UL;
+}
+
+/**
+  * @brief      Run sink policy engine
+  *
+  * @param[in]  port         Specify UTCPD port
+  *
+  * @return     Sink state, \ref UTCPD_SNK_DISABLED ~ \ref UTCPD_SNK_ERROR
+  *
+  * @details    Call after \ref UTCPD_PdIRQHandler and periodically, at least every few milliseconds while a
+  *             response is pending. Handles messages queued by the IRQ handler, tSenderResponse,
+  *             tTypeCSinkWaitCap and tPSTransition timeouts with Hard Reset, the Wait retry after
+  *             tSinkRequest, and PPS re-requests before tPPSTimeout. Replies and Requests that found the
+  *             transmitter busy are sent here once it is free.
+  *             \ref UTCPD_SNK_ERROR is returned after nHardResetCount failed resets; the caller should run
+  *             Type-C error recovery and call \ref UTCPD_PdOpen again.
+  */
+uint32_t UTCPD_PdSnkProcess(int port)
+{
+    S_UTCPD_PD_PORT_T *psPort;
+    S_UTCPD_PD_MSG_T sMsg;
+    uint32_t u32Now, u32Elapsed;
+
+    if((port < 0) || ((uint32_t)port >= UTCPD_PD_PORT_NUM))
+        return UTCPD_SNK_DISABLED;
+
+    psPort = &s_asPdPort[port];
+    if((psPort->u32State == UTCPD_SNK_DISABLED) || (psPort->u32State == UTCPD_SNK_ERROR))
+        return psPort->u32State;
+
+    u32Now = psPort->pfnTick();
+
+    if(psPort->u32HardReset)
+    {
+        psPort->u32HardReset = 0UL;
+        psPort->u32Contract = 0UL;
+        psPort->u32PdoCnt = 0UL;
+        psPort->u8Rev = (uint8_t)UTCPD_PD_REV30;
+        UTCPD_PdBase(port)->MSHEAD = (UTCPD_PdBase(port)->MSHEAD & ~UTCPD_MSHEAD_PDREV_Msk) |
+                                     (UTCPD_PD_REV30 << UTCPD_MSHEAD_PDREV_Pos);
+        UTCPD_PdBase(port)->DTRXEVNT = UTCPD_DTRXEVNT_SOPEN_Msk | UTCPD_DTRXEVNT_HRSTEN_Msk;
+        UTCPD_PdSnkDropPending(psPort);
+        if(psPort->u32State != UTCPD_SNK_WAIT_CAP)
+            UTCPD_PdSnkEnter(psPort, UTCPD_SNK_WAIT_CAP, u32Now, UTCPD_PD_T_HR_RECOVER + UTCPD_PD_T_SINK_WAIT_CAP);
+    }
+
+    while(UTCPD_PdGetMsg(port, &sMsg) == 0)
+        UTCPD_PdSnkHandleMsg(port, psPort, &sMsg, u32Now);
+
+    /* A reply the partner stopped waiting for (tSenderResponse) is dropped */
+    if(psPort->u32ReplyPending)
+    {
+        if((u32Now - psPort->u32ReplyTick) > UTCPD_PD_T_SENDER_RESPONSE)
+        {
+            psPort->u32ReplyPending = 0UL;
+            psPort->u32TxDrops++;
+        }
+        else if(UTCPD_PdSnkSend(port, psPort, psPort->u32ReplyType, &psPort->u32ReplyData, psPort->u32ReplyCnt,
+                                psPort->u32ReplyTick) == 0)
+        {
+            psPort->u32ReplyPending = 0UL;
+        }
+    }
+
+    /* A Request still waits for the transmitter, in WAIT_CAP after Source_Capabilities too */
+    if(psPort->u32ReqPending && ((psPort->u32State == UTCPD_SNK_WAIT_CAP) || (psPort->u32State == UTCPD_SNK_READY)))
+        UTCPD_PdSnkRequest(port, psPort, u32Now, psPort->u32ReqTick);
+
+    u32Elapsed = u32Now - psPort->u32Timer;
+    switch(psPort->u32State)
+    {
+        case UTCPD_SNK_WAIT_CAP:
+        case UTCPD_SNK_WAIT_PS_RDY:
+            if(u32Elapsed > psPort->u32Timeout)
+                UTCPD_PdSnkHardReset(port, psPort, u32Now);
+            break;
+
+        case UTCPD_SNK_WAIT_ACCEPT:
+            /* SenderResponseTimer starts when GoodCRC of the Request is received */
+            if(psPort->u32TxStatus == UTCPD_PD_TX_OK)
+                u32Elapsed = u32Now - psPort->u32TxTick;
+
+            if((psPort->u32TxStatus == UTCPD_PD_TX_FAIL) || (u32Elapsed > psPort->u32Timeout))
+                UTCPD_PdSnkHardReset(port, psPort, u32Now);
+            else if(psPort->u32TxStatus == UTCPD_PD_TX_DISCARD)
+                UTCPD_PdSnkRequest(port, psPort, u32Now, u32Now);
+            break;
+
+        case UTCPD_SNK_READY:
+            if(psPort->u32ReqPending)
+                break;
+
+            if(psPort->u32WaitRetry)
+            {
+                if(u32Elapsed >= UTCPD_PD_T_SINK_REQUEST)
+                    UTCPD_PdSnkRequest(port, psPort, u32Now, u32Now);
+            }
+            else if(psPort->u32Retarget || (psPort->u32ContractPps && (u32Elapsed >= UTCPD_PD_T_PPS_REQUEST)))
+            {
+                UTCPD_PdSnkRequest(port, psPort, u32Now, u32Now);
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return psPort->u32State;
+}
+
+/**
+  * @brief      Get explicit contract
+  *
+  * @param[in]  port         Specify UTCPD port
+  * @param[out] pu32Mv       Contract voltage in mV
+  * @param[out] pu32Ma       Contract operating current in mA
+  *
+  * @return     0: Successful,  1: No explicit contract
+  */
+int32_t UTCPD_PdSnkGetContract(int port, uint32_t *pu32Mv, uint32_t *pu32Ma)
+{
+    S_UTCPD_PD_PORT_T *psPort;
+
+    if((port < 0) || ((uint32_t)port >= UTCPD_PD_PORT_NUM) || (pu32Mv == NULL) || (pu32Ma == NULL))
+        return 1;
+
+    psPort = &s_asPdPort[port];
+    if(psPort->u32Contract == 0UL)
+        return 1;
+
+    *pu32Mv = psPort->u32ContractMv;
+    *pu32Ma = psPort->u32ContractMa;
+
+    return 0;
+}
+
+/**
+  * @brief      Get worst response time
+  *
+  * @param[in]  port         Specify UTCPD port
+  *
+  * @return     Longest time in ms from receiving a message to handing its response to UTCPD
+  *
+  * @details    Compare against \ref UTCPD_PD_T_RECEIVER_RESPONSE to check how often
+  *             \ref UTCPD_PdSnkProcess is called. Cleared by \ref UTCPD_PdOpen.
+  */
+uint32_t UTCPD_PdGetMaxRespTime(int port)
+{
+    if((port < 0) || ((uint32_t)port >= UTCPD_PD_PORT_NUM))
+        return 0UL;
+
+    return s_asPdPort[port].u32MaxRespMs;
+}
+
+/**
+  * @brief      Get dropped message counts
+  *
+  * @param[in]  port         Specify UTCPD port
+  * @param[out] pu32RxDrops  Received messages lost because the message queue or the UTCPD receive buffer was full
+  * @param[out] pu32TxDrops  Replies given up because the transmitter stayed busy until a newer reply, a reset or
+  *                          tSenderResponse
+  *
+  * @return     0: Successful,  1: Fail
+  *
+  * @details    A reply that finds the transmitter busy is kept and sent by \ref UTCPD_PdSnkProcess as soon as
+  *             the transmitter is free. Both counts are cleared by \ref UTCPD_PdOpen.
+  */
+int32_t UTCPD_PdGetDropCount(int port, uint32_t *pu32RxDrops, uint32_t *pu32TxDrops)
+{
+    if((port < 0) || ((uint32_t)port >= UTCPD_PD_PORT_NUM) || (pu32RxDrops == NULL) || (pu32TxDrops == NULL))
+        return 1;
+
+    *pu32RxDrops = s_asPdPort[port].u32RxDrops;
+    *pu32TxDrops = s_asPdPort[port].u32TxDrops;
+
+    return 0;
+}
+
 
 /*@}*/ /* end of group I2C_EXPORTED_FUNCTIONS */
 
@@ -70,6 +70,134 @@ int32_t WDT_Open(uint32_t u32TimeoutInterval,
     return WDT_OK;
 }
 
+/** @cond HIDDEN_SYMBOLS */
+
+/* Feed the selected watchdogs before a chunk expected to take u32NextUs */
+static int32_t WDT_LongOpFeed(S_WDT_LONGOP_T *psOp, uint32_t u32NextUs)
+{
+    uint32_t u32TimeOutCnt = WDT_TIMEOUT;
+    uint32_t u32Cmp, u32Cnt;
+
+    if(psOp->u32Feed & WDT_LONGOP_FEED_WDT)
+        WDT_RESET_COUNTER();
+
+    if(psOp->u32Feed & WDT_LONGOP_FEED_WWDT)
+    {
+        u32Cmp = (WWDT->CTL & WWDT_CTL_CMPDAT_Msk) >> WWDT_CTL_CMPDAT_Pos;
+        u32Cnt = WWDT_GET_COUNTER();
+
+        if(u32Cnt > u32Cmp)
+        {
+            /* Reloading before the window opens resets the chip. Skip this feed if the next
+               chunk ends before the counter runs out, otherwise wait for the window. */
+            if((psOp->u32UnitUs != 0UL) && (u32NextUs < (u32Cnt - 1UL) * psOp->u32WwdtTickUs))
+                return WDT_OK;
+
+            while(WWDT_GET_COUNTER() > u32Cmp)
+            {
+                if(--u32TimeOutCnt == 0UL) return WDT_ERR_TIMEOUT;
+            }
+        }
+        WWDT_RELOAD_COUNTER();
+    }
+
+    return WDT_OK;
+}
+
+/** @endcond HIDDEN_SYMBOLS */
+
+/**
+  * @brief      Run a long operation in chunks and feed the watchdogs between them
+  *
+  * @param[in,out]  psOp    Operation descriptor. u32Chunk, u32UnitUs and u32Done are updated.
+  *
+  * @retval     WDT_OK              The operation completed.
+  * @retval     WDT_FAIL            psOp has no step function.
+  * @retval     WDT_ERR_TIMEOUT     The WWDT window did not open.
+  * @retval     <0                  Error returned by the step function.
+  *
+  * @details    pfnStep is called with at most u32Chunk units at a time. Before each call the WDT counter
+  *             is reset, and the WWDT counter is reloaded once its window is open. A reload that would
+  *             come too early is skipped if the next chunk still ends before the WWDT runs out,
+  *             otherwise this function waits for the window.
+  *             With pfnGetUs set, every chunk is timed, u32UnitUs follows the measured time per unit and
+  *             u32Chunk is resized to fill u32BudgetUs, at most doubling per chunk. With WWDT feeding the
+  *             budget is limited to half of the WWDT period.
+  * @note       Until u32UnitUs is known every WWDT feed waits for the window, seed it to avoid this.
+  */
+int32_t WDT_RunLongOp(S_WDT_LONGOP_T *psOp)
+{
+    uint32_t u32Budget = psOp->u32BudgetUs;
+    uint32_t u32Count, u32Start = 0UL, u32Unit;
+    int32_t i32Ret = WDT_OK;
+
+    if(psOp->pfnStep == NULL)
+        return WDT_FAIL;
+
+    if((psOp->u32Feed & WDT_LONGOP_FEED_WWDT) && (psOp->u32WwdtTickUs != 0UL))
+    {
+        u32Unit = ((WWDT_CNT_CNTDAT_Msk >> WWDT_CNT_CNTDAT_Pos) * psOp->u32WwdtTickUs) / 2UL;
+        if((u32Budget == 0UL) || (u32Budget > u32Unit))
+            u32Budget = u32Unit;
+    }
+
+    if(psOp->u32Chunk == 0UL)
+        psOp->u32Chunk = 1UL;
+    if((psOp->u32MaxChunk != 0UL) && (psOp->u32Chunk > psOp->u32MaxChunk))
+        psOp->u32Chunk = psOp->u32MaxChunk;
+    psOp->u32Done = 0UL;
+
+    while((i32Ret != WDT_LONGOP_DONE) && ((psOp->u32Total == 0UL) || (psOp->u32Done < psOp->u32Total)))
+    {
+        u32Count = psOp->u32Chunk;
+        if((psOp->u32Total != 0UL) && (u32Count > psOp->u32Total - psOp->u32Done))
+            u32Count = psOp->u32Total - psOp->u32Done;
+
+        i32Ret = WDT_LongOpFeed(psOp, u32Count * psOp->u32UnitUs);
+        if(i32Ret != WDT_OK)
+            return i32Ret;
+
+        if(psOp->pfnGetUs != NULL)
+            u32Start = psOp->pfnGetUs();
+
+        i32Ret = psOp->pfnStep(psOp->pvCtx, psOp->u32Done, u32Count);
+        if(i32Ret < 0)
+            return i32Ret;
+        psOp->u32Done += u32Count;
+
+        if(psOp->pfnGetUs != NULL)
+        {
+            u32Unit = (psOp->pfnGetUs() - u32Start + u32Count - 1UL) / u32Count;
+            if(u32Unit == 0UL)
+                u32Unit = 1UL;
+
+            /* Follow slower units at once and faster ones gradually, rounding up so that it converges */
+            if(u32Unit >= psOp->u32UnitUs)
+                psOp->u32UnitUs = u32Unit;
+            else
+                psOp->u32UnitUs -= (psOp->u32UnitUs - u32Unit + 3UL) / 4UL;
+
+            if(u32Budget != 0UL)
+            {
+                u32Count = u32Budget / psOp->u32UnitUs;
+                if((psOp->u32Chunk <= 0x7FFFFFFFUL) && (u32Count > psOp->u32Chunk * 2UL))
+                    u32Count = psOp->u32Chunk * 2UL;
+                if(u32Count == 0UL)
+                    u32Count = 1UL;
+                if((psOp->u32MaxChunk != 0UL) && (u32Count > psOp->u32MaxChunk))
+                    u32Count = psOp->u32MaxChunk;
+                psOp->u32Chunk = u32Count;
+            }
+        }
+
+        if(psOp->pfnProgress != NULL)
+            psOp->pfnProgress(psOp->pvCtx, psOp->u32Done, psOp->u32Total);
+    }
+
+    /* Hand over with freshly fed watchdogs where the window allows it */
+    return WDT_LongOpFeed(psOp, 0UL);
+}
+
 /*@}*/ /* end of group WDT_EXPORTED_FUNCTIONS */
 
 /*@}*/ /* end of group WDT_Driver */
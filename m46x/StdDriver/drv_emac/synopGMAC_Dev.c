@@ -1758,7 +1758,7 @@ void synopGMAC_clear_interrupt(synopGMACdevice *gmacdev)
   * @param[in] pointer to synopGMACdevice.
   * \return 0 upon success. Error code upon failure.
   */
-u32 synopGMAC_get_interrupt_type(synopGMACdevice *gmacdev)
+NVT_FAST_EMAC_FUNC u32 synopGMAC_get_interrupt_type(synopGMACdevice *gmacdev)
 {
     u32 data;
     u32 interrupts = 0;
@@ -1789,7 +1789,7 @@ u32 synopGMAC_get_interrupt_type(synopGMACdevice *gmacdev)
   * @param[in] bit mask of interrupts to be enabled.
   * \return returns void.
   */
-void synopGMAC_enable_interrupt(synopGMACdevice *gmacdev, u32 interrupts)
+NVT_FAST_EMAC_FUNC void synopGMAC_enable_interrupt(synopGMACdevice *gmacdev, u32 interrupts)
 {
 //    synopGMACWriteReg((u32 *)gmacdev->DmaBase, DmaInterrupt, interrupts);
     u32 data;
@@ -1808,7 +1808,7 @@ void synopGMAC_enable_interrupt(synopGMACdevice *gmacdev, u32 interrupts)
   * \note This function disabled all the interrupts, if you want to disable a particular interrupt then
   *  use synopGMAC_disable_interrupt().
   */
-void synopGMAC_disable_interrupt_all(synopGMACdevice *gmacdev)
+NVT_FAST_EMAC_FUNC void synopGMAC_disable_interrupt_all(synopGMACdevice *gmacdev)
 {
     synopGMACWriteReg((u32 *)gmacdev->DmaBase, DmaInterrupt, DmaIntDisable);
     return;
@@ -529,7 +529,7 @@ u32 volatile LPIReg = 0;
  * \note This function runs in interrupt context
  *
  */
-void synopGMAC0_intr_handler(void)
+NVT_FAST_EMAC_FUNC void synopGMAC0_intr_handler(void)
 {
     synopGMACdevice * gmacdev = &GMACdev[0];
     u32 interrupt,dma_status_reg, mac_status_reg;
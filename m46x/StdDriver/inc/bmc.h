@@ -62,6 +62,33 @@ extern "C"
 /*@}*/ /* end of group BMC_EXPORTED_CONSTANTS */
 
 
+/** @addtogroup BMC_EXPORTED_STRUCTS BMC Exported Structs
+  @{
+*/
+
+/**
+  * @details    PDMA streaming state of one BMC channel group.
+  *             The buffer is played as two halves by a pair of linked scatter-gather descriptors.
+  *             Descriptors and buffer must be placed in SRAM, and all descriptors of a PDMA controller
+  *             must share the upper 16 address bits held in PDMA_T::SCATBA.
+  */
+typedef struct
+{
+    DSCT_T   asDesc[2];                 /*!< Ping-pong descriptors, one per buffer half */
+    uint32_t *pu32Buf;                  /*!< Circular buffer of 2 x u32HalfLen words */
+    uint32_t u32HalfLen;                /*!< Words per buffer half */
+    uint32_t u32Group;                  /*!< BMC channel group, \ref BMC_GROUP_0 ~ \ref BMC_GROUP_7 */
+    uint32_t u32PdmaCh;                 /*!< PDMA channel feeding the group */
+    volatile uint32_t u32Filled;        /*!< Bit n set when half n holds data not played yet, or is being replayed */
+    volatile uint32_t u32Playing;       /*!< Half currently transferred by PDMA */
+    uint32_t u32WrHalf;                 /*!< Half returned by the last BMC_StreamGetBuf() */
+    volatile uint32_t u32Late;          /*!< Halves replayed because they were not refilled in time */
+    volatile uint32_t u32Underrun;      /*!< Transmit data under run events of the group */
+} S_BMC_STREAM_T;
+
+/*@}*/ /* end of group BMC_EXPORTED_STRUCTS */
+
+
 /** @addtogroup BMC_EXPORTED_FUNCTIONS BMC Exported Functions
   @{
 */
@@ -213,6 +240,12 @@ uint32_t BMC_GetIntFlag(uint32_t u32Mask);
 void BMC_ClearIntFlag(uint32_t u32Mask);
 uint32_t BMC_GetStatus(uint32_t u32Mask);
 void BMC_ClearStatus(uint32_t u32Mask);
+int32_t BMC_StreamOpen(PDMA_T *pdma, S_BMC_STREAM_T *psStream, uint32_t u32Group, uint32_t u32PdmaCh, uint32_t *pu32Buf, uint32_t u32HalfLen);
+uint32_t *BMC_StreamGetBuf(S_BMC_STREAM_T *psStream);
+void BMC_StreamCommit(S_BMC_STREAM_T *psStream);
+void BMC_StreamStart(S_BMC_STREAM_T *apsStream[], uint32_t u32Num);
+void BMC_StreamStop(PDMA_T *pdma, S_BMC_STREAM_T *apsStream[], uint32_t u32Num);
+void BMC_StreamIRQHandler(PDMA_T *pdma, S_BMC_STREAM_T *psStream);
 
 
 /*@}*/ /* end of group BMC_EXPORTED_FUNCTIONS */
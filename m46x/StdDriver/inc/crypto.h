@@ -104,11 +104,32 @@ extern "C"
 #define CRYPTO_DMA_CONTINUE     (0x6UL)   /*!< Do continuous encrypt/decrypt in DMA cascade \hideinitializer */
 #define CRYPTO_DMA_LAST         (0x7UL)   /*!< Do last encrypt/decrypt in DMA cascade          \hideinitializer */
 
+#define CRPT_JOB_AES            (0UL)     /*!< Job runs on the AES engine              \hideinitializer */
+#define CRPT_JOB_SHA            (1UL)     /*!< Job runs on the SHA/HMAC engine         \hideinitializer */
+#define CRPT_JOB_RSA            (2UL)     /*!< Job runs on the RSA engine              \hideinitializer */
+#define CRPT_JOB_ENGINE_NUM     (3UL)     /*!< Engines of the job scheduler            \hideinitializer */
+#ifndef CRPT_JOB_OVERTAKE_MAX
+#define CRPT_JOB_OVERTAKE_MAX   (4UL)     /*!< Higher priority jobs that may start before a waiting job \hideinitializer */
+#endif
+#define CRPT_JOB_TIMEOUT        SystemCoreClock   /*!< Polls of \ref CRPT_JobWait before it gives up \hideinitializer */
+
+#define CRPT_JOB_OK             ( 0L)     /*!< Job finished                            \hideinitializer */
+#define CRPT_JOB_QUEUED         ( 1L)     /*!< Job waits for its engine                \hideinitializer */
+#define CRPT_JOB_RUNNING        ( 2L)     /*!< Job runs on its engine                  \hideinitializer */
+#define CRPT_JOB_ERR_ENGINE     (-1L)     /*!< Engine reported an error                \hideinitializer */
+#define CRPT_JOB_ERR_PARAM      (-2L)     /*!< Invalid job                             \hideinitializer */
+#define CRPT_JOB_ERR_BUSY       (-3L)     /*!< Job is queued or running                \hideinitializer */
+#define CRPT_JOB_ERR_TIMEOUT    (-4L)     /*!< Job did not finish in time              \hideinitializer */
+#define CRPT_JOB_ERR_CANCEL     (-5L)     /*!< Job was removed from its queue          \hideinitializer */
+
 //---------------------------------------------------
 
-#define RSA_MAX_KLEN            (4096)
+#ifndef RSA_MAX_KLEN
+#define RSA_MAX_KLEN            (4096)    /*!< Largest RSA key length in bits the RSA buffers are sized for (1024, 2048, 3072 or 4096) \hideinitializer */
+#endif
 #define RSA_KBUF_HLEN           (RSA_MAX_KLEN/4 + 8)
 #define RSA_KBUF_BLEN           (RSA_MAX_KLEN + 32)
+#define RSA_BUF_WLEN            (RSA_MAX_KLEN/32) /*!< Words of each RSA working buffer \hideinitializer */
 
 #define RSA_KEY_SIZE_1024       (0UL)     /*!< RSA select 1024-bit key length           \hideinitializer */
 #define RSA_KEY_SIZE_2048       (1UL)     /*!< RSA select 2048-bit key length           \hideinitializer */
@@ -119,6 +140,19 @@ extern "C"
 #define RSA_MODE_CRT            (0x004UL)     /*!< RSA select CRT mode                   \hideinitializer */
 #define RSA_MODE_CRTBYPASS      (0x00CUL)     /*!< RSA select CRT bypass mode            \hideinitializer */
 
+#define ECC_CURVE_GROUP_P       (0x01UL)  /*!< ECC curves P-192 to P-521               \hideinitializer */
+#define ECC_CURVE_GROUP_B       (0x02UL)  /*!< ECC curves B-163 to B-571               \hideinitializer */
+#define ECC_CURVE_GROUP_K       (0x04UL)  /*!< ECC curves K-163 to K-571               \hideinitializer */
+#define ECC_CURVE_GROUP_KO      (0x08UL)  /*!< ECC Koblitz curves KO-192 to KO-256     \hideinitializer */
+#define ECC_CURVE_GROUP_BP      (0x10UL)  /*!< ECC Brainpool curves BP-256 to BP-512   \hideinitializer */
+#define ECC_CURVE_GROUP_25519   (0x20UL)  /*!< ECC curve-25519                         \hideinitializer */
+#define ECC_CURVE_GROUP_SM2     (0x40UL)  /*!< ECC curve SM2                           \hideinitializer */
+#define ECC_CURVE_GROUP_ALL     (0x7FUL)  /*!< All ECC curves                          \hideinitializer */
+
+#ifndef ECC_CURVE_GROUPS
+#define ECC_CURVE_GROUPS        ECC_CURVE_GROUP_ALL /*!< ECC curve groups built into the driver, other curves return an error \hideinitializer */
+#endif
+
 
 typedef enum
 {
@@ -175,39 +209,76 @@ typedef struct e_curve_t
 /* RSA working buffer for normal mode */
 typedef struct
 {
-    uint32_t au32RsaOutput[128]; /* The RSA answer. */
-    uint32_t au32RsaN[128]; /* The base of modulus operation word. */
-    uint32_t au32RsaM[128]; /* The base of exponentiation words. */
-    uint32_t au32RsaE[128]; /* The exponent of exponentiation words. */
+    uint32_t au32RsaOutput[RSA_BUF_WLEN]; /* The RSA answer. */
+    uint32_t au32RsaN[RSA_BUF_WLEN]; /* The base of modulus operation word. */
+    uint32_t au32RsaM[RSA_BUF_WLEN]; /* The base of exponentiation words. */
+    uint32_t au32RsaE[RSA_BUF_WLEN]; /* The exponent of exponentiation words. */
 } RSA_BUF_NORMAL_T;
 
 /* RSA working buffer for CRT ( + CRT bypass) mode */
 typedef struct
 {
-    uint32_t au32RsaOutput[128]; /* The RSA answer. */
-    uint32_t au32RsaN[128]; /* The base of modulus operation word. */
-    uint32_t au32RsaM[128]; /* The base of exponentiation words. */
-    uint32_t au32RsaE[128]; /* The exponent of exponentiation words. */
-    uint32_t au32RsaP[128]; /* The Factor of Modulus Operation. */
-    uint32_t au32RsaQ[128]; /* The Factor of Modulus Operation. */
-    uint32_t au32RsaTmpCp[128]; /* The Temporary Value(Cp) of RSA CRT. */
-    uint32_t au32RsaTmpCq[128]; /* The Temporary Value(Cq) of RSA CRT. */
-    uint32_t au32RsaTmpDp[128]; /* The Temporary Value(Dp) of RSA CRT. */
-    uint32_t au32RsaTmpDq[128]; /* The Temporary Value(Dq) of RSA CRT. */
-    uint32_t au32RsaTmpRp[128]; /* The Temporary Value(Rp) of RSA CRT. */
-    uint32_t au32RsaTmpRq[128]; /* The Temporary Value(Rq) of RSA CRT. */
+    uint32_t au32RsaOutput[RSA_BUF_WLEN]; /* The RSA answer. */
+    uint32_t au32RsaN[RSA_BUF_WLEN]; /* The base of modulus operation word. */
+    uint32_t au32RsaM[RSA_BUF_WLEN]; /* The base of exponentiation words. */
+    uint32_t au32RsaE[RSA_BUF_WLEN]; /* The exponent of exponentiation words. */
+    uint32_t au32RsaP[RSA_BUF_WLEN]; /* The Factor of Modulus Operation. */
+    uint32_t au32RsaQ[RSA_BUF_WLEN]; /* The Factor of Modulus Operation. */
+    uint32_t au32RsaTmpCp[RSA_BUF_WLEN]; /* The Temporary Value(Cp) of RSA CRT. */
+    uint32_t au32RsaTmpCq[RSA_BUF_WLEN]; /* The Temporary Value(Cq) of RSA CRT. */
+    uint32_t au32RsaTmpDp[RSA_BUF_WLEN]; /* The Temporary Value(Dp) of RSA CRT. */
+    uint32_t au32RsaTmpDq[RSA_BUF_WLEN]; /* The Temporary Value(Dq) of RSA CRT. */
+    uint32_t au32RsaTmpRp[RSA_BUF_WLEN]; /* The Temporary Value(Rp) of RSA CRT. */
+    uint32_t au32RsaTmpRq[RSA_BUF_WLEN]; /* The Temporary Value(Rq) of RSA CRT. */
 } RSA_BUF_CRT_T;
 
 /* RSA working buffer for using key store */
 typedef struct
 {
-    uint32_t au32RsaOutput[128]; /* The RSA answer. */
-    uint32_t au32RsaN[128]; /* The base of modulus operation word. */
-    uint32_t au32RsaM[128]; /* The base of exponentiation words. */
+    uint32_t au32RsaOutput[RSA_BUF_WLEN]; /* The RSA answer. */
+    uint32_t au32RsaN[RSA_BUF_WLEN]; /* The base of modulus operation word. */
+    uint32_t au32RsaM[RSA_BUF_WLEN]; /* The base of exponentiation words. */
 } RSA_BUF_KS_T;
 
 /**@}*/ /* end of group CRYPTO_EXPORTED_CONSTANTS */
 
+/** @addtogroup CRYPTO_EXPORTED_STRUCTS CRYPTO Exported Structs
+  @{
+*/
+
+/**
+  * @details    AES key context of a session, see AES_CtxLoad
+  */
+typedef struct
+{
+    uint32_t au32Key[8];                /*!< Key words, as for AES_SetKey */
+    uint32_t u32KeySize;                /*!< AES_KEY_SIZE_128, AES_KEY_SIZE_192 or AES_KEY_SIZE_256 */
+    uint32_t u32KsCtl;                  /*!< AES_KSCTL for a Key Store key, 0 for au32Key */
+    uint32_t u32KeyGen;                 /*!< Driver private, changes whenever the key changes */
+} S_AES_CTX_T;
+
+typedef struct S_CRPT_JOB S_CRPT_JOB_T;     /*!< Job of the crypto job scheduler */
+
+typedef void (*CRPT_JOB_START_FUNC)(CRPT_T *crpt, S_CRPT_JOB_T *psJob);                  /*!< Programs and starts the engine of the job */
+typedef void (*CRPT_JOB_DONE_FUNC)(CRPT_T *crpt, S_CRPT_JOB_T *psJob, int32_t i32Status); /*!< Called from the interrupt when the job finished */
+
+/**
+  * @details    Job of the crypto job scheduler, owned by the caller until it finished
+  */
+struct S_CRPT_JOB
+{
+    uint32_t u32Engine;                 /*!< CRPT_JOB_AES, CRPT_JOB_SHA, ... */
+    uint32_t u32Priority;               /*!< Higher runs first, FIFO among equal priorities */
+    CRPT_JOB_START_FUNC pfnStart;       /*!< e.g. AES_Open, AES_SetKey, AES_SetDMATransfer and AES_Start */
+    CRPT_JOB_DONE_FUNC  pfnDone;        /*!< e.g. SHA_Read, NULL if not used */
+    void *pvUser;                       /*!< Caller data, not used by the scheduler */
+    volatile int32_t i32Status;         /*!< CRPT_JOB_QUEUED, CRPT_JOB_RUNNING, CRPT_JOB_OK or an error */
+    uint32_t u32Overtaken;              /*!< Scheduler private */
+    S_CRPT_JOB_T *psNext;               /*!< Scheduler private */
+};
+
+/**@}*/ /* end of group CRYPTO_EXPORTED_STRUCTS */
+
 
 /** @addtogroup CRYPTO_EXPORTED_MACROS CRYPTO Exported Macros
   @{
@@ -431,6 +502,7 @@ int32_t RSA_Open(CRPT_T *crpt, uint32_t u32OpMode, uint32_t u32KeySize, void *ps
 int32_t RSA_SetKey(CRPT_T *crpt, char *Key);
 int32_t RSA_SetDMATransfer(CRPT_T *crpt, char *Src, char *n, char *P, char *Q);
 void RSA_Start(CRPT_T *crpt);
+int32_t RSA_WaitStep(void *pvCtx, uint32_t u32Offset, uint32_t u32Count);
 int32_t RSA_Read(CRPT_T *crpt, char * Output);
 int32_t RSA_SetKey_KS(CRPT_T *crpt, uint32_t u32KeyNum, uint32_t u32KSMemType, uint32_t u32BlindKeyNum);
 int32_t RSA_SetDMATransfer_KS(CRPT_T *crpt, char *Src, char *n, uint32_t u32PNum,
@@ -444,6 +516,16 @@ int32_t  ECC_GenerateSecretZ_KS(CRPT_T *crpt, E_ECC_CURVE ecc_curve, KS_MEM_Type
 void CRPT_Reg2Hex(int32_t count, uint32_t volatile reg[], char output[]);
 void CRPT_Hex2Reg(char input[], uint32_t volatile reg[]);
 int32_t ECC_GetCurve(CRPT_T *crpt, E_ECC_CURVE ecc_curve, ECC_CURVE *curve);
+void AES_CtxSetKey(S_AES_CTX_T *psCtx, uint32_t au32Keys[], uint32_t u32KeySize);
+void AES_CtxSetKey_KS(S_AES_CTX_T *psCtx, KS_MEM_Type mem, int32_t i32KeyIdx);
+void AES_CtxLoad(CRPT_T *crpt, uint32_t u32Channel, S_AES_CTX_T *psCtx, uint32_t au32IV[]);
+void AES_CtxInvalidate(S_AES_CTX_T *psCtx);
+void AES_InvalidateKeyCache(CRPT_T *crpt);
+void CRPT_JobInit(CRPT_T *crpt);
+int32_t CRPT_JobSubmit(CRPT_T *crpt, S_CRPT_JOB_T *psJob);
+int32_t CRPT_JobCancel(CRPT_T *crpt, S_CRPT_JOB_T *psJob);
+int32_t CRPT_JobWait(CRPT_T *crpt, S_CRPT_JOB_T *psJob);
+void CRPT_JobIRQHandler(CRPT_T *crpt);
 
 /**@}*/ /* end of group CRYPTO_EXPORTED_FUNCTIONS */
 
@@ -188,14 +188,17 @@ __STATIC_INLINE uint32_t FMC_ReadCID(void)
     FMC->ISPCMD = FMC_ISPCMD_READ_CID;           /* Set ISP Command Code */
     FMC->ISPADDR = 0x0u;                         /* Must keep 0x0 when read CID */
     FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;          /* Trigger to start ISP procedure */
+    NVT_WAIT_BEGIN(WAIT_SITE_FMC_READ);
     while(FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk)    /* Waiting for ISP Done */
     {
         if( i32TimeOutCnt-- <= 0)
         {
             g_FMC_i32ErrCode = -1;
+            NVT_WAIT_END(WAIT_SITE_FMC_READ);
             return 0xFFFFFFFF;
         }
     }
+    NVT_WAIT_END(WAIT_SITE_FMC_READ);
 
     return FMC->ISPDAT;
 }
@@ -218,14 +221,17 @@ __STATIC_INLINE uint32_t FMC_ReadPID(void)
     FMC->ISPCMD = FMC_ISPCMD_READ_DID;          /* Set ISP Command Code */
     FMC->ISPADDR = 0x04u;                       /* Must keep 0x4 when read PID */
     FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;         /* Trigger to start ISP procedure */
+    NVT_WAIT_BEGIN(WAIT_SITE_FMC_READ);
     while(FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk)   /* Waiting for ISP Done */
     {
         if( i32TimeOutCnt-- <= 0)
         {
             g_FMC_i32ErrCode = -1;
+            NVT_WAIT_END(WAIT_SITE_FMC_READ);
             return 0xFFFFFFFF;
         }
     }
+    NVT_WAIT_END(WAIT_SITE_FMC_READ);
 
     return FMC->ISPDAT;
 }
@@ -249,14 +255,17 @@ __STATIC_INLINE uint32_t FMC_ReadUID(uint8_t u8Index)
     FMC->ISPADDR = ((uint32_t)u8Index << 2u);
     FMC->ISPDAT = 0u;
     FMC->ISPTRG = 0x1u;
+    NVT_WAIT_BEGIN(WAIT_SITE_FMC_READ);
     while(FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk)   /* Waiting for ISP Done */
     {
         if( i32TimeOutCnt-- <= 0)
         {
             g_FMC_i32ErrCode = -1;
+            NVT_WAIT_END(WAIT_SITE_FMC_READ);
             return 0xFFFFFFFF;
         }
     }
+    NVT_WAIT_END(WAIT_SITE_FMC_READ);
 
     return FMC->ISPDAT;
 }
@@ -279,14 +288,17 @@ __STATIC_INLINE uint32_t FMC_ReadUCID(uint32_t u32Index)
     FMC->ISPCMD = FMC_ISPCMD_READ_UID;            /* Set ISP Command Code */
     FMC->ISPADDR = (0x04u * u32Index) + 0x10u;    /* The UCID is at offset 0x10 with word alignment. */
     FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;           /* Trigger to start ISP procedure */
+    NVT_WAIT_BEGIN(WAIT_SITE_FMC_READ);
     while(FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk)     /* Waiting for ISP Done */
     {
         if( i32TimeOutCnt-- <= 0)
         {
             g_FMC_i32ErrCode = -1;
+            NVT_WAIT_END(WAIT_SITE_FMC_READ);
             return 0xFFFFFFFF;
         }
     }
+    NVT_WAIT_END(WAIT_SITE_FMC_READ);
 
     return FMC->ISPDAT;
 }
@@ -334,6 +346,7 @@ extern void     FMC_Close(void);
 extern int32_t  FMC_ConfigXOM(uint32_t xom_num, uint32_t xom_base, uint8_t xom_page);
 extern int32_t  FMC_Erase(uint32_t u32PageAddr);
 extern int32_t  FMC_Erase_Bank(uint32_t u32BankAddr);
+extern int32_t  FMC_EraseStep(void *pvCtx, uint32_t u32Offset, uint32_t u32Count);
 extern int32_t  FMC_EraseXOM(uint32_t xom_num);
 extern int32_t  FMC_GetXOMState(uint32_t xom_num);
 extern int32_t  FMC_GetBootSource(void);
@@ -62,8 +62,94 @@ extern "C"
 #define I2C_ERR_FAIL    (-1L)            /*!< I2C operation failed                                                        \hideinitializer */
 #define I2C_ERR_TIMEOUT (-2L)            /*!< I2C operation abort due to timeout error                                    \hideinitializer */
 
+/*---------------------------------------------------------------------------------------------------------*/
+/*  I2C SMBus transaction engine constant definitions.                                                     */
+/*---------------------------------------------------------------------------------------------------------*/
+#define I2C_SMBUS_PROTO_SEND_BYTE       0U  /*!< Command code only                                                      \hideinitializer */
+#define I2C_SMBUS_PROTO_RECV_BYTE       1U  /*!< One byte read without command code                                     \hideinitializer */
+#define I2C_SMBUS_PROTO_WRITE_BYTE      2U  /*!< Command code and one data byte                                         \hideinitializer */
+#define I2C_SMBUS_PROTO_READ_BYTE       3U  /*!< Command code, repeated START and one data byte                         \hideinitializer */
+#define I2C_SMBUS_PROTO_WRITE_WORD      4U  /*!< Command code and two data bytes, low byte first                        \hideinitializer */
+#define I2C_SMBUS_PROTO_READ_WORD       5U  /*!< Command code, repeated START and two data bytes                        \hideinitializer */
+#define I2C_SMBUS_PROTO_PROC_CALL       6U  /*!< Write word, repeated START and read word                               \hideinitializer */
+#define I2C_SMBUS_PROTO_BLOCK_WRITE     7U  /*!< Command code, byte count and data                                      \hideinitializer */
+#define I2C_SMBUS_PROTO_BLOCK_READ      8U  /*!< Command code, repeated START, byte count and data                      \hideinitializer */
+#define I2C_SMBUS_PROTO_BLOCK_PROC_CALL 9U  /*!< Block write, repeated START and block read                             \hideinitializer */
+
+#define I2C_SMBUS_BLOCK_MAX             255U    /*!< Maximum byte count of a block transfer                             \hideinitializer */
+#define I2C_SMBUS_ARP_ADDR              0x61U   /*!< SMBus Device Default Address used by ARP                           \hideinitializer */
+#define I2C_SMBUS_TIMEOUT               SystemCoreClock /*!< Wait time-out counter of I2C_SMBusWait (1 second time-out) \hideinitializer */
+
+#define I2C_SMBUS_OK                    ( 0L)   /*!< Transaction done                                                   \hideinitializer */
+#define I2C_SMBUS_BUSY                  ( 1L)   /*!< Transaction in progress                                            \hideinitializer */
+#define I2C_SMBUS_ERR_NACK              (-1L)   /*!< Address or data not acknowledged                                   \hideinitializer */
+#define I2C_SMBUS_ERR_PEC               (-2L)   /*!< Received PEC does not match                                        \hideinitializer */
+#define I2C_SMBUS_ERR_SIZE              (-3L)   /*!< Block byte count is zero or does not fit the buffer                \hideinitializer */
+#define I2C_SMBUS_ERR_ARB               (-4L)   /*!< Arbitration lost                                                   \hideinitializer */
+#define I2C_SMBUS_ERR_BUS               (-5L)   /*!< Bus error or unexpected status                                     \hideinitializer */
+#define I2C_SMBUS_ERR_TIMEOUT           (-6L)   /*!< Bus time-out or transaction did not finish                         \hideinitializer */
+#define I2C_SMBUS_ERR_BUSY              (-7L)   /*!< Port is running another transaction                                \hideinitializer */
+#define I2C_SMBUS_ERR_PARAM             (-8L)   /*!< Invalid parameter                                                  \hideinitializer */
+
+/*---------------------------------------------------------------------------------------------------------*/
+/*  I2C target engine constant definitions.                                                                */
+/*---------------------------------------------------------------------------------------------------------*/
+#ifndef I2C_TARGET_PDMA
+#define I2C_TARGET_PDMA                 0       /*!< 1 to move long target transfers by PDMA, i2c.c then needs pdma.c   \hideinitializer */
+#endif
+
+#define I2C_TARGET_MAP_MAX              4U      /*!< Register maps per port, one per own address register               \hideinitializer */
+#define I2C_TARGET_IDLE_BYTE            0xFFU   /*!< Byte sent for reads past the end of a register map                 \hideinitializer */
+
+#define I2C_TARGET_OK                   ( 0L)   /*!< Target engine operation OK                                         \hideinitializer */
+#define I2C_TARGET_ERR_PARAM            (-1L)   /*!< Invalid parameter                                                  \hideinitializer */
+
 /*@}*/ /* end of group I2C_EXPORTED_CONSTANTS */
 
+/** @addtogroup I2C_EXPORTED_STRUCTS I2C Exported Structs
+  @{
+*/
+
+/**
+  * @details    One SMBus transaction of the transaction engine
+  */
+typedef struct
+{
+    uint8_t  u8Addr;                /*!< 7-bit target address */
+    uint8_t  u8Proto;               /*!< Protocol, I2C_SMBUS_PROTO_xxx */
+    uint8_t  u8Cmd;                 /*!< Command code */
+    uint8_t  u8Pec;                 /*!< 1 to append PEC to writes and check it on reads */
+    uint8_t  u8TxLen;               /*!< Bytes in pu8Tx, fixed by the protocol except for block writes */
+    uint8_t  u8RxLen;               /*!< In: size of pu8Rx. Out: bytes received, the byte count for block reads */
+    uint8_t *pu8Tx;                 /*!< Data written after the command code (and byte count) */
+    uint8_t *pu8Rx;                 /*!< Data read after the repeated START (and byte count) */
+    int32_t  i32Status;             /*!< Result, I2C_SMBUS_OK or I2C_SMBUS_ERR_xxx */
+} S_I2C_SMBUS_MSG_T;
+
+typedef void (*I2C_SMBUS_DONE_FUNC)(I2C_T *i2c, void *pvUser, int32_t i32Status);    /*!< Called from the interrupt when a transaction list finished */
+
+typedef struct S_I2C_TARGET_MAP S_I2C_TARGET_MAP_T;     /*!< Register map of the target engine */
+
+typedef void (*I2C_TARGET_READ_FUNC)(S_I2C_TARGET_MAP_T *psMap);                                    /*!< Called at SLA+R, before the first byte is sent */
+typedef void (*I2C_TARGET_WRITE_FUNC)(S_I2C_TARGET_MAP_T *psMap, uint16_t u16Reg, uint16_t u16Len);  /*!< Called at STOP or repeated START after registers were written */
+
+/**
+  * @details    Virtual register map served at one own address
+  */
+struct S_I2C_TARGET_MAP
+{
+    uint8_t  u8Addr;                /*!< 7-bit own address */
+    uint8_t  u8PtrLen;              /*!< Register pointer bytes the host writes first, 1 or 2 (MSB first) */
+    uint16_t u16Size;               /*!< Bytes in pu8Regs */
+    uint16_t u16WrLimit;            /*!< Registers from this offset on are read-only, u16Size if all are writable */
+    uint16_t u16Ptr;                /*!< Register pointer, auto-incremented and kept between transfers */
+    uint8_t *pu8Regs;               /*!< Register contents */
+    I2C_TARGET_READ_FUNC  pfnRead;  /*!< May refresh pu8Regs before a read, NULL if not used */
+    I2C_TARGET_WRITE_FUNC pfnWrite; /*!< Reports written registers, NULL if not used */
+};
+
+/*@}*/ /* end of group I2C_EXPORTED_STRUCTS */
+
 extern int32_t g_I2C_i32ErrCode;
 
 /** @addtogroup I2C_EXPORTED_FUNCTIONS I2C Exported Functions
@@ -452,10 +538,12 @@ __STATIC_INLINE void I2C_STOP(I2C_T *i2c)
     uint32_t u32TimeOutCount = I2C_TIMEOUT;
 
     (i2c)->CTL0 |= (I2C_CTL0_SI_Msk | I2C_CTL0_STO_Msk);
+    NVT_WAIT_BEGIN(WAIT_SITE_I2C);
     while(i2c->CTL0 & I2C_CTL0_STO_Msk)
     {
         if(--u32TimeOutCount == 0) break;
     }
+    NVT_WAIT_END(WAIT_SITE_I2C);
 }
 
 void I2C_ClearTimeoutFlag(I2C_T *i2c);
@@ -498,6 +586,24 @@ uint8_t I2C_SMBusGetPECValue(I2C_T *i2c);
 void I2C_SMBusIdleTimeout(I2C_T *i2c, uint32_t us, uint32_t u32Hclk);
 void I2C_SMBusTimeout(I2C_T *i2c, uint32_t ms, uint32_t u32Pclk);
 void I2C_SMBusClockLoTimeout(I2C_T *i2c, uint32_t ms, uint32_t u32Pclk);
+int32_t I2C_SMBusXfer(I2C_T *i2c, S_I2C_SMBUS_MSG_T asMsg[], uint32_t u32MsgCnt, I2C_SMBUS_DONE_FUNC pfnDone, void *pvUser);
+int32_t I2C_SMBusWait(I2C_T *i2c);
+void I2C_SMBusIRQHandler(I2C_T *i2c);
+int32_t I2C_SMBusBlockWrite(I2C_T *i2c, uint8_t u8Addr, uint8_t u8Cmd, uint8_t au8Data[], uint8_t u8Len, uint8_t u8Pec);
+int32_t I2C_SMBusBlockRead(I2C_T *i2c, uint8_t u8Addr, uint8_t u8Cmd, uint8_t au8Data[], uint8_t *pu8Len, uint8_t u8Pec);
+int32_t I2C_SMBusProcessCall(I2C_T *i2c, uint8_t u8Addr, uint8_t u8Cmd, uint16_t u16Data, uint16_t *pu16Rsp, uint8_t u8Pec);
+int32_t I2C_SMBusBlockProcessCall(I2C_T *i2c, uint8_t u8Addr, uint8_t u8Cmd, uint8_t au8Data[], uint8_t u8Len,
+                                  uint8_t au8Rsp[], uint8_t *pu8RspLen, uint8_t u8Pec);
+int32_t I2C_SMBusArpPrepare(I2C_T *i2c);
+int32_t I2C_SMBusArpReset(I2C_T *i2c);
+int32_t I2C_SMBusArpGetUdid(I2C_T *i2c, uint8_t au8Udid[17]);
+int32_t I2C_SMBusArpAssign(I2C_T *i2c, const uint8_t au8Udid[16], uint8_t u8Addr);
+int32_t I2C_TargetOpen(I2C_T *i2c, S_I2C_TARGET_MAP_T asMap[], uint32_t u32MapCnt);
+void I2C_TargetClose(I2C_T *i2c);
+void I2C_TargetIRQHandler(I2C_T *i2c);
+#if I2C_TARGET_PDMA
+int32_t I2C_TargetSetPdma(I2C_T *i2c, PDMA_T *pdma, uint32_t u32TxCh, uint32_t u32RxCh, uint32_t u32Threshold);
+#endif
 
 /*@}*/ /* end of group I2C_EXPORTED_FUNCTIONS */
 
@@ -41,6 +41,13 @@ typedef struct {
     uint16_t    st;
 } KPI_KEY_T;
 
+typedef struct {
+    KPI_KEY_T   key;        /* Key position and press/release state */
+    uint32_t    u32Time;    /* Tick count when the key event was serviced */
+} KPI_EVENT_T;
+
+typedef uint32_t (*KPI_TICK_FUNC)(void);
+
 /**@}*/ /* end of group KPI_EXPORTED_CONSTANTS */
 
 
@@ -54,6 +61,12 @@ int32_t KPI_kbhit(void);
 KPI_KEY_T KPI_GetKey(void);
 void KPI_SetSampleTime(uint32_t ms);
 void KPI_EnableSlowScan(void);
+void KPI_DisableSlowScan(void);
+int32_t KPI_SetEventQueue(KPI_EVENT_T *pEventQueue, uint32_t u32MaxEventCnt, KPI_TICK_FUNC pfnGetTick);
+int32_t KPI_GetEvent(KPI_EVENT_T *pEvent);
+int32_t KPI_WaitEvent(KPI_EVENT_T *pEvent, uint32_t u32Timeout);
+uint32_t KPI_GetOverflowCount(void);
+void KPI_EnableAutoSlowScan(uint32_t u32Enable);
 /**@}*/ /* end of group KPI_EXPORTED_FUNCTIONS */
 
 /**@}*/ /* end of group KPI_Driver */
@@ -0,0 +1,134 @@
+/**************************************************************************//**
+ * @file     nu_async.h
+ * @version  V1.00
+ * @brief    Interrupt driven DMA and CAN queues on the series independent driver interface
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2024 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __NU_ASYNC_H__
+#define __NU_ASYNC_H__
+
+#include "nu_drv.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup NU_ASYNC_Driver NU_ASYNC Driver
+  @{
+*/
+
+/*
+ * A DMA channel queue runs the requests submitted to one channel of a PDMA (or LPPDMA) one after
+ * the other. The next request is started and the completion callback of the finished one is
+ * called from NU_DmaChanIRQHandler(), which the interrupt handler of the controller calls for each
+ * channel it owns.
+ *
+ * A CAN transmit queue keeps the frames that find the transmit buffer busy and sends them from
+ * NU_CanTxqIRQHandler(), which the interrupt handler of the controller calls on transmit complete.
+ *
+ * Both work through the operation tables of nu_drv.h, so the same code runs on every series and
+ * on either controller of M2L31.
+ */
+
+/** @addtogroup NU_ASYNC_EXPORTED_CONSTANTS NU_ASYNC Exported Constants
+  @{
+*/
+
+#ifndef NU_CAN_TXQ_LEN
+#define NU_CAN_TXQ_LEN          (8UL)     /*!< Frames a CAN transmit queue holds, a power of 2 \hideinitializer */
+#endif
+
+#define NU_ASYNC_OK             ( 0L)     /*!< Request finished                        \hideinitializer */
+#define NU_ASYNC_QUEUED         ( 1L)     /*!< Request waits for its channel           \hideinitializer */
+#define NU_ASYNC_RUNNING        ( 2L)     /*!< Request runs on its channel             \hideinitializer */
+#define NU_ASYNC_ERR_ABORT      (-1L)     /*!< Transfer was aborted by the controller  \hideinitializer */
+#define NU_ASYNC_ERR_PARAM      (-2L)     /*!< Invalid request                         \hideinitializer */
+#define NU_ASYNC_ERR_BUSY       (-3L)     /*!< Request is queued or running            \hideinitializer */
+#define NU_ASYNC_ERR_FULL       (-4L)     /*!< Queue is full, the frame was dropped    \hideinitializer */
+
+/*@}*/ /* end of group NU_ASYNC_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup NU_ASYNC_EXPORTED_STRUCTS NU_ASYNC Exported Structs
+  @{
+*/
+
+typedef struct S_NU_DMA_REQ S_NU_DMA_REQ_T;    /*!< Request of a DMA channel queue */
+
+typedef void (*NU_ASYNC_DONE_FUNC)(void *pvUser, int32_t i32Status);    /*!< Called from the interrupt when the request finished */
+
+/**
+  * @details    Request of a DMA channel queue, owned by the caller until it finished
+  */
+struct S_NU_DMA_REQ
+{
+    S_NU_DMA_XFER_T sXfer;              /*!< Transfer of the request */
+    NU_ASYNC_DONE_FUNC pfnDone;         /*!< Completion callback, NULL if not used */
+    void *pvUser;                       /*!< Caller data, passed to pfnDone */
+    volatile int32_t i32Status;         /*!< NU_ASYNC_QUEUED, NU_ASYNC_RUNNING, NU_ASYNC_OK or NU_ASYNC_ERR_ABORT */
+    S_NU_DMA_REQ_T *psNext;             /*!< Queue private */
+};
+
+/**
+  * @details    Request queue of one DMA channel
+  */
+typedef struct
+{
+    const S_NU_DMA_OPS_T *psOps;        /*!< e.g. NU_PDMA_OPS */
+    void *pvPort;                       /*!< PDMA (or LPPDMA) base address */
+    uint32_t u32Ch;                     /*!< Channel */
+    S_NU_DMA_REQ_T *psHead;             /*!< Running request, NULL when idle */
+    S_NU_DMA_REQ_T *psTail;             /*!< Last queued request */
+    volatile uint32_t u32Done;          /*!< Requests finished */
+    volatile uint32_t u32Aborts;        /*!< Requests aborted */
+} S_NU_DMA_CHAN_T;
+
+/**
+  * @details    CAN transmit queue of one transmit buffer
+  */
+typedef struct
+{
+    const S_NU_CAN_OPS_T *psOps;        /*!< e.g. NU_CANFD_OPS */
+    void *pvPort;                       /*!< CAN or CANFD base address */
+    uint32_t u32Buf;                    /*!< Message object or Tx buffer */
+    S_NU_CAN_FRAME_T asFrame[NU_CAN_TXQ_LEN];   /*!< Frames waiting for the buffer */
+    volatile uint32_t u32Head;          /*!< Next frame to send */
+    volatile uint32_t u32Tail;          /*!< Next free entry */
+    volatile uint32_t u32InFlight;      /*!< 1 while a frame of the queue is in the buffer */
+    volatile uint32_t u32Sent;          /*!< Frames sent */
+    volatile uint32_t u32Drops;         /*!< Frames dropped because the queue was full */
+} S_NU_CAN_TXQ_T;
+
+/*@}*/ /* end of group NU_ASYNC_EXPORTED_STRUCTS */
+
+
+/** @addtogroup NU_ASYNC_EXPORTED_FUNCTIONS NU_ASYNC Exported Functions
+  @{
+*/
+
+void    NU_DmaChanInit(S_NU_DMA_CHAN_T *psChan, const S_NU_DMA_OPS_T *psOps, void *pvPort, uint32_t u32Ch);
+int32_t NU_DmaChanSubmit(S_NU_DMA_CHAN_T *psChan, S_NU_DMA_REQ_T *psReq);
+void    NU_DmaChanIRQHandler(S_NU_DMA_CHAN_T *psChan);
+
+void    NU_CanTxqInit(S_NU_CAN_TXQ_T *psTxq, const S_NU_CAN_OPS_T *psOps, void *pvPort, uint32_t u32Buf);
+int32_t NU_CanTxqSend(S_NU_CAN_TXQ_T *psTxq, const S_NU_CAN_FRAME_T *psFrame);
+void    NU_CanTxqIRQHandler(S_NU_CAN_TXQ_T *psTxq);
+
+/*@}*/ /* end of group NU_ASYNC_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NU_ASYNC_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __NU_ASYNC_H__ */
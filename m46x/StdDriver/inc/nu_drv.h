@@ -0,0 +1,401 @@
+/**************************************************************************//**
+ * @file     nu_drv.h
+ * @version  V1.00
+ * @brief    Series independent driver interface
+ *
+ * @copyright SPDX-License-Identifier: Apache-2.0
+ * @copyright Copyright (C) 2024 Nuvoton Technology Corp. All rights reserved.
+ *****************************************************************************/
+#ifndef __NU_DRV_H__
+#define __NU_DRV_H__
+
+#include "NuMicro.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** @addtogroup Standard_Driver Standard Driver
+  @{
+*/
+
+/** @addtogroup NU_DRV_Driver NU_DRV Driver
+  @{
+*/
+
+/*
+ * The UART, SPI, I2C, PDMA, CAN and AES drivers of the M460, M480 and M2L31 series differ in names
+ * and argument types. This header gives every peripheral class one set of operations, implemented
+ * per series by inline backends named NU_<BACKEND>_<Op>. NU_<CLASS>_BACKEND names the backend of the
+ * series, so code written with NU_OP(NU_UART_BACKEND, Write)(...) compiles to a direct driver call
+ * on every series. For run-time selection, e.g. UART or LPUART on M2L31, an operation table
+ * S_NU_<CLASS>_OPS_T is filled with NU_<BACKEND>_OPS.
+ *
+ * The operations are the calls of the series drivers. nu_async.h builds interrupt driven DMA request
+ * queues and CAN transmit queues on top of the DMA and CAN operation tables.
+ */
+
+/** @addtogroup NU_DRV_EXPORTED_CONSTANTS NU_DRV Exported Constants
+  @{
+*/
+
+#define NU_OP_(backend, op)     backend##_##op
+#define NU_OP(backend, op)      NU_OP_(backend, op)     /*!< Backend operation, e.g. NU_OP(NU_UART_BACKEND, Write) \hideinitializer */
+
+#define NU_UART_BACKEND         NU_UART                 /*!< UART backend of this series \hideinitializer */
+#define NU_SPI_BACKEND          NU_SPI                  /*!< SPI backend of this series \hideinitializer */
+#define NU_I2C_BACKEND          NU_I2C                  /*!< I2C backend of this series \hideinitializer */
+#define NU_DMA_BACKEND          NU_PDMA                 /*!< DMA backend of this series \hideinitializer */
+#define NU_CAN_BACKEND          NU_CANFD                /*!< CAN backend of this series \hideinitializer */
+#define NU_AES_BACKEND          NU_AES                  /*!< AES backend of this series \hideinitializer */
+
+/*@}*/ /* end of group NU_DRV_EXPORTED_CONSTANTS */
+
+
+/** @addtogroup NU_DRV_EXPORTED_STRUCTS NU_DRV Exported Structs
+  @{
+*/
+
+/**
+  * @details    UART operations. pvPort is the UART (or LPUART) base address.
+  */
+typedef struct
+{
+    void     (*pfnOpen)(void *pvPort, uint32_t u32Baudrate);
+    void     (*pfnSetLine)(void *pvPort, uint32_t u32Baudrate, uint32_t u32DataWidth, uint32_t u32Parity, uint32_t u32StopBits);
+    uint32_t (*pfnWrite)(void *pvPort, uint8_t pu8TxBuf[], uint32_t u32WriteBytes);
+    uint32_t (*pfnRead)(void *pvPort, uint8_t pu8RxBuf[], uint32_t u32ReadBytes);
+    void     (*pfnClose)(void *pvPort);
+} S_NU_UART_OPS_T;
+
+/**
+  * @details    SPI operations. pvPort is the SPI (or LPSPI) base address.
+  */
+typedef struct
+{
+    uint32_t (*pfnOpen)(void *pvPort, uint32_t u32MasterSlave, uint32_t u32SPIMode, uint32_t u32DataWidth, uint32_t u32BusClock);
+    uint32_t (*pfnSetBusClock)(void *pvPort, uint32_t u32BusClock);
+    void     (*pfnClose)(void *pvPort);
+} S_NU_SPI_OPS_T;
+
+/**
+  * @details    I2C operations. pvPort is the I2C (or LPI2C) base address.
+  */
+typedef struct
+{
+    uint32_t (*pfnOpen)(void *pvPort, uint32_t u32BusClock);
+    uint32_t (*pfnWrite)(void *pvPort, uint8_t u8SlaveAddr, uint8_t pu8Data[], uint32_t u32Len);
+    uint32_t (*pfnRead)(void *pvPort, uint8_t u8SlaveAddr, uint8_t pu8Data[], uint32_t u32Len);
+    uint32_t (*pfnWriteReg)(void *pvPort, uint8_t u8SlaveAddr, uint8_t u8DataAddr, uint8_t pu8Data[], uint32_t u32Len);
+    uint32_t (*pfnReadReg)(void *pvPort, uint8_t u8SlaveAddr, uint8_t u8DataAddr, uint8_t pu8Data[], uint32_t u32Len);
+    void     (*pfnClose)(void *pvPort);
+} S_NU_I2C_OPS_T;
+
+/**
+  * @details    One basic DMA transfer, see PDMA_SetTransferCnt(), PDMA_SetTransferAddr() and PDMA_SetTransferMode().
+  */
+typedef struct
+{
+    uint32_t u32Peripheral;     /*!< Request source, e.g. PDMA_UART0_TX or PDMA_MEM */
+    uint32_t u32Width;          /*!< Transfer width */
+    uint32_t u32Count;          /*!< Transfer count */
+    uint32_t u32SrcAddr;        /*!< Source address */
+    uint32_t u32SrcCtrl;        /*!< Source address increment */
+    uint32_t u32DstAddr;        /*!< Destination address */
+    uint32_t u32DstCtrl;        /*!< Destination address increment */
+} S_NU_DMA_XFER_T;
+
+/**
+  * @details    DMA operations. pvPort is the PDMA (or LPPDMA) base address.
+  */
+typedef struct
+{
+    void     (*pfnOpen)(void *pvPort, uint32_t u32Mask);
+    void     (*pfnSetTransfer)(void *pvPort, uint32_t u32Ch, const S_NU_DMA_XFER_T *psXfer);
+    void     (*pfnTrigger)(void *pvPort, uint32_t u32Ch);
+    void     (*pfnEnableInt)(void *pvPort, uint32_t u32Ch, uint32_t u32Mask);
+    uint32_t (*pfnGetDone)(void *pvPort);
+    uint32_t (*pfnGetAbort)(void *pvPort);
+    void     (*pfnClearFlags)(void *pvPort, uint32_t u32Mask);
+    void     (*pfnClose)(void *pvPort);
+} S_NU_DMA_OPS_T;
+
+/**
+  * @details    Classic CAN frame.
+  */
+typedef struct
+{
+    uint32_t u32Id;             /*!< Standard (11-bit) or extended (29-bit) identifier */
+    uint8_t  u8Xtd;             /*!< 1 = extended identifier */
+    uint8_t  u8Rtr;             /*!< 1 = remote frame */
+    uint8_t  u8Dlc;             /*!< Data length, 0 ~ 8 */
+    uint8_t  au8Data[8];        /*!< Data */
+} S_NU_CAN_FRAME_T;
+
+/**
+  * @details    CAN operations. pvPort is the CAN or CANFD base address. u32Buf is the message object of
+  *             CAN, or the Tx buffer (Send) and Rx FIFO (Receive) of CANFD. Send and Receive return 0 on
+  *             success and -1 if the buffer is busy or empty. Acceptance filters are set with the driver of
+  *             the series.
+  */
+typedef struct
+{
+    void    (*pfnOpen)(void *pvPort, uint32_t u32BitRate);
+    int32_t (*pfnSend)(void *pvPort, uint32_t u32Buf, const S_NU_CAN_FRAME_T *psFrame);
+    int32_t (*pfnReceive)(void *pvPort, uint32_t u32Buf, S_NU_CAN_FRAME_T *psFrame);
+    void    (*pfnClose)(void *pvPort);
+} S_NU_CAN_OPS_T;
+
+/**
+  * @details    AES operations.
+  */
+typedef struct
+{
+    void (*pfnOpen)(CRPT_T *crpt, uint32_t u32Channel, uint32_t u32EncDec, uint32_t u32OpMode, uint32_t u32KeySize, uint32_t u32SwapType);
+    void (*pfnSetKey)(CRPT_T *crpt, uint32_t u32Channel, uint32_t au32Keys[], uint32_t u32KeySize);
+    void (*pfnSetInitVect)(CRPT_T *crpt, uint32_t u32Channel, uint32_t au32IV[]);
+    void (*pfnSetDMATransfer)(CRPT_T *crpt, uint32_t u32Channel, uint32_t u32SrcAddr, uint32_t u32DstAddr, uint32_t u32TransCnt);
+    void (*pfnStart)(CRPT_T *crpt, uint32_t u32Channel, uint32_t u32DMAMode);
+} S_NU_AES_OPS_T;
+
+/*@}*/ /* end of group NU_DRV_EXPORTED_STRUCTS */
+
+
+/** @addtogroup NU_DRV_EXPORTED_FUNCTIONS NU_DRV Exported Functions
+  @{
+*/
+
+/* UART backend */
+__STATIC_INLINE void NU_UART_Open(void *pvPort, uint32_t u32Baudrate)
+{
+    UART_Open((UART_T *)pvPort, u32Baudrate);
+}
+
+__STATIC_INLINE void NU_UART_SetLine(void *pvPort, uint32_t u32Baudrate, uint32_t u32DataWidth, uint32_t u32Parity, uint32_t u32StopBits)
+{
+    UART_SetLineConfig((UART_T *)pvPort, u32Baudrate, u32DataWidth, u32Parity, u32StopBits);
+}
+
+__STATIC_INLINE uint32_t NU_UART_Write(void *pvPort, uint8_t pu8TxBuf[], uint32_t u32WriteBytes)
+{
+    return UART_Write((UART_T *)pvPort, pu8TxBuf, u32WriteBytes);
+}
+
+__STATIC_INLINE uint32_t NU_UART_Read(void *pvPort, uint8_t pu8RxBuf[], uint32_t u32ReadBytes)
+{
+    return UART_Read((UART_T *)pvPort, pu8RxBuf, u32ReadBytes);
+}
+
+__STATIC_INLINE void NU_UART_Close(void *pvPort)
+{
+    UART_Close((UART_T *)pvPort);
+}
+
+#define NU_UART_OPS   { NU_UART_Open, NU_UART_SetLine, NU_UART_Write, NU_UART_Read, NU_UART_Close }
+
+/* SPI backend */
+__STATIC_INLINE uint32_t NU_SPI_Open(void *pvPort, uint32_t u32MasterSlave, uint32_t u32SPIMode, uint32_t u32DataWidth, uint32_t u32BusClock)
+{
+    return SPI_Open((SPI_T *)pvPort, u32MasterSlave, u32SPIMode, u32DataWidth, u32BusClock);
+}
+
+__STATIC_INLINE uint32_t NU_SPI_SetBusClock(void *pvPort, uint32_t u32BusClock)
+{
+    return SPI_SetBusClock((SPI_T *)pvPort, u32BusClock);
+}
+
+__STATIC_INLINE void NU_SPI_Close(void *pvPort)
+{
+    SPI_Close((SPI_T *)pvPort);
+}
+
+#define NU_SPI_OPS   { NU_SPI_Open, NU_SPI_SetBusClock, NU_SPI_Close }
+
+/* I2C backend */
+__STATIC_INLINE uint32_t NU_I2C_Open(void *pvPort, uint32_t u32BusClock)
+{
+    return I2C_Open((I2C_T *)pvPort, u32BusClock);
+}
+
+__STATIC_INLINE uint32_t NU_I2C_Write(void *pvPort, uint8_t u8SlaveAddr, uint8_t pu8Data[], uint32_t u32Len)
+{
+    return I2C_WriteMultiBytes((I2C_T *)pvPort, u8SlaveAddr, pu8Data, u32Len);
+}
+
+__STATIC_INLINE uint32_t NU_I2C_Read(void *pvPort, uint8_t u8SlaveAddr, uint8_t pu8Data[], uint32_t u32Len)
+{
+    return I2C_ReadMultiBytes((I2C_T *)pvPort, u8SlaveAddr, pu8Data, u32Len);
+}
+
+__STATIC_INLINE uint32_t NU_I2C_WriteReg(void *pvPort, uint8_t u8SlaveAddr, uint8_t u8DataAddr, uint8_t pu8Data[], uint32_t u32Len)
+{
+    return I2C_WriteMultiBytesOneReg((I2C_T *)pvPort, u8SlaveAddr, u8DataAddr, pu8Data, u32Len);
+}
+
+__STATIC_INLINE uint32_t NU_I2C_ReadReg(void *pvPort, uint8_t u8SlaveAddr, uint8_t u8DataAddr, uint8_t pu8Data[], uint32_t u32Len)
+{
+    return I2C_ReadMultiBytesOneReg((I2C_T *)pvPort, u8SlaveAddr, u8DataAddr, pu8Data, u32Len);
+}
+
+__STATIC_INLINE void NU_I2C_Close(void *pvPort)
+{
+    I2C_Close((I2C_T *)pvPort);
+}
+
+#define NU_I2C_OPS   { NU_I2C_Open, NU_I2C_Write, NU_I2C_Read, NU_I2C_WriteReg, NU_I2C_ReadReg, NU_I2C_Close }
+
+/* PDMA backend */
+__STATIC_INLINE void NU_PDMA_Open(void *pvPort, uint32_t u32Mask)
+{
+    PDMA_Open((PDMA_T *)pvPort, u32Mask);
+}
+
+__STATIC_INLINE void NU_PDMA_SetTransfer(void *pvPort, uint32_t u32Ch, const S_NU_DMA_XFER_T *psXfer)
+{
+    PDMA_SetTransferCnt((PDMA_T *)pvPort, u32Ch, psXfer->u32Width, psXfer->u32Count);
+    PDMA_SetTransferAddr((PDMA_T *)pvPort, u32Ch, psXfer->u32SrcAddr, psXfer->u32SrcCtrl, psXfer->u32DstAddr, psXfer->u32DstCtrl);
+    PDMA_SetTransferMode((PDMA_T *)pvPort, u32Ch, psXfer->u32Peripheral, 0UL, 0UL);
+}
+
+__STATIC_INLINE void NU_PDMA_Trigger(void *pvPort, uint32_t u32Ch)
+{
+    PDMA_Trigger((PDMA_T *)pvPort, u32Ch);
+}
+
+__STATIC_INLINE void NU_PDMA_EnableInt(void *pvPort, uint32_t u32Ch, uint32_t u32Mask)
+{
+    PDMA_EnableInt((PDMA_T *)pvPort, u32Ch, u32Mask);
+}
+
+__STATIC_INLINE uint32_t NU_PDMA_GetDone(void *pvPort)
+{
+    PDMA_T *pdma = (PDMA_T *)pvPort;
+
+    return PDMA_GET_TD_STS(pdma);
+}
+
+__STATIC_INLINE uint32_t NU_PDMA_GetAbort(void *pvPort)
+{
+    PDMA_T *pdma = (PDMA_T *)pvPort;
+
+    return PDMA_GET_ABORT_STS(pdma);
+}
+
+__STATIC_INLINE void NU_PDMA_ClearFlags(void *pvPort, uint32_t u32Mask)
+{
+    PDMA_T *pdma = (PDMA_T *)pvPort;
+
+    PDMA_CLR_TD_FLAG(pdma, u32Mask);
+    PDMA_CLR_ABORT_FLAG(pdma, u32Mask);
+}
+
+__STATIC_INLINE void NU_PDMA_Close(void *pvPort)
+{
+    PDMA_Close((PDMA_T *)pvPort);
+}
+
+#define NU_PDMA_OPS   { NU_PDMA_Open, NU_PDMA_SetTransfer, NU_PDMA_Trigger, NU_PDMA_EnableInt, \
+                        NU_PDMA_GetDone, NU_PDMA_GetAbort, NU_PDMA_ClearFlags, NU_PDMA_Close }
+
+/* CANFD backend, classic CAN frames */
+__STATIC_INLINE void NU_CANFD_Open(void *pvPort, uint32_t u32BitRate)
+{
+    CANFD_FD_T sConfig;
+
+    CANFD_GetDefaultConfig(&sConfig, CANFD_OP_CAN_MODE);
+    sConfig.sBtConfig.sNormBitRate.u32BitRate = u32BitRate;
+    CANFD_Open((CANFD_T *)pvPort, &sConfig);
+    (void)CANFD_RunToNormal((CANFD_T *)pvPort, TRUE);
+}
+
+__STATIC_INLINE int32_t NU_CANFD_Send(void *pvPort, uint32_t u32Buf, const S_NU_CAN_FRAME_T *psFrame)
+{
+    CANFD_FD_MSG_T sMsg;
+    uint32_t i;
+
+    sMsg.eIdType = (psFrame->u8Xtd != 0U) ? eCANFD_XID : eCANFD_SID;
+    sMsg.eFrmType = (psFrame->u8Rtr != 0U) ? eCANFD_REMOTE_FRM : eCANFD_DATA_FRM;
+    sMsg.u32Id = psFrame->u32Id;
+    sMsg.u32DLC = (psFrame->u8Dlc > 8U) ? 8UL : psFrame->u8Dlc;
+    sMsg.u8MsgMarker = 0U;
+    sMsg.bFDFormat = 0U;
+    sMsg.bBitRateSwitch = 0U;
+    sMsg.bErrStaInd = 0U;
+    sMsg.bEvntFifoCon = 0U;
+    for (i = 0UL; i < 8UL; i++)
+    {
+        sMsg.au8Data[i] = psFrame->au8Data[i];
+    }
+
+    return (CANFD_TransmitTxMsg((CANFD_T *)pvPort, u32Buf, &sMsg) == 1UL) ? 0 : -1;
+}
+
+__STATIC_INLINE int32_t NU_CANFD_Receive(void *pvPort, uint32_t u32Buf, S_NU_CAN_FRAME_T *psFrame)
+{
+    CANFD_FD_MSG_T sMsg;
+    uint32_t i;
+
+    if (CANFD_ReadRxFifoMsg((CANFD_T *)pvPort, (uint8_t)u32Buf, &sMsg) == 0UL)
+    {
+        return -1;
+    }
+
+    psFrame->u32Id = sMsg.u32Id;
+    psFrame->u8Xtd = (sMsg.eIdType == eCANFD_XID) ? 1U : 0U;
+    psFrame->u8Rtr = (sMsg.eFrmType == eCANFD_REMOTE_FRM) ? 1U : 0U;
+    psFrame->u8Dlc = (sMsg.u32DLC > 8UL) ? 8U : (uint8_t)sMsg.u32DLC;
+    for (i = 0UL; i < psFrame->u8Dlc; i++)
+    {
+        psFrame->au8Data[i] = sMsg.au8Data[i];
+    }
+
+    return 0;
+}
+
+__STATIC_INLINE void NU_CANFD_Close(void *pvPort)
+{
+    CANFD_Close((CANFD_T *)pvPort);
+}
+
+#define NU_CANFD_OPS  { NU_CANFD_Open, NU_CANFD_Send, NU_CANFD_Receive, NU_CANFD_Close }
+
+/* AES backend */
+__STATIC_INLINE void NU_AES_Open(CRPT_T *crpt, uint32_t u32Channel, uint32_t u32EncDec, uint32_t u32OpMode, uint32_t u32KeySize, uint32_t u32SwapType)
+{
+    AES_Open(crpt, u32Channel, u32EncDec, u32OpMode, u32KeySize, u32SwapType);
+}
+
+__STATIC_INLINE void NU_AES_SetKey(CRPT_T *crpt, uint32_t u32Channel, uint32_t au32Keys[], uint32_t u32KeySize)
+{
+    AES_SetKey(crpt, u32Channel, au32Keys, u32KeySize);
+}
+
+__STATIC_INLINE void NU_AES_SetInitVect(CRPT_T *crpt, uint32_t u32Channel, uint32_t au32IV[])
+{
+    AES_SetInitVect(crpt, u32Channel, au32IV);
+}
+
+__STATIC_INLINE void NU_AES_SetDMATransfer(CRPT_T *crpt, uint32_t u32Channel, uint32_t u32SrcAddr, uint32_t u32DstAddr, uint32_t u32TransCnt)
+{
+    AES_SetDMATransfer(crpt, u32Channel, u32SrcAddr, u32DstAddr, u32TransCnt);
+}
+
+__STATIC_INLINE void NU_AES_Start(CRPT_T *crpt, uint32_t u32Channel, uint32_t u32DMAMode)
+{
+    AES_Start(crpt, (int32_t)u32Channel, u32DMAMode);
+}
+
+#define NU_AES_OPS    { NU_AES_Open, NU_AES_SetKey, NU_AES_SetInitVect, NU_AES_SetDMATransfer, NU_AES_Start }
+
+/*@}*/ /* end of group NU_DRV_EXPORTED_FUNCTIONS */
+
+/*@}*/ /* end of group NU_DRV_Driver */
+
+/*@}*/ /* end of group Standard_Driver */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __NU_DRV_H__ */
@@ -46,9 +46,54 @@ extern "C"
 
 #define SC_TIMEOUT                      (SystemCoreClock)   /*!< SC time-out counter (1 second time-out) \hideinitializer */
 
+#define SC_ATR_MAX_LEN                  (33UL)              /*!< Maximum Answer To Reset length including TS \hideinitializer */
+#define SC_ENGINE_RX_BUF_SIZE           (64UL)              /*!< Protocol engine receive ring size, must be a power of 2 \hideinitializer */
+#define SC_PROTOCOL_T0                  (0UL)               /*!< Character protocol T = 0 \hideinitializer */
+#define SC_PROTOCOL_T1                  (1UL)               /*!< Block protocol T = 1 \hideinitializer */
+
+#define SC_ENGINE_OK                    (0L)                /*!< Protocol engine operation done \hideinitializer */
+#define SC_ENGINE_ERR_TIMEOUT           (-1L)               /*!< Card did not answer within the waiting time \hideinitializer */
+#define SC_ENGINE_ERR_REMOVED           (-2L)               /*!< Card removed \hideinitializer */
+#define SC_ENGINE_ERR_TRANSFER          (-3L)               /*!< Parity, retry over limit, overrun or EDC error \hideinitializer */
+#define SC_ENGINE_ERR_ATR               (-4L)               /*!< Malformed or unsupported ATR \hideinitializer */
+#define SC_ENGINE_ERR_PPS               (-5L)               /*!< PPS exchange failed \hideinitializer */
+#define SC_ENGINE_ERR_PROTOCOL          (-6L)               /*!< Unexpected procedure byte or block \hideinitializer */
+#define SC_ENGINE_ERR_BUF               (-7L)               /*!< Response does not fit the buffer \hideinitializer */
+#define SC_ENGINE_ERR_PARAM             (-8L)               /*!< Invalid parameter \hideinitializer */
+
 /**@}*/ /* end of group SC_EXPORTED_CONSTANTS */
 
 
+/** @addtogroup SC_EXPORTED_STRUCTS SC Exported Structs
+  @{
+*/
+
+/**
+  * @details    Answer To Reset and the transmission parameters decoded from it
+  */
+typedef struct
+{
+    uint8_t au8Atr[SC_ATR_MAX_LEN]; /*!< Raw ATR, starting with TS */
+    uint8_t u8AtrLen;               /*!< ATR length */
+    uint8_t u8HistOffset;           /*!< Offset of the historical bytes in au8Atr */
+    uint8_t u8HistLen;              /*!< Number of historical bytes */
+    uint8_t u8Fi;                   /*!< Clock rate conversion integer of TA1 */
+    uint8_t u8Di;                   /*!< Baud rate adjustment integer of TA1 */
+    uint8_t u8N;                    /*!< Extra guard time of TC1 */
+    uint8_t u8WI;                   /*!< T = 0 waiting time integer of TC2 */
+    uint8_t u8IFSC;                 /*!< T = 1 maximum information field size of the card */
+    uint8_t u8CWI;                  /*!< T = 1 character waiting time integer */
+    uint8_t u8BWI;                  /*!< T = 1 block waiting time integer */
+    uint8_t u8Crc;                  /*!< T = 1 error detection code. 0: LRC, 1: CRC */
+    uint8_t u8Specific;             /*!< 1 if TA2 is present (specific mode, no PPS) */
+    uint8_t u8Protocols;            /*!< Bit n is set if T = n is offered */
+    uint8_t u8Protocol;             /*!< Protocol in use, \ref SC_PROTOCOL_T0 or \ref SC_PROTOCOL_T1 */
+    uint8_t u8FiDi;                 /*!< Fi/Di in use after PPS, same encoding as TA1 */
+} S_SC_ATR_T;
+
+/**@}*/ /* end of group SC_EXPORTED_STRUCTS */
+
+
 /** @addtogroup SC_EXPORTED_FUNCTIONS SC Exported Functions
   @{
 */
@@ -321,6 +366,11 @@ void SC_StopAllTimer(SC_T *sc);
 void SC_StartTimer(SC_T *sc, uint32_t u32TimerNum, uint32_t u32Mode, uint32_t u32ETUCount);
 void SC_StopTimer(SC_T *sc, uint32_t u32TimerNum);
 uint32_t SC_GetInterfaceClock(SC_T *sc);
+void SC_EngineIRQHandler(SC_T *sc);
+int32_t SC_EngineParseAtr(const uint8_t au8Atr[], uint32_t u32Len, S_SC_ATR_T *psAtr);
+int32_t SC_EngineActivate(SC_T *sc, S_SC_ATR_T *psAtr);
+int32_t SC_EngineTransceive(SC_T *sc, const uint8_t au8Cmd[], uint32_t u32CmdLen, uint8_t au8Rsp[], uint32_t *pu32RspLen);
+void SC_EngineDeactivate(SC_T *sc);
 
 /**@}*/ /* end of group SC_EXPORTED_FUNCTIONS */
 
@@ -5236,9 +5236,33 @@ Example 1: If user want to set PA.0 as SC0_CLK in initial function,
 #define XT1_IN_PF3_Msk          SYS_GPF_MFP0_PF3MFP_Msk        /*<! XT1_IN          PF3      MFP Mask */
 #define XT1_OUT_PF2_Msk         SYS_GPF_MFP0_PF2MFP_Msk        /*<! XT1_OUT         PF2      MFP Mask */
 
+/*---------------------------------------------------------------------------------------------------------*/
+/*  Pin-mux value (NVT_PINMUX) decode constant definitions                                                 */
+/*---------------------------------------------------------------------------------------------------------*/
+#define SYS_MFP_REG_NUM             (40UL)    /*!< Number of GPx_MFPn registers from GPA_MFP0 \hideinitializer */
+#define SYS_MFP_FIELD_Msk           (0x1FUL)  /*!< Width of one pin MFP field \hideinitializer */
+#define SYS_PINMUX_PORT(u32Pinmux)  (((u32Pinmux) >> 28) & 0xFUL)           /*!< Port index of a NVT_PINMUX value, 0 = GPA \hideinitializer */
+#define SYS_PINMUX_PIN(u32Pinmux)   (((u32Pinmux) >> 24) & 0xFUL)           /*!< Pin index of a NVT_PINMUX value \hideinitializer */
+#define SYS_PINMUX_MFP(u32Pinmux)   ((u32Pinmux) & SYS_MFP_FIELD_Msk)       /*!< MFP function of a NVT_PINMUX value \hideinitializer */
 
 /*@}*/ /* end of group SYS_EXPORTED_CONSTANTS */
 
+/** @addtogroup SYS_EXPORTED_STRUCTS SYS Exported Structs
+  @{
+*/
+
+/**
+  * @brief  Merged setting of one GPx_MFPn register
+  */
+typedef struct
+{
+    uint32_t u32Reg;        /*!< Register index from GPA_MFP0, (port * 4) + (pin / 4) */
+    uint32_t u32Mask;       /*!< MFP fields written by this entry */
+    uint32_t u32Value;      /*!< MFP values, only bits in u32Mask are used */
+} S_SYS_MFP_CFG_T;
+
+/*@}*/ /* end of group SYS_EXPORTED_STRUCTS */
+
 extern int32_t g_SYS_i32ErrCode;
 
 /** @addtogroup SYS_EXPORTED_FUNCTIONS SYS Exported Functions
@@ -7237,6 +7261,8 @@ void SYS_EnableBOD(int32_t i32Mode, uint32_t u32BODLevel);
 void SYS_DisableBOD(void);
 int32_t SYS_SetPowerLevel(uint32_t u32PowerLevel);
 void SYS_SetVRef(uint32_t u32VRefCTL);
+uint32_t SYS_ApplyPinmux(const uint32_t au32Pinmux[], uint32_t u32Count);
+void SYS_ApplyMfpTable(const S_SYS_MFP_CFG_T asCfg[], uint32_t u32Count);
 
 /*@}*/ /* end of group SYS_EXPORTED_FUNCTIONS */
 
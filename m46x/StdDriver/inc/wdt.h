@@ -60,8 +60,46 @@ extern "C"
 #define WDT_FAIL            (-1L)               /*!< WDT operation failed \hideinitializer */
 #define WDT_ERR_TIMEOUT     (-2L)               /*!< WDT operation abort due to timeout error \hideinitializer */
 
+/*---------------------------------------------------------------------------------------------------------*/
+/*  WDT Long Operation Constant Definitions                                                                */
+/*---------------------------------------------------------------------------------------------------------*/
+#define WDT_LONGOP_FEED_WDT         (0x1UL)     /*!< Reset the WDT counter between chunks \hideinitializer */
+#define WDT_LONGOP_FEED_WWDT        (0x2UL)     /*!< Reload the WWDT counter between chunks, only inside its window \hideinitializer */
+#define WDT_LONGOP_DONE             (1L)        /*!< Step return value, the operation finished before u32Total units \hideinitializer */
+
 /**@}*/ /* end of group WDT_EXPORTED_CONSTANTS */
 
+
+/** @addtogroup WDT_EXPORTED_STRUCTS WDT Exported Structs
+  @{
+*/
+
+typedef int32_t (*WDT_LONGOP_STEP_FUNC)(void *pvCtx, uint32_t u32Offset, uint32_t u32Count);     /*!< Performs u32Count units from u32Offset, returns < 0 on error or \ref WDT_LONGOP_DONE */
+typedef void (*WDT_LONGOP_PROGRESS_FUNC)(void *pvCtx, uint32_t u32Done, uint32_t u32Total);     /*!< Called after every chunk */
+typedef uint32_t (*WDT_LONGOP_TICK_FUNC)(void);                                                 /*!< Free-running microsecond counter */
+
+/**
+  * @brief  Long operation split into watchdog-fed chunks
+  */
+typedef struct
+{
+    WDT_LONGOP_STEP_FUNC     pfnStep;       /*!< Performs one chunk of the operation */
+    WDT_LONGOP_PROGRESS_FUNC pfnProgress;   /*!< Progress report, NULL if not used */
+    WDT_LONGOP_TICK_FUNC     pfnGetUs;      /*!< Time base of the chunk adaptation, NULL keeps u32Chunk fixed */
+    void    *pvCtx;                         /*!< Passed to pfnStep and pfnProgress */
+    uint32_t u32Total;                      /*!< Units of work, 0 runs until pfnStep returns \ref WDT_LONGOP_DONE */
+    uint32_t u32Chunk;                      /*!< Units per chunk, updated after every chunk */
+    uint32_t u32MaxChunk;                   /*!< Upper limit of u32Chunk, 0 for no limit */
+    uint32_t u32BudgetUs;                   /*!< Target duration of one chunk, keep it below the WDT time-out */
+    uint32_t u32Feed;                       /*!< \ref WDT_LONGOP_FEED_WDT and/or \ref WDT_LONGOP_FEED_WWDT */
+    uint32_t u32WwdtTickUs;                 /*!< Duration of one WWDT count, used with \ref WDT_LONGOP_FEED_WWDT */
+    uint32_t u32UnitUs;                     /*!< Estimated duration of one unit, may be seeded, 0 if unknown */
+    uint32_t u32Done;                       /*!< Units completed */
+} S_WDT_LONGOP_T;
+
+/**@}*/ /* end of group WDT_EXPORTED_STRUCTS */
+
+
 /** @addtogroup WDT_EXPORTED_FUNCTIONS WDT Exported Functions
   @{
 */
@@ -215,6 +253,7 @@ __STATIC_INLINE void WDT_DisableInt(void)
 }
 
 int32_t WDT_Open(uint32_t u32TimeoutInterval, uint32_t u32ResetDelay, uint32_t u32EnableReset, uint32_t u32EnableWakeup);
+int32_t WDT_RunLongOp(S_WDT_LONGOP_T *psOp);
 
 /**@}*/ /* end of group WDT_EXPORTED_FUNCTIONS */
 
@@ -68,6 +68,271 @@ void ACMP_Close(ACMP_T *acmp, uint32_t u32ChNum)
     acmp->CTL[u32ChNum] &= (~ACMP_CTL_ACMPEN_Msk);
 }
 
+/**
+  * @brief  Configure both comparators as a window comparator
+  *
+  * @param[in]  acmp The pointer of the specified ACMP module
+  * @param[in]  u32PosSel Positive input shared by both comparators. Including:
+  *                  - \ref ACMP_CTL_POSSEL_P0
+  *                  - \ref ACMP_CTL_POSSEL_P1
+  *                  - \ref ACMP_CTL_POSSEL_P2
+  *                  - \ref ACMP_CTL_POSSEL_P3
+  * @param[in]  u32LowLevel CRV1 level (0 ~ 63) of the window lower bound.
+  * @param[in]  u32HighLevel CRV0 level (0 ~ 63) of the window upper bound.
+  * @param[in]  u32HysSel The hysteresis function option. Including:
+  *                  - \ref ACMP_CTL_HYSTERESIS_30MV
+  *                  - \ref ACMP_CTL_HYSTERESIS_20MV
+  *                  - \ref ACMP_CTL_HYSTERESIS_10MV
+  *                  - \ref ACMP_CTL_HYSTERESIS_DISABLE
+  *
+  * @return     None
+  *
+  * @details    ACMP0 compares the input against CRV0 (upper bound) and ACMP1 against CRV1 (lower bound).
+  *             Window compare mode is enabled on both channels so ACMPWO reports whether the input is
+  *             inside the window. The CRV source voltage keeps the setting of \ref ACMP_SELECT_CRV0_SRC
+  *             and \ref ACMP_SELECT_CRV1_SRC.
+  */
+void ACMP_WindowOpen(ACMP_T *acmp, uint32_t u32PosSel, uint32_t u32LowLevel, uint32_t u32HighLevel, uint32_t u32HysSel)
+{
+    uint32_t u32Ch;
+
+    acmp->VREF = (acmp->VREF & ~(ACMP_VREF_CRV0SEL_Msk | ACMP_VREF_CRV1SEL_Msk)) |
+                 ((u32HighLevel << ACMP_VREF_CRV0SEL_Pos) & ACMP_VREF_CRV0SEL_Msk) |
+                 ((u32LowLevel << ACMP_VREF_CRV1SEL_Pos) & ACMP_VREF_CRV1SEL_Msk) |
+                 ACMP_VREF_CRV0EN_Msk | ACMP_VREF_CRV1EN_Msk;
+
+    for(u32Ch = 0UL; u32Ch < 2UL; u32Ch++)
+    {
+        acmp->CTL[u32Ch] = (acmp->CTL[u32Ch] & ~(ACMP_CTL_POSSEL_Msk | ACMP_CTL_WLATEN_Msk | ACMP_CTL_ACMPOINV_Msk)) |
+                           u32PosSel | ACMP_CTL_WCMPSEL_Msk;
+        ACMP_Open(acmp, u32Ch, ACMP_CTL_NEGSEL_CRV, u32HysSel);
+    }
+}
+
+/**
+  * @brief  Leave window compare mode and disable both comparators
+  *
+  * @param[in]  acmp The pointer of the specified ACMP module
+  *
+  * @return     None
+  */
+void ACMP_WindowClose(ACMP_T *acmp)
+{
+    acmp->CTL[0] &= ~(ACMP_CTL_WCMPSEL_Msk | ACMP_CTL_ACMPEN_Msk);
+    acmp->CTL[1] &= ~(ACMP_CTL_WCMPSEL_Msk | ACMP_CTL_ACMPEN_Msk);
+}
+
+/**
+  * @brief  Get the position of the input relative to the window
+  *
+  * @param[in]  acmp The pointer of the specified ACMP module
+  *
+  * @return     \ref ACMP_WINDOW_BELOW, \ref ACMP_WINDOW_INSIDE or \ref ACMP_WINDOW_ABOVE
+  *
+  * @details    The window must be configured by \ref ACMP_WindowOpen. Both outputs are read from one
+  *             STATUS sample so the result is consistent.
+  */
+uint32_t ACMP_GetWindowState(ACMP_T *acmp)
+{
+    uint32_t u32Status = acmp->STATUS;
+
+    if(u32Status & ACMP_STATUS_ACMPWO_Msk)
+        return ACMP_WINDOW_INSIDE;
+
+    return (u32Status & ACMP_STATUS_ACMPO0_Msk) ? ACMP_WINDOW_ABOVE : ACMP_WINDOW_BELOW;
+}
+
+/** @cond HIDDEN_SYMBOLS */
+static void ACMP_RouteToTimer(TIMER_T *timer, uint32_t u32ChNum, uint32_t u32Edge, uint32_t u32DivShift)
+{
+    timer->CTL |= TIMER_CTL_CAPSRC_Msk;
+    timer->EXTCTL = (timer->EXTCTL & ~(TIMER_EXTCTL_ICAPSEL_Msk | TIMER_EXTCTL_CAPFUNCS_Msk |
+                                       TIMER_EXTCTL_CAPEDGE_Msk | TIMER_EXTCTL_CAPDIVSCL_Msk)) |
+                    (u32ChNum ? TIMER_INTER_CAPTURE_SOURCE_ACMP1 : TIMER_INTER_CAPTURE_SOURCE_ACMP0) |
+                    TIMER_CAPTURE_FREE_COUNTING_MODE | u32Edge |
+                    ((u32DivShift << TIMER_EXTCTL_CAPDIVSCL_Pos) & TIMER_EXTCTL_CAPDIVSCL_Msk) |
+                    TIMER_EXTCTL_CAPEN_Msk;
+
+    /* Capture events are only generated while the timer is counting */
+    if((timer->CTL & TIMER_CTL_CNTEN_Msk) == 0UL)
+    {
+        timer->CMP = TIMER_CMP_CMPDAT_Msk;
+        timer->CTL = (timer->CTL & ~(TIMER_CTL_OPMODE_Msk | TIMER_CTL_PSC_Msk)) | TIMER_CONTINUOUS_MODE | TIMER_CTL_CNTEN_Msk;
+    }
+}
+/** @endcond HIDDEN_SYMBOLS */
+
+/**
+  * @brief  Count comparator output edges with a timer capture input
+  *
+  * @param[in]  psCnt Edge counter state.
+  * @param[in]  timer The timer that captures the comparator output. It could be TIMER0, TIMER1, TIMER2, TIMER3.
+  * @param[in]  u32ChNum Comparator number.
+  * @param[in]  u32Edge Counted edge. Including:
+  *                  - \ref TIMER_CAPTURE_EVENT_FALLING
+  *                  - \ref TIMER_CAPTURE_EVENT_RISING
+  *                  - \ref TIMER_CAPTURE_EVENT_FALLING_RISING
+  *                  - \ref TIMER_CAPTURE_EVENT_RISING_FALLING
+  * @param[in]  u32DivShift Capture source divider 2^u32DivShift (0 ~ 8).
+  *
+  * @return     None
+  *
+  * @details    The timer is started in continuous mode if it is not counting yet. Call
+  *             \ref ACMP_EdgeCountIRQHandler from the timer IRQ handler; the NVIC is left to the caller.
+  */
+void ACMP_EdgeCountOpen(S_ACMP_EDGE_CNT_T *psCnt, TIMER_T *timer, uint32_t u32ChNum, uint32_t u32Edge, uint32_t u32DivShift)
+{
+    psCnt->timer = timer;
+    psCnt->u32DivShift = u32DivShift;
+    psCnt->u32Events = 0UL;
+    psCnt->u32LastCap = 0UL;
+
+    ACMP_RouteToTimer(timer, u32ChNum, u32Edge, u32DivShift);
+    timer->EINTSTS = TIMER_EINTSTS_CAPIF_Msk;
+    timer->EXTCTL |= TIMER_EXTCTL_CAPIEN_Msk;
+}
+
+/**
+  * @brief  Stop counting comparator output edges
+  *
+  * @param[in]  psCnt Edge counter state.
+  *
+  * @return     None
+  */
+void ACMP_EdgeCountClose(S_ACMP_EDGE_CNT_T *psCnt)
+{
+    psCnt->timer->EXTCTL &= ~(TIMER_EXTCTL_CAPIEN_Msk | TIMER_EXTCTL_CAPEN_Msk);
+    psCnt->timer->EINTSTS = TIMER_EINTSTS_CAPIF_Msk;
+}
+
+/**
+  * @brief  Edge counter interrupt service
+  *
+  * @param[in]  psCnt Edge counter state.
+  *
+  * @return     None
+  */
+void ACMP_EdgeCountIRQHandler(S_ACMP_EDGE_CNT_T *psCnt)
+{
+    TIMER_T *timer = psCnt->timer;
+
+    if(timer->EINTSTS & TIMER_EINTSTS_CAPIF_Msk)
+    {
+        psCnt->u32LastCap = timer->CAP;
+        timer->EINTSTS = TIMER_EINTSTS_CAPIF_Msk;
+        psCnt->u32Events++;
+    }
+}
+
+/**
+  * @brief  Get the number of counted comparator edges
+  *
+  * @param[in]  psCnt Edge counter state.
+  *
+  * @return     Edge count, in steps of the capture source divider.
+  */
+uint32_t ACMP_EdgeCountGet(S_ACMP_EDGE_CNT_T *psCnt)
+{
+    return psCnt->u32Events << psCnt->u32DivShift;
+}
+
+/**
+  * @brief  Start EADC conversion on comparator output edges
+  *
+  * @param[in]  timer The timer that relays the comparator output. It could be TIMER0, TIMER1, TIMER2, TIMER3.
+  * @param[in]  u32ChNum Comparator number.
+  * @param[in]  u32Edge Trigger edge. Including:
+  *                  - \ref TIMER_CAPTURE_EVENT_FALLING
+  *                  - \ref TIMER_CAPTURE_EVENT_RISING
+  *                  - \ref TIMER_CAPTURE_EVENT_FALLING_RISING
+  *                  - \ref TIMER_CAPTURE_EVENT_RISING_FALLING
+  *
+  * @return     The EADC trigger source to pass to \ref EADC_ConfigSampleModule.
+  *
+  * @details    EADC has no comparator trigger input, so the comparator output is captured by the timer
+  *             and the timer capture event is forwarded to EADC. The same timer may be used by
+  *             \ref ACMP_EdgeCountOpen for the same comparator.
+  */
+uint32_t ACMP_EnableEADCTrigger(TIMER_T *timer, uint32_t u32ChNum, uint32_t u32Edge)
+{
+    ACMP_RouteToTimer(timer, u32ChNum, u32Edge, 0UL);
+    timer->TRGCTL = (timer->TRGCTL & ~TIMER_TRGCTL_TRGSSEL_Msk) | TIMER_TRGSRC_CAPTURE_EVENT | TIMER_TRG_TO_EADC;
+
+    if(timer == TIMER0)
+        return EADC_TIMER0_TRIGGER;
+    else if(timer == TIMER1)
+        return EADC_TIMER1_TRIGGER;
+    else if(timer == TIMER2)
+        return EADC_TIMER2_TRIGGER;
+    else
+        return EADC_TIMER3_TRIGGER;
+}
+
+/**
+  * @brief  Stop forwarding comparator edges to EADC
+  *
+  * @param[in]  timer The timer set up by \ref ACMP_EnableEADCTrigger.
+  *
+  * @return     None
+  */
+void ACMP_DisableEADCTrigger(TIMER_T *timer)
+{
+    timer->TRGCTL &= ~(TIMER_TRGCTL_TRGSSEL_Msk | TIMER_TRGCTL_TRGEADC_Msk);
+}
+
+/**
+  * @brief  Use a comparator output as EPWM fault brake source
+  *
+  * @param[in]  epwm The pointer of the specified EPWM module
+  * @param[in]  u32ChannelMask Combination of enabled channels. Each bit corresponds to a channel.
+  * @param[in]  u32ChNum Comparator number.
+  * @param[in]  u32Mode \ref ACMP_BRAKE_EDGE or \ref ACMP_BRAKE_LEVEL
+  *
+  * @return     None
+  *
+  * @details    The brake action of the channels is left unchanged; configure it by \ref EPWM_EnableFaultBrake.
+  *             The write-protection function should be disabled before using this function.
+  */
+void ACMP_EnableEPWMBrake(EPWM_T *epwm, uint32_t u32ChannelMask, uint32_t u32ChNum, uint32_t u32Mode)
+{
+    uint32_t i, u32Src;
+
+    if(u32Mode == ACMP_BRAKE_LEVEL)
+        u32Src = u32ChNum ? EPWM_FB_LEVEL_ACMP1 : EPWM_FB_LEVEL_ACMP0;
+    else
+        u32Src = u32ChNum ? EPWM_FB_EDGE_ACMP1 : EPWM_FB_EDGE_ACMP0;
+
+    /* Not EPWM_EnableFaultBrake: with an empty level mask it would force the brake action low */
+    for(i = 0UL; i < EPWM_CHANNEL_NUM; i++)
+    {
+        if(u32ChannelMask & (1UL << i))
+            epwm->BRKCTL[i >> 1] |= u32Src;
+    }
+}
+
+/**
+  * @brief  Remove a comparator output from the EPWM fault brake sources
+  *
+  * @param[in]  epwm The pointer of the specified EPWM module
+  * @param[in]  u32ChannelMask Combination of channels. Each bit corresponds to a channel.
+  * @param[in]  u32ChNum Comparator number.
+  *
+  * @return     None
+  *
+  * @details    The write-protection function should be disabled before using this function.
+  */
+void ACMP_DisableEPWMBrake(EPWM_T *epwm, uint32_t u32ChannelMask, uint32_t u32ChNum)
+{
+    uint32_t i, u32Src;
+
+    u32Src = u32ChNum ? (EPWM_FB_EDGE_ACMP1 | EPWM_FB_LEVEL_ACMP1) : (EPWM_FB_EDGE_ACMP0 | EPWM_FB_LEVEL_ACMP0);
+
+    for(i = 0UL; i < EPWM_CHANNEL_NUM; i++)
+    {
+        if(u32ChannelMask & (1UL << i))
+            epwm->BRKCTL[i >> 1] &= ~u32Src;
+    }
+}
 
 
 /*@}*/ /* end of group ACMP_EXPORTED_FUNCTIONS */
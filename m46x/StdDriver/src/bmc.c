@@ -345,6 +345,187 @@ void BMC_ClearStatus(uint32_t u32Mask)
 }
 
 
+/**
+  * @brief      Prepare PDMA streaming of a BMC channel group
+  * @param[in]  pdma        The pointer of the PDMA module
+  * @param[in]  psStream    Stream state of the group, placed in SRAM
+  * @param[in]  u32Group    BMC channel group, \ref BMC_GROUP_0 ~ \ref BMC_GROUP_7
+  * @param[in]  u32PdmaCh   PDMA channel feeding the group
+  * @param[in]  pu32Buf     Circular buffer of 2 x u32HalfLen words
+  * @param[in]  u32HalfLen  Words per buffer half, 1 ~ 65536
+  * @retval     0           Success
+  * @retval     -1          Invalid parameter
+  * @details    Two scatter-gather descriptors link to each other so PDMA plays the buffer halves
+  *             back to back without CPU reload. Each word carries one byte per channel of the group,
+  *             as written to BMC_TXDATGn. Fill both halves through BMC_StreamGetBuf() and
+  *             BMC_StreamCommit() before BMC_StreamStart(), and call BMC_StreamIRQHandler() from
+  *             the PDMA IRQ handler.
+  * \hideinitializer
+  */
+int32_t BMC_StreamOpen(PDMA_T *pdma, S_BMC_STREAM_T *psStream, uint32_t u32Group, uint32_t u32PdmaCh, uint32_t *pu32Buf, uint32_t u32HalfLen)
+{
+    uint32_t i, u32Ctl;
+
+    if((psStream == NULL) || (pu32Buf == NULL) || (u32HalfLen == 0UL) || (u32HalfLen > 0x10000UL) ||
+            (u32Group >= BMC_CHANNEL_NUM) || ((u32Group & 0x3UL) != 0UL) || (u32PdmaCh >= PDMA_CH_MAX))
+    {
+        return -1;
+    }
+
+    psStream->pu32Buf = pu32Buf;
+    psStream->u32HalfLen = u32HalfLen;
+    psStream->u32Group = u32Group;
+    psStream->u32PdmaCh = u32PdmaCh;
+    psStream->u32Filled = 0UL;
+    psStream->u32Playing = 0UL;
+    psStream->u32WrHalf = 0UL;
+    psStream->u32Late = 0UL;
+    psStream->u32Underrun = 0UL;
+
+    PDMA_Open(pdma, 1UL << u32PdmaCh);
+
+    pdma->SCATBA = (uint32_t)psStream->asDesc & 0xFFFF0000UL;
+
+    u32Ctl = ((u32HalfLen - 1UL) << PDMA_DSCT_CTL_TXCNT_Pos) | PDMA_WIDTH_32 | PDMA_SAR_INC | PDMA_DAR_FIX |
+             PDMA_REQ_SINGLE | PDMA_TBINTDIS_ENABLE | PDMA_OP_SCATTER;
+
+    for(i = 0UL; i < 2UL; i++)
+    {
+        psStream->asDesc[i].CTL = u32Ctl;
+        psStream->asDesc[i].SA = (uint32_t)&pu32Buf[i * u32HalfLen];
+        /* TXDATGn registers are 4 bytes apart, and BMC_GROUP_n is 4 x n */
+        psStream->asDesc[i].DA = (uint32_t)&(BMC->TXDATG0) + u32Group;
+        psStream->asDesc[i].NEXT = (uint32_t)&psStream->asDesc[i ^ 1UL] - pdma->SCATBA;
+    }
+
+    PDMA_SetTransferMode(pdma, u32PdmaCh, PDMA_BMC_G0_TX + (u32Group >> 2), 1UL, (uint32_t)&psStream->asDesc[0]);
+    PDMA_CLR_TD_FLAG(pdma, 1UL << u32PdmaCh);
+    PDMA_EnableInt(pdma, u32PdmaCh, PDMA_INT_TRANS_DONE);
+
+    return 0;
+}
+
+/**
+  * @brief      Get the buffer half to fill next
+  * @param[in]  psStream    Stream state of the group
+  * @return     Pointer to psStream->u32HalfLen words, or NULL if both halves still wait to be played
+  * \hideinitializer
+  */
+uint32_t *BMC_StreamGetBuf(S_BMC_STREAM_T *psStream)
+{
+    if(psStream->u32Filled & (1UL << psStream->u32WrHalf))
+    {
+        return NULL;
+    }
+
+    return &psStream->pu32Buf[psStream->u32WrHalf * psStream->u32HalfLen];
+}
+
+/**
+  * @brief      Hand the half returned by BMC_StreamGetBuf() to PDMA
+  * @param[in]  psStream    Stream state of the group
+  * @return     None
+  * @details    u32Filled is also cleared by BMC_StreamIRQHandler(), so it is updated with interrupts masked.
+  * \hideinitializer
+  */
+void BMC_StreamCommit(S_BMC_STREAM_T *psStream)
+{
+    uint32_t u32Primask;
+
+    u32Primask = __get_PRIMASK();
+    __disable_irq();
+    psStream->u32Filled |= (1UL << psStream->u32WrHalf);
+    __set_PRIMASK(u32Primask);
+
+    psStream->u32WrHalf ^= 1UL;
+}
+
+/**
+  * @brief      Start BMC channel groups together
+  * @param[in]  apsStream   Streams opened by BMC_StreamOpen()
+  * @param[in]  u32Num      Number of streams
+  * @return     None
+  * @details    PDMA mode, every group enable and the BMC enable are set by a single register write,
+  *             so all groups start their frames on the same bit clock edge.
+  * \hideinitializer
+  */
+void BMC_StreamStart(S_BMC_STREAM_T *apsStream[], uint32_t u32Num)
+{
+    uint32_t i, u32En = BMC_CTL_DMAEN_Msk | BMC_CTL_BMCEN_Msk;
+
+    for(i = 0UL; i < u32Num; i++)
+    {
+        u32En |= BMC_CTL_G0CHEN_Msk << (apsStream[i]->u32Group >> 2);
+    }
+
+    /* Clear stale under run flags */
+    BMC->INTSTS = BMC_INTSTS_TXUNDIF_Msk | (0xFFUL << BMC_INTSTS_G0TXUND_Pos);
+    BMC->CTL |= u32En;
+}
+
+/**
+  * @brief      Stop BMC channel groups and their PDMA channels
+  * @param[in]  pdma        The pointer of the PDMA module
+  * @param[in]  apsStream   Streams opened by BMC_StreamOpen()
+  * @param[in]  u32Num      Number of streams
+  * @return     None
+  * \hideinitializer
+  */
+void BMC_StreamStop(PDMA_T *pdma, S_BMC_STREAM_T *apsStream[], uint32_t u32Num)
+{
+    uint32_t i, u32Ch = 0UL;
+
+    BMC->CTL &= ~(BMC_CTL_BMCEN_Msk | BMC_CTL_DMAEN_Msk | (0xFFUL << BMC_CTL_G0CHEN_Pos));
+
+    for(i = 0UL; i < u32Num; i++)
+    {
+        u32Ch |= 1UL << apsStream[i]->u32PdmaCh;
+        PDMA_DisableInt(pdma, apsStream[i]->u32PdmaCh, PDMA_INT_TRANS_DONE);
+    }
+
+    pdma->CHRST = u32Ch;
+    PDMA_CLR_TD_FLAG(pdma, u32Ch);
+}
+
+/**
+  * @brief      Stream interrupt handler
+  * @param[in]  pdma        The pointer of the PDMA module
+  * @param[in]  psStream    Stream state of the group
+  * @return     None
+  * @details    Call from the PDMA IRQ handler for every open stream. When a half has been played it is
+  *             released for refilling; if the other half, now being played, was not committed in time
+  *             psStream->u32Late is increased and that half is replayed as a whole; it is not returned by
+  *             BMC_StreamGetBuf() before it has been played. Transmit data under run of the group is counted in
+  *             psStream->u32Underrun; it may also be called from the BMC IRQ handler for that purpose.
+  * \hideinitializer
+  */
+void BMC_StreamIRQHandler(PDMA_T *pdma, S_BMC_STREAM_T *psStream)
+{
+    uint32_t u32Und = BMC_INTSTS_G0TXUND_Msk << (psStream->u32Group >> 2);
+
+    if(PDMA_GET_TD_STS(pdma) & (1UL << psStream->u32PdmaCh))
+    {
+        PDMA_CLR_TD_FLAG(pdma, 1UL << psStream->u32PdmaCh);
+
+        psStream->u32Filled &= ~(1UL << psStream->u32Playing);
+        psStream->u32Playing ^= 1UL;
+
+        if((psStream->u32Filled & (1UL << psStream->u32Playing)) == 0UL)
+        {
+            /* Replayed: keep it from BMC_StreamGetBuf() until PDMA is done with it */
+            psStream->u32Filled |= (1UL << psStream->u32Playing);
+            psStream->u32Late++;
+        }
+    }
+
+    if(BMC->INTSTS & u32Und)
+    {
+        BMC->INTSTS = u32Und;
+        psStream->u32Underrun++;
+    }
+}
+
+
 /*@}*/ /* end of group BMC_EXPORTED_FUNCTIONS */
 
 /*@}*/ /* end of group BMC_Driver */
@@ -27,6 +27,14 @@
 
 #define TIMEOUT_ECC        SystemCoreClock    /* 1 second time-out */
 
+#if ((ECC_CURVE_GROUPS & ECC_CURVE_GROUP_ALL) == 0)
+#error "ECC_CURVE_GROUPS must select at least one ECC curve group"
+#endif
+
+#if ((RSA_MAX_KLEN % 1024) != 0) || (RSA_MAX_KLEN < 1024) || (RSA_MAX_KLEN > 4096)
+#error "RSA_MAX_KLEN must be 1024, 2048, 3072 or 4096"
+#endif
+
 /** @addtogroup Standard_Driver Standard Driver
   @{
 */
@@ -56,6 +64,15 @@ int32_t ECC_Mutiply(CRPT_T *crpt, E_ECC_CURVE ecc_curve, char x1[], char y1[], c
 void ECC_Complete(CRPT_T *crpt);
 
 
+typedef struct
+{
+    const S_AES_CTX_T *psCtx;           /* Context whose key is in the key registers, NULL if unknown */
+    uint32_t u32KeyGen;                 /* u32KeyGen of psCtx when its key was written */
+} AES_KEY_CACHE_T;
+
+static AES_KEY_CACHE_T s_asAesKeyCache[1];
+static uint32_t s_u32AesKeyGen;
+
 /* // @endcond HIDDEN_SYMBOLS */
 
 /**
@@ -218,6 +235,7 @@ void AES_SetKey(CRPT_T *crpt, uint32_t u32Channel, uint32_t au32Keys[], uint32_t
         outpw(key_reg_addr, au32Keys[i]);
         key_reg_addr += 4UL;
     }
+    s_asAesKeyCache[0].psCtx = NULL;
 }
 
 
@@ -239,6 +257,7 @@ void AES_SetKey_KS(CRPT_T *crpt, KS_MEM_Type mem, int32_t i32KeyIdx)
                       (uint32_t)((int)mem << CRPT_AES_KSCTL_RSSRC_Pos) /* KS Memory type */ |
                       (uint32_t)i32KeyIdx /* key num */ ;
 
+    s_asAesKeyCache[0].psCtx = NULL;
 }
 
 
@@ -284,6 +303,126 @@ void AES_SetDMATransfer(CRPT_T *crpt, uint32_t u32Channel, uint32_t u32SrcAddr,
 
 }
 
+/**
+  * @brief  Set the key of an AES context
+  * @param[in]  psCtx       AES context of a session
+  * @param[in]  au32Keys    An word array contains AES keys.
+  * @param[in]  u32KeySize is AES key size, including:
+  *         - \ref AES_KEY_SIZE_128
+  *         - \ref AES_KEY_SIZE_192
+  *         - \ref AES_KEY_SIZE_256
+  * @return None
+  * @details    Only the context is updated. The key registers are written when the context is
+  *             loaded next by \ref AES_CtxLoad.
+  */
+void AES_CtxSetKey(S_AES_CTX_T *psCtx, uint32_t au32Keys[], uint32_t u32KeySize)
+{
+    uint32_t i;
+
+    for(i = 0UL; i < (4UL + u32KeySize * 2UL); i++)
+        psCtx->au32Key[i] = au32Keys[i];
+
+    psCtx->u32KeySize = u32KeySize;
+    psCtx->u32KsCtl = 0UL;
+    psCtx->u32KeyGen = ++s_u32AesKeyGen;
+}
+
+/**
+  * @brief  Set a Key Store key for an AES context
+  * @param[in]  psCtx       AES context of a session
+  * @param[in]  mem         Memory type of Key Store key. it could be:
+  *                              - \ref KS_SRAM
+  *                              - \ref KS_FLASH
+  *                              - \ref KS_OTP
+  * @param[in]  i32KeyIdx   Index of the key in Key Store.
+  * @return None
+  * @details    Key Store counterpart of \ref AES_CtxSetKey. AES_KSCTL is written when the context is
+  *             loaded next by \ref AES_CtxLoad.
+  */
+void AES_CtxSetKey_KS(S_AES_CTX_T *psCtx, KS_MEM_Type mem, int32_t i32KeyIdx)
+{
+    psCtx->u32KsCtl = CRPT_AES_KSCTL_RSRC_Msk |
+                      (uint32_t)((int)mem << CRPT_AES_KSCTL_RSSRC_Pos) |
+                      (uint32_t)i32KeyIdx;
+    psCtx->u32KeyGen = ++s_u32AesKeyGen;
+}
+
+/**
+  * @brief  Load an AES context into an AES channel
+  * @param[in]  crpt        The pointer of CRYPTO module
+  * @param[in]  u32Channel  AES channel. Must be 0~3.
+  * @param[in]  psCtx       AES context set by \ref AES_CtxSetKey or \ref AES_CtxSetKey_KS
+  * @param[in]  au32IV      A four entry word array contains AES initial vectors. NULL to leave the IV registers as they are.
+  * @return None
+  * @details    Replaces \ref AES_SetKey and \ref AES_SetInitVect for sessions that reuse one key for many
+  *             operations. The key is written only if another key was loaded into the channel since this
+  *             context was last loaded. The IV is written on every call that passes one, as the engine
+  *             updates the IV registers while it runs.
+  */
+void AES_CtxLoad(CRPT_T *crpt, uint32_t u32Channel, S_AES_CTX_T *psCtx, uint32_t au32IV[])
+{
+    AES_KEY_CACHE_T *psCache = &s_asAesKeyCache[0];
+    uint32_t i, key_reg_addr;
+
+    (void)u32Channel;
+
+    if((psCache->psCtx != psCtx) || (psCache->u32KeyGen != psCtx->u32KeyGen))
+    {
+        crpt->AES_KSCTL = psCtx->u32KsCtl;
+        if(psCtx->u32KsCtl == 0UL)
+        {
+            key_reg_addr = (uint32_t)&crpt->AES_KEY[0];
+            for(i = 0UL; i < (4UL + psCtx->u32KeySize * 2UL); i++)
+            {
+                outpw(key_reg_addr, psCtx->au32Key[i]);
+                key_reg_addr += 4UL;
+            }
+        }
+        psCache->psCtx = psCtx;
+        psCache->u32KeyGen = psCtx->u32KeyGen;
+    }
+
+    if(au32IV == NULL)
+        return;
+
+
+    key_reg_addr = (uint32_t)&crpt->AES_IV[0];
+    for(i = 0UL; i < 4UL; i++)
+    {
+        outpw(key_reg_addr, au32IV[i]);
+        key_reg_addr += 4UL;
+    }
+}
+
+/**
+  * @brief  Invalidate the loaded key of an AES context
+  * @param[in]  psCtx       AES context
+  * @return None
+  * @details    The next \ref AES_CtxLoad of this context writes its key again. Call it after the
+  *             context memory was changed directly.
+  */
+void AES_CtxInvalidate(S_AES_CTX_T *psCtx)
+{
+    psCtx->u32KeyGen = ++s_u32AesKeyGen;
+}
+
+/**
+  * @brief  Forget which keys are loaded in the AES channels
+  * @param[in]  crpt        The pointer of CRYPTO module
+  * @return None
+  * @details    Call it after the CRYPTO module was reset or lost its registers, so the next
+  *             \ref AES_CtxLoad writes the key again.
+  */
+void AES_InvalidateKeyCache(CRPT_T *crpt)
+{
+    uint32_t i;
+
+    (void)crpt;
+
+    for(i = 0UL; i < 1UL; i++)
+        s_asAesKeyCache[i].psCtx = NULL;
+}
+
 /**
   * @brief  Open SHA encrypt function.
   * @param[in]  crpt        The pointer of CRYPTO module
@@ -411,6 +550,7 @@ enum
 /*-----------------------------------------------------*/
 static const ECC_CURVE _Curve[] =
 {
+#if (ECC_CURVE_GROUPS & ECC_CURVE_GROUP_P)
     {
         /* NIST: Curve P-192 : y^2=x^3-ax+b (mod p) */
         CURVE_P_192,
@@ -501,6 +641,8 @@ static const ECC_CURVE _Curve[] =
         32,
         CURVE_GF_P
     },
+#endif
+#if (ECC_CURVE_GROUPS & ECC_CURVE_GROUP_B)
     {
         /* NIST: Curve B-163 : y^2+xy=x^3+ax^2+b */
         CURVE_B_163,
@@ -591,6 +733,8 @@ static const ECC_CURVE _Curve[] =
         2,
         CURVE_GF_2M
     },
+#endif
+#if (ECC_CURVE_GROUPS & ECC_CURVE_GROUP_K)
     {
         /* NIST: Curve K-163 : y^2+xy=x^3+ax^2+b */
         CURVE_K_163,
@@ -681,6 +825,8 @@ static const ECC_CURVE _Curve[] =
         2,
         CURVE_GF_2M
     },
+#endif
+#if (ECC_CURVE_GROUPS & ECC_CURVE_GROUP_KO)
     {
         /* Koblitz: Curve secp192k1 : y2 = x3+ax+b over Fp */
         CURVE_KO_192,
@@ -735,6 +881,8 @@ static const ECC_CURVE _Curve[] =
         1,
         CURVE_GF_P
     },
+#endif
+#if (ECC_CURVE_GROUPS & ECC_CURVE_GROUP_BP)
     {
         /* Brainpool: Curve brainpoolP256r1 */
         CURVE_BP_256,
@@ -789,6 +937,8 @@ static const ECC_CURVE _Curve[] =
         1,
         CURVE_GF_P
     },
+#endif
+#if (ECC_CURVE_GROUPS & ECC_CURVE_GROUP_25519)
     {
         CURVE_25519,
         64,     // Echar
@@ -806,6 +956,8 @@ static const ECC_CURVE _Curve[] =
         2,
         CURVE_GF_P
     },
+#endif
+#if (ECC_CURVE_GROUPS & ECC_CURVE_GROUP_SM2)
     {
         /* NIST: Curve P-256 : y^2=x^3-ax+b (mod p) */
         CURVE_SM2_256,
@@ -824,6 +976,7 @@ static const ECC_CURVE _Curve[] =
         2,
         CURVE_GF_P
     },
+#endif
 
 };
 
@@ -834,12 +987,14 @@ static ECC_CURVE  Curve_Copy;
 static ECC_CURVE * get_curve(E_ECC_CURVE ecc_curve);
 static int32_t ecc_init_curve(CRPT_T *crpt, E_ECC_CURVE ecc_curve);
 static int32_t run_ecc_codec(CRPT_T *crpt, uint32_t mode);
+static void ecc_start(CRPT_T *crpt, uint32_t u32Ctl);
+static uint32_t CRPT_JobIdle(void);
 
 static char  temp_hex_str[160];
 
 static volatile uint32_t g_ECC_done, g_ECCERR_done;
 
-void ECC_DriverISR(CRPT_T *crpt)
+NVT_FAST_CRYPTO_FUNC void ECC_DriverISR(CRPT_T *crpt)
 {
     if(crpt->INTSTS & CRPT_INTSTS_ECCIF_Msk)
     {
@@ -1161,11 +1316,10 @@ int32_t  ECC_GeneratePublicKey(CRPT_T *crpt, E_ECC_CURVE ecc_curve, char *privat
             crpt->ECC_CTL = CRPT_ECC_CTL_FSEL_Msk;
         }
 
-        g_ECC_done = g_ECCERR_done = 0UL;
-        crpt->ECC_CTL |= ((uint32_t)pCurve->key_len << CRPT_ECC_CTL_CURVEM_Pos) |
-                         ECCOP_POINT_MUL | CRPT_ECC_CTL_START_Msk;
+        ecc_start(crpt, ((uint32_t)pCurve->key_len << CRPT_ECC_CTL_CURVEM_Pos) | ECCOP_POINT_MUL);
 
         i32TimeOutCnt = TIMEOUT_ECC;
+        NVT_WAIT_BEGIN(WAIT_SITE_ECC);
         while(g_ECC_done == 0UL)
         {
             if( (i32TimeOutCnt-- <= 0) || g_ECCERR_done )
@@ -1174,6 +1328,7 @@ int32_t  ECC_GeneratePublicKey(CRPT_T *crpt, E_ECC_CURVE ecc_curve, char *privat
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_ECC);
     }
 
     if(ret == 0)
@@ -1229,11 +1384,10 @@ int32_t  ECC_GeneratePublicKey_KS(CRPT_T *crpt, E_ECC_CURVE ecc_curve, KS_MEM_Ty
             crpt->ECC_CTL = CRPT_ECC_CTL_FSEL_Msk;
         }
 
-        g_ECC_done = g_ECCERR_done = 0UL;
-        crpt->ECC_CTL |= ((uint32_t)pCurve->key_len << CRPT_ECC_CTL_CURVEM_Pos) |
-                         ECCOP_POINT_MUL | CRPT_ECC_CTL_START_Msk;
+        ecc_start(crpt, ((uint32_t)pCurve->key_len << CRPT_ECC_CTL_CURVEM_Pos) | ECCOP_POINT_MUL);
 
         i32TimeOutCnt = TIMEOUT_ECC;
+        NVT_WAIT_BEGIN(WAIT_SITE_ECC);
         while(g_ECC_done == 0UL)
         {
             if( (i32TimeOutCnt-- <= 0) || g_ECCERR_done )
@@ -1242,6 +1396,7 @@ int32_t  ECC_GeneratePublicKey_KS(CRPT_T *crpt, E_ECC_CURVE ecc_curve, KS_MEM_Ty
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_ECC);
     }
 
     if(ret == 0)
@@ -1299,17 +1454,15 @@ int32_t  ECC_Mutiply(CRPT_T *crpt, E_ECC_CURVE ecc_curve, char x1[], char y1[],
             crpt->ECC_CTL = CRPT_ECC_CTL_FSEL_Msk;
         }
 
-        g_ECC_done = g_ECCERR_done = 0UL;
-
         if(ecc_curve == CURVE_25519)
         {
             crpt->ECC_CTL |= CRPT_ECC_CTL_CSEL_Msk;
         }
 
-        crpt->ECC_CTL |= ((uint32_t)pCurve->key_len << CRPT_ECC_CTL_CURVEM_Pos) |
-                         ECCOP_POINT_MUL | CRPT_ECC_CTL_START_Msk;
+        ecc_start(crpt, ((uint32_t)pCurve->key_len << CRPT_ECC_CTL_CURVEM_Pos) | ECCOP_POINT_MUL);
 
         i32TimeOutCnt = TIMEOUT_ECC;
+        NVT_WAIT_BEGIN(WAIT_SITE_ECC);
         while(g_ECC_done == 0UL)
         {
             if( (i32TimeOutCnt-- <= 0) || g_ECCERR_done )
@@ -1318,6 +1471,7 @@ int32_t  ECC_Mutiply(CRPT_T *crpt, E_ECC_CURVE ecc_curve, char x1[], char y1[],
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_ECC);
     }
 
     if(ret == 0)
@@ -1387,11 +1541,10 @@ int32_t  ECC_GenerateSecretZ(CRPT_T *crpt, E_ECC_CURVE ecc_curve, char *private_
         {
             crpt->ECC_CTL = CRPT_ECC_CTL_FSEL_Msk;
         }
-        g_ECC_done = g_ECCERR_done = 0UL;
-        crpt->ECC_CTL |= ((uint32_t)pCurve->key_len << CRPT_ECC_CTL_CURVEM_Pos) |
-                         ECCOP_POINT_MUL | CRPT_ECC_CTL_START_Msk;
+        ecc_start(crpt, ((uint32_t)pCurve->key_len << CRPT_ECC_CTL_CURVEM_Pos) | ECCOP_POINT_MUL);
 
         i32TimeOutCnt = TIMEOUT_ECC;
+        NVT_WAIT_BEGIN(WAIT_SITE_ECC);
         while(g_ECC_done == 0UL)
         {
             if( (i32TimeOutCnt-- <= 0) || g_ECCERR_done )
@@ -1400,6 +1553,7 @@ int32_t  ECC_GenerateSecretZ(CRPT_T *crpt, E_ECC_CURVE ecc_curve, char *private_
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_ECC);
     }
 
     if(ret == 0)
@@ -1456,25 +1610,55 @@ int32_t ECC_GenerateSecretZ_KS(CRPT_T *crpt, E_ECC_CURVE ecc_curve, KS_MEM_Type
         crpt->ECC_CTL = CRPT_ECC_CTL_FSEL_Msk;
     }
 
-    g_ECC_done = g_ECCERR_done = 0UL;
-
-    crpt->ECC_CTL |= ((uint32_t)pCurve->key_len << CRPT_ECC_CTL_CURVEM_Pos) |
-                     ECCOP_POINT_MUL | CRPT_ECC_CTL_START_Msk;
+    ecc_start(crpt, ((uint32_t)pCurve->key_len << CRPT_ECC_CTL_CURVEM_Pos) | ECCOP_POINT_MUL);
 
     i32TimeOutCnt = TIMEOUT_ECC;
+    NVT_WAIT_BEGIN(WAIT_SITE_ECC);
     while(g_ECC_done == 0UL)
     {
         if( (i32TimeOutCnt-- <= 0) || g_ECCERR_done )
         {
+            NVT_WAIT_END(WAIT_SITE_ECC);
             return -1;
         }
     }
+    NVT_WAIT_END(WAIT_SITE_ECC);
 
     return (crpt->ECC_KSSTS & 0x1f);
 
 }
 
 
+/* Start an ECC operation. The ECC engine only starts while no job of the job scheduler is queued or
+   running, and CRPT_JobSubmit refuses jobs until the ECC engine is done. If the scheduler does not drain
+   within CRPT_JOB_TIMEOUT polls the ECC error flag is set instead and the operation fails. */
+static void ecc_start(CRPT_T *crpt, uint32_t u32Ctl)
+{
+    uint32_t u32TimeOutCount = CRPT_JOB_TIMEOUT;
+    uint32_t u32Primask;
+
+    g_ECC_done = g_ECCERR_done = 0UL;
+
+    while(1)
+    {
+        u32Primask = __get_PRIMASK();
+        __disable_irq();
+        if(CRPT_JobIdle())
+        {
+            crpt->ECC_CTL |= u32Ctl | CRPT_ECC_CTL_START_Msk;
+            __set_PRIMASK(u32Primask);
+            return;
+        }
+        __set_PRIMASK(u32Primask);
+
+        if(--u32TimeOutCount == 0UL)
+        {
+            g_ECCERR_done = 1UL;
+            return;
+        }
+    }
+}
+
 static int32_t run_ecc_codec(CRPT_T *crpt, uint32_t mode)
 {
     uint32_t eccop;
@@ -1525,15 +1709,15 @@ static int32_t run_ecc_codec(CRPT_T *crpt, uint32_t mode)
 
     }
 
-    g_ECC_done = g_ECCERR_done = 0UL;
-
-    crpt->ECC_CTL |= ((uint32_t)pCurve->key_len << CRPT_ECC_CTL_CURVEM_Pos) | mode | CRPT_ECC_CTL_START_Msk;
+    ecc_start(crpt, ((uint32_t)pCurve->key_len << CRPT_ECC_CTL_CURVEM_Pos) | mode);
 
     i32TimeOutCnt = TIMEOUT_ECC;
+    NVT_WAIT_BEGIN(WAIT_SITE_ECC);
     while(g_ECC_done == 0UL)
     {
         if( (i32TimeOutCnt-- <= 0) || g_ECCERR_done )
         {
+            NVT_WAIT_END(WAIT_SITE_ECC);
             goto lexit;
         }
     }
@@ -1543,13 +1727,15 @@ static int32_t run_ecc_codec(CRPT_T *crpt, uint32_t mode)
     {
         if( i32TimeOutCnt-- <= 0)
         {
+            NVT_WAIT_END(WAIT_SITE_ECC);
             goto lexit;
         }
     }
+    NVT_WAIT_END(WAIT_SITE_ECC);
 
 lexit:
 #ifdef ECC_SCA_PROTECT
-    if(i32TimeOutCnt <= 0)
+    if((i32TimeOutCnt <= 0) || g_ECCERR_done)
     {
         /* Retry if ECCOP_POINT_MUL */
         if(eccop == ECCOP_POINT_MUL)
@@ -1564,18 +1750,19 @@ lexit:
                 crpt->ECC_Y1[i] = y1[i];
             }
 
-            g_ECC_done = g_ECCERR_done = 0UL;
-
-            crpt->ECC_CTL |= ((uint32_t)pCurve->key_len << CRPT_ECC_CTL_CURVEM_Pos) | mode | CRPT_ECC_CTL_START_Msk;
+            ecc_start(crpt, ((uint32_t)pCurve->key_len << CRPT_ECC_CTL_CURVEM_Pos) | mode);
 
             i32TimeOutCnt = TIMEOUT_ECC;
+            NVT_WAIT_BEGIN(WAIT_SITE_ECC);
             while(g_ECC_done == 0UL)
             {
                 if((i32TimeOutCnt-- <= 0) || g_ECCERR_done)
                 {
+                    NVT_WAIT_END(WAIT_SITE_ECC);
                     return -1;
                 }
             }
+            NVT_WAIT_END(WAIT_SITE_ECC);
         }
         else
         {
@@ -1584,7 +1771,7 @@ lexit:
     }
 
 #else
-    if(i32TimeOutCnt <= 0)
+    if((i32TimeOutCnt <= 0) || g_ECCERR_done)
     {
         return -1;
     }
@@ -2706,7 +2893,7 @@ static ECC_CURVE * get_curve(E_ECC_CURVE ecc_curve)
   * @param[in]  crpt        Reference to Crypto module.
   * @return   none
   */
-void ECC_Complete(CRPT_T *crpt)
+NVT_FAST_CRYPTO_FUNC void ECC_Complete(CRPT_T *crpt)
 {
     if(crpt->INTSTS & CRPT_INTSTS_ECCIF_Msk)
     {
@@ -2819,7 +3006,7 @@ static int32_t CheckRsaBufferSize(uint32_t u32OpMode, uint32_t u32BufSize, uint3
   *         - \ref 0    No use key store function
   *         - \ref 1    Use key store function
   * @return  0    Success.
-  * @return  -1   The value of pointer of RSA buffer struct is null.
+  * @return  -1   The value of pointer of RSA buffer struct is null, or the key is longer than RSA_MAX_KLEN.
   */
 int32_t RSA_Open(CRPT_T *crpt, uint32_t u32OpMode, uint32_t u32KeySize, \
                  void *psRSA_Buf, uint32_t u32BufSize, uint32_t u32UseKS)
@@ -2832,6 +3019,10 @@ int32_t RSA_Open(CRPT_T *crpt, uint32_t u32OpMode, uint32_t u32KeySize, \
     {
         return (-1);
     }
+    if((u32KeySize + 1UL) * 1024UL > (uint32_t)RSA_MAX_KLEN)
+    {
+        return (-1);
+    }
 
     s_u32RsaOpMode = u32OpMode;
     s_pRSABuf = psRSA_Buf;
@@ -2913,6 +3104,34 @@ void RSA_Start(CRPT_T *crpt)
     crpt->RSA_CTL |= CRPT_RSA_CTL_START_Msk;
 }
 
+/**
+  * @brief  Wait for the RSA engine, step function of \ref WDT_RunLongOp
+  * @param[in]  pvCtx       The pointer of CRYPTO module
+  * @param[in]  u32Offset   Not used
+  * @param[in]  u32Count    Number of status polls of this chunk
+  * @return  0    RSA is still busy.
+  * @return  1    RSA operation finished, \ref WDT_LONGOP_DONE.
+  * @return  -1   RSA operation failed.
+  * @details Run with u32Total 0 after \ref RSA_Start, so that a 4096-bit operation does not
+  *          outlast the watchdog. The chunk adapts to the number of polls that fits the budget.
+  */
+int32_t RSA_WaitStep(void *pvCtx, uint32_t u32Offset, uint32_t u32Count)
+{
+    CRPT_T *crpt = (CRPT_T *)pvCtx;
+
+    (void)u32Offset;
+    while(u32Count-- > 0UL)
+    {
+        if((crpt->RSA_STS & CRPT_RSA_STS_BUSY_Msk) == 0UL)
+        {
+            if(crpt->RSA_STS & (CRPT_RSA_STS_BUSERR_Msk | CRPT_RSA_STS_CTLERR_Msk | CRPT_RSA_STS_KSERR_Msk))
+                return -1;
+            return 1;
+        }
+    }
+    return 0;
+}
+
 /**
   * @brief  Read the RSA output.
   * @param[in]   crpt       The pointer of CRYPTO module
@@ -3010,6 +3229,252 @@ int32_t RSA_SetDMATransfer_KS(CRPT_T *crpt, char *Src, char *n, uint32_t u32PNum
     return 0;
 }
 
+/** @cond HIDDEN_SYMBOLS */
+
+typedef struct
+{
+    uint32_t u32IntEn;                  /* INTEN bits of the engine */
+    uint32_t u32Done;                   /* INTSTS done flag */
+    uint32_t u32Err;                    /* INTSTS error flag */
+} CRPT_JOB_ENGINE_T;
+
+static const CRPT_JOB_ENGINE_T s_asCrptJobEngine[CRPT_JOB_ENGINE_NUM] =
+{
+    {CRPT_INTEN_AESIEN_Msk | CRPT_INTEN_AESEIEN_Msk, CRPT_INTSTS_AESIF_Msk, CRPT_INTSTS_AESEIF_Msk},
+    {CRPT_INTEN_HMACIEN_Msk | CRPT_INTEN_HMACEIEN_Msk, CRPT_INTSTS_HMACIF_Msk, CRPT_INTSTS_HMACEIF_Msk},
+    {CRPT_INTEN_RSAIEN_Msk | CRPT_INTEN_RSAEIEN_Msk, CRPT_INTSTS_RSAIF_Msk, CRPT_INTSTS_RSAEIF_Msk}
+};
+
+static S_CRPT_JOB_T *s_apsCrptJobQueue[CRPT_JOB_ENGINE_NUM];   /* Waiting jobs of each engine */
+static S_CRPT_JOB_T *s_apsCrptJobRun[CRPT_JOB_ENGINE_NUM];     /* Running job of each engine */
+
+/* No job is queued or running on any engine. Called with interrupts disabled. */
+static uint32_t CRPT_JobIdle(void)
+{
+    uint32_t i;
+
+    for(i = 0UL; i < CRPT_JOB_ENGINE_NUM; i++)
+    {
+        if((s_apsCrptJobQueue[i] != NULL) || (s_apsCrptJobRun[i] != NULL))
+            return 0UL;
+    }
+
+    return 1UL;
+}
+
+/* Start the next job of an idle engine. Called with interrupts disabled or from the IRQ handler. */
+static void CRPT_JobDispatch(CRPT_T *crpt, uint32_t u32Engine)
+{
+    const CRPT_JOB_ENGINE_T *psEng = &s_asCrptJobEngine[u32Engine];
+    S_CRPT_JOB_T *psJob = s_apsCrptJobQueue[u32Engine];
+
+    if(s_apsCrptJobRun[u32Engine] != NULL)
+        return;
+
+    if(psJob == NULL)
+    {
+        crpt->INTEN &= ~psEng->u32IntEn;
+        return;
+    }
+
+    s_apsCrptJobQueue[u32Engine] = psJob->psNext;
+    s_apsCrptJobRun[u32Engine] = psJob;
+    psJob->psNext = NULL;
+    psJob->i32Status = CRPT_JOB_RUNNING;
+
+    crpt->INTSTS = psEng->u32Done | psEng->u32Err;
+    crpt->INTEN |= psEng->u32IntEn;
+    psJob->pfnStart(crpt, psJob);
+}
+
+/** @endcond HIDDEN_SYMBOLS */
+
+/**
+  * @brief  Reset the crypto job scheduler
+  * @param[in]  crpt        The pointer of CRYPTO module
+  * @return None
+  * @details    Drops all queued and running jobs without calling their pfnDone. The CRPT IRQ handler
+  *             must call \ref CRPT_JobIRQHandler and the CRPT IRQ must be enabled in NVIC.
+  */
+void CRPT_JobInit(CRPT_T *crpt)
+{
+    uint32_t i;
+
+    for(i = 0UL; i < CRPT_JOB_ENGINE_NUM; i++)
+    {
+        crpt->INTEN &= ~s_asCrptJobEngine[i].u32IntEn;
+        s_apsCrptJobQueue[i] = NULL;
+        s_apsCrptJobRun[i] = NULL;
+    }
+}
+
+/**
+  * @brief  Queue a job on its engine
+  * @param[in]  crpt        The pointer of CRYPTO module
+  * @param[in]  psJob       Job to run. u32Engine, u32Priority, pfnStart, pfnDone and pvUser must be set, i32Status must not be CRPT_JOB_QUEUED or CRPT_JOB_RUNNING.
+  * @retval CRPT_JOB_OK         Job queued, or started if its engine was idle
+  * @retval CRPT_JOB_ERR_PARAM  Invalid job
+  * @retval CRPT_JOB_ERR_BUSY   Job is already queued or running, or an ECC operation runs
+  * @details    Each engine runs one job at a time, jobs of different engines run at the same time.
+  *             ECC operations do not run as jobs. They share the CRPT interrupt with the scheduler, so
+  *             an ECC operation waits until no job is queued or running, and no job is accepted while
+  *             it runs.
+  *             A job is queued behind jobs of the same or higher priority. It also stays behind any
+  *             job that was already overtaken \ref CRPT_JOB_OVERTAKE_MAX times, so a waiting job starts
+  *             after at most the jobs queued before it plus \ref CRPT_JOB_OVERTAKE_MAX later ones.
+  *             pfnStart runs with interrupts disabled, or from the CRPT interrupt, and must only program
+  *             and start the engine. pfnDone runs from the CRPT interrupt and may submit jobs.
+  */
+int32_t CRPT_JobSubmit(CRPT_T *crpt, S_CRPT_JOB_T *psJob)
+{
+    S_CRPT_JOB_T **ppsPos, *psIt;
+    uint32_t u32Primask;
+
+    if((psJob == NULL) || (psJob->u32Engine >= CRPT_JOB_ENGINE_NUM) || (psJob->pfnStart == NULL))
+        return CRPT_JOB_ERR_PARAM;
+
+    u32Primask = __get_PRIMASK();
+    __disable_irq();
+
+    if((psJob->i32Status == CRPT_JOB_QUEUED) || (psJob->i32Status == CRPT_JOB_RUNNING) ||
+            (crpt->ECC_STS & CRPT_ECC_STS_BUSY_Msk))
+    {
+        __set_PRIMASK(u32Primask);
+        return CRPT_JOB_ERR_BUSY;
+    }
+
+    /* Find the last job the new one may not overtake */
+    ppsPos = &s_apsCrptJobQueue[psJob->u32Engine];
+    for(psIt = *ppsPos; psIt != NULL; psIt = psIt->psNext)
+    {
+        if((psIt->u32Priority >= psJob->u32Priority) || (psIt->u32Overtaken >= CRPT_JOB_OVERTAKE_MAX))
+            ppsPos = &psIt->psNext;
+    }
+
+    for(psIt = *ppsPos; psIt != NULL; psIt = psIt->psNext)
+        psIt->u32Overtaken++;
+
+    psJob->u32Overtaken = 0UL;
+    psJob->psNext = *ppsPos;
+    psJob->i32Status = CRPT_JOB_QUEUED;
+    *ppsPos = psJob;
+
+    CRPT_JobDispatch(crpt, psJob->u32Engine);
+
+    __set_PRIMASK(u32Primask);
+
+    return CRPT_JOB_OK;
+}
+
+/**
+  * @brief  Remove a waiting job from its queue
+  * @param[in]  crpt        The pointer of CRYPTO module
+  * @param[in]  psJob       Job passed to \ref CRPT_JobSubmit
+  * @retval CRPT_JOB_OK         Job removed, its status is CRPT_JOB_ERR_CANCEL
+  * @retval CRPT_JOB_ERR_BUSY   Job is running and cannot be removed
+  * @retval CRPT_JOB_ERR_PARAM  Job is not queued
+  * @details    pfnDone is not called for a removed job.
+  */
+int32_t CRPT_JobCancel(CRPT_T *crpt, S_CRPT_JOB_T *psJob)
+{
+    S_CRPT_JOB_T **ppsPos;
+    uint32_t u32Primask;
+    int32_t i32Ret = CRPT_JOB_ERR_PARAM;
+
+    (void)crpt;
+
+    if((psJob == NULL) || (psJob->u32Engine >= CRPT_JOB_ENGINE_NUM))
+        return CRPT_JOB_ERR_PARAM;
+
+    u32Primask = __get_PRIMASK();
+    __disable_irq();
+
+    if(psJob->i32Status == CRPT_JOB_RUNNING)
+    {
+        i32Ret = CRPT_JOB_ERR_BUSY;
+    }
+    else
+    {
+        for(ppsPos = &s_apsCrptJobQueue[psJob->u32Engine]; *ppsPos != NULL; ppsPos = &(*ppsPos)->psNext)
+        {
+            if(*ppsPos == psJob)
+            {
+                *ppsPos = psJob->psNext;
+                psJob->psNext = NULL;
+                psJob->i32Status = CRPT_JOB_ERR_CANCEL;
+                i32Ret = CRPT_JOB_OK;
+                break;
+            }
+        }
+    }
+
+    __set_PRIMASK(u32Primask);
+
+    return i32Ret;
+}
+
+/**
+  * @brief  Wait for a job to finish
+  * @param[in]  crpt        The pointer of CRYPTO module
+  * @param[in]  psJob       Job passed to \ref CRPT_JobSubmit
+  * @return CRPT_JOB_OK, the error of the job, or CRPT_JOB_ERR_TIMEOUT
+  * @details    A job still waiting after \ref CRPT_JOB_TIMEOUT polls is removed from its queue.
+  *             A running job is left to its engine.
+  */
+int32_t CRPT_JobWait(CRPT_T *crpt, S_CRPT_JOB_T *psJob)
+{
+    uint32_t u32TimeOutCount = CRPT_JOB_TIMEOUT;
+
+    while((psJob->i32Status == CRPT_JOB_QUEUED) || (psJob->i32Status == CRPT_JOB_RUNNING))
+    {
+        if(--u32TimeOutCount == 0UL)
+        {
+            (void)CRPT_JobCancel(crpt, psJob);
+            return CRPT_JOB_ERR_TIMEOUT;
+        }
+    }
+
+    return psJob->i32Status;
+}
+
+/**
+  * @brief  Crypto job scheduler interrupt service
+  * @param[in]  crpt        The pointer of CRYPTO module
+  * @return None
+  * @details    Call from CRPT_IRQHandler. Finishes the running job of each engine that raised its done
+  *             or error flag, calls its pfnDone and starts the next job of that engine.
+  *             ECC flags are passed to \ref ECC_DriverISR, the ECC functions keep running in the caller context
+  *             and never overlap a job.
+  */
+NVT_FAST_CRYPTO_FUNC void CRPT_JobIRQHandler(CRPT_T *crpt)
+{
+    const CRPT_JOB_ENGINE_T *psEng;
+    S_CRPT_JOB_T *psJob;
+    uint32_t u32Sts = crpt->INTSTS;
+    uint32_t i;
+
+    for(i = 0UL; i < CRPT_JOB_ENGINE_NUM; i++)
+    {
+        psEng = &s_asCrptJobEngine[i];
+        psJob = s_apsCrptJobRun[i];
+
+        if((psJob == NULL) || ((u32Sts & (psEng->u32Done | psEng->u32Err)) == 0UL))
+            continue;
+
+        crpt->INTSTS = psEng->u32Done | psEng->u32Err;
+        s_apsCrptJobRun[i] = NULL;
+        psJob->i32Status = (u32Sts & psEng->u32Err) ? CRPT_JOB_ERR_ENGINE : CRPT_JOB_OK;
+
+        if(psJob->pfnDone != NULL)
+            psJob->pfnDone(crpt, psJob, psJob->i32Status);
+
+        CRPT_JobDispatch(crpt, i);
+    }
+
+    if(u32Sts & (CRPT_INTSTS_ECCIF_Msk | CRPT_INTSTS_ECCEIF_Msk))
+        ECC_DriverISR(crpt);
+}
+
 
 /**@}*/ /* end of group CRYPTO_EXPORTED_FUNCTIONS */
 
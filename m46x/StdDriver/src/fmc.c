@@ -77,6 +77,7 @@ int32_t FMC_ConfigXOM(uint32_t u32XomNum, uint32_t u32XomBase, uint8_t u8XomPage
         FMC->ISPDAT = u32XomBase;
         FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
         i32TimeOutCnt = FMC_TIMEOUT_WRITE;
+        NVT_WAIT_BEGIN(WAIT_SITE_FMC_PROGRAM);
         while(FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk)
         {
             if( i32TimeOutCnt-- <= 0)
@@ -86,6 +87,7 @@ int32_t FMC_ConfigXOM(uint32_t u32XomNum, uint32_t u32XomBase, uint8_t u8XomPage
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_FMC_PROGRAM);
 
         if(FMC->ISPSTS & FMC_ISPSTS_ISPFF_Msk)
         {
@@ -102,6 +104,7 @@ int32_t FMC_ConfigXOM(uint32_t u32XomNum, uint32_t u32XomBase, uint8_t u8XomPage
         FMC->ISPDAT = u8XomPage;
         FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
         i32TimeOutCnt = FMC_TIMEOUT_WRITE;
+        NVT_WAIT_BEGIN(WAIT_SITE_FMC_PROGRAM);
         while(FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk)
         {
             if( i32TimeOutCnt-- <= 0)
@@ -111,6 +114,7 @@ int32_t FMC_ConfigXOM(uint32_t u32XomNum, uint32_t u32XomBase, uint8_t u8XomPage
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_FMC_PROGRAM);
 
         if(FMC->ISPSTS & FMC_ISPSTS_ISPFF_Msk)
         {
@@ -127,6 +131,7 @@ int32_t FMC_ConfigXOM(uint32_t u32XomNum, uint32_t u32XomBase, uint8_t u8XomPage
         FMC->ISPDAT = 0u;
         FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
         i32TimeOutCnt = FMC_TIMEOUT_WRITE;
+        NVT_WAIT_BEGIN(WAIT_SITE_FMC_PROGRAM);
         while(FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk)
         {
             if( i32TimeOutCnt-- <= 0)
@@ -136,6 +141,7 @@ int32_t FMC_ConfigXOM(uint32_t u32XomNum, uint32_t u32XomBase, uint8_t u8XomPage
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_FMC_PROGRAM);
 
         if(FMC->ISPSTS & FMC_ISPSTS_ISPFF_Msk)
         {
@@ -171,6 +177,7 @@ int32_t FMC_Erase(uint32_t u32PageAddr)
     FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
 
     i32TimeOutCnt = FMC_TIMEOUT_ERASE;
+    NVT_WAIT_BEGIN(WAIT_SITE_FMC_ERASE);
     while(FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk)
     {
         if( i32TimeOutCnt-- <= 0)
@@ -180,6 +187,7 @@ int32_t FMC_Erase(uint32_t u32PageAddr)
             break;
         }
     }
+    NVT_WAIT_END(WAIT_SITE_FMC_ERASE);
 
     if (FMC->ISPCTL & FMC_ISPCTL_ISPFF_Msk)
     {
@@ -214,6 +222,7 @@ int32_t FMC_Erase_Bank(uint32_t u32BankAddr)
     FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
 
     i32TimeOutCnt = FMC_TIMEOUT_ERASE;
+    NVT_WAIT_BEGIN(WAIT_SITE_FMC_ERASE);
     while(FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk)
     {
         if( i32TimeOutCnt-- <= 0)
@@ -223,6 +232,7 @@ int32_t FMC_Erase_Bank(uint32_t u32BankAddr)
             break;
         }
     }
+    NVT_WAIT_END(WAIT_SITE_FMC_ERASE);
 
     if (FMC->ISPCTL & FMC_ISPCTL_ISPFF_Msk)
     {
@@ -233,6 +243,30 @@ int32_t FMC_Erase_Bank(uint32_t u32BankAddr)
     return ret;
 }
 
+/**
+  * @brief      Erase flash pages, step function of \ref WDT_RunLongOp
+  * @param[in]  pvCtx      Pointer to a uint32_t holding the address of page 0 of the operation
+  * @param[in]  u32Offset  Index of the first page to erase
+  * @param[in]  u32Count   Number of pages to erase
+  * @return     Erase success or not.
+  * @retval     0   Success
+  * @retval     -1  Erase failed
+  * @details    Erases a region page by page so that the watchdogs can be fed between chunks,
+  *             e.g. a bank with u32Total = FMC_BANK_SIZE / FMC_FLASH_PAGE_SIZE instead of \ref FMC_Erase_Bank.
+  */
+int32_t FMC_EraseStep(void *pvCtx, uint32_t u32Offset, uint32_t u32Count)
+{
+    uint32_t u32Addr = *(uint32_t *)pvCtx + u32Offset * FMC_FLASH_PAGE_SIZE;
+
+    while(u32Count-- > 0UL)
+    {
+        if(FMC_Erase(u32Addr) != 0)
+            return -1;
+        u32Addr += FMC_FLASH_PAGE_SIZE;
+    }
+    return 0;
+}
+
 /**
   * @brief  Execute Erase XOM Region
   *
@@ -401,14 +435,17 @@ uint32_t FMC_Read(uint32_t u32Addr)
     FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
 
     i32TimeOutCnt = FMC_TIMEOUT_READ;
+    NVT_WAIT_BEGIN(WAIT_SITE_FMC_READ);
     while (FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk)
     {
         if( i32TimeOutCnt-- <= 0)
         {
             g_FMC_i32ErrCode = -1;
+            NVT_WAIT_END(WAIT_SITE_FMC_READ);
             return 0xFFFFFFFF;
         }
     }
+    NVT_WAIT_END(WAIT_SITE_FMC_READ);
 
     return FMC->ISPDAT;
 }
@@ -438,6 +475,7 @@ int32_t FMC_Read_64(uint32_t u32addr, uint32_t * u32data0, uint32_t * u32data1)
     FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
 
     i32TimeOutCnt = FMC_TIMEOUT_READ;
+    NVT_WAIT_BEGIN(WAIT_SITE_FMC_READ);
     while (FMC->ISPSTS & FMC_ISPSTS_ISPBUSY_Msk)
     {
         if( i32TimeOutCnt-- <= 0)
@@ -447,6 +485,7 @@ int32_t FMC_Read_64(uint32_t u32addr, uint32_t * u32data0, uint32_t * u32data1)
             break;
         }
     }
+    NVT_WAIT_END(WAIT_SITE_FMC_READ);
 
     if (FMC->ISPSTS & FMC_ISPSTS_ISPFF_Msk)
     {
@@ -516,14 +555,17 @@ int32_t FMC_Write(uint32_t u32Addr, uint32_t u32Data)
     FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
 
     i32TimeOutCnt = FMC_TIMEOUT_WRITE;
+    NVT_WAIT_BEGIN(WAIT_SITE_FMC_PROGRAM);
     while (FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk)
     {
         if( i32TimeOutCnt-- <= 0)
         {
             g_FMC_i32ErrCode = -1;
+            NVT_WAIT_END(WAIT_SITE_FMC_PROGRAM);
             return -1;
         }
     }
+    NVT_WAIT_END(WAIT_SITE_FMC_PROGRAM);
 
     return 0;
 }
@@ -553,6 +595,7 @@ int32_t FMC_Write8Bytes(uint32_t u32addr, uint32_t u32data0, uint32_t u32data1)
     FMC->ISPTRG  = FMC_ISPTRG_ISPGO_Msk;
 
     i32TimeOutCnt = FMC_TIMEOUT_WRITE;
+    NVT_WAIT_BEGIN(WAIT_SITE_FMC_PROGRAM);
     while (FMC->ISPSTS & FMC_ISPSTS_ISPBUSY_Msk)
     {
         if( i32TimeOutCnt-- <= 0)
@@ -561,6 +604,7 @@ int32_t FMC_Write8Bytes(uint32_t u32addr, uint32_t u32data0, uint32_t u32data1)
             ret = -1;
         }
     }
+    NVT_WAIT_END(WAIT_SITE_FMC_PROGRAM);
 
     if (FMC->ISPSTS & FMC_ISPSTS_ISPFF_Msk)
     {
@@ -729,6 +773,7 @@ int32_t FMC_WriteOTP(uint32_t otp_num, uint32_t low_word, uint32_t high_word)
         FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
 
         i32TimeOutCnt = FMC_TIMEOUT_WRITE;
+        NVT_WAIT_BEGIN(WAIT_SITE_FMC_PROGRAM);
         while (FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk)
         {
             if( i32TimeOutCnt-- <= 0)
@@ -738,6 +783,7 @@ int32_t FMC_WriteOTP(uint32_t otp_num, uint32_t low_word, uint32_t high_word)
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_FMC_PROGRAM);
 
         if (FMC->ISPSTS & FMC_ISPSTS_ISPFF_Msk)
         {
@@ -755,6 +801,7 @@ int32_t FMC_WriteOTP(uint32_t otp_num, uint32_t low_word, uint32_t high_word)
         FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
 
         i32TimeOutCnt = FMC_TIMEOUT_WRITE;
+        NVT_WAIT_BEGIN(WAIT_SITE_FMC_PROGRAM);
         while (FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk)
         {
             if( i32TimeOutCnt-- <= 0)
@@ -764,6 +811,7 @@ int32_t FMC_WriteOTP(uint32_t otp_num, uint32_t low_word, uint32_t high_word)
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_FMC_PROGRAM);
 
         if (FMC->ISPSTS & FMC_ISPSTS_ISPFF_Msk)
         {
@@ -810,6 +858,7 @@ int32_t FMC_ReadOTP(uint32_t otp_num, uint32_t *low_word, uint32_t *high_word)
         FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
 
         i32TimeOutCnt = FMC_TIMEOUT_READ;
+        NVT_WAIT_BEGIN(WAIT_SITE_FMC_READ);
         while (FMC->ISPSTS & FMC_ISPSTS_ISPBUSY_Msk)
         {
             if( i32TimeOutCnt-- <= 0)
@@ -819,6 +868,7 @@ int32_t FMC_ReadOTP(uint32_t otp_num, uint32_t *low_word, uint32_t *high_word)
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_FMC_READ);
 
         if (FMC->ISPSTS & FMC_ISPSTS_ISPFF_Msk)
         {
@@ -867,6 +917,7 @@ int32_t FMC_LockOTP(uint32_t otp_num)
         FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
 
         i32TimeOutCnt = FMC_TIMEOUT_WRITE;
+        NVT_WAIT_BEGIN(WAIT_SITE_FMC_PROGRAM);
         while (FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk)
         {
             if( i32TimeOutCnt-- <= 0)
@@ -876,6 +927,7 @@ int32_t FMC_LockOTP(uint32_t otp_num)
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_FMC_PROGRAM);
 
         if (FMC->ISPSTS & FMC_ISPSTS_ISPFF_Msk)
         {
@@ -919,6 +971,7 @@ int32_t FMC_IsOTPLocked(uint32_t otp_num)
         FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
 
         i32TimeOutCnt = FMC_TIMEOUT_READ;
+        NVT_WAIT_BEGIN(WAIT_SITE_FMC_READ);
         while (FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk)
         {
             if( i32TimeOutCnt-- <= 0)
@@ -928,6 +981,7 @@ int32_t FMC_IsOTPLocked(uint32_t otp_num)
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_FMC_READ);
 
         if (FMC->ISPSTS & FMC_ISPSTS_ISPFF_Msk)
         {
@@ -1074,28 +1128,34 @@ uint32_t  FMC_GetChkSum(uint32_t u32addr, uint32_t u32count)
         FMC->ISPTRG  = FMC_ISPTRG_ISPGO_Msk;
 
         i32TimeOutCnt = FMC_TIMEOUT_CHKSUM;
+        NVT_WAIT_BEGIN(WAIT_SITE_FMC_CHKSUM);
         while (FMC->ISPSTS & FMC_ISPSTS_ISPBUSY_Msk)
         {
             if( i32TimeOutCnt-- <= 0)
             {
                 g_FMC_i32ErrCode = -1;
+                NVT_WAIT_END(WAIT_SITE_FMC_CHKSUM);
                 return 0xFFFFFFFF;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_FMC_CHKSUM);
 
         FMC->ISPCMD = FMC_ISPCMD_READ_CKS;
         FMC->ISPADDR    = u32addr;
         FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
 
         i32TimeOutCnt = FMC_TIMEOUT_CHKSUM;
+        NVT_WAIT_BEGIN(WAIT_SITE_FMC_CHKSUM);
         while (FMC->ISPSTS & FMC_ISPSTS_ISPBUSY_Msk)
         {
             if( i32TimeOutCnt-- <= 0)
             {
                 g_FMC_i32ErrCode = -1;
+                NVT_WAIT_END(WAIT_SITE_FMC_CHKSUM);
                 return 0xFFFFFFFF;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_FMC_CHKSUM);
 
         ret = FMC->ISPDAT;
     }
@@ -1130,6 +1190,7 @@ uint32_t  FMC_CheckAllOne(uint32_t u32addr, uint32_t u32count)
     FMC->ISPTRG   = FMC_ISPTRG_ISPGO_Msk;
 
     i32TimeOutCnt0 = FMC_TIMEOUT_CHKALLONE;
+    NVT_WAIT_BEGIN(WAIT_SITE_FMC_CHKSUM);
     while (FMC->ISPSTS & FMC_ISPSTS_ISPBUSY_Msk)
     {
         if( i32TimeOutCnt0-- <= 0)
@@ -1138,6 +1199,7 @@ uint32_t  FMC_CheckAllOne(uint32_t u32addr, uint32_t u32count)
             break;
         }
     }
+    NVT_WAIT_END(WAIT_SITE_FMC_CHKSUM);
 
     if(g_FMC_i32ErrCode == 0)
     {
@@ -1149,6 +1211,7 @@ uint32_t  FMC_CheckAllOne(uint32_t u32addr, uint32_t u32count)
             FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
 
             i32TimeOutCnt0 = FMC_TIMEOUT_CHKALLONE;
+            NVT_WAIT_BEGIN(WAIT_SITE_FMC_CHKSUM);
             while (FMC->ISPSTS & FMC_ISPSTS_ISPBUSY_Msk)
             {
                 if( i32TimeOutCnt0-- <= 0)
@@ -1157,6 +1220,7 @@ uint32_t  FMC_CheckAllOne(uint32_t u32addr, uint32_t u32count)
                     break;
                 }
             }
+            NVT_WAIT_END(WAIT_SITE_FMC_CHKSUM);
 
             if( i32TimeOutCnt1-- <= 0)
             {
@@ -1205,6 +1269,7 @@ int32_t FMC_RemapBank(uint32_t u32Bank)
     FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
 
     i32TimeOutCnt = FMC_TIMEOUT_WRITE;
+    NVT_WAIT_BEGIN(WAIT_SITE_FMC_PROGRAM);
     while(FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk)
     {
         if( i32TimeOutCnt-- <= 0)
@@ -1214,6 +1279,7 @@ int32_t FMC_RemapBank(uint32_t u32Bank)
             break;
         }
     }
+    NVT_WAIT_END(WAIT_SITE_FMC_PROGRAM);
 
     if(FMC->ISPCTL & FMC_ISPCTL_ISPFF_Msk)
     {
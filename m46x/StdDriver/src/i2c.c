@@ -711,6 +711,7 @@ uint8_t I2C_WriteByte(I2C_T *i2c, uint8_t u8SlaveAddr, uint8_t data)
     while(u8Xfering && (u8Err == 0u))
     {
         u32TimeOutCount = I2C_TIMEOUT;
+        NVT_WAIT_BEGIN(WAIT_SITE_I2C);
         I2C_WAIT_READY(i2c)
         {
             if(--u32TimeOutCount == 0)
@@ -720,6 +721,7 @@ uint8_t I2C_WriteByte(I2C_T *i2c, uint8_t u8SlaveAddr, uint8_t data)
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_I2C);
 
         switch(I2C_GET_STATUS(i2c))
         {
@@ -778,6 +780,7 @@ uint32_t I2C_WriteMultiBytes(I2C_T *i2c, uint8_t u8SlaveAddr, uint8_t data[], ui
     while(u8Xfering && (u8Err == 0u))
     {
         u32TimeOutCount = I2C_TIMEOUT;
+        NVT_WAIT_BEGIN(WAIT_SITE_I2C);
         I2C_WAIT_READY(i2c)
         {
             if(--u32TimeOutCount == 0)
@@ -787,6 +790,7 @@ uint32_t I2C_WriteMultiBytes(I2C_T *i2c, uint8_t u8SlaveAddr, uint8_t data[], ui
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_I2C);
 
         switch(I2C_GET_STATUS(i2c))
         {
@@ -851,6 +855,7 @@ uint8_t I2C_WriteByteOneReg(I2C_T *i2c, uint8_t u8SlaveAddr, uint8_t u8DataAddr,
     while(u8Xfering && (u8Err == 0u))
     {
         u32TimeOutCount = I2C_TIMEOUT;
+        NVT_WAIT_BEGIN(WAIT_SITE_I2C);
         I2C_WAIT_READY(i2c)
         {
             if(--u32TimeOutCount == 0)
@@ -860,6 +865,7 @@ uint8_t I2C_WriteByteOneReg(I2C_T *i2c, uint8_t u8SlaveAddr, uint8_t u8DataAddr,
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_I2C);
 
         switch(I2C_GET_STATUS(i2c))
         {
@@ -928,6 +934,7 @@ uint32_t I2C_WriteMultiBytesOneReg(I2C_T *i2c, uint8_t u8SlaveAddr, uint8_t u8Da
     while(u8Xfering && (u8Err == 0u))
     {
         u32TimeOutCount = I2C_TIMEOUT;
+        NVT_WAIT_BEGIN(WAIT_SITE_I2C);
         I2C_WAIT_READY(i2c)
         {
             if(--u32TimeOutCount == 0)
@@ -937,6 +944,7 @@ uint32_t I2C_WriteMultiBytesOneReg(I2C_T *i2c, uint8_t u8SlaveAddr, uint8_t u8Da
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_I2C);
 
         switch(I2C_GET_STATUS(i2c))
         {
@@ -1004,6 +1012,7 @@ uint8_t I2C_WriteByteTwoRegs(I2C_T *i2c, uint8_t u8SlaveAddr, uint16_t u16DataAd
     while(u8Xfering && (u8Err == 0u))
     {
         u32TimeOutCount = I2C_TIMEOUT;
+        NVT_WAIT_BEGIN(WAIT_SITE_I2C);
         I2C_WAIT_READY(i2c)
         {
             if(--u32TimeOutCount == 0)
@@ -1013,6 +1022,7 @@ uint8_t I2C_WriteByteTwoRegs(I2C_T *i2c, uint8_t u8SlaveAddr, uint16_t u16DataAd
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_I2C);
 
         switch(I2C_GET_STATUS(i2c))
         {
@@ -1086,6 +1096,7 @@ uint32_t I2C_WriteMultiBytesTwoRegs(I2C_T *i2c, uint8_t u8SlaveAddr, uint16_t u1
     while(u8Xfering && (u8Err == 0u))
     {
         u32TimeOutCount = I2C_TIMEOUT;
+        NVT_WAIT_BEGIN(WAIT_SITE_I2C);
         I2C_WAIT_READY(i2c)
         {
             if(--u32TimeOutCount == 0)
@@ -1095,6 +1106,7 @@ uint32_t I2C_WriteMultiBytesTwoRegs(I2C_T *i2c, uint8_t u8SlaveAddr, uint16_t u1
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_I2C);
 
         switch(I2C_GET_STATUS(i2c))
         {
@@ -1162,6 +1174,7 @@ uint8_t I2C_ReadByte(I2C_T *i2c, uint8_t u8SlaveAddr)
     while(u8Xfering && (u8Err == 0u))
     {
         u32TimeOutCount = I2C_TIMEOUT;
+        NVT_WAIT_BEGIN(WAIT_SITE_I2C);
         I2C_WAIT_READY(i2c)
         {
             if(--u32TimeOutCount == 0)
@@ -1171,6 +1184,7 @@ uint8_t I2C_ReadByte(I2C_T *i2c, uint8_t u8SlaveAddr)
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_I2C);
 
         switch(I2C_GET_STATUS(i2c))
         {
@@ -1233,6 +1247,7 @@ uint32_t I2C_ReadMultiBytes(I2C_T *i2c, uint8_t u8SlaveAddr, uint8_t rdata[], ui
     while(u8Xfering && (u8Err == 0u))
     {
         u32TimeOutCount = I2C_TIMEOUT;
+        NVT_WAIT_BEGIN(WAIT_SITE_I2C);
         I2C_WAIT_READY(i2c)
         {
             if(--u32TimeOutCount == 0)
@@ -1242,6 +1257,7 @@ uint32_t I2C_ReadMultiBytes(I2C_T *i2c, uint8_t u8SlaveAddr, uint8_t rdata[], ui
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_I2C);
 
         switch(I2C_GET_STATUS(i2c))
         {
@@ -1310,6 +1326,7 @@ uint8_t I2C_ReadByteOneReg(I2C_T *i2c, uint8_t u8SlaveAddr, uint8_t u8DataAddr)
     while(u8Xfering && (u8Err == 0u))
     {
         u32TimeOutCount = I2C_TIMEOUT;
+        NVT_WAIT_BEGIN(WAIT_SITE_I2C);
         I2C_WAIT_READY(i2c)
         {
             if(--u32TimeOutCount == 0)
@@ -1319,6 +1336,7 @@ uint8_t I2C_ReadByteOneReg(I2C_T *i2c, uint8_t u8SlaveAddr, uint8_t u8DataAddr)
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_I2C);
 
         switch(I2C_GET_STATUS(i2c))
         {
@@ -1396,6 +1414,7 @@ uint32_t I2C_ReadMultiBytesOneReg(I2C_T *i2c, uint8_t u8SlaveAddr, uint8_t u8Dat
     while(u8Xfering && (u8Err == 0u))
     {
         u32TimeOutCount = I2C_TIMEOUT;
+        NVT_WAIT_BEGIN(WAIT_SITE_I2C);
         I2C_WAIT_READY(i2c)
         {
             if(--u32TimeOutCount == 0)
@@ -1405,6 +1424,7 @@ uint32_t I2C_ReadMultiBytesOneReg(I2C_T *i2c, uint8_t u8SlaveAddr, uint8_t u8Dat
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_I2C);
 
         switch(I2C_GET_STATUS(i2c))
         {
@@ -1487,6 +1507,7 @@ uint8_t I2C_ReadByteTwoRegs(I2C_T *i2c, uint8_t u8SlaveAddr, uint16_t u16DataAdd
     while(u8Xfering && (u8Err == 0u))
     {
         u32TimeOutCount = I2C_TIMEOUT;
+        NVT_WAIT_BEGIN(WAIT_SITE_I2C);
         I2C_WAIT_READY(i2c)
         {
             if(--u32TimeOutCount == 0)
@@ -1496,6 +1517,7 @@ uint8_t I2C_ReadByteTwoRegs(I2C_T *i2c, uint8_t u8SlaveAddr, uint16_t u16DataAdd
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_I2C);
 
         switch(I2C_GET_STATUS(i2c))
         {
@@ -1581,6 +1603,7 @@ uint32_t I2C_ReadMultiBytesTwoRegs(I2C_T *i2c, uint8_t u8SlaveAddr, uint16_t u16
     while(u8Xfering && (u8Err == 0u))
     {
         u32TimeOutCount = I2C_TIMEOUT;
+        NVT_WAIT_BEGIN(WAIT_SITE_I2C);
         I2C_WAIT_READY(i2c)
         {
             if(--u32TimeOutCount == 0)
@@ -1590,6 +1613,7 @@ uint32_t I2C_ReadMultiBytesTwoRegs(I2C_T *i2c, uint8_t u8SlaveAddr, uint16_t u16
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_I2C);
 
         switch(I2C_GET_STATUS(i2c))
         {
@@ -1655,6 +1679,940 @@ uint32_t I2C_ReadMultiBytesTwoRegs(I2C_T *i2c, uint8_t u8SlaveAddr, uint16_t u16
     return u32rxLen;                                                        /* Return bytes length that have been received */
 }
 
+/** @cond HIDDEN_SYMBOLS */
+
+#define I2C_SMBUS_F_CMD     0x01U   /* Command code is sent */
+#define I2C_SMBUS_F_TXCNT   0x02U   /* Write data is preceded by its byte count */
+#define I2C_SMBUS_F_TXVAR   0x04U   /* Write length is given by u8TxLen */
+#define I2C_SMBUS_F_RD      0x08U   /* Read phase after (repeated) START */
+#define I2C_SMBUS_F_RXCNT   0x10U   /* Read data is preceded by its byte count */
+
+typedef struct
+{
+    uint8_t u8Flags;
+    uint8_t u8TxLen;                /* Write length of the fixed protocols */
+    uint8_t u8RxLen;                /* Read length of the fixed protocols */
+} I2C_SMBUS_PROTO_T;
+
+static const I2C_SMBUS_PROTO_T s_asI2cSmbusProto[] =
+{
+    { I2C_SMBUS_F_CMD,                                                          0U, 0U },   /* SEND_BYTE */
+    { I2C_SMBUS_F_RD,                                                           0U, 1U },   /* RECV_BYTE */
+    { I2C_SMBUS_F_CMD,                                                          1U, 0U },   /* WRITE_BYTE */
+    { I2C_SMBUS_F_CMD | I2C_SMBUS_F_RD,                                         0U, 1U },   /* READ_BYTE */
+    { I2C_SMBUS_F_CMD,                                                          2U, 0U },   /* WRITE_WORD */
+    { I2C_SMBUS_F_CMD | I2C_SMBUS_F_RD,                                         0U, 2U },   /* READ_WORD */
+    { I2C_SMBUS_F_CMD | I2C_SMBUS_F_RD,                                         2U, 2U },   /* PROC_CALL */
+    { I2C_SMBUS_F_CMD | I2C_SMBUS_F_TXCNT | I2C_SMBUS_F_TXVAR,                  0U, 0U },   /* BLOCK_WRITE */
+    { I2C_SMBUS_F_CMD | I2C_SMBUS_F_RD | I2C_SMBUS_F_RXCNT,                     0U, 0U },   /* BLOCK_READ */
+    { I2C_SMBUS_F_CMD | I2C_SMBUS_F_TXCNT | I2C_SMBUS_F_TXVAR | I2C_SMBUS_F_RD | I2C_SMBUS_F_RXCNT, 0U, 0U },   /* BLOCK_PROC_CALL */
+};
+
+typedef struct
+{
+    S_I2C_SMBUS_MSG_T *psMsg;       /* Running transaction, NULL when idle */
+    uint32_t u32Left;               /* Transactions queued after psMsg */
+    I2C_SMBUS_DONE_FUNC pfnDone;
+    void    *pvUser;
+    uint32_t u32Flags;              /* I2C_SMBUS_F_xxx of psMsg */
+    uint32_t u32TxIdx;              /* Next byte of the write phase */
+    uint32_t u32TxTotal;            /* Write phase length with command code and byte count, without PEC */
+    uint32_t u32RxIdx;              /* Data bytes received */
+    uint32_t u32RxTotal;            /* Data bytes expected, known after the byte count for block reads */
+    uint32_t u32GotCnt;             /* Block byte count received */
+    uint8_t  u8Pec;                 /* Hardware PEC before the received PEC byte */
+    volatile int32_t i32Status;     /* I2C_SMBUS_BUSY while the list runs */
+} I2C_SMBUS_ENGINE_T;
+
+#define I2C_PORT_NUM        5U      /* I2C0 to I2C4 */
+
+static I2C_SMBUS_ENGINE_T s_asI2cSmbus[I2C_PORT_NUM];
+
+static uint32_t I2C_PortIdx(I2C_T *i2c)
+{
+    if(i2c == I2C0)
+        return 0UL;
+    else if(i2c == I2C1)
+        return 1UL;
+    else if(i2c == I2C2)
+        return 2UL;
+    else if(i2c == I2C3)
+        return 3UL;
+    else
+        return 4UL;
+}
+
+static I2C_SMBUS_ENGINE_T *I2C_SMBusGet(I2C_T *i2c)
+{
+    return &s_asI2cSmbus[I2C_PortIdx(i2c)];
+}
+
+static void I2C_SMBusLoad(I2C_SMBUS_ENGINE_T *psEng)
+{
+    S_I2C_SMBUS_MSG_T *psMsg = psEng->psMsg;
+    const I2C_SMBUS_PROTO_T *psProto = &s_asI2cSmbusProto[psMsg->u8Proto];
+
+    psEng->u32Flags = psProto->u8Flags;
+    psEng->u32TxIdx = 0UL;
+    psEng->u32TxTotal = (psProto->u8Flags & I2C_SMBUS_F_TXVAR) ? psMsg->u8TxLen : psProto->u8TxLen;
+    if(psProto->u8Flags & I2C_SMBUS_F_TXCNT)
+        psEng->u32TxTotal++;
+    if(psProto->u8Flags & I2C_SMBUS_F_CMD)
+        psEng->u32TxTotal++;
+    psEng->u32RxIdx = 0UL;
+    psEng->u32RxTotal = psProto->u8RxLen;
+    psEng->u32GotCnt = 0UL;
+    psMsg->i32Status = I2C_SMBUS_BUSY;
+}
+
+/* Next byte of the write phase, -1 when the write phase is over */
+static int32_t I2C_SMBusNextTx(I2C_T *i2c, I2C_SMBUS_ENGINE_T *psEng)
+{
+    S_I2C_SMBUS_MSG_T *psMsg = psEng->psMsg;
+    uint32_t u32Idx = psEng->u32TxIdx++;
+
+    if(u32Idx < psEng->u32TxTotal)
+    {
+        if(psEng->u32Flags & I2C_SMBUS_F_CMD)
+        {
+            if(u32Idx == 0UL)
+                return psMsg->u8Cmd;
+            u32Idx--;
+        }
+        if(psEng->u32Flags & I2C_SMBUS_F_TXCNT)
+        {
+            if(u32Idx == 0UL)
+                return psMsg->u8TxLen;
+            u32Idx--;
+        }
+        return psMsg->pu8Tx[u32Idx];
+    }
+
+    /* PEC of a write-only transaction covers everything sent so far */
+    if((u32Idx == psEng->u32TxTotal) && psMsg->u8Pec && !(psEng->u32Flags & I2C_SMBUS_F_RD))
+        return I2C_SMBusGetPECValue(i2c);
+
+    return -1;
+}
+
+/* Bytes still to be read, PEC included */
+static uint32_t I2C_SMBusRxLeft(I2C_SMBUS_ENGINE_T *psEng)
+{
+    if((psEng->u32Flags & I2C_SMBUS_F_RXCNT) && !psEng->u32GotCnt)
+        return 2UL;
+
+    return psEng->u32RxTotal - psEng->u32RxIdx + (psEng->psMsg->u8Pec ? 1UL : 0UL);
+}
+
+static int32_t I2C_SMBusRxByte(I2C_T *i2c, I2C_SMBUS_ENGINE_T *psEng, uint8_t u8Data)
+{
+    S_I2C_SMBUS_MSG_T *psMsg = psEng->psMsg;
+
+    if((psEng->u32Flags & I2C_SMBUS_F_RXCNT) && !psEng->u32GotCnt)
+    {
+        psEng->u32GotCnt = 1UL;
+        if((u8Data == 0U) || (u8Data > psMsg->u8RxLen))
+            return I2C_SMBUS_ERR_SIZE;
+        psEng->u32RxTotal = u8Data;
+    }
+    else if(psEng->u32RxIdx < psEng->u32RxTotal)
+    {
+        psMsg->pu8Rx[psEng->u32RxIdx++] = u8Data;
+    }
+    else
+    {
+        return (u8Data == psEng->u8Pec) ? I2C_SMBUS_OK : I2C_SMBUS_ERR_PEC;
+    }
+
+    /* The hardware PEC now covers the whole packet, the next byte must match it */
+    if(psMsg->u8Pec && (psEng->u32RxIdx == psEng->u32RxTotal))
+        psEng->u8Pec = I2C_SMBusGetPECValue(i2c);
+
+    return I2C_SMBUS_BUSY;
+}
+
+/* Drop the transactions queued after the running one, they report why they did not run */
+static void I2C_SMBusDropRest(I2C_SMBUS_ENGINE_T *psEng, int32_t i32Status)
+{
+    uint32_t i;
+
+    for(i = 1UL; i <= psEng->u32Left; i++)
+        psEng->psMsg[i].i32Status = i32Status;
+    psEng->u32Left = 0UL;
+}
+
+/* Complete the running transaction and return the control bits to write */
+static uint32_t I2C_SMBusFinish(I2C_SMBUS_ENGINE_T *psEng, int32_t i32Status)
+{
+    S_I2C_SMBUS_MSG_T *psMsg = psEng->psMsg;
+
+    psMsg->i32Status = i32Status;
+    if(psEng->u32Flags & I2C_SMBUS_F_RD)
+        psMsg->u8RxLen = (uint8_t)psEng->u32RxIdx;
+    if((i32Status != I2C_SMBUS_OK) && (psEng->i32Status == I2C_SMBUS_BUSY))
+        psEng->i32Status = i32Status;
+
+    /* Arbitration loss, bus error and time-out end the list */
+    if((i32Status == I2C_SMBUS_ERR_ARB) || (i32Status == I2C_SMBUS_ERR_BUS) || (i32Status == I2C_SMBUS_ERR_TIMEOUT))
+        I2C_SMBusDropRest(psEng, i32Status);
+
+    if(i32Status == I2C_SMBUS_ERR_ARB)
+    {
+        /* Another host owns the bus, do not send STOP */
+        psEng->psMsg = NULL;
+        return I2C_CTL_SI;
+    }
+
+    if(psEng->u32Left != 0UL)
+    {
+        /* STOP, then START of the next transaction */
+        psEng->psMsg++;
+        psEng->u32Left--;
+        I2C_SMBusLoad(psEng);
+        return I2C_CTL_STO_SI | I2C_CTL_STA;
+    }
+
+    psEng->psMsg = NULL;
+    return I2C_CTL_STO_SI;
+}
+
+/** @endcond HIDDEN_SYMBOLS */
+
+/**
+ * @brief      Start a list of SMBus transactions
+ *
+ * @param[in]  i2c          Specify I2C port
+ * @param[in]  asMsg        Transactions, run in order with STOP and START between them
+ * @param[in]  u32MsgCnt    Number of transactions
+ * @param[in]  pfnDone      Called from \ref I2C_SMBusIRQHandler when the list finished, may be NULL
+ * @param[in]  pvUser       Passed to pfnDone
+ *
+ * @retval     I2C_SMBUS_OK         The first transaction started
+ * @retval     I2C_SMBUS_ERR_BUSY   The port is running another list
+ * @retval     I2C_SMBUS_ERR_PARAM  Invalid protocol, length or buffer
+ *
+ * @details    The transactions are driven by the I2C interrupt, the I2C IRQ handler must call
+ *             \ref I2C_SMBusIRQHandler. Each transaction reports its own i32Status. A NACK, size or
+ *             PEC error does not stop the list, so a table of I2C_SMBUS_PROTO_READ_WORD transactions
+ *             polls a set of PMBus registers in one call. Arbitration loss, a bus error or a time-out
+ *             ends the list; the transactions that did not run report the same error.
+ *             PEC is computed by the PKTCRC hardware. It is appended to writes and compared with the
+ *             received byte on reads, and covers the address bytes as the SMBus specification requires.
+ * @note       The port must be opened and put into SMBus host mode by \ref I2C_SMBusOpen.
+ */
+int32_t I2C_SMBusXfer(I2C_T *i2c, S_I2C_SMBUS_MSG_T asMsg[], uint32_t u32MsgCnt, I2C_SMBUS_DONE_FUNC pfnDone, void *pvUser)
+{
+    I2C_SMBUS_ENGINE_T *psEng = I2C_SMBusGet(i2c);
+    const I2C_SMBUS_PROTO_T *psProto;
+    uint32_t i, u32TxLen;
+
+    if((asMsg == NULL) || (u32MsgCnt == 0UL))
+        return I2C_SMBUS_ERR_PARAM;
+
+    for(i = 0UL; i < u32MsgCnt; i++)
+    {
+        if(asMsg[i].u8Proto >= sizeof(s_asI2cSmbusProto) / sizeof(s_asI2cSmbusProto[0]))
+            return I2C_SMBUS_ERR_PARAM;
+
+        psProto = &s_asI2cSmbusProto[asMsg[i].u8Proto];
+        u32TxLen = (psProto->u8Flags & I2C_SMBUS_F_TXVAR) ? asMsg[i].u8TxLen : psProto->u8TxLen;
+        if((psProto->u8Flags & I2C_SMBUS_F_TXVAR) && (u32TxLen == 0UL))
+            return I2C_SMBUS_ERR_PARAM;
+        if((u32TxLen != 0UL) && (asMsg[i].pu8Tx == NULL))
+            return I2C_SMBUS_ERR_PARAM;
+        if((psProto->u8Flags & I2C_SMBUS_F_RD) &&
+                ((asMsg[i].pu8Rx == NULL) || (asMsg[i].u8RxLen < psProto->u8RxLen) ||
+                 ((psProto->u8Flags & I2C_SMBUS_F_RXCNT) && (asMsg[i].u8RxLen == 0U))))
+            return I2C_SMBUS_ERR_PARAM;
+    }
+
+    if(psEng->psMsg != NULL)
+        return I2C_SMBUS_ERR_BUSY;
+
+    for(i = 0UL; i < u32MsgCnt; i++)
+        asMsg[i].i32Status = I2C_SMBUS_BUSY;
+
+    psEng->psMsg = asMsg;
+    psEng->u32Left = u32MsgCnt - 1UL;
+    psEng->pfnDone = pfnDone;
+    psEng->pvUser = pvUser;
+    psEng->i32Status = I2C_SMBUS_BUSY;
+    I2C_SMBusLoad(psEng);
+
+    /* Accumulate PEC from each START, across repeated STARTs */
+    i2c->BUSCTL = (i2c->BUSCTL & ~(I2C_BUSCTL_PECTXEN_Msk | I2C_BUSCTL_PECCLR_Msk)) | I2C_BUSCTL_PECEN_Msk;
+
+    I2C_EnableInt(i2c);
+    I2C_SET_CONTROL_REG(i2c, I2C_CTL_STA);
+
+    return I2C_SMBUS_OK;
+}
+
+/**
+ * @brief      Wait for the transaction list of a port
+ *
+ * @param[in]  i2c          Specify I2C port
+ *
+ * @return     I2C_SMBUS_OK, the first error of the list, or I2C_SMBUS_ERR_TIMEOUT
+ *
+ * @details    If the list does not finish within \ref I2C_SMBUS_TIMEOUT the bus is released with a STOP.
+ */
+int32_t I2C_SMBusWait(I2C_T *i2c)
+{
+    I2C_SMBUS_ENGINE_T *psEng = I2C_SMBusGet(i2c);
+    uint32_t u32TimeOutCount = I2C_SMBUS_TIMEOUT;
+
+    while(psEng->i32Status == I2C_SMBUS_BUSY)
+    {
+        if(--u32TimeOutCount == 0UL)
+        {
+            I2C_DisableInt(i2c);
+            if(psEng->psMsg != NULL)
+            {
+                psEng->psMsg->i32Status = I2C_SMBUS_ERR_TIMEOUT;
+                I2C_SMBusDropRest(psEng, I2C_SMBUS_ERR_TIMEOUT);
+            }
+            psEng->psMsg = NULL;
+            psEng->i32Status = I2C_SMBUS_ERR_TIMEOUT;
+            I2C_SET_CONTROL_REG(i2c, I2C_CTL_STO_SI);
+            break;
+        }
+    }
+
+    return psEng->i32Status;
+}
+
+/**
+ * @brief      SMBus transaction engine interrupt service
+ *
+ * @param[in]  i2c          Specify I2C port
+ *
+ * @return     None
+ *
+ * @details    Call from the IRQ handler of a port used with \ref I2C_SMBusXfer.
+ */
+void I2C_SMBusIRQHandler(I2C_T *i2c)
+{
+    I2C_SMBUS_ENGINE_T *psEng = I2C_SMBusGet(i2c);
+    S_I2C_SMBUS_MSG_T *psMsg = psEng->psMsg;
+    uint32_t u32Ctrl = I2C_CTL_SI;
+    int32_t i32Ret;
+
+    if(I2C_GET_TIMEOUT_FLAG(i2c))
+    {
+        I2C_ClearTimeoutFlag(i2c);
+        if(psMsg != NULL)
+        {
+            u32Ctrl = I2C_SMBusFinish(psEng, I2C_SMBUS_ERR_TIMEOUT);
+        }
+    }
+    else if(psMsg != NULL)
+    {
+        switch(I2C_GET_STATUS(i2c))
+        {
+        case 0x08U:                                     /* START */
+            I2C_SET_DATA(i2c, (uint8_t)((psMsg->u8Addr << 1) | ((psEng->u32TxTotal == 0UL) ? 1U : 0U)));
+            break;
+        case 0x10U:                                     /* Repeated START */
+            I2C_SET_DATA(i2c, (uint8_t)((psMsg->u8Addr << 1) | 1U));
+            break;
+        case 0x18U:                                     /* SLA+W ACK */
+        case 0x28U:                                     /* Data ACK */
+            i32Ret = I2C_SMBusNextTx(i2c, psEng);
+            if(i32Ret >= 0)
+                I2C_SET_DATA(i2c, (uint8_t)i32Ret);
+            else if(psEng->u32Flags & I2C_SMBUS_F_RD)
+                u32Ctrl = I2C_CTL_STA_SI;
+            else
+                u32Ctrl = I2C_SMBusFinish(psEng, I2C_SMBUS_OK);
+            break;
+        case 0x40U:                                     /* SLA+R ACK */
+            u32Ctrl = (I2C_SMBusRxLeft(psEng) > 1UL) ? I2C_CTL_SI_AA : I2C_CTL_SI;
+            break;
+        case 0x50U:                                     /* Data received, ACK sent */
+            i32Ret = I2C_SMBusRxByte(i2c, psEng, (uint8_t)I2C_GET_DATA(i2c));
+            if(i32Ret != I2C_SMBUS_BUSY)
+                u32Ctrl = I2C_SMBusFinish(psEng, i32Ret);
+            else if(I2C_SMBusRxLeft(psEng) > 1UL)
+                u32Ctrl = I2C_CTL_SI_AA;
+            break;
+        case 0x58U:                                     /* Last byte received, NACK sent */
+            i32Ret = I2C_SMBusRxByte(i2c, psEng, (uint8_t)I2C_GET_DATA(i2c));
+            u32Ctrl = I2C_SMBusFinish(psEng, (i32Ret == I2C_SMBUS_BUSY) ? I2C_SMBUS_OK : i32Ret);
+            break;
+        case 0x20U:                                     /* SLA+W NACK */
+        case 0x30U:                                     /* Data NACK */
+        case 0x48U:                                     /* SLA+R NACK */
+            u32Ctrl = I2C_SMBusFinish(psEng, I2C_SMBUS_ERR_NACK);
+            break;
+        case 0x38U:                                     /* Arbitration lost */
+            u32Ctrl = I2C_SMBusFinish(psEng, I2C_SMBUS_ERR_ARB);
+            break;
+        default:                                        /* Bus error */
+            u32Ctrl = I2C_SMBusFinish(psEng, I2C_SMBUS_ERR_BUS);
+            break;
+        }
+    }
+
+    I2C_SET_CONTROL_REG(i2c, u32Ctrl);
+
+    if((psMsg != NULL) && (psEng->psMsg == NULL))
+    {
+        if(psEng->i32Status == I2C_SMBUS_BUSY)
+            psEng->i32Status = I2C_SMBUS_OK;
+        if(psEng->pfnDone != NULL)
+            psEng->pfnDone(i2c, psEng->pvUser, psEng->i32Status);
+    }
+}
+
+/** @cond HIDDEN_SYMBOLS */
+
+static int32_t I2C_SMBusRun(I2C_T *i2c, S_I2C_SMBUS_MSG_T *psMsg)
+{
+    int32_t i32Ret = I2C_SMBusXfer(i2c, psMsg, 1UL, NULL, NULL);
+
+    if(i32Ret == I2C_SMBUS_OK)
+        i32Ret = I2C_SMBusWait(i2c);
+
+    return i32Ret;
+}
+
+/** @endcond HIDDEN_SYMBOLS */
+
+/**
+ * @brief      SMBus block write
+ *
+ * @param[in]  i2c          Specify I2C port
+ * @param[in]  u8Addr       7-bit target address
+ * @param[in]  u8Cmd        Command code
+ * @param[in]  au8Data      Data to write
+ * @param[in]  u8Len        Byte count, 1 to \ref I2C_SMBUS_BLOCK_MAX
+ * @param[in]  u8Pec        1 to append PEC
+ *
+ * @return     I2C_SMBUS_OK or I2C_SMBUS_ERR_xxx
+ */
+int32_t I2C_SMBusBlockWrite(I2C_T *i2c, uint8_t u8Addr, uint8_t u8Cmd, uint8_t au8Data[], uint8_t u8Len, uint8_t u8Pec)
+{
+    S_I2C_SMBUS_MSG_T sMsg = { u8Addr, I2C_SMBUS_PROTO_BLOCK_WRITE, u8Cmd, u8Pec, u8Len, 0U, au8Data, NULL, 0L };
+
+    return I2C_SMBusRun(i2c, &sMsg);
+}
+
+/**
+ * @brief      SMBus block read
+ *
+ * @param[in]  i2c          Specify I2C port
+ * @param[in]  u8Addr       7-bit target address
+ * @param[in]  u8Cmd        Command code
+ * @param[out] au8Data      Data read
+ * @param[in,out] pu8Len    In: size of au8Data. Out: byte count sent by the target
+ * @param[in]  u8Pec        1 to check PEC
+ *
+ * @return     I2C_SMBUS_OK or I2C_SMBUS_ERR_xxx
+ */
+int32_t I2C_SMBusBlockRead(I2C_T *i2c, uint8_t u8Addr, uint8_t u8Cmd, uint8_t au8Data[], uint8_t *pu8Len, uint8_t u8Pec)
+{
+    S_I2C_SMBUS_MSG_T sMsg = { u8Addr, I2C_SMBUS_PROTO_BLOCK_READ, u8Cmd, u8Pec, 0U, *pu8Len, NULL, au8Data, 0L };
+    int32_t i32Ret = I2C_SMBusRun(i2c, &sMsg);
+
+    *pu8Len = sMsg.u8RxLen;
+    return i32Ret;
+}
+
+/**
+ * @brief      SMBus process call
+ *
+ * @param[in]  i2c          Specify I2C port
+ * @param[in]  u8Addr       7-bit target address
+ * @param[in]  u8Cmd        Command code
+ * @param[in]  u16Data      Word written
+ * @param[out] pu16Rsp      Word read back
+ * @param[in]  u8Pec        1 to check PEC
+ *
+ * @return     I2C_SMBUS_OK or I2C_SMBUS_ERR_xxx
+ */
+int32_t I2C_SMBusProcessCall(I2C_T *i2c, uint8_t u8Addr, uint8_t u8Cmd, uint16_t u16Data, uint16_t *pu16Rsp, uint8_t u8Pec)
+{
+    uint8_t au8Tx[2], au8Rx[2];
+    S_I2C_SMBUS_MSG_T sMsg = { u8Addr, I2C_SMBUS_PROTO_PROC_CALL, u8Cmd, u8Pec, 2U, 2U, au8Tx, au8Rx, 0L };
+    int32_t i32Ret;
+
+    au8Tx[0] = (uint8_t)u16Data;
+    au8Tx[1] = (uint8_t)(u16Data >> 8);
+    i32Ret = I2C_SMBusRun(i2c, &sMsg);
+    *pu16Rsp = (uint16_t)(au8Rx[0] | ((uint16_t)au8Rx[1] << 8));
+
+    return i32Ret;
+}
+
+/**
+ * @brief      SMBus block write-block read process call
+ *
+ * @param[in]  i2c          Specify I2C port
+ * @param[in]  u8Addr       7-bit target address
+ * @param[in]  u8Cmd        Command code
+ * @param[in]  au8Data      Data to write
+ * @param[in]  u8Len        Write byte count
+ * @param[out] au8Rsp       Data read
+ * @param[in,out] pu8RspLen In: size of au8Rsp. Out: byte count sent by the target
+ * @param[in]  u8Pec        1 to check PEC
+ *
+ * @return     I2C_SMBUS_OK or I2C_SMBUS_ERR_xxx
+ */
+int32_t I2C_SMBusBlockProcessCall(I2C_T *i2c, uint8_t u8Addr, uint8_t u8Cmd, uint8_t au8Data[], uint8_t u8Len,
+                                  uint8_t au8Rsp[], uint8_t *pu8RspLen, uint8_t u8Pec)
+{
+    S_I2C_SMBUS_MSG_T sMsg = { u8Addr, I2C_SMBUS_PROTO_BLOCK_PROC_CALL, u8Cmd, u8Pec, u8Len, *pu8RspLen, au8Data, au8Rsp, 0L };
+    int32_t i32Ret = I2C_SMBusRun(i2c, &sMsg);
+
+    *pu8RspLen = sMsg.u8RxLen;
+    return i32Ret;
+}
+
+/**
+ * @brief      ARP Prepare to ARP
+ *
+ * @param[in]  i2c          Specify I2C port
+ *
+ * @return     I2C_SMBUS_OK or I2C_SMBUS_ERR_xxx
+ *
+ * @details    Sends the general Prepare to ARP command with PEC to the SMBus Device Default Address.
+ */
+int32_t I2C_SMBusArpPrepare(I2C_T *i2c)
+{
+    S_I2C_SMBUS_MSG_T sMsg = { I2C_SMBUS_ARP_ADDR, I2C_SMBUS_PROTO_SEND_BYTE, 0x01U, 1U, 0U, 0U, NULL, NULL, 0L };
+
+    return I2C_SMBusRun(i2c, &sMsg);
+}
+
+/**
+ * @brief      ARP Reset Device (general)
+ *
+ * @param[in]  i2c          Specify I2C port
+ *
+ * @return     I2C_SMBUS_OK or I2C_SMBUS_ERR_xxx
+ *
+ * @details    Makes every ARP-capable device give up an address it did not have fixed.
+ */
+int32_t I2C_SMBusArpReset(I2C_T *i2c)
+{
+    S_I2C_SMBUS_MSG_T sMsg = { I2C_SMBUS_ARP_ADDR, I2C_SMBUS_PROTO_SEND_BYTE, 0x02U, 1U, 0U, 0U, NULL, NULL, 0L };
+
+    return I2C_SMBusRun(i2c, &sMsg);
+}
+
+/**
+ * @brief      ARP Get UDID (general)
+ *
+ * @param[in]  i2c          Specify I2C port
+ * @param[out] au8Udid      16-byte UDID followed by the current address byte of the device
+ *
+ * @return     I2C_SMBUS_OK or I2C_SMBUS_ERR_xxx. I2C_SMBUS_ERR_NACK if no device is left to enumerate.
+ */
+int32_t I2C_SMBusArpGetUdid(I2C_T *i2c, uint8_t au8Udid[17])
+{
+    S_I2C_SMBUS_MSG_T sMsg = { I2C_SMBUS_ARP_ADDR, I2C_SMBUS_PROTO_BLOCK_READ, 0x03U, 1U, 0U, 17U, NULL, au8Udid, 0L };
+    int32_t i32Ret = I2C_SMBusRun(i2c, &sMsg);
+
+    if((i32Ret == I2C_SMBUS_OK) && (sMsg.u8RxLen != 17U))
+        i32Ret = I2C_SMBUS_ERR_SIZE;
+    return i32Ret;
+}
+
+/**
+ * @brief      ARP Assign Address
+ *
+ * @param[in]  i2c          Specify I2C port
+ * @param[in]  au8Udid      UDID of the device, as returned by \ref I2C_SMBusArpGetUdid
+ * @param[in]  u8Addr       7-bit address to assign
+ *
+ * @return     I2C_SMBUS_OK or I2C_SMBUS_ERR_xxx
+ */
+int32_t I2C_SMBusArpAssign(I2C_T *i2c, const uint8_t au8Udid[16], uint8_t u8Addr)
+{
+    uint8_t au8Data[17];
+    S_I2C_SMBUS_MSG_T sMsg = { I2C_SMBUS_ARP_ADDR, I2C_SMBUS_PROTO_BLOCK_WRITE, 0x04U, 1U, 17U, 0U, au8Data, NULL, 0L };
+    uint32_t i;
+
+    for(i = 0UL; i < 16UL; i++)
+        au8Data[i] = au8Udid[i];
+    au8Data[16] = (uint8_t)((u8Addr << 1) | 1U);
+
+    return I2C_SMBusRun(i2c, &sMsg);
+}
+
+/** @cond HIDDEN_SYMBOLS */
+
+#define I2C_TARGET_DMA_NONE 0U
+#define I2C_TARGET_DMA_RX   1U
+#define I2C_TARGET_DMA_TX   2U
+
+typedef struct
+{
+    S_I2C_TARGET_MAP_T *psMaps;
+    uint32_t u32MapCnt;
+    S_I2C_TARGET_MAP_T *psCur;      /* Map of the address of the running transfer */
+    uint32_t u32PtrIdx;             /* Register pointer bytes received in this write */
+    uint32_t u32WrStart;            /* First register written in this write */
+    uint32_t u32WrCnt;              /* Registers written in this write */
+    uint8_t  u8Next;                /* Prefetched byte at psCur->u16Ptr */
+#if I2C_TARGET_PDMA
+    PDMA_T  *pdma;
+    uint32_t u32TxCh;
+    uint32_t u32RxCh;
+    uint32_t u32Threshold;          /* Shortest run moved by PDMA, 0 if PDMA is not used */
+    uint32_t u32DmaDir;
+    uint32_t u32DmaLen;
+#endif
+} I2C_TARGET_ENGINE_T;
+
+static I2C_TARGET_ENGINE_T s_asI2cTarget[I2C_PORT_NUM];
+
+#if I2C_TARGET_PDMA
+static const uint32_t s_au32I2cPdmaTx[I2C_PORT_NUM] = { PDMA_I2C0_TX, PDMA_I2C1_TX, PDMA_I2C2_TX, PDMA_I2C3_TX, PDMA_I2C4_TX };
+
+static void I2C_TargetDmaStart(I2C_T *i2c, I2C_TARGET_ENGINE_T *psEng, uint32_t u32Dir, uint8_t *pu8Buf, uint32_t u32Len)
+{
+    uint32_t u32Ch = (u32Dir == I2C_TARGET_DMA_RX) ? psEng->u32RxCh : psEng->u32TxCh;
+
+    PDMA_SetTransferCnt(psEng->pdma, u32Ch, PDMA_WIDTH_8, u32Len);
+    if(u32Dir == I2C_TARGET_DMA_RX)
+        PDMA_SetTransferAddr(psEng->pdma, u32Ch, (uint32_t)&i2c->DAT, PDMA_SAR_FIX, (uint32_t)pu8Buf, PDMA_DAR_INC);
+    else
+        PDMA_SetTransferAddr(psEng->pdma, u32Ch, (uint32_t)pu8Buf, PDMA_SAR_INC, (uint32_t)&i2c->DAT, PDMA_DAR_FIX);
+    PDMA_SetBurstType(psEng->pdma, u32Ch, PDMA_REQ_SINGLE, 0UL);
+    PDMA_SetTransferMode(psEng->pdma, u32Ch, s_au32I2cPdmaTx[I2C_PortIdx(i2c)] + ((u32Dir == I2C_TARGET_DMA_RX) ? 1UL : 0UL), 0UL, 0UL);
+
+    psEng->u32DmaDir = u32Dir;
+    psEng->u32DmaLen = u32Len;
+    i2c->CTL1 |= (u32Dir == I2C_TARGET_DMA_RX) ? I2C_CTL1_RXPDMAEN_Msk : I2C_CTL1_TXPDMAEN_Msk;
+}
+
+/* Stop PDMA and return the bytes it moved */
+static uint32_t I2C_TargetDmaStop(I2C_T *i2c, I2C_TARGET_ENGINE_T *psEng)
+{
+    uint32_t u32Ch = (psEng->u32DmaDir == I2C_TARGET_DMA_RX) ? psEng->u32RxCh : psEng->u32TxCh;
+    uint32_t u32Ctl, u32Left = 0UL;
+
+    if(psEng->u32DmaDir == I2C_TARGET_DMA_NONE)
+        return 0UL;
+
+    i2c->CTL1 &= ~(I2C_CTL1_RXPDMAEN_Msk | I2C_CTL1_TXPDMAEN_Msk);
+    u32Ctl = psEng->pdma->DSCT[u32Ch].CTL;
+    if(u32Ctl & PDMA_DSCT_CTL_OPMODE_Msk)
+    {
+        u32Left = ((u32Ctl & PDMA_DSCT_CTL_TXCNT_Msk) >> PDMA_DSCT_CTL_TXCNT_Pos) + 1UL;
+        PDMA_STOP(psEng->pdma, u32Ch);
+    }
+    psEng->u32DmaDir = I2C_TARGET_DMA_NONE;
+
+    return psEng->u32DmaLen - u32Left;
+}
+#endif
+
+static I2C_TARGET_ENGINE_T *I2C_TargetGet(I2C_T *i2c)
+{
+    return &s_asI2cTarget[I2C_PortIdx(i2c)];
+}
+
+static S_I2C_TARGET_MAP_T *I2C_TargetMatch(I2C_TARGET_ENGINE_T *psEng, uint32_t u32Sla)
+{
+    uint32_t i;
+
+    for(i = 0UL; i < psEng->u32MapCnt; i++)
+    {
+        if(psEng->psMaps[i].u8Addr == ((u32Sla >> 1) & 0x7FUL))
+            return &psEng->psMaps[i];
+    }
+    return &psEng->psMaps[0];
+}
+
+static uint8_t I2C_TargetFetch(S_I2C_TARGET_MAP_T *psMap)
+{
+    return (psMap->u16Ptr < psMap->u16Size) ? psMap->pu8Regs[psMap->u16Ptr] : (uint8_t)I2C_TARGET_IDLE_BYTE;
+}
+
+/* Advance past the byte just loaded into I2C_DAT and prefetch the next one */
+static void I2C_TargetAdvance(I2C_TARGET_ENGINE_T *psEng, S_I2C_TARGET_MAP_T *psMap)
+{
+    if(psMap->u16Ptr < psMap->u16Size)
+        psMap->u16Ptr++;
+    psEng->u8Next = I2C_TargetFetch(psMap);
+}
+
+/* STOP, repeated START or NACK: close the running transfer */
+static void I2C_TargetEnd(I2C_T *i2c, I2C_TARGET_ENGINE_T *psEng)
+{
+    S_I2C_TARGET_MAP_T *psMap = psEng->psCur;
+#if I2C_TARGET_PDMA
+    uint32_t u32Dir = psEng->u32DmaDir;
+    uint32_t u32Moved = I2C_TargetDmaStop(i2c, psEng);
+
+    if(psMap != NULL)
+    {
+        psMap->u16Ptr = (uint16_t)(psMap->u16Ptr + u32Moved);
+        if(u32Dir == I2C_TARGET_DMA_RX)
+            psEng->u32WrCnt += u32Moved;
+    }
+#else
+    (void)i2c;
+#endif
+
+    if((psMap != NULL) && (psEng->u32WrCnt != 0UL) && (psMap->pfnWrite != NULL))
+        psMap->pfnWrite(psMap, (uint16_t)psEng->u32WrStart, (uint16_t)psEng->u32WrCnt);
+
+    psEng->u32WrCnt = 0UL;
+    psEng->psCur = NULL;
+}
+
+/** @endcond HIDDEN_SYMBOLS */
+
+/**
+ * @brief      Serve register maps in I2C target mode
+ *
+ * @param[in]  i2c          Specify I2C port
+ * @param[in]  asMap        Register maps, one per own address
+ * @param[in]  u32MapCnt    Number of maps, 1 to \ref I2C_TARGET_MAP_MAX
+ *
+ * @retval     I2C_TARGET_OK        Target mode started
+ * @retval     I2C_TARGET_ERR_PARAM Invalid map
+ *
+ * @details    Map n is served at own address register n. A host write starts with u8PtrLen register
+ *             pointer bytes, the following bytes are stored from there on with auto-increment. Bytes
+ *             aimed at read-only or missing registers are not acknowledged. A host read returns bytes
+ *             from the pointer on, and \ref I2C_TARGET_IDLE_BYTE past the end of the map. The pointer of
+ *             each map is kept between transfers, so a write of the pointer alone sets up the next read.
+ *             The next byte to send is fetched while the current one is shifted out, so SCL is stretched
+ *             only for the time the interrupt takes to load it.
+ *             The I2C IRQ handler must call \ref I2C_TargetIRQHandler.
+ * @note       The port must be opened by \ref I2C_Open first.
+ */
+int32_t I2C_TargetOpen(I2C_T *i2c, S_I2C_TARGET_MAP_T asMap[], uint32_t u32MapCnt)
+{
+    I2C_TARGET_ENGINE_T *psEng = I2C_TargetGet(i2c);
+    uint32_t i;
+
+    if((asMap == NULL) || (u32MapCnt == 0UL) || (u32MapCnt > I2C_TARGET_MAP_MAX))
+        return I2C_TARGET_ERR_PARAM;
+
+    for(i = 0UL; i < u32MapCnt; i++)
+    {
+        if((asMap[i].pu8Regs == NULL) || (asMap[i].u8PtrLen < 1U) || (asMap[i].u8PtrLen > 2U) ||
+                (asMap[i].u16WrLimit > asMap[i].u16Size))
+            return I2C_TARGET_ERR_PARAM;
+    }
+
+    psEng->psMaps = asMap;
+    psEng->u32MapCnt = u32MapCnt;
+    psEng->psCur = NULL;
+    psEng->u32WrCnt = 0UL;
+
+    for(i = 0UL; i < u32MapCnt; i++)
+    {
+        asMap[i].u16Ptr = 0U;
+        I2C_SetSlaveAddr(i2c, (uint8_t)i, asMap[i].u8Addr, I2C_GCMODE_DISABLE);
+        I2C_SetSlaveAddrMask(i2c, (uint8_t)i, 0U);
+    }
+
+    I2C_EnableInt(i2c);
+    I2C_SET_CONTROL_REG(i2c, I2C_CTL_SI_AA);
+
+    return I2C_TARGET_OK;
+}
+
+/**
+ * @brief      Stop serving register maps
+ *
+ * @param[in]  i2c          Specify I2C port
+ *
+ * @return     None
+ *
+ * @details    The port stops acknowledging its own addresses.
+ */
+void I2C_TargetClose(I2C_T *i2c)
+{
+    I2C_TARGET_ENGINE_T *psEng = I2C_TargetGet(i2c);
+
+    I2C_DisableInt(i2c);
+    I2C_SET_CONTROL_REG(i2c, I2C_CTL_SI);
+#if I2C_TARGET_PDMA
+    (void)I2C_TargetDmaStop(i2c, psEng);
+#endif
+    psEng->psCur = NULL;
+    psEng->u32MapCnt = 0UL;
+}
+
+#if I2C_TARGET_PDMA
+/**
+ * @brief      Move long target transfers by PDMA
+ *
+ * @param[in]  i2c          Specify I2C port
+ * @param[in]  pdma         PDMA controller
+ * @param[in]  u32TxCh      Channel for host reads
+ * @param[in]  u32RxCh      Channel for host writes
+ * @param[in]  u32Threshold Shortest register run, up to the end of the map or its writable part, given to PDMA. 0 disables PDMA.
+ *
+ * @retval     I2C_TARGET_OK        PDMA set
+ * @retval     I2C_TARGET_ERR_PARAM Invalid channel
+ *
+ * @details    Once the register pointer is known, a run of at least u32Threshold registers is moved by
+ *             PDMA without an interrupt per byte. The pointer is updated from the PDMA count at STOP.
+ *             On host reads a byte PDMA has loaded but the host did not clock out is counted as read.
+ *             On host writes PDMA stops one register short of the writable part, so the last register
+ *             is received by interrupt and a byte beyond it is NACKed.
+ * @note       The channels must be enabled by PDMA_Open.
+ */
+int32_t I2C_TargetSetPdma(I2C_T *i2c, PDMA_T *pdma, uint32_t u32TxCh, uint32_t u32RxCh, uint32_t u32Threshold)
+{
+    I2C_TARGET_ENGINE_T *psEng = I2C_TargetGet(i2c);
+
+    if((pdma == NULL) || (u32TxCh >= PDMA_CH_MAX) || (u32RxCh >= PDMA_CH_MAX) || (u32TxCh == u32RxCh))
+        return I2C_TARGET_ERR_PARAM;
+
+    psEng->pdma = pdma;
+    psEng->u32TxCh = u32TxCh;
+    psEng->u32RxCh = u32RxCh;
+    psEng->u32Threshold = u32Threshold;
+    psEng->u32DmaDir = I2C_TARGET_DMA_NONE;
+
+    return I2C_TARGET_OK;
+}
+#endif
+
+/**
+ * @brief      I2C target engine interrupt service
+ *
+ * @param[in]  i2c          Specify I2C port
+ *
+ * @return     None
+ *
+ * @details    Call from the IRQ handler of a port started by \ref I2C_TargetOpen.
+ */
+void I2C_TargetIRQHandler(I2C_T *i2c)
+{
+    I2C_TARGET_ENGINE_T *psEng = I2C_TargetGet(i2c);
+    S_I2C_TARGET_MAP_T *psMap = psEng->psCur;
+    uint32_t u32Ctrl = I2C_CTL_SI_AA;
+    uint8_t u8Data;
+
+    if(I2C_GET_TIMEOUT_FLAG(i2c))
+    {
+        I2C_ClearTimeoutFlag(i2c);
+        return;
+    }
+
+    if(psEng->u32MapCnt == 0UL)
+    {
+        I2C_SET_CONTROL_REG(i2c, I2C_CTL_SI);
+        return;
+    }
+
+    switch(I2C_GET_STATUS(i2c))
+    {
+    case 0x60U:                                     /* Own SLA+W, ACK sent */
+    case 0x68U:                                     /* Arbitration lost, own SLA+W */
+        psEng->psCur = I2C_TargetMatch(psEng, I2C_GET_DATA(i2c));
+        psEng->u32PtrIdx = 0UL;
+        psEng->u32WrCnt = 0UL;
+        break;
+
+    case 0x80U:                                     /* Data received, ACK sent */
+        u8Data = (uint8_t)I2C_GET_DATA(i2c);
+        if(psMap == NULL)
+            break;
+#if I2C_TARGET_PDMA
+        if(psEng->u32DmaDir == I2C_TARGET_DMA_RX)
+        {
+            /* PDMA ran out before the host stopped */
+            psEng->u32WrCnt += I2C_TargetDmaStop(i2c, psEng);
+            psMap->u16Ptr = (uint16_t)(psEng->u32WrStart + psEng->u32WrCnt);
+        }
+#endif
+        if(psEng->u32PtrIdx < psMap->u8PtrLen)
+        {
+            psMap->u16Ptr = (uint16_t)((psEng->u32PtrIdx == 0UL) ? u8Data : ((psMap->u16Ptr << 8) | u8Data));
+            if(++psEng->u32PtrIdx == psMap->u8PtrLen)
+            {
+                if(psMap->u16Ptr > psMap->u16Size)
+                    psMap->u16Ptr = psMap->u16Size;
+                psEng->u32WrStart = psMap->u16Ptr;
+            }
+        }
+        else if(psMap->u16Ptr < psMap->u16WrLimit)
+        {
+            psMap->pu8Regs[psMap->u16Ptr++] = u8Data;
+            psEng->u32WrCnt++;
+        }
+
+        if(psEng->u32PtrIdx == psMap->u8PtrLen)
+        {
+            /* PDMA stops one byte short of the limit, so the last writable byte comes through
+               here and the byte after it is NACKed */
+            if(psMap->u16Ptr >= psMap->u16WrLimit)
+                u32Ctrl = I2C_CTL_SI;               /* NACK the next byte */
+#if I2C_TARGET_PDMA
+            else if((psEng->u32Threshold != 0UL) && ((uint32_t)(psMap->u16WrLimit - psMap->u16Ptr) > psEng->u32Threshold))
+                I2C_TargetDmaStart(i2c, psEng, I2C_TARGET_DMA_RX, &psMap->pu8Regs[psMap->u16Ptr], psMap->u16WrLimit - psMap->u16Ptr - 1UL);
+#endif
+        }
+        break;
+
+    case 0xA8U:                                     /* Own SLA+R, ACK sent */
+    case 0xB0U:                                     /* Arbitration lost, own SLA+R */
+        psMap = psEng->psCur = I2C_TargetMatch(psEng, I2C_GET_DATA(i2c));
+        psEng->u32WrCnt = 0UL;
+        if(psMap->pfnRead != NULL)
+            psMap->pfnRead(psMap);
+#if I2C_TARGET_PDMA
+        if((psEng->u32Threshold != 0UL) && ((uint32_t)(psMap->u16Size - psMap->u16Ptr) >= psEng->u32Threshold))
+        {
+            I2C_TargetDmaStart(i2c, psEng, I2C_TARGET_DMA_TX, &psMap->pu8Regs[psMap->u16Ptr], psMap->u16Size - psMap->u16Ptr);
+            break;
+        }
+#endif
+        I2C_SET_DATA(i2c, I2C_TargetFetch(psMap));
+        I2C_SET_CONTROL_REG(i2c, I2C_CTL_SI_AA);
+        I2C_TargetAdvance(psEng, psMap);
+        return;
+
+    case 0xB8U:                                     /* Data sent, ACK received */
+        if(psMap == NULL)
+        {
+            I2C_SET_DATA(i2c, I2C_TARGET_IDLE_BYTE);
+            break;
+        }
+#if I2C_TARGET_PDMA
+        if(psEng->u32DmaDir == I2C_TARGET_DMA_TX)
+        {
+            /* PDMA ran out before the host stopped */
+            psMap->u16Ptr = (uint16_t)(psMap->u16Ptr + I2C_TargetDmaStop(i2c, psEng));
+            psEng->u8Next = I2C_TargetFetch(psMap);
+        }
+#endif
+        I2C_SET_DATA(i2c, psEng->u8Next);
+        I2C_SET_CONTROL_REG(i2c, I2C_CTL_SI_AA);
+        I2C_TargetAdvance(psEng, psMap);
+        return;
+
+    case 0x88U:                                     /* Data received, NACK sent */
+    case 0xA0U:                                     /* STOP or repeated START */
+    case 0xC0U:                                     /* Data sent, NACK received */
+    case 0xC8U:                                     /* Last data sent, ACK received */
+        I2C_TargetEnd(i2c, psEng);
+        break;
+
+    case 0x00U:                                     /* Bus error */
+        I2C_TargetEnd(i2c, psEng);
+        u32Ctrl = I2C_CTL_STO_SI_AA;
+        break;
+
+    default:
+        break;
+    }
+
+    I2C_SET_CONTROL_REG(i2c, u32Ctrl);
+}
+
 
 /*@}*/ /* end of group I2C_EXPORTED_FUNCTIONS */
 
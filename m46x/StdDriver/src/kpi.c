@@ -27,105 +27,125 @@ static volatile uint32_t s_u32MaxKeyCnt = 0;
 static volatile uint32_t s_u32FirstKey = 0;
 static volatile uint32_t s_u32LastKey = 0;
 
+static KPI_EVENT_T *s_pEventQueue = 0;
+static KPI_TICK_FUNC s_pfnGetTick = 0;
+static volatile uint32_t s_u32MaxEventCnt = 0;
+static volatile uint32_t s_u32FirstEvent = 0;
+static volatile uint32_t s_u32LastEvent = 0;
+static volatile uint32_t s_u32OverflowCnt = 0;
+static volatile uint32_t s_u32EventTime = 0;
+
+static volatile uint32_t s_u32AutoSlowScan = 0;
+static volatile uint32_t s_u32SlowScan = 0;
+static uint32_t s_u32FastDbClkSel = 0;
+static uint32_t s_u32FastDlyCtl = 0;
+
 __WEAK void KPI_KeyHandler(KPI_KEY_T key)
 
 {
     uint32_t u32Next;
-    
+
+    if(s_pEventQueue)
+    {
+        /* Move last to next available space */
+        u32Next = s_u32LastEvent + 1;
+        if(u32Next >= s_u32MaxEventCnt)
+            u32Next = 0; // buffer wrap
+        if(u32Next == s_u32FirstEvent)
+        {
+            s_u32OverflowCnt++; // Queue full, drop the newest event
+            return;
+        }
+
+        /* Push event to the queue and publish it after the data is written */
+        s_pEventQueue[s_u32LastEvent].key = key;
+        s_pEventQueue[s_u32LastEvent].u32Time = s_u32EventTime;
+        __DMB();
+        s_u32LastEvent = u32Next;
+        return;
+    }
+
     /* Move last to next available space */
     u32Next = s_u32LastKey + 1;
     if(u32Next >= s_u32MaxKeyCnt)
         u32Next = 0; // buffer wrap
     if(u32Next == s_u32FirstKey)
-        return; // Queue full
-    
+    {
+        s_u32OverflowCnt++; // Queue full
+        return;
+    }
+
     /* Push key to the queue */
     s_pKeyQueue[s_u32LastKey] = key;
+    __DMB();
     s_u32LastKey = u32Next;
 
 }
 
+static void KPI_ReportKeys(uint32_t u32Flag[2], uint16_t u16State)
+{
+    int32_t idx;
+    uint32_t u32Bit, u32Mask;
+    KPI_KEY_T key;
+
+    /* Visit the set bits only. Bit (r*8+c) of word idx is row (idx*4+r), column c. */
+    for(idx=0;idx<2;idx++)
+    {
+        u32Mask = u32Flag[idx];
+        while(u32Mask)
+        {
+            u32Bit = 31 - __CLZ(u32Mask & (~u32Mask + 1));
+            u32Mask &= u32Mask - 1;
+
+            /* Record the key */
+            key.x = idx * 4 + (u32Bit >> 3);
+            key.y = u32Bit & 0x7;
+            key.st= u16State;
+
+            /* call handler */
+            KPI_KeyHandler(key);
+        }
+    }
+}
 
 void KPI_IRQHandler()
 {
-    int32_t i,j, idx, r;
     uint32_t u32KeyPress[2], u32KeyRelease[2], status;
-    uint32_t row, col, mask;
-    KPI_KEY_T key;
-        
+
     /* cache key events ASAP */
     status = KPI->STATUS;
     u32KeyPress[0] = KPI->KPF[0];
     u32KeyPress[1] = KPI->KPF[1];
     u32KeyRelease[0] = KPI->KRF[0];
     u32KeyRelease[1] = KPI->KRF[1];
+    s_u32EventTime = s_pfnGetTick ? s_pfnGetTick() : 0;
 
     if(status & KPI_STATUS_KIF_Msk)
     {
-        /* Get current row/column setting */
-        row = ((KPI->CTL & KPI_CTL_KROW_Msk) >> KPI_CTL_KROW_Pos) + 1;
-        col = ((KPI->CTL & KPI_CTL_KCOL_Msk) >> KPI_CTL_KCOL_Pos) + 1;
-        
-        /* Deal with the key evernts */
-        for(i=0;i<row;i++)
+        /* Key Release. Clean all cached events with one write per word. */
+        if(status & KPI_STATUS_KRIF_Msk)
         {
-            for(j=0;j<col;j++)
-            {
-                /* Identify the specified key bit */
-                idx = (i < 4)?0:1;
-                r   = i - idx * 4;
-                mask = 1ul << (r*8+j);
-
-                /* Key Release */
-                if(status & KPI_STATUS_KRIF_Msk)
-                {
-                    if(u32KeyRelease[idx] & mask)
-                    {
-                        /* Clean event */
-                        KPI->KRF[idx] = mask;
-                        
-                        /* Record the key */
-                        key.x = i;
-                        key.y = j;
-                        key.st= KPI_RELEASE;
-
-                        /* call handler */
-                        KPI_KeyHandler(key);
-                    }
-                }            
-            }
+            KPI->KRF[0] = u32KeyRelease[0];
+            KPI->KRF[1] = u32KeyRelease[1];
+            KPI_ReportKeys(u32KeyRelease, KPI_RELEASE);
         }
-        
-        /* Deal with the key evernts */
-        for(i=0;i<row;i++)
+
+        /* Key Press */
+        if(status & KPI_STATUS_KPIF_Msk)
         {
-            for(j=0;j<col;j++)
-            {
-                /* Identify the specified key bit */
-                idx = (i < 4)?0:1;
-                r   = i - idx * 4;
-                mask = 1ul << (r*8+j);
-
-
-                /* Key Press */
-                if(status & KPI_STATUS_KPIF_Msk)
-                {
-                    if(u32KeyPress[idx] & mask)
-                    {
-                        /* Clean event */
-                        KPI->KPF[idx] = mask;
-                        
-                        /* Record the key */
-                        key.x = i;
-                        key.y = j;
-                        key.st= KPI_PRESS;
-                        
-                        /* call handler */
-                        KPI_KeyHandler(key);
-                    }
-                }
-            }
-        }        
+            KPI->KPF[0] = u32KeyPress[0];
+            KPI->KPF[1] = u32KeyPress[1];
+
+            /* Back to fast scan as soon as a key is pressed */
+            if(s_u32SlowScan)
+                KPI_DisableSlowScan();
+
+            KPI_ReportKeys(u32KeyPress, KPI_PRESS);
+        }
+
+        /* Slow down the scan when all keys are released */
+        if(s_u32AutoSlowScan && (s_u32SlowScan == 0) && ((KPI->KST[0] | KPI->KST[1]) == 0))
+            KPI_EnableSlowScan();
     }
     
     if(status & KPI_STATUS_TKRIF_Msk)
@@ -181,6 +201,8 @@ int32_t KPI_Open(uint32_t u32Rows, uint32_t u32Columns, KPI_KEY_T *pkeyQueue, ui
     s_u32MaxKeyCnt = u32MaxKeyCnt;
     s_u32FirstKey = 0;
     s_u32LastKey = 0;
+    s_u32OverflowCnt = 0;
+    s_u32SlowScan = 0;
     
     return 0;
 }
@@ -209,6 +231,9 @@ void KPI_Close()
  */
 int32_t KPI_kbhit()
 {
+    if(s_pEventQueue)
+        return (s_u32FirstEvent != s_u32LastEvent) ? 1 : 0;
+
     if(s_u32FirstKey != s_u32LastKey)
         return 1;
     return 0;
@@ -225,11 +250,21 @@ int32_t KPI_kbhit()
 KPI_KEY_T KPI_GetKey()
 {
     KPI_KEY_T key = {0xff,0xff,0xffff};
-    
+    KPI_EVENT_T event;
+
+    /* Drop the timestamp when the event queue is used */
+    if(s_pEventQueue)
+    {
+        if(KPI_GetEvent(&event) == 0)
+            key = event.key;
+        return key;
+    }
+
     /* Check if queue is empty */
     if(s_u32FirstKey != s_u32LastKey)
     {
         /* Pop the key from queue */
+        __DMB();
         key = s_pKeyQueue[s_u32FirstKey++];
         
         /* Wrap around check */
@@ -269,12 +304,171 @@ void KPI_EnableSlowScan()
     /* It is slow enough when using LIRC clock source */
     if((CLK->CLKSEL3 & CLK_CLKSEL3_KPISEL_Msk) == CLK_CLKSEL3_KPISEL_LIRC)
         return;
-    
+
+    if(s_u32SlowScan)
+        return;
+
+    /* Keep the fast scan timing for KPI_DisableSlowScan */
+    s_u32FastDbClkSel = KPI->CTL & KPI_CTL_DBCLKSEL_Msk;
+    s_u32FastDlyCtl = KPI->DLYCTL & 0xff;
+    s_u32SlowScan = 1;
+
     KPI->CTL = (KPI->CTL & (~KPI_CTL_DBCLKSEL_Msk)) | (5 << KPI_CTL_DBCLKSEL_Pos);
     KPI->DLYCTL = (KPI->DLYCTL & (~0xff)) | 127;
 }
 
 
+/**
+ *    @brief        Restore key scan timing saved by KPI_EnableSlowScan
+ *
+ *    @details      The function is used to go back to the scan timing used before KPI_EnableSlowScan.
+ */
+void KPI_DisableSlowScan()
+{
+    if(s_u32SlowScan == 0)
+        return;
+
+    KPI->CTL = (KPI->CTL & (~KPI_CTL_DBCLKSEL_Msk)) | s_u32FastDbClkSel;
+    KPI->DLYCTL = (KPI->DLYCTL & (~0xff)) | s_u32FastDlyCtl;
+    s_u32SlowScan = 0;
+}
+
+
+/**
+ *    @brief        Enable or disable slow scan when all keys are released
+ *
+ *    @param[in]    u32Enable   1 to enable, 0 to disable.
+ *
+ *    @details      When enabled, the key scan is slowed down by KPI_EnableSlowScan once no key is held
+ *                  and restored by KPI_DisableSlowScan on the next key press, to save power while idle.
+ */
+void KPI_EnableAutoSlowScan(uint32_t u32Enable)
+{
+    s_u32AutoSlowScan = u32Enable ? 1 : 0;
+
+    if(u32Enable == 0)
+        KPI_DisableSlowScan();
+}
+
+
+/**
+ *    @brief        Set up the timestamped key event queue
+ *
+ *    @param[in]    pEventQueue     The FIFO queue of the key events. Set NULL to go back to the KPI_Open key queue.
+ *    @param[in]    u32MaxEventCnt  Maximum event counts in the event queue. One entry is kept empty.
+ *    @param[in]    pfnGetTick      The function to get current tick count for event timestamps. It could be NULL.
+ *
+ *    @retval       0   Sucessful
+ *    @retval       -1  Failure
+ *
+ *    @details      The function is used to replace the key queue with an event queue recording the press/release
+ *                  state and timestamp of each key. The queue is single producer (KPI_IRQHandler) and
+ *                  single consumer, no lock is required.
+ */
+int32_t KPI_SetEventQueue(KPI_EVENT_T *pEventQueue, uint32_t u32MaxEventCnt, KPI_TICK_FUNC pfnGetTick)
+{
+    if(pEventQueue && (u32MaxEventCnt < 2))
+        return -1;
+
+    NVIC_DisableIRQ(KPI_IRQn);
+
+    s_pEventQueue = pEventQueue;
+    s_u32MaxEventCnt = u32MaxEventCnt;
+    s_pfnGetTick = pfnGetTick;
+    s_u32FirstEvent = 0;
+    s_u32LastEvent = 0;
+    s_u32OverflowCnt = 0;
+
+    if(KPI->CTL & KPI_CTL_KPEN_Msk)
+        NVIC_EnableIRQ(KPI_IRQn);
+
+    return 0;
+}
+
+
+/**
+ *    @brief        Get key event
+ *
+ *    @param[out]   pEvent      The oldest key event in the event queue.
+ *
+ *    @retval       0   Sucessful
+ *    @retval       -1  The event queue is empty
+ *
+ *    @details      The function is used to pop the oldest key event from the event queue.
+ */
+int32_t KPI_GetEvent(KPI_EVENT_T *pEvent)
+{
+    uint32_t u32First = s_u32FirstEvent;
+
+    /* Check if queue is empty */
+    if(u32First == s_u32LastEvent)
+        return -1;
+
+    /* Read the event after the producer index, then release the slot */
+    __DMB();
+    *pEvent = s_pEventQueue[u32First];
+    __DMB();
+
+    /* Wrap around check */
+    if(++u32First >= s_u32MaxEventCnt)
+        u32First = 0;
+    s_u32FirstEvent = u32First;
+
+    return 0;
+}
+
+
+/**
+ *    @brief        Wait key event
+ *
+ *    @param[out]   pEvent      The oldest key event in the event queue.
+ *    @param[in]    u32Timeout  Time-out in ticks of the event queue tick function, or in polling loops if
+ *                              there is no tick function. 0xFFFFFFFF to wait forever.
+ *
+ *    @retval       0   Sucessful
+ *    @retval       -1  Time-out
+ *
+ *    @details      The function is used to wait until a key event is available in the event queue.
+ */
+int32_t KPI_WaitEvent(KPI_EVENT_T *pEvent, uint32_t u32Timeout)
+{
+    uint32_t u32Start, u32Loop = 0;
+
+    u32Start = s_pfnGetTick ? s_pfnGetTick() : 0;
+
+    while(KPI_GetEvent(pEvent) != 0)
+    {
+        if(u32Timeout == 0xFFFFFFFF)
+            continue;
+
+        if(s_pfnGetTick)
+        {
+            if((s_pfnGetTick() - u32Start) >= u32Timeout)
+                return -1;
+        }
+        else if(++u32Loop >= u32Timeout)
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+
+/**
+ *    @brief        Get overflow count
+ *
+ *    @return       The number of key events dropped because the queue was full.
+ *
+ *    @details      The function is used to get the number of lost key events since the queue was set up.
+ */
+uint32_t KPI_GetOverflowCount()
+{
+    return s_u32OverflowCnt;
+}
+
+
 
 
 /*@}*/ /* end of group KPI_EXPORTED_FUNCTIONS */
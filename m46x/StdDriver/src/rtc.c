@@ -138,6 +138,160 @@ int32_t RTC_32KCalibration(int32_t i32FrequencyX10000)
     return RTC_OK;
 }
 
+/**
+  * @brief      Start Continuous 32 kHz Drift Measurement
+  *
+  * @param[out] psDrift     Drift compensation state.
+  * @param[in]  timer       The timer used for the measurement. It could be TIMER0, TIMER1, TIMER2, TIMER3.
+  * @param[in]  u32RefSel   Frequency reference. It could be
+  *                             - \ref RTC_DRIFT_REF_HXT  : Timer is clocked by HXT and captures LXT internally.
+  *                             - \ref RTC_DRIFT_REF_1PPS : Timer is clocked by LXT and captures a 1PPS signal on TMx_EXT pin.
+  * @param[in]  u32RefHz    Timer clock frequency in Hz for \ref RTC_DRIFT_REF_HXT. Ignored for \ref RTC_DRIFT_REF_1PPS.
+  * @param[in]  u32WindowSec Measurement window in seconds, 1 ~ 60.
+  *
+  * @return     None
+  *
+  * @details    The timer clock source must be selected by the caller. Call \ref RTC_DriftIRQHandler from the timer
+  *             IRQ handler and \ref RTC_DriftProcess from thread context; the NVIC is left to the caller.
+  */
+void RTC_DriftInit(S_RTC_DRIFT_T *psDrift, TIMER_T *timer, uint32_t u32RefSel, uint32_t u32RefHz, uint32_t u32WindowSec)
+{
+    uint32_t u32ExtCtl;
+
+    psDrift->timer = timer;
+    psDrift->u32RefSel = u32RefSel;
+    psDrift->u32RefHz = u32RefHz;
+    psDrift->u32Window = (u32RefSel == RTC_DRIFT_REF_HXT) ? (u32WindowSec * (32768UL / RTC_DRIFT_LXT_DIV)) : u32WindowSec;
+    psDrift->u32Caps = 0UL;
+    psDrift->u32LastCap = 0UL;
+    psDrift->u64Ticks = 0ULL;
+    psDrift->i32FreqX10000 = 0L;
+    psDrift->i32AppliedX10000 = 0L;
+    psDrift->u32Primed = 0UL;
+    psDrift->u32Ready = 0UL;
+    psDrift->u32Rejects = 0UL;
+
+    timer->CTL = 0UL;
+    timer->EINTSTS = TIMER_EINTSTS_CAPIF_Msk;
+    timer->CMP = TIMER_CMP_CMPDAT_Msk;
+
+    u32ExtCtl = TIMER_CAPTURE_FREE_COUNTING_MODE | TIMER_CAPTURE_EVENT_RISING | TIMER_EXTCTL_CAPEN_Msk | TIMER_EXTCTL_CAPIEN_Msk;
+    if(u32RefSel == RTC_DRIFT_REF_HXT)
+    {
+        /* One capture every RTC_DRIFT_LXT_DIV LXT cycles */
+        u32ExtCtl |= TIMER_INTER_CAPTURE_SOURCE_LXT | TIMER_CAPTURE_SOURCE_DIV_256;
+        timer->CTL = TIMER_CTL_CAPSRC_Msk;
+    }
+    timer->EXTCTL = u32ExtCtl;
+    timer->CTL |= TIMER_CONTINUOUS_MODE | TIMER_CTL_CNTEN_Msk;
+}
+
+/**
+  * @brief      32 kHz Drift Measurement Interrupt Service
+  *
+  * @param[in]  psDrift     Drift compensation state.
+  *
+  * @return     None
+  *
+  * @details    Accumulate capture intervals. At the end of each window the LXT frequency estimate is range checked
+  *             and merged into a first order low-pass filter.
+  */
+void RTC_DriftIRQHandler(S_RTC_DRIFT_T *psDrift)
+{
+    TIMER_T *timer = psDrift->timer;
+    uint32_t u32Cap;
+    int32_t i32Est;
+
+    if((timer->EINTSTS & TIMER_EINTSTS_CAPIF_Msk) == 0UL)
+        return;
+
+    u32Cap = timer->CAP;
+    timer->EINTSTS = TIMER_EINTSTS_CAPIF_Msk;
+
+    if(psDrift->u32Primed == 0UL)
+    {
+        psDrift->u32Primed = 1UL;
+        psDrift->u32LastCap = u32Cap;
+        return;
+    }
+
+    psDrift->u64Ticks += (u32Cap - psDrift->u32LastCap) & TIMER_CAP_CAPDAT_Msk;
+    psDrift->u32LastCap = u32Cap;
+
+    if(++psDrift->u32Caps < psDrift->u32Window)
+        return;
+
+    if(psDrift->u32RefSel == RTC_DRIFT_REF_HXT)
+        i32Est = (int32_t)(((uint64_t)RTC_DRIFT_LXT_DIV * psDrift->u32Window * psDrift->u32RefHz * 10000ULL + (psDrift->u64Ticks >> 1)) / psDrift->u64Ticks);
+    else
+        i32Est = (int32_t)((psDrift->u64Ticks * 10000ULL + (psDrift->u32Window >> 1)) / psDrift->u32Window);
+
+    psDrift->u32Caps = 0UL;
+    psDrift->u64Ticks = 0ULL;
+
+    /* A lost or spurious capture shows up as a gross frequency error */
+    if((i32Est < (327680000L - RTC_DRIFT_MAX_X10000)) || (i32Est > (327680000L + RTC_DRIFT_MAX_X10000)))
+    {
+        psDrift->u32Rejects++;
+        return;
+    }
+
+    if(psDrift->i32FreqX10000 == 0L)
+        psDrift->i32FreqX10000 = i32Est;
+    else
+        psDrift->i32FreqX10000 += (i32Est - psDrift->i32FreqX10000) / (1L << RTC_DRIFT_FILTER_SHIFT);
+
+    psDrift->u32Ready = 1UL;
+}
+
+/**
+  * @brief      Apply the Filtered 32 kHz Drift Estimate
+  *
+  * @param[in]  psDrift     Drift compensation state.
+  *
+  * @retval     RTC_OK              No new estimate, calibration unchanged or updated.
+  * @retval     RTC_ERR_TIMEOUT     RTC operation abort due to timeout error.
+  *
+  * @details    \ref RTC_32KCalibration is called when the filtered frequency moved by at least \ref RTC_DRIFT_STEP_X10000
+  *             from the value last programmed. It waits for the RTC, so this API must not be called from an interrupt.
+  */
+int32_t RTC_DriftProcess(S_RTC_DRIFT_T *psDrift)
+{
+    int32_t i32Freq, i32Diff, i32Ret = RTC_OK;
+
+    if(psDrift->u32Ready == 0UL)
+        return RTC_OK;
+
+    psDrift->u32Ready = 0UL;
+    i32Freq = psDrift->i32FreqX10000;
+    i32Diff = i32Freq - psDrift->i32AppliedX10000;
+
+    if((i32Diff >= RTC_DRIFT_STEP_X10000) || (i32Diff <= -RTC_DRIFT_STEP_X10000))
+    {
+        i32Ret = RTC_32KCalibration(i32Freq);
+        if(i32Ret == RTC_OK)
+            psDrift->i32AppliedX10000 = i32Freq;
+    }
+
+    return i32Ret;
+}
+
+/**
+  * @brief      Stop Continuous 32 kHz Drift Measurement
+  *
+  * @param[in]  psDrift     Drift compensation state.
+  *
+  * @return     None
+  *
+  * @details    The last programmed calibration stays in effect.
+  */
+void RTC_DriftClose(S_RTC_DRIFT_T *psDrift)
+{
+    psDrift->timer->CTL = 0UL;
+    psDrift->timer->EXTCTL = 0UL;
+    psDrift->timer->EINTSTS = TIMER_EINTSTS_CAPIF_Msk;
+}
+
 /**
   * @brief      Get Current RTC Date and Time
   *
@@ -233,6 +387,254 @@ void RTC_GetDateAndTime(S_RTC_TIME_DATA_T *sPt)
     }
 }
 
+/** @cond HIDDEN_SYMBOLS */
+/* Number of days before each month in a non-leap year */
+static const uint16_t s_au16RtcDaysBeforeMonth[12] = {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334};
+
+static volatile uint32_t s_u32RtcTsSec;     /* Epoch second of the current RTC second */
+static volatile uint32_t s_u32RtcTsTick;    /* Tick interrupts since the current RTC second started */
+static volatile uint32_t s_u32RtcTsSeq;     /* Advanced on every update of the cached timestamp */
+static uint32_t s_u32RtcTsTime;             /* RTC_TIME value of the current RTC second */
+static uint32_t s_u32RtcTsTickSel;          /* log2 of tick interrupts per second */
+
+static uint32_t RTC_BcdTimeToEpoch(uint32_t u32Cal, uint32_t u32Time, uint32_t u32TimeScale)
+{
+    uint32_t u32Year, u32Month, u32Day, u32Hour, u32Days;
+
+    u32Year  = (((u32Cal & RTC_CAL_TENYEAR_Msk) >> RTC_CAL_TENYEAR_Pos) * 10UL) + ((u32Cal & RTC_CAL_YEAR_Msk) >> RTC_CAL_YEAR_Pos);
+    u32Month = (((u32Cal & RTC_CAL_TENMON_Msk) >> RTC_CAL_TENMON_Pos) * 10UL) + ((u32Cal & RTC_CAL_MON_Msk) >> RTC_CAL_MON_Pos);
+    u32Day   = (((u32Cal & RTC_CAL_TENDAY_Msk) >> RTC_CAL_TENDAY_Pos) * 10UL) + ((u32Cal & RTC_CAL_DAY_Msk) >> RTC_CAL_DAY_Pos);
+    u32Hour  = (((u32Time & RTC_TIME_TENHR_Msk) >> RTC_TIME_TENHR_Pos) * 10UL) + ((u32Time & RTC_TIME_HR_Msk) >> RTC_TIME_HR_Pos);
+
+    if(u32TimeScale == (uint32_t)RTC_CLOCK_12)
+    {
+        /* AM: 1~12. PM: 21~32. */
+        if(u32Hour >= 21UL)
+            u32Hour = (u32Hour == 32UL) ? 12UL : (u32Hour - 8UL);
+        else if(u32Hour == 12UL)
+            u32Hour = 0UL;
+    }
+
+    if((u32Month < 1UL) || (u32Month > 12UL))
+        u32Month = 1UL;
+
+    /* 2000 ~ 2099: every fourth year is a leap year */
+    u32Days = (u32Year * 365UL) + ((u32Year + 3UL) / 4UL) + s_au16RtcDaysBeforeMonth[u32Month - 1UL] + u32Day - 1UL;
+    if(((u32Year & 3UL) == 0UL) && (u32Month > 2UL))
+        u32Days++;
+
+    return RTC_EPOCH_YEAR2000 + (u32Days * 86400UL) + (u32Hour * 3600UL) +
+           (((((u32Time & RTC_TIME_TENMIN_Msk) >> RTC_TIME_TENMIN_Pos) * 10UL) + ((u32Time & RTC_TIME_MIN_Msk) >> RTC_TIME_MIN_Pos)) * 60UL) +
+           ((((u32Time & RTC_TIME_TENSEC_Msk) >> RTC_TIME_TENSEC_Pos) * 10UL) + ((u32Time & RTC_TIME_SEC_Msk) >> RTC_TIME_SEC_Pos));
+}
+/** @endcond HIDDEN_SYMBOLS */
+
+/**
+  * @brief      Start the RTC Timestamp Service
+  *
+  * @param[in]  u32TickSelection    Tick period that sets the timestamp sub-second resolution. It could be
+  *                                     - \ref RTC_TICK_1_SEC ~ \ref RTC_TICK_1_128_SEC
+  *
+  * @return     None
+  *
+  * @details    This API decodes the RTC calendar once, sets the tick period and enables the tick interrupt.
+  *             \ref RTC_TimestampTickHandler must be called from RTC_IRQHandler. After that, \ref RTC_GetTimestamp
+  *             returns the time without decoding the BCD calendar registers.
+  */
+void RTC_TimestampInit(uint32_t u32TickSelection)
+{
+    RTC_DisableInt(RTC_INTEN_TICKIEN_Msk);
+
+    s_u32RtcTsTickSel = u32TickSelection & RTC_TICK_TICK_Msk;
+    RTC_SetTickPeriod(s_u32RtcTsTickSel);
+    RTC_TimestampSync();
+    RTC_EnableInt(RTC_INTEN_TICKIEN_Msk);
+}
+
+/**
+  * @brief      Reload the Cached Timestamp from the RTC Calendar
+  *
+  * @return     None
+  *
+  * @details    Call this API after the RTC date or time is changed.
+  *             The cache is written with interrupts masked, so this API can be called from thread or interrupt context.
+  */
+void RTC_TimestampSync(void)
+{
+    uint32_t u32Time, u32Cal, u32Sec, u32Primask;
+
+    /* Re-read when the calendar rolls over between the two registers */
+    do
+    {
+        u32Time = RTC->TIME;
+        u32Cal = RTC->CAL;
+    }
+    while(u32Time != RTC->TIME);
+
+    u32Sec = RTC_BcdTimeToEpoch(u32Cal, u32Time, RTC->CLKFMT & RTC_CLKFMT_24HEN_Msk);
+
+    /* Mask interrupts so that the tick handler cannot update the cache at the same time */
+    u32Primask = __get_PRIMASK();
+    __disable_irq();
+    s_u32RtcTsTime = u32Time;
+    s_u32RtcTsSec = u32Sec;
+    s_u32RtcTsTick = 0UL;
+    s_u32RtcTsSeq++;
+    __set_PRIMASK(u32Primask);
+}
+
+/**
+  * @brief      RTC Timestamp Tick Interrupt Service
+  *
+  * @return     None
+  *
+  * @details    Clear the tick interrupt flag and advance the cached timestamp. Only the RTC_TIME register is
+  *             read; the calendar is decoded again only if a second boundary was missed.
+  */
+void RTC_TimestampTickHandler(void)
+{
+    uint32_t u32Time, u32Sec, u32Expect, u32Primask;
+
+    if((RTC->INTSTS & RTC_INTSTS_TICKIF_Msk) == 0UL)
+        return;
+
+    RTC_CLEAR_TICK_INT_FLAG();
+
+    u32Time = RTC->TIME;
+    if(u32Time == s_u32RtcTsTime)
+    {
+        /* Clamp so that a late second update cannot wrap the sub-second part */
+        if(s_u32RtcTsTick < ((1UL << s_u32RtcTsTickSel) - 1UL))
+        {
+            u32Primask = __get_PRIMASK();
+            __disable_irq();
+            s_u32RtcTsTick++;
+            s_u32RtcTsSeq++;
+            __set_PRIMASK(u32Primask);
+        }
+        return;
+    }
+
+    u32Sec = (u32Time & RTC_TIME_SEC_Msk) >> RTC_TIME_SEC_Pos;
+    u32Expect = (((s_u32RtcTsTime & RTC_TIME_SEC_Msk) >> RTC_TIME_SEC_Pos) + 1UL) % 10UL;
+
+    if(u32Sec == u32Expect)
+    {
+        u32Primask = __get_PRIMASK();
+        __disable_irq();
+        s_u32RtcTsTime = u32Time;
+        s_u32RtcTsSec++;
+        s_u32RtcTsTick = 0UL;
+        s_u32RtcTsSeq++;
+        __set_PRIMASK(u32Primask);
+    }
+    else
+    {
+        RTC_TimestampSync();
+    }
+}
+
+/**
+  * @brief      Get the RTC Timestamp
+  *
+  * @return     Packed timestamp. Use \ref RTC_TS_SEC to get the seconds since 1970-01-01 00:00:00 and
+  *             \ref RTC_TS_FRAC to get the sub-second part in units of 2^-32 second.
+  *
+  * @details    The sub-second resolution is the tick period selected by \ref RTC_TimestampInit.
+  *             The cache is only updated with interrupts masked, so this API never waits on an update in
+  *             progress and can be called from any interrupt priority. It reads again only if the cache
+  *             was updated while it was being read.
+  */
+uint64_t RTC_GetTimestamp(void)
+{
+    uint32_t u32Seq, u32Sec, u32Tick;
+
+    do
+    {
+        u32Seq = s_u32RtcTsSeq;
+        u32Sec = s_u32RtcTsSec;
+        u32Tick = s_u32RtcTsTick;
+    }
+    while(u32Seq != s_u32RtcTsSeq);
+
+    return ((uint64_t)u32Sec << 32) | ((uint64_t)u32Tick << (32UL - s_u32RtcTsTickSel));
+}
+
+/**
+  * @brief      Convert Date and Time to Epoch Seconds
+  *
+  * @param[in]  sPt     Date and time, year range between 2000 ~ 2099.
+  *
+  * @return     Seconds since 1970-01-01 00:00:00.
+  */
+uint32_t RTC_DateAndTimeToEpoch(S_RTC_TIME_DATA_T *sPt)
+{
+    uint32_t u32Year, u32Hour, u32Days;
+
+    u32Year = sPt->u32Year - RTC_YEAR2000;
+    u32Hour = sPt->u32Hour;
+
+    if(sPt->u32TimeScale == (uint32_t)RTC_CLOCK_12)
+    {
+        u32Hour %= 12UL;
+        if(sPt->u32AmPm == (uint32_t)RTC_PM)
+            u32Hour += 12UL;
+    }
+
+    u32Days = (u32Year * 365UL) + ((u32Year + 3UL) / 4UL) + s_au16RtcDaysBeforeMonth[(sPt->u32Month - 1UL) % 12UL] + sPt->u32Day - 1UL;
+    if(((u32Year & 3UL) == 0UL) && (sPt->u32Month > 2UL))
+        u32Days++;
+
+    return RTC_EPOCH_YEAR2000 + (u32Days * 86400UL) + (u32Hour * 3600UL) + (sPt->u32Minute * 60UL) + sPt->u32Second;
+}
+
+/**
+  * @brief      Convert Epoch Seconds to Date and Time
+  *
+  * @param[in]  u32Epoch    Seconds since 1970-01-01 00:00:00, between year 2000 ~ 2099.
+  * @param[out] sPt         Date and time in 24-hour time scale.
+  *
+  * @return     None
+  */
+void RTC_EpochToDateAndTime(uint32_t u32Epoch, S_RTC_TIME_DATA_T *sPt)
+{
+    uint32_t u32Days, u32Secs, u32Year, u32YearDays, u32Month, u32Leap;
+
+    u32Secs = (u32Epoch - RTC_EPOCH_YEAR2000) % 86400UL;
+    u32Days = (u32Epoch - RTC_EPOCH_YEAR2000) / 86400UL;
+
+    /* 2000-01-01 is Saturday */
+    sPt->u32DayOfWeek = (u32Days + RTC_SATURDAY) % 7UL;
+
+    /* Each 4-year block starts with a leap year */
+    u32Year = (u32Days / 1461UL) * 4UL;
+    u32Days %= 1461UL;
+    u32YearDays = 366UL;
+    while(u32Days >= u32YearDays)
+    {
+        u32Days -= u32YearDays;
+        u32Year++;
+        u32YearDays = 365UL;
+    }
+
+    u32Leap = ((u32Year & 3UL) == 0UL) ? 1UL : 0UL;
+    for(u32Month = 11UL; u32Month > 0UL; u32Month--)
+    {
+        if(u32Days >= (s_au16RtcDaysBeforeMonth[u32Month] + ((u32Month >= 2UL) ? u32Leap : 0UL)))
+            break;
+    }
+    u32Days -= s_au16RtcDaysBeforeMonth[u32Month] + ((u32Month >= 2UL) ? u32Leap : 0UL);
+
+    sPt->u32Year = u32Year + RTC_YEAR2000;
+    sPt->u32Month = u32Month + 1UL;
+    sPt->u32Day = u32Days + 1UL;
+    sPt->u32Hour = u32Secs / 3600UL;
+    sPt->u32Minute = (u32Secs / 60UL) % 60UL;
+    sPt->u32Second = u32Secs % 60UL;
+    sPt->u32TimeScale = RTC_CLOCK_24;
+    sPt->u32AmPm = 0UL;
+}
+
 /**
   * @brief      Get RTC Alarm Date and Time
   *
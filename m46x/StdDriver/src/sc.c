@@ -470,6 +470,1108 @@ uint32_t SC_GetInterfaceClock(SC_T *sc)
     return u32ClkFreq;
 }
 
+/** @cond HIDDEN_SYMBOLS */
+
+#define SC_ENGINE_EVT_TIMEOUT   (0x01UL)
+#define SC_ENGINE_EVT_ERROR     (0x02UL)
+#define SC_ENGINE_EVT_REMOVED   (0x04UL)
+#define SC_ENGINE_EVT_INIT      (0x08UL)
+
+#define SC_ENGINE_ATR_START_ETU (114UL)     /* 42000 clocks from RST high to TS */
+#define SC_ENGINE_ATR_WWT_ETU   (10080UL)   /* 9600 ETU character waiting time plus tolerance */
+#define SC_ENGINE_MIN_ETU       (16UL)      /* Smallest clocks per ETU negotiated by PPS */
+
+#define SC_T1_BLOCK_MAX         (3UL + 254UL + 2UL)
+#define SC_T1_IFSD              (254UL)
+#define SC_T1_MAX_RETRY         (3UL)
+#define SC_T1_R_BLOCK           (0x80U)
+#define SC_T1_S_BLOCK           (0xC0U)
+#define SC_T1_S_RESPONSE        (0x20U)
+#define SC_T1_S_IFS             (0x01U)
+#define SC_T1_S_ABORT           (0x02U)
+#define SC_T1_S_WTX             (0x03U)
+
+typedef struct
+{
+    uint8_t au8RxBuf[SC_ENGINE_RX_BUF_SIZE];
+    volatile uint32_t u32RxHead;        /* Free running, advanced by SC_EngineIRQHandler */
+    volatile uint32_t u32RxTail;        /* Free running, advanced by the protocol functions */
+    const uint8_t *pu8TxBuf;
+    volatile uint32_t u32TxLen;
+    volatile uint32_t u32TxPos;
+    volatile uint32_t u32Event;
+    uint32_t u32Protocol;
+    uint32_t u32WaitEtu;                /* T = 0 work waiting time or T = 1 block waiting time */
+    uint32_t u32CharWaitEtu;            /* T = 1 character waiting time */
+    uint32_t u32IFSC;
+    uint32_t u32Crc;
+    uint8_t u8NS;
+    uint8_t u8NR;
+} SC_ENGINE_T;
+
+static SC_ENGINE_T s_asScEngine[SC_INTERFACE_NUM];
+
+static const uint16_t s_au16ScFiTable[16] = {372U, 372U, 558U, 744U, 1116U, 1488U, 1860U, 0U, 0U, 512U, 768U, 1024U, 1536U, 2048U, 0U, 0U};
+static const uint8_t s_au8ScDiTable[16] = {0U, 1U, 2U, 4U, 8U, 16U, 32U, 64U, 12U, 20U, 0U, 0U, 0U, 0U, 0U, 0U};
+
+static SC_ENGINE_T *SC_EngineGet(SC_T *sc)
+{
+    if(sc == SC0)
+        return &s_asScEngine[0];
+    else if(sc == SC1)
+        return &s_asScEngine[1];
+    else
+        return &s_asScEngine[2];
+}
+
+static void SC_EngineClearEvent(SC_ENGINE_T *psEng, uint32_t u32Mask)
+{
+    uint32_t u32Primask = __get_PRIMASK();
+
+    __disable_irq();
+    psEng->u32Event &= ~u32Mask;
+    __set_PRIMASK(u32Primask);
+}
+
+static void SC_EngineWaitCtlSync(SC_T *sc)
+{
+    uint32_t u32TimeOutCount = SC_TIMEOUT;
+
+    while((sc->CTL & SC_CTL_SYNC_Msk) == SC_CTL_SYNC_Msk)
+    {
+        if(--u32TimeOutCount == 0UL) break;
+    }
+}
+
+/* Timer0 counts the waiting time and reloads on every start bit, so it measures the gap between characters */
+static void SC_EngineArmTimer(SC_T *sc, SC_ENGINE_T *psEng, uint32_t u32Mode, uint32_t u32Etu)
+{
+    if(u32Etu > 0x1000000UL)
+        u32Etu = 0x1000000UL;
+
+    SC_StopTimer(sc, 0UL);
+    sc->INTSTS = SC_INTSTS_TMR0IF_Msk;
+    SC_EngineClearEvent(psEng, SC_ENGINE_EVT_TIMEOUT);
+    SC_StartTimer(sc, 0UL, u32Mode, u32Etu);
+}
+
+static int32_t SC_EngineGetByte(SC_ENGINE_T *psEng, uint8_t *pu8Data)
+{
+    while(psEng->u32RxTail == psEng->u32RxHead)
+    {
+        if(psEng->u32Event & SC_ENGINE_EVT_REMOVED)
+            return SC_ENGINE_ERR_REMOVED;
+        if(psEng->u32Event & SC_ENGINE_EVT_TIMEOUT)
+            return SC_ENGINE_ERR_TIMEOUT;
+    }
+
+    *pu8Data = psEng->au8RxBuf[psEng->u32RxTail & (SC_ENGINE_RX_BUF_SIZE - 1UL)];
+    psEng->u32RxTail++;
+
+    return SC_ENGINE_OK;
+}
+
+static int32_t SC_EngineSend(SC_T *sc, SC_ENGINE_T *psEng, const uint8_t au8Buf[], uint32_t u32Len)
+{
+    psEng->pu8TxBuf = au8Buf;
+    psEng->u32TxPos = 0UL;
+    psEng->u32TxLen = u32Len;
+
+    /* TX buffer empty interrupt fires at once and SC_EngineIRQHandler feeds the FIFO */
+    sc->INTEN |= SC_INTEN_TBEIEN_Msk;
+
+    while((psEng->u32TxPos < psEng->u32TxLen) ||
+            ((sc->STATUS & SC_STATUS_TXEMPTY_Msk) == 0UL) ||
+            ((sc->STATUS & SC_STATUS_TXACT_Msk) == SC_STATUS_TXACT_Msk))
+    {
+        if(psEng->u32Event & (SC_ENGINE_EVT_REMOVED | SC_ENGINE_EVT_ERROR))
+        {
+            sc->INTEN &= ~SC_INTEN_TBEIEN_Msk;
+            return (psEng->u32Event & SC_ENGINE_EVT_REMOVED) ? SC_ENGINE_ERR_REMOVED : SC_ENGINE_ERR_TRANSFER;
+        }
+    }
+
+    return SC_ENGINE_OK;
+}
+
+/* Discard characters until the line has been idle for the character waiting time */
+static void SC_EngineDrain(SC_T *sc, SC_ENGINE_T *psEng, uint32_t u32Etu)
+{
+    uint8_t u8Data;
+
+    SC_EngineArmTimer(sc, psEng, SC_TMR_MODE_F, u32Etu);
+    while(SC_EngineGetByte(psEng, &u8Data) == SC_ENGINE_OK) {}
+    SC_StopTimer(sc, 0UL);
+}
+
+static uint32_t SC_EngineBitCount(uint32_t u32Val)
+{
+    uint32_t u32Cnt = 0UL;
+
+    while(u32Val != 0UL)
+    {
+        u32Cnt += u32Val & 1UL;
+        u32Val >>= 1;
+    }
+
+    return u32Cnt;
+}
+
+static int32_t SC_EngineColdReset(SC_T *sc, SC_ENGINE_T *psEng, S_SC_ATR_T *psAtr)
+{
+    uint32_t u32Len = 0UL, u32Need = 2UL, u32YPos = 1UL, u32Y, u32Hist = 0UL, u32Tck = 0UL, u32TimeOutCount, u32Primask;
+    int32_t i32Ret;
+    uint8_t u8Data;
+
+    SC_ResetReader(sc);
+    sc->INTEN = (sc->INTEN & ~(SC_INTEN_TMR1IEN_Msk | SC_INTEN_TMR2IEN_Msk | SC_INTEN_BGTIEN_Msk)) | SC_INTEN_INITIEN_Msk;
+
+    u32Primask = __get_PRIMASK();
+    __disable_irq();
+    psEng->u32RxHead = 0UL;
+    psEng->u32RxTail = 0UL;
+    psEng->u32TxLen = 0UL;
+    psEng->u32TxPos = 0UL;
+    psEng->u32Event = 0UL;
+    __set_PRIMASK(u32Primask);
+
+    /* Timer0 in activation mode limits the delay from RST high to TS */
+    SC_EngineArmTimer(sc, psEng, SC_TMR_MODE_3, SC_ENGINE_ATR_START_ETU);
+
+    u32TimeOutCount = SC_TIMEOUT;
+    while((sc->ALTCTL & SC_ALTCTL_SYNC_Msk) == SC_ALTCTL_SYNC_Msk)
+    {
+        if(--u32TimeOutCount == 0UL) break;
+    }
+    sc->ALTCTL |= SC_ALTCTL_ACTEN_Msk;
+
+    /* Read TS, T0 and each TDi, and extend the expected length by the bytes they announce */
+    while(u32Len < u32Need)
+    {
+        i32Ret = SC_EngineGetByte(psEng, &u8Data);
+        if(i32Ret != SC_ENGINE_OK)
+        {
+            SC_StopTimer(sc, 0UL);
+            return (i32Ret == SC_ENGINE_ERR_TIMEOUT) ? SC_ENGINE_ERR_ATR : i32Ret;
+        }
+
+        if(u32Len == 0UL)
+            SC_EngineArmTimer(sc, psEng, SC_TMR_MODE_F, SC_ENGINE_ATR_WWT_ETU);
+
+        psAtr->au8Atr[u32Len] = u8Data;
+
+        if(u32Len == u32YPos)
+        {
+            u32Y = (uint32_t)u8Data >> 4;
+            u32Need += SC_EngineBitCount(u32Y);
+
+            /* T0 gives the historical byte count, any TDi announcing T != 0 adds TCK */
+            if(u32Len == 1UL)
+                u32Hist = u8Data & 0xFUL;
+            else if((u8Data & 0xFU) != 0U)
+                u32Tck = 1UL;
+
+            if(u32Y & 0x8UL)
+            {
+                u32YPos = u32Len + SC_EngineBitCount(u32Y);
+            }
+            else
+            {
+                u32Need += u32Hist + u32Tck;
+                u32YPos = 0UL;
+            }
+
+            if(u32Need > SC_ATR_MAX_LEN)
+            {
+                SC_StopTimer(sc, 0UL);
+                return SC_ENGINE_ERR_ATR;
+            }
+        }
+
+        u32Len++;
+    }
+
+    SC_StopTimer(sc, 0UL);
+
+    if(psEng->u32Event & SC_ENGINE_EVT_ERROR)
+        return SC_ENGINE_ERR_TRANSFER;
+
+    return SC_EngineParseAtr(psAtr->au8Atr, u32Len, psAtr);
+}
+
+/* Pick the fastest Di the card offers that still leaves at least SC_ENGINE_MIN_ETU clocks per ETU */
+static uint8_t SC_EngineSelectFiDi(const S_SC_ATR_T *psAtr)
+{
+    uint32_t u32F = s_au16ScFiTable[psAtr->u8Fi], u32CardD = s_au8ScDiTable[psAtr->u8Di];
+    uint32_t u32Di, u32BestDi = 1UL, u32BestD = 1UL, u32D;
+
+    if((u32F == 0UL) || (u32CardD == 0UL))
+        return 0x11U;
+
+    for(u32Di = 1UL; u32Di < 16UL; u32Di++)
+    {
+        u32D = s_au8ScDiTable[u32Di];
+
+        if((u32D > u32BestD) && (u32D <= u32CardD) && ((u32F / u32D) >= SC_ENGINE_MIN_ETU))
+        {
+            u32BestD = u32D;
+            u32BestDi = u32Di;
+        }
+    }
+
+    return (uint8_t)(((uint32_t)psAtr->u8Fi << 4) | u32BestDi);
+}
+
+static int32_t SC_EnginePps(SC_T *sc, SC_ENGINE_T *psEng, uint32_t u32Protocol, uint8_t *pu8FiDi)
+{
+    uint8_t au8Req[4], au8Rsp[6];
+    uint32_t u32Len, u32Need = 3UL, i;
+    uint8_t u8Pck = 0U;
+    int32_t i32Ret;
+
+    au8Req[0] = 0xFFU;
+    au8Req[1] = (uint8_t)(0x10U | u32Protocol);
+    au8Req[2] = *pu8FiDi;
+    au8Req[3] = (uint8_t)(au8Req[0] ^ au8Req[1] ^ au8Req[2]);
+
+    SC_EngineClearEvent(psEng, SC_ENGINE_EVT_ERROR);
+
+    i32Ret = SC_EngineSend(sc, psEng, au8Req, 4UL);
+    if(i32Ret != SC_ENGINE_OK)
+        return i32Ret;
+
+    SC_EngineArmTimer(sc, psEng, SC_TMR_MODE_F, SC_ENGINE_ATR_WWT_ETU);
+
+    for(u32Len = 0UL; u32Len < u32Need; u32Len++)
+    {
+        i32Ret = SC_EngineGetByte(psEng, &au8Rsp[u32Len]);
+        if(i32Ret != SC_ENGINE_OK)
+        {
+            SC_StopTimer(sc, 0UL);
+            return (i32Ret == SC_ENGINE_ERR_TIMEOUT) ? SC_ENGINE_ERR_PPS : i32Ret;
+        }
+
+        if(u32Len == 1UL)
+            u32Need += SC_EngineBitCount(((uint32_t)au8Rsp[1] >> 4) & 0x7UL);
+    }
+
+    SC_StopTimer(sc, 0UL);
+
+    for(i = 0UL; i < u32Len; i++)
+        u8Pck ^= au8Rsp[i];
+
+    if((u8Pck != 0U) || (au8Rsp[0] != 0xFFU) || ((au8Rsp[1] & 0xFU) != u32Protocol))
+        return SC_ENGINE_ERR_PPS;
+
+    /* Card answered without PPS1: keep the default Fi/Di */
+    if(au8Rsp[1] & 0x10U)
+    {
+        if(au8Rsp[2] != *pu8FiDi)
+            return SC_ENGINE_ERR_PPS;
+    }
+    else
+    {
+        *pu8FiDi = 0x11U;
+    }
+
+    return SC_ENGINE_OK;
+}
+
+static void SC_EngineApplyParam(SC_T *sc, SC_ENGINE_T *psEng, const S_SC_ATR_T *psAtr)
+{
+    uint32_t u32F = s_au16ScFiTable[psAtr->u8FiDi >> 4];
+    uint32_t u32D = s_au8ScDiTable[psAtr->u8FiDi & 0xFU];
+    uint32_t u32Cgt;
+
+    sc->ETUCTL = ((u32F + (u32D / 2UL)) / u32D) - 1UL;
+    psEng->u32Protocol = psAtr->u8Protocol;
+
+    if(psAtr->u8Protocol == SC_PROTOCOL_T1)
+    {
+        SC_EngineWaitCtlSync(sc);
+        SC_SET_STOP_BIT_LEN(sc, 1);
+        SC_SetTxRetry(sc, 0UL);
+        SC_SetRxRetry(sc, 0UL);
+        u32Cgt = (psAtr->u8N == 255U) ? 11UL : (12UL + psAtr->u8N);
+        SC_SetBlockGuardTime(sc, 22UL);
+
+        psEng->u32CharWaitEtu = 11UL + (1UL << psAtr->u8CWI);
+        psEng->u32WaitEtu = 11UL + (((960UL * 372UL) << psAtr->u8BWI) / u32F) * u32D;
+        psEng->u32IFSC = psAtr->u8IFSC;
+        psEng->u32Crc = psAtr->u8Crc;
+        psEng->u8NS = 0U;
+        psEng->u8NR = 0U;
+    }
+    else
+    {
+        SC_EngineWaitCtlSync(sc);
+        SC_SET_STOP_BIT_LEN(sc, 2);
+        /* T = 0 repeats characters with parity error in hardware */
+        SC_SetTxRetry(sc, 4UL);
+        SC_SetRxRetry(sc, 4UL);
+        u32Cgt = (psAtr->u8N == 255U) ? 12UL : (12UL + psAtr->u8N);
+        SC_SetBlockGuardTime(sc, 16UL);
+
+        psEng->u32WaitEtu = (uint32_t)psAtr->u8WI * 960UL * u32D;
+    }
+
+    SC_SetCharGuardTime(sc, u32Cgt);
+}
+
+/* Exchange one T = 0 TPDU. Received data is appended to au8Rsp at *pu32RspLen. */
+static int32_t SC_EngineT0Tpdu(SC_T *sc, SC_ENGINE_T *psEng, const uint8_t au8Hdr[], const uint8_t au8Data[], uint32_t u32OutLen,
+                               uint32_t u32InLen, uint8_t au8Rsp[], uint32_t u32RspMax, uint32_t *pu32RspLen, uint8_t au8Sw[])
+{
+    uint32_t u32Left = (u32OutLen != 0UL) ? u32OutLen : u32InLen, u32Cnt, i;
+    uint8_t u8Proc;
+    int32_t i32Ret;
+
+    if((u32InLen != 0UL) && ((*pu32RspLen + u32InLen) > u32RspMax))
+        return SC_ENGINE_ERR_BUF;
+
+    SC_EngineClearEvent(psEng, SC_ENGINE_EVT_ERROR);
+
+    i32Ret = SC_EngineSend(sc, psEng, au8Hdr, 5UL);
+
+    while(i32Ret == SC_ENGINE_OK)
+    {
+        SC_EngineArmTimer(sc, psEng, SC_TMR_MODE_F, psEng->u32WaitEtu);
+
+        i32Ret = SC_EngineGetByte(psEng, &u8Proc);
+        if(i32Ret != SC_ENGINE_OK)
+            break;
+
+        if(u8Proc == 0x60U)
+            continue;
+
+        if(((u8Proc & 0xF0U) == 0x60U) || ((u8Proc & 0xF0U) == 0x90U))
+        {
+            au8Sw[0] = u8Proc;
+            i32Ret = SC_EngineGetByte(psEng, &au8Sw[1]);
+            break;
+        }
+
+        if(u8Proc == au8Hdr[1])
+            u32Cnt = u32Left;
+        else if(((u8Proc ^ au8Hdr[1]) & 0xFFU) == 0xFFU)
+            u32Cnt = (u32Left != 0UL) ? 1UL : 0UL;
+        else
+        {
+            i32Ret = SC_ENGINE_ERR_PROTOCOL;
+            break;
+        }
+
+        if(u32OutLen != 0UL)
+        {
+            i32Ret = SC_EngineSend(sc, psEng, &au8Data[u32OutLen - u32Left], u32Cnt);
+        }
+        else
+        {
+            for(i = 0UL; (i < u32Cnt) && (i32Ret == SC_ENGINE_OK); i++)
+                i32Ret = SC_EngineGetByte(psEng, &au8Rsp[(*pu32RspLen)++]);
+        }
+
+        u32Left -= u32Cnt;
+    }
+
+    SC_StopTimer(sc, 0UL);
+
+    if((i32Ret == SC_ENGINE_OK) && (psEng->u32Event & SC_ENGINE_EVT_ERROR))
+        i32Ret = SC_ENGINE_ERR_TRANSFER;
+
+    return i32Ret;
+}
+
+static int32_t SC_EngineT0Transceive(SC_T *sc, SC_ENGINE_T *psEng, const uint8_t au8Cmd[], uint32_t u32CmdLen,
+                                     uint8_t au8Rsp[], uint32_t *pu32RspLen)
+{
+    uint8_t au8Hdr[5], au8Sw[2];
+    uint32_t u32RspMax = *pu32RspLen, u32Len = 0UL, u32Lc = 0UL, u32Le = 0UL, u32Resent = 0UL;
+    int32_t i32Ret;
+
+    if((u32CmdLen < 4UL) || (u32RspMax < 2UL))
+        return SC_ENGINE_ERR_PARAM;
+
+    au8Hdr[0] = au8Cmd[0];
+    au8Hdr[1] = au8Cmd[1];
+    au8Hdr[2] = au8Cmd[2];
+    au8Hdr[3] = au8Cmd[3];
+    au8Hdr[4] = 0U;
+
+    if(u32CmdLen == 5UL)
+    {
+        /* Case 2: Le of 0 means 256 */
+        au8Hdr[4] = au8Cmd[4];
+        u32Le = (au8Cmd[4] != 0U) ? au8Cmd[4] : 256UL;
+    }
+    else if(u32CmdLen > 5UL)
+    {
+        /* Case 3 and case 4. Case 4 data is fetched by GET RESPONSE */
+        u32Lc = au8Cmd[4];
+        if((u32Lc == 0UL) || ((u32CmdLen != (5UL + u32Lc)) && (u32CmdLen != (6UL + u32Lc))))
+            return SC_ENGINE_ERR_PARAM;
+        au8Hdr[4] = au8Cmd[4];
+    }
+
+    u32RspMax -= 2UL;
+    i32Ret = SC_EngineT0Tpdu(sc, psEng, au8Hdr, (u32Lc != 0UL) ? &au8Cmd[5] : NULL, u32Lc, u32Le, au8Rsp, u32RspMax, &u32Len, au8Sw);
+
+    while(i32Ret == SC_ENGINE_OK)
+    {
+        if((au8Sw[0] == 0x6CU) && (u32Le != 0UL) && (u32Resent == 0UL))
+        {
+            /* Wrong Le, resend with the length the card asks for */
+            au8Hdr[4] = au8Sw[1];
+            u32Le = (au8Sw[1] != 0U) ? au8Sw[1] : 256UL;
+            u32Len = 0UL;
+            u32Resent = 1UL;
+        }
+        else if(au8Sw[0] == 0x61U)
+        {
+            /* More data available, issue GET RESPONSE */
+            au8Hdr[1] = 0xC0U;
+            au8Hdr[2] = 0U;
+            au8Hdr[3] = 0U;
+            au8Hdr[4] = au8Sw[1];
+            u32Le = (au8Sw[1] != 0U) ? au8Sw[1] : 256UL;
+        }
+        else
+        {
+            break;
+        }
+
+        i32Ret = SC_EngineT0Tpdu(sc, psEng, au8Hdr, NULL, 0UL, u32Le, au8Rsp, u32RspMax, &u32Len, au8Sw);
+    }
+
+    if(i32Ret == SC_ENGINE_OK)
+    {
+        au8Rsp[u32Len++] = au8Sw[0];
+        au8Rsp[u32Len++] = au8Sw[1];
+        *pu32RspLen = u32Len;
+    }
+
+    return i32Ret;
+}
+
+static uint32_t SC_EngineT1Edc(const SC_ENGINE_T *psEng, const uint8_t au8Blk[], uint32_t u32Len, uint8_t au8Edc[])
+{
+    uint32_t u32Crc = 0xFFFFUL, i, j;
+    uint8_t u8Lrc = 0U;
+
+    if(psEng->u32Crc == 0UL)
+    {
+        for(i = 0UL; i < u32Len; i++)
+            u8Lrc ^= au8Blk[i];
+        au8Edc[0] = u8Lrc;
+        return 1UL;
+    }
+
+    /* ISO/IEC 13239 CRC, sent most significant byte first */
+    for(i = 0UL; i < u32Len; i++)
+    {
+        u32Crc ^= au8Blk[i];
+        for(j = 0UL; j < 8UL; j++)
+            u32Crc = (u32Crc & 1UL) ? ((u32Crc >> 1) ^ 0x8408UL) : (u32Crc >> 1);
+    }
+    au8Edc[0] = (uint8_t)(u32Crc >> 8);
+    au8Edc[1] = (uint8_t)u32Crc;
+
+    return 2UL;
+}
+
+static uint32_t SC_EngineT1Build(const SC_ENGINE_T *psEng, uint8_t au8Blk[], uint8_t u8Pcb, const uint8_t au8Inf[], uint32_t u32InfLen)
+{
+    uint32_t i;
+
+    au8Blk[0] = 0U;
+    au8Blk[1] = u8Pcb;
+    au8Blk[2] = (uint8_t)u32InfLen;
+    for(i = 0UL; i < u32InfLen; i++)
+        au8Blk[3UL + i] = au8Inf[i];
+
+    return 3UL + u32InfLen + SC_EngineT1Edc(psEng, au8Blk, 3UL + u32InfLen, &au8Blk[3UL + u32InfLen]);
+}
+
+/* Build the I-block that carries au8Cmd[u32Off...] and return its length */
+static uint32_t SC_EngineT1IBlock(const SC_ENGINE_T *psEng, uint8_t au8Blk[], const uint8_t au8Cmd[], uint32_t u32CmdLen,
+                                  uint32_t u32Off, uint32_t *pu32Chunk)
+{
+    uint32_t u32Chunk = u32CmdLen - u32Off;
+    uint8_t u8Pcb = (uint8_t)(psEng->u8NS << 6);
+
+    if(u32Chunk > psEng->u32IFSC)
+    {
+        u32Chunk = psEng->u32IFSC;
+        u8Pcb |= 0x20U;
+    }
+
+    *pu32Chunk = u32Chunk;
+
+    return SC_EngineT1Build(psEng, au8Blk, u8Pcb, &au8Cmd[u32Off], u32Chunk);
+}
+
+static int32_t SC_EngineT1Recv(SC_T *sc, SC_ENGINE_T *psEng, uint8_t au8Blk[], uint32_t *pu32Len, uint32_t u32Wtx)
+{
+    uint32_t u32Len = 0UL, u32Need = 3UL, u32EdcLen = (psEng->u32Crc != 0UL) ? 2UL : 1UL;
+    uint8_t au8Edc[2] = {0U, 0U};
+    int32_t i32Ret;
+
+    SC_EngineClearEvent(psEng, SC_ENGINE_EVT_ERROR);
+    SC_EngineArmTimer(sc, psEng, SC_TMR_MODE_F, psEng->u32WaitEtu * u32Wtx);
+
+    while(u32Len < u32Need)
+    {
+        i32Ret = SC_EngineGetByte(psEng, &au8Blk[u32Len]);
+        if(i32Ret != SC_ENGINE_OK)
+        {
+            SC_StopTimer(sc, 0UL);
+            return i32Ret;
+        }
+
+        /* Block waiting time applies to the first character only */
+        if(u32Len == 0UL)
+            SC_EngineArmTimer(sc, psEng, SC_TMR_MODE_F, psEng->u32CharWaitEtu);
+
+        if(u32Len == 2UL)
+        {
+            if(au8Blk[2] == 0xFFU)
+            {
+                SC_EngineDrain(sc, psEng, psEng->u32CharWaitEtu);
+                return SC_ENGINE_ERR_PROTOCOL;
+            }
+            u32Need += au8Blk[2] + u32EdcLen;
+        }
+
+        u32Len++;
+    }
+
+    SC_StopTimer(sc, 0UL);
+
+    if(psEng->u32Event & SC_ENGINE_EVT_ERROR)
+        return SC_ENGINE_ERR_TRANSFER;
+
+    SC_EngineT1Edc(psEng, au8Blk, u32Len - u32EdcLen, au8Edc);
+    if((au8Edc[0] != au8Blk[u32Len - u32EdcLen]) || ((u32EdcLen == 2UL) && (au8Edc[1] != au8Blk[u32Len - 1UL])))
+        return SC_ENGINE_ERR_TRANSFER;
+
+    *pu32Len = u32Len;
+
+    return SC_ENGINE_OK;
+}
+
+static int32_t SC_EngineT1Transceive(SC_T *sc, SC_ENGINE_T *psEng, const uint8_t au8Cmd[], uint32_t u32CmdLen,
+                                     uint8_t au8Rsp[], uint32_t *pu32RspLen)
+{
+    uint8_t au8Tx[SC_T1_BLOCK_MAX], au8Rx[SC_T1_BLOCK_MAX];
+    uint32_t u32TxLen, u32RxLen = 0UL, u32Off = 0UL, u32Chunk, u32Len = 0UL, u32RspMax = *pu32RspLen;
+    uint32_t u32Retry = 0UL, u32Wtx = 1UL, u32Receiving = 0UL, i;
+    uint8_t u8Pcb;
+    int32_t i32Ret;
+
+    u32TxLen = SC_EngineT1IBlock(psEng, au8Tx, au8Cmd, u32CmdLen, u32Off, &u32Chunk);
+
+    for(;;)
+    {
+        i32Ret = SC_EngineSend(sc, psEng, au8Tx, u32TxLen);
+        if(i32Ret == SC_ENGINE_OK)
+            i32Ret = SC_EngineT1Recv(sc, psEng, au8Rx, &u32RxLen, u32Wtx);
+        u32Wtx = 1UL;
+
+        if(i32Ret == SC_ENGINE_ERR_REMOVED)
+            return i32Ret;
+
+        if(i32Ret != SC_ENGINE_OK)
+        {
+            /* Ask the card to send its last block again */
+            if(++u32Retry > SC_T1_MAX_RETRY)
+                return i32Ret;
+            u32TxLen = SC_EngineT1Build(psEng, au8Tx, (uint8_t)(SC_T1_R_BLOCK | (psEng->u8NR << 4) | ((i32Ret == SC_ENGINE_ERR_TRANSFER) ? 1U : 2U)), NULL, 0UL);
+            continue;
+        }
+
+        u8Pcb = au8Rx[1];
+
+        if((u8Pcb & 0x80U) == 0U)
+        {
+            /* I-block. The first one also acknowledges the last I-block of the command. */
+            if(((u32Receiving == 0UL) && ((u32Off + u32Chunk) < u32CmdLen)) || (((u8Pcb >> 6) & 1U) != psEng->u8NR))
+            {
+                if(++u32Retry > SC_T1_MAX_RETRY)
+                    return SC_ENGINE_ERR_PROTOCOL;
+                u32TxLen = SC_EngineT1Build(psEng, au8Tx, (uint8_t)(SC_T1_R_BLOCK | (psEng->u8NR << 4) | 2U), NULL, 0UL);
+                continue;
+            }
+
+            if(u32Receiving == 0UL)
+            {
+                psEng->u8NS ^= 1U;
+                u32Receiving = 1UL;
+            }
+
+            if((u32Len + au8Rx[2]) > u32RspMax)
+                return SC_ENGINE_ERR_BUF;
+            for(i = 0UL; i < au8Rx[2]; i++)
+                au8Rsp[u32Len++] = au8Rx[3UL + i];
+
+            psEng->u8NR ^= 1U;
+            u32Retry = 0UL;
+
+            if((u8Pcb & 0x20U) == 0U)
+            {
+                *pu32RspLen = u32Len;
+                return SC_ENGINE_OK;
+            }
+
+            /* Card is chaining, acknowledge and wait for the next block */
+            u32TxLen = SC_EngineT1Build(psEng, au8Tx, (uint8_t)(SC_T1_R_BLOCK | (psEng->u8NR << 4)), NULL, 0UL);
+        }
+        else if((u8Pcb & 0xC0U) == SC_T1_R_BLOCK)
+        {
+            if((u32Receiving == 0UL) && ((u32Off + u32Chunk) < u32CmdLen) && (((u8Pcb >> 4) & 1U) != psEng->u8NS))
+            {
+                /* Chained I-block acknowledged, send the next one */
+                psEng->u8NS ^= 1U;
+                u32Off += u32Chunk;
+                u32Retry = 0UL;
+                u32TxLen = SC_EngineT1IBlock(psEng, au8Tx, au8Cmd, u32CmdLen, u32Off, &u32Chunk);
+                continue;
+            }
+
+            if(++u32Retry > SC_T1_MAX_RETRY)
+                return SC_ENGINE_ERR_PROTOCOL;
+
+            /* Resend the I-block, or during response chaining the last R-block */
+            if(u32Receiving == 0UL)
+                u32TxLen = SC_EngineT1IBlock(psEng, au8Tx, au8Cmd, u32CmdLen, u32Off, &u32Chunk);
+        }
+        else
+        {
+            switch(u8Pcb & 0x3FU)
+            {
+                case SC_T1_S_WTX:
+                    u32Wtx = (au8Rx[2] != 0U) ? au8Rx[3] : 1UL;
+                    if(u32Wtx == 0UL)
+                        u32Wtx = 1UL;
+                    break;
+                case SC_T1_S_IFS:
+                    if((au8Rx[2] == 0U) || (au8Rx[3] == 0U) || (au8Rx[3] == 0xFFU))
+                        return SC_ENGINE_ERR_PROTOCOL;
+                    psEng->u32IFSC = au8Rx[3];
+                    break;
+                case SC_T1_S_ABORT:
+                    u32TxLen = SC_EngineT1Build(psEng, au8Tx, (uint8_t)(SC_T1_S_BLOCK | SC_T1_S_RESPONSE | SC_T1_S_ABORT), NULL, 0UL);
+                    SC_EngineSend(sc, psEng, au8Tx, u32TxLen);
+                    return SC_ENGINE_ERR_PROTOCOL;
+                default:
+                    if(++u32Retry > SC_T1_MAX_RETRY)
+                        return SC_ENGINE_ERR_PROTOCOL;
+                    u32TxLen = SC_EngineT1Build(psEng, au8Tx, (uint8_t)(SC_T1_R_BLOCK | (psEng->u8NR << 4) | 2U), NULL, 0UL);
+                    continue;
+            }
+
+            /* Answer the request with the same information field */
+            u32TxLen = SC_EngineT1Build(psEng, au8Tx, (uint8_t)(u8Pcb | SC_T1_S_RESPONSE), &au8Rx[3], au8Rx[2]);
+        }
+    }
+}
+
+/* Announce the reader information field size once after activation */
+static int32_t SC_EngineT1SetIfsd(SC_T *sc, SC_ENGINE_T *psEng)
+{
+    uint8_t au8Tx[6], au8Rx[SC_T1_BLOCK_MAX];
+    uint8_t u8Ifsd = (uint8_t)SC_T1_IFSD;
+    uint32_t u32TxLen, u32RxLen, u32Retry;
+    int32_t i32Ret = SC_ENGINE_ERR_PROTOCOL;
+
+    u32TxLen = SC_EngineT1Build(psEng, au8Tx, (uint8_t)(SC_T1_S_BLOCK | SC_T1_S_IFS), &u8Ifsd, 1UL);
+
+    for(u32Retry = 0UL; u32Retry <= SC_T1_MAX_RETRY; u32Retry++)
+    {
+        i32Ret = SC_EngineSend(sc, psEng, au8Tx, u32TxLen);
+        if(i32Ret == SC_ENGINE_OK)
+            i32Ret = SC_EngineT1Recv(sc, psEng, au8Rx, &u32RxLen, 1UL);
+
+        if(i32Ret == SC_ENGINE_ERR_REMOVED)
+            break;
+
+        if((i32Ret == SC_ENGINE_OK) && (au8Rx[1] == (SC_T1_S_BLOCK | SC_T1_S_RESPONSE | SC_T1_S_IFS)))
+            break;
+
+        i32Ret = SC_ENGINE_ERR_PROTOCOL;
+    }
+
+    return i32Ret;
+}
+
+/** @endcond HIDDEN_SYMBOLS */
+
+/**
+  * @brief      Protocol engine interrupt service
+  *
+  * @param[in]  sc      The pointer of smartcard module.
+  *
+  * @return     None
+  *
+  * @details    Call this function from the interrupt handler of the smartcard module used with
+  *             SC_EngineActivate() and SC_EngineTransceive(). It moves received characters to the engine ring,
+  *             feeds the Tx FIFO and records timer0 time-out, transfer error and card removal.
+  */
+void SC_EngineIRQHandler(SC_T *sc)
+{
+    SC_ENGINE_T *psEng = SC_EngineGet(sc);
+    uint32_t u32IntSts = sc->INTSTS, u32Status;
+
+    while((sc->STATUS & SC_STATUS_RXEMPTY_Msk) == 0UL)
+    {
+        if((psEng->u32RxHead - psEng->u32RxTail) < SC_ENGINE_RX_BUF_SIZE)
+        {
+            psEng->au8RxBuf[psEng->u32RxHead & (SC_ENGINE_RX_BUF_SIZE - 1UL)] = (uint8_t)sc->DAT;
+            psEng->u32RxHead++;
+        }
+        else
+        {
+            (void)sc->DAT;
+            psEng->u32Event |= SC_ENGINE_EVT_ERROR;
+        }
+    }
+
+    if((u32IntSts & SC_INTSTS_TBEIF_Msk) && (sc->INTEN & SC_INTEN_TBEIEN_Msk))
+    {
+        while((psEng->u32TxPos < psEng->u32TxLen) && ((sc->STATUS & SC_STATUS_TXFULL_Msk) == 0UL))
+        {
+            sc->DAT = psEng->pu8TxBuf[psEng->u32TxPos];
+            psEng->u32TxPos++;
+        }
+
+        if(psEng->u32TxPos >= psEng->u32TxLen)
+            sc->INTEN &= ~SC_INTEN_TBEIEN_Msk;
+    }
+
+    if(u32IntSts & SC_INTSTS_TERRIF_Msk)
+    {
+        u32Status = sc->STATUS;
+        sc->STATUS = u32Status & (SC_STATUS_RXOV_Msk | SC_STATUS_PEF_Msk | SC_STATUS_FEF_Msk | SC_STATUS_BEF_Msk |
+                                  SC_STATUS_TXOV_Msk | SC_STATUS_RXOVERR_Msk | SC_STATUS_TXOVERR_Msk);
+        psEng->u32Event |= SC_ENGINE_EVT_ERROR;
+    }
+
+    if(u32IntSts & SC_INTSTS_CDIF_Msk)
+    {
+        if(sc->STATUS & SC_STATUS_CREMOVE_Msk)
+            psEng->u32Event |= SC_ENGINE_EVT_REMOVED;
+        sc->STATUS = SC_STATUS_CREMOVE_Msk | SC_STATUS_CINSERT_Msk;
+    }
+
+    if(u32IntSts & SC_INTSTS_TMR0IF_Msk)
+        psEng->u32Event |= SC_ENGINE_EVT_TIMEOUT;
+
+    if(u32IntSts & SC_INTSTS_INITIF_Msk)
+        psEng->u32Event |= SC_ENGINE_EVT_INIT;
+
+    if(u32IntSts & SC_INTSTS_ACERRIF_Msk)
+        psEng->u32Event |= SC_ENGINE_EVT_ERROR;
+
+    sc->INTSTS = u32IntSts & (SC_INTSTS_TERRIF_Msk | SC_INTSTS_TMR0IF_Msk | SC_INTSTS_TMR1IF_Msk | SC_INTSTS_TMR2IF_Msk |
+                              SC_INTSTS_BGTIF_Msk | SC_INTSTS_CDIF_Msk | SC_INTSTS_INITIF_Msk | SC_INTSTS_RXTOIF_Msk |
+                              SC_INTSTS_ACERRIF_Msk);
+}
+
+/**
+  * @brief      Decode an Answer To Reset
+  *
+  * @param[in]  au8Atr  ATR starting with TS.
+  * @param[in]  u32Len  ATR length.
+  * @param[out] psAtr   Decoded ATR. au8Atr and u8AtrLen are filled with a copy of the input.
+  *
+  * @retval     SC_ENGINE_OK        ATR decoded
+  * @retval     SC_ENGINE_ERR_ATR   Malformed ATR, wrong TCK or reserved parameter value
+  *
+  * @details    Parameters not present in the ATR take their ISO 7816-3 default values.
+  *             The protocol in use is the one of TA2 in specific mode, otherwise the first offered protocol.
+  */
+int32_t SC_EngineParseAtr(const uint8_t au8Atr[], uint32_t u32Len, S_SC_ATR_T *psAtr)
+{
+    uint32_t u32Pos = 2UL, u32Y, u32I = 1UL, u32T = 0UL, u32FirstT = 0xFFUL, u32T1Seen = 0UL, u32Tck = 0UL, i;
+    uint8_t u8Tck = 0U, u8Byte;
+
+    if((u32Len < 2UL) || (u32Len > SC_ATR_MAX_LEN) || ((au8Atr[0] != 0x3BU) && (au8Atr[0] != 0x3FU)))
+        return SC_ENGINE_ERR_ATR;
+
+    for(i = 0UL; i < u32Len; i++)
+        psAtr->au8Atr[i] = au8Atr[i];
+    psAtr->u8AtrLen = (uint8_t)u32Len;
+
+    psAtr->u8Fi = 1U;
+    psAtr->u8Di = 1U;
+    psAtr->u8N = 0U;
+    psAtr->u8WI = 10U;
+    psAtr->u8IFSC = 32U;
+    psAtr->u8CWI = 13U;
+    psAtr->u8BWI = 4U;
+    psAtr->u8Crc = 0U;
+    psAtr->u8Specific = 0U;
+    psAtr->u8Protocols = 0U;
+    psAtr->u8FiDi = 0x11U;
+
+    u32Y = (uint32_t)au8Atr[1] >> 4;
+    psAtr->u8HistLen = au8Atr[1] & 0xFU;
+
+    /* Interface bytes of group i, u32T is the protocol announced by TD(i-1) */
+    for(;;)
+    {
+        if((u32Pos + SC_EngineBitCount(u32Y)) > u32Len)
+            return SC_ENGINE_ERR_ATR;
+
+        if(u32Y & 0x1UL)
+        {
+            u8Byte = au8Atr[u32Pos++];
+            if(u32I == 1UL)
+            {
+                psAtr->u8Fi = u8Byte >> 4;
+                psAtr->u8Di = u8Byte & 0xFU;
+            }
+            else if(u32I == 2UL)
+            {
+                psAtr->u8Specific = 1U;
+                psAtr->u8Protocol = u8Byte & 0xFU;
+                /* Bit 5 set means implicit parameters, TA1 does not apply */
+                if(u8Byte & 0x10U)
+                {
+                    psAtr->u8Fi = 1U;
+                    psAtr->u8Di = 1U;
+                }
+            }
+            else if((u32T == 1UL) && (u32T1Seen == 0UL))
+            {
+                if((u8Byte == 0U) || (u8Byte == 0xFFU))
+                    return SC_ENGINE_ERR_ATR;
+                psAtr->u8IFSC = u8Byte;
+            }
+        }
+
+        if(u32Y & 0x2UL)
+        {
+            u8Byte = au8Atr[u32Pos++];
+            if((u32I > 2UL) && (u32T == 1UL) && (u32T1Seen == 0UL))
+            {
+                psAtr->u8CWI = u8Byte & 0xFU;
+                psAtr->u8BWI = u8Byte >> 4;
+                if(psAtr->u8BWI > 9U)
+                    return SC_ENGINE_ERR_ATR;
+            }
+        }
+
+        if(u32Y & 0x4UL)
+        {
+            u8Byte = au8Atr[u32Pos++];
+            if(u32I == 1UL)
+                psAtr->u8N = u8Byte;
+            else if(u32I == 2UL)
+            {
+                if(u8Byte == 0U)
+                    return SC_ENGINE_ERR_ATR;
+                psAtr->u8WI = u8Byte;
+            }
+            else if((u32T == 1UL) && (u32T1Seen == 0UL))
+                psAtr->u8Crc = u8Byte & 0x1U;
+        }
+
+        if((u32I > 2UL) && (u32T == 1UL))
+            u32T1Seen = 1UL;
+
+        if((u32Y & 0x8UL) == 0UL)
+            break;
+
+        u8Byte = au8Atr[u32Pos++];
+        u32T = u8Byte & 0xFU;
+        u32Y = (uint32_t)u8Byte >> 4;
+        u32I++;
+
+        if(u32T < 8UL)
+            psAtr->u8Protocols |= (uint8_t)(1UL << u32T);
+        if(u32FirstT == 0xFFUL)
+            u32FirstT = u32T;
+        if(u32T != 0UL)
+            u32Tck = 1UL;
+    }
+
+    psAtr->u8HistOffset = (uint8_t)u32Pos;
+    u32Pos += psAtr->u8HistLen;
+
+    if(u32Tck != 0UL)
+    {
+        if(u32Pos >= u32Len)
+            return SC_ENGINE_ERR_ATR;
+        for(i = 1UL; i <= u32Pos; i++)
+            u8Tck ^= au8Atr[i];
+        if(u8Tck != 0U)
+            return SC_ENGINE_ERR_ATR;
+        u32Pos++;
+    }
+
+    if(u32Pos != u32Len)
+        return SC_ENGINE_ERR_ATR;
+
+    if(psAtr->u8Protocols == 0U)
+        psAtr->u8Protocols = 0x1U;
+
+    if(psAtr->u8Specific == 0U)
+        psAtr->u8Protocol = (uint8_t)((u32FirstT == 0xFFUL) ? SC_PROTOCOL_T0 : u32FirstT);
+
+    if((psAtr->u8Protocol != SC_PROTOCOL_T0) && (psAtr->u8Protocol != SC_PROTOCOL_T1))
+        return SC_ENGINE_ERR_ATR;
+
+    return SC_ENGINE_OK;
+}
+
+/**
+  * @brief      Activate the card, read its ATR and negotiate the transmission parameters
+  *
+  * @param[in]  sc      The pointer of smartcard module.
+  * @param[out] psAtr   Decoded ATR and the parameters in use.
+  *
+  * @retval     SC_ENGINE_OK            Card is ready for SC_EngineTransceive()
+  * @retval     SC_ENGINE_ERR_REMOVED   No card
+  * @retval     SC_ENGINE_ERR_ATR       No or invalid ATR
+  * @retval     SC_ENGINE_ERR_TRANSFER  Transfer error during ATR
+  * @retval     SC_ENGINE_ERR_PARAM     psAtr is NULL
+  *
+  * @details    Call SC_Open() and enable the smartcard interrupt before this function; the interrupt handler
+  *             must call SC_EngineIRQHandler(). In negotiable mode the fastest Di the card offers is requested
+  *             by PPS. If the card rejects PPS it is reset again and kept at the default rate.
+  *             For T = 1 the reader information field size is announced with an S(IFS) request.
+  */
+int32_t SC_EngineActivate(SC_T *sc, S_SC_ATR_T *psAtr)
+{
+    SC_ENGINE_T *psEng = SC_EngineGet(sc);
+    uint8_t u8FiDi;
+    int32_t i32Ret;
+
+    if(psAtr == NULL)
+        return SC_ENGINE_ERR_PARAM;
+
+    if(SC_IsCardInserted(sc) == (uint32_t)FALSE)
+        return SC_ENGINE_ERR_REMOVED;
+
+    i32Ret = SC_EngineColdReset(sc, psEng, psAtr);
+    if(i32Ret != SC_ENGINE_OK)
+        return i32Ret;
+
+    if(psAtr->u8Specific != 0U)
+    {
+        psAtr->u8FiDi = (uint8_t)((psAtr->u8Fi << 4) | psAtr->u8Di);
+        if((s_au16ScFiTable[psAtr->u8Fi] == 0U) || (s_au8ScDiTable[psAtr->u8Di] == 0U))
+            return SC_ENGINE_ERR_ATR;
+    }
+    else
+    {
+        u8FiDi = SC_EngineSelectFiDi(psAtr);
+
+        if((s_au8ScDiTable[u8FiDi & 0xFU] > 1U) || (psAtr->u8Protocols != (1U << psAtr->u8Protocol)))
+        {
+            i32Ret = SC_EnginePps(sc, psEng, psAtr->u8Protocol, &u8FiDi);
+
+            if(i32Ret == SC_ENGINE_ERR_REMOVED)
+                return i32Ret;
+
+            if(i32Ret != SC_ENGINE_OK)
+            {
+                /* A card that fails PPS must be reset and used at the default rate */
+                SC_EngineDeactivate(sc);
+                i32Ret = SC_EngineColdReset(sc, psEng, psAtr);
+                if(i32Ret != SC_ENGINE_OK)
+                    return i32Ret;
+                u8FiDi = 0x11U;
+            }
+        }
+        else
+        {
+            u8FiDi = 0x11U;
+        }
+
+        psAtr->u8FiDi = u8FiDi;
+    }
+
+    SC_EngineApplyParam(sc, psEng, psAtr);
+
+    if(psAtr->u8Protocol == SC_PROTOCOL_T1)
+    {
+        i32Ret = SC_EngineT1SetIfsd(sc, psEng);
+        if(i32Ret == SC_ENGINE_ERR_REMOVED)
+            return i32Ret;
+    }
+
+    return SC_ENGINE_OK;
+}
+
+/**
+  * @brief      Exchange a command APDU with the card
+  *
+  * @param[in]      sc          The pointer of smartcard module.
+  * @param[in]      au8Cmd      Command APDU. Short APDUs only.
+  * @param[in]      u32CmdLen   Command APDU length.
+  * @param[out]     au8Rsp      Response data followed by SW1 SW2.
+  * @param[in,out]  pu32RspLen  Size of au8Rsp on input, response length on output.
+  *
+  * @retval     SC_ENGINE_OK            Response received
+  * @retval     SC_ENGINE_ERR_TIMEOUT   Card did not answer in time
+  * @retval     SC_ENGINE_ERR_REMOVED   Card removed
+  * @retval     SC_ENGINE_ERR_TRANSFER  Transfer error
+  * @retval     SC_ENGINE_ERR_PROTOCOL  Protocol error
+  * @retval     SC_ENGINE_ERR_BUF       Response does not fit au8Rsp
+  * @retval     SC_ENGINE_ERR_PARAM     Invalid APDU
+  *
+  * @details    For T = 0, procedure bytes are handled and 61XX/6CXX are followed by GET RESPONSE or a resend.
+  *             For T = 1, the command is chained by IFSC, response chaining, WTX and IFS requests are handled
+  *             and a lost or corrupted block is recovered with R-blocks.
+  */
+int32_t SC_EngineTransceive(SC_T *sc, const uint8_t au8Cmd[], uint32_t u32CmdLen, uint8_t au8Rsp[], uint32_t *pu32RspLen)
+{
+    SC_ENGINE_T *psEng = SC_EngineGet(sc);
+
+    if((au8Cmd == NULL) || (au8Rsp == NULL) || (pu32RspLen == NULL) || (u32CmdLen == 0UL))
+        return SC_ENGINE_ERR_PARAM;
+
+    if(psEng->u32Event & SC_ENGINE_EVT_REMOVED)
+        return SC_ENGINE_ERR_REMOVED;
+
+    if(psEng->u32Protocol == SC_PROTOCOL_T1)
+        return SC_EngineT1Transceive(sc, psEng, au8Cmd, u32CmdLen, au8Rsp, pu32RspLen);
+    else
+        return SC_EngineT0Transceive(sc, psEng, au8Cmd, u32CmdLen, au8Rsp, pu32RspLen);
+}
+
+/**
+  * @brief      Deactivate the card
+  *
+  * @param[in]  sc      The pointer of smartcard module.
+  *
+  * @return     None
+  *
+  * @details    Stops the smartcard timers and runs the hardware deactivation sequence.
+  */
+void SC_EngineDeactivate(SC_T *sc)
+{
+    SC_ENGINE_T *psEng = SC_EngineGet(sc);
+    uint32_t u32TimeOutCount;
+
+    SC_StopAllTimer(sc);
+    SC_EngineClearEvent(psEng, SC_ENGINE_EVT_INIT);
+
+    u32TimeOutCount = SC_TIMEOUT;
+    while((sc->ALTCTL & SC_ALTCTL_SYNC_Msk) == SC_ALTCTL_SYNC_Msk)
+    {
+        if(--u32TimeOutCount == 0UL) break;
+    }
+    sc->ALTCTL |= SC_ALTCTL_DACTEN_Msk;
+
+    u32TimeOutCount = SC_TIMEOUT;
+    while((psEng->u32Event & SC_ENGINE_EVT_INIT) == 0UL)
+    {
+        if(--u32TimeOutCount == 0UL) break;
+    }
+}
+
 /**@}*/ /* end of group SC_EXPORTED_FUNCTIONS */
 
 /**@}*/ /* end of group SC_Driver */
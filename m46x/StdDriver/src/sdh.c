@@ -24,6 +24,13 @@
 */
 #define SDH_BLOCK_SIZE   512ul
 
+/* Build with SDH_DISABLE_MMC to leave out MMC/eMMC support; such cards then fail SDH_Init(). */
+#if defined(SDH_DISABLE_MMC)
+#define SDH_IS_MMC(pSD)  (0)
+#else
+#define SDH_IS_MMC(pSD)  (((pSD)->CardType == SDH_TYPE_MMC) || ((pSD)->CardType == SDH_TYPE_EMMC))
+#endif
+
 /** @cond HIDDEN_SYMBOLS */
 
 /* global variables */
@@ -604,6 +611,7 @@ uint32_t SDH_Init(SDH_T *sdh)
         }
 
         i = SDH_SDCmdAndRsp(sdh, 55ul, 0x00ul, u32CmdTimeOut);
+#if !defined(SDH_DISABLE_MMC)
         if (i == 2ul)     /* MMC memory */
         {
 
@@ -648,7 +656,9 @@ uint32_t SDH_Init(SDH_T *sdh)
                 return SDH_ERR_DEVICE;
             }
         }
-        else if (i == 0ul)     /* SD Memory */
+        else
+#endif
+        if (i == 0ul)     /* SD Memory */
         {
             pSD->R3Flag = 1ul;
             SDH_SDCmdAndRsp(sdh, 41ul, 0x00ff8000ul, u32CmdTimeOut); /* 3.0v-3.4v */
@@ -678,7 +688,7 @@ uint32_t SDH_Init(SDH_T *sdh)
     if (pSD->CardType != SDH_TYPE_UNKNOWN)
     {
         SDH_SDCmdAndRsp2(sdh, 2ul, 0x00ul, CIDBuffer);
-        if ((pSD->CardType == SDH_TYPE_MMC) || (pSD->CardType == SDH_TYPE_EMMC))
+        if (SDH_IS_MMC(pSD))
         {
             if ((status = SDH_SDCmdAndRsp(sdh, 3ul, 0x10000ul, 0ul)) != Successful)     /* set RCA */
             {
@@ -863,7 +873,7 @@ uint32_t SDH_SelectCardType(SDH_T *sdh)
 
         sdh->CTL |= SDH_CTL_DBW_Msk;
     }
-    else if ((pSD->CardType == SDH_TYPE_MMC) ||(pSD->CardType == SDH_TYPE_EMMC))
+    else if (SDH_IS_MMC(pSD))
     {
 
         if(pSD->CardType == SDH_TYPE_MMC)
@@ -928,7 +938,7 @@ void SDH_Get_SD_info(SDH_T *sdh)
 
     SDH_SDCmdAndRsp2(sdh, 9ul, pSD->RCA, Buffer);
 
-    if ((pSD->CardType == SDH_TYPE_MMC) || (pSD->CardType == SDH_TYPE_EMMC))
+    if (SDH_IS_MMC(pSD))
     {
         /* for MMC/eMMC card */
         if ((Buffer[0] & 0xc0000000) == 0xc0000000)
@@ -1201,6 +1211,7 @@ uint32_t SDH_Read(SDH_T *sdh, uint8_t *pu8BufAddr, uint32_t u32StartSec, uint32_
         }
 
         u32TimeOutCount = SDH_TIMEOUT_CNT;
+        NVT_WAIT_BEGIN(WAIT_SITE_SDH);
         while(!pSD->DataReadyFlag)
         {
             if(pSD->DataReadyFlag)
@@ -1209,6 +1220,7 @@ uint32_t SDH_Read(SDH_T *sdh, uint8_t *pu8BufAddr, uint32_t u32StartSec, uint32_
             }
             if (pSD->IsCardInsert == FALSE)
             {
+                NVT_WAIT_END(WAIT_SITE_SDH);
                 return SDH_NO_SD_CARD;
             }
             if(--u32TimeOutCount == 0)
@@ -1217,6 +1229,7 @@ uint32_t SDH_Read(SDH_T *sdh, uint8_t *pu8BufAddr, uint32_t u32StartSec, uint32_
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_SDH);
 
         if ((sdh->INTSTS & SDH_INTSTS_CRC7_Msk) != SDH_INTSTS_CRC7_Msk)      /* check CRC7 */
         {
@@ -1248,10 +1261,12 @@ uint32_t SDH_Read(SDH_T *sdh, uint8_t *pu8BufAddr, uint32_t u32StartSec, uint32_
         }
 
         u32TimeOutCount = SDH_TIMEOUT_CNT;
+        NVT_WAIT_BEGIN(WAIT_SITE_SDH);
         while(!pSD->DataReadyFlag)
         {
             if (pSD->IsCardInsert == FALSE)
             {
+                NVT_WAIT_END(WAIT_SITE_SDH);
                 return SDH_NO_SD_CARD;
             }
             if(--u32TimeOutCount == 0)
@@ -1260,6 +1275,7 @@ uint32_t SDH_Read(SDH_T *sdh, uint8_t *pu8BufAddr, uint32_t u32StartSec, uint32_
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_SDH);
 
         if ((sdh->INTSTS & SDH_INTSTS_CRC7_Msk) != SDH_INTSTS_CRC7_Msk)      /* check CRC7 */
         {
@@ -1370,10 +1386,12 @@ uint32_t SDH_Write(SDH_T *sdh, uint8_t *pu8BufAddr, uint32_t u32StartSec, uint32
         }
 
         u32TimeOutCount = SDH_TIMEOUT_CNT;
+        NVT_WAIT_BEGIN(WAIT_SITE_SDH);
         while(!pSD->DataReadyFlag)
         {
             if (pSD->IsCardInsert == FALSE)
             {
+                NVT_WAIT_END(WAIT_SITE_SDH);
                 return SDH_NO_SD_CARD;
             }
             if(--u32TimeOutCount == 0)
@@ -1382,6 +1400,7 @@ uint32_t SDH_Write(SDH_T *sdh, uint8_t *pu8BufAddr, uint32_t u32StartSec, uint32
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_SDH);
 
         if ((sdh->INTSTS & SDH_INTSTS_CRCIF_Msk) != 0ul)
         {
@@ -1406,10 +1425,12 @@ uint32_t SDH_Write(SDH_T *sdh, uint8_t *pu8BufAddr, uint32_t u32StartSec, uint32
         }
 
         u32TimeOutCount = SDH_TIMEOUT_CNT;
+        NVT_WAIT_BEGIN(WAIT_SITE_SDH);
         while(!pSD->DataReadyFlag)
         {
             if (pSD->IsCardInsert == FALSE)
             {
+                NVT_WAIT_END(WAIT_SITE_SDH);
                 return SDH_NO_SD_CARD;
             }
             if(--u32TimeOutCount == 0)
@@ -1418,6 +1439,7 @@ uint32_t SDH_Write(SDH_T *sdh, uint8_t *pu8BufAddr, uint32_t u32StartSec, uint32
                 break;
             }
         }
+        NVT_WAIT_END(WAIT_SITE_SDH);
 
         if ((sdh->INTSTS & SDH_INTSTS_CRCIF_Msk) != 0ul)
         {
@@ -1448,6 +1470,30 @@ uint32_t SDH_Write(SDH_T *sdh, uint8_t *pu8BufAddr, uint32_t u32StartSec, uint32
     return Successful;
 }
 
+/**
+ *  @brief  Write sectors to SD card, step function of \ref WDT_RunLongOp.
+ *
+ *  @param[in]    pvCtx         Pointer to a \ref S_SDH_WRITE_STEP_T.
+ *  @param[in]    u32Offset     Index of the first sector of this chunk.
+ *  @param[in]    u32Count      Number of sectors of this chunk.
+ *
+ *  @return   0 on success, -1 if \ref SDH_Write failed.
+ *
+ *  @details  Splits a large write into \ref SDH_Write calls of u32Count sectors,
+ *            u32Total of the operation is the number of sectors.
+ */
+int32_t SDH_WriteStep(void *pvCtx, uint32_t u32Offset, uint32_t u32Count)
+{
+    S_SDH_WRITE_STEP_T *psWrite = (S_SDH_WRITE_STEP_T *)pvCtx;
+
+    if (SDH_Write(psWrite->sdh, psWrite->pu8BufAddr + u32Offset * 512ul,
+                  psWrite->u32StartSec + u32Offset, u32Count) != Successful)
+    {
+        return -1;
+    }
+    return 0;
+}
+
 /*@}*/ /* end of group SDH_EXPORTED_FUNCTIONS */
 
 /*@}*/ /* end of group SDH_Driver */
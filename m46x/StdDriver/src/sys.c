@@ -310,6 +310,81 @@ void SYS_SetVRef(uint32_t u32VRefCTL)
     SYS->VREFCTL = (SYS->VREFCTL & (~SYS_VREFCTL_VREFCTL_Msk)) | (u32VRefCTL);
 }
 
+/**
+  * @brief      Apply a list of pin-mux settings
+  * @param[in]  au32Pinmux  Array of NVT_PINMUX values from the pinctrl header.
+  * @param[in]  u32Count    Number of entries in au32Pinmux.
+  * @return     Number of GPx_MFPn registers written.
+  * @details    Settings are merged per GPx_MFPn register, so each register is written once no matter how many
+  *             of its pins are listed. A register whose four pins are all listed is written without being read.
+  *             When a pin appears more than once, the last setting wins.
+  */
+uint32_t SYS_ApplyPinmux(const uint32_t au32Pinmux[], uint32_t u32Count)
+{
+    uint32_t au32Mask[SYS_MFP_REG_NUM], au32Value[SYS_MFP_REG_NUM];
+    uint32_t au32Used[(SYS_MFP_REG_NUM + 31UL) / 32UL] = {0UL};
+    S_SYS_MFP_CFG_T sCfg;
+    uint32_t i, u32Reg, u32Shift, u32Written = 0UL;
+
+    for(i = 0UL; i < u32Count; i++)
+    {
+        u32Reg = (SYS_PINMUX_PORT(au32Pinmux[i]) * 4UL) + (SYS_PINMUX_PIN(au32Pinmux[i]) / 4UL);
+        if(u32Reg >= SYS_MFP_REG_NUM)
+            continue;
+
+        u32Shift = (SYS_PINMUX_PIN(au32Pinmux[i]) % 4UL) * 8UL;
+        if((au32Used[u32Reg / 32UL] & (1UL << (u32Reg % 32UL))) == 0UL)
+        {
+            au32Used[u32Reg / 32UL] |= (1UL << (u32Reg % 32UL));
+            au32Mask[u32Reg] = 0UL;
+            au32Value[u32Reg] = 0UL;
+        }
+        au32Mask[u32Reg] |= (SYS_MFP_FIELD_Msk << u32Shift);
+        au32Value[u32Reg] = (au32Value[u32Reg] & ~(SYS_MFP_FIELD_Msk << u32Shift)) | (SYS_PINMUX_MFP(au32Pinmux[i]) << u32Shift);
+    }
+
+    for(u32Reg = 0UL; u32Reg < SYS_MFP_REG_NUM; u32Reg++)
+    {
+        if(au32Used[u32Reg / 32UL] & (1UL << (u32Reg % 32UL)))
+        {
+            sCfg.u32Reg = u32Reg;
+            sCfg.u32Mask = au32Mask[u32Reg];
+            sCfg.u32Value = au32Value[u32Reg];
+            SYS_ApplyMfpTable(&sCfg, 1UL);
+            u32Written++;
+        }
+    }
+
+    return u32Written;
+}
+
+/**
+  * @brief      Apply a merged pin-mux table
+  * @param[in]  asCfg       Array of merged register settings, e.g. generated by scripts/gen_pinmux_table.py.
+  * @param[in]  u32Count    Number of entries in asCfg.
+  * @return     None
+  * @details    Each entry is one GPx_MFPn register write. A read-modify-write is only used when the entry does
+  *             not cover all four pins of the register.
+  */
+void SYS_ApplyMfpTable(const S_SYS_MFP_CFG_T asCfg[], uint32_t u32Count)
+{
+    volatile uint32_t *pu32Mfp = &SYS->GPA_MFP0;
+    uint32_t i;
+
+    for(i = 0UL; i < u32Count; i++)
+    {
+        if(asCfg[i].u32Reg >= SYS_MFP_REG_NUM)
+            continue;
+
+        if(asCfg[i].u32Mask == 0x1F1F1F1FUL)
+            pu32Mfp[asCfg[i].u32Reg] = asCfg[i].u32Value;
+        else
+            pu32Mfp[asCfg[i].u32Reg] = (pu32Mfp[asCfg[i].u32Reg] & ~asCfg[i].u32Mask) | (asCfg[i].u32Value & asCfg[i].u32Mask);
+    }
+}
+
+
+
 /*@}*/ /* end of group SYS_EXPORTED_FUNCTIONS */
 
 /*@}*/ /* end of group SYS_Driver */
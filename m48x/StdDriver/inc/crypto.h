@@ -89,6 +89,35 @@ extern "C"
 #define CRYPTO_DMA_CONTINUE     0x6UL   /*!< Do continuous encrypt/decrypt in DMA cascade \hideinitializer */
 #define CRYPTO_DMA_LAST         0x7UL   /*!< Do last encrypt/decrypt in DMA cascade          \hideinitializer */
 
+#define CRPT_JOB_AES            0UL     /*!< Job runs on the AES engine              \hideinitializer */
+#define CRPT_JOB_SHA            1UL     /*!< Job runs on the SHA/HMAC engine         \hideinitializer */
+#define CRPT_JOB_TDES           2UL     /*!< Job runs on the TDES engine             \hideinitializer */
+#define CRPT_JOB_ENGINE_NUM     3UL     /*!< Engines of the job scheduler            \hideinitializer */
+#ifndef CRPT_JOB_OVERTAKE_MAX
+#define CRPT_JOB_OVERTAKE_MAX   4UL     /*!< Higher priority jobs that may start before a waiting job \hideinitializer */
+#endif
+#define CRPT_JOB_TIMEOUT        SystemCoreClock   /*!< Polls of \ref CRPT_JobWait before it gives up \hideinitializer */
+
+#define CRPT_JOB_OK             0L      /*!< Job finished                            \hideinitializer */
+#define CRPT_JOB_QUEUED         1L      /*!< Job waits for its engine                \hideinitializer */
+#define CRPT_JOB_RUNNING        2L      /*!< Job runs on its engine                  \hideinitializer */
+#define CRPT_JOB_ERR_ENGINE     (-1L)   /*!< Engine reported an error                \hideinitializer */
+#define CRPT_JOB_ERR_PARAM      (-2L)   /*!< Invalid job                             \hideinitializer */
+#define CRPT_JOB_ERR_BUSY       (-3L)   /*!< Job is queued or running                \hideinitializer */
+#define CRPT_JOB_ERR_TIMEOUT    (-4L)   /*!< Job did not finish in time              \hideinitializer */
+#define CRPT_JOB_ERR_CANCEL     (-5L)   /*!< Job was removed from its queue          \hideinitializer */
+
+#define ECC_CURVE_GROUP_P       0x01UL  /*!< ECC curves P-192 to P-521               \hideinitializer */
+#define ECC_CURVE_GROUP_B       0x02UL  /*!< ECC curves B-163 to B-571               \hideinitializer */
+#define ECC_CURVE_GROUP_K       0x04UL  /*!< ECC curves K-163 to K-571               \hideinitializer */
+#define ECC_CURVE_GROUP_KO      0x08UL  /*!< ECC Koblitz curves KO-192 to KO-256     \hideinitializer */
+#define ECC_CURVE_GROUP_BP      0x10UL  /*!< ECC Brainpool curves BP-256 to BP-512   \hideinitializer */
+#define ECC_CURVE_GROUP_ALL     0x1FUL  /*!< All ECC curves                          \hideinitializer */
+
+#ifndef ECC_CURVE_GROUPS
+#define ECC_CURVE_GROUPS        ECC_CURVE_GROUP_ALL /*!< ECC curve groups built into the driver, other curves return an error \hideinitializer */
+#endif
+
 typedef enum
 {
     /*!< ECC curve                \hideinitializer */
@@ -120,6 +149,42 @@ E_ECC_CURVE;                            /*!< ECC curve                \hideiniti
 
 /*@}*/ /* end of group CRYPTO_EXPORTED_CONSTANTS */
 
+/** @addtogroup CRYPTO_EXPORTED_STRUCTS CRYPTO Exported Structs
+  @{
+*/
+
+/**
+  * @details    AES key context of a session, see AES_CtxLoad
+  */
+typedef struct
+{
+    uint32_t au32Key[8];                /*!< Key words, as for AES_SetKey */
+    uint32_t u32KeySize;                /*!< AES_KEY_SIZE_128, AES_KEY_SIZE_192 or AES_KEY_SIZE_256 */
+    uint32_t u32KeyGen;                 /*!< Driver private, changes whenever the key changes */
+} S_AES_CTX_T;
+
+typedef struct S_CRPT_JOB S_CRPT_JOB_T;     /*!< Job of the crypto job scheduler */
+
+typedef void (*CRPT_JOB_START_FUNC)(CRPT_T *crpt, S_CRPT_JOB_T *psJob);                  /*!< Programs and starts the engine of the job */
+typedef void (*CRPT_JOB_DONE_FUNC)(CRPT_T *crpt, S_CRPT_JOB_T *psJob, int32_t i32Status); /*!< Called from the interrupt when the job finished */
+
+/**
+  * @details    Job of the crypto job scheduler, owned by the caller until it finished
+  */
+struct S_CRPT_JOB
+{
+    uint32_t u32Engine;                 /*!< CRPT_JOB_AES, CRPT_JOB_SHA, ... */
+    uint32_t u32Priority;               /*!< Higher runs first, FIFO among equal priorities */
+    CRPT_JOB_START_FUNC pfnStart;       /*!< e.g. AES_Open, AES_SetKey, AES_SetDMATransfer and AES_Start */
+    CRPT_JOB_DONE_FUNC  pfnDone;        /*!< e.g. SHA_Read, NULL if not used */
+    void *pvUser;                       /*!< Caller data, not used by the scheduler */
+    volatile int32_t i32Status;         /*!< CRPT_JOB_QUEUED, CRPT_JOB_RUNNING, CRPT_JOB_OK or an error */
+    uint32_t u32Overtaken;              /*!< Scheduler private */
+    S_CRPT_JOB_T *psNext;               /*!< Scheduler private */
+};
+
+/*@}*/ /* end of group CRYPTO_EXPORTED_STRUCTS */
+
 
 /** @addtogroup M480_CRYPTO_EXPORTED_MACROS CRYPTO Exported Macros
   @{
@@ -360,6 +425,15 @@ int32_t  ECC_Mutiply(CRPT_T *crpt, E_ECC_CURVE ecc_curve, char x1[], char y1[],
 int32_t  ECC_GenerateSecretZ(CRPT_T *crpt, E_ECC_CURVE ecc_curve, char *private_k, char public_k1[], char public_k2[], char secret_z[]);
 int32_t  ECC_GenerateSignature(CRPT_T *crpt, E_ECC_CURVE ecc_curve, char *message, char *d, char *k, char *R, char *S);
 int32_t  ECC_VerifySignature(CRPT_T *crpt, E_ECC_CURVE ecc_curve, char *message, char *public_k1, char *public_k2, char *R, char *S);
+void AES_CtxSetKey(S_AES_CTX_T *psCtx, uint32_t au32Keys[], uint32_t u32KeySize);
+void AES_CtxLoad(CRPT_T *crpt, uint32_t u32Channel, S_AES_CTX_T *psCtx, uint32_t au32IV[]);
+void AES_CtxInvalidate(S_AES_CTX_T *psCtx);
+void AES_InvalidateKeyCache(CRPT_T *crpt);
+void CRPT_JobInit(CRPT_T *crpt);
+int32_t CRPT_JobSubmit(CRPT_T *crpt, S_CRPT_JOB_T *psJob);
+int32_t CRPT_JobCancel(CRPT_T *crpt, S_CRPT_JOB_T *psJob);
+int32_t CRPT_JobWait(CRPT_T *crpt, S_CRPT_JOB_T *psJob);
+void CRPT_JobIRQHandler(CRPT_T *crpt);
 
 
 /*@}*/ /* end of group CRYPTO_EXPORTED_FUNCTIONS */
@@ -171,7 +171,9 @@ __STATIC_INLINE uint32_t FMC_ReadCID(void)
 #if ISBEN
     __ISB();
 #endif                                           /* To make sure ISP/CPU be Synchronized */
+    NVT_WAIT_BEGIN(WAIT_SITE_FMC_READ);
     while(FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk) {} /* Waiting for ISP Done */
+    NVT_WAIT_END(WAIT_SITE_FMC_READ);
 
     return FMC->ISPDAT;
 }
@@ -190,7 +192,9 @@ __STATIC_INLINE uint32_t FMC_ReadPID(void)
 #if ISBEN
     __ISB();
 #endif                                          /* To make sure ISP/CPU be Synchronized */
+    NVT_WAIT_BEGIN(WAIT_SITE_FMC_READ);
     while(FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk) {} /* Waiting for ISP Done */
+    NVT_WAIT_END(WAIT_SITE_FMC_READ);
 
     return FMC->ISPDAT;
 }
@@ -229,7 +233,9 @@ __STATIC_INLINE uint32_t FMC_ReadUCID(uint32_t u32Index)
 #if ISBEN
     __ISB();
 #endif                                            /* To make sure ISP/CPU be Synchronized */
+    NVT_WAIT_BEGIN(WAIT_SITE_FMC_READ);
     while(FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk) {}  /* Waiting for ISP Done */
+    NVT_WAIT_END(WAIT_SITE_FMC_READ);
 
     return FMC->ISPDAT;
 }
@@ -264,6 +270,7 @@ extern int32_t  FMC_Erase(uint32_t u32PageAddr);
 extern int32_t  FMC_Erase_SPROM(void);
 extern int32_t  FMC_Erase_Block(uint32_t u32BlockAddr);
 extern int32_t  FMC_Erase_Bank(uint32_t u32BankAddr);
+extern int32_t  FMC_EraseStep(void *pvCtx, uint32_t u32Offset, uint32_t u32Count);
 extern int32_t  FMC_EraseXOM(uint32_t xom_num);
 extern int32_t  FMC_GetXOMState(uint32_t xom_num);
 extern int32_t  FMC_GetBootSource(void);
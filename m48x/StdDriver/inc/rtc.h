@@ -68,6 +68,7 @@ extern "C"
 /*---------------------------------------------------------------------------------------------------------*/
 #define RTC_WAIT_COUNT          0xFFFFFFFFUL      /*!< Initial Time-out Value \hideinitializer */
 #define RTC_YEAR2000            2000UL            /*!< RTC Reference for compute year data \hideinitializer */
+#define RTC_EPOCH_YEAR2000      946684800UL       /*!< Seconds from 1970-01-01 to 2000-01-01 00:00:00 \hideinitializer */
 #define RTC_FCR_REFERENCE       32761UL           /*!< RTC Reference for frequency compensation \hideinitializer */
 
 
@@ -213,6 +214,26 @@ typedef struct
   */
 #define RTC_GET_TICK_INT_FLAG()         ((RTC->INTSTS & RTC_INTSTS_TICKIF_Msk)? 1:0)
 
+/**
+  * @brief      Get Seconds of RTC Timestamp
+  *
+  * @param[in]  u64Ts   Timestamp returned by \ref RTC_GetTimestamp
+  *
+  * @return     Seconds since 1970-01-01 00:00:00
+  * \hideinitializer
+  */
+#define RTC_TS_SEC(u64Ts)               ((uint32_t)((u64Ts) >> 32))
+
+/**
+  * @brief      Get Sub-second of RTC Timestamp
+  *
+  * @param[in]  u64Ts   Timestamp returned by \ref RTC_GetTimestamp
+  *
+  * @return     Sub-second part in units of 2^-32 second
+  * \hideinitializer
+  */
+#define RTC_TS_FRAC(u64Ts)              ((uint32_t)(u64Ts))
+
 /**
   * @brief      Get RTC Tamper Interrupt Flag
   *
@@ -306,6 +327,12 @@ void RTC_Open(S_RTC_TIME_DATA_T *sPt);
 void RTC_Close(void);
 void RTC_32KCalibration(int32_t i32FrequencyX10000);
 void RTC_GetDateAndTime(S_RTC_TIME_DATA_T *sPt);
+void RTC_TimestampInit(uint32_t u32TickSelection);
+void RTC_TimestampSync(void);
+void RTC_TimestampTickHandler(void);
+uint64_t RTC_GetTimestamp(void);
+uint32_t RTC_DateAndTimeToEpoch(S_RTC_TIME_DATA_T *sPt);
+void RTC_EpochToDateAndTime(uint32_t u32Epoch, S_RTC_TIME_DATA_T *sPt);
 void RTC_GetAlarmDateAndTime(S_RTC_TIME_DATA_T *sPt);
 void RTC_SetDateAndTime(S_RTC_TIME_DATA_T *sPt);
 void RTC_SetAlarmDateAndTime(S_RTC_TIME_DATA_T *sPt);
@@ -82,6 +82,16 @@ typedef struct SDH_info_t
     int             sectorSize;     /*!< Sector size in bytes */
 } SDH_INFO_T;                       /*!< Structure holds SD card info */
 
+/**
+  * @brief  Multi-sector write run by \ref WDT_RunLongOp with \ref SDH_WriteStep
+  */
+typedef struct
+{
+    SDH_T   *sdh;                   /*!< SDH0 or SDH1 */
+    uint8_t *pu8BufAddr;            /*!< Data of the first sector, word aligned */
+    uint32_t u32StartSec;           /*!< First sector of the operation */
+} S_SDH_WRITE_STEP_T;
+
 /*@}*/ /* end of group SDH_EXPORTED_TYPEDEF */
 
 /** @cond HIDDEN_SYMBOLS */
@@ -181,6 +191,7 @@ void SDH_Open(SDH_T *sdh, uint32_t u32CardDetSrc);
 uint32_t SDH_Probe(SDH_T *sdh);
 uint32_t SDH_Read(SDH_T *sdh, uint8_t *pu8BufAddr, uint32_t u32StartSec, uint32_t u32SecCount);
 uint32_t SDH_Write(SDH_T *sdh, uint8_t *pu8BufAddr, uint32_t u32StartSec, uint32_t u32SecCount);
+int32_t SDH_WriteStep(void *pvCtx, uint32_t u32Offset, uint32_t u32Count);
 
 uint32_t SDH_CardDetection(SDH_T *sdh);
 void SDH_Open_Disk(SDH_T *sdh, uint32_t u32CardDetSrc);
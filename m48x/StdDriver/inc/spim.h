@@ -64,6 +64,17 @@ extern "C"
 #define CMD_DMA_NORMAL_QUAD_READ        (0xE7UL << SPIM_CTL0_CMDCODE_Pos)       /*!< SPIM_CTL0: Fast Read Quad I/O (Page Read Mode Use) \hideinitializer */
 #define CMD_DMA_FAST_QUAD_READ          (0xEBUL << SPIM_CTL0_CMDCODE_Pos)       /*!< SPIM_CTL0: Fast Read Quad I/O (Page Read Mode Use) \hideinitializer */
 
+#define SPIM_VENDOR_WINBOND             (0x01UL)    /*!< Winbond flash support \hideinitializer */
+#define SPIM_VENDOR_MXIC                (0x02UL)    /*!< MXIC flash support \hideinitializer */
+#define SPIM_VENDOR_EON                 (0x04UL)    /*!< EON flash support \hideinitializer */
+#define SPIM_VENDOR_ISSI                (0x08UL)    /*!< ISSI flash support \hideinitializer */
+#define SPIM_VENDOR_SPANSION            (0x10UL)    /*!< Spansion flash support \hideinitializer */
+#define SPIM_VENDOR_ALL                 (0x1FUL)    /*!< All supported flash vendors \hideinitializer */
+
+#ifndef SPIM_FLASH_VENDORS
+#define SPIM_FLASH_VENDORS              SPIM_VENDOR_ALL     /*!< Flash vendors built into the driver, others fail SPIM_InitFlash() \hideinitializer */
+#endif
+
 /** @cond HIDDEN_SYMBOLS */
 
 typedef enum
@@ -356,7 +367,9 @@ E_MFGID;
  */
 #define SPIM_WAIT_FREE()   \
     do {    \
+        NVT_WAIT_BEGIN(WAIT_SITE_SPIM);    \
         while (SPIM->CTL1 & SPIM_CTL1_SPIMEN_Msk) { }   \
+        NVT_WAIT_END(WAIT_SITE_SPIM);  \
     } while (0)
 
 /**
@@ -7,6 +7,7 @@
  * @copyright (C) 2016-2020 Nuvoton Technology Corp. All rights reserved.
 *****************************************************************************/
 #include "NuMicro.h"
+#include "can.h"     /* not included by M480.h */
 
 /** @addtogroup Standard_Driver Standard Driver
   @{
@@ -1073,14 +1074,14 @@ void CAN_DisableInt(CAN_T *tCAN, uint32_t u32Mask)
   */
 int32_t CAN_SetRxMsg(CAN_T *tCAN, uint32_t u32MsgNum, uint32_t u32IDType, uint32_t u32ID)
 {
-    int32_t rev = (int32_t)TRUE;
+    int32_t rev = 1l;
     uint32_t u32TimeOutCount = 0ul;
 
-    while(CAN_SetRxMsgObj(tCAN, (uint8_t)u32MsgNum, (uint8_t)u32IDType, u32ID, (uint8_t)TRUE) == (int32_t)FALSE)
+    while(CAN_SetRxMsgObj(tCAN, (uint8_t)u32MsgNum, (uint8_t)u32IDType, u32ID, (uint8_t)1u) == 0l)
     {
         if(++u32TimeOutCount >= RETRY_COUNTS)
         {
-            rev = (int32_t)(FALSE); /* return FALSE */
+            rev = 0l; /* return FALSE */
             break;
         }
         else
@@ -1110,14 +1111,14 @@ int32_t CAN_SetRxMsg(CAN_T *tCAN, uint32_t u32MsgNum, uint32_t u32IDType, uint32
   */
 int32_t CAN_SetRxMsgAndMsk(CAN_T *tCAN, uint32_t u32MsgNum, uint32_t u32IDType, uint32_t u32ID, uint32_t u32IDMask)
 {
-    int32_t  rev = (int32_t)TRUE;
+    int32_t  rev = 1l;
     uint32_t u32TimeOutCount = 0ul;
 
-    while(CAN_SetRxMsgObjAndMsk(tCAN, (uint8_t)u32MsgNum, (uint8_t)u32IDType, u32ID, u32IDMask, (uint8_t)TRUE) == (int32_t)FALSE)
+    while(CAN_SetRxMsgObjAndMsk(tCAN, (uint8_t)u32MsgNum, (uint8_t)u32IDType, u32ID, u32IDMask, (uint8_t)1u) == 0l)
     {
         if(++u32TimeOutCount >= RETRY_COUNTS)
         {
-            rev = (int32_t)FALSE;
+            rev = 0l;
             break;
         }
         else
@@ -1147,7 +1148,7 @@ int32_t CAN_SetRxMsgAndMsk(CAN_T *tCAN, uint32_t u32MsgNum, uint32_t u32IDType,
   */
 int32_t CAN_SetMultiRxMsg(CAN_T *tCAN, uint32_t u32MsgNum, uint32_t u32MsgCount, uint32_t u32IDType, uint32_t u32ID)
 {
-    int32_t  rev = (int32_t)TRUE;
+    int32_t  rev = 1l;
     uint32_t i = 0ul;
     uint32_t u32TimeOutCount;
     uint32_t u32EOB_Flag = 0ul;
@@ -1166,11 +1167,11 @@ int32_t CAN_SetMultiRxMsg(CAN_T *tCAN, uint32_t u32MsgNum, uint32_t u32MsgCount,
         {
         }
 
-        while(CAN_SetRxMsgObj(tCAN, (uint8_t)u32MsgNum, (uint8_t)u32IDType, u32ID, (uint8_t)u32EOB_Flag) == (int32_t)FALSE)
+        while(CAN_SetRxMsgObj(tCAN, (uint8_t)u32MsgNum, (uint8_t)u32IDType, u32ID, (uint8_t)u32EOB_Flag) == 0l)
         {
             if(++u32TimeOutCount >= RETRY_COUNTS)
             {
-                rev = (int32_t)FALSE;
+                rev = 0l;
                 break;
             }
             else
@@ -1198,7 +1199,7 @@ int32_t CAN_SetMultiRxMsg(CAN_T *tCAN, uint32_t u32MsgNum, uint32_t u32MsgCount,
   */
 int32_t CAN_Transmit(CAN_T *tCAN, uint32_t u32MsgNum, STR_CANMSG_T* pCanMsg)
 {
-    int32_t rev = (int32_t)TRUE;
+    int32_t rev = 1l;
     uint32_t u32Tmp;
 
     u32Tmp = (tCAN->TEST & CAN_TEST_BASIC_Msk);
@@ -1209,9 +1210,9 @@ int32_t CAN_Transmit(CAN_T *tCAN, uint32_t u32MsgNum, STR_CANMSG_T* pCanMsg)
     }
     else
     {
-        if(CAN_SetTxMsg(tCAN, u32MsgNum, pCanMsg) == FALSE)
+        if(CAN_SetTxMsg(tCAN, u32MsgNum, pCanMsg) == 0l)
         {
-            rev = (int32_t)FALSE;
+            rev = 0l;
         }
         else
         {
@@ -1237,7 +1238,7 @@ int32_t CAN_Transmit(CAN_T *tCAN, uint32_t u32MsgNum, STR_CANMSG_T* pCanMsg)
   */
 int32_t CAN_Receive(CAN_T *tCAN, uint32_t u32MsgNum, STR_CANMSG_T* pCanMsg)
 {
-    int32_t rev = (int32_t)TRUE;
+    int32_t rev = 1l;
     uint32_t u32Tmp;
 
     u32Tmp = (tCAN->TEST & CAN_TEST_BASIC_Msk);
@@ -1248,7 +1249,7 @@ int32_t CAN_Receive(CAN_T *tCAN, uint32_t u32MsgNum, STR_CANMSG_T* pCanMsg)
     }
     else
     {
-        rev = CAN_ReadMsgObj(tCAN, (uint8_t)u32MsgNum, (uint8_t)TRUE, pCanMsg);
+        rev = CAN_ReadMsgObj(tCAN, (uint8_t)u32MsgNum, (uint8_t)1u, pCanMsg);
     }
 
     return rev;
@@ -21,6 +21,10 @@
 #define CRPT_DBGMSG(...)   do { } while (0)       /* disable debug */
 #endif
 
+#if ((ECC_CURVE_GROUPS & ECC_CURVE_GROUP_ALL) == 0)
+#error "ECC_CURVE_GROUPS must select at least one ECC curve group"
+#endif
+
 /** @endcond HIDDEN_SYMBOLS */
 
 /** @addtogroup Standard_Driver Standard Driver
@@ -41,6 +45,15 @@
 static uint32_t g_AES_CTL[4];
 static uint32_t g_TDES_CTL[4];
 
+typedef struct
+{
+    const S_AES_CTX_T *psCtx;           /* Context whose key is in the key registers, NULL if unknown */
+    uint32_t u32KeyGen;                 /* u32KeyGen of psCtx when its key was written */
+} AES_KEY_CACHE_T;
+
+static AES_KEY_CACHE_T s_asAesKeyCache[4];
+static uint32_t s_u32AesKeyGen;
+
 static char  hex_char_tbl[] = "0123456789abcdef";
 
 static void dump_ecc_reg(char *str, uint32_t volatile regs[], int32_t count);
@@ -185,6 +198,7 @@ void AES_SetKey(CRPT_T *crpt, uint32_t u32Channel, uint32_t au32Keys[], uint32_t
         outpw(key_reg_addr, au32Keys[i]);
         key_reg_addr += 4UL;
     }
+    s_asAesKeyCache[u32Channel].psCtx = NULL;
 }
 
 /**
@@ -231,6 +245,99 @@ void AES_SetDMATransfer(CRPT_T *crpt, uint32_t u32Channel, uint32_t u32SrcAddr,
     outpw(reg_addr, u32TransCnt);
 }
 
+/**
+  * @brief  Set the key of an AES context
+  * @param[in]  psCtx       AES context of a session
+  * @param[in]  au32Keys    An word array contains AES keys.
+  * @param[in]  u32KeySize is AES key size, including:
+  *         - \ref AES_KEY_SIZE_128
+  *         - \ref AES_KEY_SIZE_192
+  *         - \ref AES_KEY_SIZE_256
+  * @return None
+  * @details    Only the context is updated. The key registers are written when the context is
+  *             loaded next by \ref AES_CtxLoad.
+  */
+void AES_CtxSetKey(S_AES_CTX_T *psCtx, uint32_t au32Keys[], uint32_t u32KeySize)
+{
+    uint32_t i;
+
+    for(i = 0UL; i < (4UL + u32KeySize * 2UL); i++)
+        psCtx->au32Key[i] = au32Keys[i];
+
+    psCtx->u32KeySize = u32KeySize;
+    psCtx->u32KeyGen = ++s_u32AesKeyGen;
+}
+
+/**
+  * @brief  Load an AES context into an AES channel
+  * @param[in]  crpt        The pointer of CRYPTO module
+  * @param[in]  u32Channel  AES channel. Must be 0~3.
+  * @param[in]  psCtx       AES context set by \ref AES_CtxSetKey
+  * @param[in]  au32IV      A four entry word array contains AES initial vectors. NULL to leave the IV registers as they are.
+  * @return None
+  * @details    Replaces \ref AES_SetKey and \ref AES_SetInitVect for sessions that reuse one key for many
+  *             operations. The key is written only if another key was loaded into the channel since this
+  *             context was last loaded. The IV is written on every call that passes one, as the engine
+  *             updates the IV registers while it runs.
+  */
+void AES_CtxLoad(CRPT_T *crpt, uint32_t u32Channel, S_AES_CTX_T *psCtx, uint32_t au32IV[])
+{
+    AES_KEY_CACHE_T *psCache = &s_asAesKeyCache[u32Channel];
+    uint32_t i, key_reg_addr;
+
+    if((psCache->psCtx != psCtx) || (psCache->u32KeyGen != psCtx->u32KeyGen))
+    {
+        key_reg_addr = (uint32_t)&crpt->AES0_KEY[0] + (u32Channel * 0x3CUL);
+        for(i = 0UL; i < (4UL + psCtx->u32KeySize * 2UL); i++)
+        {
+            outpw(key_reg_addr, psCtx->au32Key[i]);
+            key_reg_addr += 4UL;
+        }
+        psCache->psCtx = psCtx;
+        psCache->u32KeyGen = psCtx->u32KeyGen;
+    }
+
+    if(au32IV == NULL)
+        return;
+
+
+    key_reg_addr = (uint32_t)&crpt->AES0_IV[0] + (u32Channel * 0x3CUL);
+    for(i = 0UL; i < 4UL; i++)
+    {
+        outpw(key_reg_addr, au32IV[i]);
+        key_reg_addr += 4UL;
+    }
+}
+
+/**
+  * @brief  Invalidate the loaded key of an AES context
+  * @param[in]  psCtx       AES context
+  * @return None
+  * @details    The next \ref AES_CtxLoad of this context writes its key again. Call it after the
+  *             context memory was changed directly.
+  */
+void AES_CtxInvalidate(S_AES_CTX_T *psCtx)
+{
+    psCtx->u32KeyGen = ++s_u32AesKeyGen;
+}
+
+/**
+  * @brief  Forget which keys are loaded in the AES channels
+  * @param[in]  crpt        The pointer of CRYPTO module
+  * @return None
+  * @details    Call it after the CRYPTO module was reset or lost its registers, so the next
+  *             \ref AES_CtxLoad writes the key again.
+  */
+void AES_InvalidateKeyCache(CRPT_T *crpt)
+{
+    uint32_t i;
+
+    (void)crpt;
+
+    for(i = 0UL; i < 4UL; i++)
+        s_asAesKeyCache[i].psCtx = NULL;
+}
+
 /**
   * @brief  Open TDES encrypt/decrypt function.
   * @param[in]  crpt         Reference to Crypto module.
@@ -504,6 +611,7 @@ typedef struct e_curve_t
 
 const ECC_CURVE _Curve[] =
 {
+#if (ECC_CURVE_GROUPS & ECC_CURVE_GROUP_P)
     {
         /* NIST: Curve P-192 : y^2=x^3-ax+b (mod p) */
         CURVE_P_192,
@@ -594,6 +702,8 @@ const ECC_CURVE _Curve[] =
         32,
         CURVE_GF_P
     },
+#endif
+#if (ECC_CURVE_GROUPS & ECC_CURVE_GROUP_B)
     {
         /* NIST: Curve B-163 : y^2+xy=x^3+ax^2+b */
         CURVE_B_163,
@@ -684,6 +794,8 @@ const ECC_CURVE _Curve[] =
         2,
         CURVE_GF_2M
     },
+#endif
+#if (ECC_CURVE_GROUPS & ECC_CURVE_GROUP_K)
     {
         /* NIST: Curve K-163 : y^2+xy=x^3+ax^2+b */
         CURVE_K_163,
@@ -774,6 +886,8 @@ const ECC_CURVE _Curve[] =
         2,
         CURVE_GF_2M
     },
+#endif
+#if (ECC_CURVE_GROUPS & ECC_CURVE_GROUP_KO)
     {
         /* Koblitz: Curve secp192k1 : y2 = x3+ax+b over Fp */
         CURVE_KO_192,
@@ -828,6 +942,8 @@ const ECC_CURVE _Curve[] =
         1,
         CURVE_GF_P
     },
+#endif
+#if (ECC_CURVE_GROUPS & ECC_CURVE_GROUP_BP)
     {
         /* Brainpool: Curve brainpoolP256r1 */
         CURVE_BP_256,
@@ -882,6 +998,7 @@ const ECC_CURVE _Curve[] =
         1,
         CURVE_GF_P
     },
+#endif
 };
 
 static ECC_CURVE  *pCurve;
@@ -890,6 +1007,8 @@ static ECC_CURVE  Curve_Copy;
 static ECC_CURVE * get_curve(E_ECC_CURVE ecc_curve);
 static int32_t ecc_init_curve(CRPT_T *crpt, E_ECC_CURVE ecc_curve);
 static void run_ecc_codec(CRPT_T *crpt, uint32_t mode);
+static void ecc_start(CRPT_T *crpt, uint32_t u32Ctl);
+static uint32_t CRPT_JobIdle(void);
 
 static char  temp_hex_str[160];
 
@@ -1136,7 +1255,7 @@ volatile uint32_t g_ECC_done, g_ECCERR_done;
   * @param[in]  crpt        Reference to Crypto module.
   * @return   none
   */
-void ECC_Complete(CRPT_T *crpt)
+NVT_FAST_CRYPTO_FUNC void ECC_Complete(CRPT_T *crpt)
 {
     if (crpt->INTSTS & CRPT_INTSTS_ECCIF_Msk)
     {
@@ -1207,7 +1326,7 @@ int ECC_IsPrivateKeyValid(CRPT_T *crpt, E_ECC_CURVE ecc_curve, char private_k[])
   * @param[out] public_k1   The output public key 1.
   * @param[out] public_k2   The output public key 2.
   * @return  0    Success.
-  * @return  -1   "ecc_curve" value is invalid.
+  * @return  -1   "ecc_curve" value is invalid, or the ECC engine did not run.
   */
 int32_t  ECC_GeneratePublicKey(CRPT_T *crpt, E_ECC_CURVE ecc_curve, char *private_k, char public_k1[], char public_k2[])
 {
@@ -1237,13 +1356,18 @@ int32_t  ECC_GeneratePublicKey(CRPT_T *crpt, E_ECC_CURVE ecc_curve, char *privat
             crpt->ECC_CTL = CRPT_ECC_CTL_FSEL_Msk;
         }
 
-        g_ECC_done = g_ECCERR_done = 0UL;
-        crpt->ECC_CTL |= ((uint32_t)pCurve->key_len << CRPT_ECC_CTL_CURVEM_Pos) |
-                         ECCOP_POINT_MUL | CRPT_ECC_CTL_START_Msk;
+        ecc_start(crpt, ((uint32_t)pCurve->key_len << CRPT_ECC_CTL_CURVEM_Pos) | ECCOP_POINT_MUL);
 
+        NVT_WAIT_BEGIN(WAIT_SITE_ECC);
         while ((g_ECC_done | g_ECCERR_done) == 0UL)
         {
         }
+        NVT_WAIT_END(WAIT_SITE_ECC);
+
+        if (g_ECCERR_done)
+        {
+            ret = -1;
+        }
 
         Reg2Hex(pCurve->Echar, crpt->ECC_X1, public_k1);
         Reg2Hex(pCurve->Echar, crpt->ECC_Y1, public_k2);
@@ -1262,7 +1386,7 @@ int32_t  ECC_GeneratePublicKey(CRPT_T *crpt, E_ECC_CURVE ecc_curve, char *privat
   * @param[out] x2          The x-coordinate of output point.
   * @param[out] y2          The y-coordinate of output point.
   * @return  0    Success.
-  * @return  -1   "ecc_curve" value is invalid.
+  * @return  -1   "ecc_curve" value is invalid, or the ECC engine did not run.
   */
 int32_t  ECC_Mutiply(CRPT_T *crpt, E_ECC_CURVE ecc_curve, char x1[], char y1[], char *k, char x2[], char y2[])
 {
@@ -1296,13 +1420,18 @@ int32_t  ECC_Mutiply(CRPT_T *crpt, E_ECC_CURVE ecc_curve, char x1[], char y1[],
             crpt->ECC_CTL = CRPT_ECC_CTL_FSEL_Msk;
         }
 
-        g_ECC_done = g_ECCERR_done = 0UL;
-        crpt->ECC_CTL |= ((uint32_t)pCurve->key_len << CRPT_ECC_CTL_CURVEM_Pos) |
-                         ECCOP_POINT_MUL | CRPT_ECC_CTL_START_Msk;
+        ecc_start(crpt, ((uint32_t)pCurve->key_len << CRPT_ECC_CTL_CURVEM_Pos) | ECCOP_POINT_MUL);
 
+        NVT_WAIT_BEGIN(WAIT_SITE_ECC);
         while ((g_ECC_done | g_ECCERR_done) == 0UL)
         {
         }
+        NVT_WAIT_END(WAIT_SITE_ECC);
+
+        if (g_ECCERR_done)
+        {
+            ret = -1;
+        }
 
         Reg2Hex(pCurve->Echar, crpt->ECC_X1, x2);
         Reg2Hex(pCurve->Echar, crpt->ECC_Y1, y2);
@@ -1320,7 +1449,7 @@ int32_t  ECC_Mutiply(CRPT_T *crpt, E_ECC_CURVE ecc_curve, char x1[], char y1[],
   * @param[in]  public_k2   The other party's publick key 2.
   * @param[out] secret_z    The ECC CDH secret Z.
   * @return  0    Success.
-  * @return  -1   "ecc_curve" value is invalid.
+  * @return  -1   "ecc_curve" value is invalid, or the ECC engine did not run.
   */
 int32_t  ECC_GenerateSecretZ(CRPT_T *crpt, E_ECC_CURVE ecc_curve, char *private_k, char public_k1[], char public_k2[], char secret_z[])
 {
@@ -1368,13 +1497,18 @@ int32_t  ECC_GenerateSecretZ(CRPT_T *crpt, E_ECC_CURVE ecc_curve, char *private_
             /*  CURVE_GF_P */
             crpt->ECC_CTL = CRPT_ECC_CTL_FSEL_Msk;
         }
-        g_ECC_done = g_ECCERR_done = 0UL;
-        crpt->ECC_CTL |= ((uint32_t)pCurve->key_len << CRPT_ECC_CTL_CURVEM_Pos) |
-                         ECCOP_POINT_MUL | CRPT_ECC_CTL_START_Msk;
+        ecc_start(crpt, ((uint32_t)pCurve->key_len << CRPT_ECC_CTL_CURVEM_Pos) | ECCOP_POINT_MUL);
 
+        NVT_WAIT_BEGIN(WAIT_SITE_ECC);
         while ((g_ECC_done | g_ECCERR_done) == 0UL)
         {
         }
+        NVT_WAIT_END(WAIT_SITE_ECC);
+
+        if (g_ECCERR_done)
+        {
+            ret = -1;
+        }
 
         Reg2Hex(pCurve->Echar, crpt->ECC_X1, secret_z);
     }
@@ -1382,6 +1516,36 @@ int32_t  ECC_GenerateSecretZ(CRPT_T *crpt, E_ECC_CURVE ecc_curve, char *private_
     return ret;
 }
 
+/* Start an ECC operation. The ECC engine only starts while no job of the job scheduler is queued or
+   running, and CRPT_JobSubmit refuses jobs until the ECC engine is done. If the scheduler does not drain
+   within CRPT_JOB_TIMEOUT polls the ECC error flag is set instead and the operation fails. */
+static void ecc_start(CRPT_T *crpt, uint32_t u32Ctl)
+{
+    uint32_t u32TimeOutCount = CRPT_JOB_TIMEOUT;
+    uint32_t u32Primask;
+
+    g_ECC_done = g_ECCERR_done = 0UL;
+
+    while (1)
+    {
+        u32Primask = __get_PRIMASK();
+        __disable_irq();
+        if (CRPT_JobIdle())
+        {
+            crpt->ECC_CTL |= u32Ctl | CRPT_ECC_CTL_START_Msk;
+            __set_PRIMASK(u32Primask);
+            return;
+        }
+        __set_PRIMASK(u32Primask);
+
+        if (--u32TimeOutCount == 0UL)
+        {
+            g_ECCERR_done = 1UL;
+            return;
+        }
+    }
+}
+
 /** @cond HIDDEN_SYMBOLS */
 
 static void run_ecc_codec(CRPT_T *crpt, uint32_t mode)
@@ -1404,8 +1568,8 @@ static void run_ecc_codec(CRPT_T *crpt, uint32_t mode)
         }
     }
 
-    g_ECC_done = g_ECCERR_done = 0UL;
-    crpt->ECC_CTL |= ((uint32_t)pCurve->key_len << CRPT_ECC_CTL_CURVEM_Pos) | mode | CRPT_ECC_CTL_START_Msk;
+    ecc_start(crpt, ((uint32_t)pCurve->key_len << CRPT_ECC_CTL_CURVEM_Pos) | mode);
+    NVT_WAIT_BEGIN(WAIT_SITE_ECC);
     while ((g_ECC_done | g_ECCERR_done) == 0UL)
     {
     }
@@ -1413,6 +1577,7 @@ static void run_ecc_codec(CRPT_T *crpt, uint32_t mode)
     while (crpt->ECC_STS & CRPT_ECC_STS_BUSY_Msk)
     {
     }
+    NVT_WAIT_END(WAIT_SITE_ECC);
 }
 /** @endcond HIDDEN_SYMBOLS */
 
@@ -1985,6 +2150,252 @@ int32_t  ECC_VerifySignature(CRPT_T *crpt, E_ECC_CURVE ecc_curve, char *message,
     return ret;
 }
 
+/** @cond HIDDEN_SYMBOLS */
+
+typedef struct
+{
+    uint32_t u32IntEn;                  /* INTEN bits of the engine */
+    uint32_t u32Done;                   /* INTSTS done flag */
+    uint32_t u32Err;                    /* INTSTS error flag */
+} CRPT_JOB_ENGINE_T;
+
+static const CRPT_JOB_ENGINE_T s_asCrptJobEngine[CRPT_JOB_ENGINE_NUM] =
+{
+    {CRPT_INTEN_AESIEN_Msk | CRPT_INTEN_AESEIEN_Msk, CRPT_INTSTS_AESIF_Msk, CRPT_INTSTS_AESEIF_Msk},
+    {CRPT_INTEN_HMACIEN_Msk | CRPT_INTEN_HMACEIEN_Msk, CRPT_INTSTS_HMACIF_Msk, CRPT_INTSTS_HMACEIF_Msk},
+    {CRPT_INTEN_TDESIEN_Msk | CRPT_INTEN_TDESEIEN_Msk, CRPT_INTSTS_TDESIF_Msk, CRPT_INTSTS_TDESEIF_Msk}
+};
+
+static S_CRPT_JOB_T *s_apsCrptJobQueue[CRPT_JOB_ENGINE_NUM];   /* Waiting jobs of each engine */
+static S_CRPT_JOB_T *s_apsCrptJobRun[CRPT_JOB_ENGINE_NUM];     /* Running job of each engine */
+
+/* No job is queued or running on any engine. Called with interrupts disabled. */
+static uint32_t CRPT_JobIdle(void)
+{
+    uint32_t i;
+
+    for(i = 0UL; i < CRPT_JOB_ENGINE_NUM; i++)
+    {
+        if((s_apsCrptJobQueue[i] != NULL) || (s_apsCrptJobRun[i] != NULL))
+            return 0UL;
+    }
+
+    return 1UL;
+}
+
+/* Start the next job of an idle engine. Called with interrupts disabled or from the IRQ handler. */
+static void CRPT_JobDispatch(CRPT_T *crpt, uint32_t u32Engine)
+{
+    const CRPT_JOB_ENGINE_T *psEng = &s_asCrptJobEngine[u32Engine];
+    S_CRPT_JOB_T *psJob = s_apsCrptJobQueue[u32Engine];
+
+    if(s_apsCrptJobRun[u32Engine] != NULL)
+        return;
+
+    if(psJob == NULL)
+    {
+        crpt->INTEN &= ~psEng->u32IntEn;
+        return;
+    }
+
+    s_apsCrptJobQueue[u32Engine] = psJob->psNext;
+    s_apsCrptJobRun[u32Engine] = psJob;
+    psJob->psNext = NULL;
+    psJob->i32Status = CRPT_JOB_RUNNING;
+
+    crpt->INTSTS = psEng->u32Done | psEng->u32Err;
+    crpt->INTEN |= psEng->u32IntEn;
+    psJob->pfnStart(crpt, psJob);
+}
+
+/** @endcond HIDDEN_SYMBOLS */
+
+/**
+  * @brief  Reset the crypto job scheduler
+  * @param[in]  crpt        The pointer of CRYPTO module
+  * @return None
+  * @details    Drops all queued and running jobs without calling their pfnDone. The CRPT IRQ handler
+  *             must call \ref CRPT_JobIRQHandler and the CRPT IRQ must be enabled in NVIC.
+  */
+void CRPT_JobInit(CRPT_T *crpt)
+{
+    uint32_t i;
+
+    for(i = 0UL; i < CRPT_JOB_ENGINE_NUM; i++)
+    {
+        crpt->INTEN &= ~s_asCrptJobEngine[i].u32IntEn;
+        s_apsCrptJobQueue[i] = NULL;
+        s_apsCrptJobRun[i] = NULL;
+    }
+}
+
+/**
+  * @brief  Queue a job on its engine
+  * @param[in]  crpt        The pointer of CRYPTO module
+  * @param[in]  psJob       Job to run. u32Engine, u32Priority, pfnStart, pfnDone and pvUser must be set, i32Status must not be CRPT_JOB_QUEUED or CRPT_JOB_RUNNING.
+  * @retval CRPT_JOB_OK         Job queued, or started if its engine was idle
+  * @retval CRPT_JOB_ERR_PARAM  Invalid job
+  * @retval CRPT_JOB_ERR_BUSY   Job is already queued or running, or an ECC operation runs
+  * @details    Each engine runs one job at a time, jobs of different engines run at the same time.
+  *             ECC operations do not run as jobs. They share the CRPT interrupt with the scheduler, so
+  *             an ECC operation waits until no job is queued or running, and no job is accepted while
+  *             it runs.
+  *             A job is queued behind jobs of the same or higher priority. It also stays behind any
+  *             job that was already overtaken \ref CRPT_JOB_OVERTAKE_MAX times, so a waiting job starts
+  *             after at most the jobs queued before it plus \ref CRPT_JOB_OVERTAKE_MAX later ones.
+  *             pfnStart runs with interrupts disabled, or from the CRPT interrupt, and must only program
+  *             and start the engine. pfnDone runs from the CRPT interrupt and may submit jobs.
+  */
+int32_t CRPT_JobSubmit(CRPT_T *crpt, S_CRPT_JOB_T *psJob)
+{
+    S_CRPT_JOB_T **ppsPos, *psIt;
+    uint32_t u32Primask;
+
+    if((psJob == NULL) || (psJob->u32Engine >= CRPT_JOB_ENGINE_NUM) || (psJob->pfnStart == NULL))
+        return CRPT_JOB_ERR_PARAM;
+
+    u32Primask = __get_PRIMASK();
+    __disable_irq();
+
+    if((psJob->i32Status == CRPT_JOB_QUEUED) || (psJob->i32Status == CRPT_JOB_RUNNING) ||
+            (crpt->ECC_STS & CRPT_ECC_STS_BUSY_Msk))
+    {
+        __set_PRIMASK(u32Primask);
+        return CRPT_JOB_ERR_BUSY;
+    }
+
+    /* Find the last job the new one may not overtake */
+    ppsPos = &s_apsCrptJobQueue[psJob->u32Engine];
+    for(psIt = *ppsPos; psIt != NULL; psIt = psIt->psNext)
+    {
+        if((psIt->u32Priority >= psJob->u32Priority) || (psIt->u32Overtaken >= CRPT_JOB_OVERTAKE_MAX))
+            ppsPos = &psIt->psNext;
+    }
+
+    for(psIt = *ppsPos; psIt != NULL; psIt = psIt->psNext)
+        psIt->u32Overtaken++;
+
+    psJob->u32Overtaken = 0UL;
+    psJob->psNext = *ppsPos;
+    psJob->i32Status = CRPT_JOB_QUEUED;
+    *ppsPos = psJob;
+
+    CRPT_JobDispatch(crpt, psJob->u32Engine);
+
+    __set_PRIMASK(u32Primask);
+
+    return CRPT_JOB_OK;
+}
+
+/**
+  * @brief  Remove a waiting job from its queue
+  * @param[in]  crpt        The pointer of CRYPTO module
+  * @param[in]  psJob       Job passed to \ref CRPT_JobSubmit
+  * @retval CRPT_JOB_OK         Job removed, its status is CRPT_JOB_ERR_CANCEL
+  * @retval CRPT_JOB_ERR_BUSY   Job is running and cannot be removed
+  * @retval CRPT_JOB_ERR_PARAM  Job is not queued
+  * @details    pfnDone is not called for a removed job.
+  */
+int32_t CRPT_JobCancel(CRPT_T *crpt, S_CRPT_JOB_T *psJob)
+{
+    S_CRPT_JOB_T **ppsPos;
+    uint32_t u32Primask;
+    int32_t i32Ret = CRPT_JOB_ERR_PARAM;
+
+    (void)crpt;
+
+    if((psJob == NULL) || (psJob->u32Engine >= CRPT_JOB_ENGINE_NUM))
+        return CRPT_JOB_ERR_PARAM;
+
+    u32Primask = __get_PRIMASK();
+    __disable_irq();
+
+    if(psJob->i32Status == CRPT_JOB_RUNNING)
+    {
+        i32Ret = CRPT_JOB_ERR_BUSY;
+    }
+    else
+    {
+        for(ppsPos = &s_apsCrptJobQueue[psJob->u32Engine]; *ppsPos != NULL; ppsPos = &(*ppsPos)->psNext)
+        {
+            if(*ppsPos == psJob)
+            {
+                *ppsPos = psJob->psNext;
+                psJob->psNext = NULL;
+                psJob->i32Status = CRPT_JOB_ERR_CANCEL;
+                i32Ret = CRPT_JOB_OK;
+                break;
+            }
+        }
+    }
+
+    __set_PRIMASK(u32Primask);
+
+    return i32Ret;
+}
+
+/**
+  * @brief  Wait for a job to finish
+  * @param[in]  crpt        The pointer of CRYPTO module
+  * @param[in]  psJob       Job passed to \ref CRPT_JobSubmit
+  * @return CRPT_JOB_OK, the error of the job, or CRPT_JOB_ERR_TIMEOUT
+  * @details    A job still waiting after \ref CRPT_JOB_TIMEOUT polls is removed from its queue.
+  *             A running job is left to its engine.
+  */
+int32_t CRPT_JobWait(CRPT_T *crpt, S_CRPT_JOB_T *psJob)
+{
+    uint32_t u32TimeOutCount = CRPT_JOB_TIMEOUT;
+
+    while((psJob->i32Status == CRPT_JOB_QUEUED) || (psJob->i32Status == CRPT_JOB_RUNNING))
+    {
+        if(--u32TimeOutCount == 0UL)
+        {
+            (void)CRPT_JobCancel(crpt, psJob);
+            return CRPT_JOB_ERR_TIMEOUT;
+        }
+    }
+
+    return psJob->i32Status;
+}
+
+/**
+  * @brief  Crypto job scheduler interrupt service
+  * @param[in]  crpt        The pointer of CRYPTO module
+  * @return None
+  * @details    Call from CRPT_IRQHandler. Finishes the running job of each engine that raised its done
+  *             or error flag, calls its pfnDone and starts the next job of that engine.
+  *             ECC flags are passed to \ref ECC_Complete, the ECC functions keep running in the caller context
+  *             and never overlap a job.
+  */
+NVT_FAST_CRYPTO_FUNC void CRPT_JobIRQHandler(CRPT_T *crpt)
+{
+    const CRPT_JOB_ENGINE_T *psEng;
+    S_CRPT_JOB_T *psJob;
+    uint32_t u32Sts = crpt->INTSTS;
+    uint32_t i;
+
+    for(i = 0UL; i < CRPT_JOB_ENGINE_NUM; i++)
+    {
+        psEng = &s_asCrptJobEngine[i];
+        psJob = s_apsCrptJobRun[i];
+
+        if((psJob == NULL) || ((u32Sts & (psEng->u32Done | psEng->u32Err)) == 0UL))
+            continue;
+
+        crpt->INTSTS = psEng->u32Done | psEng->u32Err;
+        s_apsCrptJobRun[i] = NULL;
+        psJob->i32Status = (u32Sts & psEng->u32Err) ? CRPT_JOB_ERR_ENGINE : CRPT_JOB_OK;
+
+        if(psJob->pfnDone != NULL)
+            psJob->pfnDone(crpt, psJob, psJob->i32Status);
+
+        CRPT_JobDispatch(crpt, i);
+    }
+
+    if(u32Sts & (CRPT_INTSTS_ECCIF_Msk | CRPT_INTSTS_ECCEIF_Msk))
+        ECC_Complete(crpt);
+}
+
 /*@}*/ /* end of group CRYPTO_EXPORTED_FUNCTIONS */
 
 /*@}*/ /* end of group CRYPTO_Driver */
@@ -68,7 +68,9 @@ int32_t FMC_ConfigXOM(uint32_t u32XomNum, uint32_t u32XomBase, uint8_t u8XomPage
         FMC->ISPADDR = FMC_XOM_BASE + (u32XomNum * 0x10u);
         FMC->ISPDAT = u32XomBase;
         FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
+        NVT_WAIT_BEGIN(WAIT_SITE_FMC_PROGRAM);
         while(FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk) {}
+        NVT_WAIT_END(WAIT_SITE_FMC_PROGRAM);
 
         if(FMC->ISPSTS & FMC_ISPSTS_ISPFF_Msk)
         {
@@ -83,7 +85,9 @@ int32_t FMC_ConfigXOM(uint32_t u32XomNum, uint32_t u32XomBase, uint8_t u8XomPage
         FMC->ISPADDR = FMC_XOM_BASE + (u32XomNum * 0x10u + 0x04u);
         FMC->ISPDAT = u8XomPage;
         FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
+        NVT_WAIT_BEGIN(WAIT_SITE_FMC_PROGRAM);
         while(FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk) {}
+        NVT_WAIT_END(WAIT_SITE_FMC_PROGRAM);
 
         if(FMC->ISPSTS & FMC_ISPSTS_ISPFF_Msk)
         {
@@ -98,7 +102,9 @@ int32_t FMC_ConfigXOM(uint32_t u32XomNum, uint32_t u32XomBase, uint8_t u8XomPage
         FMC->ISPADDR = FMC_XOM_BASE + (u32XomNum * 0x10u + 0x08u);
         FMC->ISPDAT = 0u;
         FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
+        NVT_WAIT_BEGIN(WAIT_SITE_FMC_PROGRAM);
         while(FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk) {}
+        NVT_WAIT_END(WAIT_SITE_FMC_PROGRAM);
 
         if(FMC->ISPSTS & FMC_ISPSTS_ISPFF_Msk)
         {
@@ -133,7 +139,9 @@ int32_t FMC_Erase(uint32_t u32PageAddr)
         FMC->ISPADDR = u32PageAddr;
         FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
 
+        NVT_WAIT_BEGIN(WAIT_SITE_FMC_ERASE);
         while (FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk) { }
+        NVT_WAIT_END(WAIT_SITE_FMC_ERASE);
 
         if (FMC->ISPCTL & FMC_ISPCTL_ISPFF_Msk)
         {
@@ -160,7 +168,9 @@ int32_t FMC_Erase_SPROM(void)
     FMC->ISPDAT = 0x0055AA03UL;
     FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
 
+    NVT_WAIT_BEGIN(WAIT_SITE_FMC_ERASE);
     while (FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk) { }
+    NVT_WAIT_END(WAIT_SITE_FMC_ERASE);
 
     if (FMC->ISPCTL & FMC_ISPCTL_ISPFF_Msk)
     {
@@ -186,7 +196,9 @@ int32_t FMC_Erase_Block(uint32_t u32BlockAddr)
     FMC->ISPADDR = u32BlockAddr;
     FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
 
+    NVT_WAIT_BEGIN(WAIT_SITE_FMC_ERASE);
     while (FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk) { }
+    NVT_WAIT_END(WAIT_SITE_FMC_ERASE);
 
     if (FMC->ISPCTL & FMC_ISPCTL_ISPFF_Msk)
     {
@@ -211,7 +223,9 @@ int32_t FMC_Erase_Bank(uint32_t u32BankAddr)
     FMC->ISPADDR = u32BankAddr;
     FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
 
+    NVT_WAIT_BEGIN(WAIT_SITE_FMC_ERASE);
     while (FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk) { }
+    NVT_WAIT_END(WAIT_SITE_FMC_ERASE);
 
     if (FMC->ISPCTL & FMC_ISPCTL_ISPFF_Msk)
     {
@@ -221,6 +235,30 @@ int32_t FMC_Erase_Bank(uint32_t u32BankAddr)
     return ret;
 }
 
+/**
+  * @brief      Erase flash pages, step function of \ref WDT_RunLongOp
+  * @param[in]  pvCtx      Pointer to a uint32_t holding the address of page 0 of the operation
+  * @param[in]  u32Offset  Index of the first page to erase
+  * @param[in]  u32Count   Number of pages to erase
+  * @return     Erase success or not.
+  * @retval     0   Success
+  * @retval     -1  Erase failed
+  * @details    Erases a region page by page so that the watchdogs can be fed between chunks,
+  *             e.g. a bank with u32Total = FMC_BANK_SIZE / FMC_FLASH_PAGE_SIZE instead of \ref FMC_Erase_Bank.
+  */
+int32_t FMC_EraseStep(void *pvCtx, uint32_t u32Offset, uint32_t u32Count)
+{
+    uint32_t u32Addr = *(uint32_t *)pvCtx + u32Offset * FMC_FLASH_PAGE_SIZE;
+
+    while(u32Count-- > 0UL)
+    {
+        if(FMC_Erase(u32Addr) != 0)
+            return -1;
+        u32Addr += FMC_FLASH_PAGE_SIZE;
+    }
+    return 0;
+}
+
 /**
   * @brief  Execute Erase XOM Region
   *
@@ -361,7 +399,9 @@ uint32_t FMC_Read(uint32_t u32Addr)
     FMC->ISPCMD = FMC_ISPCMD_READ;
     FMC->ISPADDR = u32Addr;
     FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
+    NVT_WAIT_BEGIN(WAIT_SITE_FMC_READ);
     while (FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk) { }
+    NVT_WAIT_END(WAIT_SITE_FMC_READ);
 
     return FMC->ISPDAT;
 }
@@ -385,7 +425,9 @@ int32_t FMC_Read_64(uint32_t u32addr, uint32_t * u32data0, uint32_t * u32data1)
     FMC->ISPDAT = 0x0UL;
     FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
 
+    NVT_WAIT_BEGIN(WAIT_SITE_FMC_READ);
     while (FMC->ISPSTS & FMC_ISPSTS_ISPBUSY_Msk) { }
+    NVT_WAIT_END(WAIT_SITE_FMC_READ);
 
     if (FMC->ISPSTS & FMC_ISPSTS_ISPFF_Msk)
     {
@@ -445,7 +487,9 @@ void FMC_Write(uint32_t u32Addr, uint32_t u32Data)
     FMC->ISPADDR = u32Addr;
     FMC->ISPDAT = u32Data;
     FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
+    NVT_WAIT_BEGIN(WAIT_SITE_FMC_PROGRAM);
     while (FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk) { }
+    NVT_WAIT_END(WAIT_SITE_FMC_PROGRAM);
 }
 
 /**
@@ -467,7 +511,9 @@ int32_t FMC_Write8Bytes(uint32_t u32addr, uint32_t u32data0, uint32_t u32data1)
     FMC->MPDAT1  = u32data1;
     FMC->ISPTRG  = FMC_ISPTRG_ISPGO_Msk;
 
+    NVT_WAIT_BEGIN(WAIT_SITE_FMC_PROGRAM);
     while (FMC->ISPSTS & FMC_ISPSTS_ISPBUSY_Msk) { }
+    NVT_WAIT_END(WAIT_SITE_FMC_PROGRAM);
 
     if (FMC->ISPSTS & FMC_ISPSTS_ISPFF_Msk)
     {
@@ -593,7 +639,9 @@ int32_t FMC_Write_OTP(uint32_t otp_num, uint32_t low_word, uint32_t high_word)
         FMC->ISPDAT = low_word;
         FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
 
+        NVT_WAIT_BEGIN(WAIT_SITE_FMC_PROGRAM);
         while (FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk) { }
+        NVT_WAIT_END(WAIT_SITE_FMC_PROGRAM);
 
         if (FMC->ISPSTS & FMC_ISPSTS_ISPFF_Msk)
         {
@@ -609,7 +657,9 @@ int32_t FMC_Write_OTP(uint32_t otp_num, uint32_t low_word, uint32_t high_word)
         FMC->ISPDAT = high_word;
         FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
 
+        NVT_WAIT_BEGIN(WAIT_SITE_FMC_PROGRAM);
         while (FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk) { }
+        NVT_WAIT_END(WAIT_SITE_FMC_PROGRAM);
 
         if (FMC->ISPSTS & FMC_ISPSTS_ISPFF_Msk)
         {
@@ -646,7 +696,9 @@ int32_t FMC_Read_OTP(uint32_t otp_num, uint32_t *low_word, uint32_t *high_word)
         FMC->ISPDAT = 0x0UL;
         FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
 
+        NVT_WAIT_BEGIN(WAIT_SITE_FMC_READ);
         while (FMC->ISPSTS & FMC_ISPSTS_ISPBUSY_Msk) { }
+        NVT_WAIT_END(WAIT_SITE_FMC_READ);
 
         if (FMC->ISPSTS & FMC_ISPSTS_ISPFF_Msk)
         {
@@ -685,7 +737,9 @@ int32_t FMC_Lock_OTP(uint32_t otp_num)
         FMC->ISPDAT = 0UL;
         FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
 
+        NVT_WAIT_BEGIN(WAIT_SITE_FMC_PROGRAM);
         while (FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk) { }
+        NVT_WAIT_END(WAIT_SITE_FMC_PROGRAM);
 
         if (FMC->ISPSTS & FMC_ISPSTS_ISPFF_Msk)
         {
@@ -719,7 +773,9 @@ int32_t FMC_Is_OTP_Locked(uint32_t otp_num)
         FMC->ISPADDR = FMC_OTP_BASE + 0x800UL + otp_num * 4UL;
         FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
 
+        NVT_WAIT_BEGIN(WAIT_SITE_FMC_READ);
         while (FMC->ISPTRG & FMC_ISPTRG_ISPGO_Msk) { }
+        NVT_WAIT_END(WAIT_SITE_FMC_READ);
 
         if (FMC->ISPSTS & FMC_ISPSTS_ISPFF_Msk)
         {
@@ -826,13 +882,17 @@ uint32_t  FMC_GetChkSum(uint32_t u32addr, uint32_t u32count)
         FMC->ISPDAT  = u32count;
         FMC->ISPTRG  = FMC_ISPTRG_ISPGO_Msk;
 
+        NVT_WAIT_BEGIN(WAIT_SITE_FMC_CHKSUM);
         while (FMC->ISPSTS & FMC_ISPSTS_ISPBUSY_Msk) { }
+        NVT_WAIT_END(WAIT_SITE_FMC_CHKSUM);
 
         FMC->ISPCMD = FMC_ISPCMD_READ_CKS;
         FMC->ISPADDR    = u32addr;
         FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
 
+        NVT_WAIT_BEGIN(WAIT_SITE_FMC_CHKSUM);
         while (FMC->ISPSTS & FMC_ISPSTS_ISPBUSY_Msk) { }
+        NVT_WAIT_END(WAIT_SITE_FMC_CHKSUM);
 
         ret = FMC->ISPDAT;
     }
@@ -860,14 +920,18 @@ uint32_t  FMC_CheckAllOne(uint32_t u32addr, uint32_t u32count)
     FMC->ISPDAT   = u32count;
     FMC->ISPTRG   = FMC_ISPTRG_ISPGO_Msk;
 
+    NVT_WAIT_BEGIN(WAIT_SITE_FMC_CHKSUM);
     while (FMC->ISPSTS & FMC_ISPSTS_ISPBUSY_Msk) { }
+    NVT_WAIT_END(WAIT_SITE_FMC_CHKSUM);
 
     do
     {
         FMC->ISPCMD = FMC_ISPCMD_READ_ALL1;
         FMC->ISPADDR    = u32addr;
         FMC->ISPTRG = FMC_ISPTRG_ISPGO_Msk;
+        NVT_WAIT_BEGIN(WAIT_SITE_FMC_CHKSUM);
         while (FMC->ISPSTS & FMC_ISPSTS_ISPBUSY_Msk) { }
+        NVT_WAIT_END(WAIT_SITE_FMC_CHKSUM);
     }
     while (FMC->ISPDAT == 0UL);
 
@@ -9,6 +9,7 @@
 
 
 #include <stdio.h>
+#include <stdarg.h>
 #include "NuMicro.h"
 
 #if defined ( __CC_ARM   )
@@ -76,6 +77,9 @@ static void stackDump(uint32_t stack[])
  */
 void Hard_Fault_Handler(uint32_t stack[])
 {
+#if defined(DEFERRED_PRINTF) && !defined(DISABLE_UART)
+    DebugLog_EnterPanic();
+#endif
     printf("In Hard Fault Handler\n");
 
     stackDump(stack);
@@ -429,6 +433,318 @@ Get_LR_and_Branch
 #endif
 
 #ifndef DISABLE_UART
+#if defined(DEFERRED_PRINTF)
+#if defined(NONBLOCK_PRINTF)
+#error "DEFERRED_PRINTF and NONBLOCK_PRINTF cannot be enabled at the same time"
+#endif
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Deferred printf: characters are queued in a ring and the debug port TX empty interrupt drains it        */
+/*---------------------------------------------------------------------------------------------------------*/
+#ifndef DEFERRED_PRINTF_BUF_SIZE
+#define DEFERRED_PRINTF_BUF_SIZE    1024    /* Must be a power of 2 */
+#endif
+
+static uint8_t s_au8LogBuf[DEFERRED_PRINTF_BUF_SIZE];
+static volatile uint32_t s_u32LogHead = 0;      /* Free running, advanced by writers */
+static volatile uint32_t s_u32LogTail = 0;      /* Free running, advanced by DebugLog_IRQHandler/DebugLog_Flush */
+static volatile uint32_t s_u32LogDropCnt = 0;
+static volatile uint32_t s_u32LogPanic = 0;
+
+/**
+ * @brief    Queue characters to the deferred printf ring
+ *
+ * @param[in] ptr  Characters to send
+ * @param[in] len  Number of characters
+ *
+ * @returns  len
+ *
+ * @details  '\n' is queued as "\r\n". Characters that do not fit are dropped and counted.
+ *           The interrupt mask is only held while the characters are copied, so this can be
+ *           called from thread and interrupt context.
+ */
+int DebugLog_Write(const char *ptr, int len)
+{
+    uint32_t u32Primask, u32Head, u32Need;
+    int i;
+
+    u32Primask = __get_PRIMASK();
+    __disable_irq();
+
+    u32Head = s_u32LogHead;
+
+    for(i = 0; i < len; i++)
+    {
+        u32Need = (ptr[i] == '\n') ? 2U : 1U;
+
+        if((u32Head - s_u32LogTail) + u32Need > DEFERRED_PRINTF_BUF_SIZE)
+        {
+            s_u32LogDropCnt++;
+            continue;
+        }
+
+        if(ptr[i] == '\n')
+            s_au8LogBuf[u32Head++ & (DEFERRED_PRINTF_BUF_SIZE - 1)] = '\r';
+
+        s_au8LogBuf[u32Head++ & (DEFERRED_PRINTF_BUF_SIZE - 1)] = (uint8_t)ptr[i];
+    }
+
+    s_u32LogHead = u32Head;
+
+    /* TX empty interrupt fires at once if the FIFO is already empty */
+    DEBUG_PORT->INTEN |= UART_INTEN_THREIEN_Msk;
+
+    __set_PRIMASK(u32Primask);
+
+    return len;
+}
+
+/**
+ * @brief    Drain the deferred printf ring to the debug port FIFO
+ *
+ * @param    None
+ *
+ * @returns  None
+ *
+ * @details  Call this function from the interrupt handler of DEBUG_PORT.
+ *           TX empty interrupt is disabled once the ring is empty.
+ */
+NVT_FAST_UART_FUNC void DebugLog_IRQHandler(void)
+{
+    uint32_t u32Tail = s_u32LogTail;
+    uint32_t u32Primask;
+
+    while((u32Tail != s_u32LogHead) && ((DEBUG_PORT->FIFOSTS & UART_FIFOSTS_TXFULL_Msk) == 0U))
+    {
+        DEBUG_PORT->DAT = s_au8LogBuf[u32Tail++ & (DEFERRED_PRINTF_BUF_SIZE - 1)];
+    }
+
+    s_u32LogTail = u32Tail;
+
+    if(u32Tail == s_u32LogHead)
+    {
+        /* Re-check with interrupts masked so a writer cannot slip in between */
+        u32Primask = __get_PRIMASK();
+        __disable_irq();
+
+        if(s_u32LogTail == s_u32LogHead)
+            DEBUG_PORT->INTEN &= ~UART_INTEN_THREIEN_Msk;
+
+        __set_PRIMASK(u32Primask);
+    }
+}
+
+/**
+ * @brief    Send all queued characters by polling
+ *
+ * @param    None
+ *
+ * @returns  None
+ *
+ * @details  Busy-waits on the debug port FIFO until the ring is empty.
+ */
+void DebugLog_Flush(void)
+{
+    uint32_t u32Primask;
+
+    u32Primask = __get_PRIMASK();
+    __disable_irq();
+
+    while(s_u32LogTail != s_u32LogHead)
+    {
+        while(DEBUG_PORT->FIFOSTS & UART_FIFOSTS_TXFULL_Msk) {}
+        DEBUG_PORT->DAT = s_au8LogBuf[s_u32LogTail & (DEFERRED_PRINTF_BUF_SIZE - 1)];
+        s_u32LogTail++;
+    }
+
+    DEBUG_PORT->INTEN &= ~UART_INTEN_THREIEN_Msk;
+
+    __set_PRIMASK(u32Primask);
+}
+
+/**
+ * @brief    Switch the deferred printf to synchronous output
+ *
+ * @param    None
+ *
+ * @returns  None
+ *
+ * @details  Flushes the ring and makes every later character go to the debug port by polling.
+ *           It is called by the hard fault handler so fault messages are not lost.
+ */
+void DebugLog_EnterPanic(void)
+{
+    s_u32LogPanic = 1;
+    DebugLog_Flush();
+}
+
+/**
+ * @brief    Get the number of characters dropped because the ring was full
+ *
+ * @param    None
+ *
+ * @returns  Dropped character count
+ */
+uint32_t DebugLog_GetDropCount(void)
+{
+    return s_u32LogDropCnt;
+}
+
+#endif /* DEFERRED_PRINTF */
+
+#if defined(BINARY_TRACE)
+
+/*---------------------------------------------------------------------------------------------------------*/
+/* Binary trace: send the format string address and raw arguments, the host decoder formats them         */
+/*                                                                                                         */
+/* Frame: 0xA5 | varint(fmt address) | varint(tick delta) | arg count | varint(arg) x count | checksum      */
+/*        checksum is the two's complement of the byte sum from the address to the last argument           */
+/*---------------------------------------------------------------------------------------------------------*/
+#define TRACE_SYNC          0xA5U
+#define TRACE_FRAME_MAX     (1U + 5U + 5U + 1U + (5U * TRACE_MAX_ARGS) + 1U)
+
+static TRACE_TICK_FUNC s_pfnTraceGetTick = NULL;
+static uint32_t s_u32TraceLastTick = 0;         /* Tick of the last frame that was queued or sent */
+static volatile uint32_t s_u32TraceDropCnt = 0;
+static volatile uint32_t s_u32TraceTxBusy = 0;  /* A polled frame is being sent */
+
+static uint32_t Trace_PutVarint(uint8_t *pu8Buf, uint32_t u32Val)
+{
+    uint32_t u32Len = 0;
+
+    while(u32Val >= 0x80U)
+    {
+        pu8Buf[u32Len++] = (uint8_t)(u32Val | 0x80U);
+        u32Val >>= 7;
+    }
+    pu8Buf[u32Len++] = (uint8_t)u32Val;
+
+    return u32Len;
+}
+
+/**
+ * @brief    Set the time stamp source of binary trace
+ *
+ * @param[in] pfnGetTick  Free running tick counter, NULL to send zero deltas
+ *
+ * @returns  None
+ *
+ * @details  Each frame carries the tick difference from the previous frame so that
+ *           a slowly changing time stamp costs a single byte.
+ */
+void Trace_SetTickFunc(TRACE_TICK_FUNC pfnGetTick)
+{
+    s_pfnTraceGetTick = pfnGetTick;
+    s_u32TraceLastTick = (pfnGetTick != NULL) ? pfnGetTick() : 0U;
+}
+
+/**
+ * @brief    Send one binary trace frame
+ *
+ * @param[in] pcFmt      printf format string. Its address identifies the message to the host decoder.
+ * @param[in] u32ArgCnt  Number of 32-bit arguments that follow. Arguments beyond TRACE_MAX_ARGS are not sent.
+ *
+ * @returns  None
+ *
+ * @details  Use TRACE_PRINTF() rather than calling this function directly.
+ *           Only integer, character and pointer conversions are supported; %s, %f and 64-bit
+ *           arguments cannot be decoded because only the 32-bit argument value is sent.
+ *           The interrupt mask is held while the frame is built and queued so that frames
+ *           from thread and interrupt context are never interleaved. When a frame is sent by
+ *           polling, interrupts are enabled again before the UART is drained and a frame
+ *           logged by an interrupt meanwhile is dropped.
+ *           A dropped frame does not advance the last tick, so the next delta still covers
+ *           the time since the last frame the host received.
+ */
+void Trace_Log(const char *pcFmt, uint32_t u32ArgCnt, ...)
+{
+    uint8_t au8Frame[TRACE_FRAME_MAX];
+    uint32_t u32Len, u32Tick, u32Primask, i;
+    uint8_t u8Sum = 0;
+    va_list args;
+
+    if(u32ArgCnt > TRACE_MAX_ARGS)
+        u32ArgCnt = TRACE_MAX_ARGS;
+
+    u32Primask = __get_PRIMASK();
+    __disable_irq();
+
+    if(s_u32TraceTxBusy)
+    {
+        s_u32TraceDropCnt++;
+        __set_PRIMASK(u32Primask);
+        return;
+    }
+
+    au8Frame[0] = TRACE_SYNC;
+    u32Len = 1U + Trace_PutVarint(&au8Frame[1], (uint32_t)pcFmt);
+
+    u32Tick = (s_pfnTraceGetTick != NULL) ? s_pfnTraceGetTick() : 0U;
+    u32Len += Trace_PutVarint(&au8Frame[u32Len], u32Tick - s_u32TraceLastTick);
+
+    au8Frame[u32Len++] = (uint8_t)u32ArgCnt;
+
+    va_start(args, u32ArgCnt);
+    for(i = 0; i < u32ArgCnt; i++)
+        u32Len += Trace_PutVarint(&au8Frame[u32Len], va_arg(args, uint32_t));
+    va_end(args);
+
+    for(i = 1; i < u32Len; i++)
+        u8Sum += au8Frame[i];
+    au8Frame[u32Len++] = (uint8_t)(0U - u8Sum);
+
+#if defined(DEFERRED_PRINTF)
+    if(s_u32LogPanic == 0U)
+    {
+        uint32_t u32Head = s_u32LogHead;
+
+        /* A frame is queued whole or not at all so the host never sees a torn frame */
+        if((u32Head - s_u32LogTail) + u32Len > DEFERRED_PRINTF_BUF_SIZE)
+        {
+            s_u32TraceDropCnt++;
+        }
+        else
+        {
+            for(i = 0; i < u32Len; i++)
+                s_au8LogBuf[u32Head++ & (DEFERRED_PRINTF_BUF_SIZE - 1)] = au8Frame[i];
+
+            s_u32LogHead = u32Head;
+            s_u32TraceLastTick = u32Tick;
+            DEBUG_PORT->INTEN |= UART_INTEN_THREIEN_Msk;
+        }
+
+        __set_PRIMASK(u32Primask);
+        return;
+    }
+#endif
+
+    s_u32TraceLastTick = u32Tick;
+    s_u32TraceTxBusy = 1U;
+    __set_PRIMASK(u32Primask);
+
+    for(i = 0; i < u32Len; i++)
+    {
+        while(DEBUG_PORT->FIFOSTS & UART_FIFOSTS_TXFULL_Msk) {}
+        DEBUG_PORT->DAT = au8Frame[i];
+    }
+
+    s_u32TraceTxBusy = 0U;
+}
+
+/**
+ * @brief    Get the number of binary trace frames dropped because the deferred printf ring was full
+ *
+ * @param    None
+ *
+ * @returns  Dropped frame count
+ */
+uint32_t Trace_GetDropCount(void)
+{
+    return s_u32TraceDropCnt;
+}
+
+#endif /* BINARY_TRACE */
+
 /**
  * @brief       Routine to send a char
  *
@@ -441,6 +757,16 @@ Get_LR_and_Branch
 #ifndef NONBLOCK_PRINTF
 static void SendChar_ToUART(int ch)
 {
+#if defined(DEFERRED_PRINTF)
+    char c = (char)ch;
+
+    if(s_u32LogPanic == 0U)
+    {
+        DebugLog_Write(&c, 1);
+        return;
+    }
+#endif
+
     while(DEBUG_PORT->FIFOSTS & UART_FIFOSTS_TXFULL_Msk);
 
     if(ch == '\n')
@@ -628,6 +954,10 @@ int kbhit(void)
 int IsDebugFifoEmpty(void)
 {
 #ifndef DISABLE_UART
+#if defined(DEFERRED_PRINTF)
+    if(s_u32LogTail != s_u32LogHead)
+        return 0;
+#endif
     return ((DEBUG_PORT->FIFOSTS & UART_FIFOSTS_TXEMPTYF_Msk) != 0);
 #else
     return 1;
@@ -681,6 +1011,11 @@ int _write (int fd, char *ptr, int len)
 {
     int i = len;
 
+#if defined(DEFERRED_PRINTF)
+    if(s_u32LogPanic == 0U)
+        return DebugLog_Write(ptr, len);
+#endif
+
     while(i--)
     {
         while(DEBUG_PORT->FIFOSTS & UART_FIFOSTS_TXFULL_Msk);
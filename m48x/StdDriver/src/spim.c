@@ -36,16 +36,34 @@
 #define SPIM_DBGMSG(...)   do { } while (0)      /* disable debug */
 #endif
 
+#define SPIM_HAS_VENDOR(v)  ((SPIM_FLASH_VENDORS & SPIM_VENDOR_##v) != 0UL)
+
+#if !SPIM_HAS_VENDOR(ALL)
+#error "SPIM_FLASH_VENDORS must select at least one flash vendor"
+#endif
+
 static volatile uint8_t  g_Supported_List[] =
 {
+#if SPIM_HAS_VENDOR(WINBOND)
     MFGID_WINBOND,
+#endif
+#if SPIM_HAS_VENDOR(MXIC)
     MFGID_MXIC,
+#endif
+#if SPIM_HAS_VENDOR(EON)
     MFGID_EON,
+#endif
+#if SPIM_HAS_VENDOR(ISSI)
     MFGID_ISSI,
-    MFGID_SPANSION
+#endif
+#if SPIM_HAS_VENDOR(SPANSION)
+    MFGID_SPANSION,
+#endif
 };
 
+#if SPIM_HAS_VENDOR(SPANSION)
 static void  N_delay(int n);
+#endif
 static void SwitchNBitOutput(uint32_t u32NBit);
 static void SwitchNBitInput(uint32_t u32NBit);
 static void spim_write(uint8_t pu8TxBuf[], uint32_t u32NTx);
@@ -59,15 +77,20 @@ static void SPIM_ReadSecurityRegister(uint8_t dataBuf[], uint32_t u32NRx, uint32
 static int spim_is_write_done(uint32_t u32NBit);
 static int spim_wait_write_done(uint32_t u32NBit);
 static void spim_set_write_enable(int isEn, uint32_t u32NBit);
+#if SPIM_HAS_VENDOR(SPANSION)
 static void spim_enable_spansion_quad_mode(int isEn);
-static void spim_eon_set_qpi_mode(int isEn);
 static void SPIM_SPANSION_4Bytes_Enable(int isEn, uint32_t u32NBit);
+#endif
+#if SPIM_HAS_VENDOR(EON)
+static void spim_eon_set_qpi_mode(int isEn);
+#endif
 static void SPIM_WriteInPageDataByIo(uint32_t u32Addr, int is4ByteAddr, uint32_t u32NTx, uint8_t pu8TxBuf[], uint8_t wrCmd,
                                      uint32_t u32NBitCmd, uint32_t u32NBitAddr, uint32_t u32NBitDat, int isSync);
 static void SPIM_WriteInPageDataByPageWrite(uint32_t u32Addr, int is4ByteAddr, uint32_t u32NTx,
         uint8_t pu8TxBuf[], uint32_t wrCmd, int isSync);
 
 
+#if SPIM_HAS_VENDOR(SPANSION)
 static void  N_delay(int n)
 {
     while (n-- > 0)
@@ -75,6 +98,7 @@ static void  N_delay(int n)
         __NOP();
     }
 }
+#endif
 
 static void SwitchNBitOutput(uint32_t u32NBit)
 {
@@ -577,6 +601,7 @@ void SPIM_ReadJedecId(uint8_t idBuf[], uint32_t u32NRx, uint32_t u32NBit)
 
 /** @cond HIDDEN_SYMBOLS */
 
+#if SPIM_HAS_VENDOR(SPANSION)
 static void spim_enable_spansion_quad_mode(int isEn)
 {
     uint8_t cmdBuf[3];
@@ -638,6 +663,7 @@ static void spim_enable_spansion_quad_mode(int isEn)
     /* SPIM_DBGMSG("CR1 = 0x%x\n", dataBuf[0]); */
     N_delay(10000);
 }
+#endif
 
 /** @endcond HIDDEN_SYMBOLS */
 
@@ -652,12 +678,15 @@ void SPIM_SetQuadEnable(int isEn, uint32_t u32NBit)
     uint8_t  idBuf[3];
     uint8_t  dataBuf[2];
 
+    (void)dataBuf;                               /* Unused in a Spansion-only build. */
+
     SPIM_ReadJedecId(idBuf, sizeof (idBuf), u32NBit);
 
     SPIM_DBGMSG("SPIM_SetQuadEnable - Flash ID is 0x%x\n", idBuf[0]);
 
     switch (idBuf[0])
     {
+#if SPIM_HAS_VENDOR(WINBOND)
     case MFGID_WINBOND:                      /* Winbond SPI flash  */
         SPIM_ReadStatusRegister(&dataBuf[0], 1UL, u32NBit);
         SPIM_ReadStatusRegister2(&dataBuf[1], 1UL, u32NBit);
@@ -679,19 +708,30 @@ void SPIM_SetQuadEnable(int isEn, uint32_t u32NBit)
         SPIM_ReadStatusRegister2(&dataBuf[1], 1UL, u32NBit);
         SPIM_DBGMSG("Status Register: 0x%x - 0x%x\n", dataBuf[0], dataBuf[1]);
         break;
+#endif
 
+#if SPIM_HAS_VENDOR(MXIC) || SPIM_HAS_VENDOR(EON) || SPIM_HAS_VENDOR(ISSI)
+#if SPIM_HAS_VENDOR(MXIC)
     case MFGID_MXIC:                         /* MXIC SPI flash.  */
+#endif
+#if SPIM_HAS_VENDOR(EON)
     case MFGID_EON:
+#endif
+#if SPIM_HAS_VENDOR(ISSI)
     case MFGID_ISSI:                         /* ISSI SPI flash.  */
+#endif
         spim_set_write_enable(1, u32NBit);   /* Write Enable.    */
         dataBuf[0] = isEn ? SR_QE : 0U;
         SPIM_WriteStatusRegister(dataBuf, sizeof (dataBuf), u32NBit);
         spim_wait_write_done(u32NBit);
         break;
+#endif
 
+#if SPIM_HAS_VENDOR(SPANSION)
     case MFGID_SPANSION:
         spim_enable_spansion_quad_mode(isEn);
         break;
+#endif
 
     default:
         break;
@@ -703,6 +743,7 @@ void SPIM_SetQuadEnable(int isEn, uint32_t u32NBit)
   * @param      isEn        Enable/disable.
   * @return     None.
   */
+#if SPIM_HAS_VENDOR(EON)
 static void spim_eon_set_qpi_mode(int isEn)
 {
     uint8_t cmdBuf[1];                           /* 1-byte command.  */
@@ -733,8 +774,9 @@ static void spim_eon_set_qpi_mode(int isEn)
     SPIM_ReadStatusRegister(status, sizeof (status), 1UL);
     SPIM_DBGMSG("Status: 0x%x\n", status[0]);
 }
+#endif
 
-
+#if SPIM_HAS_VENDOR(SPANSION)
 static void SPIM_SPANSION_4Bytes_Enable(int isEn, uint32_t u32NBit)
 {
     uint8_t cmdBuf[2];
@@ -766,6 +808,7 @@ static void SPIM_SPANSION_4Bytes_Enable(int isEn, uint32_t u32NBit)
     spim_write(cmdBuf, 2UL);
     SPIM_SET_SS_EN(0);                          /* CS deactivated.  */
 }
+#endif
 
 /** @cond HIDDEN_SYMBOLS */
 
@@ -850,11 +893,13 @@ int SPIM_Enable_4Bytes_Mode(int isEn, uint32_t u32NBit)
         isSupt = (idBuf[2] < 0x49U) ? 0L : 1L;
         break;
 
+#if SPIM_HAS_VENDOR(SPANSION)
     case MFGID_SPANSION:
         SPIM_SPANSION_4Bytes_Enable(isEn, u32NBit);
         isSupt = 1L;
         ret = 0L;
         break;
+#endif
 
     default:
         break;
@@ -1061,11 +1106,13 @@ static void SPIM_WriteInPageDataByPageWrite(uint32_t u32Addr, int is4ByteAddr, u
     {
         SPIM_SetQuadEnable(1, 1UL);              /* Set Quad Enable. */
     }
+#if SPIM_HAS_VENDOR(EON)
     else if (wrCmd == CMD_QUAD_PAGE_PROGRAM_EON)
     {
         SPIM_SetQuadEnable(1, 1UL);              /* Set Quad Enable. */
         spim_eon_set_qpi_mode(1);                /* Enter QPI mode.  */
     }
+#endif
 
     SPIM_SET_OPMODE(SPIM_CTL0_OPMODE_PAGEWRITE);/* Switch to Page Write mode.   */
     SPIM_SET_SPIM_MODE(wrCmd);                  /* SPIM mode.       */
@@ -1081,10 +1128,12 @@ static void SPIM_WriteInPageDataByPageWrite(uint32_t u32Addr, int is4ByteAddr, u
         SPIM_WAIT_FREE();
     }
 
+#if SPIM_HAS_VENDOR(EON)
     if (wrCmd == CMD_QUAD_PAGE_PROGRAM_EON)
     {
         spim_eon_set_qpi_mode(0);                /* Exit QPI mode.   */
     }
+#endif
 }
 
 /** @endcond HIDDEN_SYMBOLS */
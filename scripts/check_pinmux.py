@@ -0,0 +1,268 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 Nuvoton Technology Corp.
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Check the pin-mux assignment of a board for conflicts.
+
+The pin-function database is built from the SYS_GPx_MFPn_PxyMFP_<func>
+constants of dts/<series>/sys.h, so it always matches the headers the
+pinctrl names are generated from. The checker then reports
+
+  - a pin that is given two functions, or is claimed by two devices,
+  - a function that is routed to two pins,
+  - a pin-mux name or value that does not exist on the series.
+
+Input is either a list of pin-mux names or devicetree files. For devicetree
+input only the pinctrl states referenced by enabled devices are checked,
+each state name separately. Both the board sources (pinmux = <PB12MFP_UART0_RXD>)
+and the merged build/zephyr/zephyr.dts (numeric cells) are accepted; numeric
+cells are decoded for the NVT_PINMUX encoding of m46x and m2l31x only.
+
+Usage:
+    check_pinmux.py --series m46x build/zephyr/zephyr.dts
+    check_pinmux.py --series m2l31x --pins PB12MFP_UART0_RXD PB13MFP_UART0_TXD
+    check_pinmux.py --series m48x --db pins.json
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+
+SERIES = ("m46x", "m48x", "m2l31x")
+
+MFP_RE = re.compile(r"^\s*#\s*define\s+SYS_GP[A-J]_MFP\w*?_P([A-J])(\d+)MFP_(\w+)\s+\((0x[0-9a-fA-F]+)UL\s*<<")
+NVT_NAME_RE = re.compile(r"^P([A-J])(\d+)MFP_(\w+)$")
+NUMICRO_NAME_RE = re.compile(r"^(?:(\w+)_)?P([A-J])(\d+)$")
+TOKEN_RE = re.compile(r'"(?:\\.|[^"\\])*"|<[^>]*>|\[[^\]]*\]|&\{[^}]*\}|[{};=,]|[^\s{};=,<>"]+')
+COMMENT_RE = re.compile(r"/\*.*?\*/|//[^\n]*", re.S)
+
+
+def pin_name(port, pin):
+    return "P%c%d" % (chr(ord("A") + port), pin)
+
+
+class PinDatabase:
+    """Functions of every pin, read from dts/<series>/sys.h."""
+
+    def __init__(self, series, root):
+        self.series = series
+        self.funcs = {}
+
+        with open(os.path.join(root, "dts", series, "sys.h"), encoding="utf-8", errors="replace") as f:
+            for line in f:
+                m = MFP_RE.match(line)
+                if m:
+                    pin = (ord(m.group(1)) - ord("A"), int(m.group(2)))
+                    self.funcs.setdefault(pin, {}).setdefault(int(m.group(4), 16), []).append(m.group(3))
+
+    def function(self, port, pin, mfp):
+        names = self.funcs.get((port, pin), {}).get(mfp)
+        return "/".join(names) if names else None
+
+    def lookup(self, port, pin, func):
+        for mfp, names in self.funcs.get((port, pin), {}).items():
+            for name in names:
+                if name.upper() == func.upper():
+                    return mfp, name
+        return None
+
+    def decode(self, item):
+        """Return (port, pin, mfp, function) of a pin-mux name or cell value."""
+        if isinstance(item, int):
+            if self.series == "m48x":
+                raise ValueError("numeric pin-mux 0x%08X cannot be decoded for m48x, check the board sources" % item)
+            port, pin, mfp = (item >> 28) & 0xF, (item >> 24) & 0xF, item & 0x1F
+            func = self.function(port, pin, mfp)
+            if func is None:
+                raise ValueError("0x%08X: %s has no function %d" % (item, pin_name(port, pin), mfp))
+            return port, pin, mfp, func
+
+        m = NVT_NAME_RE.match(item) if self.series != "m48x" else None
+        if m:
+            port, pin, func = ord(m.group(1)) - ord("A"), int(m.group(2)), m.group(3)
+        else:
+            m = NUMICRO_NAME_RE.match(item) if self.series == "m48x" else None
+            if not m:
+                raise ValueError("%s is not a %s pin-mux name" % (item, self.series))
+            port, pin, func = ord(m.group(2)) - ord("A"), int(m.group(3)), m.group(1) or "GPIO"
+
+        found = self.lookup(port, pin, func)
+        if found is None:
+            raise ValueError("%s: %s has no function %s" % (item, pin_name(port, pin), func))
+        return (port, pin) + found
+
+    def to_json(self):
+        return {pin_name(*pin): {name: mfp for mfp, names in sorted(funcs.items()) for name in names}
+                for pin, funcs in sorted(self.funcs.items())}
+
+
+class Node:
+    def __init__(self, name):
+        self.name = name
+        self.labels = []
+        self.props = {}
+        self.children = []
+
+
+class Devicetree:
+    """Just enough of a devicetree parser to follow pinctrl references."""
+
+    def __init__(self, paths):
+        self.labels = {}
+        self.nodes = []
+        for path in paths:
+            with open(path, encoding="utf-8", errors="replace") as f:
+                text = COMMENT_RE.sub(" ", f.read())
+            text = "\n".join(line for line in text.splitlines() if not line.lstrip().startswith("#"))
+            self._parse(TOKEN_RE.findall(text))
+
+    def _parse(self, tokens):
+        stack = []
+        node = None
+        words = []
+
+        for tok in tokens:
+            if tok == "{":
+                labels = [w[:-1] for w in words if w.endswith(":")]
+                name = ([w for w in words if not w.endswith(":")] or ["/"])[-1]
+                if name.startswith("&") and not stack:
+                    child = self.labels.get(name[1:])
+                    if child is None:
+                        child = self._new_node(name[1:], [name[1:]])
+                else:
+                    child = self._new_node(name, labels)
+                    if node is not None:
+                        node.children.append(child)
+                stack.append(node)
+                node = child
+                words = []
+            elif tok == "}":
+                node = stack.pop() if stack else None
+                words = []
+            elif tok == ";":
+                if node is not None and len(words) >= 2 and words[1] == "=":
+                    node.props[words[0]] = self._values(words[2:])
+                words = []
+            else:
+                words.append(tok)
+
+    def _new_node(self, name, labels):
+        node = Node(name)
+        node.labels = labels
+        for label in labels:
+            self.labels[label] = node
+        self.nodes.append(node)
+        return node
+
+    @staticmethod
+    def _values(words):
+        values = []
+        for w in words:
+            if w.startswith('"'):
+                values.append(w[1:-1])
+            elif w.startswith("<"):
+                for cell in w[1:-1].split():
+                    try:
+                        values.append(int(cell, 0))
+                    except ValueError:
+                        values.append(cell)
+        return values
+
+    def pinmux_of(self, state):
+        items = list(state.props.get("pinmux", []))
+        for child in state.children:
+            items += self.pinmux_of(child)
+        return items
+
+    def states(self):
+        """Yield (state name, {device: [pin-mux items]}) of enabled devices."""
+        devices = {}
+        for node in self.nodes:
+            if "pinctrl-0" not in node.props or node.props.get("status", ["okay"])[0] != "okay":
+                continue
+            names = node.props.get("pinctrl-names", ["default"])
+            owner = node.labels[0] if node.labels else node.name
+            devices[owner] = {}
+            for i, name in enumerate(names):
+                refs = node.props.get("pinctrl-%d" % i, [])
+                items = []
+                for ref in refs:
+                    target = self.labels.get(str(ref).lstrip("&"))
+                    if target is None:
+                        raise ValueError("%s: pinctrl-%d refers to unknown %s" % (owner, i, ref))
+                    items += self.pinmux_of(target)
+                devices[owner][name] = items
+
+        for state in sorted({name for states in devices.values() for name in states}):
+            yield state, {dev: states.get(state, states.get("default", [])) for dev, states in devices.items()}
+
+
+def check(db, assignments):
+    """Check {owner: [pin-mux items]}; return a list of error strings."""
+    errors = []
+    pins = {}
+    funcs = {}
+
+    for owner, items in assignments.items():
+        for item in items:
+            try:
+                port, pin, mfp, func = db.decode(item)
+            except ValueError as e:
+                errors.append("%s: %s" % (owner, e))
+                continue
+
+            name = pin_name(port, pin)
+            prev = pins.setdefault((port, pin), (owner, mfp, func))
+            if prev[0] != owner or prev[1] != mfp:
+                errors.append("%s is %s for %s and %s for %s" % (name, prev[2], prev[0], func, owner))
+
+            if mfp == 0:
+                continue
+            prev = funcs.setdefault(func, (owner, name))
+            if prev[1] != name:
+                errors.append("%s is routed to %s by %s and to %s by %s" % (func, prev[1], prev[0], name, owner))
+
+    return errors
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("files", nargs="*", help="devicetree sources or zephyr.dts")
+    parser.add_argument("--series", required=True, choices=SERIES)
+    parser.add_argument("--pins", nargs="+", help="check a list of pin-mux names instead of devicetree files")
+    parser.add_argument("--db", metavar="FILE", help="write the pin-function database as JSON")
+    parser.add_argument("--root", default=os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."),
+                        help="root of the hal_nuvoton tree")
+    args = parser.parse_args()
+
+    db = PinDatabase(args.series, args.root)
+
+    if args.db:
+        with open(args.db, "w", encoding="utf-8") as f:
+            json.dump(db.to_json(), f, indent=1)
+            f.write("\n")
+
+    errors = []
+    if args.pins:
+        errors += check(db, {"pins": args.pins})
+    elif args.files:
+        try:
+            for state, assignments in Devicetree(args.files).states():
+                errors += ["[%s] %s" % (state, e) for e in check(db, assignments)]
+        except ValueError as e:
+            errors.append(str(e))
+    elif not args.db:
+        parser.error("no pins or devicetree files given")
+
+    for e in errors:
+        print(e, file=sys.stderr)
+
+    return 1 if errors else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
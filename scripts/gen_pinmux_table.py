@@ -0,0 +1,163 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 Nuvoton Technology Corp.
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Generate a merged S_SYS_MFP_CFG_T table from NVT_PINMUX names.
+
+The pinctrl headers in dts/pinctrl encode each pin function as
+NVT_PINMUX(port, pin, mfp). This script resolves the requested names, merges
+the pins that share a GPx_MFPn register and prints a C table for
+SYS_ApplyMfpTable(), so the merge is done at build time.
+
+Usage:
+    gen_pinmux_table.py dts/pinctrl/m467hjhae-pinctrl.h PB12MFP_UART0_RXD PB13MFP_UART0_TXD
+    gen_pinmux_table.py dts/pinctrl/m467hjhae-pinctrl.h --name s_asUartPins @pins.txt
+    gen_pinmux_table.py dts/pinctrl/m467hjhae-pinctrl.h --check
+"""
+
+import argparse
+import os
+import re
+import sys
+
+MFP_FIELD_MSK = 0x1F
+
+DEFINE_RE = re.compile(r"^\s*#\s*define\s+(\w+)\s+(.+?)\s*(?:/\*.*)?$")
+INCLUDE_RE = re.compile(r'^\s*#\s*include\s+"([^"]+)"')
+PINMUX_RE = re.compile(r"NVT_PINMUX\(\s*'([A-Z])'\s*,\s*(\d+)\s*,\s*(\w+)\s*\)")
+IDENT_RE = re.compile(r"\b[A-Za-z_]\w*\b")
+SUFFIX_RE = re.compile(r"\b(0[xX][0-9a-fA-F]+|\d+)[uUlL]+\b")
+
+
+class Defines:
+    """Object-like macros of a header and the headers it includes."""
+
+    def __init__(self, path):
+        self.values = {}
+        self.pinmux = {}
+        self._load(os.path.abspath(path), set())
+
+    def _load(self, path, seen):
+        if path in seen:
+            return
+        seen.add(path)
+
+        with open(path, encoding="utf-8", errors="replace") as f:
+            for line in f:
+                inc = INCLUDE_RE.match(line)
+                if inc:
+                    self._load(os.path.join(os.path.dirname(path), inc.group(1)), seen)
+                    continue
+
+                m = DEFINE_RE.match(line)
+                if not m or "(" in m.group(1):
+                    continue
+
+                pm = PINMUX_RE.search(m.group(2))
+                if pm:
+                    self.pinmux[m.group(1)] = (ord(pm.group(1)) - ord("A"), int(pm.group(2)), pm.group(3))
+                else:
+                    self.values[m.group(1)] = m.group(2)
+
+    def evaluate(self, name, depth=0):
+        if depth > 16:
+            raise ValueError("macro nesting too deep: " + name)
+
+        expr = SUFFIX_RE.sub(r"\1", self.values[name])
+
+        def resolve(m):
+            ident = m.group(0)
+            if ident in self.values:
+                return "(%d)" % self.evaluate(ident, depth + 1)
+            if re.fullmatch(r"0[xX][0-9a-fA-F]+", ident):
+                return ident
+            raise ValueError("unresolved symbol %s in %s" % (ident, name))
+
+        return int(eval(IDENT_RE.sub(resolve, expr), {"__builtins__": {}}))
+
+    def decode(self, name):
+        """Return (port, pin, function) of a NVT_PINMUX name."""
+        port, pin, mfp_name = self.pinmux[name]
+        shift = (pin % 4) * 8
+        mfp = self.evaluate(mfp_name)
+
+        if mfp & ~(MFP_FIELD_MSK << shift):
+            raise ValueError("%s: %s is not a field of pin %d" % (name, mfp_name, pin))
+
+        return port, pin, mfp >> shift
+
+
+def merge(defs, names):
+    regs = {}
+    pins = {}
+    for name in names:
+        port, pin, func = defs.decode(name)
+        prev = pins.setdefault((port, pin), (name, func))
+        if prev[1] != func:
+            raise ValueError("%s conflicts with %s" % (name, prev[0]))
+        reg = port * 4 + pin // 4
+        shift = (pin % 4) * 8
+        mask, value = regs.get(reg, (0, 0))
+        regs[reg] = (mask | (MFP_FIELD_MSK << shift), (value & ~(MFP_FIELD_MSK << shift)) | (func << shift))
+    return [(reg,) + regs[reg] for reg in sorted(regs)]
+
+
+def emit(table, names, var):
+    out = ["/* Generated by scripts/gen_pinmux_table.py from:"]
+    out += [" *   " + name for name in names]
+    out += [" */", "static const S_SYS_MFP_CFG_T %s[] =" % var, "{"]
+    for reg, mask, value in table:
+        out.append("    {%2dUL, 0x%08XUL, 0x%08XUL},   /* GP%c_MFP%d */" %
+                   (reg, mask, value, chr(ord("A") + reg // 4), reg % 4))
+    out.append("};")
+    return "\n".join(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("header", help="pinctrl header, e.g. dts/pinctrl/m467hjhae-pinctrl.h")
+    parser.add_argument("pins", nargs="*", help="NVT_PINMUX names, or @file with one name per line")
+    parser.add_argument("--name", default="s_asPinmuxCfg", help="name of the generated array")
+    parser.add_argument("--check", action="store_true", help="decode every NVT_PINMUX name in the header")
+    args = parser.parse_args()
+
+    defs = Defines(args.header)
+
+    if args.check:
+        errors = 0
+        for name in defs.pinmux:
+            try:
+                defs.decode(name)
+            except (KeyError, ValueError) as e:
+                print("%s: %s" % (name, e), file=sys.stderr)
+                errors += 1
+        print("%d pin functions, %d errors" % (len(defs.pinmux), errors))
+        return 1 if errors else 0
+
+    names = []
+    for arg in args.pins:
+        if arg.startswith("@"):
+            with open(arg[1:], encoding="utf-8") as f:
+                names += [line.split("#")[0].strip() for line in f if line.split("#")[0].strip()]
+        else:
+            names.append(arg)
+
+    if not names:
+        parser.error("no pins given")
+
+    try:
+        print(emit(merge(defs, names), names, args.name))
+    except KeyError as e:
+        print("unknown pin function %s" % e, file=sys.stderr)
+        return 1
+    except ValueError as e:
+        print(e, file=sys.stderr)
+        return 1
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,252 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 Nuvoton Technology Corp.
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Decode the BINARY_TRACE output of retarget.c.
+
+Each frame sent by Trace_Log() is
+
+    0xA5 | varint(fmt address) | varint(tick delta) | arg count | varint(arg) x count | checksum
+
+The format string is read from the ELF file at the frame's address, so the
+ELF must be the exact image running on the target.
+
+Usage:
+    trace_decode.py zephyr.elf capture.bin
+    trace_decode.py zephyr.elf /dev/ttyUSB0 --baud 115200
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+SYNC = 0xA5
+MAX_ARGS = 8
+
+SHT_NOBITS = 8
+SHF_ALLOC = 0x2
+
+
+class Elf32Image:
+    """Loadable sections of a little-endian ELF32 file, indexed by address."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            data = f.read()
+
+        if data[:4] != b"\x7fELF" or data[4] != 1 or data[5] != 1:
+            raise ValueError(f"{path}: not a little-endian ELF32 file")
+
+        e_shoff, = struct.unpack_from("<I", data, 0x20)
+        e_shentsize, e_shnum = struct.unpack_from("<HH", data, 0x2E)
+
+        self.sections = []
+        for i in range(e_shnum):
+            (_, sh_type, sh_flags, sh_addr, sh_offset,
+             sh_size) = struct.unpack_from("<IIIIII", data, e_shoff + i * e_shentsize)
+            if sh_type == SHT_NOBITS or not sh_flags & SHF_ALLOC or sh_size == 0:
+                continue
+            self.sections.append((sh_addr, data[sh_offset:sh_offset + sh_size]))
+
+        self.cache = {}
+
+    def string_at(self, addr):
+        if addr in self.cache:
+            return self.cache[addr]
+
+        text = None
+        for base, blob in self.sections:
+            if base <= addr < base + len(blob):
+                end = blob.find(b"\0", addr - base)
+                if end >= 0:
+                    text = blob[addr - base:end].decode("utf-8", "replace")
+                break
+
+        self.cache[addr] = text
+        return text
+
+
+# %[flags][width][.precision][length]conversion
+FMT_RE = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(hh|h|ll|l|j|z|t|L)?([diouxXcpeEfgGaAsn%])")
+
+
+def c_format(fmt, args):
+    """Format a C printf string with 32-bit argument values."""
+    out = []
+    pos = 0
+    args = list(args)
+
+    def next_arg():
+        return args.pop(0) if args else 0
+
+    for m in FMT_RE.finditer(fmt):
+        out.append(fmt[pos:m.start()])
+        pos = m.end()
+
+        flags, width, prec, _, conv = m.groups()
+        if conv == "%":
+            out.append("%")
+            continue
+
+        if width == "*":
+            width = str(to_signed(next_arg()))
+        if prec == "*":
+            prec = str(to_signed(next_arg()))
+
+        spec = "%" + flags + (width or "") + ("." + prec if prec is not None else "")
+        value = next_arg()
+
+        if conv in "di":
+            out.append((spec + "d") % to_signed(value))
+        elif conv in "uoxX":
+            out.append((spec + conv.replace("u", "d")) % value)
+        elif conv == "c":
+            out.append((spec + "c") % chr(value & 0xFF))
+        elif conv == "p":
+            out.append((spec + "s") % f"0x{value:08x}")
+        else:
+            # %s, %f and friends cannot be rebuilt from a 32-bit value
+            out.append(f"<%{conv}:0x{value:08x}>")
+
+    out.append(fmt[pos:])
+    return "".join(out)
+
+
+def to_signed(value):
+    return value - (1 << 32) if value & 0x80000000 else value
+
+
+def read_varint(buf, pos):
+    value = 0
+    for shift in range(0, 35, 7):
+        if pos >= len(buf):
+            return None, pos
+        byte = buf[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        if not byte & 0x80:
+            return value & 0xFFFFFFFF, pos
+    raise ValueError("varint too long")
+
+
+def parse_frame(buf, start):
+    """Return (addr, delta, args, next position), None if more data is needed,
+    or raise ValueError for a corrupt frame."""
+    pos = start + 1
+
+    addr, pos = read_varint(buf, pos)
+    if addr is None:
+        return None
+    delta, pos = read_varint(buf, pos)
+    if delta is None:
+        return None
+    if pos >= len(buf):
+        return None
+    count = buf[pos]
+    pos += 1
+    if count > MAX_ARGS:
+        raise ValueError("bad argument count")
+
+    args = []
+    for _ in range(count):
+        arg, pos = read_varint(buf, pos)
+        if arg is None:
+            return None
+        args.append(arg)
+
+    if pos >= len(buf):
+        return None
+    if (sum(buf[start + 1:pos + 1]) & 0xFF) != 0:
+        raise ValueError("checksum mismatch")
+
+    return addr, delta, args, pos + 1
+
+
+def decode(elf, chunks, out):
+    buf = bytearray()
+    tick = 0
+    lost = 0
+
+    for chunk in chunks:
+        buf += chunk
+
+        while True:
+            start = buf.find(SYNC)
+            if start < 0:
+                lost += len(buf)
+                buf.clear()
+                break
+            lost += start
+            del buf[:start]
+
+            try:
+                frame = parse_frame(buf, 0)
+            except ValueError:
+                # Resynchronize on the next sync byte
+                lost += 1
+                del buf[:1]
+                continue
+
+            if frame is None:
+                break
+
+            addr, delta, args, end = frame
+            del buf[:end]
+
+            # The delta is relative to the previous frame sent, so it counts
+            # even when the format is unknown and the frame is skipped
+            tick = (tick + delta) & 0xFFFFFFFF
+
+            fmt = elf.string_at(addr)
+            if fmt is None:
+                lost += end
+                continue
+
+            out.write(f"[{tick:10d}] {c_format(fmt, args)}")
+            if not fmt.endswith("\n"):
+                out.write("\n")
+            out.flush()
+
+    return lost
+
+
+def read_chunks(path, baud):
+    if path.startswith("/dev/") or path.upper().startswith("COM"):
+        import serial  # pyserial, only needed for live capture
+
+        with serial.Serial(path, baud, timeout=0.1) as port:
+            while True:
+                yield port.read(256)
+    else:
+        with open(path, "rb") as f:
+            while True:
+                chunk = f.read(4096)
+                if not chunk:
+                    return
+                yield chunk
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf", help="ELF image running on the target")
+    parser.add_argument("input", help="captured binary file or serial port")
+    parser.add_argument("--baud", type=int, default=115200, help="serial port baud rate")
+    args = parser.parse_args()
+
+    elf = Elf32Image(args.elf)
+    try:
+        lost = decode(elf, read_chunks(args.input, args.baud), sys.stdout)
+    except KeyboardInterrupt:
+        return 0
+
+    if lost:
+        print(f"{lost} byte(s) could not be decoded", file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())